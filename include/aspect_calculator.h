@@ -1,13 +1,24 @@
 #pragma once
 
 #include "astro_types.h"
+#include <array>
 #include <vector>
-#include <map>
 
 namespace Astro {
 
 class AspectCalculator {
 public:
+    static constexpr size_t ASPECT_COUNT = 5;
+
+    // Aspects in the order they are tested; orb tables are indexed the same way
+    static constexpr std::array<AspectType, ASPECT_COUNT> SUPPORTED_ASPECTS = {
+        AspectType::CONJUNCTION,
+        AspectType::SEXTILE,
+        AspectType::SQUARE,
+        AspectType::TRINE,
+        AspectType::OPPOSITION
+    };
+
     AspectCalculator();
 
     // Calculate all aspects between planets
@@ -23,14 +34,23 @@ public:
     // Set default orb tolerances
     void setDefaultOrbs();
 
+    // Orb tolerance of an aspect (0 for unsupported aspects)
+    double getOrbTolerance(AspectType aspect) const;
+
+    // Orb tolerances indexed like SUPPORTED_ASPECTS
+    const std::array<double, ASPECT_COUNT>& getOrbTolerances() const { return orbTolerances; }
+
     // Check if two angles form a specific aspect
     bool isAspect(double angle1, double angle2, AspectType aspect, double& orb) const;
 
     // Get all supported aspects
     static std::vector<AspectType> getSupportedAspects();
 
+    // Position of an aspect in SUPPORTED_ASPECTS, or -1 if unsupported
+    static int aspectIndex(AspectType aspect);
+
 private:
-    std::map<AspectType, double> orbTolerances;
+    std::array<double, ASPECT_COUNT> orbTolerances;
 
     // Calculate aspect between two planets
     bool calculateAspectBetweenPlanets(const PlanetPosition& pos1,
@@ -0,0 +1,112 @@
+#pragma once
+
+#include "aspect_calculator.h"
+#include "astro_types.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace Astro {
+
+// Body longitudes of one chart as parallel arrays
+struct ChartLongitudes {
+    std::vector<Planet> planets;
+    std::vector<double> longitudes;  // degrees, [0, 360)
+    std::vector<double> speeds;      // degrees per day
+
+    static ChartLongitudes fromPositions(const std::vector<PlanetPosition>& positions);
+
+    size_t size() const { return planets.size(); }
+};
+
+// Many charts with the same body list, stored one column per body so that a
+// body's longitude across all charts is contiguous.
+class ChartLongitudeMatrix {
+public:
+    explicit ChartLongitudeMatrix(std::vector<Planet> planets);
+
+    void reserve(size_t charts);
+
+    // Append a chart; returns false (and adds nothing) if one of the bodies is missing
+    bool addChart(const std::vector<PlanetPosition>& positions);
+
+    // Append a chart given one longitude per body, in body-list order
+    void addChart(const double* longitudes);
+
+    size_t chartCount() const { return charts; }
+    size_t bodyCount() const { return planets.size(); }
+    const std::vector<Planet>& getPlanets() const { return planets; }
+
+    // Longitudes of one body across all charts
+    const double* column(size_t body) const { return columns[body].data(); }
+
+    double longitude(size_t chart, size_t body) const { return columns[body][chart]; }
+
+private:
+    std::vector<Planet> planets;
+    std::vector<std::vector<double>> columns;
+    size_t charts;
+};
+
+// One aspect found by the matrix engine. body1 indexes the first chart's bodies,
+// body2 the second chart's (or the matrix body list).
+struct AspectHit {
+    uint32_t chart;
+    uint8_t body1;
+    uint8_t body2;
+    AspectType type;
+    float orb;
+};
+
+// Aspect engine for chart-to-chart comparison.
+// Every body of one chart is tested against every body of another chart, or of
+// every chart in a ChartLongitudeMatrix. Aspect angles and orbs live in flat
+// arrays and each (body, body) pair is classified for a block of charts in one
+// branch-free loop that the compiler vectorizes in release builds. The first
+// matching aspect in AspectCalculator::SUPPORTED_ASPECTS order wins, as in
+// AspectCalculator.
+class AspectMatrix {
+public:
+    AspectMatrix();
+
+    // Use the orb tolerances configured on an AspectCalculator
+    explicit AspectMatrix(const AspectCalculator& calculator);
+
+    void setOrbTolerance(AspectType aspect, double orb);
+
+    // Synastry: every body of a against every body of b (chart index 0)
+    void compare(const ChartLongitudes& a, const ChartLongitudes& b,
+                 std::vector<AspectHit>& hits) const;
+
+    // One chart against many. Hits for charts [firstChart, lastChart) are appended
+    // ordered by chart, then body1, then body2.
+    void compare(const ChartLongitudes& a, const ChartLongitudeMatrix& charts,
+                 std::vector<AspectHit>& hits,
+                 size_t firstChart = 0, size_t lastChart = SIZE_MAX) const;
+
+    // Number of aspects per chart, without materializing the hits
+    void countAspects(const ChartLongitudes& a, const ChartLongitudeMatrix& charts,
+                      std::vector<uint32_t>& counts) const;
+
+private:
+    static constexpr size_t ASPECT_COUNT = AspectCalculator::ASPECT_COUNT;
+
+    // Charts classified per pass; keeps the per-pair mask buffers in L1/L2
+    static constexpr size_t BLOCK_CHARTS = 128;
+
+    std::array<double, ASPECT_COUNT> angles;
+    std::array<double, ASPECT_COUNT> orbs;
+
+    // Aspect mask of one longitude against count others: bit i is set when
+    // SUPPORTED_ASPECTS[i] is within orb. Stored as float so the loop stays in
+    // floating point registers, which SSE2 can vectorize.
+    void classify(double longitude, const double* others, size_t count, float* masks) const;
+
+    // Index of the first aspect in a non-zero mask
+    static size_t firstAspect(float mask);
+
+    double orbOf(double longitude1, double longitude2, size_t aspect) const;
+};
+
+} // namespace Astro
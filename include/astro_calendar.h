@@ -14,10 +14,12 @@ namespace Astro {
 
 // Forward declarations
 class HinduCalendar;
+class JsonWriter;
 class MyanmarCalendar;
 class EphemerisManager;
 class PlanetCalculator;
 class KPSystem;
+class TransitEventFinder;
 
 // Enhanced planetary transition types
 enum class TransitionType {
@@ -152,6 +154,36 @@ struct AstroCalendarMonth {
 };
 
 // Main Astro Calendar System
+// Ephemeris samples for a run of consecutive days (noon UT, one day apart),
+// one column per body and quantity. The day pipeline fills it once per day
+// range and every stage (Panchanga, lunar phases, KP lords, positions) reads
+// from it; row i + 1 doubles as the "next day" of row i.
+struct DaySampleBuffer {
+    // Sampled bodies in planetPositions order; the South Node is derived
+    // from the North Node
+    static constexpr int BODY_COUNT = 12;
+    static const std::array<Planet, BODY_COUNT> bodies;
+
+    double firstJulianDay = 0.0;
+    int days = 0;              // rows with Panchanga samples
+    int rows = 0;              // rows with body samples (days, or days + 1 for KP)
+    int bodyCount = 0;         // leading entries of bodies that were sampled
+
+    // Tropical geocentric (swe_calc_ut, SEFLG_SWIEPH | SEFLG_SPEED)
+    std::array<std::vector<double>, BODY_COUNT> longitude;
+    std::array<std::vector<double>, BODY_COUNT> latitude;
+    std::array<std::vector<double>, BODY_COUNT> distance;
+    std::array<std::vector<double>, BODY_COUNT> speed;
+    std::array<std::vector<char>, BODY_COUNT> valid;
+
+    // Sidereal Sun and Moon for the Panchanga (swe_calc, SEFLG_SIDEREAL | SEFLG_SPEED)
+    std::vector<double> siderealSun, siderealSunSpeed;
+    std::vector<double> siderealMoon, siderealMoonSpeed;
+    std::vector<char> siderealValid;
+
+    double julianDay(int row) const { return firstJulianDay + row; }
+};
+
 class AstroCalendar {
 private:
     // Calendar systems
@@ -160,6 +192,7 @@ private:
     std::unique_ptr<EphemerisManager> ephemerisManager;
     std::unique_ptr<PlanetCalculator> planetCalculator;
     std::unique_ptr<KPSystem> kpSystem;
+    std::unique_ptr<TransitEventFinder> transitFinder;   // exact ingresses and stations, cached per year
 
     // Configuration
     double latitude = 0.0;
@@ -176,16 +209,23 @@ private:
     mutable std::string lastError;
 
     // Internal calculation methods
-    AstroCalendarDay calculateDayData(double julianDay, int gregYear, int gregMonth, int gregDay) const;
-    std::vector<PlanetaryTransition> calculatePlanetaryTransitions(double julianDay) const;
+    void sampleDays(double firstJulianDay, int days, DaySampleBuffer& samples) const;
+    AstroCalendarDay calculateDayData(const DaySampleBuffer& samples, int row,
+                                      int gregYear, int gregMonth, int gregDay) const;
+    std::vector<PlanetaryTransition> calculatePlanetaryTransitions(const DaySampleBuffer& samples, int row) const;
     std::vector<PlanetaryTransition> findMonthlyTransitions(int year, int month) const;
-    std::vector<KPStarLordTransition> calculateKPTransitions(double julianDay) const;
+    std::vector<PlanetaryTransition> findTransitionsBetween(double startJD, double endJD) const;
+    std::vector<KPStarLordTransition> calculateKPTransitions(const DaySampleBuffer& samples, int row) const;
+    void fillPlanetPositions(const DaySampleBuffer& samples, int row, AstroCalendarDay& day) const;
     std::vector<PlanetaryTransition> findAdvancedTransitions(int year, int month) const;
 
     // Festival and event compilation
     void compileFestivalsAndEvents(AstroCalendarDay& day) const;
     void calculateDayQuality(AstroCalendarDay& day) const;
 
+    // One day as a JSON object, shared by the day and month outputs
+    void writeJSON(JsonWriter& json, const AstroCalendarDay& day) const;
+
     // Planetary calculations
     bool isPlanetRetrograde(Planet planet, double julianDay) const;
     double calculateConjunctionOrb(Planet planet1, Planet planet2, double julianDay) const;
@@ -217,6 +257,7 @@ private:
     int countCautionDays(const AstroCalendarMonth& monthData) const;
     std::string formatAstroCalendarDate(const AstroCalendarDay& day) const;
     std::string getPlanetaryWeather(const std::vector<PlanetaryTransition>& transitions) const;
+    std::string formatMonthlyTransitions(const AstroCalendarMonth& monthData) const;
     std::string formatEnhancedDate(const AstroCalendarDay& day) const;
     std::string getSeasonName(int month) const;
     std::string generateDetailedDayView(const AstroCalendarDay& day) const;
@@ -19,6 +19,9 @@ public:
     // Set house cusps
     void setHouseCusps(const HouseCusps& cusps);
 
+    // Set the house system the cusps were calculated with
+    void setHouseSystem(HouseSystem system);
+
     // Set aspects
     void setAspects(const std::vector<Aspect>& aspects);
 
@@ -53,6 +56,7 @@ public:
     const BirthData& getBirthData() const { return birthData; }
     const std::vector<PlanetPosition>& getPlanetPositions() const { return planetPositions; }
     const HouseCusps& getHouseCusps() const { return houseCusps; }
+    HouseSystem getHouseSystem() const { return houseSystem; }
     const std::vector<Aspect>& getAspects() const { return aspects; }
     ZodiacMode getZodiacMode() const { return zodiacMode; }
     AyanamsaType getAyanamsa() const { return ayanamsa; }
@@ -61,6 +65,7 @@ private:
     BirthData birthData;
     std::vector<PlanetPosition> planetPositions;
     HouseCusps houseCusps;
+    HouseSystem houseSystem;
     std::vector<Aspect> aspects;
     ZodiacMode zodiacMode;
     AyanamsaType ayanamsa;
@@ -0,0 +1,67 @@
+#pragma once
+
+#include "hindu_calendar.h"
+#include "myanmar_calendar.h"
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace Astro {
+
+// One civil day, sampled at noon UT like the monthly calendars
+struct CalendarDay {
+    int day;
+    double julianDay;
+    PanchangaData panchanga;        // empty unless the stream includes Hindu data
+    MyanmarCalendarData myanmar;    // empty unless the stream includes Myanmar data
+};
+
+struct CalendarMonthDays {
+    int year;                       // negative for BC, as in HinduMonthlyCalendar
+    int month;
+    std::vector<CalendarDay> days;
+};
+
+// Day-by-day Panchanga and Myanmar dates for a run of Gregorian months,
+// computed once so the Hindu monthly, Myanmar monthly and combined views of a
+// multi-year almanac all read the same days. Months are spread over worker
+// threads, each with its own HinduCalendar and MyanmarCalendar (Swiss
+// Ephemeris settings and the rise/set cache are per thread), and always come
+// back in calendar order.
+class CalendarDayStream {
+public:
+    CalendarDayStream();
+
+    void setLocation(double latitude, double longitude);
+    void setAyanamsa(AyanamsaType ayanamsa, CalculationMethod method = CalculationMethod::DRIK_SIDDHANTA);
+    void setIncludeHindu(bool include) { includeHindu = include; }
+    void setIncludeMyanmar(bool include) { includeMyanmar = include; }
+
+    // 0 uses one thread per core
+    void setThreadCount(unsigned threads) { threadCount = threads; }
+
+    // months consecutive months starting at startYear-startMonth
+    bool generate(int startYear, int startMonth, int months, std::vector<CalendarMonthDays>& result) const;
+
+    std::string getLastError() const { return lastError; }
+
+    // Calls render(0) .. render(count - 1) on worker threads and returns the
+    // pages in index order. render must only read shared state.
+    static std::vector<std::string> renderPages(size_t count, unsigned threads,
+                                                const std::function<std::string(size_t)>& render);
+
+private:
+    double latitude;
+    double longitude;
+    AyanamsaType ayanamsa;
+    CalculationMethod calculationMethod;
+    bool includeHindu;
+    bool includeMyanmar;
+    unsigned threadCount;
+    mutable std::string lastError;
+
+    static unsigned workerCount(unsigned requested, size_t jobs);
+    static int daysInMonth(int year, int month);
+};
+
+} // namespace Astro
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace Astro {
+
+// Writes a time-lapse as a sequence of text frames of the same shape.
+// ANSI output draws the first frame in full and then rewrites only the part
+// of each row that changed; STREAM output writes every frame in full,
+// separated by form feeds, for piping into other tools.
+class ChartAnimator {
+public:
+    enum class Output { ANSI, STREAM };
+
+    ChartAnimator(std::ostream& out, Output output);
+
+    // Write the next frame; the caption is shown above the rows
+    void writeFrame(const std::string& caption, const std::vector<std::string>& rows);
+
+    // Leave the cursor below the last frame
+    void finish();
+
+    size_t getFrameCount() const { return frameCount; }
+
+    static bool parseOutput(const std::string& name, Output& output);
+
+private:
+    std::ostream& out;
+    Output output;
+    size_t frameCount;
+    std::string previousCaption;
+    std::vector<std::string> previousRows;
+
+    void writeFullFrame(const std::string& caption, const std::vector<std::string>& rows);
+    void writeChangedRow(int line, const std::string& previous, const std::string& row);
+};
+
+} // namespace Astro
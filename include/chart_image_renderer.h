@@ -0,0 +1,41 @@
+#pragma once
+
+#include "birth_chart.h"
+#include <string>
+#include <vector>
+
+namespace Astro {
+
+// Renders the Western wheel and the North, South and East Indian grids as
+// SVG or PNG images. Everything that does not depend on the chart (circles,
+// sign ring, grid lines, glyph outlines, and for PNG the rasterized frame) is
+// built once per style and shared by every chart rendered afterwards, so a
+// chart costs only its planets, cusps and aspects.
+class ChartImageRenderer {
+public:
+    enum class Format { SVG, PNG };
+
+    ChartImageRenderer();
+
+    // western, north-indian, south-indian or east-indian
+    bool setChartStyle(const std::string& style);
+    const std::string& getChartStyle() const { return chartStyle; }
+
+    // Append the rendered chart to output
+    bool render(const BirthChart& chart, Format format, std::string& output) const;
+
+    std::string getLastError() const { return lastError; }
+
+    static bool parseFormat(const std::string& name, Format& format);
+
+    // PNG for a .png file name, SVG otherwise
+    static Format formatForFile(const std::string& filename);
+
+    static std::vector<std::string> getAvailableStyles();
+
+private:
+    std::string chartStyle;
+    mutable std::string lastError;
+};
+
+} // namespace Astro
@@ -0,0 +1,144 @@
+#pragma once
+
+#include "location_manager.h"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace Astro {
+
+// Request latency accounting for the server, kept per command.
+// Latencies are recorded in microseconds into log-linear buckets (four per power
+// of two), so percentiles are exact to within about 20%.
+class ServerMetrics {
+public:
+    ServerMetrics();
+
+    void record(const std::string& command, uint64_t micros, bool ok);
+
+    // {"uptime_s":..,"requests":..,"errors":..,"commands":{"chart":{"count":..,"p50_us":..},..}}
+    std::string toJSON(int workers, size_t queueDepth) const;
+
+    // One line per command, for the shutdown log
+    std::string summary() const;
+
+private:
+    static constexpr int BUCKETS = 128;
+
+    struct CommandStats {
+        uint64_t count = 0;
+        uint64_t errors = 0;
+        uint64_t totalMicros = 0;
+        uint64_t maxMicros = 0;
+        uint64_t buckets[BUCKETS] = {};
+
+        uint64_t percentile(double fraction) const;
+    };
+
+    mutable std::mutex mutex;
+    std::map<std::string, CommandStats> commands;
+    std::chrono::steady_clock::time_point startTime;
+
+    static int bucketOf(uint64_t micros);
+    static uint64_t bucketUpperBound(int bucket);
+};
+
+// Long-running server mode (--serve). Listens on a Unix domain socket and answers
+// line-delimited JSON requests from a pool of worker threads, each owning warm
+// calculators (ephemeris, Hindu/Myanmar calendars, KP subdivisions), so a request
+// costs only its own calculation.
+//
+// Each request is one JSON object on one line. "command" selects the operation and
+// the remaining members mirror the command-line options without their dashes:
+//
+//   {"id":1,"command":"chart","date":"1990-01-15","time":"14:30:00","location":"New York"}
+//   {"id":2,"command":"panchanga","date":"2024-03-25","lat":28.61,"lon":77.21,"timezone":5.5}
+//
+// Commands: chart (the default), panchanga, myanmar, kp, search-location,
+// nearest-location (lat, lon, and limit or radius in km), stats, ping.
+// Chart options: date, time, lat, lon, timezone, tz (IANA zone), location,
+// house-system, zodiac-mode, ayanamsa. A location or tz resolves the UTC
+// offset in effect at the date and time, daylight saving included. Each
+// response is one line,
+//
+//   {"id":1,"ok":true,"elapsed_us":412,"result":{...}}
+//   {"id":1,"ok":false,"error":"..."}
+//
+// with "id" echoed from the request. Requests on one connection are served
+// concurrently, so responses may arrive out of order; match them by id.
+class ChartServer {
+public:
+    struct Options {
+        std::string socketPath;
+        std::string ephemerisPath;
+        std::string festivalRulesFile;
+        int workers = 0;                // 0 = one per hardware thread
+    };
+
+    ChartServer();
+    ~ChartServer();
+
+    ChartServer(const ChartServer&) = delete;
+    ChartServer& operator=(const ChartServer&) = delete;
+
+    // Bind the socket and start the workers. Fails if another server is
+    // listening on the path or a worker cannot initialize.
+    bool start(const Options& options);
+
+    // Serve until stop() (or SIGINT/SIGTERM); removes the socket on return
+    bool run();
+
+    // Safe to call from any thread
+    void stop();
+
+    const ServerMetrics& getMetrics() const { return metrics; }
+    std::string getLastError() const { return lastError; }
+
+private:
+    struct Connection;
+    class Worker;
+
+    struct Job {
+        std::shared_ptr<Connection> connection;
+        std::string line;
+        std::chrono::steady_clock::time_point received;
+    };
+
+    Options options;
+    LocationManager locationManager;   // read-only once built, shared by the workers
+    ServerMetrics metrics;
+
+    int listenFd;
+    int wakePipe[2];
+    std::atomic<bool> stopping;
+
+    std::vector<std::thread> workerThreads;
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<Job> queue;
+    bool queueClosed;
+
+    std::mutex startupMutex;
+    std::condition_variable startupDone;
+    int workersReady;
+    std::string workerError;
+
+    std::string lastError;
+
+    bool bindSocket();
+    void startWorkers(int count);
+    void stopWorkers();
+    void workerLoop();
+    void enqueue(const std::shared_ptr<Connection>& connection, std::string line);
+    bool readFrom(const std::shared_ptr<Connection>& connection);
+};
+
+} // namespace Astro
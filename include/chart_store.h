@@ -0,0 +1,168 @@
+#pragma once
+
+#include "aspect_matrix.h"
+#include "astro_types.h"
+#include "birth_chart.h"
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace Astro {
+
+// One natal chart in a chart store file. Fixed width so that record i lives at
+// HEADER_SIZE + i * sizeof(ChartRecord) and the file can be memory-mapped.
+// Longitudes are in the store's zodiac mode.
+struct ChartRecord {
+    static constexpr size_t BODY_COUNT = 14;   // Planet::SUN .. Planet::LILITH
+
+    uint64_t id;                 // caller-supplied key
+    double julianDay;            // UT
+    int16_t year;                // local birth date and time
+    uint8_t month;
+    uint8_t day;
+    uint8_t hour;
+    uint8_t minute;
+    uint8_t second;
+    uint8_t reserved0;
+    float latitude;
+    float longitude;
+    float timezone;
+    float ayanamsa;              // degrees at julianDay, for nakshatra queries on tropical stores
+    uint32_t bodyMask;           // bit p set when Planet p was calculated
+    float longitudes[BODY_COUNT];
+    float speeds[BODY_COUNT];
+    float cusps[12];             // houses 1-12
+    float ascendant;
+    float midheaven;
+    uint8_t houses[BODY_COUNT];  // 1-12, 0 if the body is missing
+    uint8_t reserved1[6];
+
+    bool hasBody(Planet planet) const {
+        return (bodyMask >> static_cast<int>(planet)) & 1u;
+    }
+
+    // Build a record from a calculated chart. ayanamsaDegrees is stored as is.
+    static ChartRecord fromChart(uint64_t id, const BirthChart& chart, double ayanamsaDegrees);
+};
+
+static_assert(sizeof(ChartRecord) == 232, "ChartRecord layout is part of the file format");
+
+// Placement filter. All conditions must hold (logical AND).
+class ChartQuery {
+public:
+    ChartQuery& sign(Planet planet, ZodiacSign sign);
+    ChartQuery& house(Planet planet, int house);
+
+    // Nakshatra 1 (Ashwini) .. 27 (Revati) of the sidereal longitude
+    ChartQuery& nakshatra(Planet planet, int nakshatra);
+
+    ChartQuery& ascendantSign(ZodiacSign sign);
+
+    bool empty() const { return conditions.empty(); }
+
+private:
+    friend class ChartStore;
+
+    struct Condition {
+        enum class Kind : uint8_t { LONGITUDE, SIDEREAL_LONGITUDE, HOUSE, ASCENDANT };
+        Kind kind;
+        uint8_t body;
+        uint8_t house;
+        float from;    // longitude range [from, to)
+        float to;
+    };
+
+    std::vector<Condition> conditions;
+};
+
+// Appends ChartRecords to a store file
+class ChartStoreWriter {
+public:
+    ChartStoreWriter();
+    ~ChartStoreWriter();
+
+    ChartStoreWriter(const ChartStoreWriter&) = delete;
+    ChartStoreWriter& operator=(const ChartStoreWriter&) = delete;
+
+    // Create (or truncate) a store for charts calculated with these settings
+    bool create(const std::string& filename, ZodiacMode zodiacMode,
+                AyanamsaType ayanamsa, HouseSystem houseSystem);
+
+    // Continue an existing store
+    bool openForAppend(const std::string& filename);
+
+    // Add a calculated chart; its zodiac mode, ayanamsa and house system must
+    // match the store
+    bool append(uint64_t id, const BirthChart& chart);
+    bool append(const ChartRecord& record);
+
+    // Write the record count to the header and close the file
+    bool close();
+
+    uint64_t getRecordCount() const { return recordCount; }
+    std::string getLastError() const { return lastError; }
+
+private:
+    std::fstream file;
+    uint64_t recordCount;
+    ZodiacMode zodiacMode;
+    AyanamsaType ayanamsa;
+    HouseSystem houseSystem;
+    std::string lastError;
+};
+
+// Read-only, memory-mapped view of a store file
+class ChartStore {
+public:
+    ChartStore();
+    ~ChartStore();
+
+    ChartStore(const ChartStore&) = delete;
+    ChartStore& operator=(const ChartStore&) = delete;
+
+    bool open(const std::string& filename);
+    void close();
+    bool isOpen() const { return mapping != nullptr; }
+
+    size_t size() const { return recordCount; }
+    const ChartRecord& record(size_t index) const { return records[index]; }
+
+    ZodiacMode getZodiacMode() const { return zodiacMode; }
+    AyanamsaType getAyanamsa() const { return ayanamsa; }
+    HouseSystem getHouseSystem() const { return houseSystem; }
+
+    // Indices of the records matching every condition, in file order
+    std::vector<uint32_t> query(const ChartQuery& query) const;
+    size_t count(const ChartQuery& query) const;
+
+    // Stored data in the forms the calculators use
+    BirthData birthData(size_t index) const;
+    std::vector<PlanetPosition> planetPositions(size_t index) const;
+    HouseCusps houseCusps(size_t index) const;
+
+    // Feeds for AspectMatrix (and anything else taking longitudes). Matrix chart i
+    // is record indices[i]; a body missing from a record gets a NaN longitude,
+    // which never forms an aspect.
+    ChartLongitudes longitudes(size_t index) const;
+    ChartLongitudeMatrix longitudeMatrix(const std::vector<Planet>& planets,
+                                         const std::vector<uint32_t>& indices) const;
+    ChartLongitudeMatrix longitudeMatrix(const std::vector<Planet>& planets) const;
+
+    std::string getLastError() const { return lastError; }
+
+private:
+    void* mapping;
+    size_t mappingSize;
+    const ChartRecord* records;
+    size_t recordCount;
+    ZodiacMode zodiacMode;
+    AyanamsaType ayanamsa;
+    HouseSystem houseSystem;
+    std::string lastError;
+
+    bool matches(const ChartRecord& record, const ChartQuery& query) const;
+};
+
+} // namespace Astro
@@ -1,7 +1,9 @@
 #pragma once
 
 #include "astro_types.h"
+#include <functional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace Astro {
@@ -38,6 +40,19 @@ struct ConjunctionEvent {
     std::string getPlanetsString() const;
 };
 
+// Moment two bodies share a geocentric tropical ecliptic longitude, as
+// streamed by ConjunctionCalculator::forEachConjunction()
+struct ExactConjunction {
+    Planet planet1;
+    Planet planet2;
+    double julianDay;               // UT
+    double longitude;
+    double latitude1;
+    double latitude2;
+    double distance1;               // AU
+    double distance2;
+};
+
 class ConjunctionCalculator {
 public:
     ConjunctionCalculator();
@@ -85,12 +100,30 @@ public:
     std::vector<ConjunctionEvent> findGrahaYuddha(const BirthData& fromDate, const BirthData& toDate,
                                                   double maxOrb = 1.0) const;
 
+    // Calls onEvent for every exact conjunction in longitude of the given
+    // pairs with startJD <= julianDay < endJD (UT), in time order, without
+    // collecting them. The bodies are sampled once per step for all pairs
+    // together: a quarter day with the Moon, a day with the Sun to Mars, five
+    // days for slower bodies. A sign change of a pair's longitude difference
+    // is refined by Newton steps on the difference of speeds, kept inside the
+    // bracket; a step in which the pair turns back towards zero is also
+    // sampled at the turn. A retrograde loop gives one event per crossing.
+    bool forEachConjunction(const std::vector<std::pair<Planet, Planet>>& pairs, double startJD, double endJD,
+                            const std::function<void(const ExactConjunction&)>& onEvent) const;
+
     // Check if conjunction qualifies as Graha Yuddha
     bool isGrahaYuddha(const ConjunctionEvent& conjunction) const;
 
+    // Whether both planets take part in Graha Yuddha (Mercury, Venus, Mars, Jupiter, Saturn)
+    static bool isGrahaYuddhaPair(Planet planet1, Planet planet2);
+
     // Get winner planet in Graha Yuddha based on Vedic rules
     Planet getGrahaYuddhaWinner(Planet planet1, Planet planet2, double julianDay) const;
 
+    // Same rules for positions already at hand
+    static Planet getGrahaYuddhaWinner(Planet planet1, double latitude1, double distance1,
+                                       Planet planet2, double latitude2, double distance2);
+
     // Generate formatted conjunction report
     std::string generateConjunctionReport(const std::vector<ConjunctionEvent>& conjunctions) const;
 
@@ -143,7 +176,7 @@ private:
     void sortConjunctionsByDate(std::vector<ConjunctionEvent>& conjunctions) const;
 
     // Helper methods for Graha Yuddha
-    Planet getStrongerPlanetByHierarchy(Planet planet1, Planet planet2) const;
+    static Planet getStrongerPlanetByHierarchy(Planet planet1, Planet planet2);
     std::string getGrahaYuddhaEffectDescription(Planet winner, Planet planet1, Planet planet2) const;
 };
 
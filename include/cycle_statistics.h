@@ -0,0 +1,143 @@
+#pragma once
+
+#include "astro_types.h"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace Astro {
+
+class ConjunctionCalculator;
+class TransitEventFinder;
+
+// Distribution of a duration in days: count, mean and variance by Welford's
+// update, extremes, and a histogram of BINS_PER_OCTAVE bins per doubling
+// from one day (bin 0 also takes anything shorter). Summaries of disjoint
+// runs merge exactly, so time slices can be reduced in any grouping.
+struct DurationStatistics {
+    static const int BINS_PER_OCTAVE = 8;
+
+    uint64_t count = 0;
+    double mean = 0.0;
+    double sumSquares = 0.0;        // of deviations from the mean
+    double minimum = 0.0;
+    double maximum = 0.0;
+    std::vector<uint64_t> histogram;
+
+    void add(double days);
+    void merge(const DurationStatistics& other);
+
+    double variance() const;        // sample variance; 0 below two values
+    double standardDeviation() const;
+
+    static double binStart(size_t bin);
+};
+
+// One pair's exact conjunctions in longitude over the whole range
+struct PairCycleStatistics {
+    Planet planet1;
+    Planet planet2;
+    uint64_t conjunctions = 0;
+    DurationStatistics intervals;                   // between successive conjunctions
+    std::array<uint64_t, 12> bySign{};
+    std::vector<uint64_t> byCentury;                // from CycleSummary::firstCentury
+
+    // Graha Yuddha: both planets among the five, latitudes within the orb
+    bool grahaYuddhaPair = false;
+    uint64_t grahaYuddha = 0;
+    std::array<uint64_t, 2> grahaYuddhaWins{};      // planet1, planet2
+    std::vector<uint64_t> grahaYuddhaByCentury;
+
+    // First and last conjunction, to join the interval across slices
+    double firstJD = 0.0;
+    double lastJD = 0.0;
+};
+
+// One planet's retrograde periods, station retrograde to station direct.
+// Periods cut by either end of the range are not counted.
+struct RetrogradeStatistics {
+    Planet planet;
+    DurationStatistics durations;
+    std::array<uint64_t, 12> bySign{};              // retrograde stations, by sign
+    std::vector<uint64_t> byCentury;                // retrograde stations
+
+    // First and last station, to join the period across slices
+    uint64_t stations = 0;
+    double firstStationJD = 0.0;
+    bool firstStationRetrograde = false;
+    double lastStationJD = 0.0;
+    bool lastStationRetrograde = false;
+};
+
+struct CycleSummary {
+    double startJD = 0.0;
+    double endJD = 0.0;
+    int firstCentury = 0;           // floor(year / 100) of the start, astronomical years
+    ZodiacMode zodiacMode = ZodiacMode::TROPICAL;
+    AyanamsaType ayanamsa = AyanamsaType::LAHIRI;
+    double grahaYuddhaOrb = 1.0;
+    unsigned slices = 0;
+    unsigned threads = 0;
+    std::vector<PairCycleStatistics> pairs;
+    std::vector<RetrogradeStatistics> retrogrades;
+};
+
+// Long-range cycle statistics: intervals between conjunctions of planet
+// pairs, Graha Yuddha counts and winners, and retrograde durations, reduced
+// as the events are found rather than collected. The range is cut into
+// slices (ten years by default) spread over worker threads, each with its
+// own ConjunctionCalculator and TransitEventFinder; every slice fills its own
+// summary, and the summaries are folded in time order, joining the interval
+// or retrograde period that spans each slice boundary.
+class CycleStatistics {
+public:
+    CycleStatistics();
+
+    bool initialize(const std::string& ephemerisPath = "");
+
+    // Default: Jupiter - Saturn, no retrograde planets
+    void setPairs(const std::vector<std::pair<Planet, Planet>>& pairList) { pairs = pairList; }
+    void setRetrogradePlanets(const std::vector<Planet>& planets) { retrogradePlanets = planets; }
+
+    // Signs are taken in this zodiac; the events themselves do not depend on it
+    void setZodiacMode(ZodiacMode mode, AyanamsaType type = AyanamsaType::LAHIRI);
+
+    // Largest difference in ecliptic latitude at the conjunction
+    void setGrahaYuddhaOrb(double degrees) { grahaYuddhaOrb = degrees; }
+
+    // 0 uses one thread per core
+    void setThreadCount(unsigned threads) { threadCount = threads; }
+    void setSliceDays(double days) { sliceDays = days; }
+
+    bool compute(double startJD, double endJD, CycleSummary& summary) const;
+
+    std::string generateReport(const CycleSummary& summary) const;
+    std::string generateJSON(const CycleSummary& summary) const;
+
+    std::string getLastError() const { return lastError; }
+
+    // The ten pairs of Mercury, Venus, Mars, Jupiter and Saturn
+    static std::vector<std::pair<Planet, Planet>> grahaYuddhaPairs();
+
+private:
+    bool isInitialized;
+    std::string ephemerisPath;
+    std::vector<std::pair<Planet, Planet>> pairs;
+    std::vector<Planet> retrogradePlanets;
+    ZodiacMode zodiacMode;
+    AyanamsaType ayanamsa;
+    double grahaYuddhaOrb;
+    unsigned threadCount;
+    double sliceDays;
+    mutable std::string lastError;
+
+    CycleSummary emptySummary(double startJD, double endJD) const;
+    bool computeSlice(const ConjunctionCalculator& conjunctions, const TransitEventFinder& stations,
+                      double startJD, double endJD, CycleSummary& slice, std::string& error) const;
+    static void mergeInto(CycleSummary& total, const CycleSummary& slice);
+    static int centuryOf(double julianDay);
+};
+
+} // namespace Astro
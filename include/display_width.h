@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace Astro {
+
+// Terminal column widths of UTF-8 text, shared by the table, calendar and
+// chart renderers. Combining marks, format characters and ANSI escape
+// sequences take no columns; East Asian wide and fullwidth characters,
+// emoji included, take two; everything else takes one. Devanagari and
+// Myanmar consonants count one column and their dependent signs none (or
+// one for spacing vowel signs), as terminals draw them.
+//
+// Runs of plain ASCII are scanned 16 bytes at a time, and the widths of
+// short non-ASCII strings are remembered per thread, so re-measuring the
+// same glyph or label while padding costs one lookup.
+
+// Width of a single code point: 0, 1 or 2
+int codepointWidth(char32_t codepoint);
+
+// Width of a UTF-8 string, skipping ANSI escape sequences
+int displayWidth(const std::string& text);
+int displayWidth(const char* text, size_t length);
+
+// Number of leading bytes that fit in the given number of columns, never
+// splitting a character or an escape sequence; trailing zero-width marks
+// stay with their base character
+size_t byteOffsetForWidth(const std::string& text, int columns);
+size_t byteOffsetForWidth(const char* text, size_t length, int columns);
+
+// First columns of the text, followed by any escape sequences from the
+// part cut off (so colors are still reset)
+std::string truncateToWidth(const std::string& text, int columns);
+
+// Text padded with spaces to the given width; text that is already at least
+// that wide comes back unchanged
+std::string padToWidth(const std::string& text, int width, bool rightAlign = false);
+std::string centerToWidth(const std::string& text, int width);
+
+} // namespace Astro
@@ -22,39 +22,48 @@ public:
     // Draw East Indian style chart
     std::string drawEastIndianChart(const BirthChart& chart) const;
 
+    // Frame-by-frame drawing for time-lapse output. The state holds the last
+    // grid and the planets shown in each house; an update redraws only the
+    // houses whose planets changed and returns how many that was.
+    struct GridState {
+        std::string style;
+        std::vector<std::string> rows;
+        std::vector<std::string> houses;    // Index 1-12
+    };
+    int updateGrid(GridState& state, const BirthChart& chart) const;
+
+    // Empty grid of a chart style and where each house's planets go
+    struct HouseCell {
+        int line;
+        int col;
+        int width;
+    };
+    struct GridLayout {
+        std::vector<std::string> frame;
+        HouseCell cells[13];        // Index 1-12; width 0 if the house is not shown
+        bool clipToWidth;           // Long content fills the cell instead of width - 1
+    };
+    static const GridLayout& getLayout(const std::string& style);
+
     // Set chart style
     void setChartStyle(const std::string& style);
 
     // Get available chart styles
     static std::vector<std::string> getAvailableStyles();
 
+    // Short planet names used in the house cells ("Su", "Mo", ...)
+    static std::string getShortPlanetName(Planet planet);
+
 private:
     std::string chartStyle;
 
     // Helper functions for chart drawing
-    std::string getPlanetsInHouse(const std::vector<PlanetPosition>& positions, int house) const;
-    std::string getShortPlanetName(Planet planet) const;
+    std::vector<std::string> getHouseContents(const std::vector<PlanetPosition>& positions) const;
     std::string formatHouseContent(const std::string& content, int width) const;
-
-    // North Indian chart specific functions
-    std::string drawNorthIndianFrame() const;
-    void fillNorthIndianHouses(std::vector<std::string>& lines,
-                              const std::vector<PlanetPosition>& positions) const;
-
-    // South Indian chart specific functions
-    std::string drawSouthIndianFrame() const;
-    void fillSouthIndianHouses(std::vector<std::string>& lines,
-                              const std::vector<PlanetPosition>& positions) const;
-
-    // East Indian chart specific functions
-    std::string drawEastIndianFrame() const;
-    void fillEastIndianHouses(std::vector<std::string>& lines,
-                             const std::vector<PlanetPosition>& positions) const;
-
-    // Get house number mapping for different chart styles
-    int getNorthIndianHousePosition(int house) const;
-    int getSouthIndianHousePosition(int house) const;
-    int getEastIndianHousePosition(int house) const;
+    void drawHouse(std::vector<std::string>& lines, const GridLayout& layout,
+                   int house, const std::string& planets) const;
+    int updateGrid(GridState& state, const BirthChart& chart, const std::string& style) const;
+    std::string drawGrid(const BirthChart& chart, const std::string& style) const;
 };
 
 } // namespace Astro
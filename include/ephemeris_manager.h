@@ -1,7 +1,10 @@
 #pragma once
 
 #include "astro_types.h"
+#include "position_stream.h"
+#include <map>
 #include <string>
+#include <tuple>
 
 namespace Astro {
 
@@ -24,6 +27,17 @@ public:
                                ZodiacMode zodiacMode, AyanamsaType ayanamsa,
                                const std::vector<CalculationFlag>& flags = {});
 
+    // Serve the zodiac-mode calculatePlanetPosition() from per-body position
+    // streams (see position_stream.h) for callers that walk forward in time
+    // about step days at a time, interpolating within tolerance degrees. A
+    // tolerance of 0 computes every position exactly.
+    void setPositionStep(double step, double tolerance);
+
+    // The zodiac-mode calculatePlanetPosition() also derives the orbital
+    // inclination, which costs several ephemeris calls; callers that never
+    // show it can leave it at 0
+    void setIncludeInclination(bool include) { includeInclination = include; }
+
     // Calculate house cusps
     bool calculateHouseCusps(double julianDay, double latitude, double longitude,
                            HouseSystem system, HouseCusps& cusps);
@@ -42,6 +56,13 @@ public:
 private:
     std::string lastError;
     bool initialized;
+    bool includeInclination;
+
+    double streamStep;
+    double streamTolerance;
+    std::map<std::tuple<int, int, int>, PositionStream> streams;    // by body, flags and sidereal mode
+
+    int calculatePosition(double julianDay, int ipl, int iflag, int siderealMode, double* xx, char* serr);
 
     // Convert Planet enum to Swiss Ephemeris planet number
     int planetToSwissEph(Planet planet) const;
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "astro_types.h"
+#include <functional>
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -19,10 +21,12 @@ enum class MotionType {
 struct EphemerisEntry {
     double julianDay;
     int year, month, day;
+    int hour = 0, minute = 0;   // UT; shown only in sub-day tables
     double siderealTime;        // Greenwich Sidereal Time in hours
     std::vector<PlanetPosition> positions;
 
     std::string getDateString() const;
+    std::string getTimeString() const;      // HH:MM
     std::string getJulianDateString() const;
     std::string getDayName() const;
     bool shouldUseJulianCalendar() const; // Returns true if date is before Oct 15, 1582
@@ -35,6 +39,8 @@ struct EphemerisConfig {
     BirthData startDate;
     BirthData endDate;
     int intervalDays;           // Interval between entries (1 = daily, 7 = weekly, etc.)
+    int intervalMinutes;        // Minutes between entries for sub-day tables (0 = use intervalDays)
+    double interpolationTolerance; // Degrees; entries between exact ones are interpolated within this (0 = all exact)
     std::vector<Planet> planets; // Planets to include in table
     bool showDegreeMinutes;     // Show degrees and minutes
     bool showSign;              // Show zodiac sign
@@ -60,6 +66,10 @@ struct EphemerisConfig {
     std::string calendarMode;   // Calendar display mode: "jul", "gregorian", "auto", "both"
 
     EphemerisConfig();
+
+    // Spacing of the entries in days, and as shown in headers ("1 day(s)", "30 minute(s)")
+    double getStepDays() const;
+    std::string getIntervalString() const;
 };
 
 class EphemerisTable {
@@ -73,6 +83,12 @@ public:
     // Generate ephemeris table for date range
     std::string generateTable(const EphemerisConfig& config) const;
 
+    // Same, written straight to os. Entries are computed one at a time: the
+    // ASCII table takes one pass to measure and one to emit, CSV and JSON a
+    // single pass, so neither the entries nor the output are held in memory
+    // (the compact and HTML formats still collect the entries first).
+    bool writeTable(const EphemerisConfig& config, std::ostream& os) const;
+
     // Generate table with string dates (convenience methods)
     std::string generateTable(const std::string& fromDate, const std::string& toDate, int intervalDays = 1) const;
     std::string generateCSVTable(const std::string& fromDate, const std::string& toDate, int intervalDays = 1) const;
@@ -120,11 +136,25 @@ private:
     bool isInitialized;
     mutable std::string lastError;
 
+    // Entries are visited in date order; a visitor returns false to stop early
+    using EntryVisitor = std::function<bool(const EphemerisEntry&)>;
+
+    // Walks a table's entries from the start on every call, so output can take several passes
+    using EntryRange = std::function<bool(const EntryVisitor&)>;
+
     // Generate table entries for date range
     std::vector<EphemerisEntry> generateEntries(const EphemerisConfig& config) const;
 
+    // Compute the entries one at a time; false if the ephemeris cannot be set up
+    bool forEachEntry(const EphemerisConfig& config, const EntryVisitor& visit) const;
+    static EntryRange entriesOf(const std::vector<EphemerisEntry>& entries);
+
     // Format table as ASCII
     std::string formatAsTable(const std::vector<EphemerisEntry>& entries, const EphemerisConfig& config) const;
+    bool writeAsTable(std::ostream& os, const EntryRange& entries, const EphemerisConfig& config) const;
+    bool writeCSV(std::ostream& os, const EntryRange& entries, const EphemerisConfig& config) const;
+    bool writeJSON(std::ostream& os, const EntryRange& entries, const EphemerisConfig& config) const;
+    std::string formatDateColumn(const EphemerisEntry& entry, const EphemerisConfig& config) const;
     std::string formatAsCompactTable(const std::vector<EphemerisEntry>& entries, const EphemerisConfig& config) const;
 
     // Get column headers
@@ -135,8 +165,8 @@ private:
     std::string format3LinePosition(const PlanetPosition& position, const EphemerisConfig& config) const;
 
     // Calculate column widths
-    std::vector<int> calculateColumnWidths(const std::vector<EphemerisEntry>& entries,
-                                          const EphemerisConfig& config) const;
+    bool calculateColumnWidths(const EntryRange& entries, const EphemerisConfig& config,
+                               std::vector<int>& widths) const;
 
     // Format table header
     std::string formatTableHeader(const std::vector<std::string>& headers,
@@ -1,12 +1,19 @@
 #pragma once
 
 #include "astro_types.h"
+#include "location_manager.h"
+#include "rise_set_calculator.h"
+#include <cstdint>
+#include <functional>
 #include <string>
+#include <unordered_map>
 #include <vector>
 #include <map>
 
 namespace Astro {
 
+class JsonWriter;
+
 // Hindu calendar elements enumeration
 enum class Tithi {
     PRATIPAD = 1, DWITIYA, TRITIYA, CHATURTHI, PANCHAMI,
@@ -54,6 +61,23 @@ enum class Rashi {
     TULA, VRISHCHIKA, DHANU, MAKARA, KUMBHA, MEENA
 };
 
+// Seasons, directions and varnas used by the Panchanga (NONE = not determined)
+enum class Ritu : uint8_t {
+    NONE = 0, SHISHIRA, VASANTA, GRISHMA, VARSHA, SHARAD, HEMANTA
+};
+
+enum class Ayana : uint8_t {
+    NONE = 0, UTTARAYANA, DAKSHINAYANA
+};
+
+enum class Direction : uint8_t {
+    NONE = 0, EAST, NORTH, SOUTH, WEST
+};
+
+enum class Varna : uint8_t {
+    NONE = 0, BRAHMIN, KSHATRIYA, VAISHYA, SHUDRA
+};
+
 // Calendar calculation methods
 enum class CalculationMethod {
     DRIK_SIDDHANTA = 1,  // Accurate astronomical calculations
@@ -206,6 +230,221 @@ struct PanchangaData {
     std::string getTimeString(double hours) const;  // Convert decimal hours to HH:MM format
 };
 
+// Interned festival/event name; resolve with HinduCalendar::getEventName()
+using FestivalId = uint16_t;
+
+// Fixed-capacity list of interned names; push returns false once it is full
+template <size_t Capacity>
+struct FestivalIdList {
+    uint8_t count;
+    FestivalId ids[Capacity];
+
+    bool push(FestivalId id) {
+        if (count >= Capacity) return false;
+        ids[count++] = id;
+        return true;
+    }
+    bool empty() const { return count == 0; }
+    const FestivalId* begin() const { return ids; }
+    const FestivalId* end() const { return ids + count; }
+};
+
+// A named observance tied to a lunar day, the Sun's entry into a rashi, or the
+// Moon's nakshatra within a (solar) Hindu month
+struct FestivalRule {
+    enum class Kind : uint8_t {
+        TITHI,
+        SANKRANTI,
+        NAKSHATRA
+    };
+
+    Kind kind;
+    int month;          // HinduMonth value for TITHI/NAKSHATRA rules, 0 = every month
+    int tithi;          // TITHI: 1-30 (16-30 = Krishna paksha)
+    int rashi;          // SANKRANTI: Rashi the Sun enters
+    int nakshatra;      // NAKSHATRA: HinduNakshatra value
+    FestivalId name;
+};
+
+// Compact Panchanga for bulk calculations.
+// Holds the same information as PanchangaData but uses enums, flag bits and
+// interned name ids instead of strings and vectors, so filling a record never
+// allocates. Value-initialize (`PanchangaRecord record = {};`) before use;
+// HinduCalendar::toPanchangaData() produces the display form.
+struct PanchangaRecord {
+    enum Flag : uint32_t {
+        SHUKLA            = 1u << 0,
+        EKADASHI          = 1u << 1,
+        PURNIMA           = 1u << 2,
+        AMAVASYA          = 1u << 3,
+        SANKRANTI         = 1u << 4,
+        NAVRATRI          = 1u << 5,
+        GANDA_MOOL        = 1u << 6,
+        PANCHAK           = 1u << 7,
+        BHADRA            = 1u << 8,
+        SARVARTHA_SIDDHI  = 1u << 9,
+        AMRITA_SIDDHI     = 1u << 10,
+        DWIPUSHKAR        = 1u << 11,
+        TRIPUSHKAR        = 1u << 12,
+        RAVI_PUSHYA       = 1u << 13,
+        GURU_PUSHYA       = 1u << 14,
+        SHUBHA_MUHURTA    = 1u << 15,
+        FASTING_DAY       = 1u << 16
+    };
+
+    static constexpr size_t MAX_FESTIVALS = 12;
+    static constexpr size_t MAX_EKADASHI_NAMES = 4;
+    static constexpr size_t MAX_SPECIAL_EVENTS = 4;
+    static constexpr size_t MAX_VRATAS = 6;
+    static constexpr size_t VARJYAM_PERIODS = 2;
+
+    double julianDay;
+
+    // Five limbs and calendar position
+    Tithi tithi;
+    Vara vara;
+    HinduNakshatra nakshatra;
+    Yoga yoga;
+    Karana karana;
+    HinduMonth month;
+    Rashi sunRashi;
+    Rashi moonRashi;
+    int8_t day;                // Day of the paksha (1-15)
+    int8_t nakshatraPada;      // 1-4
+    int year;                  // Vikram Samvat
+    int kaliyugaYear;
+    int shakaYear;
+
+    // Positions and end times (same units as PanchangaData)
+    double sunLongitude;
+    double moonLongitude;
+    double lunarPhase;
+    double ayanamsaValue;
+    double tithiEndTime;
+    double nakshatraEndTime;
+    double yogaEndTime;
+    double karanaEndTime;
+    double nakshatraPadaEndTime;
+
+    // Sunrise-anchored timings (decimal hours)
+    double sunriseTime;
+    double sunsetTime;
+    double moonriseTime;
+    double moonsetTime;
+    double dayLength;
+    double nightLength;
+    double brahmaMuhurtaStart;
+    double brahmaMuhurtaEnd;
+    double abhijitStart;
+    double abhijitEnd;
+    double godhuliBelStart;
+    double godhuliBelEnd;
+    double nishitaMuhurtaStart;
+    double nishitaMuhurtaEnd;
+    double rahuKaalStart;
+    double rahuKaalEnd;
+    double yamagandaStart;
+    double yamagandaEnd;
+    double gulikaiStart;
+    double gulikaiEnd;
+    double durMuhurtamStart;
+    double durMuhurtamEnd;
+    double varjyamStart[VARJYAM_PERIODS];
+    double varjyamEnd[VARJYAM_PERIODS];
+
+    uint32_t flags;
+
+    Ritu ritu;
+    Ayana ayana;
+    Direction dishaShool;
+    Direction nakshatraShool;
+    Varna varnaDay;
+    Varna varnaTithi;
+    Varna varnaNakshatra;
+
+    FestivalIdList<MAX_FESTIVALS> festivals;
+    FestivalIdList<MAX_EKADASHI_NAMES> ekadashiNames;
+    FestivalIdList<MAX_SPECIAL_EVENTS> specialEvents;
+    FestivalIdList<MAX_VRATAS> vrataList;
+
+    bool has(Flag flag) const { return (flags & flag) != 0; }
+    void set(Flag flag) { flags |= flag; }
+};
+
+// Lunar month between consecutive new moons (amanta reckoning)
+struct LunarMonth {
+    double newMoonJD;          // Month start
+    double fullMoonJD;         // Purnimanta months change name here
+    double endJD;              // Next new moon
+    HinduMonth month;          // Named after the Sankranti it contains
+    bool isAdhika;             // No Sankranti inside: intercalary month
+};
+
+// A festival or lunar vrata observed on a civil day
+struct FestivalOccurrence {
+    double julianDay;          // 0h UT of the day, as in calculatePanchangaRange()
+    FestivalId name;
+    bool isVrata;
+    Tithi tithi;
+    HinduMonth month;          // Solar month used by the festival rules
+    HinduMonth amantaMonth;
+    HinduMonth purnimantaMonth;
+    bool isAdhika;
+};
+
+// Festival calendar for one Gregorian year
+struct FestivalCalendar {
+    int year;
+    std::vector<double> sankrantis;            // Sun's ingress into each rashi (JD UT)
+    std::vector<LunarMonth> months;            // Lunar months overlapping the year
+    std::vector<FestivalOccurrence> festivals; // In date order
+    int daysEvaluated;                         // Days on which the Panchanga was computed
+};
+
+// Panchanga for one instant across many locations (structure of arrays).
+// Limbs, festivals and yogas depend only on the instant and are stored once in
+// `common`; sunrise-anchored timings are stored per location.
+struct MultiLocationPanchanga {
+    PanchangaData common = {}; // Location-independent part; varjyamTimes are offsets from sunrise
+
+    std::vector<double> latitudes;
+    std::vector<double> longitudes;
+
+    // Rise/set and day length (decimal hours, same convention as PanchangaData)
+    std::vector<double> sunriseTime;
+    std::vector<double> sunsetTime;
+    std::vector<double> moonriseTime;
+    std::vector<double> moonsetTime;
+    std::vector<double> dayLength;
+    std::vector<double> nightLength;
+
+    // Muhurtas
+    std::vector<double> brahmaMuhurtaStart;
+    std::vector<double> brahmaMuhurtaEnd;
+    std::vector<double> abhijitStart;
+    std::vector<double> abhijitEnd;
+    std::vector<double> godhuliBelStart;
+    std::vector<double> godhuliBelEnd;
+    std::vector<double> nishitaMuhurtaStart;
+    std::vector<double> nishitaMuhurtaEnd;
+
+    // Inauspicious periods
+    std::vector<double> rahuKaalStart;
+    std::vector<double> rahuKaalEnd;
+    std::vector<double> yamagandaStart;
+    std::vector<double> yamagandaEnd;
+    std::vector<double> gulikaiStart;
+    std::vector<double> gulikaiEnd;
+    std::vector<double> durMuhurtamStart;
+    std::vector<double> durMuhurtamEnd;
+
+    size_t size() const { return latitudes.size(); }
+    void resize(size_t count);
+
+    // Assemble the full Panchanga for one location
+    PanchangaData at(size_t index) const;
+};
+
 // Main Hindu Calendar System
 class HinduCalendar {
 private:
@@ -222,49 +461,75 @@ private:
 
     // Nakshatra and star data
     struct NakshatraInfo {
-        std::string name;
-        std::string sanskrit;
+        const char* name;
+        const char* sanskrit;
         Planet lord;
-        std::string symbol;
-        std::string deity;
+        const char* symbol;
+        const char* deity;
         double startDegree;
         double endDegree;
-        std::string nature; // Dev, Manush, Rakshasa
-        std::string gana;
-        std::string quality;
+        const char* nature; // Dev, Manush, Rakshasa
+        const char* gana;
+        const char* quality;
     };
 
     struct TithiInfo {
-        std::string name;
-        std::string sanskrit;
+        const char* name;
+        const char* sanskrit;
         Planet lord;
-        std::string nature;
+        const char* nature;
         bool isShubha; // auspicious
-        std::string significance;
+        const char* significance;
     };
 
     struct YogaInfo {
-        std::string name;
-        std::string sanskrit;
-        std::string nature;
-        std::string effect;
+        const char* name;
+        const char* sanskrit;
+        const char* nature;
+        const char* effect;
     };
 
     struct KaranaInfo {
-        std::string name;
-        std::string sanskrit;
-        std::string nature;
+        const char* name;
+        const char* sanskrit;
+        const char* nature;
         bool isMovable;
     };
 
-    // Data tables
-    std::vector<NakshatraInfo> nakshatraData;
-    std::vector<TithiInfo> tithiData;
-    std::vector<YogaInfo> yogaData;
-    std::vector<KaranaInfo> karanaData;
-
-    // Festival and special event data
-    std::map<std::string, std::vector<std::string>> festivalMap;
+    // Static reference tables (constant-initialized, nothing built at startup)
+    static const NakshatraInfo NAKSHATRA_DATA[27];
+    static const TithiInfo TITHI_DATA[30];
+    static const YogaInfo YOGA_DATA[27];
+    static const KaranaInfo KARANA_DATA[11];
+
+    // Festival rules in load order (built-in first, then user rule files)
+    std::vector<FestivalRule> festivalRules;
+
+    // Interned festival/event names, indexed by FestivalId
+    std::vector<std::string> eventNames;
+    std::unordered_map<std::string, FestivalId> eventIds;
+
+    // Festival rules compiled into direct lookup tables
+    static constexpr size_t MAX_SLOT_FESTIVALS = 6;
+    using FestivalSlot = FestivalIdList<MAX_SLOT_FESTIVALS>;
+    FestivalSlot tithiFestivals[13][31];       // [HinduMonth][Tithi]
+    FestivalSlot sankrantiFestivals[13];       // [Rashi]
+    FestivalSlot nakshatraFestivals[13][28];   // [HinduMonth][HinduNakshatra]
+
+    // Names produced by the special event and vrata rules
+    struct BuiltinEvents {
+        FestivalId ekadashiVrata;
+        FestivalId sankranti[13];          // "Sankranti - <rashi>", by Rashi
+        FestivalId yoga[28];               // auspicious/inauspicious yoga event, by Yoga
+        FestivalId purnimaVrata;
+        FestivalId amavasyaVrata;
+        FestivalId somwarVrata;
+        FestivalId mangalwarVrata;
+        FestivalId shaniwarVrata;
+        FestivalId rohiniVrata;
+        FestivalId gandaMoolShanti;
+    };
+    BuiltinEvents builtinEvents;
 
     // Calculation configuration
     AyanamsaType ayanamsa;
@@ -272,12 +537,14 @@ private:
     CalendarSystem calendarSystem;
     bool useModernCalculations;
 
+    // Sunrise/sunset solver with per-location cache
+    RiseSetCalculator riseSetCalculator;
+
     // Initialization
-    void initializeNakshatraData();
-    void initializeTithiData();
-    void initializeYogaData();
-    void initializeKaranaData();
     void initializeFestivalData();
+    size_t compileFestivalRules();     // returns the number of names that did not fit
+    FestivalId internEventName(const std::string& name);
+    bool parseFestivalRule(const std::string& line, std::vector<FestivalRule>& rules, std::string& error);
 
     // Calculation methods
     double calculateLunarPhase(double sunLong, double moonLong) const;
@@ -312,25 +579,31 @@ private:
     double getAyanamsaValue(double julianDay) const;
     int getSweAyanamsaId() const;
 
+    // Panchanga stages: elements fixed by the instant, then sunrise-anchored timings
+    bool calculateInstantElements(double julianDay, PanchangaRecord& record) const;
+    bool calculateInstantElements(double julianDay, double sunLongitude, double sunSpeed,
+                                  double moonLongitude, double moonSpeed, PanchangaRecord& record) const;
+    void calculateLocationElements(PanchangaRecord& record, const RiseSetTimes& times) const;
+
     // Festival identification
-    void identifyFestivals(PanchangaData& panchanga) const;
-    void identifySpecialEvents(PanchangaData& panchanga) const;
+    void identifyFestivals(PanchangaRecord& record) const;
+    void identifySpecialEvents(PanchangaRecord& record) const;
 
     // Muhurta calculations
-    void calculateMuhurta(PanchangaData& panchanga) const;
-    void calculateSunMoonTimes(PanchangaData& panchanga, double latitude, double longitude) const;
-    void calculateRahuKaal(PanchangaData& panchanga) const;
-    void calculateYamaganda(PanchangaData& panchanga) const;
-    void calculateGulikai(PanchangaData& panchanga) const;
-    void calculateDurMuhurtam(PanchangaData& panchanga) const;
-    void calculateVarjyam(PanchangaData& panchanga) const;
-    void calculateSpecialYogas(PanchangaData& panchanga) const;
-    void calculateNakshatraPada(PanchangaData& panchanga) const;
-    void calculateChandraTaraBalam(PanchangaData& panchanga) const;
-    void calculateRituAyana(PanchangaData& panchanga) const;
-    void calculateShoolDirections(PanchangaData& panchanga) const;
-    void calculateVarnaInformation(PanchangaData& panchanga) const;  // New method for Savarna calculation
-    void identifyVrataUpavas(PanchangaData& panchanga) const;
+    void calculateMuhurta(PanchangaRecord& record) const;
+    void calculateSunMoonTimes(PanchangaRecord& record, const RiseSetTimes& times) const;
+    void calculateRahuKaal(PanchangaRecord& record) const;
+    void calculateYamaganda(PanchangaRecord& record) const;
+    void calculateGulikai(PanchangaRecord& record) const;
+    void calculateDurMuhurtam(PanchangaRecord& record) const;
+    void calculateVarjyam(PanchangaRecord& record) const;
+    void calculateSpecialYogas(PanchangaRecord& record) const;
+    void calculateNakshatraPada(PanchangaRecord& record) const;
+    void calculateChandraTaraBalam(PanchangaData& panchanga) const;  // Derived from moon rashi/nakshatra
+    void calculateRituAyana(PanchangaRecord& record) const;
+    void calculateShoolDirections(PanchangaRecord& record) const;
+    void calculateVarnaInformation(PanchangaRecord& record) const;  // New method for Savarna calculation
+    void identifyVrataUpavas(PanchangaRecord& record) const;
 
     // Helper methods for time calculations
     double calculateBrahmaMuhurta(double sunriseTime, bool isStart) const;
@@ -355,17 +628,60 @@ public:
     PanchangaData calculatePanchanga(const BirthData& birthData) const;
     PanchangaData calculatePanchanga(double julianDay, double latitude, double longitude) const;
 
+    // Compact form; returns false (record left zeroed) on ephemeris errors
+    bool calculatePanchangaRecord(double julianDay, double latitude, double longitude,
+                                  PanchangaRecord& record) const;
+    PanchangaData toPanchangaData(const PanchangaRecord& record) const;
+
+    // Same, for callers that already sampled the sidereal Sun and Moon at
+    // julianDay (swe_calc with SEFLG_SIDEREAL | SEFLG_SPEED: longitude and
+    // speed in degrees per day)
+    bool calculatePanchangaRecord(double julianDay, double latitude, double longitude,
+                                  double sunLongitude, double sunSpeed,
+                                  double moonLongitude, double moonSpeed,
+                                  PanchangaRecord& record) const;
+
     // Bulk calculations
     std::vector<PanchangaData> calculatePanchangaRange(const std::string& fromDate,
                                                        const std::string& toDate,
                                                        double latitude, double longitude) const;
 
+    // Streams one record per day (julianDay, julianDay + 1, ...) to the visitor
+    // without allocating per day; stops early when the visitor returns false.
+    // Returns the number of records produced.
+    int forEachPanchangaRecord(double julianDay, int days, double latitude, double longitude,
+                               const std::function<bool(const PanchangaRecord&)>& visitor) const;
+
+    // One instant for many locations; location-independent elements are computed once
+    MultiLocationPanchanga calculatePanchangaMultiLocation(double julianDay,
+                                                           const std::vector<double>& latitudes,
+                                                           const std::vector<double>& longitudes) const;
+    MultiLocationPanchanga calculatePanchangaMultiLocation(double julianDay,
+                                                           const std::vector<Location>& locations) const;
+
     // Specific element calculations
     Tithi getTithi(double julianDay) const;
     HinduNakshatra getNakshatra(double julianDay) const;
     Yoga getYoga(double julianDay) const;
     Karana getKarana(double julianDay) const;
 
+    // Festival rules
+    // Adds regional rules from a text file (call after initialize()). Each line is
+    //   tithi     | <month or *> | <Shukla|Krishna> | <1-15> | Name[; Name...]
+    //   sankranti | <rashi> | Name[; Name...]
+    //   nakshatra | <month or *> | <nakshatra> | Name[; Name...]
+    // Blank lines and lines starting with '#' are ignored. On error nothing is added;
+    // that includes rules that would put more than six festivals on one lookup slot.
+    bool loadFestivalRules(const std::string& filename);
+    const std::vector<FestivalRule>& getFestivalRules() const { return festivalRules; }
+
+    // Whole-year festival and lunar vrata calendar. New/full moons and Sankrantis
+    // are located first; the Panchanga is then evaluated only on days where a
+    // festival rule can match.
+    FestivalCalendar generateFestivalCalendar(int year) const;
+    std::string generateFestivalCalendarTable(const FestivalCalendar& calendar) const;
+    std::string generateFestivalCalendarCSV(const FestivalCalendar& calendar) const;
+
     // Festival and event queries
     std::vector<std::string> getFestivalsForDate(const PanchangaData& panchanga) const;
     bool isEkadashi(const PanchangaData& panchanga) const;
@@ -382,6 +698,7 @@ public:
     std::string generatePanchangaTableFormat(const std::vector<PanchangaData>& panchangaList,
                                            const std::vector<double>& julianDays) const;
     std::string generateJSON(const PanchangaData& panchanga) const;
+    void writeJSON(JsonWriter& json, const PanchangaData& panchanga) const;    // as a nested value
     std::string generateCSV(const std::vector<PanchangaData>& panchangaList) const;
 
     // Utility methods
@@ -392,6 +709,11 @@ public:
     std::string getVaraName(Vara vara) const;
     std::string getHinduMonthName(HinduMonth month) const;
     std::string getRashiName(Rashi rashi) const;
+    std::string getRituName(Ritu ritu) const;
+    std::string getAyanaName(Ayana ayana) const;
+    std::string getDirectionName(Direction direction) const;
+    std::string getVarnaName(Varna varna) const;
+    const std::string& getEventName(FestivalId id) const;
 
     // Date conversion functions
     std::string hinduDateToGregorian(int hinduYear, int hinduMonth, int hinduDay, bool isKrishna = false) const;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "hindu_calendar.h"
+#include "calendar_day_stream.h"
 #include "astro_types.h"
 #include <string>
 #include <vector>
@@ -147,6 +148,11 @@ private:
     std::string generateHTMLCell(const PanchangaData& panchanga, const std::string& gregorianDate,
                                 const std::string& hinduDate, int day) const;
 
+    // Month assembly shared by the computed and the precomputed (day stream) paths
+    MonthlyData createMonthlyData(int year, int month) const;
+    void appendDay(MonthlyData& monthData, double julianDay, const PanchangaData& panchanga) const;
+    void completeMonthlyData(MonthlyData& monthData) const;
+
     // Festival and event identification
     void identifyMonthlyFestivals(MonthlyData& monthData) const;
     void calculateMonthlySummary(MonthlyData& monthData) const;
@@ -176,18 +182,22 @@ public:
     // Main calendar generation methods
     MonthlyData generateMonthlyData(int year, int month) const;
     MonthlyData generateMonthlyData(const std::string& dateStr) const; // Format: "YYYY-MM" or "YYYY-MM-DD"
+    MonthlyData generateMonthlyData(const CalendarMonthDays& monthDays) const; // From a CalendarDayStream
 
     // Calendar display methods
     std::string generateCalendar(int year, int month) const;
     std::string generateCalendar(const std::string& dateStr) const;
     std::string generateHTMLCalendar(int year, int month) const;
     std::string generateHTMLCalendar(const std::string& dateStr) const;
+    std::string generateCalendar(const MonthlyData& monthData) const;
+    std::string generateHTMLCalendar(const MonthlyData& monthData) const;
 
     // BC date support
     std::string generateBCCalendar(int bcYear, int month) const;  // For BC dates
     MonthlyData generateBCMonthlyData(int bcYear, int month) const;
 
-    // Multi-month generation
+    // Multi-month generation. The days are computed once through a
+    // CalendarDayStream and the month pages are rendered in parallel, in order.
     std::vector<std::string> generateMultipleMonths(int startYear, int startMonth,
                                                    int endYear, int endMonth) const;
     std::vector<MonthlyData> generateMultipleMonthsData(int startYear, int startMonth,
@@ -213,6 +223,7 @@ public:
                      const std::string& format = "txt") const;
 
     // Utility methods
+    bool parseMonth(const std::string& dateStr, int& year, int& month) const; // BC years negative
     bool isValidDate(int year, int month, int day = 1) const;
     bool isBCDateValid(int bcYear, int month, int day = 1) const;
     std::string getCurrentDate() const;
@@ -5,6 +5,7 @@
 #include "planet_calculator.h"
 #include "house_calculator.h"
 #include "aspect_calculator.h"
+#include <map>
 
 namespace Astro {
 
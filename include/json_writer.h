@@ -0,0 +1,108 @@
+#pragma once
+
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Astro {
+
+enum class JsonStyle {
+    PRETTY,   // two-space indentation, one member per line
+    COMPACT   // no whitespace
+};
+
+// Streaming JSON builder shared by every JSON output.
+// Appends directly to one std::string: strings are escaped, numbers go through
+// std::to_chars (doubles in shortest round-trip form, non-finite values as null),
+// and commas/indentation are tracked with a bit stack, so apart from growing the
+// output buffer nothing is allocated. Nesting is limited to MAX_DEPTH levels;
+// opening a deeper level throws std::length_error, and closing a container that
+// was never opened throws std::logic_error.
+class JsonWriter {
+public:
+    explicit JsonWriter(JsonStyle style = defaultStyle());
+
+    // Style used by writers constructed without one (set once from the command line)
+    static void setDefaultStyle(JsonStyle style);
+    static JsonStyle defaultStyle();
+
+    JsonWriter& beginObject();
+    JsonWriter& endObject();
+    JsonWriter& beginArray();
+    JsonWriter& endArray();
+
+    // Member name inside an object; must be followed by a value or begin*()
+    JsonWriter& key(std::string_view name);
+
+    JsonWriter& value(std::string_view text);
+    JsonWriter& value(const std::string& text) { return value(std::string_view(text)); }
+    JsonWriter& value(const char* text) { return value(std::string_view(text)); }
+    JsonWriter& value(bool flag);
+    JsonWriter& value(double number);
+    JsonWriter& null();
+
+    template <typename Integer>
+    std::enable_if_t<std::is_integral_v<Integer> && !std::is_same_v<Integer, bool>, JsonWriter&>
+    value(Integer number) {
+        if constexpr (std::is_signed_v<Integer>) {
+            return integer(static_cast<int64_t>(number));
+        } else {
+            return unsignedInteger(static_cast<uint64_t>(number));
+        }
+    }
+
+    // Already-serialized JSON inserted as one value
+    JsonWriter& raw(std::string_view json);
+
+    // key(name).value(v)
+    template <typename T>
+    JsonWriter& field(std::string_view name, const T& v) {
+        key(name);
+        return value(v);
+    }
+
+    // Array member whose elements are passed to value()
+    template <typename Container>
+    JsonWriter& arrayField(std::string_view name, const Container& items) {
+        key(name);
+        beginArray();
+        for (const auto& item : items) {
+            value(item);
+        }
+        return endArray();
+    }
+
+    void reserve(size_t bytes) { out.reserve(bytes); }
+    const std::string& str() const { return out; }
+    std::string take() { return std::move(out); }
+
+    // Write the text built so far to os and empty the buffer; nesting is kept,
+    // so a long array can be streamed one element at a time
+    void writeTo(std::ostream& os);
+
+    // Append text with JSON string escaping (no surrounding quotes)
+    static void appendEscaped(std::string& target, std::string_view text);
+
+private:
+    static constexpr int MAX_DEPTH = 64;
+
+    std::string out;
+    JsonStyle style;
+    int depth;
+    uint64_t nonEmptyLevels;  // bit d set once level d has a member
+    static_assert(MAX_DEPTH <= 64, "nonEmptyLevels has one bit per level");
+    bool afterKey;
+
+    JsonWriter& integer(int64_t number);
+    JsonWriter& unsignedInteger(uint64_t number);
+
+    // Separator and indentation before a value or key at the current level
+    void beginItem();
+    void newline();
+    JsonWriter& open(char bracket);
+    JsonWriter& close(char bracket);
+};
+
+} // namespace Astro
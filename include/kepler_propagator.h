@@ -0,0 +1,65 @@
+#pragma once
+
+#include <map>
+#include <vector>
+
+namespace Astro {
+
+// Heliocentric positions of planets from two-body (Keplerian) orbits, for
+// runs that need very many positions and can live with arc-second errors,
+// such as solar-system animations and long heliocentric scans.
+//
+// Each body's osculating elements are taken from swe_get_orbital_elements at
+// epochs every resyncDays (Julian days that are whole multiples of it), and
+// a request is served from the orbit of the nearest epoch: one Kepler
+// equation, usually solved in a single Newton step from the previous
+// request's anomaly, and a rotation. That is over ten million positions a
+// second, five times the ephemeris even when it shares work between bodies
+// at the same instant. The error is the planetary perturbation accumulated
+// over at most half a resync interval and vanishes at the epochs. Against
+// the geometric J2000 heliocentric ephemeris over 1950-2050, 30-day resyncs
+// keep every planet within 0.5" in longitude and 3e-6 in relative distance;
+// 365-day resyncs within 1' for Mercury to Mars and 5" beyond. The Moon's
+// elements are geocentric and too strongly perturbed to propagate, so it is
+// refused.
+//
+// Results match SwissEphemeris::calc with SEFLG_HELCTR | SEFLG_J2000 |
+// SEFLG_TRUEPOS | SEFLG_NONUT | SEFLG_SPEED: ecliptic longitude, latitude
+// and distance (AU) for the J2000 equinox without light time, then their
+// daily speeds. SE_EARTH gives the Earth-Moon barycentre, up to 7" from
+// the Earth that swe_calc returns.
+class KeplerPropagator {
+public:
+    // ephemerisFlags: SEFLG_SWIEPH, SEFLG_MOSEPH or SEFLG_JPLEPH
+    KeplerPropagator(int ephemerisFlags, double resyncDays);
+
+    // Same arguments and result as swe_calc for the flags above
+    int calc(double julianDayET, int body, double* result, char* error);
+
+    double getResyncDays() const { return resyncDays; }
+
+private:
+    struct Orbit {
+        long epochIndex;        // epoch = epochIndex * resyncDays
+        bool valid;
+        double epoch;
+        double eccentricity;
+        double meanAnomaly;     // at epoch, radians
+        double meanMotion;      // radians per day
+        double lastTime;        // last request, to start Kepler's equation from
+        double lastAnomaly;     // its eccentric anomaly, radians
+        double lastRate;        // and that anomaly's rate, radians per day
+        double p[3];            // towards perihelion, scaled by the semimajor axis
+        double q[3];            // 90 degrees ahead in the orbit, scaled by the semiminor axis
+    };
+
+    int ephemerisFlags;
+    double resyncDays;
+    std::vector<Orbit> planets;         // by body number, for the major bodies
+    std::map<int, Orbit> others;
+
+    Orbit& orbitFor(int body);
+    bool synchronize(Orbit& orbit, long epochIndex, int body, char* error) const;
+};
+
+} // namespace Astro
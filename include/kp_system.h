@@ -75,15 +75,16 @@ struct KPTransition {
 class KPSystem {
 private:
     std::vector<Nakshatra> nakshatras;
-    std::vector<std::vector<KPSubDivision>> subDivisions;
     bool isInitialized;
     mutable std::string lastError;
 
     void initializeNakshatras();
-    void initializeSubDivisions();
+
+    // Sub divisions of levels 3-5 for each nakshatra, shared by all instances
+    static const std::vector<std::vector<KPSubDivision>>& sharedSubDivisions();
 
     // Calculate sub divisions for a nakshatra
-    std::vector<KPSubDivision> calculateSubDivisions(const Nakshatra& nakshatra, int level) const;
+    static std::vector<KPSubDivision> calculateSubDivisions(const Nakshatra& nakshatra, int level);
 
     // Find nakshatra for given longitude
     Nakshatra findNakshatra(double longitude) const;
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Astro {
+namespace LocationDB {
+
+// Location database and search index, generated at build time by
+// tools/location_db_generator from data/locations.tsv (plus a GeoNames
+// cities15000.txt when one is bundled). Every string lives in TEXT and is
+// referenced by offset, so the tables are plain read-only data: nothing is
+// constructed or relocated at start-up.
+
+struct Record {
+    uint32_t name;           // offsets into TEXT
+    uint32_t country;
+    uint32_t region;
+    uint32_t timezoneId;
+    uint32_t lowerName;      // ASCII-lowercased copies used for matching
+    uint32_t lowerCountry;
+    double latitude;
+    double longitude;
+    double timezone;         // hours from UTC
+    int32_t population;
+};
+
+// Search key: lowercased full name, name token, country or region.
+// Sorted by text; the locations carrying it are KEY_LOCATIONS[first, first + count).
+struct Key {
+    uint32_t text;
+    uint32_t length;
+    uint32_t firstLocation;
+    uint32_t locationCount;
+};
+
+// Keys containing a three-byte sequence, for substring search.
+// Sorted by code; the keys are TRIGRAM_KEYS[first, first + count).
+struct Trigram {
+    uint32_t code;           // byte0 << 16 | byte1 << 8 | byte2
+    uint32_t firstKey;
+    uint32_t keyCount;
+};
+
+// Record position as a unit vector, for nearest-city queries. SPATIAL_NODES
+// holds RECORD_COUNT nodes as an implicit k-d tree: the node of range
+// [lo, hi) is at lo + (hi - lo) / 2 and splits on xyz[axis]; its subtrees
+// are [lo, mid) and [mid + 1, hi).
+struct SpatialNode {
+    double xyz[3];
+    uint32_t location;
+    uint32_t axis;
+};
+
+extern const char TEXT[];
+extern const Record RECORDS[];
+extern const size_t RECORD_COUNT;
+extern const Key KEYS[];
+extern const size_t KEY_COUNT;
+extern const uint32_t KEY_LOCATIONS[];
+extern const Trigram TRIGRAMS[];
+extern const size_t TRIGRAM_COUNT;
+extern const uint32_t TRIGRAM_KEYS[];
+extern const SpatialNode SPATIAL_NODES[];
+
+inline std::string_view text(uint32_t offset) {
+    return std::string_view(TEXT + offset);
+}
+
+inline std::string_view keyText(const Key& key) {
+    return std::string_view(TEXT + key.text, key.length);
+}
+
+inline uint32_t trigramCode(unsigned char a, unsigned char b, unsigned char c) {
+    return (static_cast<uint32_t>(a) << 16) | (static_cast<uint32_t>(b) << 8) | c;
+}
+
+} // namespace LocationDB
+} // namespace Astro
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
-#include <map>
 
 namespace Astro {
 
@@ -17,6 +19,14 @@ struct Location {
     int population = 0; // For ranking results
 };
 
+// A location and its great-circle distance from a query point
+struct NearbyLocation {
+    Location location;
+    double distanceKm = 0.0;
+};
+
+// City lookup over the build-time location database (location_db.h).
+// Construction is free; every query reads the generated tables directly.
 class LocationManager {
 public:
     LocationManager();
@@ -39,17 +49,21 @@ public:
     // Check if location exists
     bool hasLocation(const std::string& name) const;
 
+    // Up to count locations nearest to a point, closest first
+    std::vector<NearbyLocation> findNearest(double latitude, double longitude, int count = 1) const;
+
+    // Every location within radiusKm of a point, closest first
+    std::vector<NearbyLocation> findWithinRadius(double latitude, double longitude, double radiusKm) const;
+
+    // Nearest location to each (latitude, longitude) point, in input order.
+    // Points that are not finite get an empty Location.
+    std::vector<NearbyLocation> reverseGeocode(const std::vector<std::pair<double, double>>& points) const;
+
 private:
-    std::vector<Location> locations;
-    std::map<std::string, std::vector<int>> nameIndex;
-
-    void initializeDatabase();
-    void addLocation(const std::string& name, const std::string& country,
-                    const std::string& region, double lat, double lon,
-                    double tz, const std::string& tzStr, int population = 0);
-    void buildIndex();
-    std::vector<std::string> tokenize(const std::string& text) const;
-    double calculateRelevance(const Location& location, const std::string& query) const;
+    // Database indices whose search keys contain lowerQuery, ascending
+    void collectCandidates(std::string_view lowerQuery, std::vector<uint32_t>& candidates) const;
+    double calculateRelevance(size_t index, std::string_view lowerQuery) const;
+    static Location toLocation(size_t index);
 };
 
 } // namespace Astro
@@ -8,6 +8,8 @@
 
 namespace Astro {
 
+class JsonWriter;
+
 // Myanmar calendar elements enumeration (based on yan9a/mmcal)
 enum class MyanmarYearType {
     COMMON = 0,      // Common year (354 days)
@@ -210,6 +212,7 @@ public:
     std::string generateTable(const MyanmarCalendarData& data) const;
     std::string generateTable(const std::vector<MyanmarCalendarData>& dataList) const;
     std::string generateJSON(const MyanmarCalendarData& data) const;
+    void writeJSON(JsonWriter& json, const MyanmarCalendarData& data) const;  // as a nested value
     std::string generateCSV(const std::vector<MyanmarCalendarData>& dataList) const;
     std::string generateCalendarView(long myanmarYear, long month) const;
 
@@ -10,6 +10,7 @@
 #include "myanmar_calendar.h"
 #include "astro_calendar.h"
 #include "hindu_calendar.h"
+#include "calendar_day_stream.h"
 #include <string>
 #include <vector>
 #include <map>
@@ -206,9 +207,18 @@ private:
     // Multi-calendar data calculation methods
     void calculateGregorianData(MyanmarMonthlyData::DayData& dayData, int year, int month, int day) const;
     void calculateHinduCalendarData(MyanmarMonthlyData::DayData& dayData, double julianDay) const;
+    void applyHinduCalendarData(MyanmarMonthlyData::DayData& dayData, const PanchangaData* panchanga) const;
     void calculatePlanetaryData(MyanmarMonthlyData::DayData& dayData, double julianDay) const;
     void calculateMultiCalendarStatistics(MyanmarMonthlyData& monthData) const;
 
+    // Month assembly shared by the computed and the precomputed (day stream) paths
+    MyanmarMonthlyData createMonthlyData(int year, int month, bool includeGregorian, bool includeHindu,
+                                         bool includePlanetary, bool includeAdvancedAstro) const;
+    void fillDayData(MyanmarMonthlyData& monthData, MyanmarMonthlyData::DayData& dayData,
+                     const MyanmarCalendarData& myanmarData) const;
+    void setDefaultDayData(MyanmarMonthlyData::DayData& dayData, bool includeHindu) const;
+    void completeMonthlyData(MyanmarMonthlyData& monthData) const;
+
     // Tabulate helper methods
     tabulate::Table createCalendarTable(const MyanmarMonthlyData& monthData) const;
     void styleCalendarTable(tabulate::Table& table, const std::string& style) const;
@@ -237,6 +247,12 @@ public:
                                           bool includeGregorian = false, bool includeHindu = false,
                                           bool includePlanetary = false, bool includeAdvancedAstro = false) const;
 
+    // Month from a CalendarDayStream; the Hindu view reads the stream's Panchanga
+    // (computed at the stream's location) instead of recalculating it
+    MyanmarMonthlyData calculateMonthlyData(const CalendarMonthDays& monthDays,
+                                          bool includeGregorian = false, bool includeHindu = false,
+                                          bool includePlanetary = false, bool includeAdvancedAstro = false) const;
+
     // Output format methods
     std::string generateMonthlyCalendar(const MyanmarMonthlyData& monthData, const std::string& format = "traditional") const;
     std::string generateTraditionalMyanmarCalendar(const MyanmarMonthlyData& monthData) const;
@@ -0,0 +1,62 @@
+#pragma once
+
+namespace Astro {
+
+// Positions of one body for a run of times walked in order at a roughly
+// fixed step, as a drop-in for SwissEphemeris::calc/calcUt in tables and
+// sweeps.
+//
+// Only a few times are computed exactly: the stream takes positions at the
+// ends and the middle of a time window and serves every request inside it by
+// cubic Hermite interpolation on the two half windows, using each node's
+// longitude, latitude and distance and their speeds. Before a window is used,
+// the Hermite curve through its two ends is compared with the exact middle;
+// a window whose error exceeds the tolerance is halved until it passes or
+// spans too few steps to save anything, and one that passes by a wide margin
+// lets the next window double. Each body therefore settles on its own
+// window, from every step for the Moon in a daily table to weeks at a time
+// for the outer planets.
+//
+// Failed or warned calls and windows too short to pay off fall back to the
+// exact ephemeris, for longer and longer stretches while a body keeps
+// failing.
+class PositionStream {
+public:
+    // step: expected spacing of the requests, in days. tolerance: largest
+    // position error accepted at a window's middle, in degrees (distance is
+    // held to the same angle); the times actually served lie on half windows
+    // and come out some sixteen times closer. Speeds are the interpolant's
+    // derivative and stay about as accurate as the ephemeris's own.
+    PositionStream(int body, int flags, bool universalTime, double step, double tolerance);
+
+    // Same arguments and result as swe_calc/swe_calc_ut for this body and flags
+    int calc(double julianDay, double* result, char* error);
+
+private:
+    struct Node {
+        double julianDay;
+        int returnFlags;
+        double position[6];
+    };
+
+    int body;
+    int flags;
+    bool universalTime;
+    double step;
+    double tolerance;
+
+    // Current window; valid when last.julianDay > first.julianDay
+    Node first;
+    Node middle;
+    Node last;
+    double span;
+    double retryAfter;          // no new window before this time
+    double retrySteps;
+
+    int exact(double julianDay, Node& node, char* error) const;
+    bool openWindow(double julianDay, char* error);
+    double windowError(const Node& a, const Node& b, const Node& check) const;
+    void interpolate(const Node& a, const Node& b, double julianDay, double* result) const;
+};
+
+} // namespace Astro
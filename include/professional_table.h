@@ -32,7 +32,7 @@ struct CellFormat {
     int paddingLeft = 1;
     int paddingRight = 1;
     bool wordWrap = true;
-    bool multiByteSupport = false;
+    bool multiByteSupport = false;     // no longer needed: widths always follow display_width.h
 
     CellFormat() = default;
     CellFormat& align(FontAlign align) { alignment = align; return *this; }
@@ -50,6 +50,7 @@ class TableCell {
 private:
     std::string content;
     CellFormat format;
+    mutable int displayWidthCache = -1;   // -1 until measured
 
 public:
     TableCell() = default;
@@ -58,7 +59,7 @@ public:
 
     // Content access
     const std::string& getText() const { return content; }
-    void setText(const std::string& text) { content = text; }
+    void setText(const std::string& text) { content = text; displayWidthCache = -1; }
 
     // Format access
     const CellFormat& getFormat() const { return format; }
@@ -75,7 +76,23 @@ public:
 
     // Utility methods
     std::vector<std::string> getWrappedLines(int maxWidth) const;
-    int getDisplayWidth() const;
+    int getDisplayWidth() const;          // terminal columns, measured once
+};
+
+// Column widths grown as rows are measured, so a layout never rescans rows
+// it has already seen
+class ColumnWidths {
+private:
+    std::vector<int> widths;
+
+public:
+    void observe(size_t column, int width) {
+        if (column >= widths.size()) widths.resize(column + 1, 0);
+        if (width > widths[column]) widths[column] = width;
+    }
+    int operator[](size_t column) const { return column < widths.size() ? widths[column] : 0; }
+    size_t size() const { return widths.size(); }
+    void clear() { widths.clear(); }
 };
 
 // Table row
@@ -112,8 +129,14 @@ public:
 
 // Professional table class inspired by p-ranav/tabulate
 class ProfessionalTable {
+public:
+    // Supplies streamed row index into row; false once there are no more rows
+    using RowSource = std::function<bool(size_t index, TableRow& row)>;
+
 private:
     std::vector<TableRow> rows;
+    mutable ColumnWidths rowWidths;     // content + padding of rows, kept up to date by addRow
+    mutable bool rowWidthsValid = true; // false after rows were edited in place
     BorderStyle borderStyle = BorderStyle::ASCII;
     CellFormat globalFormat;
     std::vector<CellFormat> columnFormats;
@@ -167,19 +190,29 @@ public:
 
     // Output generation
     std::string toString() const;
+    void write(std::ostream& os) const;
+
+    // Two-pass streaming: source is run once to measure and once to emit, so
+    // the formatted table is never held in memory. Rows added with addRow()
+    // come first (typically just the header).
+    void stream(std::ostream& os, const RowSource& source) const;
+
     std::string toMarkdown() const;
     std::string toCSV() const;
     std::string toJSON() const;
     std::string toHTML() const;
 
     // Utility methods
-    void clear() { rows.clear(); }
+    void clear() { rows.clear(); rowWidths.clear(); rowWidthsValid = true; }
     bool empty() const { return rows.empty(); }
 
 private:
     // Internal rendering methods
     std::vector<int> calculateColumnWidths() const;
-    std::string formatHeaderSection() const;
+    const ColumnWidths& measuredRowWidths() const;
+    std::vector<int> resolveColumnWidths(const ColumnWidths& content) const;
+    static void measureRow(const TableRow& row, ColumnWidths& widths);
+    std::string formatHeaderSection(const std::vector<int>& widths) const;
     std::string formatRowSeparator(const std::vector<int>& widths, bool isTop = false, bool isBottom = false) const;
     std::string formatDataRow(const TableRow& row, const std::vector<int>& widths, size_t rowIndex) const;
     std::string formatCell(const TableCell& cell, int width, bool isLast = false) const;
@@ -192,7 +225,6 @@ private:
     // Text processing utilities
     std::string alignText(const std::string& text, int width, FontAlign alignment) const;
     std::string padText(const std::string& text, int width, char padChar = ' ') const;
-    int getTextDisplayWidth(const std::string& text, bool multiByteSupport = false) const;
     std::vector<std::string> wrapText(const std::string& text, int width) const;
 
     // Border character access
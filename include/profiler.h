@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <ostream>
+
+namespace Astro {
+
+struct ProfileNode;
+
+// Hierarchical scoped timers and counters behind --profile. Each thread
+// records into its own tree, so a scope costs a child lookup and two clock
+// reads with no locking; the trees are merged by path when the report is
+// written, with times summed over threads.
+//
+// Instrumentation goes through the ASTRO_PROFILE_* macros below. Builds
+// configured with -DHOROSCOPE_PROFILING=OFF compile them out entirely;
+// otherwise a disabled profiler costs one relaxed load per scope.
+class Profiler {
+public:
+    static void setEnabled(bool enable) { active.store(enable, std::memory_order_relaxed); }
+    static bool isEnabled() { return active.load(std::memory_order_relaxed); }
+
+    // True when the ASTRO_PROFILE_* macros were compiled in
+    static bool isCompiledIn();
+
+    // Opens a child of the current scope on this thread; detail (may be null)
+    // splits one name into separate entries, e.g. by body
+    static ProfileNode* enter(const char* name, const char* detail = nullptr);
+    static void leave(ProfileNode* node, uint64_t nanoseconds);
+
+    // Adds to a counter under the current scope
+    static void count(const char* name, uint64_t amount = 1, const char* detail = nullptr);
+
+    // Indented tree: calls, total and self milliseconds per scope
+    static void writeReport(std::ostream& os);
+    static void writeJSON(std::ostream& os);
+
+    // Drops everything recorded so far; no scope may be open
+    static void reset();
+
+private:
+    static inline std::atomic<bool> active{false};
+};
+
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name, const char* detail = nullptr) : node(nullptr) {
+        if (Profiler::isEnabled()) {
+            node = Profiler::enter(name, detail);
+            start = std::chrono::steady_clock::now();
+        }
+    }
+
+    ~ProfileScope() {
+        if (node) {
+            auto elapsed = std::chrono::steady_clock::now() - start;
+            Profiler::leave(node, static_cast<uint64_t>(
+                std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count()));
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfileNode* node;
+    std::chrono::steady_clock::time_point start;
+};
+
+} // namespace Astro
+
+#define ASTRO_PROFILE_CONCAT_INNER(a, b) a##b
+#define ASTRO_PROFILE_CONCAT(a, b) ASTRO_PROFILE_CONCAT_INNER(a, b)
+
+#ifdef ASTRO_PROFILING
+// Times the rest of the enclosing block
+#define ASTRO_PROFILE_SCOPE(name) \
+    ::Astro::ProfileScope ASTRO_PROFILE_CONCAT(astroProfileScope, __LINE__)(name)
+#define ASTRO_PROFILE_SCOPE_DETAIL(name, detail) \
+    ::Astro::ProfileScope ASTRO_PROFILE_CONCAT(astroProfileScope, __LINE__)(name, detail)
+#define ASTRO_PROFILE_COUNT(name, amount) \
+    do { if (::Astro::Profiler::isEnabled()) ::Astro::Profiler::count(name, amount); } while (0)
+#define ASTRO_PROFILE_COUNT_DETAIL(name, amount, detail) \
+    do { if (::Astro::Profiler::isEnabled()) ::Astro::Profiler::count(name, amount, detail); } while (0)
+#else
+#define ASTRO_PROFILE_SCOPE(name) ((void)0)
+#define ASTRO_PROFILE_SCOPE_DETAIL(name, detail) ((void)0)
+#define ASTRO_PROFILE_COUNT(name, amount) ((void)0)
+#define ASTRO_PROFILE_COUNT_DETAIL(name, amount, detail) ((void)0)
+#endif
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Astro {
+
+// 8-bit grayscale image with anti-aliased strokes, for chart images without
+// an external graphics library. Drawing only ever darkens (each pixel keeps
+// the darkest value drawn over it), so overlapping strokes and polyline
+// joints do not build up.
+class RasterImage {
+public:
+    RasterImage();
+    RasterImage(int width, int height, uint8_t background = 255);
+
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    uint8_t pixel(int x, int y) const { return pixels[static_cast<size_t>(y) * width + x]; }
+
+    // Coordinates are in pixels with (0, 0) at the top-left corner of the
+    // first pixel; strokes are centered on the geometry
+    void strokeLine(double x0, double y0, double x1, double y1, double strokeWidth, uint8_t gray);
+    void strokeCircle(double cx, double cy, double radius, double strokeWidth, uint8_t gray);
+    void fillCircle(double cx, double cy, double radius, uint8_t gray);
+
+    // Append the image as a PNG file (grayscale, fixed-Huffman deflate)
+    void encodePng(std::string& out) const;
+
+private:
+    int width;
+    int height;
+    std::vector<uint8_t> pixels;
+
+    void blend(int x, int y, double coverage, uint8_t gray);
+};
+
+} // namespace Astro
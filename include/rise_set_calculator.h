@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace Astro {
+
+// Rise/set instants found after a search start (Julian Day UT, 0.0 = no event)
+struct RiseSetTimes {
+    double sunrise = 0.0;
+    double sunset = 0.0;
+    double moonrise = 0.0;
+    double moonset = 0.0;
+};
+
+// Fast sunrise/sunset solver.
+// The Sun's rise/set is first estimated from an analytic solar position and then
+// refined with one or two Newton corrections against the precise topocentric
+// ephemeris, using the same horizon definition as swe_rise_trans() (upper limb,
+// standard refraction). Single-location Moon events are delegated to swe_rise_trans().
+// For many locations at once, the geocentric Sun and Moon are sampled a single
+// time and each location only needs an analytic topocentric reduction.
+// Results are cached per (location, search start).
+class RiseSetCalculator {
+public:
+    RiseSetCalculator();
+
+    // Atmospheric conditions used for refraction at the horizon
+    void setAtmosphere(double pressure, double temperature);
+
+    // Find the next sunrise or sunset after jdStart (UT).
+    // Returns false if the Sun does not rise/set (polar day or night).
+    bool findSunEvent(double jdStart, double latitude, double longitude,
+                      bool rising, double& eventJD) const;
+
+    // Sun and Moon rise/set after jdStart, served from the cache when available
+    RiseSetTimes calculate(double jdStart, double latitude, double longitude) const;
+
+    // Uncached solve that never allocates. When previousDay holds the results for
+    // the window one day earlier, its sunrise/sunset seed the Newton refinement.
+    RiseSetTimes solve(double jdStart, double latitude, double longitude,
+                       const RiseSetTimes* previousDay = nullptr) const;
+
+    // Consecutive daily windows starting at jdStart, jdStart + 1, ...
+    // Each day's solve is seeded from the previous day's result.
+    std::vector<RiseSetTimes> calculateRange(double jdStart, int days,
+                                             double latitude, double longitude) const;
+
+    // Whole Gregorian year, one window per day starting at 0h UT
+    std::vector<RiseSetTimes> calculateYear(int year, double latitude, double longitude) const;
+
+    // Many locations sharing one search start
+    std::vector<RiseSetTimes> calculateMultiLocation(double jdStart,
+                                                     const std::vector<double>& latitudes,
+                                                     const std::vector<double>& longitudes) const;
+
+    // Cache management
+    void clearCache();
+    size_t getCacheSize() const { return cache.size(); }
+
+private:
+    struct CacheKey {
+        int64_t latitude;   // micro-degrees
+        int64_t longitude;  // micro-degrees
+        int64_t start;      // seconds since JD 0
+
+        bool operator==(const CacheKey& other) const {
+            return latitude == other.latitude && longitude == other.longitude && start == other.start;
+        }
+    };
+
+    struct CacheKeyHash {
+        size_t operator()(const CacheKey& key) const;
+    };
+
+    static constexpr size_t MAX_CACHE_ENTRIES = 8192;
+
+    // Beyond this latitude the diurnal-arc estimate is unreliable; use swe_rise_trans()
+    static constexpr double FAST_LATITUDE_LIMIT = 65.0;
+
+    double atmosphericPressure;
+    double atmosphericTemperature;
+    double horizonRefraction;  // degrees, derived from the atmosphere
+
+    mutable std::unordered_map<CacheKey, RiseSetTimes, CacheKeyHash> cache;
+
+    static CacheKey makeKey(double jdStart, double latitude, double longitude);
+    void storeInCache(const CacheKey& key, const RiseSetTimes& times) const;
+
+    // Analytic first guess for the next event after jdStart
+    bool estimateSunEvent(double jdStart, double latitude, double longitude,
+                          bool rising, double& eventJD) const;
+
+    // Newton refinement against the precise ephemeris; false if it does not converge
+    bool refineSunEvent(double latitude, double longitude, double& eventJD) const;
+
+    // Fallback to the iterative Swiss Ephemeris search
+    bool sweRiseTrans(double jdStart, int body, double latitude, double longitude,
+                      bool rising, double& eventJD) const;
+};
+
+} // namespace Astro
@@ -2,9 +2,11 @@
 
 #include "birth_chart.h"
 #include "astro_types.h"
+#include "kepler_propagator.h"
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
-#include <map>
 
 namespace Astro {
 
@@ -34,6 +36,26 @@ public:
     std::string drawGeocentricView(const std::vector<PlanetPosition>& positions) const;
     std::string drawPlanetCentricView(const std::vector<PlanetPosition>& positions, Planet centerPlanet) const;
 
+    // Frame-by-frame heliocentric view for time-lapse output, placing Earth
+    // and the planets at their heliocentric longitudes for the moment rather
+    // than a chart's geocentric ones. The state keeps the orbits and the
+    // cells drawn over them, so each update restores and redraws just those.
+    // Returns false with getLastError() set when a position cannot be
+    // computed.
+    struct OrbitState {
+        std::vector<std::string> rows;
+        std::vector<std::string> frame;                 // orbits and Sun only
+        std::vector<std::pair<int, int>> drawnCells;    // (x, y)
+    };
+    bool updateHeliocentricView(OrbitState& state, double julianDayUT);
+
+    // With a resync interval in days, updateHeliocentricView() propagates
+    // Kepler orbits (see kepler_propagator.h) instead of calling the
+    // ephemeris for every body and frame; 0 goes back to the ephemeris
+    void setKeplerResync(double days);
+
+    std::string getLastError() const { return lastError; }
+
     // Set drawing options
     void setShowOrbits(bool show) { showOrbits = show; }
     void setShowPlanetNames(bool show) { showPlanetNames = show; }
@@ -47,6 +69,8 @@ private:
     bool showDistances;
     double scale;
     SolarSystemPerspective perspective;
+    std::unique_ptr<KeplerPropagator> propagator;
+    std::string lastError;
 
     // Helper methods
     std::string getPlanetSymbol(Planet planet) const;
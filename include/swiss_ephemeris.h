@@ -0,0 +1,44 @@
+#pragma once
+
+namespace Astro {
+
+// The Swiss Ephemeris position and rise/set queries, in one place so that
+// --profile can attribute their time by function and body. Arguments and
+// return values are exactly those of the swe_* functions they forward to.
+//
+// calcUt() and calc() remember their recent results per thread, keyed by
+// Julian day, body, flags and (for SEFLG_SIDEREAL) the sidereal mode, so a
+// position asked for twice in one run is computed once. Only clean results
+// are kept: errors, warnings left in the error buffer and topocentric
+// positions go to the library every time. The sidereal mode and the
+// ephemeris path must be changed through the setters below, which keep the
+// cache consistent.
+class SwissEphemeris {
+public:
+    static int calcUt(double julianDayUT, int body, int flags, double* result, char* error);
+    static int calc(double julianDayET, int body, int flags, double* result, char* error);
+    static int riseTrans(double julianDayUT, int body, char* star, int ephemerisFlags, int riseSetFlags,
+                         double* geopos, double pressure, double temperature, double* result, char* error);
+
+    // swe_get_orbital_elements; result must hold ORBITAL_ELEMENT_COUNT values
+    static const int ORBITAL_ELEMENT_COUNT = 50;
+    static int orbitalElements(double julianDayET, int body, int flags, double* result, char* error);
+
+    // swe_set_sid_mode, swe_set_topo, swe_set_ephe_path and swe_close
+    static void setSiderealMode(int mode, double referenceJD = 0.0, double ayanamsaAtReference = 0.0);
+    static void setTopocentric(double longitude, double latitude, double altitude);
+    static void setEphemerisPath(const char* path);
+    static void close();
+
+    // swe_get_ayanamsa_ut for the given sidereal mode, leaving the thread's
+    // mode (and so the cache) as it was
+    static double ayanamsaUt(double julianDayUT, int mode);
+
+    // Forgets this thread's cached positions
+    static void clearCache();
+
+    // Profile label for a Swiss Ephemeris body number
+    static const char* bodyName(int body);
+};
+
+} // namespace Astro
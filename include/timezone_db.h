@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace Astro {
+namespace TimeZoneDB {
+
+// IANA time zone database, compiled at build time by
+// tools/timezone_db_generator from the tzdata snapshot in data/tzdata.zi.
+// Times are seconds since 1970-01-01 00:00 UTC on the proleptic Gregorian
+// calendar; offsets are seconds east of UTC.
+
+enum DayKind { DAY_FIXED, DAY_LAST_WEEKDAY, DAY_WEEKDAY_ON_OR_AFTER, DAY_WEEKDAY_ON_OR_BEFORE };
+enum TimeKind { TIME_WALL, TIME_STANDARD, TIME_UNIVERSAL };
+
+// A day of a month: fixed, the last weekday, or the first weekday on or
+// after (before) day. Weekdays count from Sunday = 0.
+struct DayRule {
+    int8_t month;
+    int8_t day;
+    int8_t weekday;
+    int8_t kind;             // DayKind
+};
+
+// One yearly daylight saving change
+struct YearlyRule {
+    DayRule date;
+    int32_t at;              // seconds after midnight, in atKind time
+    int32_t atKind;          // TimeKind
+    int32_t save;            // added to the standard offset from then on
+    int32_t dst;
+};
+
+// The pair of rules a zone follows for every year after its transition table
+struct FinalRules {
+    int32_t standardOffset;
+    YearlyRule rules[2];
+};
+
+// Transitions of a zone are [firstTransition, firstTransition + transitionCount)
+// in the TRANSITION_* arrays, ascending. Before the first one the initial
+// offset (usually local mean time) applies.
+struct Zone {
+    uint32_t name;           // offset into TEXT
+    uint32_t firstTransition;
+    uint32_t transitionCount;
+    int32_t initialOffset;
+    int32_t initialDST;
+    int32_t finalRules;      // index into FINAL_RULES, -1 if none
+};
+
+// Canonical zone names and their aliases, sorted by name
+struct ZoneName {
+    uint32_t name;
+    uint32_t zone;
+};
+
+struct Offset {
+    int32_t utcOffset;
+    int32_t dst;
+};
+
+extern const char VERSION[];
+extern const char TEXT[];
+extern const Zone ZONES[];
+extern const size_t ZONE_COUNT;
+extern const ZoneName ZONE_NAMES[];
+extern const size_t ZONE_NAME_COUNT;
+
+// Per transition: the UTC instant, the local wall clock time from which the
+// new offset applies (local times skipped or repeated by the change resolve
+// to the earlier offset), and the offset itself
+extern const int64_t TRANSITION_UTC[];
+extern const int64_t TRANSITION_LOCAL[];
+extern const Offset TRANSITION_OFFSETS[];
+extern const FinalRules FINAL_RULES[];
+
+inline std::string_view text(uint32_t offset) {
+    return std::string_view(TEXT + offset);
+}
+
+} // namespace TimeZoneDB
+} // namespace Astro
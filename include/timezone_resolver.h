@@ -0,0 +1,57 @@
+#pragma once
+
+#include "astro_types.h"
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+namespace Astro {
+
+// UTC offset in effect in a time zone at some moment
+struct ZoneOffset {
+    int utcOffsetSeconds = 0;
+    bool isDST = false;
+
+    double hours() const { return utcOffsetSeconds / 3600.0; }
+};
+
+// Historical UTC offsets for IANA time zones, from the tzdata snapshot
+// compiled into the binary (timezone_db.h); system zoneinfo files are never
+// read. A lookup is a binary search over the zone's transitions; years past
+// the table follow the zone's current daylight saving rules.
+class TimeZoneResolver {
+public:
+    TimeZoneResolver();
+
+    // Zone index for an IANA name or alias ("Asia/Calcutta"), -1 if unknown
+    int findZone(std::string_view name) const;
+
+    // Canonical name of a zone index
+    std::string zoneName(int zone) const;
+
+    // Offset at a UTC instant (seconds since 1970-01-01 00:00 UTC)
+    ZoneOffset offsetAtUTC(int zone, int64_t utcSeconds) const;
+
+    // Offset for a local wall clock time, as seconds since 1970-01-01 00:00
+    // local. Times skipped by a forward change, or repeated by a backward
+    // one, take the offset in effect before the change.
+    ZoneOffset offsetAtLocalTime(int zone, int64_t localSeconds) const;
+
+    // Set birthData.timezone to the zone's offset at its local date and time
+    bool resolve(std::string_view zoneName, BirthData& birthData) const;
+
+    // Seconds since 1970-01-01 00:00 for a proleptic Gregorian date and time
+    static int64_t toSeconds(int year, int month, int day, int hour, int minute, int second);
+
+    // tzdata release of the compiled snapshot, e.g. "2025b"
+    static std::string dataVersion();
+
+    std::string getLastError() const { return lastError; }
+
+private:
+    mutable std::string lastError;
+
+    ZoneOffset finalRuleOffset(int zone, int64_t seconds, bool local) const;
+};
+
+} // namespace Astro
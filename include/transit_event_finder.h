@@ -0,0 +1,85 @@
+#pragma once
+
+#include "astro_types.h"
+#include <map>
+#include <string>
+#include <vector>
+
+namespace Astro {
+
+enum class TransitEventType {
+    SIGN_INGRESS,           // Longitude crosses a 30° sign boundary
+    NAKSHATRA_INGRESS,      // Longitude crosses a 13°20' nakshatra boundary
+    STATION_RETROGRADE,     // Speed turns negative
+    STATION_DIRECT          // Speed turns positive
+};
+
+struct TransitEvent {
+    TransitEventType type;
+    Planet planet;
+    double julianDay;       // exact time, UT
+    double longitude;       // longitude at that time
+    int from;               // sign (0-11) or nakshatra (0-26) left; for stations the sign
+    int to;                 // sign or nakshatra entered; for stations the sign
+};
+
+// Exact sign and nakshatra ingresses and retrograde stations. Each planet is
+// sampled on a fixed step (a quarter day for the Moon, a day otherwise); a
+// boundary between two samples is refined by Newton steps on longitude, using
+// the ephemeris speed as the derivative, and a speed sign change by regula
+// falsi on speed. A station splits its step before ingresses are searched, so
+// a planet that touches a boundary and turns back is not lost.
+//
+// Whole Gregorian years are cached on first use; getEvents() slices them, so
+// a run of monthly calendars pays for each year once. Not thread-safe.
+class TransitEventFinder {
+public:
+    TransitEventFinder();
+
+    // Default: tropical, Sun through Pluto without the Moon, sign ingresses
+    // and stations. Changing any setting clears the cache.
+    void setZodiacMode(ZodiacMode mode, AyanamsaType ayanamsa = AyanamsaType::LAHIRI);
+    void setPlanets(const std::vector<Planet>& planetList);
+    void setIncludeSignIngresses(bool include);
+    void setIncludeNakshatraIngresses(bool include);
+    void setIncludeStations(bool include);
+
+    // Events with startJD <= julianDay < endJD (UT), in time order, computed
+    // directly for the range
+    bool findEvents(double startJD, double endJD, std::vector<TransitEvent>& events) const;
+
+    // Same range, sliced from the cached years
+    bool getEvents(double startJD, double endJD, std::vector<TransitEvent>& events) const;
+    const std::vector<TransitEvent>& getYearEvents(int year) const;
+
+    std::string getLastError() const { return lastError; }
+
+    static std::string getEventTypeName(TransitEventType type);
+
+private:
+    ZodiacMode zodiacMode;
+    AyanamsaType ayanamsa;
+    std::vector<Planet> planets;
+    bool includeSigns;
+    bool includeNakshatras;
+    bool includeStations;
+    mutable std::map<int, std::vector<TransitEvent>> yearCache;
+    mutable std::string lastError;
+
+    struct Sample {
+        double julianDay;
+        double longitude;
+        double speed;
+    };
+
+    int calculationFlags() const;
+    bool sample(int body, double julianDay, Sample& result) const;
+    bool findPlanetEvents(Planet planet, double startJD, double endJD, std::vector<TransitEvent>& events) const;
+    void findIngresses(Planet planet, int body, const Sample& a, const Sample& b, double size,
+                       TransitEventType type, double startJD, double endJD,
+                       std::vector<TransitEvent>& events) const;
+    bool refineIngress(int body, Sample a, Sample b, double boundary, Sample& result) const;
+    bool refineStation(int body, Sample a, Sample b, Sample& result) const;
+};
+
+} // namespace Astro
@@ -15,6 +15,15 @@ public:
     // Draw traditional Western chart wheel in ASCII
     std::string drawChartWheel(const BirthChart& chart) const;
 
+    // Frame-by-frame wheel drawing for time-lapse output. The state holds the
+    // last wheel and the cells drawn over the static frame; each update
+    // restores just those cells and draws the new chart's planets and cusps.
+    struct WheelState {
+        std::vector<std::string> rows;
+        std::vector<std::pair<int, int>> drawnCells;   // (x, y)
+    };
+    void updateWheel(WheelState& state, const BirthChart& chart) const;
+
     // Draw simplified rectangular chart
     std::string drawRectangularChart(const BirthChart& chart) const;
 
@@ -42,11 +51,15 @@ private:
     std::pair<int, int> getWheelPosition(int centerX, int centerY, double angle, int radius) const;
 
     // Chart drawing components
-    std::string drawWheelFrame(int size) const;
+    static const int WHEEL_SIZE = 61;   // Must be odd for center
+    static std::string drawWheelFrame(int size);
+    static const std::vector<std::string>& wheelFrame();
     void fillWheelWithPlanets(std::vector<std::string>& wheel, const std::vector<PlanetPosition>& positions,
-                             const HouseCusps& cusps, int centerX, int centerY) const;
+                             const HouseCusps& cusps, int centerX, int centerY,
+                             std::vector<std::pair<int, int>>* drawnCells = nullptr) const;
     void drawHouseCusps(std::vector<std::string>& wheel, const HouseCusps& cusps,
-                       int centerX, int centerY, int radius) const;
+                       int centerX, int centerY, int radius,
+                       std::vector<std::pair<int, int>>* drawnCells = nullptr) const;
     void drawAspectLines(std::vector<std::string>& wheel, const std::vector<Aspect>& aspects,
                         const std::vector<PlanetPosition>& positions, const HouseCusps& cusps,
                         int centerX, int centerY) const;
@@ -5,6 +5,7 @@
 namespace Astro {
 
 AspectCalculator::AspectCalculator() {
+    orbTolerances.fill(0.0);
     setDefaultOrbs();
 }
 
@@ -63,15 +64,32 @@ std::vector<Aspect> AspectCalculator::calculateAspectsForPlanet(const std::vecto
 }
 
 void AspectCalculator::setOrbTolerance(AspectType aspect, double orb) {
-    orbTolerances[aspect] = orb;
+    int index = aspectIndex(aspect);
+    if (index >= 0) {
+        orbTolerances[index] = orb;
+    }
 }
 
 void AspectCalculator::setDefaultOrbs() {
-    orbTolerances[AspectType::CONJUNCTION] = 8.0;
-    orbTolerances[AspectType::OPPOSITION] = 8.0;
-    orbTolerances[AspectType::SQUARE] = 6.0;
-    orbTolerances[AspectType::TRINE] = 6.0;
-    orbTolerances[AspectType::SEXTILE] = 4.0;
+    setOrbTolerance(AspectType::CONJUNCTION, 8.0);
+    setOrbTolerance(AspectType::OPPOSITION, 8.0);
+    setOrbTolerance(AspectType::SQUARE, 6.0);
+    setOrbTolerance(AspectType::TRINE, 6.0);
+    setOrbTolerance(AspectType::SEXTILE, 4.0);
+}
+
+double AspectCalculator::getOrbTolerance(AspectType aspect) const {
+    int index = aspectIndex(aspect);
+    return index >= 0 ? orbTolerances[index] : 0.0;
+}
+
+int AspectCalculator::aspectIndex(AspectType aspect) {
+    for (size_t i = 0; i < ASPECT_COUNT; i++) {
+        if (SUPPORTED_ASPECTS[i] == aspect) {
+            return static_cast<int>(i);
+        }
+    }
+    return -1;
 }
 
 bool AspectCalculator::isAspect(double angle1, double angle2, AspectType aspect, double& orb) const {
@@ -81,32 +99,28 @@ bool AspectCalculator::isAspect(double angle1, double angle2, AspectType aspect,
     double aspectAngle = static_cast<double>(aspect);
     orb = std::abs(diff - aspectAngle);
 
-    auto it = orbTolerances.find(aspect);
-    if (it != orbTolerances.end()) {
-        return orb <= it->second;
+    int index = aspectIndex(aspect);
+    if (index >= 0) {
+        return orb <= orbTolerances[index];
     }
 
     return false; // Unknown aspect type
 }
 
 std::vector<AspectType> AspectCalculator::getSupportedAspects() {
-    return {
-        AspectType::CONJUNCTION,
-        AspectType::SEXTILE,
-        AspectType::SQUARE,
-        AspectType::TRINE,
-        AspectType::OPPOSITION
-    };
+    return std::vector<AspectType>(SUPPORTED_ASPECTS.begin(), SUPPORTED_ASPECTS.end());
 }
 
 bool AspectCalculator::calculateAspectBetweenPlanets(const PlanetPosition& pos1,
                                                    const PlanetPosition& pos2,
                                                    Aspect& aspect) const {
-    std::vector<AspectType> aspectTypes = getSupportedAspects();
+    double diff = std::abs(pos1.longitude - pos2.longitude);
+    if (diff > 180.0) diff = 360.0 - diff;
 
-    for (AspectType aspectType : aspectTypes) {
-        double orb;
-        if (isAspect(pos1.longitude, pos2.longitude, aspectType, orb)) {
+    for (size_t i = 0; i < ASPECT_COUNT; i++) {
+        AspectType aspectType = SUPPORTED_ASPECTS[i];
+        double orb = std::abs(diff - static_cast<double>(aspectType));
+        if (orb <= orbTolerances[i]) {
             aspect.planet1 = pos1.planet;
             aspect.planet2 = pos2.planet;
             aspect.type = aspectType;
@@ -0,0 +1,215 @@
+#include "aspect_matrix.h"
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+namespace Astro {
+
+namespace {
+
+constexpr size_t ASPECT_COUNT = AspectCalculator::ASPECT_COUNT;
+
+// Sum of 2^i over the aspects within orb. Expanded at compile time: a loop over
+// the aspects here would keep the caller's loop from being vectorized.
+template <size_t... I>
+inline double aspectMask(double separation,
+                         const std::array<double, ASPECT_COUNT>& angles,
+                         const std::array<double, ASPECT_COUNT>& orbs,
+                         std::index_sequence<I...>) {
+    return ((std::fabs(separation - angles[I]) <= orbs[I] ? static_cast<double>(1u << I) : 0.0) + ...);
+}
+
+} // namespace
+
+ChartLongitudes ChartLongitudes::fromPositions(const std::vector<PlanetPosition>& positions) {
+    ChartLongitudes chart;
+    chart.planets.reserve(positions.size());
+    chart.longitudes.reserve(positions.size());
+    chart.speeds.reserve(positions.size());
+
+    for (const auto& pos : positions) {
+        chart.planets.push_back(pos.planet);
+        chart.longitudes.push_back(pos.longitude);
+        chart.speeds.push_back(pos.speed);
+    }
+
+    return chart;
+}
+
+ChartLongitudeMatrix::ChartLongitudeMatrix(std::vector<Planet> planets)
+    : planets(std::move(planets)), columns(this->planets.size()), charts(0) {
+}
+
+void ChartLongitudeMatrix::reserve(size_t chartCapacity) {
+    for (auto& column : columns) {
+        column.reserve(chartCapacity);
+    }
+}
+
+bool ChartLongitudeMatrix::addChart(const std::vector<PlanetPosition>& positions) {
+    std::vector<double> longitudes(planets.size());
+
+    for (size_t body = 0; body < planets.size(); body++) {
+        auto it = std::find_if(positions.begin(), positions.end(),
+                               [&](const PlanetPosition& pos) {
+                                   return pos.planet == planets[body];
+                               });
+        if (it == positions.end()) {
+            return false;
+        }
+        longitudes[body] = it->longitude;
+    }
+
+    addChart(longitudes.data());
+    return true;
+}
+
+void ChartLongitudeMatrix::addChart(const double* longitudes) {
+    for (size_t body = 0; body < planets.size(); body++) {
+        columns[body].push_back(longitudes[body]);
+    }
+    charts++;
+}
+
+AspectMatrix::AspectMatrix() : AspectMatrix(AspectCalculator()) {
+}
+
+AspectMatrix::AspectMatrix(const AspectCalculator& calculator) {
+    for (size_t i = 0; i < ASPECT_COUNT; i++) {
+        angles[i] = static_cast<double>(AspectCalculator::SUPPORTED_ASPECTS[i]);
+    }
+    orbs = calculator.getOrbTolerances();
+}
+
+void AspectMatrix::setOrbTolerance(AspectType aspect, double orb) {
+    int index = AspectCalculator::aspectIndex(aspect);
+    if (index >= 0) {
+        orbs[index] = orb;
+    }
+}
+
+void AspectMatrix::classify(double longitude, const double* others, size_t count, float* masks) const {
+    // Local copies so the compiler can keep the tables in registers
+    const std::array<double, ASPECT_COUNT> angle = angles;
+    const std::array<double, ASPECT_COUNT> orb = orbs;
+
+    for (size_t c = 0; c < count; c++) {
+        double separation = std::fabs(longitude - others[c]);
+        separation = std::min(separation, 360.0 - separation);
+        masks[c] = static_cast<float>(aspectMask(separation, angle, orb,
+                                                 std::make_index_sequence<ASPECT_COUNT>()));
+    }
+}
+
+size_t AspectMatrix::firstAspect(float mask) {
+    unsigned bits = static_cast<unsigned>(mask);
+    size_t aspect = 0;
+    while ((bits & 1u) == 0) {
+        bits >>= 1;
+        aspect++;
+    }
+    return aspect;
+}
+
+double AspectMatrix::orbOf(double longitude1, double longitude2, size_t aspect) const {
+    double diff = std::fabs(longitude1 - longitude2);
+    if (diff > 180.0) diff = 360.0 - diff;
+    return std::fabs(diff - angles[aspect]);
+}
+
+void AspectMatrix::compare(const ChartLongitudes& a, const ChartLongitudes& b,
+                           std::vector<AspectHit>& hits) const {
+    std::vector<float> masks(b.size());
+
+    for (size_t i = 0; i < a.size(); i++) {
+        classify(a.longitudes[i], b.longitudes.data(), b.size(), masks.data());
+
+        for (size_t j = 0; j < b.size(); j++) {
+            if (masks[j] == 0.0f) continue;
+
+            size_t aspect = firstAspect(masks[j]);
+            AspectHit hit;
+            hit.chart = 0;
+            hit.body1 = static_cast<uint8_t>(i);
+            hit.body2 = static_cast<uint8_t>(j);
+            hit.type = AspectCalculator::SUPPORTED_ASPECTS[aspect];
+            hit.orb = static_cast<float>(orbOf(a.longitudes[i], b.longitudes[j], aspect));
+            hits.push_back(hit);
+        }
+    }
+}
+
+void AspectMatrix::compare(const ChartLongitudes& a, const ChartLongitudeMatrix& charts,
+                           std::vector<AspectHit>& hits,
+                           size_t firstChart, size_t lastChart) const {
+    lastChart = std::min(lastChart, charts.chartCount());
+    if (firstChart >= lastChart) return;
+
+    const size_t bodiesA = a.size();
+    const size_t bodiesB = charts.bodyCount();
+    const size_t pairs = bodiesA * bodiesB;
+
+    // masks[pair * BLOCK_CHARTS + chart offset]
+    std::vector<float> masks(pairs * BLOCK_CHARTS);
+
+    for (size_t blockStart = firstChart; blockStart < lastChart; blockStart += BLOCK_CHARTS) {
+        const size_t blockSize = std::min(BLOCK_CHARTS, lastChart - blockStart);
+
+        for (size_t i = 0; i < bodiesA; i++) {
+            for (size_t j = 0; j < bodiesB; j++) {
+                classify(a.longitudes[i], charts.column(j) + blockStart, blockSize,
+                         masks.data() + (i * bodiesB + j) * BLOCK_CHARTS);
+            }
+        }
+
+        // Emit chart by chart so the hits of a chart stay together
+        for (size_t c = 0; c < blockSize; c++) {
+            const size_t chart = blockStart + c;
+            for (size_t pair = 0; pair < pairs; pair++) {
+                float mask = masks[pair * BLOCK_CHARTS + c];
+                if (mask == 0.0f) continue;
+
+                size_t i = pair / bodiesB;
+                size_t j = pair % bodiesB;
+                size_t aspect = firstAspect(mask);
+
+                AspectHit hit;
+                hit.chart = static_cast<uint32_t>(chart);
+                hit.body1 = static_cast<uint8_t>(i);
+                hit.body2 = static_cast<uint8_t>(j);
+                hit.type = AspectCalculator::SUPPORTED_ASPECTS[aspect];
+                hit.orb = static_cast<float>(orbOf(a.longitudes[i], charts.longitude(chart, j), aspect));
+                hits.push_back(hit);
+            }
+        }
+    }
+}
+
+void AspectMatrix::countAspects(const ChartLongitudes& a, const ChartLongitudeMatrix& charts,
+                                std::vector<uint32_t>& counts) const {
+    const size_t chartCount = charts.chartCount();
+    counts.assign(chartCount, 0);
+
+    float masks[BLOCK_CHARTS];
+    float blockCounts[BLOCK_CHARTS];
+
+    for (size_t blockStart = 0; blockStart < chartCount; blockStart += BLOCK_CHARTS) {
+        const size_t blockSize = std::min(BLOCK_CHARTS, chartCount - blockStart);
+        std::fill(blockCounts, blockCounts + blockSize, 0.0f);
+
+        for (size_t i = 0; i < a.size(); i++) {
+            for (size_t j = 0; j < charts.bodyCount(); j++) {
+                classify(a.longitudes[i], charts.column(j) + blockStart, blockSize, masks);
+                for (size_t c = 0; c < blockSize; c++) {
+                    blockCounts[c] += masks[c] != 0.0f ? 1.0f : 0.0f;
+                }
+            }
+        }
+
+        for (size_t c = 0; c < blockSize; c++) {
+            counts[blockStart + c] = static_cast<uint32_t>(blockCounts[c]);
+        }
+    }
+}
+
+} // namespace Astro
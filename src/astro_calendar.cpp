@@ -1,8 +1,13 @@
 #include "astro_calendar.h"
+#include "profiler.h"
+#include "swiss_ephemeris.h"
+#include "json_writer.h"
+#include "display_width.h"
 #include "hindu_calendar.h"
 #include "myanmar_calendar.h"
 #include "ephemeris_manager.h"
 #include "planet_calculator.h"
+#include "transit_event_finder.h"
 #include "swephexp.h"
 #include <iostream>
 #include <sstream>
@@ -15,6 +20,12 @@
 namespace Astro {
 
 // Month names array
+const std::array<Planet, DaySampleBuffer::BODY_COUNT> DaySampleBuffer::bodies = {{
+    Planet::SUN, Planet::MOON, Planet::MERCURY, Planet::VENUS, Planet::MARS,
+    Planet::JUPITER, Planet::SATURN, Planet::URANUS, Planet::NEPTUNE, Planet::PLUTO,
+    Planet::NORTH_NODE, Planet::CHIRON
+}};
+
 const std::array<std::string, 12> AstroCalendar::monthNames = {{
     "January", "February", "March", "April", "May", "June",
     "July", "August", "September", "October", "November", "December"
@@ -180,6 +191,7 @@ AstroCalendar::AstroCalendar() {
     myanmarCalendar = std::make_unique<MyanmarCalendar>();
     ephemerisManager = std::make_unique<EphemerisManager>();
     kpSystem = std::make_unique<KPSystem>();
+    transitFinder = std::make_unique<TransitEventFinder>();
     // PlanetCalculator will be initialized after ephemerisManager is ready
 }
 
@@ -227,11 +239,13 @@ AstroCalendarDay AstroCalendar::calculateAstroCalendarDay(int year, int month, i
         throw std::runtime_error("AstroCalendar not initialized");
     }
 
-    double jd = gregorianToJulianDay(year, month, day);
-    return calculateDayData(jd, year, month, day);
+    DaySampleBuffer samples;
+    sampleDays(gregorianToJulianDay(year, month, day), 1, samples);
+    return calculateDayData(samples, 0, year, month, day);
 }
 
 AstroCalendarMonth AstroCalendar::calculateAstroCalendarMonth(int year, int month) const {
+    ASTRO_PROFILE_SCOPE("AstroCalendar::calculateAstroCalendarMonth");
     if (!initialized) {
         throw std::runtime_error("AstroCalendar not initialized");
     }
@@ -244,11 +258,14 @@ AstroCalendarMonth AstroCalendar::calculateAstroCalendarMonth(int year, int mont
     int daysInMonth = getDaysInMonth(year, month);
     monthData.days.reserve(daysInMonth);
 
-    // Calculate data for each day
+    // Sample the whole month once, then run each day through the pipeline
+    DaySampleBuffer samples;
+    sampleDays(gregorianToJulianDay(year, month, 1), daysInMonth, samples);
+
     for (int day = 1; day <= daysInMonth; ++day) {
         try {
-            AstroCalendarDay dayData = calculateAstroCalendarDay(year, month, day);
-            monthData.days.push_back(dayData);
+            monthData.days.push_back(calculateDayData(samples, day - 1, year, month, day));
+            const AstroCalendarDay& dayData = monthData.days.back();
 
             // Update statistics
             if (dayData.isAuspicious) {
@@ -272,8 +289,67 @@ AstroCalendarMonth AstroCalendar::calculateAstroCalendarMonth(int year, int mont
     return monthData;
 }
 
-AstroCalendarDay AstroCalendar::calculateDayData(double julianDay, int gregYear, int gregMonth, int gregDay) const {
+void AstroCalendar::sampleDays(double firstJulianDay, int days, DaySampleBuffer& samples) const {
+    ASTRO_PROFILE_SCOPE("AstroCalendar::sampleDays");
+    samples.firstJulianDay = firstJulianDay;
+    samples.days = days;
+
+    // KP compares each day with the next, so it needs one extra row and
+    // every body; the lunar phase check only needs the Sun and Moon
+    samples.bodyCount = includeKPTransitions ? DaySampleBuffer::BODY_COUNT
+                      : includePlanetaryTransitions ? 2 : 0;
+    samples.rows = includeKPTransitions ? days + 1 : days;
+
+    char error[AS_MAXCH];
+    double position[6];
+
+    for (int b = 0; b < samples.bodyCount; b++) {
+        int body = DaySampleBuffer::bodies[b] == Planet::NORTH_NODE ? SE_TRUE_NODE
+                 : DaySampleBuffer::bodies[b] == Planet::CHIRON ? SE_CHIRON
+                 : static_cast<int>(DaySampleBuffer::bodies[b]);
+
+        samples.longitude[b].assign(samples.rows, 0.0);
+        samples.latitude[b].assign(samples.rows, 0.0);
+        samples.distance[b].assign(samples.rows, 0.0);
+        samples.speed[b].assign(samples.rows, 0.0);
+        samples.valid[b].assign(samples.rows, 0);
+
+        for (int row = 0; row < samples.rows; row++) {
+            if (SwissEphemeris::calcUt(samples.julianDay(row), body, SEFLG_SWIEPH | SEFLG_SPEED, position, error) >= 0) {
+                samples.longitude[b][row] = position[0];
+                samples.latitude[b][row] = position[1];
+                samples.distance[b][row] = position[2];
+                samples.speed[b][row] = position[3];
+                samples.valid[b][row] = 1;
+            }
+        }
+    }
+
+    // Sidereal Sun and Moon in the Hindu calendar's ayanamsa
+    samples.siderealSun.assign(days, 0.0);
+    samples.siderealSunSpeed.assign(days, 0.0);
+    samples.siderealMoon.assign(days, 0.0);
+    samples.siderealMoonSpeed.assign(days, 0.0);
+    samples.siderealValid.assign(days, 0);
+
+    double sunPosition[6];
+    for (int row = 0; row < days; row++) {
+        if (SwissEphemeris::calc(samples.julianDay(row), SE_SUN, SEFLG_SIDEREAL | SEFLG_SPEED, sunPosition, error) >= 0 &&
+            SwissEphemeris::calc(samples.julianDay(row), SE_MOON, SEFLG_SIDEREAL | SEFLG_SPEED, position, error) >= 0) {
+            samples.siderealSun[row] = sunPosition[0];
+            samples.siderealSunSpeed[row] = sunPosition[3];
+            samples.siderealMoon[row] = position[0];
+            samples.siderealMoonSpeed[row] = position[3];
+            samples.siderealValid[row] = 1;
+        }
+    }
+}
+
+AstroCalendarDay AstroCalendar::calculateDayData(const DaySampleBuffer& samples, int row,
+                                                 int gregYear, int gregMonth, int gregDay) const {
+    ASTRO_PROFILE_SCOPE("AstroCalendar::calculateDayData");
     AstroCalendarDay day;
+    double julianDay = samples.julianDay(row);
 
     // Basic Gregorian data
     day.gregorianYear = gregYear;
@@ -283,9 +359,18 @@ AstroCalendarDay AstroCalendar::calculateDayData(double julianDay, int gregYear,
     day.julianDay = julianDay;
 
     try {
-        // Calculate Hindu Calendar (Panchanga) data
-        day.panchangaData = hinduCalendar->calculatePanchanga(julianDay, latitude, longitude);
-        day.hasPanchangaData = true;
+        // Calculate Hindu Calendar (Panchanga) data from the sampled Sun and Moon
+        PanchangaRecord record = {};
+        day.hasPanchangaData = samples.siderealValid[row] &&
+            hinduCalendar->calculatePanchangaRecord(julianDay, latitude, longitude,
+                                                    samples.siderealSun[row], samples.siderealSunSpeed[row],
+                                                    samples.siderealMoon[row], samples.siderealMoonSpeed[row],
+                                                    record);
+        if (day.hasPanchangaData) {
+            day.panchangaData = hinduCalendar->toPanchangaData(record);
+        } else {
+            lastError = "Hindu calendar calculation failed for " + day.gregorianDateStr;
+        }
 
     } catch (const std::exception& e) {
         lastError = "Hindu calendar calculation failed: " + std::string(e.what());
@@ -304,38 +389,27 @@ AstroCalendarDay AstroCalendar::calculateDayData(double julianDay, int gregYear,
 
     // Calculate planetary transitions if requested
     if (includePlanetaryTransitions) {
-        day.planetaryTransitions = calculatePlanetaryTransitions(julianDay);
+        day.planetaryTransitions = calculatePlanetaryTransitions(samples, row);
+
+        // Ingresses and stations during this UT day
+        std::vector<PlanetaryTransition> events = findTransitionsBetween(julianDay - 0.5, julianDay + 0.5);
+        day.planetaryTransitions.insert(day.planetaryTransitions.end(), events.begin(), events.end());
     }
 
     // Calculate KP transitions if requested
     if (includeKPTransitions) {
         try {
-            day.kpTransitions = calculateKPTransitions(julianDay);
+            day.kpTransitions = calculateKPTransitions(samples, row);
             day.hasKPData = true;
 
-            // Calculate planetary positions for KP analysis
-            if (planetCalculator) {
-                BirthData tempData;
-                tempData.year = gregYear;
-                tempData.month = gregMonth;
-                tempData.day = gregDay;
-                tempData.hour = 12;
-                tempData.minute = 0;
-                tempData.second = 0;
-                tempData.latitude = latitude;
-                tempData.longitude = longitude;
-
-                planetCalculator->calculateAllPlanets(tempData, day.planetPositions);
-
-                // Calculate KP data for each planet
-                for (const auto& pos : day.planetPositions) {
-                    KPPosition kpData = kpSystem->calculateKPPosition(pos.longitude);
-                    day.kpPlanetData[pos.planet] = kpData;
-
-                    // Store sign and nakshatra info
-                    day.planetSigns[pos.planet] = zodiacSignToString(static_cast<ZodiacSign>(static_cast<int>(pos.longitude / 30.0)));
-                    day.planetNakshatras[pos.planet] = static_cast<int>((pos.longitude / 13.333333) + 1);
-                }
+            // Planetary positions for KP analysis
+            fillPlanetPositions(samples, row, day);
+            for (const auto& pos : day.planetPositions) {
+                day.kpPlanetData[pos.planet] = kpSystem->calculateKPPosition(pos.longitude);
+
+                // Store sign and nakshatra info
+                day.planetSigns[pos.planet] = zodiacSignToString(static_cast<ZodiacSign>(static_cast<int>(pos.longitude / 30.0)));
+                day.planetNakshatras[pos.planet] = static_cast<int>((pos.longitude / 13.333333) + 1);
             }
 
         } catch (const std::exception& e) {
@@ -353,139 +427,159 @@ AstroCalendarDay AstroCalendar::calculateDayData(double julianDay, int gregYear,
     return day;
 }
 
-std::vector<PlanetaryTransition> AstroCalendar::calculatePlanetaryTransitions(double julianDay) const {
+std::vector<PlanetaryTransition> AstroCalendar::calculatePlanetaryTransitions(const DaySampleBuffer& samples, int row) const {
     std::vector<PlanetaryTransition> transitions;
 
-    try {
-        // Check for lunar phases
-        double moonPhase[6];
-        // Calculate moon phase using ephemeris
-        if (swe_calc_ut(julianDay, SE_MOON, SEFLG_SWIEPH, moonPhase, nullptr) >= 0) {
-            double sunPos[6];
-            if (swe_calc_ut(julianDay, SE_SUN, SEFLG_SWIEPH, sunPos, nullptr) >= 0) {
-                double phaseDiff = std::fmod(moonPhase[0] - sunPos[0] + 360.0, 360.0);
-
-                if (std::abs(phaseDiff) < 1.0) { // New Moon
-                    PlanetaryTransition newMoon;
-                    newMoon.type = TransitionType::NEW_MOON;
-                    newMoon.planet = Planet::MOON;
-                    newMoon.julianDay = julianDay;
-                    newMoon.description = "New Moon - New beginnings";
-                    newMoon.isAuspicious = true;
-                    newMoon.recommendations = "Good time for setting intentions and starting new projects";
-                    transitions.push_back(newMoon);
-                }
+    // Sun and Moon are the first two sampled bodies
+    if (samples.bodyCount < 2 || !samples.valid[0][row] || !samples.valid[1][row]) {
+        return transitions;
+    }
 
-                if (std::abs(phaseDiff - 180.0) < 1.0) { // Full Moon
-                    PlanetaryTransition fullMoon;
-                    fullMoon.type = TransitionType::FULL_MOON;
-                    fullMoon.planet = Planet::MOON;
-                    fullMoon.julianDay = julianDay;
-                    fullMoon.description = "Full Moon - Peak energy";
-                    fullMoon.isAuspicious = true;
-                    fullMoon.recommendations = "Time for completion, manifestation, and releasing";
-                    transitions.push_back(fullMoon);
-                }
-            }
-        }
+    double julianDay = samples.julianDay(row);
+    double phaseDiff = std::fmod(samples.longitude[1][row] - samples.longitude[0][row] + 360.0, 360.0);
 
-    } catch (const std::exception& e) {
-        lastError = "Error calculating planetary transitions: " + std::string(e.what());
+    if (std::abs(phaseDiff) < 1.0) { // New Moon
+        PlanetaryTransition newMoon;
+        newMoon.type = TransitionType::NEW_MOON;
+        newMoon.planet = Planet::MOON;
+        newMoon.julianDay = julianDay;
+        newMoon.description = "New Moon - New beginnings";
+        newMoon.isAuspicious = true;
+        newMoon.recommendations = "Good time for setting intentions and starting new projects";
+        transitions.push_back(newMoon);
+    }
+
+    if (std::abs(phaseDiff - 180.0) < 1.0) { // Full Moon
+        PlanetaryTransition fullMoon;
+        fullMoon.type = TransitionType::FULL_MOON;
+        fullMoon.planet = Planet::MOON;
+        fullMoon.julianDay = julianDay;
+        fullMoon.description = "Full Moon - Peak energy";
+        fullMoon.isAuspicious = true;
+        fullMoon.recommendations = "Time for completion, manifestation, and releasing";
+        transitions.push_back(fullMoon);
     }
 
     return transitions;
 }
 
 std::vector<PlanetaryTransition> AstroCalendar::findMonthlyTransitions(int year, int month) const {
+    double startJD = swe_julday(year, month, 1, 0.0, SE_GREG_CAL);
+    double endJD = month == 12 ? swe_julday(year + 1, 1, 1, 0.0, SE_GREG_CAL)
+                               : swe_julday(year, month + 1, 1, 0.0, SE_GREG_CAL);
+    return findTransitionsBetween(startJD, endJD);
+}
+
+std::vector<PlanetaryTransition> AstroCalendar::findTransitionsBetween(double startJD, double endJD) const {
+    ASTRO_PROFILE_SCOPE("AstroCalendar::findTransitionsBetween");
     std::vector<PlanetaryTransition> transitions;
 
-    // This is a placeholder - would need more sophisticated ephemeris calculations
-    // to find actual planetary sign changes, retrogrades, etc.
+    std::vector<TransitEvent> events;
+    if (!transitFinder->getEvents(startJD, endJD, events)) {
+        lastError = "Error finding planetary transitions: " + transitFinder->getLastError();
+        return transitions;
+    }
+
+    for (const auto& event : events) {
+        PlanetaryTransition transition;
+        transition.planet = event.planet;
+        transition.julianDay = event.julianDay;
+        transition.longitude = event.longitude;
+        transition.strength = 3;
+
+        switch (event.type) {
+            case TransitEventType::SIGN_INGRESS:
+                transition.type = TransitionType::SIGN_CHANGE;
+                transition.fromSign = zodiacSignToString(static_cast<ZodiacSign>(event.from));
+                transition.toSign = zodiacSignToString(static_cast<ZodiacSign>(event.to));
+                transition.description = getPlanetName(event.planet) + " ingress into " + transition.toSign;
+                transition.isAuspicious = event.planet != Planet::MARS && event.planet != Planet::SATURN &&
+                                          event.planet != Planet::URANUS && event.planet != Planet::NEPTUNE &&
+                                          event.planet != Planet::PLUTO;
+                break;
+            case TransitEventType::NAKSHATRA_INGRESS:
+                transition.type = TransitionType::NAKSHATRA_CHANGE;
+                transition.fromSign = "Nakshatra " + std::to_string(event.from + 1);
+                transition.toSign = "Nakshatra " + std::to_string(event.to + 1);
+                transition.description = getPlanetName(event.planet) + " enters " + transition.toSign;
+                transition.isAuspicious = true;
+                break;
+            case TransitEventType::STATION_RETROGRADE:
+            case TransitEventType::STATION_DIRECT: {
+                bool retrograde = event.type == TransitEventType::STATION_RETROGRADE;
+                transition.type = retrograde ? TransitionType::STATIONARY_RETRO : TransitionType::STATIONARY_DIRECT;
+                transition.fromSign = transition.toSign = zodiacSignToString(static_cast<ZodiacSign>(event.to));
+                transition.description = getPlanetName(event.planet) + (retrograde ? " stations retrograde" : " stations direct");
+                transition.isAuspicious = !retrograde;
+                transition.recommendations = retrograde ? "Review and revise rather than begin"
+                                                        : "Stalled matters start moving again";
+                break;
+            }
+        }
+
+        transitions.push_back(transition);
+    }
 
     return transitions;
 }
 
-std::vector<KPStarLordTransition> AstroCalendar::calculateKPTransitions(double julianDay) const {
+std::vector<KPStarLordTransition> AstroCalendar::calculateKPTransitions(const DaySampleBuffer& samples, int row) const {
+    ASTRO_PROFILE_SCOPE("AstroCalendar::calculateKPTransitions");
     std::vector<KPStarLordTransition> transitions;
 
-    if (!kpSystem) {
+    if (!kpSystem || row + 1 >= samples.rows) {
         return transitions;
     }
 
+    // Major planets, as indices into DaySampleBuffer::bodies
+    static const int planets[] = {0, 1, 4, 2, 5, 3, 6};   // Sun, Moon, Mars, Mercury, Jupiter, Venus, Saturn
+
     try {
-        // Calculate for major planets
-        std::vector<Planet> planets = {
-            Planet::SUN, Planet::MOON, Planet::MARS, Planet::MERCURY,
-            Planet::JUPITER, Planet::VENUS, Planet::SATURN
-        };
-
-        for (const Planet& planet : planets) {
-            double planetPos[6];
-            int planetId = static_cast<int>(planet);
-
-            if (swe_calc_ut(julianDay, planetId, SEFLG_SWIEPH, planetPos, nullptr) >= 0) {
-                double longitude = planetPos[0];
-
-                // Calculate KP data for each level requested
-                for (int level = 1; level <= kpLevels; level++) {
-                    KPPosition currentKP = kpSystem->calculateKPPosition(longitude);
-                    KPPosition nextDayKP;
-
-                    // Check next day to see if there's a transition
-                    if (swe_calc_ut(julianDay + 1.0, planetId, SEFLG_SWIEPH, planetPos, nullptr) >= 0) {
-                        nextDayKP = kpSystem->calculateKPPosition(planetPos[0]);
-
-                        // Check for level transitions
-                        bool hasTransition = false;
-                        int fromStar = 0, toStar = 0;
-
-                        switch (level) {
-                            case 1:
-                                if (currentKP.nakshatra.lord != nextDayKP.nakshatra.lord) {
-                                    fromStar = static_cast<int>(currentKP.nakshatra.lord);
-                                    toStar = static_cast<int>(nextDayKP.nakshatra.lord);
-                                    hasTransition = true;
-                                }
-                                break;
-                            case 2:
-                                if (currentKP.subLord != nextDayKP.subLord) {
-                                    fromStar = static_cast<int>(currentKP.subLord);
-                                    toStar = static_cast<int>(nextDayKP.subLord);
-                                    hasTransition = true;
-                                }
-                                break;
-                            case 3:
-                                if (currentKP.subSubLord != nextDayKP.subSubLord) {
-                                    fromStar = static_cast<int>(currentKP.subSubLord);
-                                    toStar = static_cast<int>(nextDayKP.subSubLord);
-                                    hasTransition = true;
-                                }
-                                break;
-                            case 4:
-                                if (currentKP.subSubSubLord != nextDayKP.subSubSubLord) {
-                                    fromStar = static_cast<int>(currentKP.subSubSubLord);
-                                    toStar = static_cast<int>(nextDayKP.subSubSubLord);
-                                    hasTransition = true;
-                                }
-                                break;
-                        }
-
-                        if (hasTransition) {
-                            KPStarLordTransition transition;
-                            transition.planet = planet;
-                            transition.level = level;
-                            transition.fromStar = fromStar;
-                            transition.toStar = toStar;
-                            transition.fromStarName = "Star " + std::to_string(static_cast<int>(fromStar));
-                            transition.toStarName = "Star " + std::to_string(static_cast<int>(toStar));
-                            transition.julianDay = julianDay;
-                            transition.duration = 24.0; // Default 24 hours
-                            transition.isAuspicious = true; // Default
-                            transition.significance = 0.5; // Default significance
-
-                            transitions.push_back(transition);
-                        }
-                    }
+        for (int b : planets) {
+            if (b >= samples.bodyCount || !samples.valid[b][row] || !samples.valid[b][row + 1]) {
+                continue;
+            }
+
+            KPPosition currentKP = kpSystem->calculateKPPosition(samples.longitude[b][row]);
+            KPPosition nextDayKP = kpSystem->calculateKPPosition(samples.longitude[b][row + 1]);
+
+            // Check each level requested for a lord change by the next day
+            for (int level = 1; level <= kpLevels; level++) {
+                int fromStar = 0, toStar = 0;
+
+                switch (level) {
+                    case 1:
+                        fromStar = static_cast<int>(currentKP.nakshatra.lord);
+                        toStar = static_cast<int>(nextDayKP.nakshatra.lord);
+                        break;
+                    case 2:
+                        fromStar = static_cast<int>(currentKP.subLord);
+                        toStar = static_cast<int>(nextDayKP.subLord);
+                        break;
+                    case 3:
+                        fromStar = static_cast<int>(currentKP.subSubLord);
+                        toStar = static_cast<int>(nextDayKP.subSubLord);
+                        break;
+                    case 4:
+                        fromStar = static_cast<int>(currentKP.subSubSubLord);
+                        toStar = static_cast<int>(nextDayKP.subSubSubLord);
+                        break;
+                }
+
+                if (fromStar != toStar) {
+                    KPStarLordTransition transition;
+                    transition.planet = DaySampleBuffer::bodies[b];
+                    transition.level = level;
+                    transition.fromStar = fromStar;
+                    transition.toStar = toStar;
+                    transition.fromStarName = "Star " + std::to_string(fromStar);
+                    transition.toStarName = "Star " + std::to_string(toStar);
+                    transition.julianDay = samples.julianDay(row);
+                    transition.duration = 24.0; // Default 24 hours
+                    transition.isAuspicious = true; // Default
+                    transition.significance = 0.5; // Default significance
+
+                    transitions.push_back(transition);
                 }
             }
         }
@@ -497,7 +591,36 @@ std::vector<KPStarLordTransition> AstroCalendar::calculateKPTransitions(double j
     return transitions;
 }
 
+void AstroCalendar::fillPlanetPositions(const DaySampleBuffer& samples, int row, AstroCalendarDay& day) const {
+    day.planetPositions.clear();
+
+    for (int b = 0; b < samples.bodyCount; b++) {
+        if (!samples.valid[b][row]) {
+            continue;
+        }
+
+        PlanetPosition position{};
+        position.planet = DaySampleBuffer::bodies[b];
+        position.longitude = samples.longitude[b][row];
+        position.latitude = samples.latitude[b][row];
+        position.distance = samples.distance[b][row];
+        position.speed = samples.speed[b][row];
+        position.calculateSignPosition();
+        day.planetPositions.push_back(position);
+
+        // South Node opposite the North Node, as in PlanetCalculator
+        if (position.planet == Planet::NORTH_NODE) {
+            position.planet = Planet::SOUTH_NODE;
+            position.longitude = std::fmod(position.longitude + 180.0, 360.0);
+            position.latitude = -position.latitude;
+            position.calculateSignPosition();
+            day.planetPositions.push_back(position);
+        }
+    }
+}
+
 void AstroCalendar::compileFestivalsAndEvents(AstroCalendarDay& day) const {
+    ASTRO_PROFILE_SCOPE("AstroCalendar::compileFestivalsAndEvents");
     day.allFestivals.clear();
     day.allEvents.clear();
 
@@ -520,6 +643,7 @@ void AstroCalendar::compileFestivalsAndEvents(AstroCalendarDay& day) const {
 }
 
 void AstroCalendar::calculateDayQuality(AstroCalendarDay& day) const {
+    ASTRO_PROFILE_SCOPE("AstroCalendar::calculateDayQuality");
     int score = 5; // Neutral starting point
 
     // Hindu calendar factors
@@ -579,6 +703,7 @@ void AstroCalendar::calculateDayQuality(AstroCalendarDay& day) const {
 
 // Output formatting methods
 std::string AstroCalendar::generateDayCalendar(const AstroCalendarDay& day, const std::string& format) const {
+    ASTRO_PROFILE_SCOPE("AstroCalendar::generateDayCalendar");
     if (format == "json") {
         return generateJSON(day);
     } else if (format == "professional") {
@@ -656,6 +781,7 @@ std::string AstroCalendar::generateDayCalendar(const AstroCalendarDay& day, cons
 }
 
 std::string AstroCalendar::generateMonthlyCalendar(const AstroCalendarMonth& monthData, const std::string& format) const {
+    ASTRO_PROFILE_SCOPE("AstroCalendar::generateMonthlyCalendar");
     if (format == "json") {
         return generateJSON(monthData);
     } else if (format == "csv") {
@@ -670,80 +796,94 @@ std::string AstroCalendar::generateMonthlyCalendar(const AstroCalendarMonth& mon
 }
 
 std::string AstroCalendar::generateJSON(const AstroCalendarDay& day) const {
-    std::stringstream ss;
-    ss << "{\n";
-    ss << "  \"gregorianDate\": \"" << day.gregorianDateStr << "\",\n";
-    ss << "  \"julianDay\": " << std::fixed << std::setprecision(6) << day.julianDay << ",\n";
-    ss << "  \"dayQuality\": {\n";
-    ss << "    \"score\": " << day.auspiciousScore << ",\n";
-    ss << "    \"description\": \"" << day.dayQualityDescription << "\",\n";
-    ss << "    \"isAuspicious\": " << (day.isAuspicious ? "true" : "false") << ",\n";
-    ss << "    \"isInauspicious\": " << (day.isInauspicious ? "true" : "false") << "\n";
-    ss << "  },\n";
+    JsonWriter json;
+    json.reserve(1024);
+    writeJSON(json, day);
+    return json.take();
+}
+
+void AstroCalendar::writeJSON(JsonWriter& json, const AstroCalendarDay& day) const {
+    json.beginObject();
+    json.field("gregorianDate", day.gregorianDateStr);
+    json.field("julianDay", day.julianDay);
+    json.key("dayQuality").beginObject();
+    json.field("score", day.auspiciousScore);
+    json.field("description", day.dayQualityDescription);
+    json.field("isAuspicious", day.isAuspicious);
+    json.field("isInauspicious", day.isInauspicious);
+    json.endObject();
 
     if (day.hasPanchangaData) {
-        ss << "  \"hinduCalendar\": {\n";
-        ss << "    \"tithi\": " << static_cast<int>(day.panchangaData.tithi) << ",\n";
-        ss << "    \"vara\": " << static_cast<int>(day.panchangaData.vara) << ",\n";
-        ss << "    \"nakshatra\": " << static_cast<int>(day.panchangaData.nakshatra) << ",\n";
-        ss << "    \"yoga\": " << static_cast<int>(day.panchangaData.yoga) << ",\n";
-        ss << "    \"karana\": " << static_cast<int>(day.panchangaData.karana) << ",\n";
-        ss << "    \"isShukla\": " << (day.panchangaData.isShukla ? "true" : "false") << "\n";
-        ss << "  },\n";
+        json.key("hinduCalendar").beginObject();
+        json.field("tithi", static_cast<int>(day.panchangaData.tithi));
+        json.field("vara", static_cast<int>(day.panchangaData.vara));
+        json.field("nakshatra", static_cast<int>(day.panchangaData.nakshatra));
+        json.field("yoga", static_cast<int>(day.panchangaData.yoga));
+        json.field("karana", static_cast<int>(day.panchangaData.karana));
+        json.field("isShukla", day.panchangaData.isShukla);
+        json.endObject();
     }
 
     if (day.hasMyanmarData) {
-        ss << "  \"myanmarCalendar\": {\n";
-        ss << "    \"myanmarYear\": " << day.myanmarData.myanmarYear << ",\n";
-        ss << "    \"sasanaYear\": " << day.myanmarData.sasanaYear << ",\n";
-        ss << "    \"month\": " << static_cast<int>(day.myanmarData.month) << ",\n";
-        ss << "    \"day\": " << day.myanmarData.dayOfMonth << ",\n";
-        ss << "    \"moonPhase\": " << static_cast<int>(day.myanmarData.moonPhase) << "\n";
-        ss << "  },\n";
+        json.key("myanmarCalendar").beginObject();
+        json.field("myanmarYear", day.myanmarData.myanmarYear);
+        json.field("sasanaYear", day.myanmarData.sasanaYear);
+        json.field("month", static_cast<int>(day.myanmarData.month));
+        json.field("day", day.myanmarData.dayOfMonth);
+        json.field("moonPhase", static_cast<int>(day.myanmarData.moonPhase));
+        json.endObject();
     }
 
-    // Festivals
-    ss << "  \"festivals\": [";
-    for (size_t i = 0; i < day.allFestivals.size(); ++i) {
-        if (i > 0) ss << ",";
-        ss << "\"" << day.allFestivals[i] << "\"";
-    }
-    ss << "],\n";
+    json.arrayField("festivals", day.allFestivals);
 
-    // Planetary transitions
-    ss << "  \"planetaryTransitions\": [";
-    for (size_t i = 0; i < day.planetaryTransitions.size(); ++i) {
-        if (i > 0) ss << ",";
-        ss << "{\"description\":\"" << day.planetaryTransitions[i].getDescription() << "\"}";
+    json.key("planetaryTransitions").beginArray();
+    for (const auto& transition : day.planetaryTransitions) {
+        json.beginObject();
+        json.field("description", transition.getDescription());
+        json.endObject();
     }
-    ss << "]\n";
+    json.endArray();
 
-    ss << "}";
-    return ss.str();
+    json.endObject();
 }
 
 std::string AstroCalendar::generateJSON(const AstroCalendarMonth& monthData) const {
-    std::stringstream ss;
-    ss << "{\n";
-    ss << "  \"year\": " << monthData.year << ",\n";
-    ss << "  \"month\": " << monthData.month << ",\n";
-    ss << "  \"monthName\": \"" << monthData.monthName << "\",\n";
-    ss << "  \"summary\": \"" << monthData.getMonthSummary() << "\",\n";
-    ss << "  \"statistics\": {\n";
-    ss << "    \"auspiciousDays\": " << monthData.auspiciousDays << ",\n";
-    ss << "    \"inauspiciousDays\": " << monthData.inauspiciousDays << ",\n";
-    ss << "    \"neutralDays\": " << monthData.neutralDays << "\n";
-    ss << "  },\n";
-    ss << "  \"days\": [\n";
-
-    for (size_t i = 0; i < monthData.days.size(); ++i) {
-        if (i > 0) ss << ",\n";
-        ss << "    " << generateJSON(monthData.days[i]);
-    }
-
-    ss << "\n  ]\n";
-    ss << "}";
-    return ss.str();
+    JsonWriter json;
+    json.reserve(512 + monthData.days.size() * 1024);
+    json.beginObject();
+    json.field("year", monthData.year);
+    json.field("month", monthData.month);
+    json.field("monthName", monthData.monthName);
+    json.field("summary", monthData.getMonthSummary());
+    json.key("statistics").beginObject();
+    json.field("auspiciousDays", monthData.auspiciousDays);
+    json.field("inauspiciousDays", monthData.inauspiciousDays);
+    json.field("neutralDays", monthData.neutralDays);
+    json.endObject();
+
+    json.key("days").beginArray();
+    for (const auto& day : monthData.days) {
+        writeJSON(json, day);
+    }
+    json.endArray();
+
+    if (!monthData.monthlyTransitions.empty()) {
+        json.key("monthlyTransitions").beginArray();
+        for (const auto& transition : monthData.monthlyTransitions) {
+            json.beginObject();
+            json.field("julianDay", transition.julianDay);
+            json.field("planet", getPlanetName(transition.planet));
+            json.field("description", transition.getDescription());
+            json.field("fromSign", transition.fromSign);
+            json.field("toSign", transition.toSign);
+            json.field("longitude", transition.longitude);
+            json.endObject();
+        }
+        json.endArray();
+    }
+
+    json.endObject();
+    return json.take();
 }
 
 // Helper methods for enhanced UI/UX
@@ -840,6 +980,7 @@ std::string AstroCalendar::generateCalendarLayout(const AstroCalendarMonth& mont
         ss << "\n";
     }
 
+    ss << formatMonthlyTransitions(monthData);
     ss << "═══════════════════════════════════════════════════════════════════\n";
 
     return ss.str();
@@ -984,7 +1125,7 @@ std::string AstroCalendar::generateTable(const AstroCalendarMonth& monthData) co
 
         // Add detailed line for highly significant days
         if (day.auspiciousScore >= 8 || day.isInauspicious || !day.allFestivals.empty() || !day.planetaryTransitions.empty()) {
-            ss << "║   " << getDetailedDayInfo(day) << std::string(80 - getDetailedDayInfo(day).length(), ' ') << " ║\n";
+            ss << "║   " << padToWidth(getDetailedDayInfo(day), 80) << " ║\n";
         }
     }
 
@@ -1175,17 +1316,10 @@ std::string AstroCalendar::generateProfessionalDayCell(const AstroCalendarDay& d
     }
 
     // Ensure cell doesn't exceed 10 characters to fit grid
-    std::string cellContent = ss.str();
-    if (cellContent.length() > 10) {
-        cellContent = cellContent.substr(0, 10);
-    }
+    std::string cellContent = truncateToWidth(ss.str(), 10);
 
-    // Pad to exactly 10 characters for consistent grid alignment
-    while (cellContent.length() < 10) {
-        cellContent += " ";
-    }
-
-    return cellContent;
+    // Pad to exactly 10 columns for consistent grid alignment
+    return padToWidth(cellContent, 10);
 }
 
 std::string AstroCalendar::getKPLevelDescription(int level) const {
@@ -1363,6 +1497,34 @@ std::string AstroCalendar::getSeasonName(int month) const {
     }
 }
 
+std::string AstroCalendar::formatMonthlyTransitions(const AstroCalendarMonth& monthData) const {
+    if (monthData.monthlyTransitions.empty()) {
+        return "";
+    }
+
+    std::stringstream ss;
+    ss << "🪐 PLANETARY TRANSITIONS (UT)\n";
+    for (const auto& transition : monthData.monthlyTransitions) {
+        int year, month, day;
+        double hour;
+        swe_revjul(transition.julianDay, SE_GREG_CAL, &year, &month, &day, &hour);
+        int minutes = static_cast<int>(hour * 60.0 + 0.5);
+        if (minutes == 24 * 60) {
+            minutes--;   // keep 23:59.5 and later on the same date
+        }
+
+        ss << "  " << formatDate(year, month, day) << " "
+           << std::setfill('0') << std::setw(2) << minutes / 60 << ":" << std::setw(2) << minutes % 60
+           << std::setfill(' ') << "  " << getPlanetarySymbol(transition) << " " << transition.getDescription();
+        if (transition.type == TransitionType::STATIONARY_RETRO || transition.type == TransitionType::STATIONARY_DIRECT) {
+            ss << " in " << transition.toSign;
+        }
+        ss << "\n";
+    }
+    ss << "\n";
+    return ss.str();
+}
+
 std::string AstroCalendar::getEnhancedMonthlySummary(const AstroCalendarMonth& monthData) const {
     std::stringstream ss;
 
@@ -1432,6 +1594,12 @@ std::string AstroCalendar::getPlanetarySymbol(const PlanetaryTransition& transit
         case TransitionType::FULL_MOON:
             symbol = "🌕";
             break;
+        case TransitionType::STATIONARY_RETRO:
+            symbol = "⏪";
+            break;
+        case TransitionType::STATIONARY_DIRECT:
+            symbol = "⏩";
+            break;
         default:
             symbol = "🪐";
     }
@@ -1574,8 +1742,7 @@ std::string AstroCalendar::generateProfessionalDayCalendar(const AstroCalendarDa
     ss << "│ Status: " << (day.isAuspicious ? "✅ HIGHLY AUSPICIOUS DAY" :
                           (day.isInauspicious ? "⚠️ EXERCISE CAUTION" : "⚪ NEUTRAL DAY"));
     ss << std::string(45, ' ') << "│\n";
-    ss << "│ Recommendation: " << day.dayQualityDescription;
-    ss << std::string(60 - day.dayQualityDescription.length(), ' ') << "│\n";
+    ss << "│ Recommendation: " << padToWidth(day.dayQualityDescription, 60) << "│\n";
     ss << "└─────────────────────────────────────────────────────────────────────────────────────────┘\n\n";
 
     // Three Calendar Systems Integration
@@ -1623,8 +1790,7 @@ std::string AstroCalendar::generateProfessionalDayCalendar(const AstroCalendarDa
         ss << "🪐 PLANETARY TRANSITS & EVENTS\n";
         ss << "┌─────────────────────────────────────────────────────────────────────────────────────────┐\n";
         for (const auto& transit : day.planetaryTransitions) {
-            ss << "│ • " << transit.getDescription();
-            ss << std::string(85 - transit.getDescription().length(), ' ') << "│\n";
+            ss << "│ • " << padToWidth(transit.getDescription(), 85) << "│\n";
         }
         ss << "└─────────────────────────────────────────────────────────────────────────────────────────┘\n\n";
     }
@@ -1634,8 +1800,7 @@ std::string AstroCalendar::generateProfessionalDayCalendar(const AstroCalendarDa
         ss << "🔮 KP SYSTEM ANALYSIS\n";
         ss << "┌─────────────────────────────────────────────────────────────────────────────────────────┐\n";
         for (const auto& kpTransit : day.kpTransitions) {
-            ss << "│ Level " << kpTransit.level << ": " << kpTransit.getDescription();
-            ss << std::string(80 - kpTransit.getDescription().length(), ' ') << "│\n";
+            ss << "│ Level " << kpTransit.level << ": " << padToWidth(kpTransit.getDescription(), 80) << "│\n";
         }
         ss << "└─────────────────────────────────────────────────────────────────────────────────────────┘\n\n";
     }
@@ -1645,8 +1810,7 @@ std::string AstroCalendar::generateProfessionalDayCalendar(const AstroCalendarDa
         ss << "🎉 FESTIVALS & SPECIAL EVENTS\n";
         ss << "┌─────────────────────────────────────────────────────────────────────────────────────────┐\n";
         for (const auto& festival : day.allFestivals) {
-            ss << "│ • " << festival;
-            ss << std::string(85 - festival.length(), ' ') << "│\n";
+            ss << "│ • " << padToWidth(festival, 85) << "│\n";
         }
         ss << "└─────────────────────────────────────────────────────────────────────────────────────────┘\n\n";
     }
@@ -1656,8 +1820,7 @@ std::string AstroCalendar::generateProfessionalDayCalendar(const AstroCalendarDa
         ss << "💡 ASTROLOGICAL RECOMMENDATIONS\n";
         ss << "┌─────────────────────────────────────────────────────────────────────────────────────────┐\n";
         for (const auto& rec : day.astrologicalRecommendations) {
-            ss << "│ • " << rec;
-            ss << std::string(85 - rec.length(), ' ') << "│\n";
+            ss << "│ • " << padToWidth(rec, 85) << "│\n";
         }
         ss << "└─────────────────────────────────────────────────────────────────────────────────────────┘\n\n";
     }
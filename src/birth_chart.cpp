@@ -1,11 +1,14 @@
 #include "birth_chart.h"
+#include "json_writer.h"
+#include <cstdio>
 #include <sstream>
 #include <iomanip>
 #include <cmath>
 
 namespace Astro {
 
-BirthChart::BirthChart() : zodiacMode(ZodiacMode::TROPICAL), ayanamsa(AyanamsaType::LAHIRI) {
+BirthChart::BirthChart()
+    : houseSystem(HouseSystem::PLACIDUS), zodiacMode(ZodiacMode::TROPICAL), ayanamsa(AyanamsaType::LAHIRI) {
 }
 
 void BirthChart::setBirthData(const BirthData& data) {
@@ -20,6 +23,10 @@ void BirthChart::setHouseCusps(const HouseCusps& cusps) {
     houseCusps = cusps;
 }
 
+void BirthChart::setHouseSystem(HouseSystem system) {
+    houseSystem = system;
+}
+
 void BirthChart::setAspects(const std::vector<Aspect>& aspects) {
     this->aspects = aspects;
 }
@@ -145,62 +152,58 @@ std::string BirthChart::getChartHeader() const {
 }
 
 std::string BirthChart::exportToJson() const {
-    std::ostringstream oss;
-    oss << "{\n";
-    oss << "  \"birthData\": {\n";
-    oss << "    \"date\": \"" << birthData.year << "-"
-        << std::setfill('0') << std::setw(2) << birthData.month << "-"
-        << std::setw(2) << birthData.day << "\",\n";
-    oss << "    \"time\": \"" << std::setw(2) << birthData.hour << ":"
-        << std::setw(2) << birthData.minute << ":"
-        << std::setw(2) << birthData.second << "\",\n";
-    oss << "    \"latitude\": " << std::fixed << std::setprecision(6) << birthData.latitude << ",\n";
-    oss << "    \"longitude\": " << birthData.longitude << ",\n";
-    oss << "    \"timezone\": " << birthData.timezone << "\n";
-    oss << "  },\n";
-
-    oss << "  \"planets\": [\n";
-    for (size_t i = 0; i < planetPositions.size(); i++) {
-        const auto& pos = planetPositions[i];
-        oss << "    {\n";
-        oss << "      \"name\": \"" << planetToString(pos.planet) << "\",\n";
-        oss << "      \"longitude\": " << std::fixed << std::setprecision(6) << pos.longitude << ",\n";
-        oss << "      \"latitude\": " << pos.latitude << ",\n";
-        oss << "      \"sign\": \"" << zodiacSignToString(pos.sign) << "\",\n";
-        oss << "      \"house\": " << pos.house << ",\n";
-        oss << "      \"speed\": " << pos.speed << "\n";
-        oss << "    }";
-        if (i < planetPositions.size() - 1) oss << ",";
-        oss << "\n";
+    char date[16];
+    char time[16];
+    std::snprintf(date, sizeof(date), "%d-%02d-%02d", birthData.year, birthData.month, birthData.day);
+    std::snprintf(time, sizeof(time), "%02d:%02d:%02d", birthData.hour, birthData.minute, birthData.second);
+
+    JsonWriter json;
+    json.reserve(512 + planetPositions.size() * 160 + aspects.size() * 140);
+    json.beginObject();
+
+    json.key("birthData").beginObject();
+    json.field("date", date);
+    json.field("time", time);
+    json.field("latitude", birthData.latitude);
+    json.field("longitude", birthData.longitude);
+    json.field("timezone", birthData.timezone);
+    json.endObject();
+
+    json.key("planets").beginArray();
+    for (const auto& pos : planetPositions) {
+        json.beginObject();
+        json.field("name", planetToString(pos.planet));
+        json.field("longitude", pos.longitude);
+        json.field("latitude", pos.latitude);
+        json.field("sign", zodiacSignToString(pos.sign));
+        json.field("house", pos.house);
+        json.field("speed", pos.speed);
+        json.endObject();
     }
-    oss << "  ],\n";
+    json.endArray();
 
-    oss << "  \"houses\": {\n";
+    json.key("houses").beginObject();
     for (int house = 1; house <= 12; house++) {
-        oss << "    \"" << house << "\": " << std::fixed << std::setprecision(6)
-            << houseCusps.cusps[house];
-        if (house < 12) oss << ",";
-        oss << "\n";
+        char name[4];
+        std::snprintf(name, sizeof(name), "%d", house);
+        json.field(name, houseCusps.cusps[house]);
     }
-    oss << "  },\n";
-
-    oss << "  \"aspects\": [\n";
-    for (size_t i = 0; i < aspects.size(); i++) {
-        const auto& aspect = aspects[i];
-        oss << "    {\n";
-        oss << "      \"planet1\": \"" << planetToString(aspect.planet1) << "\",\n";
-        oss << "      \"planet2\": \"" << planetToString(aspect.planet2) << "\",\n";
-        oss << "      \"type\": \"" << aspectTypeToString(aspect.type) << "\",\n";
-        oss << "      \"orb\": " << std::fixed << std::setprecision(2) << aspect.orb << ",\n";
-        oss << "      \"applying\": " << (aspect.isApplying ? "true" : "false") << "\n";
-        oss << "    }";
-        if (i < aspects.size() - 1) oss << ",";
-        oss << "\n";
+    json.endObject();
+
+    json.key("aspects").beginArray();
+    for (const auto& aspect : aspects) {
+        json.beginObject();
+        json.field("planet1", planetToString(aspect.planet1));
+        json.field("planet2", planetToString(aspect.planet2));
+        json.field("type", aspectTypeToString(aspect.type));
+        json.field("orb", aspect.orb);
+        json.field("applying", aspect.isApplying);
+        json.endObject();
     }
-    oss << "  ]\n";
-    oss << "}";
+    json.endArray();
 
-    return oss.str();
+    json.endObject();
+    return json.take();
 }
 
 std::string BirthChart::formatDegreeMinute(double degrees) const {
@@ -0,0 +1,137 @@
+#include "calendar_day_stream.h"
+#include "profiler.h"
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <thread>
+
+extern "C" {
+#include "swephexp.h"
+}
+
+namespace Astro {
+
+CalendarDayStream::CalendarDayStream()
+    : latitude(28.6139), longitude(77.2090),  // New Delhi, as HinduMonthlyCalendar
+      ayanamsa(AyanamsaType::LAHIRI), calculationMethod(CalculationMethod::DRIK_SIDDHANTA),
+      includeHindu(true), includeMyanmar(true), threadCount(0) {
+}
+
+void CalendarDayStream::setLocation(double lat, double lon) {
+    latitude = lat;
+    longitude = lon;
+}
+
+void CalendarDayStream::setAyanamsa(AyanamsaType type, CalculationMethod method) {
+    ayanamsa = type;
+    calculationMethod = method;
+}
+
+bool CalendarDayStream::generate(int startYear, int startMonth, int months,
+                                 std::vector<CalendarMonthDays>& result) const {
+    ASTRO_PROFILE_SCOPE("CalendarDayStream::generate");
+    result.clear();
+    if (startMonth < 1 || startMonth > 12 || months < 1) {
+        lastError = "Invalid month range";
+        return false;
+    }
+
+    result.resize(months);
+    for (int i = 0; i < months; i++) {
+        int index = startMonth - 1 + i;
+        result[i].year = startYear + index / 12;
+        result[i].month = index % 12 + 1;
+    }
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::mutex errorMutex;
+    std::string error;
+
+    auto work = [&]() {
+        HinduCalendar hinduCalendar(ayanamsa, calculationMethod);
+        MyanmarCalendar myanmarCalendar;
+        if ((includeHindu && !hinduCalendar.initialize()) || (includeMyanmar && !myanmarCalendar.initialize())) {
+            std::lock_guard<std::mutex> lock(errorMutex);
+            if (!failed.exchange(true)) {
+                error = "Failed to initialize calendars: " + hinduCalendar.getLastError();
+            }
+            return;
+        }
+
+        for (size_t i = next++; i < result.size() && !failed; i = next++) {
+            ASTRO_PROFILE_SCOPE("CalendarDayStream::month");
+            CalendarMonthDays& month = result[i];
+            int days = daysInMonth(month.year, month.month);
+            month.days.resize(days);
+
+            for (int day = 1; day <= days; day++) {
+                CalendarDay& entry = month.days[day - 1];
+                entry.day = day;
+                entry.julianDay = swe_julday(month.year, month.month, day, 12.0, SE_GREG_CAL);
+                if (includeHindu) {
+                    entry.panchanga = hinduCalendar.calculatePanchanga(entry.julianDay, latitude, longitude);
+                }
+                if (includeMyanmar) {
+                    entry.myanmar = myanmarCalendar.calculateMyanmarCalendar(entry.julianDay);
+                }
+            }
+        }
+    };
+
+    unsigned workers = workerCount(threadCount, result.size());
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < workers; i++) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (failed) {
+        lastError = error;
+        result.clear();
+        return false;
+    }
+    return true;
+}
+
+std::vector<std::string> CalendarDayStream::renderPages(size_t count, unsigned threads,
+                                                        const std::function<std::string(size_t)>& render) {
+    std::vector<std::string> pages(count);
+    std::atomic<size_t> next(0);
+
+    auto work = [&]() {
+        for (size_t i = next++; i < count; i = next++) {
+            ASTRO_PROFILE_SCOPE("CalendarDayStream::renderPage");
+            pages[i] = render(i);
+        }
+    };
+
+    unsigned workers = workerCount(threads, count);
+    std::vector<std::thread> pool;
+    for (unsigned i = 1; i < workers; i++) {
+        pool.emplace_back(work);
+    }
+    work();
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    return pages;
+}
+
+unsigned CalendarDayStream::workerCount(unsigned requested, size_t jobs) {
+    unsigned workers = requested > 0 ? requested : std::max(1u, std::thread::hardware_concurrency());
+    return static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(workers, jobs)));
+}
+
+int CalendarDayStream::daysInMonth(int year, int month) {
+    static const int days[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    // BC years count as in HinduMonthlyCalendar::isLeapYear
+    int y = year < 0 ? -year : year;
+    bool leap = (y % 4 == 0 && y % 100 != 0) || y % 400 == 0;
+    return month == 2 && leap ? 29 : days[month - 1];
+}
+
+} // namespace Astro
@@ -0,0 +1,121 @@
+#include "chart_animator.h"
+
+namespace Astro {
+
+namespace {
+
+bool isContinuation(char byte) {
+    return (static_cast<unsigned char>(byte) & 0xC0) == 0x80;
+}
+
+// Terminal column of a byte in a UTF-8 row: the number of characters before
+// it. -1 when the bytes before it are not valid UTF-8, since terminals differ
+// in how many columns they give a broken sequence.
+int columnOf(const std::string& row, size_t offset) {
+    int column = 0;
+    size_t i = 0;
+    while (i < offset) {
+        unsigned char lead = static_cast<unsigned char>(row[i]);
+        size_t length = lead < 0x80 ? 1 : lead >= 0xF0 ? 4 : lead >= 0xE0 ? 3 : lead >= 0xC0 ? 2 : 0;
+        if (length == 0 || i + length > offset) return -1;
+        for (size_t k = 1; k < length; k++) {
+            if (!isContinuation(row[i + k])) return -1;
+        }
+        i += length;
+        column++;
+    }
+    return column;
+}
+
+void moveTo(std::ostream& out, int line, int column) {
+    out << "\x1b[" << line << ";" << column << "H";
+}
+
+const int FIRST_ROW_LINE = 3;   // Caption, blank line, then the rows
+
+} // namespace
+
+ChartAnimator::ChartAnimator(std::ostream& out, Output output)
+    : out(out), output(output), frameCount(0) {
+}
+
+bool ChartAnimator::parseOutput(const std::string& name, Output& output) {
+    if (name == "ansi") {
+        output = Output::ANSI;
+    } else if (name == "stream") {
+        output = Output::STREAM;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+void ChartAnimator::writeFrame(const std::string& caption, const std::vector<std::string>& rows) {
+    if (output == Output::STREAM) {
+        if (frameCount > 0) out << "\f\n";
+        out << caption << "\n\n";
+        for (const auto& row : rows) {
+            out << row << "\n";
+        }
+    } else if (frameCount == 0 || rows.size() != previousRows.size()) {
+        writeFullFrame(caption, rows);
+    } else {
+        if (caption != previousCaption) {
+            writeChangedRow(1, previousCaption, caption);
+        }
+        for (size_t i = 0; i < rows.size(); i++) {
+            if (rows[i] != previousRows[i]) {
+                writeChangedRow(FIRST_ROW_LINE + static_cast<int>(i), previousRows[i], rows[i]);
+            }
+        }
+    }
+    out.flush();
+
+    if (output == Output::ANSI) {
+        previousCaption = caption;
+        previousRows = rows;
+    }
+    frameCount++;
+}
+
+void ChartAnimator::finish() {
+    if (output == Output::ANSI && frameCount > 0) {
+        moveTo(out, FIRST_ROW_LINE + static_cast<int>(previousRows.size()), 1);
+        out << "\x1b[?25h";
+    }
+    out.flush();
+}
+
+void ChartAnimator::writeFullFrame(const std::string& caption, const std::vector<std::string>& rows) {
+    // Clear the screen and hide the cursor while the animation runs
+    out << "\x1b[2J\x1b[?25l";
+    moveTo(out, 1, 1);
+    out << caption << "\n\n";
+    for (const auto& row : rows) {
+        out << row << "\n";
+    }
+}
+
+void ChartAnimator::writeChangedRow(int line, const std::string& previous, const std::string& row) {
+    // Rewrite from the first differing character to the end of the row; a
+    // character only partly overwritten in either row is rewritten whole
+    size_t first = 0;
+    while (first < previous.size() && first < row.size() && previous[first] == row[first]) {
+        first++;
+    }
+    while (first > 0 && (isContinuation(row[first]) || isContinuation(previous[first]))) {
+        first--;
+    }
+
+    int column = columnOf(row, first);
+    if (column < 0) {
+        first = 0;
+        column = 0;
+    }
+
+    moveTo(out, line, column + 1);
+    out.write(row.data() + first, static_cast<std::streamsize>(row.size() - first));
+    out << "\x1b[K";
+}
+
+} // namespace Astro
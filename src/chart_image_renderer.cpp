@@ -0,0 +1,651 @@
+#include "chart_image_renderer.h"
+#include "eastern_chart_drawer.h"
+#include "raster_image.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+
+namespace Astro {
+
+namespace {
+
+struct Point {
+    double x;
+    double y;
+};
+
+// --- Stroke font ---
+//
+// Glyph outlines in SVG path syntax (M, L and Z only) on a grid four units
+// wide: capitals and digits span y = 0..6, lowercase letters 2..6 and
+// descenders reach 8. The same paths become <defs> entries in SVG output and
+// line segments in PNG output.
+
+struct GlyphSource {
+    char character;
+    const char* path;
+};
+
+const GlyphSource GLYPH_SOURCES[] = {
+    {'0', "M1,0 L3,0 L4,1 L4,5 L3,6 L1,6 L0,5 L0,1 Z"},
+    {'1', "M1,1 L2,0 L2,6 M1,6 L3,6"},
+    {'2', "M0,1 L1,0 L3,0 L4,1 L4,2 L0,6 L4,6"},
+    {'3', "M0,0 L4,0 L2,2.5 L3,2.5 L4,3.5 L4,5 L3,6 L1,6 L0,5"},
+    {'4', "M3,6 L3,0 L0,4 L4,4"},
+    {'5', "M4,0 L0,0 L0,2.5 L3,2.5 L4,3.5 L4,5 L3,6 L0,6"},
+    {'6', "M3,0 L1,0 L0,1 L0,5 L1,6 L3,6 L4,5 L4,3.5 L3,2.5 L0,2.5"},
+    {'7', "M0,0 L4,0 L1.5,6"},
+    {'8', "M1,0 L3,0 L4,1 L4,2 L3,3 L1,3 L0,4 L0,5 L1,6 L3,6 L4,5 L4,4 L3,3 L1,3 L0,2 L0,1 Z"},
+    {'9', "M4,3.5 L1,3.5 L0,2.5 L0,1 L1,0 L3,0 L4,1 L4,5 L3,6 L1,6"},
+    {'A', "M0,6 L2,0 L4,6 M0.7,4 L3.3,4"},
+    {'C', "M4,1 L3,0 L1,0 L0,1 L0,5 L1,6 L3,6 L4,5"},
+    {'G', "M4,1 L3,0 L1,0 L0,1 L0,5 L1,6 L3,6 L4,5 L4,3.5 L2.5,3.5"},
+    {'I', "M1,0 L3,0 M2,0 L2,6 M1,6 L3,6"},
+    {'J', "M4,0 L4,5 L3,6 L1,6 L0,5"},
+    {'K', "M0,0 L0,6 M4,0 L0,4 M1.3,2.7 L4,6"},
+    {'L', "M0,0 L0,6 L4,6"},
+    {'M', "M0,6 L0,0 L2,3 L4,0 L4,6"},
+    {'N', "M0,6 L0,0 L4,6 L4,0"},
+    {'P', "M0,6 L0,0 L3,0 L4,1 L4,2 L3,3 L0,3"},
+    {'R', "M0,6 L0,0 L3,0 L4,1 L4,2 L3,3 L0,3 M2,3 L4,6"},
+    {'S', "M4,1 L3,0 L1,0 L0,1 L0,2 L1,3 L3,3 L4,4 L4,5 L3,6 L1,6 L0,5"},
+    {'T', "M0,0 L4,0 M2,0 L2,6"},
+    {'U', "M0,0 L0,5 L1,6 L3,6 L4,5 L4,0"},
+    {'V', "M0,0 L2,6 L4,0"},
+    {'a', "M1,2 L3,2 L4,3 L4,6 M4,4 L1,4 L0,4.8 L0,5.2 L0.8,6 L3.2,6 L4,5.2"},
+    {'c', "M4,3 L3,2 L1,2 L0,3 L0,5 L1,6 L3,6 L4,5"},
+    {'e', "M0,4 L4,4 L4,3 L3,2 L1,2 L0,3 L0,5 L1,6 L3.5,6"},
+    {'g', "M4,2 L4,7 L3,8 L1,8 L0,7.5 M4,3 L3,2 L1,2 L0,3 L0,5 L1,6 L3,6 L4,5"},
+    {'h', "M0,0 L0,6 M0,3 L1,2 L3,2 L4,3 L4,6"},
+    {'i', "M2,2 L2,6 M2,0.6 L2,0.9"},
+    {'l', "M1.5,0 L1.5,5 L2.5,6"},
+    {'n', "M0,2 L0,6 M0,3 L1,2 L3,2 L4,3 L4,6"},
+    {'o', "M1,2 L3,2 L4,3 L4,5 L3,6 L1,6 L0,5 L0,3 Z"},
+    {'p', "M0,2 L0,8 M0,3 L1,2 L3,2 L4,3 L4,5 L3,6 L1,6 L0,5"},
+    {'q', "M4,2 L4,8 M4,3 L3,2 L1,2 L0,3 L0,5 L1,6 L3,6 L4,5"},
+    {'r', "M0,2 L0,6 M0,3.5 L1.5,2 L3.5,2"},
+    {'s', "M4,2.5 L3.5,2 L0.8,2 L0,2.7 L0,3.3 L0.8,4 L3.2,4 L4,4.7 L4,5.3 L3.2,6 L0.5,6 L0,5.5"},
+    {'t', "M1.5,0.5 L1.5,5 L2.5,6 L3.5,6 M0,2 L3.5,2"},
+    {'u', "M0,2 L0,5 L1,6 L3,6 L4,5 M4,2 L4,6"}
+};
+
+const double GLYPH_WIDTH = 4.0;
+const double GLYPH_ADVANCE = 5.5;
+const double CAP_HEIGHT = 6.0;
+
+using Glyph = std::vector<std::vector<Point>>;   // strokes
+
+const std::vector<Glyph>& glyphs() {
+    static const std::vector<Glyph> table = [] {
+        std::vector<Glyph> result(128);
+        for (const auto& source : GLYPH_SOURCES) {
+            Glyph& glyph = result[static_cast<unsigned char>(source.character)];
+            const char* p = source.path;
+            while (*p) {
+                char command = *p++;
+                if (command == ' ') continue;
+                if (command == 'Z') {
+                    glyph.back().push_back(glyph.back().front());
+                    continue;
+                }
+                char* end;
+                double x = std::strtod(p, &end);
+                double y = std::strtod(end + 1, &end);   // skip the comma
+                p = end;
+                if (command == 'M') glyph.emplace_back();
+                glyph.back().push_back(Point{x, y});
+            }
+        }
+        return result;
+    }();
+    return table;
+}
+
+bool hasGlyph(char c) {
+    unsigned char code = static_cast<unsigned char>(c);
+    return code < 128 && !glyphs()[code].empty();
+}
+
+// --- Drawing ---
+
+struct Drawing {
+    struct Line {
+        Point from;
+        Point to;
+        double width;
+        uint8_t gray;
+    };
+    struct Circle {
+        Point center;
+        double radius;
+        double width;     // 0: filled
+        uint8_t gray;
+    };
+    struct Text {
+        std::string text;
+        Point center;     // middle of the cap height
+        double size;      // cap height in pixels
+        double weight;    // stroke width in pixels
+        uint8_t gray;
+    };
+
+    std::vector<Line> lines;
+    std::vector<Circle> circles;
+    std::vector<Text> texts;
+
+    void line(Point from, Point to, double width, uint8_t gray) {
+        lines.push_back(Line{from, to, width, gray});
+    }
+    void circle(Point center, double radius, double width, uint8_t gray) {
+        circles.push_back(Circle{center, radius, width, gray});
+    }
+    void text(const std::string& value, Point center, double size, double weight, uint8_t gray) {
+        texts.push_back(Text{value, center, size, weight, gray});
+    }
+};
+
+double textWidth(const std::string& text, double size) {
+    if (text.empty()) return 0.0;
+    double units = (text.size() - 1) * GLYPH_ADVANCE + GLYPH_WIDTH;
+    return units * size / CAP_HEIGHT;
+}
+
+// Top-left corner of the text's glyph grid
+Point textOrigin(const Drawing::Text& text) {
+    return Point{text.center.x - textWidth(text.text, text.size) / 2.0, text.center.y - text.size / 2.0};
+}
+
+// --- SVG output ---
+
+// One decimal is plenty at chart sizes and keeps the files small
+void appendNumber(std::string& out, double value) {
+    long tenths = std::lround(value * 10.0);
+    if (tenths < 0) {
+        out += '-';
+        tenths = -tenths;
+    }
+    out += std::to_string(tenths / 10);
+    if (tenths % 10 != 0) {
+        out += '.';
+        out += static_cast<char>('0' + tenths % 10);
+    }
+}
+
+void appendGray(std::string& out, uint8_t gray) {
+    static const char HEX[] = "0123456789abcdef";
+    out += '#';
+    for (int i = 0; i < 3; i++) {
+        out += HEX[gray >> 4];
+        out += HEX[gray & 0xF];
+    }
+}
+
+void appendAttribute(std::string& out, const char* name, double value) {
+    out += ' ';
+    out += name;
+    out += "=\"";
+    appendNumber(out, value);
+    out += '"';
+}
+
+void appendStroke(std::string& out, uint8_t gray, double width) {
+    out += " stroke=\"";
+    appendGray(out, gray);
+    out += '"';
+    appendAttribute(out, "stroke-width", width);
+}
+
+void appendSvg(const Drawing& drawing, std::string& out) {
+    for (const auto& circle : drawing.circles) {
+        out += "<circle";
+        appendAttribute(out, "cx", circle.center.x);
+        appendAttribute(out, "cy", circle.center.y);
+        appendAttribute(out, "r", circle.radius);
+        if (circle.width > 0.0) {
+            appendStroke(out, circle.gray, circle.width);
+        } else {
+            out += " stroke=\"none\" fill=\"";
+            appendGray(out, circle.gray);
+            out += '"';
+        }
+        out += "/>\n";
+    }
+
+    for (const auto& line : drawing.lines) {
+        out += "<line";
+        appendAttribute(out, "x1", line.from.x);
+        appendAttribute(out, "y1", line.from.y);
+        appendAttribute(out, "x2", line.to.x);
+        appendAttribute(out, "y2", line.to.y);
+        appendStroke(out, line.gray, line.width);
+        out += "/>\n";
+    }
+
+    // Glyphs are drawn in font units, so the stroke width is scaled back
+    for (const auto& text : drawing.texts) {
+        double scale = text.size / CAP_HEIGHT;
+        Point origin = textOrigin(text);
+        out += "<g transform=\"translate(";
+        appendNumber(out, origin.x);
+        out += ' ';
+        appendNumber(out, origin.y);
+        char scaleText[16];
+        std::snprintf(scaleText, sizeof(scaleText), "%.4g", scale);
+        out += ") scale(";
+        out += scaleText;
+        out += ")\"";
+        appendStroke(out, text.gray, text.weight / scale);
+        out += '>';
+        for (size_t i = 0; i < text.text.size(); i++) {
+            if (!hasGlyph(text.text[i])) continue;
+            out += "<use xlink:href=\"#g";
+            out += std::to_string(static_cast<int>(text.text[i]));
+            out += '"';
+            if (i > 0) appendAttribute(out, "x", i * GLYPH_ADVANCE);
+            out += "/>";
+        }
+        out += "</g>\n";
+    }
+}
+
+// Opening of every SVG document: glyph definitions and the shared styles.
+// The root group is left open for the frame and chart elements.
+std::string svgHeader(int width, int height) {
+    std::string out = "<svg xmlns=\"http://www.w3.org/2000/svg\" xmlns:xlink=\"http://www.w3.org/1999/xlink\"";
+    appendAttribute(out, "width", width);
+    appendAttribute(out, "height", height);
+    out += " viewBox=\"0 0 " + std::to_string(width) + " " + std::to_string(height) + "\">\n<defs>\n";
+    for (const auto& source : GLYPH_SOURCES) {
+        out += "<path id=\"g" + std::to_string(static_cast<int>(source.character)) +
+               "\" d=\"" + source.path + "\"/>\n";
+    }
+    out += "</defs>\n<rect width=\"100%\" height=\"100%\" fill=\"#ffffff\"/>\n";
+    out += "<g fill=\"none\" stroke-linecap=\"round\" stroke-linejoin=\"round\">\n";
+    return out;
+}
+
+// --- PNG output ---
+
+void rasterize(const Drawing& drawing, RasterImage& image) {
+    for (const auto& circle : drawing.circles) {
+        if (circle.width > 0.0) {
+            image.strokeCircle(circle.center.x, circle.center.y, circle.radius, circle.width, circle.gray);
+        } else {
+            image.fillCircle(circle.center.x, circle.center.y, circle.radius, circle.gray);
+        }
+    }
+
+    for (const auto& line : drawing.lines) {
+        image.strokeLine(line.from.x, line.from.y, line.to.x, line.to.y, line.width, line.gray);
+    }
+
+    const auto& font = glyphs();
+    for (const auto& text : drawing.texts) {
+        double scale = text.size / CAP_HEIGHT;
+        Point origin = textOrigin(text);
+        for (size_t i = 0; i < text.text.size(); i++) {
+            unsigned char code = static_cast<unsigned char>(text.text[i]);
+            if (code >= 128) continue;
+            double left = origin.x + i * GLYPH_ADVANCE * scale;
+            for (const auto& stroke : font[code]) {
+                for (size_t k = 0; k + 1 < stroke.size(); k++) {
+                    image.strokeLine(left + stroke[k].x * scale, origin.y + stroke[k].y * scale,
+                                     left + stroke[k + 1].x * scale, origin.y + stroke[k + 1].y * scale,
+                                     text.weight, text.gray);
+                }
+                if (stroke.size() == 1) {
+                    image.fillCircle(left + stroke[0].x * scale, origin.y + stroke[0].y * scale,
+                                     text.weight / 2.0, text.gray);
+                }
+            }
+        }
+    }
+}
+
+// --- Styles ---
+
+const uint8_t INK = 0;
+const uint8_t FRAME = 60;
+const uint8_t MUTED = 130;
+
+// Western wheel: 0° Aries at the top and longitude increasing clockwise,
+// as in the ASCII wheel
+const int WHEEL_SIZE = 600;
+const double WHEEL_CENTER = WHEEL_SIZE / 2.0;
+const double OUTER_RADIUS = 290.0;
+const double SIGN_RADIUS = 250.0;
+const double PLANET_RADIUS = 224.0;
+const double HOUSE_NUMBER_RADIUS = 128.0;
+const double ASPECT_RADIUS = 110.0;
+
+Point onWheel(double longitude, double radius) {
+    double angle = (longitude - 90.0) * M_PI / 180.0;
+    return Point{WHEEL_CENTER + radius * std::cos(angle), WHEEL_CENTER + radius * std::sin(angle)};
+}
+
+// Indian grids: the ASCII templates of EasternChartDrawer at a fixed cell size
+const double CELL_WIDTH = 14.0;
+const double CELL_HEIGHT = 26.0;
+
+Point gridPoint(int line, int col) {
+    return Point{(col + 1.5) * CELL_WIDTH, (line + 1.5) * CELL_HEIGHT};
+}
+
+struct HouseRect {
+    bool shown;
+    double left;
+    double top;
+    double right;
+    double bottom;
+};
+
+struct StyleTemplate {
+    int width = 0;
+    int height = 0;
+    std::string svgFrame;         // header, definitions and frame elements
+    RasterImage rasterFrame;
+    HouseRect houses[13] = {};    // grid styles
+};
+
+void buildWesternFrame(StyleTemplate& tpl, Drawing& frame) {
+    static const char* SIGN_NAMES[] = {"Ar", "Ta", "Ge", "Cn", "Le", "Vi", "Li", "Sc", "Sg", "Cp", "Aq", "Pi"};
+
+    tpl.width = WHEEL_SIZE;
+    tpl.height = WHEEL_SIZE;
+    Point center{WHEEL_CENTER, WHEEL_CENTER};
+    frame.circle(center, OUTER_RADIUS, 2.0, FRAME);
+    frame.circle(center, SIGN_RADIUS, 1.5, FRAME);
+    frame.circle(center, ASPECT_RADIUS, 1.0, MUTED);
+
+    for (int degree = 0; degree < 360; degree += 5) {
+        if (degree % 30 == 0) {
+            frame.line(onWheel(degree, SIGN_RADIUS), onWheel(degree, OUTER_RADIUS), 1.0, FRAME);
+        } else {
+            frame.line(onWheel(degree, SIGN_RADIUS), onWheel(degree, SIGN_RADIUS + 6.0), 0.8, MUTED);
+        }
+    }
+    for (int sign = 0; sign < 12; sign++) {
+        frame.text(SIGN_NAMES[sign], onWheel(sign * 30 + 15, (SIGN_RADIUS + OUTER_RADIUS) / 2.0), 11.0, 1.3, FRAME);
+    }
+}
+
+void buildGridFrame(StyleTemplate& tpl, Drawing& frame, const EasternChartDrawer::GridLayout& layout) {
+    const auto& rows = layout.frame;
+    size_t columns = 0;
+    for (const auto& row : rows) columns = std::max(columns, row.size());
+
+    tpl.width = static_cast<int>((columns + 2) * CELL_WIDTH);
+    tpl.height = static_cast<int>((rows.size() + 2) * CELL_HEIGHT);
+
+    auto at = [&](int line, int col) {
+        if (line < 0 || line >= static_cast<int>(rows.size())) return ' ';
+        if (col < 0 || col >= static_cast<int>(rows[line].size())) return ' ';
+        return rows[line][col];
+    };
+
+    // Runs of "-" and "+" are horizontal rules, runs of "|" and "+" vertical ones
+    for (int line = 0; line < static_cast<int>(rows.size()); line++) {
+        int col = 0;
+        while (col < static_cast<int>(columns)) {
+            int start = col;
+            bool rule = false;
+            while (at(line, col) == '-' || at(line, col) == '+') {
+                rule = rule || at(line, col) == '-';
+                col++;
+            }
+            if (rule) frame.line(gridPoint(line, start), gridPoint(line, col - 1), 1.5, FRAME);
+            if (col == start) col++;
+        }
+    }
+    for (int col = 0; col < static_cast<int>(columns); col++) {
+        int line = 0;
+        while (line < static_cast<int>(rows.size())) {
+            int start = line;
+            bool rule = false;
+            while (at(line, col) == '|' || at(line, col) == '+') {
+                rule = rule || at(line, col) == '|';
+                line++;
+            }
+            if (rule) frame.line(gridPoint(start, col), gridPoint(line - 1, col), 1.5, FRAME);
+            if (line == start) line++;
+        }
+    }
+
+    // Words in the template ("RASI"); house numbers are drawn per cell instead
+    for (int line = 0; line < static_cast<int>(rows.size()); line++) {
+        int col = 0;
+        while (col < static_cast<int>(rows[line].size())) {
+            int start = col;
+            while (std::isupper(static_cast<unsigned char>(at(line, col)))) col++;
+            if (col > start) {
+                Point first = gridPoint(line, start);
+                Point last = gridPoint(line, col - 1);
+                frame.text(rows[line].substr(start, col - start),
+                           Point{(first.x + last.x) / 2.0, first.y}, 14.0, 1.6, MUTED);
+            } else {
+                col++;
+            }
+        }
+    }
+
+    // Each house cell extends to the rules around the spot its planets go
+    auto isWall = [&](int line, int col) { return at(line, col) == '|' || at(line, col) == '+'; };
+    auto isFloor = [&](int line, int col) { return at(line, col) == '-' || at(line, col) == '+'; };
+    for (int house = 1; house <= 12; house++) {
+        const auto& cell = layout.cells[house];
+        HouseRect& rect = tpl.houses[house];
+        if (cell.width == 0) continue;
+
+        int left = cell.col, right = cell.col, top = cell.line, bottom = cell.line;
+        while (left > 0 && !isWall(cell.line, left)) left--;
+        while (right + 1 < static_cast<int>(columns) && !isWall(cell.line, right)) right++;
+        while (top > 0 && !isFloor(top, cell.col)) top--;
+        while (bottom + 1 < static_cast<int>(rows.size()) && !isFloor(bottom, cell.col)) bottom++;
+
+        rect.shown = true;
+        rect.left = gridPoint(cell.line, left).x;
+        rect.right = gridPoint(cell.line, right).x;
+        rect.top = gridPoint(top, cell.col).y;
+        rect.bottom = gridPoint(bottom, cell.col).y;
+    }
+}
+
+// Built once per style and shared by every chart of that style
+const StyleTemplate& styleTemplate(const std::string& style) {
+    auto build = [](const std::string& name) {
+        StyleTemplate tpl;
+        Drawing frame;
+        if (name == "western") {
+            buildWesternFrame(tpl, frame);
+        } else {
+            buildGridFrame(tpl, frame, EasternChartDrawer::getLayout(name));
+        }
+        tpl.svgFrame = svgHeader(tpl.width, tpl.height);
+        appendSvg(frame, tpl.svgFrame);
+        tpl.rasterFrame = RasterImage(tpl.width, tpl.height);
+        rasterize(frame, tpl.rasterFrame);
+        return tpl;
+    };
+
+    static const StyleTemplate western = build("western");
+    static const StyleTemplate northIndian = build("north-indian");
+    static const StyleTemplate southIndian = build("south-indian");
+    static const StyleTemplate eastIndian = build("east-indian");
+
+    if (style == "western") return western;
+    if (style == "south-indian") return southIndian;
+    if (style == "east-indian") return eastIndian;
+    return northIndian;
+}
+
+std::string westernPlanetName(Planet planet) {
+    switch (planet) {
+        case Planet::NORTH_NODE: return "NN";
+        case Planet::SOUTH_NODE: return "SN";
+        default: return EasternChartDrawer::getShortPlanetName(planet);
+    }
+}
+
+void drawWesternChart(const BirthChart& chart, Drawing& drawing) {
+    const auto& positions = chart.getPlanetPositions();
+    const auto& cusps = chart.getHouseCusps();
+
+    // House cusps, the angles heavier; numbers midway between cusps
+    for (int house = 1; house <= 12; house++) {
+        bool angle = house == 1 || house == 4 || house == 7 || house == 10;
+        double cusp = cusps.cusps[house];
+        drawing.line(onWheel(cusp, ASPECT_RADIUS), onWheel(cusp, SIGN_RADIUS),
+                     angle ? 2.2 : 0.8, angle ? INK : MUTED);
+
+        double next = cusps.cusps[house % 12 + 1];
+        double span = normalizeAngle(next - cusp);
+        drawing.text(std::to_string(house), onWheel(cusp + span / 2.0, HOUSE_NUMBER_RADIUS), 9.0, 1.1, MUTED);
+    }
+
+    // Planet labels are spread so that close planets stay readable
+    const double minSeparation = 8.0;
+    std::vector<size_t> order(positions.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = i;
+    std::sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+        return positions[a].longitude < positions[b].longitude;
+    });
+    std::vector<double> shown(positions.size());
+    for (size_t i = 0; i < positions.size(); i++) shown[i] = positions[i].longitude;
+    for (int pass = 0; pass < 20 && order.size() > 1; pass++) {
+        bool moved = false;
+        for (size_t k = 0; k < order.size(); k++) {
+            size_t a = order[k];
+            size_t b = order[(k + 1) % order.size()];
+            double gap = normalizeAngle(shown[b] - shown[a]);
+            if (gap < minSeparation) {
+                double push = (minSeparation - gap) / 2.0;
+                shown[a] -= push;
+                shown[b] += push;
+                moved = true;
+            }
+        }
+        if (!moved) break;
+    }
+
+    std::map<Planet, double> longitudes;
+    for (size_t i = 0; i < positions.size(); i++) {
+        const auto& pos = positions[i];
+        longitudes[pos.planet] = pos.longitude;
+        drawing.line(onWheel(pos.longitude, SIGN_RADIUS), onWheel(pos.longitude, SIGN_RADIUS - 8.0), 1.5, INK);
+        drawing.line(onWheel(pos.longitude, SIGN_RADIUS - 8.0), onWheel(shown[i], SIGN_RADIUS - 14.0), 0.6, MUTED);
+        drawing.text(westernPlanetName(pos.planet), onWheel(shown[i], PLANET_RADIUS), 12.0, 1.5, INK);
+    }
+
+    // Aspect lines inside the inner circle; hard aspects darker
+    for (const auto& aspect : chart.getAspects()) {
+        if (aspect.type == AspectType::CONJUNCTION) continue;
+        auto first = longitudes.find(aspect.planet1);
+        auto second = longitudes.find(aspect.planet2);
+        if (first == longitudes.end() || second == longitudes.end()) continue;
+
+        bool hard = aspect.type == AspectType::SQUARE || aspect.type == AspectType::OPPOSITION;
+        drawing.line(onWheel(first->second, ASPECT_RADIUS), onWheel(second->second, ASPECT_RADIUS),
+                     hard ? 1.2 : 0.9, hard ? 40 : 150);
+    }
+}
+
+void drawGridChart(const BirthChart& chart, const StyleTemplate& tpl, Drawing& drawing) {
+    const double planetSize = 11.0;
+    const double lineHeight = planetSize * 1.7;
+    const double itemWidth = textWidth("Su", planetSize) + GLYPH_ADVANCE * planetSize / CAP_HEIGHT;
+
+    std::vector<std::string> planets[13];
+    for (const auto& pos : chart.getPlanetPositions()) {
+        if (pos.house >= 1 && pos.house <= 12) {
+            planets[pos.house].push_back(EasternChartDrawer::getShortPlanetName(pos.planet));
+        }
+    }
+
+    for (int house = 1; house <= 12; house++) {
+        const HouseRect& rect = tpl.houses[house];
+        if (!rect.shown) continue;
+
+        drawing.text(std::to_string(house), Point{rect.left + 10.0, rect.top + 10.0}, 8.0, 1.0, MUTED);
+
+        // As many names per line as fit, lines centered in the cell
+        const auto& names = planets[house];
+        size_t perLine = std::max<size_t>(1, static_cast<size_t>((rect.right - rect.left - 10.0) / itemWidth));
+        size_t lines = (names.size() + perLine - 1) / perLine;
+        double y = (rect.top + rect.bottom) / 2.0 - (lines - 1) * lineHeight / 2.0;
+        for (size_t first = 0; first < names.size(); first += perLine, y += lineHeight) {
+            std::string text;
+            for (size_t i = first; i < std::min(names.size(), first + perLine); i++) {
+                if (i > first) text += ' ';
+                text += names[i];
+            }
+            drawing.text(text, Point{(rect.left + rect.right) / 2.0, y}, planetSize, 1.4, INK);
+        }
+    }
+}
+
+} // namespace
+
+ChartImageRenderer::ChartImageRenderer() : chartStyle("western") {
+}
+
+bool ChartImageRenderer::setChartStyle(const std::string& style) {
+    auto styles = getAvailableStyles();
+    if (std::find(styles.begin(), styles.end(), style) == styles.end()) {
+        lastError = "No image layout for chart style \"" + style + "\"";
+        return false;
+    }
+    chartStyle = style;
+    return true;
+}
+
+bool ChartImageRenderer::render(const BirthChart& chart, Format format, std::string& output) const {
+    const StyleTemplate& tpl = styleTemplate(chartStyle);
+
+    Drawing drawing;
+    if (chartStyle == "western") {
+        drawWesternChart(chart, drawing);
+    } else {
+        drawGridChart(chart, tpl, drawing);
+    }
+
+    if (format == Format::SVG) {
+        output += tpl.svgFrame;
+        appendSvg(drawing, output);
+        output += "</g>\n</svg>\n";
+    } else {
+        RasterImage image = tpl.rasterFrame;
+        rasterize(drawing, image);
+        image.encodePng(output);
+    }
+    return true;
+}
+
+bool ChartImageRenderer::parseFormat(const std::string& name, Format& format) {
+    if (name == "svg") {
+        format = Format::SVG;
+    } else if (name == "png") {
+        format = Format::PNG;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+ChartImageRenderer::Format ChartImageRenderer::formatForFile(const std::string& filename) {
+    size_t dot = filename.rfind('.');
+    if (dot != std::string::npos) {
+        std::string extension = filename.substr(dot + 1);
+        std::transform(extension.begin(), extension.end(), extension.begin(), ::tolower);
+        if (extension == "png") return Format::PNG;
+    }
+    return Format::SVG;
+}
+
+std::vector<std::string> ChartImageRenderer::getAvailableStyles() {
+    return {"western", "north-indian", "south-indian", "east-indian"};
+}
+
+} // namespace Astro
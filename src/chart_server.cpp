@@ -0,0 +1,972 @@
+#include "chart_server.h"
+#include "birth_chart.h"
+#include "hindu_calendar.h"
+#include "horoscope_calculator.h"
+#include "json_writer.h"
+#include "kp_system.h"
+#include "myanmar_calendar.h"
+#include "timezone_resolver.h"
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cmath>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fcntl.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/time.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace Astro {
+
+namespace {
+
+constexpr size_t MAX_REQUEST_BYTES = 1 << 20;
+constexpr size_t READ_CHUNK = 64 * 1024;
+
+// A client that reads nothing for this long while a response is pending is dropped
+constexpr int SEND_TIMEOUT_SECONDS = 10;
+
+// Write end of the running server's wake pipe, for the signal handler
+volatile sig_atomic_t signalWakeFd = -1;
+
+void handleStopSignal(int) {
+    if (signalWakeFd >= 0) {
+        char byte = 's';
+        ssize_t ignored = write(signalWakeFd, &byte, 1);
+        (void)ignored;
+    }
+}
+
+// One member of a request object. Strings are unescaped; numbers, booleans and
+// null keep their JSON text.
+struct RequestValue {
+    std::string text;
+    bool isString = false;
+};
+
+using Request = std::map<std::string, RequestValue>;
+
+// Parser for the flat request objects: {"key": scalar, ...}
+class RequestParser {
+public:
+    explicit RequestParser(const std::string& line) : text(line), pos(0) {}
+
+    bool parse(Request& request, std::string& error) {
+        skipSpace();
+        if (!consume('{')) return fail(error, "request must be a JSON object");
+
+        skipSpace();
+        if (consume('}')) return finish(error);
+
+        while (true) {
+            std::string name;
+            skipSpace();
+            if (!parseString(name)) return fail(error, "expected member name");
+
+            skipSpace();
+            if (!consume(':')) return fail(error, "expected ':' after \"" + name + "\"");
+
+            skipSpace();
+            RequestValue value;
+            if (peek() == '"') {
+                value.isString = true;
+                if (!parseString(value.text)) return fail(error, "bad string value for \"" + name + "\"");
+            } else if (peek() == '{' || peek() == '[') {
+                return fail(error, "\"" + name + "\": nested values are not supported");
+            } else {
+                size_t start = pos;
+                while (pos < text.size() && text[pos] != ',' && text[pos] != '}' &&
+                       !std::isspace(static_cast<unsigned char>(text[pos]))) {
+                    pos++;
+                }
+                value.text = text.substr(start, pos - start);
+                if (value.text.empty()) return fail(error, "missing value for \"" + name + "\"");
+            }
+            request[name] = std::move(value);
+
+            skipSpace();
+            if (consume(',')) continue;
+            if (consume('}')) return finish(error);
+            return fail(error, "expected ',' or '}'");
+        }
+    }
+
+private:
+    const std::string& text;
+    size_t pos;
+
+    char peek() const { return pos < text.size() ? text[pos] : '\0'; }
+
+    bool consume(char c) {
+        if (peek() != c) return false;
+        pos++;
+        return true;
+    }
+
+    void skipSpace() {
+        while (pos < text.size() && std::isspace(static_cast<unsigned char>(text[pos]))) {
+            pos++;
+        }
+    }
+
+    bool finish(std::string& error) {
+        skipSpace();
+        return pos == text.size() || fail(error, "trailing characters after request object");
+    }
+
+    static bool fail(std::string& error, const std::string& message) {
+        error = "invalid request: " + message;
+        return false;
+    }
+
+    bool parseHex4(unsigned& code) {
+        if (pos + 4 > text.size()) return false;
+        code = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = text[pos++];
+            code <<= 4;
+            if (c >= '0' && c <= '9') code |= c - '0';
+            else if (c >= 'a' && c <= 'f') code |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') code |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+
+    static void appendUtf8(std::string& out, unsigned code) {
+        if (code < 0x80) {
+            out += static_cast<char>(code);
+        } else if (code < 0x800) {
+            out += static_cast<char>(0xC0 | (code >> 6));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else if (code < 0x10000) {
+            out += static_cast<char>(0xE0 | (code >> 12));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        } else {
+            out += static_cast<char>(0xF0 | (code >> 18));
+            out += static_cast<char>(0x80 | ((code >> 12) & 0x3F));
+            out += static_cast<char>(0x80 | ((code >> 6) & 0x3F));
+            out += static_cast<char>(0x80 | (code & 0x3F));
+        }
+    }
+
+    bool parseString(std::string& out) {
+        if (!consume('"')) return false;
+
+        while (pos < text.size()) {
+            char c = text[pos++];
+            if (c == '"') return true;
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (pos >= text.size()) return false;
+
+            switch (text[pos++]) {
+                case '"':  out += '"'; break;
+                case '\\': out += '\\'; break;
+                case '/':  out += '/'; break;
+                case 'b':  out += '\b'; break;
+                case 'f':  out += '\f'; break;
+                case 'n':  out += '\n'; break;
+                case 'r':  out += '\r'; break;
+                case 't':  out += '\t'; break;
+                case 'u': {
+                    unsigned code;
+                    if (!parseHex4(code)) return false;
+                    if (code >= 0xD800 && code <= 0xDBFF) {
+                        unsigned low;
+                        if (!consume('\\') || !consume('u') || !parseHex4(low) ||
+                            low < 0xDC00 || low > 0xDFFF) {
+                            return false;
+                        }
+                        code = 0x10000 + ((code - 0xD800) << 10) + (low - 0xDC00);
+                    }
+                    appendUtf8(out, code);
+                    break;
+                }
+                default:
+                    return false;
+            }
+        }
+        return false;
+    }
+};
+
+const RequestValue* member(const Request& request, const std::string& name) {
+    auto it = request.find(name);
+    return it == request.end() || (!it->second.isString && it->second.text == "null") ? nullptr : &it->second;
+}
+
+bool numberMember(const Request& request, const std::string& name, double& value, std::string& error) {
+    const RequestValue* v = member(request, name);
+    if (!v) return false;
+
+    char* end = nullptr;
+    value = std::strtod(v->text.c_str(), &end);
+    if (v->text.empty() || *end != '\0' || !std::isfinite(value)) {
+        error = "\"" + name + "\" must be a number";
+        return false;
+    }
+    return true;
+}
+
+// "limit" as a result count; numberMember has already rejected NaN and infinities
+int resultLimit(double limit) {
+    return static_cast<int>(std::min(std::max(limit, 1.0), 1000.0));
+}
+
+// A JSON number, true, false or null, the only non-string ids echoed back
+bool isJsonScalar(const std::string& text) {
+    if (text == "true" || text == "false" || text == "null") return true;
+
+    size_t i = 0;
+    auto digits = [&]() {
+        size_t start = i;
+        while (i < text.size() && std::isdigit(static_cast<unsigned char>(text[i]))) i++;
+        return i > start;
+    };
+    if (i < text.size() && text[i] == '-') i++;
+    if (i < text.size() && text[i] == '0') {
+        i++;
+    } else if (!digits()) {
+        return false;
+    }
+    if (i < text.size() && text[i] == '.') {
+        i++;
+        if (!digits()) return false;
+    }
+    if (i < text.size() && (text[i] == 'e' || text[i] == 'E')) {
+        i++;
+        if (i < text.size() && (text[i] == '+' || text[i] == '-')) i++;
+        if (!digits()) return false;
+    }
+    return i == text.size();
+}
+
+bool parseTimeOfDay(const std::string& text, int& hour, int& minute, int& second) {
+    char tail;
+    second = 0;
+    int fields = std::sscanf(text.c_str(), "%d:%d:%d%c", &hour, &minute, &second, &tail);
+    if (fields != 2 && fields != 3) return false;
+    return hour >= 0 && hour <= 23 && minute >= 0 && minute <= 59 && second >= 0 && second <= 59;
+}
+
+// Same letters as --house-system
+HouseSystem houseSystemFromString(const std::string& text) {
+    switch (text.empty() ? 'P' : std::toupper(static_cast<unsigned char>(text[0]))) {
+        case 'K': return HouseSystem::KOCH;
+        case 'E': return HouseSystem::EQUAL;
+        case 'W': return HouseSystem::WHOLE_SIGN;
+        case 'C': return HouseSystem::CAMPANUS;
+        case 'R': return HouseSystem::REGIOMONTANUS;
+        default:  return HouseSystem::PLACIDUS;
+    }
+}
+
+bool isWorkerCommand(const std::string& command) {
+    return command == "chart" || command == "kp" || command == "panchanga" ||
+           command == "myanmar" || command == "search-location" || command == "nearest-location";
+}
+
+uint64_t microsSince(std::chrono::steady_clock::time_point start) {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::microseconds>(
+        std::chrono::steady_clock::now() - start).count());
+}
+
+// Generator output is pretty or followed by a newline; the response line needs it bare
+std::string_view trimmed(const std::string& json) {
+    size_t end = json.find_last_not_of(" \t\r\n");
+    return std::string_view(json.data(), end == std::string::npos ? 0 : end + 1);
+}
+
+} // namespace
+
+// ---------------------------------------------------------------------------
+// ServerMetrics
+
+ServerMetrics::ServerMetrics() : startTime(std::chrono::steady_clock::now()) {
+}
+
+int ServerMetrics::bucketOf(uint64_t micros) {
+    if (micros < 4) return static_cast<int>(micros);
+
+    micros = std::min<uint64_t>(micros, 0xFFFFFFFFull);
+    int exponent = 63 - __builtin_clzll(micros);
+    int sub = static_cast<int>((micros >> (exponent - 2)) & 3);
+    return 4 * (exponent - 1) + sub;
+}
+
+uint64_t ServerMetrics::bucketUpperBound(int bucket) {
+    if (bucket < 4) return static_cast<uint64_t>(bucket);
+
+    int exponent = bucket / 4 + 1;
+    uint64_t lower = static_cast<uint64_t>(4 + bucket % 4) << (exponent - 2);
+    return lower + (1ull << (exponent - 2)) - 1;
+}
+
+uint64_t ServerMetrics::CommandStats::percentile(double fraction) const {
+    if (count == 0) return 0;
+
+    uint64_t target = static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(count)));
+    uint64_t seen = 0;
+    for (int b = 0; b < BUCKETS; b++) {
+        seen += buckets[b];
+        if (seen >= target) {
+            return std::min(bucketUpperBound(b), maxMicros);
+        }
+    }
+    return maxMicros;
+}
+
+void ServerMetrics::record(const std::string& command, uint64_t micros, bool ok) {
+    std::lock_guard<std::mutex> lock(mutex);
+    CommandStats& stats = commands[command];
+    stats.count++;
+    if (!ok) stats.errors++;
+    stats.totalMicros += micros;
+    stats.maxMicros = std::max(stats.maxMicros, micros);
+    stats.buckets[bucketOf(micros)]++;
+}
+
+std::string ServerMetrics::toJSON(int workers, size_t queueDepth) const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    uint64_t requests = 0;
+    uint64_t errors = 0;
+    for (const auto& entry : commands) {
+        requests += entry.second.count;
+        errors += entry.second.errors;
+    }
+
+    JsonWriter json(JsonStyle::COMPACT);
+    json.beginObject();
+    json.field("uptime_s", std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count());
+    json.field("workers", workers);
+    json.field("queue_depth", queueDepth);
+    json.field("requests", requests);
+    json.field("errors", errors);
+    json.key("commands").beginObject();
+    for (const auto& [name, stats] : commands) {
+        json.key(name).beginObject();
+        json.field("count", stats.count);
+        json.field("errors", stats.errors);
+        json.field("mean_us", static_cast<double>(stats.totalMicros) / static_cast<double>(stats.count));
+        json.field("p50_us", stats.percentile(0.50));
+        json.field("p90_us", stats.percentile(0.90));
+        json.field("p99_us", stats.percentile(0.99));
+        json.field("max_us", stats.maxMicros);
+        json.endObject();
+    }
+    json.endObject();
+    json.endObject();
+    return json.take();
+}
+
+std::string ServerMetrics::summary() const {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    std::string out;
+    char line[160];
+    for (const auto& [name, stats] : commands) {
+        std::snprintf(line, sizeof(line),
+                      "%-16s %8llu requests %6llu errors  mean %8.1f us  p50 %6llu us  p99 %6llu us  max %6llu us\n",
+                      name.c_str(),
+                      static_cast<unsigned long long>(stats.count),
+                      static_cast<unsigned long long>(stats.errors),
+                      static_cast<double>(stats.totalMicros) / static_cast<double>(stats.count),
+                      static_cast<unsigned long long>(stats.percentile(0.50)),
+                      static_cast<unsigned long long>(stats.percentile(0.99)),
+                      static_cast<unsigned long long>(stats.maxMicros));
+        out += line;
+    }
+    return out;
+}
+
+// ---------------------------------------------------------------------------
+// Connection and worker
+
+struct ChartServer::Connection {
+    int fd;
+    std::string pending;          // bytes after the last complete line
+    std::mutex writeMutex;
+    bool broken = false;          // guarded by writeMutex
+
+    explicit Connection(int fd) : fd(fd) {}
+    ~Connection() { ::close(fd); }
+
+    // Responses are written whole, so concurrent workers never interleave lines.
+    // A client that has gone away is not an error for the server. One that
+    // stops reading makes a write time out (SO_SNDTIMEO); the connection is
+    // then shut down, which the poll loop sees as a hangup and drops.
+    void send(const std::string& line) {
+        std::lock_guard<std::mutex> lock(writeMutex);
+        if (broken) return;
+        size_t written = 0;
+        while (written < line.size()) {
+            ssize_t n = ::send(fd, line.data() + written, line.size() - written, MSG_NOSIGNAL);
+            if (n < 0 && errno == EINTR) continue;
+            if (n <= 0) {
+                broken = true;
+                ::shutdown(fd, SHUT_RDWR);
+                return;
+            }
+            written += static_cast<size_t>(n);
+        }
+    }
+};
+
+// Calculators owned by one worker thread. Swiss Ephemeris keeps its state in
+// thread-local storage, so they are initialized on the thread that uses them.
+class ChartServer::Worker {
+public:
+    explicit Worker(const LocationManager& locations) : locations(locations) {}
+
+    bool initialize(const Options& options, std::string& error) {
+        if (!calculator.initialize(options.ephemerisPath)) {
+            error = "failed to initialize calculator: " + calculator.getLastError();
+            return false;
+        }
+        if (!hinduCalendar.initialize()) {
+            error = "failed to initialize Hindu calendar: " + hinduCalendar.getLastError();
+            return false;
+        }
+        if (!options.festivalRulesFile.empty() && !hinduCalendar.loadFestivalRules(options.festivalRulesFile)) {
+            error = "failed to load festival rules: " + hinduCalendar.getLastError();
+            return false;
+        }
+        if (!myanmarCalendar.initialize()) {
+            error = "failed to initialize Myanmar calendar: " + myanmarCalendar.getLastError();
+            return false;
+        }
+        if (!kpSystem.initialize()) {
+            error = "failed to initialize KP system: " + kpSystem.getLastError();
+            return false;
+        }
+        return true;
+    }
+
+    // Run one of the isWorkerCommand() commands; result receives its JSON text
+    bool execute(const std::string& command, const Request& request,
+                 std::string& result, std::string& error) {
+        if (command == "search-location") {
+            return searchLocation(request, result, error);
+        }
+        if (command == "nearest-location") {
+            return nearestLocation(request, result, error);
+        }
+
+        BirthData birthData;
+        if (!birthDataFrom(request, birthData, error)) {
+            return false;
+        }
+
+        if (command == "chart" || command == "kp") {
+            BirthChart chart;
+            if (!calculateChart(request, birthData, chart, error)) {
+                return false;
+            }
+            result = command == "chart" ? chart.exportToJson()
+                                        : kpSystem.generateKPTableJSON(chart.getPlanetPositions());
+            return true;
+        }
+        if (command == "panchanga") {
+            result = hinduCalendar.generateJSON(hinduCalendar.calculatePanchanga(birthData));
+        } else {
+            result = myanmarCalendar.generateJSON(myanmarCalendar.calculateMyanmarDate(birthData));
+        }
+        return true;
+    }
+
+private:
+    const LocationManager& locations;
+    TimeZoneResolver timeZones;
+    HoroscopeCalculator calculator;
+    HinduCalendar hinduCalendar;
+    MyanmarCalendar myanmarCalendar;
+    KPSystem kpSystem;
+
+    bool birthDataFrom(const Request& request, BirthData& birthData, std::string& error) {
+        const RequestValue* date = member(request, "date");
+        if (!date) {
+            error = "\"date\" is required";
+            return false;
+        }
+        if (!parseBCDate(date->text, birthData.year, birthData.month, birthData.day)) {
+            error = "invalid date \"" + date->text + "\"";
+            return false;
+        }
+
+        const RequestValue* time = member(request, "time");
+        birthData.hour = 12;
+        birthData.minute = 0;
+        birthData.second = 0;
+        if (time && !parseTimeOfDay(time->text, birthData.hour, birthData.minute, birthData.second)) {
+            error = "invalid time \"" + time->text + "\"";
+            return false;
+        }
+
+        birthData.latitude = 0.0;
+        birthData.longitude = 0.0;
+        birthData.timezone = 0.0;
+
+        // "tz" (an IANA zone) overrides "timezone" and the location's own zone
+        const RequestValue* zone = member(request, "tz");
+        std::string zoneName = zone ? zone->text : "";
+
+        if (const RequestValue* name = member(request, "location")) {
+            Location location = locations.getLocationByName(name->text);
+            if (location.name.empty()) {
+                error = "location \"" + name->text + "\" not found";
+                return false;
+            }
+            birthData.latitude = location.latitude;
+            birthData.longitude = location.longitude;
+            birthData.timezone = location.timezone;
+            if (zoneName.empty()) {
+                zoneName = location.timezoneStr;
+            }
+            return resolveZone(zoneName, birthData, error);
+        }
+
+        bool hasLat = numberMember(request, "lat", birthData.latitude, error);
+        if (!error.empty()) return false;
+        bool hasLon = numberMember(request, "lon", birthData.longitude, error);
+        if (!error.empty()) return false;
+        numberMember(request, "timezone", birthData.timezone, error);
+        if (!error.empty()) return false;
+
+        if (!hasLat || !hasLon) {
+            error = "\"location\" or \"lat\" and \"lon\" are required";
+            return false;
+        }
+        if (birthData.latitude < -90.0 || birthData.latitude > 90.0 ||
+            birthData.longitude < -180.0 || birthData.longitude > 180.0) {
+            error = "coordinates out of range";
+            return false;
+        }
+        return resolveZone(zoneName, birthData, error);
+    }
+
+    bool resolveZone(const std::string& zoneName, BirthData& birthData, std::string& error) {
+        if (!zoneName.empty() && !timeZones.resolve(zoneName, birthData)) {
+            error = timeZones.getLastError();
+            return false;
+        }
+        return true;
+    }
+
+    bool calculateChart(const Request& request, const BirthData& birthData,
+                        BirthChart& chart, std::string& error) {
+        const RequestValue* houseSystem = member(request, "house-system");
+        const RequestValue* zodiacMode = member(request, "zodiac-mode");
+        const RequestValue* ayanamsa = member(request, "ayanamsa");
+
+        HouseSystem hs = houseSystem ? houseSystemFromString(houseSystem->text) : HouseSystem::PLACIDUS;
+        ZodiacMode mode = zodiacMode ? stringToZodiacMode(zodiacMode->text) : ZodiacMode::TROPICAL;
+        AyanamsaType type = ayanamsa ? stringToAyanamsaType(ayanamsa->text) : AyanamsaType::LAHIRI;
+
+        calculator.setZodiacMode(mode);
+        calculator.setAyanamsa(type);
+        if (!calculator.calculateBirthChart(birthData, hs, mode, type, chart)) {
+            error = "failed to calculate birth chart: " + calculator.getLastError();
+            return false;
+        }
+        return true;
+    }
+
+    bool searchLocation(const Request& request, std::string& result, std::string& error) {
+        const RequestValue* query = member(request, "search-location");
+        if (!query) {
+            error = "\"search-location\" is required";
+            return false;
+        }
+
+        double limit = 10.0;
+        numberMember(request, "limit", limit, error);
+        if (!error.empty()) return false;
+
+        JsonWriter json(JsonStyle::COMPACT);
+        json.beginObject();
+        json.key("locations").beginArray();
+        for (const auto& location : locations.searchLocations(query->text, resultLimit(limit))) {
+            json.beginObject();
+            json.field("name", location.name);
+            json.field("country", location.country);
+            json.field("region", location.region);
+            json.field("latitude", location.latitude);
+            json.field("longitude", location.longitude);
+            json.field("timezone", location.timezone);
+            json.endObject();
+        }
+        json.endArray();
+        json.endObject();
+        result = json.take();
+        return true;
+    }
+
+    bool nearestLocation(const Request& request, std::string& result, std::string& error) {
+        double latitude = 0.0, longitude = 0.0, limit = 5.0, radius = -1.0;
+        bool hasLat = numberMember(request, "lat", latitude, error);
+        if (!error.empty()) return false;
+        bool hasLon = numberMember(request, "lon", longitude, error);
+        if (!error.empty()) return false;
+        numberMember(request, "limit", limit, error);
+        if (!error.empty()) return false;
+        bool hasRadius = numberMember(request, "radius", radius, error);
+        if (!error.empty()) return false;
+
+        if (!hasLat || !hasLon) {
+            error = "\"lat\" and \"lon\" are required";
+            return false;
+        }
+        if (latitude < -90.0 || latitude > 90.0 || longitude < -180.0 || longitude > 180.0) {
+            error = "coordinates out of range";
+            return false;
+        }
+
+        // "radius" (km) lists every location within it; otherwise the nearest "limit"
+        auto nearby = hasRadius ? locations.findWithinRadius(latitude, longitude, radius)
+                                : locations.findNearest(latitude, longitude, resultLimit(limit));
+
+        JsonWriter json(JsonStyle::COMPACT);
+        json.beginObject();
+        json.key("locations").beginArray();
+        for (const auto& entry : nearby) {
+            json.beginObject();
+            json.field("name", entry.location.name);
+            json.field("country", entry.location.country);
+            json.field("region", entry.location.region);
+            json.field("latitude", entry.location.latitude);
+            json.field("longitude", entry.location.longitude);
+            json.field("timezone", entry.location.timezone);
+            json.field("distance_km", entry.distanceKm);
+            json.endObject();
+        }
+        json.endArray();
+        json.endObject();
+        result = json.take();
+        return true;
+    }
+};
+
+// ---------------------------------------------------------------------------
+// ChartServer
+
+ChartServer::ChartServer()
+    : listenFd(-1), wakePipe{-1, -1}, stopping(false), queueClosed(false), workersReady(0) {
+}
+
+ChartServer::~ChartServer() {
+    stopWorkers();
+    if (listenFd >= 0) ::close(listenFd);
+    if (wakePipe[0] >= 0) ::close(wakePipe[0]);
+    if (wakePipe[1] >= 0) ::close(wakePipe[1]);
+}
+
+bool ChartServer::start(const Options& serverOptions) {
+    options = serverOptions;
+
+    // Responses are single lines, so every generator writes compact JSON
+    JsonWriter::setDefaultStyle(JsonStyle::COMPACT);
+
+    if (options.workers <= 0) {
+        options.workers = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    if (pipe(wakePipe) != 0) {
+        lastError = std::string("cannot create wake pipe: ") + std::strerror(errno);
+        return false;
+    }
+    fcntl(wakePipe[0], F_SETFL, O_NONBLOCK);
+    fcntl(wakePipe[1], F_SETFL, O_NONBLOCK);
+
+    if (!bindSocket()) {
+        return false;
+    }
+
+    startWorkers(options.workers);
+
+    std::unique_lock<std::mutex> lock(startupMutex);
+    startupDone.wait(lock, [&] { return workersReady == options.workers; });
+    if (!workerError.empty()) {
+        lastError = workerError;
+        lock.unlock();
+        stopWorkers();
+        ::close(listenFd);
+        listenFd = -1;
+        unlink(options.socketPath.c_str());
+        return false;
+    }
+    return true;
+}
+
+bool ChartServer::bindSocket() {
+    sockaddr_un address = {};
+    address.sun_family = AF_UNIX;
+    if (options.socketPath.empty() || options.socketPath.size() >= sizeof(address.sun_path)) {
+        lastError = "socket path must be 1-" + std::to_string(sizeof(address.sun_path) - 1) + " characters";
+        return false;
+    }
+    std::memcpy(address.sun_path, options.socketPath.c_str(), options.socketPath.size() + 1);
+
+    listenFd = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (listenFd < 0) {
+        lastError = std::string("cannot create socket: ") + std::strerror(errno);
+        return false;
+    }
+
+    // A socket file left by a server that is gone is replaced; a live one is not
+    struct stat info;
+    if (lstat(options.socketPath.c_str(), &info) == 0) {
+        if (!S_ISSOCK(info.st_mode)) {
+            lastError = options.socketPath + " exists and is not a socket";
+            return false;
+        }
+        int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+        bool live = connect(probe, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0;
+        ::close(probe);
+        if (live) {
+            lastError = "another server is listening on " + options.socketPath;
+            return false;
+        }
+        unlink(options.socketPath.c_str());
+    }
+
+    if (bind(listenFd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+        listen(listenFd, SOMAXCONN) != 0) {
+        lastError = "cannot listen on " + options.socketPath + ": " + std::strerror(errno);
+        return false;
+    }
+    return true;
+}
+
+void ChartServer::startWorkers(int count) {
+    for (int i = 0; i < count; i++) {
+        workerThreads.emplace_back(&ChartServer::workerLoop, this);
+    }
+}
+
+void ChartServer::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queueClosed = true;
+    }
+    queueReady.notify_all();
+
+    for (auto& thread : workerThreads) {
+        thread.join();
+    }
+    workerThreads.clear();
+}
+
+void ChartServer::workerLoop() {
+    Worker worker(locationManager);
+    {
+        std::string error;
+        bool ok = worker.initialize(options, error);
+
+        std::lock_guard<std::mutex> lock(startupMutex);
+        if (!ok && workerError.empty()) workerError = error;
+        workersReady++;
+        startupDone.notify_all();
+        if (!ok) return;
+    }
+
+    while (true) {
+        Job job;
+        size_t queueDepth;
+        {
+            std::unique_lock<std::mutex> lock(queueMutex);
+            queueReady.wait(lock, [&] { return queueClosed || !queue.empty(); });
+            if (queue.empty()) return;   // closed and drained
+            job = std::move(queue.front());
+            queue.pop_front();
+            queueDepth = queue.size();
+        }
+
+        auto serviceStart = std::chrono::steady_clock::now();
+        Request request;
+        std::string error;
+        std::string result;
+        std::string command = "invalid";
+        bool ok = RequestParser(job.line).parse(request, error);
+
+        // Non-string ids are copied into the response verbatim, so only JSON scalars pass
+        auto id = request.find("id");
+        if (id != request.end() && !id->second.isString && !isJsonScalar(id->second.text)) {
+            request.erase(id);
+            if (ok) error = "invalid id";
+            ok = false;
+        }
+
+        if (ok) {
+            const RequestValue* name = member(request, "command");
+            command = name ? name->text : "chart";
+            if (command == "ping") {
+                result = "{}";
+            } else if (command == "stats") {
+                result = metrics.toJSON(options.workers, queueDepth);
+            } else if (isWorkerCommand(command)) {
+                ok = worker.execute(command, request, result, error);
+            } else {
+                error = "unknown command \"" + command + "\"";
+                command = "invalid";   // keeps the metrics keyed by known commands
+                ok = false;
+            }
+        }
+
+        JsonWriter response(JsonStyle::COMPACT);
+        response.reserve(result.size() + 64);
+        response.beginObject();
+        id = request.find("id");
+        if (id != request.end()) {
+            response.key("id");
+            if (id->second.isString) {
+                response.value(id->second.text);
+            } else {
+                response.raw(id->second.text);
+            }
+        }
+        response.field("ok", ok);
+        if (ok) {
+            response.field("elapsed_us", microsSince(serviceStart));
+            response.key("result").raw(trimmed(result));
+        } else {
+            response.field("error", error);
+        }
+        response.endObject();
+
+        std::string line = response.take();
+        line += '\n';
+        job.connection->send(line);
+
+        metrics.record(command, microsSince(job.received), ok);
+    }
+}
+
+void ChartServer::enqueue(const std::shared_ptr<Connection>& connection, std::string line) {
+    {
+        std::lock_guard<std::mutex> lock(queueMutex);
+        queue.push_back(Job{connection, std::move(line), std::chrono::steady_clock::now()});
+    }
+    queueReady.notify_one();
+}
+
+bool ChartServer::readFrom(const std::shared_ptr<Connection>& connection) {
+    char buffer[READ_CHUNK];
+    ssize_t n = ::read(connection->fd, buffer, sizeof(buffer));
+    if (n < 0 && (errno == EINTR || errno == EAGAIN)) return true;
+    if (n <= 0) return false;
+
+    std::string& pending = connection->pending;
+    pending.append(buffer, static_cast<size_t>(n));
+
+    size_t lineStart = 0;
+    size_t newline;
+    while ((newline = pending.find('\n', lineStart)) != std::string::npos) {
+        size_t lineEnd = newline;
+        if (lineEnd > lineStart && pending[lineEnd - 1] == '\r') lineEnd--;
+        if (lineEnd > lineStart) {
+            enqueue(connection, pending.substr(lineStart, lineEnd - lineStart));
+        }
+        lineStart = newline + 1;
+    }
+    pending.erase(0, lineStart);
+
+    if (pending.size() > MAX_REQUEST_BYTES) {
+        connection->send("{\"ok\":false,\"error\":\"request exceeds 1 MiB\"}\n");
+        return false;
+    }
+    return true;
+}
+
+bool ChartServer::run() {
+    if (listenFd < 0) {
+        lastError = "server not started";
+        return false;
+    }
+
+    struct sigaction action = {};
+    struct sigaction oldInt, oldTerm;
+    action.sa_handler = handleStopSignal;
+    sigemptyset(&action.sa_mask);
+    signalWakeFd = wakePipe[1];
+    sigaction(SIGINT, &action, &oldInt);
+    sigaction(SIGTERM, &action, &oldTerm);
+
+    std::vector<std::shared_ptr<Connection>> connections;
+    std::vector<pollfd> fds;
+    bool ok = true;
+
+    while (!stopping) {
+        fds.clear();
+        fds.push_back({wakePipe[0], POLLIN, 0});
+        fds.push_back({listenFd, POLLIN, 0});
+        for (const auto& connection : connections) {
+            fds.push_back({connection->fd, POLLIN, 0});
+        }
+
+        if (poll(fds.data(), fds.size(), -1) < 0) {
+            if (errno == EINTR) continue;
+            lastError = std::string("poll failed: ") + std::strerror(errno);
+            ok = false;
+            break;
+        }
+
+        if (fds[0].revents) {
+            break;   // stop() or a signal
+        }
+
+        // Connections first: fds[2 + i] belongs to connections[i]
+        size_t kept = 0;
+        for (size_t i = 0; i < connections.size(); i++) {
+            short events = fds[2 + i].revents;
+            bool open = !(events & (POLLIN | POLLHUP | POLLERR)) || readFrom(connections[i]);
+            if (open) {
+                connections[kept++] = std::move(connections[i]);
+            }
+        }
+        connections.resize(kept);
+
+        if (fds[1].revents & POLLIN) {
+            int client = accept4(listenFd, nullptr, nullptr, SOCK_CLOEXEC);
+            if (client >= 0) {
+                timeval timeout = {SEND_TIMEOUT_SECONDS, 0};
+                setsockopt(client, SOL_SOCKET, SO_SNDTIMEO, &timeout, sizeof(timeout));
+                connections.push_back(std::make_shared<Connection>(client));
+            }
+        }
+    }
+
+    sigaction(SIGINT, &oldInt, nullptr);
+    sigaction(SIGTERM, &oldTerm, nullptr);
+    signalWakeFd = -1;
+
+    ::close(listenFd);
+    listenFd = -1;
+    unlink(options.socketPath.c_str());
+
+    // Let the workers answer what has already been read
+    stopWorkers();
+    connections.clear();
+    return ok;
+}
+
+void ChartServer::stop() {
+    stopping = true;
+    if (wakePipe[1] >= 0) {
+        char byte = 'q';
+        ssize_t ignored = write(wakePipe[1], &byte, 1);
+        (void)ignored;
+    }
+}
+
+} // namespace Astro
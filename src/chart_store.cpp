@@ -0,0 +1,451 @@
+#include "chart_store.h"
+#include "house_calculator.h"
+#include "swiss_ephemeris.h"
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace Astro {
+
+namespace {
+
+constexpr char STORE_MAGIC[8] = {'H', 'C', 'S', 'T', 'O', 'R', 'E', '\0'};
+constexpr uint32_t STORE_VERSION = 1;
+
+struct StoreHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t recordSize;
+    uint64_t recordCount;
+    uint8_t zodiacMode;
+    uint8_t ayanamsa;
+    uint8_t houseSystem;
+    uint8_t reserved[37];
+};
+
+static_assert(sizeof(StoreHeader) == 64, "StoreHeader layout is part of the file format");
+
+constexpr std::streamoff HEADER_SIZE = sizeof(StoreHeader);
+constexpr std::streamoff RECORD_COUNT_OFFSET = offsetof(StoreHeader, recordCount);
+
+constexpr float NAKSHATRA_SPAN = 360.0f / 27.0f;
+
+bool validateHeader(const StoreHeader& header, std::string& error) {
+    if (std::memcmp(header.magic, STORE_MAGIC, sizeof(STORE_MAGIC)) != 0) {
+        error = "not a chart store file";
+        return false;
+    }
+    if (header.version != STORE_VERSION) {
+        error = "unsupported chart store version " + std::to_string(header.version);
+        return false;
+    }
+    if (header.recordSize != sizeof(ChartRecord)) {
+        error = "unexpected chart record size " + std::to_string(header.recordSize);
+        return false;
+    }
+    return true;
+}
+
+float storedLongitude(double longitude) {
+    float value = static_cast<float>(normalizeAngle(longitude));
+    return value >= 360.0f ? 0.0f : value;  // rounding up to 360 wraps to Aries 0
+}
+
+} // namespace
+
+ChartRecord ChartRecord::fromChart(uint64_t id, const BirthChart& chart, double ayanamsaDegrees) {
+    ChartRecord record;
+    std::memset(&record, 0, sizeof(record));
+
+    const BirthData& birth = chart.getBirthData();
+    record.id = id;
+    record.julianDay = birth.getJulianDay();
+    record.year = static_cast<int16_t>(birth.year);
+    record.month = static_cast<uint8_t>(birth.month);
+    record.day = static_cast<uint8_t>(birth.day);
+    record.hour = static_cast<uint8_t>(birth.hour);
+    record.minute = static_cast<uint8_t>(birth.minute);
+    record.second = static_cast<uint8_t>(birth.second);
+    record.latitude = static_cast<float>(birth.latitude);
+    record.longitude = static_cast<float>(birth.longitude);
+    record.timezone = static_cast<float>(birth.timezone);
+    record.ayanamsa = static_cast<float>(ayanamsaDegrees);
+
+    for (const auto& pos : chart.getPlanetPositions()) {
+        size_t body = static_cast<size_t>(pos.planet);
+        if (body >= BODY_COUNT) continue;
+
+        record.bodyMask |= 1u << body;
+        record.longitudes[body] = storedLongitude(pos.longitude);
+        record.speeds[body] = static_cast<float>(pos.speed);
+        record.houses[body] = static_cast<uint8_t>(pos.house);
+    }
+
+    const HouseCusps& cusps = chart.getHouseCusps();
+    for (int house = 1; house <= 12; house++) {
+        record.cusps[house - 1] = storedLongitude(cusps.cusps[house]);
+    }
+    record.ascendant = storedLongitude(cusps.ascendant);
+    record.midheaven = storedLongitude(cusps.midheaven);
+
+    return record;
+}
+
+ChartQuery& ChartQuery::sign(Planet planet, ZodiacSign sign) {
+    float from = static_cast<float>(sign) * 30.0f;
+    conditions.push_back({Condition::Kind::LONGITUDE, static_cast<uint8_t>(planet), 0, from, from + 30.0f});
+    return *this;
+}
+
+ChartQuery& ChartQuery::house(Planet planet, int house) {
+    conditions.push_back({Condition::Kind::HOUSE, static_cast<uint8_t>(planet),
+                          static_cast<uint8_t>(house), 0.0f, 0.0f});
+    return *this;
+}
+
+ChartQuery& ChartQuery::nakshatra(Planet planet, int nakshatra) {
+    float from = static_cast<float>(nakshatra - 1) * NAKSHATRA_SPAN;
+    conditions.push_back({Condition::Kind::SIDEREAL_LONGITUDE, static_cast<uint8_t>(planet), 0,
+                          from, from + NAKSHATRA_SPAN});
+    return *this;
+}
+
+ChartQuery& ChartQuery::ascendantSign(ZodiacSign sign) {
+    float from = static_cast<float>(sign) * 30.0f;
+    conditions.push_back({Condition::Kind::ASCENDANT, 0, 0, from, from + 30.0f});
+    return *this;
+}
+
+// ChartStoreWriter
+
+ChartStoreWriter::ChartStoreWriter()
+    : recordCount(0), zodiacMode(ZodiacMode::TROPICAL), ayanamsa(AyanamsaType::LAHIRI),
+      houseSystem(HouseSystem::PLACIDUS) {
+}
+
+ChartStoreWriter::~ChartStoreWriter() {
+    close();
+}
+
+bool ChartStoreWriter::create(const std::string& filename, ZodiacMode mode,
+                              AyanamsaType ayanamsaType, HouseSystem system) {
+    close();
+
+    file.open(filename, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        lastError = "Cannot create chart store: " + filename;
+        return false;
+    }
+
+    StoreHeader header;
+    std::memset(&header, 0, sizeof(header));
+    std::memcpy(header.magic, STORE_MAGIC, sizeof(STORE_MAGIC));
+    header.version = STORE_VERSION;
+    header.recordSize = sizeof(ChartRecord);
+    header.zodiacMode = static_cast<uint8_t>(mode);
+    header.ayanamsa = static_cast<uint8_t>(ayanamsaType);
+    header.houseSystem = static_cast<uint8_t>(system);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    if (!file) {
+        lastError = "Cannot write chart store header: " + filename;
+        file.close();
+        return false;
+    }
+
+    recordCount = 0;
+    zodiacMode = mode;
+    ayanamsa = ayanamsaType;
+    houseSystem = system;
+    return true;
+}
+
+bool ChartStoreWriter::openForAppend(const std::string& filename) {
+    close();
+
+    file.open(filename, std::ios::in | std::ios::out | std::ios::binary);
+    if (!file.is_open()) {
+        lastError = "Cannot open chart store: " + filename;
+        return false;
+    }
+
+    StoreHeader header;
+    file.read(reinterpret_cast<char*>(&header), sizeof(header));
+    std::string error;
+    if (!file || !validateHeader(header, error)) {
+        lastError = filename + ": " + (error.empty() ? "truncated header" : error);
+        file.close();
+        return false;
+    }
+
+    recordCount = header.recordCount;
+    zodiacMode = static_cast<ZodiacMode>(header.zodiacMode);
+    ayanamsa = static_cast<AyanamsaType>(header.ayanamsa);
+    houseSystem = static_cast<HouseSystem>(header.houseSystem);
+
+    // Records written after the last close() are not counted; overwrite them
+    file.seekp(HEADER_SIZE + static_cast<std::streamoff>(recordCount * sizeof(ChartRecord)));
+    return true;
+}
+
+bool ChartStoreWriter::append(uint64_t id, const BirthChart& chart) {
+    if (chart.getZodiacMode() != zodiacMode ||
+        (zodiacMode == ZodiacMode::SIDEREAL && chart.getAyanamsa() != ayanamsa)) {
+        lastError = "Chart zodiac settings do not match the chart store";
+        return false;
+    }
+    if (chart.getHouseSystem() != houseSystem) {
+        lastError = "Chart house system does not match the chart store";
+        return false;
+    }
+
+    // Kept for tropical stores too, for sidereal-longitude queries
+    double ayanamsaDegrees = SwissEphemeris::ayanamsaUt(chart.getBirthData().getJulianDay(),
+                                                        ayanamsaTypeToSwissEphId(ayanamsa));
+
+    return append(ChartRecord::fromChart(id, chart, ayanamsaDegrees));
+}
+
+bool ChartStoreWriter::append(const ChartRecord& record) {
+    if (!file.is_open()) {
+        lastError = "Chart store is not open";
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&record), sizeof(record));
+    if (!file) {
+        lastError = "Failed to write chart record";
+        return false;
+    }
+
+    recordCount++;
+    return true;
+}
+
+bool ChartStoreWriter::close() {
+    if (!file.is_open()) {
+        return true;
+    }
+
+    file.seekp(RECORD_COUNT_OFFSET);
+    file.write(reinterpret_cast<const char*>(&recordCount), sizeof(recordCount));
+    bool ok = static_cast<bool>(file.flush());
+    file.close();
+
+    if (!ok) {
+        lastError = "Failed to update chart store header";
+    }
+    return ok;
+}
+
+// ChartStore
+
+ChartStore::ChartStore()
+    : mapping(nullptr), mappingSize(0), records(nullptr), recordCount(0),
+      zodiacMode(ZodiacMode::TROPICAL), ayanamsa(AyanamsaType::LAHIRI),
+      houseSystem(HouseSystem::PLACIDUS) {
+}
+
+ChartStore::~ChartStore() {
+    close();
+}
+
+bool ChartStore::open(const std::string& filename) {
+    close();
+
+    int fd = ::open(filename.c_str(), O_RDONLY);
+    if (fd < 0) {
+        lastError = "Cannot open chart store: " + filename;
+        return false;
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size < HEADER_SIZE) {
+        lastError = filename + ": truncated header";
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(info.st_size);
+    void* data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED) {
+        lastError = "Cannot map chart store: " + filename;
+        return false;
+    }
+
+    const StoreHeader* header = static_cast<const StoreHeader*>(data);
+    std::string error;
+    if (!validateHeader(*header, error)) {
+        lastError = filename + ": " + error;
+        munmap(data, size);
+        return false;
+    }
+    if (header->recordCount > (size - HEADER_SIZE) / sizeof(ChartRecord)) {
+        lastError = filename + ": file is shorter than its record count";
+        munmap(data, size);
+        return false;
+    }
+
+    mapping = data;
+    mappingSize = size;
+    records = reinterpret_cast<const ChartRecord*>(static_cast<const char*>(data) + HEADER_SIZE);
+    recordCount = header->recordCount;
+    zodiacMode = static_cast<ZodiacMode>(header->zodiacMode);
+    ayanamsa = static_cast<AyanamsaType>(header->ayanamsa);
+    houseSystem = static_cast<HouseSystem>(header->houseSystem);
+    return true;
+}
+
+void ChartStore::close() {
+    if (mapping) {
+        munmap(mapping, mappingSize);
+    }
+    mapping = nullptr;
+    mappingSize = 0;
+    records = nullptr;
+    recordCount = 0;
+}
+
+bool ChartStore::matches(const ChartRecord& record, const ChartQuery& query) const {
+    using Kind = ChartQuery::Condition::Kind;
+
+    for (const auto& condition : query.conditions) {
+        float value;
+        switch (condition.kind) {
+            case Kind::LONGITUDE:
+                if (!((record.bodyMask >> condition.body) & 1u)) return false;
+                value = record.longitudes[condition.body];
+                break;
+            case Kind::SIDEREAL_LONGITUDE:
+                if (!((record.bodyMask >> condition.body) & 1u)) return false;
+                value = record.longitudes[condition.body];
+                if (zodiacMode == ZodiacMode::TROPICAL) {
+                    value -= record.ayanamsa;
+                    if (value < 0.0f) value += 360.0f;
+                }
+                break;
+            case Kind::HOUSE:
+                if (record.houses[condition.body] != condition.house) return false;
+                continue;
+            case Kind::ASCENDANT:
+                value = record.ascendant;
+                break;
+            default:
+                return false;       // unknown field: matches nothing
+        }
+        if (value < condition.from || value >= condition.to) return false;
+    }
+    return true;
+}
+
+std::vector<uint32_t> ChartStore::query(const ChartQuery& query) const {
+    std::vector<uint32_t> result;
+    for (size_t i = 0; i < recordCount; i++) {
+        if (matches(records[i], query)) {
+            result.push_back(static_cast<uint32_t>(i));
+        }
+    }
+    return result;
+}
+
+size_t ChartStore::count(const ChartQuery& query) const {
+    size_t total = 0;
+    for (size_t i = 0; i < recordCount; i++) {
+        total += matches(records[i], query);
+    }
+    return total;
+}
+
+BirthData ChartStore::birthData(size_t index) const {
+    const ChartRecord& record = records[index];
+    BirthData data;
+    data.year = record.year;
+    data.month = record.month;
+    data.day = record.day;
+    data.hour = record.hour;
+    data.minute = record.minute;
+    data.second = record.second;
+    data.latitude = record.latitude;
+    data.longitude = record.longitude;
+    data.timezone = record.timezone;
+    return data;
+}
+
+HouseCusps ChartStore::houseCusps(size_t index) const {
+    const ChartRecord& record = records[index];
+    HouseCusps cusps;
+    cusps.cusps[0] = 0.0;
+    for (int house = 1; house <= 12; house++) {
+        cusps.cusps[house] = record.cusps[house - 1];
+    }
+    cusps.ascendant = record.ascendant;
+    cusps.midheaven = record.midheaven;
+    cusps.vertex = 0.0;
+    cusps.eastPoint = 0.0;
+    return cusps;
+}
+
+std::vector<PlanetPosition> ChartStore::planetPositions(size_t index) const {
+    const ChartRecord& record = records[index];
+    HouseCusps cusps = houseCusps(index);
+
+    std::vector<PlanetPosition> positions;
+    for (size_t body = 0; body < ChartRecord::BODY_COUNT; body++) {
+        if (!((record.bodyMask >> body) & 1u)) continue;
+
+        PlanetPosition pos{};
+        pos.planet = static_cast<Planet>(body);
+        pos.longitude = record.longitudes[body];
+        pos.speed = record.speeds[body];
+        pos.calculateSignPosition();
+        pos.house = record.houses[body];
+        pos.housePosition = HouseCalculator::getHousePosition(cusps, pos.longitude, pos.house);
+        positions.push_back(pos);
+    }
+    return positions;
+}
+
+ChartLongitudes ChartStore::longitudes(size_t index) const {
+    const ChartRecord& record = records[index];
+    ChartLongitudes chart;
+    for (size_t body = 0; body < ChartRecord::BODY_COUNT; body++) {
+        if (!((record.bodyMask >> body) & 1u)) continue;
+        chart.planets.push_back(static_cast<Planet>(body));
+        chart.longitudes.push_back(record.longitudes[body]);
+        chart.speeds.push_back(record.speeds[body]);
+    }
+    return chart;
+}
+
+ChartLongitudeMatrix ChartStore::longitudeMatrix(const std::vector<Planet>& planets,
+                                                 const std::vector<uint32_t>& indices) const {
+    ChartLongitudeMatrix matrix(planets);
+    matrix.reserve(indices.size());
+
+    std::vector<double> row(planets.size());
+    for (uint32_t index : indices) {
+        const ChartRecord& record = records[index];
+        for (size_t body = 0; body < planets.size(); body++) {
+            row[body] = record.hasBody(planets[body])
+                ? static_cast<double>(record.longitudes[static_cast<size_t>(planets[body])])
+                : std::numeric_limits<double>::quiet_NaN();
+        }
+        matrix.addChart(row.data());
+    }
+    return matrix;
+}
+
+ChartLongitudeMatrix ChartStore::longitudeMatrix(const std::vector<Planet>& planets) const {
+    std::vector<uint32_t> indices(recordCount);
+    for (size_t i = 0; i < recordCount; i++) {
+        indices[i] = static_cast<uint32_t>(i);
+    }
+    return longitudeMatrix(planets, indices);
+}
+
+} // namespace Astro
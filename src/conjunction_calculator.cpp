@@ -1,4 +1,6 @@
 #include "conjunction_calculator.h"
+#include "profiler.h"
+#include "swiss_ephemeris.h"
 #include "ephemeris_manager.h"
 #include "planet_calculator.h"
 #include "astro_types.h"
@@ -33,6 +35,7 @@ bool ConjunctionCalculator::initialize(const std::string& ephemerisPath) {
 
 std::vector<ConjunctionEvent> ConjunctionCalculator::findConjunctions(const BirthData& fromDate, const BirthData& toDate,
                                                                      double maxOrb) const {
+    ASTRO_PROFILE_SCOPE("ConjunctionCalculator::findConjunctions");
     if (!isInitialized) {
         lastError = "Conjunction calculator not initialized";
         return {};
@@ -255,8 +258,8 @@ bool ConjunctionCalculator::areInConjunction(Planet planet1, Planet planet2, dou
     if (planet1 == Planet::NORTH_NODE) sweBody1 = SE_MEAN_NODE;
     if (planet2 == Planet::NORTH_NODE) sweBody2 = SE_MEAN_NODE;
 
-    int result1 = swe_calc(julianDay, sweBody1, SEFLG_SWIEPH, pos1, serr);
-    int result2 = swe_calc(julianDay, sweBody2, SEFLG_SWIEPH, pos2, serr);
+    int result1 = SwissEphemeris::calc(julianDay, sweBody1, SEFLG_SWIEPH, pos1, serr);
+    int result2 = SwissEphemeris::calc(julianDay, sweBody2, SEFLG_SWIEPH, pos2, serr);
 
     if (result1 < 0 || result2 < 0) {
         return false;
@@ -285,8 +288,8 @@ double ConjunctionCalculator::findExactConjunctionTime(Planet planet1, Planet pl
         if (planet1 == Planet::NORTH_NODE) sweBody1 = SE_MEAN_NODE;
         if (planet2 == Planet::NORTH_NODE) sweBody2 = SE_MEAN_NODE;
 
-        swe_calc(testJD, sweBody1, SEFLG_SWIEPH, pos1, serr);
-        swe_calc(testJD, sweBody2, SEFLG_SWIEPH, pos2, serr);
+        SwissEphemeris::calc(testJD, sweBody1, SEFLG_SWIEPH, pos1, serr);
+        SwissEphemeris::calc(testJD, sweBody2, SEFLG_SWIEPH, pos2, serr);
 
         double separation = std::abs(pos1[0] - pos2[0]);
         if (separation > 180.0) separation = 360.0 - separation;
@@ -298,10 +301,10 @@ double ConjunctionCalculator::findExactConjunctionTime(Planet planet1, Planet pl
 
         // Determine which half to search next
         double pos1a[6], pos2a[6], pos1b[6], pos2b[6];
-        swe_calc(startJD, sweBody1, SEFLG_SWIEPH, pos1a, serr);
-        swe_calc(startJD, sweBody2, SEFLG_SWIEPH, pos2a, serr);
-        swe_calc(endJD, sweBody1, SEFLG_SWIEPH, pos1b, serr);
-        swe_calc(endJD, sweBody2, SEFLG_SWIEPH, pos2b, serr);
+        SwissEphemeris::calc(startJD, sweBody1, SEFLG_SWIEPH, pos1a, serr);
+        SwissEphemeris::calc(startJD, sweBody2, SEFLG_SWIEPH, pos2a, serr);
+        SwissEphemeris::calc(endJD, sweBody1, SEFLG_SWIEPH, pos1b, serr);
+        SwissEphemeris::calc(endJD, sweBody2, SEFLG_SWIEPH, pos2b, serr);
 
         double sepA = std::abs(pos1a[0] - pos2a[0]);
         if (sepA > 180.0) sepA = 360.0 - sepA;
@@ -335,16 +338,16 @@ ConjunctionEvent ConjunctionCalculator::calculateConjunction(Planet planet1, Pla
     if (planet1 == Planet::NORTH_NODE) sweBody1 = SE_MEAN_NODE;
     if (planet2 == Planet::NORTH_NODE) sweBody2 = SE_MEAN_NODE;
 
-    swe_calc(julianDay, sweBody1, SEFLG_SWIEPH, pos1, serr);
-    swe_calc(julianDay, sweBody2, SEFLG_SWIEPH, pos2, serr);
+    SwissEphemeris::calc(julianDay, sweBody1, SEFLG_SWIEPH, pos1, serr);
+    SwissEphemeris::calc(julianDay, sweBody2, SEFLG_SWIEPH, pos2, serr);
 
     conjunction.longitude = (pos1[0] + pos2[0]) / 2.0;
     conjunction.sign = longitudeToSign(conjunction.longitude);
     conjunction.orb = calculateConjunctionOrb(planet1, planet2, julianDay);
 
     // Determine if applying or separating
-    swe_calc(julianDay - 0.1, sweBody1, SEFLG_SWIEPH, pos1, serr);
-    swe_calc(julianDay - 0.1, sweBody2, SEFLG_SWIEPH, pos2, serr);
+    SwissEphemeris::calc(julianDay - 0.1, sweBody1, SEFLG_SWIEPH, pos1, serr);
+    SwissEphemeris::calc(julianDay - 0.1, sweBody2, SEFLG_SWIEPH, pos2, serr);
     double previousOrb = std::abs(pos1[0] - pos2[0]);
     if (previousOrb > 180.0) previousOrb = 360.0 - previousOrb;
 
@@ -473,8 +476,8 @@ double ConjunctionCalculator::calculateConjunctionOrb(Planet planet1, Planet pla
     if (planet1 == Planet::NORTH_NODE) sweBody1 = SE_MEAN_NODE;
     if (planet2 == Planet::NORTH_NODE) sweBody2 = SE_MEAN_NODE;
 
-    swe_calc(julianDay, sweBody1, SEFLG_SWIEPH, pos1, serr);
-    swe_calc(julianDay, sweBody2, SEFLG_SWIEPH, pos2, serr);
+    SwissEphemeris::calc(julianDay, sweBody1, SEFLG_SWIEPH, pos1, serr);
+    SwissEphemeris::calc(julianDay, sweBody2, SEFLG_SWIEPH, pos2, serr);
 
     double diff = std::abs(pos1[0] - pos2[0]);
     if (diff > 180.0) diff = 360.0 - diff;
@@ -534,6 +537,7 @@ std::vector<ConjunctionEvent> ConjunctionCalculator::findConjunctionsWithLatitud
 
 std::vector<ConjunctionEvent> ConjunctionCalculator::findGrahaYuddha(
     const BirthData& fromDate, const BirthData& toDate, double maxOrb) const {
+    ASTRO_PROFILE_SCOPE("ConjunctionCalculator::findGrahaYuddha");
 
     if (!isInitialized) {
         lastError = "Conjunction calculator not initialized";
@@ -564,6 +568,181 @@ std::vector<ConjunctionEvent> ConjunctionCalculator::findGrahaYuddha(
     return grahaYuddhaEvents;
 }
 
+bool ConjunctionCalculator::forEachConjunction(const std::vector<std::pair<Planet, Planet>>& pairs,
+                                               double startJD, double endJD,
+                                               const std::function<void(const ExactConjunction&)>& onEvent) const {
+    ASTRO_PROFILE_SCOPE("ConjunctionCalculator::forEachConjunction");
+    if (!isInitialized) {
+        lastError = "Conjunction calculator not initialized";
+        return false;
+    }
+    if (endJD <= startJD) {
+        lastError = "Empty conjunction range";
+        return false;
+    }
+
+    struct Sample {
+        double longitude;
+        double latitude;
+        double distance;
+        double speed;
+    };
+
+    // Each body once, however many pairs it is in
+    std::vector<int> bodies;
+    std::vector<std::pair<size_t, size_t>> pairBodies;
+    auto bodyIndex = [&bodies](Planet planet) {
+        int body = planet == Planet::NORTH_NODE ? SE_MEAN_NODE : static_cast<int>(planet);
+        auto it = std::find(bodies.begin(), bodies.end(), body);
+        if (it != bodies.end()) {
+            return static_cast<size_t>(it - bodies.begin());
+        }
+        bodies.push_back(body);
+        return bodies.size() - 1;
+    };
+    for (const auto& pair : pairs) {
+        if (pair.first == pair.second || pair.first == Planet::SOUTH_NODE || pair.second == Planet::SOUTH_NODE) {
+            lastError = "Invalid conjunction pair " + planetToString(pair.first) + " - " + planetToString(pair.second);
+            return false;
+        }
+        pairBodies.push_back({bodyIndex(pair.first), bodyIndex(pair.second)});
+    }
+
+    char serr[AS_MAXCH];
+    auto sample = [&](size_t body, double julianDay, Sample& result) {
+        double position[6];
+        if (SwissEphemeris::calcUt(julianDay, bodies[body], SEFLG_SWIEPH | SEFLG_SPEED, position, serr) < 0) {
+            lastError = "Swiss Ephemeris error: " + std::string(serr);
+            return false;
+        }
+        result = {position[0], position[1], position[2], position[3]};
+        return true;
+    };
+    auto difference = [](const Sample& s1, const Sample& s2) {
+        return std::remainder(s1.longitude - s2.longitude, 360.0);
+    };
+
+    std::vector<Sample> previous(bodies.size()), current(bodies.size());
+    for (size_t body = 0; body < bodies.size(); body++) {
+        if (!sample(body, startJD, previous[body])) {
+            return false;
+        }
+    }
+
+    // Brackets a crossing between low and high, where the difference is fLow
+    // and fHigh with opposite signs, and adds it to found
+    std::vector<ExactConjunction> found;
+    auto refine = [&](size_t i, double low, double fLow, double high, double fHigh) {
+        size_t p = pairBodies[i].first, q = pairBodies[i].second;
+        double t = low + (high - low) * fLow / (fLow - fHigh);
+        Sample sp, sq;
+        for (int iteration = 0; iteration < 40; iteration++) {
+            if (!sample(p, t, sp) || !sample(q, t, sq)) {
+                return false;
+            }
+
+            double f = difference(sp, sq);
+            if (f == 0.0) {
+                break;
+            }
+            if ((f < 0.0) == (fLow < 0.0)) {
+                low = t;
+            } else {
+                high = t;
+            }
+
+            double rate = sp.speed - sq.speed;
+            double next = rate != 0.0 ? t - f / rate : 0.5 * (low + high);
+            if (next <= low || next >= high) {
+                next = 0.5 * (low + high);
+            }
+            if (std::abs(next - t) < 1e-7) {
+                break;
+            }
+            t = next;
+        }
+
+        if (t >= startJD && t < endJD) {
+            found.push_back({pairs[i].first, pairs[i].second, t, sp.longitude,
+                             sp.latitude, sq.latitude, sp.distance, sq.distance});
+        }
+        return true;
+    };
+
+    // A pair turns at most once within a step (at greatest elongation or
+    // around a station), so the Moon needs a quarter day, the Sun to Mars a
+    // day, and the slower bodies five
+    double step = 5.0;
+    for (int body : bodies) {
+        if (body == SE_MOON) {
+            step = std::min(step, 0.25);
+        } else if (body <= SE_MARS) {
+            step = std::min(step, 1.0);
+        }
+    }
+
+    for (double a = startJD; a < endJD; ) {
+        double b = std::min(a + step, endJD);
+        for (size_t body = 0; body < bodies.size(); body++) {
+            if (!sample(body, b, current[body])) {
+                return false;
+            }
+        }
+
+        found.clear();
+        for (size_t i = 0; i < pairBodies.size(); i++) {
+            size_t p = pairBodies[i].first, q = pairBodies[i].second;
+            double fa = difference(previous[p], previous[q]);
+            double fb = difference(current[p], current[q]);
+            // A jump through 180 degrees is an opposition, not a conjunction
+            if (std::abs(fb - fa) > 180.0) {
+                continue;
+            }
+
+            if ((fa < 0.0) != (fb < 0.0)) {
+                if (!refine(i, a, fa, b, fb)) {
+                    return false;
+                }
+                continue;
+            }
+
+            // The pair turns towards zero inside the step: if the turning
+            // point, by linear interpolation of the rate, may lie past zero,
+            // look there for two crossings
+            double ra = previous[p].speed - previous[q].speed;
+            double rb = current[p].speed - current[q].speed;
+            if ((ra < 0.0) == (rb < 0.0) || (ra < 0.0) != (fa > 0.0)) {
+                continue;
+            }
+            double tm = a + (b - a) * ra / (ra - rb);
+            double estimate = fa + 0.5 * ra * (tm - a);
+            if ((estimate < 0.0) == (fa < 0.0) && std::abs(estimate) > 0.01) {
+                continue;
+            }
+            Sample sp, sq;
+            if (!sample(p, tm, sp) || !sample(q, tm, sq)) {
+                return false;
+            }
+            double fm = difference(sp, sq);
+            if ((fm < 0.0) != (fa < 0.0) && (!refine(i, a, fa, tm, fm) || !refine(i, tm, fm, b, fb))) {
+                return false;
+            }
+        }
+
+        std::sort(found.begin(), found.end(), [](const ExactConjunction& x, const ExactConjunction& y) {
+            return x.julianDay < y.julianDay;
+        });
+        for (const auto& conjunction : found) {
+            onEvent(conjunction);
+        }
+
+        previous.swap(current);
+        a = b;
+    }
+
+    return true;
+}
+
 bool ConjunctionCalculator::isGrahaYuddha(const ConjunctionEvent& conjunction) const {
     // Graha Yuddha conditions:
     // 1. Very tight orb (usually < 1°)
@@ -574,18 +753,15 @@ bool ConjunctionCalculator::isGrahaYuddha(const ConjunctionEvent& conjunction) c
     if (conjunction.orb > 1.0) return false;
     if (conjunction.planets.size() != 2) return false; // Only two-planet wars for now
 
-    std::vector<Planet> traditionalPlanets = {
-        Planet::MARS, Planet::MERCURY, Planet::JUPITER, Planet::VENUS, Planet::SATURN
-    };
-
-    int validPlanets = 0;
-    for (Planet p : conjunction.planets) {
-        if (std::find(traditionalPlanets.begin(), traditionalPlanets.end(), p) != traditionalPlanets.end()) {
-            validPlanets++;
-        }
-    }
+    return isGrahaYuddhaPair(conjunction.planets[0], conjunction.planets[1]);
+}
 
-    return validPlanets == 2;
+bool ConjunctionCalculator::isGrahaYuddhaPair(Planet planet1, Planet planet2) {
+    auto traditional = [](Planet p) {
+        return p == Planet::MARS || p == Planet::MERCURY || p == Planet::JUPITER ||
+               p == Planet::VENUS || p == Planet::SATURN;
+    };
+    return planet1 != planet2 && traditional(planet1) && traditional(planet2);
 }
 
 Planet ConjunctionCalculator::getGrahaYuddhaWinner(Planet planet1, Planet planet2, double julianDay) const {
@@ -604,21 +780,26 @@ Planet ConjunctionCalculator::getGrahaYuddhaWinner(Planet planet1, Planet planet
         return getStrongerPlanetByHierarchy(planet1, planet2);
     }
 
+    return getGrahaYuddhaWinner(planet1, pos1.latitude, pos1.distance, planet2, pos2.latitude, pos2.distance);
+}
+
+Planet ConjunctionCalculator::getGrahaYuddhaWinner(Planet planet1, double latitude1, double distance1,
+                                                   Planet planet2, double latitude2, double distance2) {
     // Primary rule: Southern planet (higher latitude) wins
-    if (std::abs(pos1.latitude - pos2.latitude) > 0.1) {
-        return (pos1.latitude > pos2.latitude) ? planet1 : planet2;
+    if (std::abs(latitude1 - latitude2) > 0.1) {
+        return (latitude1 > latitude2) ? planet1 : planet2;
     }
 
     // Secondary rule: Brighter planet wins (approximated by distance)
-    if (std::abs(pos1.distance - pos2.distance) > 0.01) {
-        return (pos1.distance < pos2.distance) ? planet1 : planet2;
+    if (std::abs(distance1 - distance2) > 0.01) {
+        return (distance1 < distance2) ? planet1 : planet2;
     }
 
     // Tertiary rule: Hierarchical strength
     return getStrongerPlanetByHierarchy(planet1, planet2);
 }
 
-Planet ConjunctionCalculator::getStrongerPlanetByHierarchy(Planet planet1, Planet planet2) const {
+Planet ConjunctionCalculator::getStrongerPlanetByHierarchy(Planet planet1, Planet planet2) {
     // Traditional Vedic hierarchy for Graha Yuddha
     std::map<Planet, int> hierarchy = {
         {Planet::JUPITER, 5},
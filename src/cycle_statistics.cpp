@@ -0,0 +1,551 @@
+#include "cycle_statistics.h"
+#include "conjunction_calculator.h"
+#include "json_writer.h"
+#include "profiler.h"
+#include "swiss_ephemeris.h"
+#include "transit_event_finder.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <iomanip>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+extern "C" {
+#include "swephexp.h"
+}
+
+namespace Astro {
+
+namespace {
+
+const char* const SIGN_ABBREVIATIONS[] = {
+    "Ari", "Tau", "Gem", "Can", "Leo", "Vir", "Lib", "Sco", "Sag", "Cap", "Aqu", "Pis"
+};
+
+int signOf(double longitude) {
+    int sign = static_cast<int>(std::floor(longitude / 30.0)) % 12;
+    return sign < 0 ? sign + 12 : sign;
+}
+
+void countCentury(std::vector<uint64_t>& byCentury, int index) {
+    if (index >= 0 && index < static_cast<int>(byCentury.size())) {
+        byCentury[index]++;
+    }
+}
+
+// YYYY-MM-DD, or YYYYBC-MM-DD before 1 AD, as --cycle-stats reads them back
+std::string dateString(double julianDay) {
+    int year, month, day;
+    double hour;
+    swe_revjul(julianDay, SE_GREG_CAL, &year, &month, &day, &hour);
+
+    std::ostringstream oss;
+    oss << std::setfill('0');
+    if (year <= 0) {
+        oss << std::setw(4) << 1 - year << "BC";
+    } else {
+        oss << std::setw(4) << year;
+    }
+    oss << "-" << std::setw(2) << month << "-" << std::setw(2) << day;
+    return oss.str();
+}
+
+} // namespace
+
+void DurationStatistics::add(double days) {
+    count++;
+    double delta = days - mean;
+    mean += delta / count;
+    sumSquares += delta * (days - mean);
+    minimum = count == 1 ? days : std::min(minimum, days);
+    maximum = count == 1 ? days : std::max(maximum, days);
+
+    size_t bin = days > 1.0 ? static_cast<size_t>(std::floor(std::log2(days) * BINS_PER_OCTAVE)) : 0;
+    if (bin >= histogram.size()) {
+        histogram.resize(bin + 1, 0);
+    }
+    histogram[bin]++;
+}
+
+void DurationStatistics::merge(const DurationStatistics& other) {
+    if (other.count == 0) {
+        return;
+    }
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+
+    // Chan, Golub and LeVeque's pairwise update
+    uint64_t total = count + other.count;
+    double delta = other.mean - mean;
+    mean += delta * other.count / total;
+    sumSquares += other.sumSquares + delta * delta * (static_cast<double>(count) * other.count / total);
+    count = total;
+    minimum = std::min(minimum, other.minimum);
+    maximum = std::max(maximum, other.maximum);
+
+    if (other.histogram.size() > histogram.size()) {
+        histogram.resize(other.histogram.size(), 0);
+    }
+    for (size_t i = 0; i < other.histogram.size(); i++) {
+        histogram[i] += other.histogram[i];
+    }
+}
+
+double DurationStatistics::variance() const {
+    return count > 1 ? sumSquares / (count - 1) : 0.0;
+}
+
+double DurationStatistics::standardDeviation() const {
+    return std::sqrt(variance());
+}
+
+double DurationStatistics::binStart(size_t bin) {
+    return bin == 0 ? 0.0 : std::exp2(static_cast<double>(bin) / BINS_PER_OCTAVE);
+}
+
+CycleStatistics::CycleStatistics()
+    : isInitialized(false), pairs({{Planet::JUPITER, Planet::SATURN}}),
+      zodiacMode(ZodiacMode::TROPICAL), ayanamsa(AyanamsaType::LAHIRI),
+      grahaYuddhaOrb(1.0), threadCount(0), sliceDays(3652.5) {
+}
+
+bool CycleStatistics::initialize(const std::string& path) {
+    ConjunctionCalculator calculator;
+    if (!calculator.initialize(path)) {
+        lastError = calculator.getLastError();
+        return false;
+    }
+    ephemerisPath = path;
+    isInitialized = true;
+    return true;
+}
+
+void CycleStatistics::setZodiacMode(ZodiacMode mode, AyanamsaType type) {
+    zodiacMode = mode;
+    ayanamsa = type;
+}
+
+std::vector<std::pair<Planet, Planet>> CycleStatistics::grahaYuddhaPairs() {
+    const Planet planets[] = {Planet::MERCURY, Planet::VENUS, Planet::MARS, Planet::JUPITER, Planet::SATURN};
+    std::vector<std::pair<Planet, Planet>> result;
+    for (size_t i = 0; i < 5; i++) {
+        for (size_t j = i + 1; j < 5; j++) {
+            result.push_back({planets[i], planets[j]});
+        }
+    }
+    return result;
+}
+
+int CycleStatistics::centuryOf(double julianDay) {
+    int year, month, day;
+    double hour;
+    swe_revjul(julianDay, SE_GREG_CAL, &year, &month, &day, &hour);
+    return year >= 0 ? year / 100 : -((-year + 99) / 100);
+}
+
+CycleSummary CycleStatistics::emptySummary(double startJD, double endJD) const {
+    CycleSummary summary;
+    summary.startJD = startJD;
+    summary.endJD = endJD;
+    summary.firstCentury = centuryOf(startJD);
+    summary.zodiacMode = zodiacMode;
+    summary.ayanamsa = ayanamsa;
+    summary.grahaYuddhaOrb = grahaYuddhaOrb;
+
+    // endJD itself is excluded, so a range ending on 1 January 2000 stops in the 1900s
+    int lastCentury = std::max(summary.firstCentury, centuryOf(endJD - 1.0 / 86400.0));
+    size_t centuries = static_cast<size_t>(lastCentury - summary.firstCentury + 1);
+    for (const auto& pair : pairs) {
+        PairCycleStatistics statistics;
+        statistics.planet1 = pair.first;
+        statistics.planet2 = pair.second;
+        statistics.byCentury.assign(centuries, 0);
+        statistics.grahaYuddhaPair = ConjunctionCalculator::isGrahaYuddhaPair(pair.first, pair.second);
+        if (statistics.grahaYuddhaPair) {
+            statistics.grahaYuddhaByCentury.assign(centuries, 0);
+        }
+        summary.pairs.push_back(std::move(statistics));
+    }
+    for (Planet planet : retrogradePlanets) {
+        RetrogradeStatistics statistics;
+        statistics.planet = planet;
+        statistics.byCentury.assign(centuries, 0);
+        summary.retrogrades.push_back(std::move(statistics));
+    }
+    return summary;
+}
+
+bool CycleStatistics::compute(double startJD, double endJD, CycleSummary& summary) const {
+    ASTRO_PROFILE_SCOPE("CycleStatistics::compute");
+    if (!isInitialized) {
+        lastError = "Cycle statistics not initialized";
+        return false;
+    }
+    if (endJD <= startJD) {
+        lastError = "Empty date range";
+        return false;
+    }
+    for (Planet planet : retrogradePlanets) {
+        if (planet == Planet::SUN || planet == Planet::MOON) {
+            lastError = planetToString(planet) + " is never retrograde";
+            return false;
+        }
+    }
+
+    size_t sliceCount = static_cast<size_t>(std::ceil((endJD - startJD) / sliceDays));
+    std::vector<CycleSummary> slices(sliceCount);
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::mutex errorMutex;
+    std::string error;
+
+    auto work = [&]() {
+        // Swiss Ephemeris settings are per thread
+        ConjunctionCalculator conjunctions;
+        std::string sliceError;
+        if (!conjunctions.initialize(ephemerisPath)) {
+            sliceError = conjunctions.getLastError();
+        }
+        TransitEventFinder stations;
+        stations.setZodiacMode(zodiacMode, ayanamsa);
+        stations.setPlanets(retrogradePlanets);
+        stations.setIncludeSignIngresses(false);
+        stations.setIncludeStations(true);
+        if (zodiacMode == ZodiacMode::SIDEREAL) {
+            SwissEphemeris::setSiderealMode(ayanamsaTypeToSwissEphId(ayanamsa));
+        }
+
+        for (size_t i = next++; i < sliceCount && !failed; i = next++) {
+            double sliceStart = startJD + i * sliceDays;
+            double sliceEnd = std::min(sliceStart + sliceDays, endJD);
+            // Century counts index from the start of the whole range
+            slices[i] = emptySummary(startJD, endJD);
+            slices[i].startJD = sliceStart;
+            slices[i].endJD = sliceEnd;
+
+            if (!sliceError.empty() || !computeSlice(conjunctions, stations, sliceStart, sliceEnd, slices[i], sliceError)) {
+                std::lock_guard<std::mutex> lock(errorMutex);
+                if (!failed.exchange(true)) {
+                    error = sliceError;
+                }
+                return;
+            }
+        }
+    };
+
+    unsigned workers = threadCount > 0 ? threadCount : std::max(1u, std::thread::hardware_concurrency());
+    workers = static_cast<unsigned>(std::max<size_t>(1, std::min<size_t>(workers, sliceCount)));
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < workers; i++) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (failed) {
+        lastError = error;
+        return false;
+    }
+
+    summary = emptySummary(startJD, endJD);
+    summary.slices = static_cast<unsigned>(sliceCount);
+    summary.threads = workers;
+    for (const auto& slice : slices) {
+        mergeInto(summary, slice);
+    }
+    return true;
+}
+
+bool CycleStatistics::computeSlice(const ConjunctionCalculator& conjunctions, const TransitEventFinder& stations,
+                                   double startJD, double endJD, CycleSummary& slice, std::string& error) const {
+    ASTRO_PROFILE_SCOPE("CycleStatistics::slice");
+    bool sidereal = zodiacMode == ZodiacMode::SIDEREAL;
+
+    if (!pairs.empty()) {
+        size_t pairIndex = 0;
+        bool ok = conjunctions.forEachConjunction(pairs, startJD, endJD, [&](const ExactConjunction& event) {
+            // Events of several pairs arrive interleaved; most runs have one
+            if (pairs[pairIndex].first != event.planet1 || pairs[pairIndex].second != event.planet2) {
+                pairIndex = 0;
+                while (pairs[pairIndex].first != event.planet1 || pairs[pairIndex].second != event.planet2) {
+                    pairIndex++;
+                }
+            }
+            PairCycleStatistics& pair = slice.pairs[pairIndex];
+
+            if (pair.conjunctions > 0) {
+                pair.intervals.add(event.julianDay - pair.lastJD);
+            } else {
+                pair.firstJD = event.julianDay;
+            }
+            pair.lastJD = event.julianDay;
+            pair.conjunctions++;
+
+            double longitude = sidereal ? event.longitude - swe_get_ayanamsa_ut(event.julianDay) : event.longitude;
+            pair.bySign[signOf(longitude)]++;
+            int century = centuryOf(event.julianDay) - slice.firstCentury;
+            countCentury(pair.byCentury, century);
+
+            if (pair.grahaYuddhaPair && std::abs(event.latitude1 - event.latitude2) <= grahaYuddhaOrb) {
+                pair.grahaYuddha++;
+                countCentury(pair.grahaYuddhaByCentury, century);
+                Planet winner = ConjunctionCalculator::getGrahaYuddhaWinner(
+                    event.planet1, event.latitude1, event.distance1,
+                    event.planet2, event.latitude2, event.distance2);
+                pair.grahaYuddhaWins[winner == event.planet1 ? 0 : 1]++;
+            }
+        });
+        if (!ok) {
+            error = conjunctions.getLastError();
+            return false;
+        }
+    }
+
+    if (!retrogradePlanets.empty()) {
+        // A slice holds a few hundred stations at most
+        std::vector<TransitEvent> events;
+        if (!stations.findEvents(startJD, endJD, events)) {
+            error = stations.getLastError();
+            return false;
+        }
+
+        for (const TransitEvent& event : events) {
+            size_t index = std::find(retrogradePlanets.begin(), retrogradePlanets.end(), event.planet) -
+                           retrogradePlanets.begin();
+            RetrogradeStatistics& retrograde = slice.retrogrades[index];
+            bool turnsRetrograde = event.type == TransitEventType::STATION_RETROGRADE;
+
+            if (retrograde.stations == 0) {
+                retrograde.firstStationJD = event.julianDay;
+                retrograde.firstStationRetrograde = turnsRetrograde;
+            } else if (!turnsRetrograde && retrograde.lastStationRetrograde) {
+                retrograde.durations.add(event.julianDay - retrograde.lastStationJD);
+            }
+            retrograde.lastStationJD = event.julianDay;
+            retrograde.lastStationRetrograde = turnsRetrograde;
+            retrograde.stations++;
+
+            if (turnsRetrograde) {
+                retrograde.bySign[event.from]++;
+                countCentury(retrograde.byCentury, centuryOf(event.julianDay) - slice.firstCentury);
+            }
+        }
+    }
+    return true;
+}
+
+void CycleStatistics::mergeInto(CycleSummary& total, const CycleSummary& slice) {
+    for (size_t i = 0; i < total.pairs.size(); i++) {
+        PairCycleStatistics& into = total.pairs[i];
+        const PairCycleStatistics& from = slice.pairs[i];
+        if (from.conjunctions == 0) {
+            continue;
+        }
+
+        if (into.conjunctions > 0) {
+            into.intervals.add(from.firstJD - into.lastJD);
+        } else {
+            into.firstJD = from.firstJD;
+        }
+        into.lastJD = from.lastJD;
+        into.conjunctions += from.conjunctions;
+        into.intervals.merge(from.intervals);
+        into.grahaYuddha += from.grahaYuddha;
+        for (size_t k = 0; k < 12; k++) {
+            into.bySign[k] += from.bySign[k];
+        }
+        for (size_t k = 0; k < 2; k++) {
+            into.grahaYuddhaWins[k] += from.grahaYuddhaWins[k];
+        }
+        for (size_t k = 0; k < into.byCentury.size(); k++) {
+            into.byCentury[k] += from.byCentury[k];
+        }
+        for (size_t k = 0; k < into.grahaYuddhaByCentury.size(); k++) {
+            into.grahaYuddhaByCentury[k] += from.grahaYuddhaByCentury[k];
+        }
+    }
+
+    for (size_t i = 0; i < total.retrogrades.size(); i++) {
+        RetrogradeStatistics& into = total.retrogrades[i];
+        const RetrogradeStatistics& from = slice.retrogrades[i];
+        if (from.stations == 0) {
+            continue;
+        }
+
+        if (into.stations == 0) {
+            into.firstStationJD = from.firstStationJD;
+            into.firstStationRetrograde = from.firstStationRetrograde;
+        } else if (into.lastStationRetrograde && !from.firstStationRetrograde) {
+            into.durations.add(from.firstStationJD - into.lastStationJD);
+        }
+        into.lastStationJD = from.lastStationJD;
+        into.lastStationRetrograde = from.lastStationRetrograde;
+        into.stations += from.stations;
+        into.durations.merge(from.durations);
+        for (size_t k = 0; k < 12; k++) {
+            into.bySign[k] += from.bySign[k];
+        }
+        for (size_t k = 0; k < into.byCentury.size(); k++) {
+            into.byCentury[k] += from.byCentury[k];
+        }
+    }
+}
+
+std::string CycleStatistics::generateReport(const CycleSummary& summary) const {
+    std::ostringstream ss;
+    ss << std::fixed << std::setprecision(1);
+
+    auto writeDistribution = [&ss](const char* label, const DurationStatistics& statistics) {
+        if (statistics.count == 0) {
+            return;
+        }
+        ss << "  " << label << " (days): mean " << statistics.mean << ", std dev " << statistics.standardDeviation()
+           << ", min " << statistics.minimum << ", max " << statistics.maximum << "\n";
+        ss << "  Histogram:";
+        for (size_t bin = 0; bin < statistics.histogram.size(); bin++) {
+            if (statistics.histogram[bin] > 0) {
+                ss << " " << DurationStatistics::binStart(bin) << "+:" << statistics.histogram[bin];
+            }
+        }
+        ss << "\n";
+    };
+    auto writeSigns = [&ss](const char* label, const std::array<uint64_t, 12>& bySign) {
+        ss << "  " << label << ":";
+        for (size_t k = 0; k < 12; k++) {
+            ss << " " << SIGN_ABBREVIATIONS[k] << " " << bySign[k];
+        }
+        ss << "\n";
+    };
+    auto writeCenturies = [&ss, &summary](const char* label, const std::vector<uint64_t>& byCentury) {
+        ss << "  " << label << " from " << summary.firstCentury * 100 << ":";
+        for (uint64_t count : byCentury) {
+            ss << " " << count;
+        }
+        ss << "\n";
+    };
+
+    ss << "\n=== PLANETARY CYCLE STATISTICS ===\n\n";
+    // The end is exclusive: show the last day included
+    ss << "Range: " << dateString(summary.startJD) << " to " << dateString(summary.endJD - 1.0 / 86400.0)
+       << " (" << (summary.endJD - summary.startJD) / 365.2425 << " years)\n";
+    ss << "Zodiac: " << zodiacModeToString(summary.zodiacMode);
+    if (summary.zodiacMode == ZodiacMode::SIDEREAL) {
+        ss << " (" << ayanamsaTypeToString(summary.ayanamsa) << ")";
+    }
+    ss << " | Slices: " << summary.slices << " | Threads: " << summary.threads << "\n";
+    ss << "Centuries are astronomical years (-100 = 101 BC to 2 BC).\n";
+
+    for (const auto& pair : summary.pairs) {
+        ss << "\n" << planetToString(pair.planet1) << " - " << planetToString(pair.planet2)
+           << ": " << pair.conjunctions << " conjunctions\n";
+        writeDistribution("Interval", pair.intervals);
+        writeSigns("By sign", pair.bySign);
+        writeCenturies("Per century", pair.byCentury);
+        if (pair.grahaYuddhaPair) {
+            ss << "  Graha Yuddha (latitudes within " << std::setprecision(2) << summary.grahaYuddhaOrb
+               << std::setprecision(1) << "°): " << pair.grahaYuddha << ", "
+               << planetToString(pair.planet1) << " won " << pair.grahaYuddhaWins[0] << ", "
+               << planetToString(pair.planet2) << " won " << pair.grahaYuddhaWins[1] << "\n";
+            writeCenturies("Graha Yuddha per century", pair.grahaYuddhaByCentury);
+        }
+    }
+
+    for (const auto& retrograde : summary.retrogrades) {
+        ss << "\n" << planetToString(retrograde.planet) << " retrograde: " << retrograde.durations.count
+           << " complete periods\n";
+        writeDistribution("Duration", retrograde.durations);
+        writeSigns("Retrograde stations by sign", retrograde.bySign);
+        writeCenturies("Retrograde stations per century", retrograde.byCentury);
+    }
+
+    return ss.str();
+}
+
+std::string CycleStatistics::generateJSON(const CycleSummary& summary) const {
+    JsonWriter json;
+    auto writeDistribution = [&json](const char* name, const DurationStatistics& statistics) {
+        json.key(name).beginObject();
+        json.field("count", statistics.count);
+        json.field("mean", statistics.mean);
+        json.field("std_dev", statistics.standardDeviation());
+        json.field("min", statistics.minimum);
+        json.field("max", statistics.maximum);
+        json.key("histogram").beginArray();
+        for (size_t bin = 0; bin < statistics.histogram.size(); bin++) {
+            if (statistics.histogram[bin] > 0) {
+                json.beginObject();
+                json.field("from", DurationStatistics::binStart(bin));
+                json.field("to", DurationStatistics::binStart(bin + 1));
+                json.field("count", statistics.histogram[bin]);
+                json.endObject();
+            }
+        }
+        json.endArray();
+        json.endObject();
+    };
+    auto writeSigns = [&json](const std::array<uint64_t, 12>& bySign) {
+        json.key("by_sign").beginObject();
+        for (size_t k = 0; k < 12; k++) {
+            json.field(zodiacSignToString(static_cast<ZodiacSign>(k)), bySign[k]);
+        }
+        json.endObject();
+    };
+
+    json.beginObject();
+    json.field("start_jd", summary.startJD);
+    json.field("end_jd", summary.endJD);
+    json.field("start", dateString(summary.startJD));
+    json.field("end", dateString(summary.endJD - 1.0 / 86400.0));
+    json.field("zodiac", zodiacModeToString(summary.zodiacMode));
+    if (summary.zodiacMode == ZodiacMode::SIDEREAL) {
+        json.field("ayanamsa", ayanamsaTypeToString(summary.ayanamsa));
+    }
+    json.field("first_century", summary.firstCentury * 100);
+    json.field("slices", summary.slices);
+    json.field("threads", summary.threads);
+
+    json.key("pairs").beginArray();
+    for (const auto& pair : summary.pairs) {
+        json.beginObject();
+        json.field("planet1", planetToString(pair.planet1));
+        json.field("planet2", planetToString(pair.planet2));
+        json.field("conjunctions", pair.conjunctions);
+        writeDistribution("intervals", pair.intervals);
+        writeSigns(pair.bySign);
+        json.arrayField("per_century", pair.byCentury);
+        if (pair.grahaYuddhaPair) {
+            json.key("graha_yuddha").beginObject();
+            json.field("orb", summary.grahaYuddhaOrb);
+            json.field("count", pair.grahaYuddha);
+            json.field("planet1_wins", pair.grahaYuddhaWins[0]);
+            json.field("planet2_wins", pair.grahaYuddhaWins[1]);
+            json.arrayField("per_century", pair.grahaYuddhaByCentury);
+            json.endObject();
+        }
+        json.endObject();
+    }
+    json.endArray();
+
+    json.key("retrogrades").beginArray();
+    for (const auto& retrograde : summary.retrogrades) {
+        json.beginObject();
+        json.field("planet", planetToString(retrograde.planet));
+        writeDistribution("durations", retrograde.durations);
+        writeSigns(retrograde.bySign);
+        json.arrayField("per_century", retrograde.byCentury);
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+
+    return json.take() + "\n";
+}
+
+} // namespace Astro
@@ -1,8 +1,7 @@
 #include "eastern_chart_drawer.h"
+#include "display_width.h"
 #include <sstream>
-#include <iomanip>
 #include <algorithm>
-#include <map>
 
 namespace Astro {
 
@@ -24,34 +23,7 @@ std::string EasternChartDrawer::drawNorthIndianChart(const BirthChart& chart) co
 
     oss << "\n=== NORTH INDIAN VEDIC CHART ===\n\n";
 
-    const auto& positions = chart.getPlanetPositions();
-
-    // Create the chart frame
-    std::vector<std::string> lines = {
-        "+-------------+-------------+-------------+-------------+",
-        "|             |             |             |             |",
-        "|     12      |      1      |      2      |      3      |",
-        "|             |             |             |             |",
-        "+-------------+-------------+-------------+-------------+",
-        "|             |                           |             |",
-        "|     11      |                           |      4      |",
-        "|             |                           |             |",
-        "+-------------+           RASI            +-------------+",
-        "|             |                           |             |",
-        "|     10      |                           |      5      |",
-        "|             |                           |             |",
-        "+-------------+-------------+-------------+-------------+",
-        "|             |             |             |             |",
-        "|      9      |      8      |      7      |      6      |",
-        "|             |             |             |             |",
-        "+-------------+-------------+-------------+-------------+"
-    };
-
-    fillNorthIndianHouses(lines, positions);
-
-    for (const auto& line : lines) {
-        oss << line << "\n";
-    }
+    oss << drawGrid(chart, "north-indian");
 
     // Add legend
     oss << "\nPlanet Symbols:\n";
@@ -67,42 +39,7 @@ std::string EasternChartDrawer::drawSouthIndianChart(const BirthChart& chart) co
 
     oss << "\n=== SOUTH INDIAN VEDIC CHART ===\n\n";
 
-    const auto& positions = chart.getPlanetPositions();
-
-    // Create the chart frame - South Indian style is a square divided into 12 triangular sections
-    std::vector<std::string> lines = {
-        "        +-------------+-------------+        ",
-        "        |      2      |      3      |        ",
-        "        |             |             |        ",
-        "+-------+-------------+-------------+-------+",
-        "|   1   |                           |   4   |",
-        "|       |                           |       |",
-        "+-------+           RASI            +-------+",
-        "|  12   |                           |   5   |",
-        "|       |                           |       |",
-        "+-------+-------------+-------------+-------+",
-        "        |     11      |      6      |        ",
-        "        |             |             |        ",
-        "        +-------------+-------------+        ",
-        "        +-------------+-------------+        ",
-        "        |     10      |      7      |        ",
-        "        |             |             |        ",
-        "        +-------------+-------------+        ",
-        "              +-------------+              ",
-        "              |      8      |              ",
-        "              |             |              ",
-        "              +-------------+              ",
-        "              +-------------+              ",
-        "              |      9      |              ",
-        "              |             |              ",
-        "              +-------------+              "
-    };
-
-    fillSouthIndianHouses(lines, positions);
-
-    for (const auto& line : lines) {
-        oss << line << "\n";
-    }
+    oss << drawGrid(chart, "south-indian");
 
     // Add legend
     oss << "\nPlanet Symbols:\n";
@@ -118,26 +55,7 @@ std::string EasternChartDrawer::drawEastIndianChart(const BirthChart& chart) con
 
     oss << "\n=== EAST INDIAN VEDIC CHART ===\n\n";
 
-    const auto& positions = chart.getPlanetPositions();
-
-    // Create the chart frame - East Indian style is a rectangular 3x4 grid format
-    std::vector<std::string> lines = {
-        "+---------+---------+---------+",
-        "|   12    |    1    |    2    |",
-        "+---------+---------+---------+",
-        "|   11    |         |    3    |",
-        "+---------+---------+---------+",
-        "|   10    |         |    4    |",
-        "+---------+---------+---------+",
-        "|    9    |    8    |    7    |",
-        "+---------+---------+---------+"
-    };
-
-    fillEastIndianHouses(lines, positions);
-
-    for (const auto& line : lines) {
-        oss << line << "\n";
-    }
+    oss << drawGrid(chart, "east-indian");
 
     // Add legend
     oss << "\nPlanet Symbols:\n";
@@ -160,25 +78,181 @@ std::vector<std::string> EasternChartDrawer::getAvailableStyles() {
     return {"north-indian", "south-indian", "east-indian"};
 }
 
-std::string EasternChartDrawer::getPlanetsInHouse(const std::vector<PlanetPosition>& positions, int house) const {
-    std::vector<std::string> planetsInHouse;
+int EasternChartDrawer::updateGrid(GridState& state, const BirthChart& chart) const {
+    return updateGrid(state, chart, chartStyle);
+}
 
-    for (const auto& pos : positions) {
-        if (pos.house == house) {
-            planetsInHouse.push_back(getShortPlanetName(pos.planet));
+int EasternChartDrawer::updateGrid(GridState& state, const BirthChart& chart, const std::string& style) const {
+    const GridLayout& layout = getLayout(style);
+
+    if (state.style != style || state.rows.size() != layout.frame.size()) {
+        state.style = style;
+        state.rows = layout.frame;
+        state.houses.assign(13, std::string());
+    }
+
+    std::vector<std::string> contents = getHouseContents(chart.getPlanetPositions());
+    int redrawn = 0;
+    for (int house = 1; house <= 12; house++) {
+        if (contents[house] != state.houses[house]) {
+            drawHouse(state.rows, layout, house, contents[house]);
+            state.houses[house] = std::move(contents[house]);
+            redrawn++;
         }
     }
+    return redrawn;
+}
 
-    std::ostringstream oss;
-    for (size_t i = 0; i < planetsInHouse.size(); i++) {
-        if (i > 0) oss << ",";
-        oss << planetsInHouse[i];
+std::string EasternChartDrawer::drawGrid(const BirthChart& chart, const std::string& style) const {
+    GridState state;
+    updateGrid(state, chart, style);
+
+    std::string grid;
+    for (const auto& line : state.rows) {
+        grid += line;
+        grid += '\n';
     }
+    return grid;
+}
 
-    return oss.str();
+const EasternChartDrawer::GridLayout& EasternChartDrawer::getLayout(const std::string& style) {
+    // North Indian chart; planets are written two columns into each cell
+    static const GridLayout northIndian = {
+        {
+            "+-------------+-------------+-------------+-------------+",
+            "|             |             |             |             |",
+            "|     12      |      1      |      2      |      3      |",
+            "|             |             |             |             |",
+            "+-------------+-------------+-------------+-------------+",
+            "|             |                           |             |",
+            "|     11      |                           |      4      |",
+            "|             |                           |             |",
+            "+-------------+           RASI            +-------------+",
+            "|             |                           |             |",
+            "|     10      |                           |      5      |",
+            "|             |                           |             |",
+            "+-------------+-------------+-------------+-------------+",
+            "|             |             |             |             |",
+            "|      9      |      8      |      7      |      6      |",
+            "|             |             |             |             |",
+            "+-------------+-------------+-------------+-------------+"
+        },
+        {
+            {0, 0, 0},      // Dummy for index 0
+            {2, 16, 11},    // House 1
+            {2, 30, 11},    // House 2
+            {2, 44, 11},    // House 3
+            {6, 44, 11},    // House 4
+            {10, 44, 11},   // House 5
+            {14, 44, 11},   // House 6
+            {14, 30, 11},   // House 7
+            {14, 16, 11},   // House 8
+            {14, 3, 11},    // House 9
+            {10, 3, 11},    // House 10
+            {6, 3, 11},     // House 11
+            {2, 3, 11}      // House 12
+        },
+        false
+    };
+
+    // South Indian style is a square divided into 12 triangular sections
+    static const GridLayout southIndian = {
+        {
+            "        +-------------+-------------+        ",
+            "        |      2      |      3      |        ",
+            "        |             |             |        ",
+            "+-------+-------------+-------------+-------+",
+            "|   1   |                           |   4   |",
+            "|       |                           |       |",
+            "+-------+           RASI            +-------+",
+            "|  12   |                           |   5   |",
+            "|       |                           |       |",
+            "+-------+-------------+-------------+-------+",
+            "        |     11      |      6      |        ",
+            "        |             |             |        ",
+            "        +-------------+-------------+        ",
+            "        +-------------+-------------+        ",
+            "        |     10      |      7      |        ",
+            "        |             |             |        ",
+            "        +-------------+-------------+        ",
+            "              +-------------+              ",
+            "              |      8      |              ",
+            "              |             |              ",
+            "              +-------------+              ",
+            "              +-------------+              ",
+            "              |      9      |              ",
+            "              |             |              ",
+            "              +-------------+              "
+        },
+        {
+            {0, 0, 0},      // Dummy for index 0
+            {4, 2, 5},      // House 1
+            {1, 10, 11},    // House 2
+            {1, 24, 11},    // House 3
+            {4, 40, 5},     // House 4
+            {7, 40, 5},     // House 5
+            {10, 24, 11},   // House 6
+            {14, 24, 11},   // House 7
+            {18, 16, 11},   // House 8
+            {22, 16, 11},   // House 9
+            {14, 10, 11},   // House 10
+            {10, 10, 11},   // House 11
+            {7, 2, 5}       // House 12
+        },
+        false
+    };
+
+    // East Indian style is a rectangular 3x4 grid; houses 5 and 6 have no cell
+    static const GridLayout eastIndian = {
+        {
+            "+---------+---------+---------+",
+            "|   12    |    1    |    2    |",
+            "+---------+---------+---------+",
+            "|   11    |         |    3    |",
+            "+---------+---------+---------+",
+            "|   10    |         |    4    |",
+            "+---------+---------+---------+",
+            "|    9    |    8    |    7    |",
+            "+---------+---------+---------+"
+        },
+        {
+            {0, 0, 0},      // Dummy for index 0
+            {1, 11, 7},     // House 1 (top-center)
+            {1, 21, 7},     // House 2 (top-right)
+            {3, 21, 7},     // House 3 (middle-right)
+            {5, 21, 7},     // House 4
+            {0, 0, 0},      // House 5
+            {0, 0, 0},      // House 6
+            {7, 21, 7},     // House 7 (bottom-right)
+            {7, 11, 7},     // House 8 (bottom-center)
+            {7, 1, 7},      // House 9 (bottom-left)
+            {5, 1, 7},      // House 10
+            {3, 1, 7},      // House 11 (middle-left)
+            {1, 1, 7}       // House 12 (top-left)
+        },
+        true
+    };
+
+    if (style == "south-indian") return southIndian;
+    if (style == "east-indian") return eastIndian;
+    return northIndian;
+}
+
+std::vector<std::string> EasternChartDrawer::getHouseContents(const std::vector<PlanetPosition>& positions) const {
+    std::vector<std::string> contents(13);
+
+    for (const auto& pos : positions) {
+        if (pos.house >= 1 && pos.house <= 12) {
+            std::string& content = contents[pos.house];
+            if (!content.empty()) content += ",";
+            content += getShortPlanetName(pos.planet);
+        }
+    }
+
+    return contents;
 }
 
-std::string EasternChartDrawer::getShortPlanetName(Planet planet) const {
+std::string EasternChartDrawer::getShortPlanetName(Planet planet) {
     switch (planet) {
         case Planet::SUN: return "Su";
         case Planet::MOON: return "Mo";
@@ -199,146 +273,32 @@ std::string EasternChartDrawer::getShortPlanetName(Planet planet) const {
 }
 
 std::string EasternChartDrawer::formatHouseContent(const std::string& content, int width) const {
-    if (content.length() >= static_cast<size_t>(width)) {
-        return content.substr(0, width - 1);
+    if (displayWidth(content) >= width) {
+        return truncateToWidth(content, width - 1);
     }
 
-    int padding = width - content.length();
-    int leftPad = padding / 2;
-    int rightPad = padding - leftPad;
-
-    return std::string(leftPad, ' ') + content + std::string(rightPad, ' ');
+    return centerToWidth(content, width);
 }
 
-void EasternChartDrawer::fillNorthIndianHouses(std::vector<std::string>& lines,
-                                              const std::vector<PlanetPosition>& positions) const {
-    // North Indian chart house positions in the ASCII grid
-    struct HousePosition {
-        int line;
-        int startCol;
-        int width;
-    };
-
-    std::vector<HousePosition> housePositions = {
-        {0, 0, 0},      // Dummy for index 0
-        {2, 14, 11},    // House 1
-        {2, 28, 11},    // House 2
-        {2, 42, 11},    // House 3
-        {6, 42, 11},    // House 4
-        {10, 42, 11},   // House 5
-        {14, 42, 11},   // House 6
-        {14, 28, 11},   // House 7
-        {14, 14, 11},   // House 8
-        {14, 1, 11},    // House 9
-        {10, 1, 11},    // House 10
-        {6, 1, 11},     // House 11
-        {2, 1, 11}      // House 12
-    };
-
-    for (int house = 1; house <= 12; house++) {
-        std::string planets = getPlanetsInHouse(positions, house);
-        if (!planets.empty()) {
-            const auto& pos = housePositions[house];
-            std::string formatted = formatHouseContent(planets, pos.width);
-
-            // Replace the content in the appropriate line
-            if (pos.line < static_cast<int>(lines.size())) {
-                std::string& line = lines[pos.line];
-                if (pos.startCol + formatted.length() <= line.length()) {
-                    line.replace(pos.startCol + 2, formatted.length(), formatted);
-                }
-            }
-        }
+void EasternChartDrawer::drawHouse(std::vector<std::string>& lines, const GridLayout& layout,
+                                   int house, const std::string& planets) const {
+    const HouseCell& cell = layout.cells[house];
+    if (cell.width == 0 || cell.line >= static_cast<int>(lines.size())) {
+        return;
     }
-}
-
-void EasternChartDrawer::fillSouthIndianHouses(std::vector<std::string>& lines,
-                                              const std::vector<PlanetPosition>& positions) const {
-    // South Indian chart house positions in the ASCII grid
-    struct HousePosition {
-        int line;
-        int startCol;
-        int width;
-    };
 
-    std::vector<HousePosition> housePositions = {
-        {0, 0, 0},      // Dummy for index 0
-        {4, 2, 5},      // House 1
-        {1, 10, 11},    // House 2
-        {1, 24, 11},    // House 3
-        {4, 40, 5},     // House 4
-        {7, 40, 5},     // House 5
-        {10, 24, 11},   // House 6
-        {14, 24, 11},   // House 7
-        {18, 16, 11},   // House 8
-        {22, 16, 11},   // House 9
-        {14, 10, 11},   // House 10
-        {10, 10, 11},   // House 11
-        {7, 2, 5}       // House 12
-    };
-
-    for (int house = 1; house <= 12; house++) {
-        std::string planets = getPlanetsInHouse(positions, house);
-        if (!planets.empty()) {
-            const auto& pos = housePositions[house];
-            std::string formatted = formatHouseContent(planets, pos.width);
-
-            // Replace the content in the appropriate line
-            if (pos.line < static_cast<int>(lines.size())) {
-                std::string& line = lines[pos.line];
-                if (pos.startCol + formatted.length() <= line.length()) {
-                    line.replace(pos.startCol, formatted.length(), formatted);
-                }
-            }
-        }
+    // Put back the empty cell first, then the planets if there are any
+    std::string& line = lines[cell.line];
+    line.replace(cell.col, cell.width, layout.frame[cell.line], cell.col, cell.width);
+    if (planets.empty()) {
+        return;
     }
-}
-
-void EasternChartDrawer::fillEastIndianHouses(std::vector<std::string>& lines,
-                                             const std::vector<PlanetPosition>& positions) const {
-    // East Indian chart house positions in the 3x4 rectangular grid
-    // Create a mapping of houses to their positions in the grid
-    std::map<int, std::pair<int, int>> houseToLineCol = {
-        {12, {1, 1}},  // House 12 (top-left)
-        {1, {1, 11}},  // House 1 (top-center)
-        {2, {1, 21}},  // House 2 (top-right)
-        {11, {3, 1}},  // House 11 (middle-left)
-        {3, {3, 21}},  // House 3 (middle-right)
-        {10, {5, 1}},  // House 10 (not visible in this simplified format)
-        {4, {5, 21}},  // House 4 (not visible in this simplified format)
-        {9, {7, 1}},   // House 9 (bottom-left)
-        {8, {7, 11}},  // House 8 (bottom-center)
-        {7, {7, 21}}   // House 7 (bottom-right)
-    };
 
-    // Fill the houses with planets
-    for (int house = 1; house <= 12; house++) {
-        std::string planets = getPlanetsInHouse(positions, house);
-        if (!planets.empty()) {
-            auto it = houseToLineCol.find(house);
-            if (it != houseToLineCol.end()) {
-                int lineIdx = it->second.first;
-                int colStart = it->second.second;
-
-                if (lineIdx < static_cast<int>(lines.size())) {
-                    // Format content to fit in the cell (7 characters wide)
-                    std::string content = planets;
-                    if (content.length() > 7) {
-                        content = content.substr(0, 7);
-                    }
-
-                    // Center the content
-                    int padding = (7 - content.length()) / 2;
-                    std::string formatted = std::string(padding, ' ') + content +
-                                          std::string(7 - padding - content.length(), ' ');
-
-                    // Replace in the line
-                    if (colStart + 7 <= lines[lineIdx].length()) {
-                        lines[lineIdx].replace(colStart, 7, formatted);
-                    }
-                }
-            }
-        }
+    std::string formatted = layout.clipToWidth && displayWidth(planets) > cell.width
+                            ? truncateToWidth(planets, cell.width)
+                            : formatHouseContent(planets, cell.width);
+    if (cell.col + formatted.length() <= line.length()) {
+        line.replace(cell.col, formatted.length(), formatted);
     }
 }
 
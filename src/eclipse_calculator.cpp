@@ -1,4 +1,6 @@
 #include "eclipse_calculator.h"
+#include "profiler.h"
+#include "swiss_ephemeris.h"
 #include "ephemeris_manager.h"
 #include "astro_types.h"
 #include <swephexp.h>
@@ -66,6 +68,7 @@ bool EclipseCalculator::initialize(const std::string& ephemerisPath) {
 
 std::vector<EclipseEvent> EclipseCalculator::findEclipses(const BirthData& fromDate, const BirthData& toDate,
                                                           double latitude, double longitude) const {
+    ASTRO_PROFILE_SCOPE("EclipseCalculator::findEclipses");
     std::vector<EclipseEvent> eclipses;
 
     if (!isInitialized) {
@@ -119,10 +122,10 @@ std::vector<EclipseEvent> EclipseCalculator::findEclipses(const BirthData& fromD
 
             // Get Sun/Moon positions
             double sunpos[6], moonpos[6];
-            if (swe_calc_ut(eclipse.julianDay, SE_SUN, SEFLG_SWIEPH, sunpos, serr) >= 0) {
+            if (SwissEphemeris::calcUt(eclipse.julianDay, SE_SUN, SEFLG_SWIEPH, sunpos, serr) >= 0) {
                 eclipse.sunLongitude = sunpos[0];
             }
-            if (swe_calc_ut(eclipse.julianDay, SE_MOON, SEFLG_SWIEPH, moonpos, serr) >= 0) {
+            if (SwissEphemeris::calcUt(eclipse.julianDay, SE_MOON, SEFLG_SWIEPH, moonpos, serr) >= 0) {
                 eclipse.moonLongitude = moonpos[0];
             }
 
@@ -169,10 +172,10 @@ std::vector<EclipseEvent> EclipseCalculator::findEclipses(const BirthData& fromD
 
             // Get Sun/Moon positions
             double sunpos[6], moonpos[6];
-            if (swe_calc_ut(eclipse.julianDay, SE_SUN, SEFLG_SWIEPH, sunpos, serr) >= 0) {
+            if (SwissEphemeris::calcUt(eclipse.julianDay, SE_SUN, SEFLG_SWIEPH, sunpos, serr) >= 0) {
                 eclipse.sunLongitude = sunpos[0];
             }
-            if (swe_calc_ut(eclipse.julianDay, SE_MOON, SEFLG_SWIEPH, moonpos, serr) >= 0) {
+            if (SwissEphemeris::calcUt(eclipse.julianDay, SE_MOON, SEFLG_SWIEPH, moonpos, serr) >= 0) {
                 eclipse.moonLongitude = moonpos[0];
             }
 
@@ -275,8 +278,8 @@ EclipseEvent EclipseCalculator::findNextSolarEclipse(const BirthData& afterDate,
 
             // Calculate Sun and Moon positions for additional info
             double sunpos[6], moonpos[6];
-            if (swe_calc_ut(eclipse.julianDay, SE_SUN, SEFLG_SWIEPH, sunpos, serr) >= 0 &&
-                swe_calc_ut(eclipse.julianDay, SE_MOON, SEFLG_SWIEPH, moonpos, serr) >= 0) {
+            if (SwissEphemeris::calcUt(eclipse.julianDay, SE_SUN, SEFLG_SWIEPH, sunpos, serr) >= 0 &&
+                SwissEphemeris::calcUt(eclipse.julianDay, SE_MOON, SEFLG_SWIEPH, moonpos, serr) >= 0) {
                 eclipse.sunLongitude = sunpos[0];
                 eclipse.moonLongitude = moonpos[0];
             }
@@ -286,8 +289,8 @@ EclipseEvent EclipseCalculator::findNextSolarEclipse(const BirthData& afterDate,
 
             // Get positions anyway
             double sunpos[6], moonpos[6];
-            if (swe_calc_ut(eclipse.julianDay, SE_SUN, SEFLG_SWIEPH, sunpos, serr) >= 0 &&
-                swe_calc_ut(eclipse.julianDay, SE_MOON, SEFLG_SWIEPH, moonpos, serr) >= 0) {
+            if (SwissEphemeris::calcUt(eclipse.julianDay, SE_SUN, SEFLG_SWIEPH, sunpos, serr) >= 0 &&
+                SwissEphemeris::calcUt(eclipse.julianDay, SE_MOON, SEFLG_SWIEPH, moonpos, serr) >= 0) {
                 eclipse.sunLongitude = sunpos[0];
                 eclipse.moonLongitude = moonpos[0];
             }
@@ -352,8 +355,8 @@ EclipseEvent EclipseCalculator::findNextLunarEclipse(const BirthData& afterDate,
 
         // Calculate Sun and Moon positions
         double sunpos[6], moonpos[6];
-        if (swe_calc_ut(eclipse.julianDay, SE_SUN, SEFLG_SWIEPH, sunpos, serr) >= 0 &&
-            swe_calc_ut(eclipse.julianDay, SE_MOON, SEFLG_SWIEPH, moonpos, serr) >= 0) {
+        if (SwissEphemeris::calcUt(eclipse.julianDay, SE_SUN, SEFLG_SWIEPH, sunpos, serr) >= 0 &&
+            SwissEphemeris::calcUt(eclipse.julianDay, SE_MOON, SEFLG_SWIEPH, moonpos, serr) >= 0) {
             eclipse.sunLongitude = sunpos[0];
             eclipse.moonLongitude = moonpos[0];
         }
@@ -1,16 +1,18 @@
 #include "ephemeris_manager.h"
+#include "swiss_ephemeris.h"
 #include "swephexp.h"
 #include <iostream>
 #include <cstring>
 
 namespace Astro {
 
-EphemerisManager::EphemerisManager() : initialized(false) {
+EphemerisManager::EphemerisManager()
+    : initialized(false), includeInclination(true), streamStep(0.0), streamTolerance(0.0) {
 }
 
 EphemerisManager::~EphemerisManager() {
     if (initialized) {
-        swe_close();
+        SwissEphemeris::close();
     }
 }
 
@@ -20,7 +22,7 @@ bool EphemerisManager::initialize(const std::string& ephemerisPath) {
     }
 
     // Set ephemeris flags
-    swe_set_ephe_path(nullptr); // Use default path if not specified
+    SwissEphemeris::setEphemerisPath(nullptr); // Use default path if not specified
 
     initialized = true;
     lastError.clear();
@@ -29,7 +31,7 @@ bool EphemerisManager::initialize(const std::string& ephemerisPath) {
 
 void EphemerisManager::setEphemerisPath(const std::string& path) {
     if (!path.empty()) {
-        swe_set_ephe_path(const_cast<char*>(path.c_str()));
+        SwissEphemeris::setEphemerisPath(path.c_str());
     }
 }
 
@@ -49,7 +51,7 @@ bool EphemerisManager::calculatePlanetPosition(double julianDay, Planet planet,
         return false;
     }
 
-    int32 ret = swe_calc_ut(julianDay, ipl, iflag, xx, serr);
+    int32 ret = SwissEphemeris::calcUt(julianDay, ipl, iflag, xx, serr);
 
     if (ret < 0) {
         lastError = std::string("Swiss Ephemeris error: ") + serr;
@@ -67,7 +69,7 @@ bool EphemerisManager::calculatePlanetPosition(double julianDay, Planet planet,
 
     // Calculate equatorial coordinates (declination and right ascension)
     double xxEqu[6];
-    int32 ret2 = swe_calc_ut(julianDay, ipl, iflag | SEFLG_EQUATORIAL, xxEqu, serr);
+    int32 ret2 = SwissEphemeris::calcUt(julianDay, ipl, iflag | SEFLG_EQUATORIAL, xxEqu, serr);
     if (ret2 >= 0) {
         position.rightAscension = xxEqu[0];
         position.declination = xxEqu[1];
@@ -79,8 +81,8 @@ bool EphemerisManager::calculatePlanetPosition(double julianDay, Planet planet,
     // Calculate orbital inclination (for planets, not points like lunar nodes)
     if (planet != Planet::NORTH_NODE && planet != Planet::SOUTH_NODE &&
         planet != Planet::LILITH && planet != Planet::CHIRON) {
-        double orbitalElements[6];
-        int32 ret3 = swe_get_orbital_elements(julianDay, ipl, iflag, orbitalElements, serr);
+        double orbitalElements[SwissEphemeris::ORBITAL_ELEMENT_COUNT];
+        int32 ret3 = SwissEphemeris::orbitalElements(julianDay, ipl, iflag, orbitalElements, serr);
         if (ret3 >= 0) {
             position.inclination = orbitalElements[2]; // Inclination is the 3rd orbital element
         } else {
@@ -114,11 +116,13 @@ bool EphemerisManager::calculatePlanetPosition(double julianDay, Planet planet,
     }
 
     // Set ayanamsa if using sidereal zodiac
+    int siderealMode = -1;
     if (zodiacMode == ZodiacMode::SIDEREAL) {
-        swe_set_sid_mode(ayanamsaTypeToSwissEphId(ayanamsa), 0, 0);
+        siderealMode = ayanamsaTypeToSwissEphId(ayanamsa);
+        SwissEphemeris::setSiderealMode(siderealMode);
     }
 
-    int ret = swe_calc(julianDay, ipl, iflag, xx, serr);
+    int ret = calculatePosition(julianDay, ipl, iflag, siderealMode, xx, serr);
 
     if (ret < 0) {
         lastError = std::string("Swiss Ephemeris error: ") + serr;
@@ -135,7 +139,7 @@ bool EphemerisManager::calculatePlanetPosition(double julianDay, Planet planet,
 
     // Calculate equatorial coordinates (declination and right ascension)
     double xxEqu[6];
-    int32 ret2 = swe_calc(julianDay, ipl, iflag | SEFLG_EQUATORIAL, xxEqu, serr);
+    int32 ret2 = calculatePosition(julianDay, ipl, iflag | SEFLG_EQUATORIAL, siderealMode, xxEqu, serr);
     if (ret2 >= 0) {
         position.rightAscension = xxEqu[0];
         position.declination = xxEqu[1];
@@ -145,10 +149,10 @@ bool EphemerisManager::calculatePlanetPosition(double julianDay, Planet planet,
     }
 
     // Calculate orbital inclination (for planets, not points like lunar nodes)
-    if (planet != Planet::NORTH_NODE && planet != Planet::SOUTH_NODE &&
+    if (includeInclination && planet != Planet::NORTH_NODE && planet != Planet::SOUTH_NODE &&
         planet != Planet::LILITH && planet != Planet::CHIRON) {
-        double orbitalElements[6];
-        int32 ret3 = swe_get_orbital_elements(julianDay, ipl, iflag, orbitalElements, serr);
+        double orbitalElements[SwissEphemeris::ORBITAL_ELEMENT_COUNT];
+        int32 ret3 = SwissEphemeris::orbitalElements(julianDay, ipl, iflag, orbitalElements, serr);
         if (ret3 >= 0) {
             position.inclination = orbitalElements[2]; // Inclination is the 3rd orbital element
         } else {
@@ -163,6 +167,26 @@ bool EphemerisManager::calculatePlanetPosition(double julianDay, Planet planet,
     return true;
 }
 
+void EphemerisManager::setPositionStep(double step, double tolerance) {
+    streamStep = step;
+    streamTolerance = tolerance;
+    streams.clear();
+}
+
+int EphemerisManager::calculatePosition(double julianDay, int ipl, int iflag, int siderealMode,
+                                        double* xx, char* serr) {
+    if (streamTolerance <= 0.0) {
+        return SwissEphemeris::calc(julianDay, ipl, iflag, xx, serr);
+    }
+
+    auto key = std::make_tuple(ipl, iflag, siderealMode);
+    auto it = streams.find(key);
+    if (it == streams.end()) {
+        it = streams.emplace(key, PositionStream(ipl, iflag, false, streamStep, streamTolerance)).first;
+    }
+    return it->second.calc(julianDay, xx, serr);
+}
+
 bool EphemerisManager::calculateHouseCusps(double julianDay, double latitude, double longitude,
                                          HouseSystem system, HouseCusps& cusps) {
     if (!initialized) {
@@ -204,7 +228,7 @@ bool EphemerisManager::calculateHouseCusps(double julianDay, double latitude, do
 
     // Set ayanamsa if using sidereal zodiac
     if (zodiacMode == ZodiacMode::SIDEREAL) {
-        swe_set_sid_mode(ayanamsaTypeToSwissEphId(ayanamsa), 0, 0);
+        SwissEphemeris::setSiderealMode(ayanamsaTypeToSwissEphId(ayanamsa));
     }
 
     double hcusps[13];
@@ -1,7 +1,12 @@
 #include "ephemeris_table.h"
+#include "profiler.h"
+#include "json_writer.h"
 #include "ephemeris_manager.h"
 #include "planet_calculator.h"
 #include "astro_types.h"
+#include "professional_table.h"
+#include "display_width.h"
+#include "swiss_ephemeris.h"
 #include <swephexp.h>
 #include <sstream>
 #include <iomanip>
@@ -23,7 +28,7 @@ namespace AnsiColors {
 namespace Astro {
 
 EphemerisConfig::EphemerisConfig()
-    : intervalDays(1), showDegreeMinutes(true), showSign(true), showRetrograde(true),
+    : intervalDays(1), intervalMinutes(0), interpolationTolerance(0.0), showDegreeMinutes(true), showSign(true), showRetrograde(true),
       showSpeed(false), showDistance(false), showLatitude(false), showLatitudeOnly(false),
       showDeclination(false), showRightAscension(false), showSiderealTime(false),
       show3LineCoordinates(false), compactFormat(false), format("table"), zodiacMode(ZodiacMode::TROPICAL),
@@ -36,6 +41,14 @@ EphemerisConfig::EphemerisConfig()
 }EphemerisTable::EphemerisTable() : isInitialized(false) {
 }
 
+double EphemerisConfig::getStepDays() const {
+    return intervalMinutes > 0 ? intervalMinutes / 1440.0 : intervalDays;
+}
+
+std::string EphemerisConfig::getIntervalString() const {
+    return intervalMinutes > 0 ? std::to_string(intervalMinutes) + " minute(s)" : std::to_string(intervalDays) + " day(s)";
+}
+
 EphemerisTable::~EphemerisTable() {
 }
 
@@ -51,27 +64,30 @@ bool EphemerisTable::initialize(const std::string& ephePath) {
 }
 
 std::string EphemerisTable::generateTable(const EphemerisConfig& config) const {
-    if (!isInitialized) {
-        lastError = "Ephemeris table not initialized";
+    std::ostringstream output;
+    if (!writeTable(config, output)) {
         return "";
     }
+    return output.str();
+}
 
-    std::vector<EphemerisEntry> entries = generateEntries(config);
-
-    // Check if entries generation failed due to error
-    if (entries.empty() && !lastError.empty()) {
-        return "";
+bool EphemerisTable::writeTable(const EphemerisConfig& config, std::ostream& os) const {
+    if (!isInitialized) {
+        lastError = "Ephemeris table not initialized";
+        return false;
     }
 
+    EntryRange entries = [this, &config](const EntryVisitor& visit) { return forEachEntry(config, visit); };
+
     if (config.format == "csv") {
-        return exportToCSV(entries, config);
+        return writeCSV(os, entries, config);
     } else if (config.format == "json") {
-        return exportToJSON(entries, config);
+        return writeJSON(os, entries, config);
     } else if (config.format == "html") {
-        return exportToHTML(entries, config);
-    } else {
-        return formatAsTable(entries, config);
+        os << exportToHTML(generateEntries(config), config);
+        return true;
     }
+    return writeAsTable(os, entries, config);
 }
 
 std::string EphemerisTable::generateMonthlyTable(int year, int month, const std::vector<Planet>& planets) const {
@@ -149,6 +165,9 @@ std::string EphemerisTable::generateTransitTable(const BirthData& natalData, con
 
     for (const auto& entry : entries) {
         ss << entry.getDateString() << " ";
+        if (config.intervalMinutes > 0) {
+            ss << entry.getTimeString() << " ";
+        }
 
         for (Planet planet : config.planets) {
             auto it = std::find_if(entry.positions.begin(), entry.positions.end(),
@@ -178,29 +197,58 @@ std::string EphemerisTable::generateTransitTable(const BirthData& natalData, con
 }
 
 std::vector<EphemerisEntry> EphemerisTable::generateEntries(const EphemerisConfig& config) const {
+    ASTRO_PROFILE_SCOPE("EphemerisTable::generateEntries");
     std::vector<EphemerisEntry> entries;
+    forEachEntry(config, [&entries](const EphemerisEntry& entry) {
+        entries.push_back(entry);
+        return true;
+    });
+    return entries;
+}
+
+EphemerisTable::EntryRange EphemerisTable::entriesOf(const std::vector<EphemerisEntry>& entries) {
+    return [&entries](const EntryVisitor& visit) {
+        for (const auto& entry : entries) {
+            if (!visit(entry)) break;
+        }
+        return true;
+    };
+}
 
+bool EphemerisTable::forEachEntry(const EphemerisConfig& config, const EntryVisitor& visit) const {
+    ASTRO_PROFILE_SCOPE("EphemerisTable::forEachEntry");
     double startJD = config.startDate.getJulianDay();
     double endJD = config.endDate.getJulianDay();
 
     EphemerisManager ephMgr;
     if (!ephMgr.initialize()) {
-        return entries;
+        lastError = "Failed to initialize ephemeris manager: " + ephMgr.getLastError();
+        return false;
     }
+    double step = config.getStepDays();
+    ephMgr.setPositionStep(step, config.interpolationTolerance);
+    ephMgr.setIncludeInclination(false);     // not part of any table
 
     PlanetCalculator calc(ephMgr);
 
-    for (double currentJD = startJD; currentJD <= endJD; currentJD += config.intervalDays) {
+    for (long n = 0; startJD + n * step <= endJD; n++) {
+        double currentJD = startJD + n * step;
         EphemerisEntry entry;
         entry.julianDay = currentJD;
 
-        // Convert Julian Day to calendar date
-        int year, month, day, hour, minute;
-        double second;
-        swe_jdet_to_utc(currentJD, SE_GREG_CAL, &year, &month, &day, &hour, &minute, &second);
+        // Convert the UT Julian Day to calendar date and time, to the nearest minute
+        long long minutes = std::llround((currentJD + 0.5) * 1440.0);
+        long long dayNumber = minutes / 1440 - (minutes % 1440 < 0 ? 1 : 0);
+        int year, month, day;
+        double noon;
+        swe_revjul(static_cast<double>(dayNumber), SE_GREG_CAL, &year, &month, &day, &noon);
+        int hour = static_cast<int>((minutes - dayNumber * 1440) / 60);
+        int minute = static_cast<int>((minutes - dayNumber * 1440) % 60);
         entry.year = year;
         entry.month = month;
         entry.day = day;
+        entry.hour = hour;
+        entry.minute = minute;
 
         // Calculate sidereal time for ephemeris table
         // Testing different sidereal time calculation methods to match reference
@@ -217,7 +265,7 @@ std::vector<EphemerisEntry> EphemerisTable::generateEntries(const EphemerisConfi
         entry.siderealTime = mean_sidereal_time;
 
         // Calculate planet positions for this date with zodiac mode and ayanamsa
-        BirthData entryDate = {year, month, day, hour, minute, static_cast<int>(second), 0.0, 0.0, 0.0};
+        BirthData entryDate = {year, month, day, hour, minute, 0, 0.0, 0.0, 0.0};
 
         // Configure the calculator with zodiac mode and ayanamsa
         calc.setZodiacMode(config.zodiacMode);
@@ -227,25 +275,52 @@ std::vector<EphemerisEntry> EphemerisTable::generateEntries(const EphemerisConfi
 
         calc.calculateAllPlanets(entryDate, entry.positions);
 
-        entries.push_back(entry);
+        if (!visit(entry)) break;
     }
 
-    return entries;
+    return true;
 }
 
 std::string EphemerisTable::formatAsTable(const std::vector<EphemerisEntry>& entries, const EphemerisConfig& config) const {
-    if (entries.empty()) {
-        return "No entries to display.\n";
+    std::ostringstream output;
+    writeAsTable(output, entriesOf(entries), config);
+    return output.str();
+}
+
+bool EphemerisTable::writeAsTable(std::ostream& ss, const EntryRange& entries,
+                                  const EphemerisConfig& config) const {
+    ASTRO_PROFILE_SCOPE("EphemerisTable::writeAsTable");
+    // The first entry decides the empty case and dates the ayanamsa footer
+    EphemerisEntry first;
+    bool hasEntries = false;
+    if (!entries([&](const EphemerisEntry& entry) {
+            first = entry;
+            hasEntries = true;
+            return false;
+        })) {
+        return false;
+    }
+    if (!hasEntries) {
+        ss << "No entries to display.\n";
+        return true;
     }
 
     if (config.compactFormat) {
-        return formatAsCompactTable(entries, config);
+        // Grouped by month, so the entries are collected first
+        std::vector<EphemerisEntry> all;
+        if (!entries([&all](const EphemerisEntry& entry) {
+                all.push_back(entry);
+                return true;
+            })) {
+            return false;
+        }
+        ss << formatAsCompactTable(all, config);
+        return true;
     }
 
-    std::stringstream ss;
     ss << "\n=== EPHEMERIS TABLE ===\n";
     ss << "Period: " << config.startDate.getDateTimeString() << " to " << config.endDate.getDateTimeString() << "\n";
-    ss << "Interval: " << config.intervalDays << " day(s)\n";
+    ss << "Interval: " << config.getIntervalString() << "\n";
 
     // Show zodiac mode and ayanamsa info
     ss << "Zodiac: " << zodiacModeToString(config.zodiacMode);
@@ -254,8 +329,11 @@ std::string EphemerisTable::formatAsTable(const std::vector<EphemerisEntry>& ent
     }
     ss << "\n\n";
 
-    // Calculate column widths
-    std::vector<int> widths = calculateColumnWidths(entries, config);
+    // One pass measures every column, the next emits row by row
+    std::vector<int> widths;
+    if (!calculateColumnWidths(entries, config, widths)) {
+        return false;
+    }
 
     // Generate header
     std::vector<std::string> headers = getColumnHeaders(config);
@@ -263,8 +341,11 @@ std::string EphemerisTable::formatAsTable(const std::vector<EphemerisEntry>& ent
     ss << formatTableSeparator(widths);
 
     // Generate table rows
-    for (const auto& entry : entries) {
-        ss << formatTableRow(entry, config, widths);
+    if (!entries([&](const EphemerisEntry& entry) {
+            ss << formatTableRow(entry, config, widths);
+            return true;
+        })) {
+        return false;
     }
 
     ss << formatTableSeparator(widths);
@@ -302,14 +383,13 @@ std::string EphemerisTable::formatAsTable(const std::vector<EphemerisEntry>& ent
     }
 
     // Add ayanamsa information for sidereal zodiac mode
-    if (config.zodiacMode == ZodiacMode::SIDEREAL && !entries.empty()) {
-        double ayanamsaValue = entries[0].getAyanamsaValue(config.ayanamsa);
+    if (config.zodiacMode == ZodiacMode::SIDEREAL) {
+        double ayanamsaValue = first.getAyanamsaValue(config.ayanamsa);
         ss << "Ayanamsa: " << ayanamsaTypeToString(config.ayanamsa)
            << " = " << std::fixed << std::setprecision(4) << ayanamsaValue << "°"
-           << " (at " << entries[0].getDateString() << ")\n";
+           << " (at " << first.getDateString() << ")\n";
     }
-
-    return ss.str();
+    return true;
 }
 
 std::vector<std::string> EphemerisTable::getColumnHeaders(const EphemerisConfig& config) const {
@@ -361,91 +441,85 @@ std::vector<std::string> EphemerisTable::getColumnHeaders(const EphemerisConfig&
     return headers;
 }
 
-std::vector<int> EphemerisTable::calculateColumnWidths(const std::vector<EphemerisEntry>& entries,
-                                                      const EphemerisConfig& config) const {
+bool EphemerisTable::calculateColumnWidths(const EntryRange& entries, const EphemerisConfig& config,
+                                           std::vector<int>& widths) const {
     std::vector<std::string> headers = getColumnHeaders(config);
-    std::vector<int> widths;
-
-    // Date column width - calculate based on configuration
-    int dateWidth = headers[0].length(); // Start with header width
+    size_t firstPlanetColumn = config.showSiderealTime ? 2 : 1;
 
-    // Calculate maximum date string width from actual entries
-    for (const auto& entry : entries) {
-        std::string dateStr;
-        if (config.showDayNames) {
-            dateStr = entry.getDayName() + " ";
-        }
-
-        if (config.calendarMode == "jul") {
-            dateStr += entry.getJulianDateString();
-        } else if (config.calendarMode == "gregorian") {
-            dateStr += entry.getDateString();
-        } else if (config.calendarMode == "auto") {
-            if (entry.shouldUseJulianCalendar()) {
-                dateStr += entry.getJulianDateString() + " (Jul)";
-            } else {
-                dateStr += entry.getDateString();
-            }
-        } else if (config.calendarMode == "both") {
-            dateStr += entry.getDateString() + " (" + entry.getJulianDateString() + ")";
-        } else {
-            dateStr += entry.getDateString(); // Default fallback
-        }
-
-        dateWidth = std::max(dateWidth, static_cast<int>(dateStr.length()));
+    // Start with the header widths; each row can only widen a column
+    ColumnWidths measured;
+    for (size_t i = 0; i < headers.size(); i++) {
+        measured.observe(i, static_cast<int>(headers[i].length()));
     }
 
-    widths.push_back(dateWidth);
+    bool complete = entries([&](const EphemerisEntry& entry) {
+        measured.observe(0, static_cast<int>(formatDateColumn(entry, config).length()));
 
-    // Sidereal time column width if enabled
-    if (config.showSiderealTime) {
-        int siderealWidth = headers[widths.size()].length(); // Start with header width
-
-        // Calculate width based on actual sidereal time data
-        for (const auto& entry : entries) {
-            std::string siderealStr = formatSiderealTime(entry.siderealTime);
-            siderealWidth = std::max(siderealWidth, static_cast<int>(siderealStr.length()));
+        if (config.showSiderealTime) {
+            measured.observe(1, static_cast<int>(formatSiderealTime(entry.siderealTime).length()));
         }
 
-        widths.push_back(siderealWidth);
-    }
-
-    // Planet column widths - calculate based on actual data content
-    for (size_t i = 0; i < config.planets.size(); i++) {
-        Planet planet = config.planets[i];
-        int headerIndex = widths.size();
-        int width = headers[headerIndex].length(); // Start with header width
-
-        // Calculate maximum width needed for this planet's data across all entries
-        for (const auto& entry : entries) {
-            // Find position for this planet
+        for (size_t i = 0; i < config.planets.size(); i++) {
+            Planet planet = config.planets[i];
             auto it = std::find_if(entry.positions.begin(), entry.positions.end(),
                                  [planet](const PlanetPosition& pos) { return pos.planet == planet; });
+            if (it == entry.positions.end()) {
+                continue;
+            }
 
-            if (it != entry.positions.end()) {
-                std::string positionStr = formatPlanetPosition(*it, config);
-
-                if (config.show3LineCoordinates) {
-                    // For 3-line format, check each line separately and take the maximum
-                    std::istringstream iss(positionStr);
-                    std::string line;
-                    while (std::getline(iss, line)) {
-                        width = std::max(width, static_cast<int>(getVisualWidth(line)));
-                    }
-                } else {
-                    // For single-line formats, use the full string width
-                    width = std::max(width, static_cast<int>(getVisualWidth(positionStr)));
-                }
+            // For the 3-line format every line counts separately
+            std::string positionStr = formatPlanetPosition(*it, config);
+            size_t start = 0;
+            while (start <= positionStr.size()) {
+                size_t end = config.show3LineCoordinates ? positionStr.find('\n', start) : std::string::npos;
+                if (end == std::string::npos) end = positionStr.size();
+                measured.observe(firstPlanetColumn + i, static_cast<int>(getVisualWidth(positionStr.substr(start, end - start))));
+                if (end == positionStr.size()) break;
+                start = end + 1;
             }
         }
+        return true;
+    });
 
-        // Add a small padding (2 characters) for better readability
-        width += 2;
+    widths.assign(headers.size(), 0);
+    for (size_t i = 0; i < widths.size(); i++) {
+        // Planet columns get a small padding (2 characters) for better readability
+        widths[i] = measured[i] + (i >= firstPlanetColumn ? 2 : 0);
+    }
+    return complete;
+}
+
+std::string EphemerisTable::formatDateColumn(const EphemerisEntry& entry, const EphemerisConfig& config) const {
+    std::string dateStr;
+    if (config.showDayNames) {
+        dateStr = entry.getDayName() + " ";
+    }
 
-        widths.push_back(width);
+    if (config.calendarMode == "jul") {
+        // Julian calendar only
+        dateStr += entry.getJulianDateString();
+    } else if (config.calendarMode == "gregorian") {
+        // Gregorian calendar only
+        dateStr += entry.getDateString();
+    } else if (config.calendarMode == "auto") {
+        // Automatic: use Julian before Oct 15, 1582, Gregorian after
+        if (entry.shouldUseJulianCalendar()) {
+            dateStr += entry.getJulianDateString() + " (Jul)";
+        } else {
+            dateStr += entry.getDateString();
+        }
+    } else if (config.calendarMode == "both") {
+        // Show both calendars
+        dateStr += entry.getDateString() + " (" + entry.getJulianDateString() + ")";
+    } else {
+        // Default fallback to Gregorian
+        dateStr += entry.getDateString();
     }
 
-    return widths;
+    if (config.intervalMinutes > 0) {
+        dateStr += " " + entry.getTimeString();
+    }
+    return dateStr;
 }
 
 std::string EphemerisTable::formatTableHeader(const std::vector<std::string>& headers,
@@ -480,33 +554,9 @@ std::string EphemerisTable::formatTableRow(const EphemerisEntry& entry, const Ep
     std::stringstream ss;
 
     // Date column - construct based on calendar mode configuration
-    std::string dateStr;
-    if (config.showDayNames) {
-        dateStr = entry.getDayName() + " ";
-    }
+    ss << padStringToWidth(formatDateColumn(entry, config), widths[0], true);
 
-    if (config.calendarMode == "jul") {
-        // Julian calendar only
-        dateStr += entry.getJulianDateString();
-    } else if (config.calendarMode == "gregorian") {
-        // Gregorian calendar only
-        dateStr += entry.getDateString();
-    } else if (config.calendarMode == "auto") {
-        // Automatic: use Julian before Oct 15, 1582, Gregorian after
-        if (entry.shouldUseJulianCalendar()) {
-            dateStr += entry.getJulianDateString() + " (Jul)";
-        } else {
-            dateStr += entry.getDateString();
-        }
-    } else if (config.calendarMode == "both") {
-        // Show both calendars
-        dateStr += entry.getDateString() + " (" + entry.getJulianDateString() + ")";
-    } else {
-        // Default fallback to Gregorian
-        dateStr += entry.getDateString();
-    }
-
-    ss << padStringToWidth(dateStr, widths[0], true);    size_t columnIndex = 1;
+    size_t columnIndex = 1;
 
     // Sidereal time column if enabled
     if (config.showSiderealTime) {
@@ -542,26 +592,7 @@ std::string EphemerisTable::format3LineTableRow(const EphemerisEntry& entry, con
     std::stringstream ss;
 
     // Date column - construct based on calendar mode configuration
-    std::string dateStr;
-    if (config.showDayNames) {
-        dateStr = entry.getDayName() + " ";
-    }
-
-    if (config.calendarMode == "jul") {
-        dateStr += entry.getJulianDateString();
-    } else if (config.calendarMode == "gregorian") {
-        dateStr += entry.getDateString();
-    } else if (config.calendarMode == "auto") {
-        if (entry.shouldUseJulianCalendar()) {
-            dateStr += entry.getJulianDateString() + " (Jul)";
-        } else {
-            dateStr += entry.getDateString();
-        }
-    } else if (config.calendarMode == "both") {
-        dateStr += entry.getDateString() + " (" + entry.getJulianDateString() + ")";
-    } else {
-        dateStr += entry.getDateString();
-    }
+    std::string dateStr = formatDateColumn(entry, config);
 
     size_t columnIndex = 1;
 
@@ -720,12 +751,27 @@ std::string EphemerisTable::format3LinePosition(const PlanetPosition& position,
 }
 
 std::string EphemerisTable::exportToCSV(const std::vector<EphemerisEntry>& entries, const EphemerisConfig& config) const {
-    std::stringstream ss;
+    std::ostringstream output;
+    writeCSV(output, entriesOf(entries), config);
+    return output.str();
+}
+
+bool EphemerisTable::writeCSV(std::ostream& ss, const EntryRange& entries, const EphemerisConfig& config) const {
+    // Fetching the first entry up front also reports a failed setup before any output
+    EphemerisEntry first;
+    bool hasEntries = false;
+    if (!entries([&](const EphemerisEntry& entry) {
+            first = entry;
+            hasEntries = true;
+            return false;
+        })) {
+        return false;
+    }
 
     // CSV Header with metadata comments
     ss << "# Ephemeris Table - Zodiac: " << (config.zodiacMode == ZodiacMode::TROPICAL ? "Tropical" : "Sidereal");
-    if (config.zodiacMode == ZodiacMode::SIDEREAL && !entries.empty()) {
-        double ayanamsaValue = entries[0].getAyanamsaValue(config.ayanamsa);
+    if (config.zodiacMode == ZodiacMode::SIDEREAL && hasEntries) {
+        double ayanamsaValue = first.getAyanamsaValue(config.ayanamsa);
         ss << " (" << ayanamsaTypeToString(config.ayanamsa) << " ayanamsa = "
            << std::fixed << std::setprecision(4) << ayanamsaValue << "°)";
     }
@@ -742,8 +788,11 @@ std::string EphemerisTable::exportToCSV(const std::vector<EphemerisEntry>& entri
     ss << "\n";
 
     // CSV Data
-    for (const auto& entry : entries) {
+    return entries([&](const EphemerisEntry& entry) {
         ss << entry.getDateString();
+        if (config.intervalMinutes > 0) {
+            ss << " " << entry.getTimeString();
+        }
 
         for (Planet planet : config.planets) {
             auto it = std::find_if(entry.positions.begin(), entry.positions.end(),
@@ -762,67 +811,89 @@ std::string EphemerisTable::exportToCSV(const std::vector<EphemerisEntry>& entri
             }
         }
         ss << "\n";
-    }
-
-    return ss.str();
+        return true;
+    });
 }
 
 std::string EphemerisTable::exportToJSON(const std::vector<EphemerisEntry>& entries, const EphemerisConfig& config) const {
-    std::stringstream ss;
-    ss << "{\n";
-    ss << "  \"ephemeris\": {\n";
-    ss << "    \"period\": {\n";
-    ss << "      \"start\": \"" << config.startDate.getDateTimeString() << "\",\n";
-    ss << "      \"end\": \"" << config.endDate.getDateTimeString() << "\",\n";
-    ss << "      \"interval_days\": " << config.intervalDays << "\n";
-    ss << "    },\n";
-    ss << "    \"zodiac_mode\": \"" << (config.zodiacMode == ZodiacMode::TROPICAL ? "tropical" : "sidereal") << "\",\n";
-    if (config.zodiacMode == ZodiacMode::SIDEREAL && !entries.empty()) {
-        double ayanamsaValue = entries[0].getAyanamsaValue(config.ayanamsa);
-        ss << "    \"ayanamsa\": {\n";
-        ss << "      \"name\": \"" << ayanamsaTypeToString(config.ayanamsa) << "\",\n";
-        ss << "      \"value\": " << std::fixed << std::setprecision(4) << ayanamsaValue << ",\n";
-        ss << "      \"date\": \"" << entries[0].getDateString() << "\"\n";
-        ss << "    },\n";
-    }
-    ss << "    \"entries\": [\n";
-
-    for (size_t i = 0; i < entries.size(); i++) {
-        const auto& entry = entries[i];
-        ss << "      {\n";
-        ss << "        \"date\": \"" << entry.getDateString() << "\",\n";
-        ss << "        \"julian_day\": " << std::fixed << std::setprecision(6) << entry.julianDay << ",\n";
-        ss << "        \"planets\": {\n";
-
-        for (size_t j = 0; j < config.planets.size(); j++) {
-            Planet planet = config.planets[j];
+    std::ostringstream output;
+    writeJSON(output, entriesOf(entries), config);
+    return output.str();
+}
+
+bool EphemerisTable::writeJSON(std::ostream& os, const EntryRange& entries, const EphemerisConfig& config) const {
+    EphemerisEntry first;
+    bool hasEntries = false;
+    if (!entries([&](const EphemerisEntry& entry) {
+            first = entry;
+            hasEntries = true;
+            return false;
+        })) {
+        return false;
+    }
+
+    // The buffer is written out after every entry, so it only ever holds one
+    JsonWriter json;
+    json.reserve(512 + config.planets.size() * 160);
+    json.beginObject();
+    json.key("ephemeris").beginObject();
+    json.key("period").beginObject();
+    json.field("start", config.startDate.getDateTimeString());
+    json.field("end", config.endDate.getDateTimeString());
+    if (config.intervalMinutes > 0) {
+        json.field("interval_minutes", config.intervalMinutes);
+    } else {
+        json.field("interval_days", config.intervalDays);
+    }
+    json.endObject();
+    json.field("zodiac_mode", config.zodiacMode == ZodiacMode::TROPICAL ? "tropical" : "sidereal");
+    if (config.zodiacMode == ZodiacMode::SIDEREAL && hasEntries) {
+        json.key("ayanamsa").beginObject();
+        json.field("name", ayanamsaTypeToString(config.ayanamsa));
+        json.field("value", first.getAyanamsaValue(config.ayanamsa));
+        json.field("date", first.getDateString());
+        json.endObject();
+    }
+
+    json.key("entries").beginArray();
+    bool complete = entries([&](const EphemerisEntry& entry) {
+        json.beginObject();
+        json.field("date", entry.getDateString());
+        if (config.intervalMinutes > 0) {
+            json.field("time", entry.getTimeString());
+        }
+        json.field("julian_day", entry.julianDay);
+        json.key("planets").beginObject();
+
+        for (Planet planet : config.planets) {
             auto it = std::find_if(entry.positions.begin(), entry.positions.end(),
                                  [planet](const PlanetPosition& pos) { return pos.planet == planet; });
-
-            if (it != entry.positions.end()) {
-                ss << "          \"" << planetToString(planet) << "\": {\n";
-                ss << "            \"longitude\": " << std::fixed << std::setprecision(6) << it->longitude << ",\n";
-                ss << "            \"latitude\": " << std::fixed << std::setprecision(6) << it->latitude << ",\n";
-                ss << "            \"speed\": " << std::fixed << std::setprecision(6) << it->speed << ",\n";
-                ss << "            \"sign\": \"" << zodiacSignToString(it->sign) << "\",\n";
-                ss << "            \"retrograde\": " << (isRetrograde(*it) ? "true" : "false") << "\n";
-                ss << "          }";
-                if (j < config.planets.size() - 1) ss << ",";
-                ss << "\n";
-            }
+            if (it == entry.positions.end()) continue;
+
+            json.key(planetToString(planet)).beginObject();
+            json.field("longitude", it->longitude);
+            json.field("latitude", it->latitude);
+            json.field("speed", it->speed);
+            json.field("sign", zodiacSignToString(it->sign));
+            json.field("retrograde", isRetrograde(*it));
+            json.endObject();
         }
 
-        ss << "        }\n";
-        ss << "      }";
-        if (i < entries.size() - 1) ss << ",";
-        ss << "\n";
+        json.endObject();
+        json.endObject();
+        json.writeTo(os);
+        return true;
+    });
+    if (!complete) {
+        return false;
     }
+    json.endArray();
 
-    ss << "    ]\n";
-    ss << "  }\n";
-    ss << "}\n";
-
-    return ss.str();
+    json.endObject();
+    json.endObject();
+    json.writeTo(os);
+    os << '\n';
+    return true;
 }
 
 // Helper functions
@@ -833,6 +904,12 @@ std::string EphemerisEntry::getDateString() const {
     return ss.str();
 }
 
+std::string EphemerisEntry::getTimeString() const {
+    std::stringstream ss;
+    ss << std::setfill('0') << std::setw(2) << hour << ":" << std::setw(2) << minute;
+    return ss.str();
+}
+
 std::string EphemerisEntry::getJulianDateString() const {
     // Convert Julian Day to Julian calendar date using Swiss Ephemeris
     int julYear, julMonth, julDay;
@@ -861,11 +938,8 @@ bool EphemerisEntry::shouldUseJulianCalendar() const {
 }
 
 double EphemerisEntry::getAyanamsaValue(AyanamsaType ayanamsa) const {
-    // Set the ayanamsa mode in Swiss Ephemeris
-    swe_set_sid_mode(ayanamsaTypeToSwissEphId(ayanamsa), 0, 0);
-
-    // Get the ayanamsa value for this Julian Day
-    return swe_get_ayanamsa_ut(julianDay);
+    // Leaves the thread's sidereal mode alone, so it can be asked mid-table
+    return SwissEphemeris::ayanamsaUt(julianDay, ayanamsaTypeToSwissEphId(ayanamsa));
 }bool EphemerisTable::isRetrograde(const PlanetPosition& position) const {
     return position.speed < 0.0;
 }
@@ -1317,40 +1391,14 @@ EphemerisConfig EphemerisTable::createTropicalConfig() {
     return config;
 }
 
-// Helper function to calculate visual width excluding ANSI codes
+// Helper function to calculate visual width: display columns, ANSI codes excluded
 size_t EphemerisTable::getVisualWidth(const std::string& text) const {
-    size_t visualWidth = 0;
-    bool inEscapeSequence = false;
-
-    for (size_t i = 0; i < text.length(); i++) {
-        if (text[i] == '\033') {
-            inEscapeSequence = true;
-        } else if (inEscapeSequence && text[i] == 'm') {
-            inEscapeSequence = false;
-        } else if (!inEscapeSequence) {
-            visualWidth++;
-        }
-    }
-
-    return visualWidth;
+    return static_cast<size_t>(displayWidth(text));
 }
 
 // Helper function to pad string to specific width accounting for ANSI codes
 std::string EphemerisTable::padStringToWidth(const std::string& text, int width, bool leftAlign) const {
-    size_t visualWidth = getVisualWidth(text);
-
-    if (static_cast<int>(visualWidth) >= width) {
-        return text; // Already wide enough or too wide
-    }
-
-    int paddingNeeded = width - static_cast<int>(visualWidth);
-    std::string padding(paddingNeeded, ' ');
-
-    if (leftAlign) {
-        return text + padding;
-    } else {
-        return padding + text;
-    }
+    return padToWidth(text, width, !leftAlign);
 }
 
 } // namespace Astro
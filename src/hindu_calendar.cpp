@@ -1,8 +1,11 @@
 #include "hindu_calendar.h"
+#include "profiler.h"
+#include "swiss_ephemeris.h"
 #include "ephemeris_manager.h"
 #include "planet_calculator.h"
 #include "myanmar_calendar.h"
 #include "astro_types.h"
+#include "json_writer.h"
 #include <cmath>
 #include <sstream>
 #include <iomanip>
@@ -10,6 +13,9 @@
 #include <algorithm>
 #include <map>
 #include <ctime>
+#include <cctype>
+#include <cstdlib>
+#include <fstream>
 
 extern "C" {
 #include "swephexp.h"
@@ -17,6 +23,128 @@ extern "C" {
 
 namespace Astro {
 
+namespace {
+
+// Starting eighth of the day for each weekday (Sunday to Saturday)
+const int RAHU_KAAL_PERIODS[] = {7, 1, 6, 4, 5, 3, 2};
+const int YAMAGANDA_PERIODS[] = {4, 3, 2, 1, 7, 6, 5};
+const int GULIKAI_PERIODS[] = {6, 5, 4, 3, 2, 1, 7};
+
+// Dur Muhurtam spans 45 minutes either side of midday
+const double DUR_MUHURTAM_HALF_SPAN = 0.75;
+
+// Display names, indexed by the Ritu/Ayana/Direction/Varna enum values
+const char* const RITU_NAMES[] = {
+    "", "Shishira (Late Winter)", "Vasanta (Spring)", "Grishma (Summer)",
+    "Varsha (Monsoon)", "Sharad (Autumn)", "Hemanta (Early Winter)"
+};
+const char* const AYANA_NAMES[] = {"", "Uttarayana (Northward)", "Dakshinayana (Southward)"};
+const char* const DIRECTION_NAMES[] = {"", "East", "North", "South", "West"};
+const char* const VARNA_NAMES[] = {"", "Brahmin", "Kshatriya", "Vaishya", "Shudra"};
+
+const char* const SHUBHA_MUHURTA_DESCRIPTION = "Generally auspicious time for most activities";
+const char* const ASHUBHA_MUHURTA_DESCRIPTION =
+    "Exercise caution; consult detailed muhurta for important activities";
+
+// Mean daily motions used to seed root finding (degrees/day)
+const double MEAN_ELONGATION_RATE = 12.190749;
+const double MEAN_SUN_RATE = 0.985647;
+const double MEAN_MOON_RATE = 13.176358;
+
+// Widening of candidate windows so a day sitting on a boundary is still evaluated
+const double CANDIDATE_MARGIN_DAYS = 0.01;
+
+enum class CalendarAngle { SUN, MOON, ELONGATION };
+
+// Sidereal angle and its daily rate, using the Panchanga's ephemeris flags
+bool calendarAngleAt(CalendarAngle kind, double jd, double& angle, double& rate) {
+    double sunPos[6] = {0}, moonPos[6] = {0};
+    char errorString[256];
+    if (kind != CalendarAngle::MOON &&
+        SwissEphemeris::calc(jd, SE_SUN, SEFLG_SIDEREAL | SEFLG_SPEED, sunPos, errorString) < 0) {
+        return false;
+    }
+    if (kind != CalendarAngle::SUN &&
+        SwissEphemeris::calc(jd, SE_MOON, SEFLG_SIDEREAL | SEFLG_SPEED, moonPos, errorString) < 0) {
+        return false;
+    }
+
+    switch (kind) {
+        case CalendarAngle::SUN:
+            angle = sunPos[0];
+            rate = sunPos[3];
+            break;
+        case CalendarAngle::MOON:
+            angle = moonPos[0];
+            rate = moonPos[3];
+            break;
+        case CalendarAngle::ELONGATION:
+            angle = moonPos[0] - sunPos[0];
+            rate = moonPos[3] - sunPos[3];
+            break;
+    }
+    return true;
+}
+
+// Newton iteration from jd towards the nearest instant where the angle equals target
+bool solveCalendarAngle(CalendarAngle kind, double target, double& jd) {
+    for (int iteration = 0; iteration < 12; iteration++) {
+        double angle, rate;
+        if (!calendarAngleAt(kind, jd, angle, rate) || rate <= 0.0) {
+            return false;
+        }
+        double step = std::remainder(target - angle, 360.0) / rate;
+        jd += step;
+        if (std::fabs(step) < 1e-6) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Every instant in [from, to) where the angle passes through target
+std::vector<double> findCalendarCrossings(CalendarAngle kind, double target, double meanRate,
+                                          double from, double to) {
+    std::vector<double> crossings;
+    double angle, rate;
+    if (!calendarAngleAt(kind, from, angle, rate)) {
+        return crossings;
+    }
+
+    double period = 360.0 / meanRate;
+    double guess = from + std::fmod(target - angle + 720.0, 360.0) / meanRate;
+    while (guess < to + period) {
+        double jd = guess;
+        if (!solveCalendarAngle(kind, target, jd) || jd >= to) {
+            break;
+        }
+        if (jd >= from && (crossings.empty() || jd - crossings.back() > period / 2.0)) {
+            crossings.push_back(jd);
+        }
+        guess = std::max(jd, guess) + period;
+    }
+    return crossings;
+}
+
+std::string formatJulianDate(double jd) {
+    int year, month, day;
+    double hour;
+    swe_revjul(jd, SE_GREG_CAL, &year, &month, &day, &hour);
+    char buffer[16];
+    snprintf(buffer, sizeof(buffer), "%04d-%02d-%02d", year, month, day);
+    return buffer;
+}
+
+// Convert a rise/set Julian Day to decimal hours (approximate local time)
+double riseSetToHours(double eventJD, double defaultHours) {
+    if (eventJD <= 0.0) return defaultHours;
+    double hours = (eventJD - floor(eventJD)) * 24.0;
+    if (hours < 0) hours += 24.0;
+    return hours;
+}
+
+} // namespace
+
 HinduCalendar::HinduCalendar() :
     ayanamsa(AyanamsaType::LAHIRI),
     calculationMethod(CalculationMethod::DRIK_SIDDHANTA),
@@ -36,13 +164,10 @@ HinduCalendar::~HinduCalendar() {
 bool HinduCalendar::initialize() {
     try {
         // Set the ayanamsa for Swiss Ephemeris
-        swe_set_sid_mode(getSweAyanamsaId(), 0, 0);
+        SwissEphemeris::setSiderealMode(getSweAyanamsaId());
 
-        initializeNakshatraData();
-        initializeTithiData();
-        initializeYogaData();
-        initializeKaranaData();
         initializeFestivalData();
+        compileFestivalRules();
 
         initialized = true;
         return true;
@@ -58,199 +183,439 @@ bool HinduCalendar::initialize(AyanamsaType ayanamsaType, CalculationMethod meth
     return initialize();
 }
 
-void HinduCalendar::initializeNakshatraData() {
-    nakshatraData = {
-        {"Ashwini", "अश्विनी", Planet::SOUTH_NODE, "Horse's head", "Ashwini Kumaras", 0.0, 13.333333, "Dev", "Dev", "Swift"},
-        {"Bharani", "भरणी", Planet::VENUS, "Yoni", "Yama", 13.333333, 26.666667, "Manush", "Manush", "Fierce"},
-        {"Krittika", "कृत्तिका", Planet::SUN, "Razor/Knife", "Agni", 26.666667, 40.0, "Rakshasa", "Rakshasa", "Mixed"},
-        {"Rohini", "रोहिणी", Planet::MOON, "Cart/Chariot", "Brahma", 40.0, 53.333333, "Manush", "Manush", "Fixed"},
-        {"Mrigashira", "मृगशिरा", Planet::MARS, "Deer's head", "Soma", 53.333333, 66.666667, "Dev", "Dev", "Soft"},
-        {"Ardra", "आर्द्रा", Planet::NORTH_NODE, "Teardrop", "Rudra", 66.666667, 80.0, "Manush", "Manush", "Sharp"},
-        {"Punarvasu", "पुनर्वसु", Planet::JUPITER, "Quiver of arrows", "Aditi", 80.0, 93.333333, "Dev", "Dev", "Moveable"},
-        {"Pushya", "पुष्य", Planet::SATURN, "Cow's udder", "Brihaspati", 93.333333, 106.666667, "Dev", "Dev", "Light"},
-        {"Ashlesha", "आश्लेषा", Planet::MERCURY, "Serpent", "Sarpa", 106.666667, 120.0, "Rakshasa", "Rakshasa", "Sharp"},
-        {"Magha", "मघा", Planet::SOUTH_NODE, "Royal throne", "Pitrs", 120.0, 133.333333, "Rakshasa", "Rakshasa", "Fierce"},
-        {"Purva Phalguni", "पूर्व फाल्गुनी", Planet::VENUS, "Front legs of bed", "Bhaga", 133.333333, 146.666667, "Manush", "Manush", "Fierce"},
-        {"Uttara Phalguni", "उत्तर फाल्गुनी", Planet::SUN, "Back legs of bed", "Aryaman", 146.666667, 160.0, "Manush", "Manush", "Fixed"},
-        {"Hasta", "हस्त", Planet::MOON, "Hand", "Savitar", 160.0, 173.333333, "Dev", "Dev", "Light"},
-        {"Chitra", "चित्रा", Planet::MARS, "Bright jewel", "Vishvakarma", 173.333333, 186.666667, "Rakshasa", "Rakshasa", "Soft"},
-        {"Swati", "स्वाति", Planet::NORTH_NODE, "Young shoot", "Vayu", 186.666667, 200.0, "Dev", "Dev", "Moveable"},
-        {"Vishakha", "विशाखा", Planet::JUPITER, "Triumphal arch", "Indragni", 200.0, 213.333333, "Rakshasa", "Rakshasa", "Mixed"},
-        {"Anuradha", "अनुराधा", Planet::SATURN, "Lotus", "Mitra", 213.333333, 226.666667, "Dev", "Dev", "Soft"},
-        {"Jyeshtha", "ज्येष्ठा", Planet::MERCURY, "Earring", "Indra", 226.666667, 240.0, "Rakshasa", "Rakshasa", "Sharp"},
-        {"Mula", "मूल", Planet::SOUTH_NODE, "Bunch of roots", "Nirriti", 240.0, 253.333333, "Rakshasa", "Rakshasa", "Sharp"},
-        {"Purva Ashadha", "पूर्वाषाढ़ा", Planet::VENUS, "Elephant tusk", "Apas", 253.333333, 266.666667, "Manush", "Manush", "Fierce"},
-        {"Uttara Ashadha", "उत्तराषाढ़ा", Planet::SUN, "Elephant tusk", "Vishvedevas", 266.666667, 280.0, "Manush", "Manush", "Fixed"},
-        {"Shravana", "श्रवण", Planet::MOON, "Ear", "Vishnu", 280.0, 293.333333, "Dev", "Dev", "Moveable"},
-        {"Dhanishta", "धनिष्ठा", Planet::MARS, "Drum", "Vasus", 293.333333, 306.666667, "Rakshasa", "Rakshasa", "Moveable"},
-        {"Shatabhisha", "शतभिषा", Planet::NORTH_NODE, "Empty circle", "Varuna", 306.666667, 320.0, "Rakshasa", "Rakshasa", "Moveable"},
-        {"Purva Bhadrapada", "पूर्व भाद्रपदा", Planet::JUPITER, "Sword", "Aja Ekapada", 320.0, 333.333333, "Manush", "Manush", "Fierce"},
-        {"Uttara Bhadrapada", "उत्तर भाद्रपदा", Planet::SATURN, "Twins", "Ahir Budhnya", 333.333333, 346.666667, "Manush", "Manush", "Fixed"},
-        {"Revati", "रेवती", Planet::MERCURY, "Fish", "Pushan", 346.666667, 360.0, "Dev", "Dev", "Soft"}
-    };
-}
+const HinduCalendar::NakshatraInfo HinduCalendar::NAKSHATRA_DATA[27] = {
+    {"Ashwini", "अश्विनी", Planet::SOUTH_NODE, "Horse's head", "Ashwini Kumaras", 0.0, 13.333333, "Dev", "Dev", "Swift"},
+    {"Bharani", "भरणी", Planet::VENUS, "Yoni", "Yama", 13.333333, 26.666667, "Manush", "Manush", "Fierce"},
+    {"Krittika", "कृत्तिका", Planet::SUN, "Razor/Knife", "Agni", 26.666667, 40.0, "Rakshasa", "Rakshasa", "Mixed"},
+    {"Rohini", "रोहिणी", Planet::MOON, "Cart/Chariot", "Brahma", 40.0, 53.333333, "Manush", "Manush", "Fixed"},
+    {"Mrigashira", "मृगशिरा", Planet::MARS, "Deer's head", "Soma", 53.333333, 66.666667, "Dev", "Dev", "Soft"},
+    {"Ardra", "आर्द्रा", Planet::NORTH_NODE, "Teardrop", "Rudra", 66.666667, 80.0, "Manush", "Manush", "Sharp"},
+    {"Punarvasu", "पुनर्वसु", Planet::JUPITER, "Quiver of arrows", "Aditi", 80.0, 93.333333, "Dev", "Dev", "Moveable"},
+    {"Pushya", "पुष्य", Planet::SATURN, "Cow's udder", "Brihaspati", 93.333333, 106.666667, "Dev", "Dev", "Light"},
+    {"Ashlesha", "आश्लेषा", Planet::MERCURY, "Serpent", "Sarpa", 106.666667, 120.0, "Rakshasa", "Rakshasa", "Sharp"},
+    {"Magha", "मघा", Planet::SOUTH_NODE, "Royal throne", "Pitrs", 120.0, 133.333333, "Rakshasa", "Rakshasa", "Fierce"},
+    {"Purva Phalguni", "पूर्व फाल्गुनी", Planet::VENUS, "Front legs of bed", "Bhaga", 133.333333, 146.666667, "Manush", "Manush", "Fierce"},
+    {"Uttara Phalguni", "उत्तर फाल्गुनी", Planet::SUN, "Back legs of bed", "Aryaman", 146.666667, 160.0, "Manush", "Manush", "Fixed"},
+    {"Hasta", "हस्त", Planet::MOON, "Hand", "Savitar", 160.0, 173.333333, "Dev", "Dev", "Light"},
+    {"Chitra", "चित्रा", Planet::MARS, "Bright jewel", "Vishvakarma", 173.333333, 186.666667, "Rakshasa", "Rakshasa", "Soft"},
+    {"Swati", "स्वाति", Planet::NORTH_NODE, "Young shoot", "Vayu", 186.666667, 200.0, "Dev", "Dev", "Moveable"},
+    {"Vishakha", "विशाखा", Planet::JUPITER, "Triumphal arch", "Indragni", 200.0, 213.333333, "Rakshasa", "Rakshasa", "Mixed"},
+    {"Anuradha", "अनुराधा", Planet::SATURN, "Lotus", "Mitra", 213.333333, 226.666667, "Dev", "Dev", "Soft"},
+    {"Jyeshtha", "ज्येष्ठा", Planet::MERCURY, "Earring", "Indra", 226.666667, 240.0, "Rakshasa", "Rakshasa", "Sharp"},
+    {"Mula", "मूल", Planet::SOUTH_NODE, "Bunch of roots", "Nirriti", 240.0, 253.333333, "Rakshasa", "Rakshasa", "Sharp"},
+    {"Purva Ashadha", "पूर्वाषाढ़ा", Planet::VENUS, "Elephant tusk", "Apas", 253.333333, 266.666667, "Manush", "Manush", "Fierce"},
+    {"Uttara Ashadha", "उत्तराषाढ़ा", Planet::SUN, "Elephant tusk", "Vishvedevas", 266.666667, 280.0, "Manush", "Manush", "Fixed"},
+    {"Shravana", "श्रवण", Planet::MOON, "Ear", "Vishnu", 280.0, 293.333333, "Dev", "Dev", "Moveable"},
+    {"Dhanishta", "धनिष्ठा", Planet::MARS, "Drum", "Vasus", 293.333333, 306.666667, "Rakshasa", "Rakshasa", "Moveable"},
+    {"Shatabhisha", "शतभिषा", Planet::NORTH_NODE, "Empty circle", "Varuna", 306.666667, 320.0, "Rakshasa", "Rakshasa", "Moveable"},
+    {"Purva Bhadrapada", "पूर्व भाद्रपदा", Planet::JUPITER, "Sword", "Aja Ekapada", 320.0, 333.333333, "Manush", "Manush", "Fierce"},
+    {"Uttara Bhadrapada", "उत्तर भाद्रपदा", Planet::SATURN, "Twins", "Ahir Budhnya", 333.333333, 346.666667, "Manush", "Manush", "Fixed"},
+    {"Revati", "रेवती", Planet::MERCURY, "Fish", "Pushan", 346.666667, 360.0, "Dev", "Dev", "Soft"}
+};
+
+const HinduCalendar::TithiInfo HinduCalendar::TITHI_DATA[30] = {
+    {"Pratipad", "प्रतिपदा", Planet::SUN, "Beginning", true, "New starts, worship"},
+    {"Dwitiya", "द्वितीया", Planet::MOON, "Second", true, "Growth, learning"},
+    {"Tritiya", "तृतीया", Planet::MARS, "Third", true, "Action, energy"},
+    {"Chaturthi", "चतुर्थी", Planet::MERCURY, "Fourth", true, "Intelligence, obstacles removal"},
+    {"Panchami", "पंचमी", Planet::JUPITER, "Fifth", true, "Knowledge, wisdom"},
+    {"Shashthi", "षष्ठी", Planet::VENUS, "Sixth", true, "Love, beauty, comfort"},
+    {"Saptami", "सप्तमी", Planet::SATURN, "Seventh", true, "Discipline, hard work"},
+    {"Ashtami", "अष्टमी", Planet::NORTH_NODE, "Eighth", false, "Obstacles, power"},
+    {"Navami", "नवमी", Planet::SUN, "Ninth", true, "Completion of tasks"},
+    {"Dashami", "दशमी", Planet::MOON, "Tenth", true, "Success in endeavors"},
+    {"Ekadashi", "एकादशी", Planet::MARS, "Eleventh", true, "Fasting, spirituality"},
+    {"Dwadashi", "द्वादशी", Planet::MERCURY, "Twelfth", true, "Communication, travel"},
+    {"Trayodashi", "त्रयोदशी", Planet::JUPITER, "Thirteenth", true, "Learning, teaching"},
+    {"Chaturdashi", "चतुर्दशी", Planet::VENUS, "Fourteenth", true, "Devotion, prayers"},
+    {"Purnima", "पूर्णिमा", Planet::SATURN, "Full Moon", true, "Completion, fulfillment"},
+    // Krishna Paksha
+    {"Pratipad K", "प्रतिपदा कृष्ण", Planet::SUN, "Beginning Dark", false, "New challenges"},
+    {"Dwitiya K", "द्वितीया कृष्ण", Planet::MOON, "Second Dark", false, "Letting go"},
+    {"Tritiya K", "तृतीया कृष्ण", Planet::MARS, "Third Dark", false, "Inner strength"},
+    {"Chaturthi K", "चतुर्थी कृष्ण", Planet::MERCURY, "Fourth Dark", false, "Mental clarity"},
+    {"Panchami K", "पंचमी कृष्ण", Planet::JUPITER, "Fifth Dark", false, "Wisdom through trials"},
+    {"Shashthi K", "षष्ठी कृष्ण", Planet::VENUS, "Sixth Dark", false, "Purification"},
+    {"Saptami K", "सप्तमी कृष्ण", Planet::SATURN, "Seventh Dark", false, "Patience"},
+    {"Ashtami K", "अष्टमी कृष्ण", Planet::NORTH_NODE, "Eighth Dark", false, "Power struggles"},
+    {"Navami K", "नवमी कृष्ण", Planet::SUN, "Ninth Dark", false, "Spiritual completion"},
+    {"Dashami K", "दशमी कृष्ण", Planet::MOON, "Tenth Dark", false, "Emotional release"},
+    {"Ekadashi K", "एकादशी कृष्ण", Planet::MARS, "Eleventh Dark", false, "Deep fasting"},
+    {"Dwadashi K", "द्वादशी कृष्ण", Planet::MERCURY, "Twelfth Dark", false, "Mental preparation"},
+    {"Trayodashi K", "त्रयोदशी कृष्ण", Planet::JUPITER, "Thirteenth Dark", false, "Final learning"},
+    {"Chaturdashi K", "चतुर्दशी कृष्ण", Planet::VENUS, "Fourteenth Dark", false, "Last prayers"},
+    {"Amavasya", "अमावस्या", Planet::SATURN, "New Moon", false, "Rebirth, renewal"}
+};
+
+const HinduCalendar::YogaInfo HinduCalendar::YOGA_DATA[27] = {
+    {"Vishkumbha", "विष्कम्भ", "Inauspicious", "Obstacles"},
+    {"Priti", "प्रीति", "Auspicious", "Love, affection"},
+    {"Ayushman", "आयुष्मान्", "Very Auspicious", "Longevity"},
+    {"Saubhagya", "सौभाग्य", "Auspicious", "Good fortune"},
+    {"Shobhana", "शोभन", "Very Auspicious", "Beauty, prosperity"},
+    {"Atiganda", "अतिगण्ड", "Inauspicious", "Great obstacles"},
+    {"Sukarman", "सुकर्म", "Auspicious", "Good deeds"},
+    {"Dhriti", "धृति", "Auspicious", "Steadfastness"},
+    {"Shula", "शूल", "Very Inauspicious", "Pain, suffering"},
+    {"Ganda", "गण्ड", "Inauspicious", "Obstacles"},
+    {"Vriddhi", "वृद्धि", "Auspicious", "Growth, increase"},
+    {"Dhruva", "ध्रुव", "Very Auspicious", "Stability"},
+    {"Vyaghata", "व्याघात", "Inauspicious", "Accidents"},
+    {"Harshana", "हर्षण", "Auspicious", "Joy, happiness"},
+    {"Vajra", "वज्र", "Inauspicious", "Hard like diamond"},
+    {"Siddhi", "सिद्धि", "Very Auspicious", "Success, achievement"},
+    {"Vyatipata", "व्यतीपात", "Very Inauspicious", "Calamity"},
+    {"Variyan", "वरीयान्", "Auspicious", "Excellent"},
+    {"Parigha", "परिघ", "Inauspicious", "Iron club"},
+    {"Shiva", "शिव", "Very Auspicious", "Auspicious"},
+    {"Siddha", "सिद्ध", "Very Auspicious", "Accomplished"},
+    {"Sadhya", "साध्य", "Auspicious", "Achievable"},
+    {"Shubha", "शुभ", "Very Auspicious", "Auspicious"},
+    {"Shukla", "शुक्ल", "Auspicious", "Bright, pure"},
+    {"Brahma", "ब्रह्म", "Very Auspicious", "Sacred"},
+    {"Indra", "इन्द्र", "Auspicious", "Powerful"},
+    {"Vaidhriti", "वैधृति", "Very Inauspicious", "Separation"}
+};
+
+const HinduCalendar::KaranaInfo HinduCalendar::KARANA_DATA[11] = {
+    {"Bava", "बव", "Movable", true},
+    {"Balava", "बालव", "Movable", true},
+    {"Kaulava", "कौलव", "Movable", true},
+    {"Taitila", "तैतिल", "Movable", true},
+    {"Gara", "गर", "Movable", true},
+    {"Vanija", "वाणिज", "Movable", true},
+    {"Vishti", "विष्टि", "Movable", true},
+    {"Shakuni", "शकुनि", "Fixed", false},
+    {"Chatushpada", "चतुष्पद", "Fixed", false},
+    {"Naga", "नाग", "Fixed", false},
+    {"Kimstughna", "किंस्तुघ्न", "Fixed", false}
+};
 
-void HinduCalendar::initializeTithiData() {
-    tithiData = {
-        {"Pratipad", "प्रतिपदा", Planet::SUN, "Beginning", true, "New starts, worship"},
-        {"Dwitiya", "द्वितीया", Planet::MOON, "Second", true, "Growth, learning"},
-        {"Tritiya", "तृतीया", Planet::MARS, "Third", true, "Action, energy"},
-        {"Chaturthi", "चतुर्थी", Planet::MERCURY, "Fourth", true, "Intelligence, obstacles removal"},
-        {"Panchami", "पंचमी", Planet::JUPITER, "Fifth", true, "Knowledge, wisdom"},
-        {"Shashthi", "षष्ठी", Planet::VENUS, "Sixth", true, "Love, beauty, comfort"},
-        {"Saptami", "सप्तमी", Planet::SATURN, "Seventh", true, "Discipline, hard work"},
-        {"Ashtami", "अष्टमी", Planet::NORTH_NODE, "Eighth", false, "Obstacles, power"},
-        {"Navami", "नवमी", Planet::SUN, "Ninth", true, "Completion of tasks"},
-        {"Dashami", "दशमी", Planet::MOON, "Tenth", true, "Success in endeavors"},
-        {"Ekadashi", "एकादशी", Planet::MARS, "Eleventh", true, "Fasting, spirituality"},
-        {"Dwadashi", "द्वादशी", Planet::MERCURY, "Twelfth", true, "Communication, travel"},
-        {"Trayodashi", "त्रयोदशी", Planet::JUPITER, "Thirteenth", true, "Learning, teaching"},
-        {"Chaturdashi", "चतुर्दशी", Planet::VENUS, "Fourteenth", true, "Devotion, prayers"},
-        {"Purnima", "पूर्णिमा", Planet::SATURN, "Full Moon", true, "Completion, fulfillment"},
-        // Krishna Paksha
-        {"Pratipad K", "प्रतिपदा कृष्ण", Planet::SUN, "Beginning Dark", false, "New challenges"},
-        {"Dwitiya K", "द्वितीया कृष्ण", Planet::MOON, "Second Dark", false, "Letting go"},
-        {"Tritiya K", "तृतीया कृष्ण", Planet::MARS, "Third Dark", false, "Inner strength"},
-        {"Chaturthi K", "चतुर्थी कृष्ण", Planet::MERCURY, "Fourth Dark", false, "Mental clarity"},
-        {"Panchami K", "पंचमी कृष्ण", Planet::JUPITER, "Fifth Dark", false, "Wisdom through trials"},
-        {"Shashthi K", "षष्ठी कृष्ण", Planet::VENUS, "Sixth Dark", false, "Purification"},
-        {"Saptami K", "सप्तमी कृष्ण", Planet::SATURN, "Seventh Dark", false, "Patience"},
-        {"Ashtami K", "अष्टमी कृष्ण", Planet::NORTH_NODE, "Eighth Dark", false, "Power struggles"},
-        {"Navami K", "नवमी कृष्ण", Planet::SUN, "Ninth Dark", false, "Spiritual completion"},
-        {"Dashami K", "दशमी कृष्ण", Planet::MOON, "Tenth Dark", false, "Emotional release"},
-        {"Ekadashi K", "एकादशी कृष्ण", Planet::MARS, "Eleventh Dark", false, "Deep fasting"},
-        {"Dwadashi K", "द्वादशी कृष्ण", Planet::MERCURY, "Twelfth Dark", false, "Mental preparation"},
-        {"Trayodashi K", "त्रयोदशी कृष्ण", Planet::JUPITER, "Thirteenth Dark", false, "Final learning"},
-        {"Chaturdashi K", "चतुर्दशी कृष्ण", Planet::VENUS, "Fourteenth Dark", false, "Last prayers"},
-        {"Amavasya", "अमावस्या", Planet::SATURN, "New Moon", false, "Rebirth, renewal"}
+void HinduCalendar::initializeFestivalData() {
+    eventNames.clear();
+    eventIds.clear();
+    festivalRules.clear();
+    internEventName("");  // Id 0 means "no event"
+
+    auto addTithi = [this](HinduMonth month, int tithi, std::initializer_list<const char*> names) {
+        for (const char* name : names) {
+            festivalRules.push_back({FestivalRule::Kind::TITHI, static_cast<int>(month), tithi, 0, 0,
+                                     internEventName(name)});
+        }
     };
-}
-
-void HinduCalendar::initializeYogaData() {
-    yogaData = {
-        {"Vishkumbha", "विष्कम्भ", "Inauspicious", "Obstacles"},
-        {"Priti", "प्रीति", "Auspicious", "Love, affection"},
-        {"Ayushman", "आयुष्मान्", "Very Auspicious", "Longevity"},
-        {"Saubhagya", "सौभाग्य", "Auspicious", "Good fortune"},
-        {"Shobhana", "शोभन", "Very Auspicious", "Beauty, prosperity"},
-        {"Atiganda", "अतिगण्ड", "Inauspicious", "Great obstacles"},
-        {"Sukarman", "सुकर्म", "Auspicious", "Good deeds"},
-        {"Dhriti", "धृति", "Auspicious", "Steadfastness"},
-        {"Shula", "शूल", "Very Inauspicious", "Pain, suffering"},
-        {"Ganda", "गण्ड", "Inauspicious", "Obstacles"},
-        {"Vriddhi", "वृद्धि", "Auspicious", "Growth, increase"},
-        {"Dhruva", "ध्रुव", "Very Auspicious", "Stability"},
-        {"Vyaghata", "व्याघात", "Inauspicious", "Accidents"},
-        {"Harshana", "हर्षण", "Auspicious", "Joy, happiness"},
-        {"Vajra", "वज्र", "Inauspicious", "Hard like diamond"},
-        {"Siddhi", "सिद्धि", "Very Auspicious", "Success, achievement"},
-        {"Vyatipata", "व्यतीपात", "Very Inauspicious", "Calamity"},
-        {"Variyan", "वरीयान्", "Auspicious", "Excellent"},
-        {"Parigha", "परिघ", "Inauspicious", "Iron club"},
-        {"Shiva", "शिव", "Very Auspicious", "Auspicious"},
-        {"Siddha", "सिद्ध", "Very Auspicious", "Accomplished"},
-        {"Sadhya", "साध्य", "Auspicious", "Achievable"},
-        {"Shubha", "शुभ", "Very Auspicious", "Auspicious"},
-        {"Shukla", "शुक्ल", "Auspicious", "Bright, pure"},
-        {"Brahma", "ब्रह्म", "Very Auspicious", "Sacred"},
-        {"Indra", "इन्द्र", "Auspicious", "Powerful"},
-        {"Vaidhriti", "वैधृति", "Very Inauspicious", "Separation"}
+    auto addSankranti = [this](Rashi rashi, std::initializer_list<const char*> names) {
+        for (const char* name : names) {
+            festivalRules.push_back({FestivalRule::Kind::SANKRANTI, 0, 0, static_cast<int>(rashi), 0,
+                                     internEventName(name)});
+        }
     };
-}
-
-void HinduCalendar::initializeKaranaData() {
-    karanaData = {
-        {"Bava", "बव", "Movable", true},
-        {"Balava", "बालव", "Movable", true},
-        {"Kaulava", "कौलव", "Movable", true},
-        {"Taitila", "तैतिल", "Movable", true},
-        {"Gara", "गर", "Movable", true},
-        {"Vanija", "वाणिज", "Movable", true},
-        {"Vishti", "विष्टि", "Movable", true},
-        {"Shakuni", "शकुनि", "Fixed", false},
-        {"Chatushpada", "चतुष्पद", "Fixed", false},
-        {"Naga", "नाग", "Fixed", false},
-        {"Kimstughna", "किंस्तुघ्न", "Fixed", false}
+    auto addNakshatra = [this](HinduMonth month, HinduNakshatra nakshatra, std::initializer_list<const char*> names) {
+        for (const char* name : names) {
+            festivalRules.push_back({FestivalRule::Kind::NAKSHATRA, static_cast<int>(month), 0,
+                                     0, static_cast<int>(nakshatra), internEventName(name)});
+        }
     };
-}
 
-void HinduCalendar::initializeFestivalData() {
+    const int PURNIMA = static_cast<int>(Tithi::PURNIMA);
+    const int AMAVASYA = static_cast<int>(Tithi::AMAVASYA);
+    const int EKADASHI_S = static_cast<int>(Tithi::EKADASHI);
+    const int EKADASHI_K = static_cast<int>(Tithi::EKADASHI_K);
+
     // Major Hindu festivals mapped to Tithi and month
-    festivalMap["Chaitra_Purnima"] = {"Hanuman Jayanti", "Chaitanya Mahaprabhu Jayanti"};
-    festivalMap["Vaishakha_Purnima"] = {"Buddha Purnima", "Kurma Jayanti"};
-    festivalMap["Jyeshtha_Purnima"] = {"Vat Purnima", "Savitri Vrata"};
-    festivalMap["Ashadha_Purnima"] = {"Guru Purnima", "Vyasa Purnima"};
-    festivalMap["Shravana_Purnima"] = {"Raksha Bandhan", "Hayagriva Jayanti"};
-    festivalMap["Bhadrapada_Purnima"] = {"Madhu Purnima"};
-    festivalMap["Ashwini_Purnima"] = {"Sharad Purnima", "Kojagari Purnima"};
-    festivalMap["Kartika_Purnima"] = {"Kartika Purnima", "Dev Diwali"};
-    festivalMap["Margashirsha_Purnima"] = {"Dattatreya Jayanti"};
-    festivalMap["Pausha_Purnima"] = {"Shakambhari Purnima"};
-    festivalMap["Magha_Purnima"] = {"Maghi Purnima"};
-    festivalMap["Phalguna_Purnima"] = {"Holi", "Holika Dahan"};
+    addTithi(HinduMonth::CHAITRA, PURNIMA, {"Hanuman Jayanti", "Chaitanya Mahaprabhu Jayanti"});
+    addTithi(HinduMonth::VAISHAKHA, PURNIMA, {"Buddha Purnima", "Kurma Jayanti"});
+    addTithi(HinduMonth::JYESHTHA, PURNIMA, {"Vat Purnima", "Savitri Vrata"});
+    addTithi(HinduMonth::ASHADHA, PURNIMA, {"Guru Purnima", "Vyasa Purnima"});
+    addTithi(HinduMonth::SHRAVANA, PURNIMA, {"Raksha Bandhan", "Hayagriva Jayanti"});
+    addTithi(HinduMonth::BHADRAPADA, PURNIMA, {"Madhu Purnima"});
+    addTithi(HinduMonth::ASHWINI_MONTH, PURNIMA, {"Sharad Purnima", "Kojagari Purnima"});
+    addTithi(HinduMonth::KARTIKA, PURNIMA, {"Kartika Purnima", "Dev Diwali"});
+    addTithi(HinduMonth::MARGASHIRSHA, PURNIMA, {"Dattatreya Jayanti"});
+    addTithi(HinduMonth::PAUSHA, PURNIMA, {"Shakambhari Purnima"});
+    addTithi(HinduMonth::MAGHA, PURNIMA, {"Maghi Purnima"});
+    addTithi(HinduMonth::PHALGUNA, PURNIMA, {"Holi", "Holika Dahan"});
 
     // Ekadashi festivals - detailed list
-    festivalMap["Chaitra_Ekadashi_S"] = {"Kamada Ekadashi"};
-    festivalMap["Chaitra_Ekadashi_K"] = {"Papmochani Ekadashi"};
-    festivalMap["Vaishakha_Ekadashi_S"] = {"Varuthini Ekadashi"};
-    festivalMap["Vaishakha_Ekadashi_K"] = {"Mohini Ekadashi"};
-    festivalMap["Jyeshtha_Ekadashi_S"] = {"Apara Ekadashi"};
-    festivalMap["Jyeshtha_Ekadashi_K"] = {"Nirjala Ekadashi"};
-    festivalMap["Ashadha_Ekadashi_S"] = {"Yogini Ekadashi"};
-    festivalMap["Ashadha_Ekadashi_K"] = {"Kamika Ekadashi"};
-    festivalMap["Shravana_Ekadashi_S"] = {"Putrada Ekadashi"};
-    festivalMap["Shravana_Ekadashi_K"] = {"Aja Ekadashi"};
-    festivalMap["Bhadrapada_Ekadashi_S"] = {"Parsva Ekadashi"};
-    festivalMap["Bhadrapada_Ekadashi_K"] = {"Indira Ekadashi"};
-    festivalMap["Ashwini_Ekadashi_S"] = {"Papankusha Ekadashi"};
-    festivalMap["Ashwini_Ekadashi_K"] = {"Rama Ekadashi"};
-    festivalMap["Kartika_Ekadashi_S"] = {"Devuthani Ekadashi", "Prabodhini Ekadashi"};
-    festivalMap["Kartika_Ekadashi_K"] = {"Utpanna Ekadashi"};
-    festivalMap["Margashirsha_Ekadashi_S"] = {"Mokshada Ekadashi"};
-    festivalMap["Margashirsha_Ekadashi_K"] = {"Saphala Ekadashi"};
-    festivalMap["Pausha_Ekadashi_S"] = {"Putrada Ekadashi"};
-    festivalMap["Pausha_Ekadashi_K"] = {"Shattila Ekadashi"};
-    festivalMap["Magha_Ekadashi_S"] = {"Jaya Ekadashi"};
-    festivalMap["Magha_Ekadashi_K"] = {"Vijaya Ekadashi"};
-    festivalMap["Phalguna_Ekadashi_S"] = {"Amalaki Ekadashi"};
-    festivalMap["Phalguna_Ekadashi_K"] = {"Papamochani Ekadashi"};
+    addTithi(HinduMonth::CHAITRA, EKADASHI_S, {"Kamada Ekadashi"});
+    addTithi(HinduMonth::CHAITRA, EKADASHI_K, {"Papmochani Ekadashi"});
+    addTithi(HinduMonth::VAISHAKHA, EKADASHI_S, {"Varuthini Ekadashi"});
+    addTithi(HinduMonth::VAISHAKHA, EKADASHI_K, {"Mohini Ekadashi"});
+    addTithi(HinduMonth::JYESHTHA, EKADASHI_S, {"Apara Ekadashi"});
+    addTithi(HinduMonth::JYESHTHA, EKADASHI_K, {"Nirjala Ekadashi"});
+    addTithi(HinduMonth::ASHADHA, EKADASHI_S, {"Yogini Ekadashi"});
+    addTithi(HinduMonth::ASHADHA, EKADASHI_K, {"Kamika Ekadashi"});
+    addTithi(HinduMonth::SHRAVANA, EKADASHI_S, {"Putrada Ekadashi"});
+    addTithi(HinduMonth::SHRAVANA, EKADASHI_K, {"Aja Ekadashi"});
+    addTithi(HinduMonth::BHADRAPADA, EKADASHI_S, {"Parsva Ekadashi"});
+    addTithi(HinduMonth::BHADRAPADA, EKADASHI_K, {"Indira Ekadashi"});
+    addTithi(HinduMonth::ASHWINI_MONTH, EKADASHI_S, {"Papankusha Ekadashi"});
+    addTithi(HinduMonth::ASHWINI_MONTH, EKADASHI_K, {"Rama Ekadashi"});
+    addTithi(HinduMonth::KARTIKA, EKADASHI_S, {"Devuthani Ekadashi", "Prabodhini Ekadashi"});
+    addTithi(HinduMonth::KARTIKA, EKADASHI_K, {"Utpanna Ekadashi"});
+    addTithi(HinduMonth::MARGASHIRSHA, EKADASHI_S, {"Mokshada Ekadashi"});
+    addTithi(HinduMonth::MARGASHIRSHA, EKADASHI_K, {"Saphala Ekadashi"});
+    addTithi(HinduMonth::PAUSHA, EKADASHI_S, {"Putrada Ekadashi"});
+    addTithi(HinduMonth::PAUSHA, EKADASHI_K, {"Shattila Ekadashi"});
+    addTithi(HinduMonth::MAGHA, EKADASHI_S, {"Jaya Ekadashi"});
+    addTithi(HinduMonth::MAGHA, EKADASHI_K, {"Vijaya Ekadashi"});
+    addTithi(HinduMonth::PHALGUNA, EKADASHI_S, {"Amalaki Ekadashi"});
+    addTithi(HinduMonth::PHALGUNA, EKADASHI_K, {"Papamochani Ekadashi"});
 
     // Amavasya festivals
-    festivalMap["Chaitra_Amavasya"] = {"Chaitra Amavasya"};
-    festivalMap["Vaishakha_Amavasya"] = {"Shani Amavasya"};
-    festivalMap["Jyeshtha_Amavasya"] = {"Vat Savitri Amavasya"};
-    festivalMap["Ashadha_Amavasya"] = {"Hariyali Amavasya"};
-    festivalMap["Shravana_Amavasya"] = {"Pithori Amavasya"};
-    festivalMap["Bhadrapada_Amavasya"] = {"Pitru Amavasya", "Sarva Pitru Amavasya"};
-    festivalMap["Ashwini_Amavasya"] = {"Sharad Amavasya"};
-    festivalMap["Kartika_Amavasya"] = {"Diwali", "Kali Chaudas", "Lakshmi Puja"};
-    festivalMap["Margashirsha_Amavasya"] = {"Margashirsha Amavasya"};
-    festivalMap["Pausha_Amavasya"] = {"Pausha Amavasya"};
-    festivalMap["Magha_Amavasya"] = {"Mauni Amavasya", "Maghi Amavasya"};
-    festivalMap["Phalguna_Amavasya"] = {"Phalguna Amavasya"};
-
-    // Navratri festivals
-    festivalMap["Chaitra_Navratri"] = {"Vasant Navratri", "Chaitra Navratri"};
-    festivalMap["Ashwini_Navratri"] = {"Sharad Navratri", "Maha Navratri"};
+    addTithi(HinduMonth::CHAITRA, AMAVASYA, {"Chaitra Amavasya"});
+    addTithi(HinduMonth::VAISHAKHA, AMAVASYA, {"Shani Amavasya"});
+    addTithi(HinduMonth::JYESHTHA, AMAVASYA, {"Vat Savitri Amavasya"});
+    addTithi(HinduMonth::ASHADHA, AMAVASYA, {"Hariyali Amavasya"});
+    addTithi(HinduMonth::SHRAVANA, AMAVASYA, {"Pithori Amavasya"});
+    addTithi(HinduMonth::BHADRAPADA, AMAVASYA, {"Pitru Amavasya", "Sarva Pitru Amavasya"});
+    addTithi(HinduMonth::ASHWINI_MONTH, AMAVASYA, {"Sharad Amavasya"});
+    addTithi(HinduMonth::KARTIKA, AMAVASYA, {"Diwali", "Kali Chaudas", "Lakshmi Puja"});
+    addTithi(HinduMonth::MARGASHIRSHA, AMAVASYA, {"Margashirsha Amavasya"});
+    addTithi(HinduMonth::PAUSHA, AMAVASYA, {"Pausha Amavasya"});
+    addTithi(HinduMonth::MAGHA, AMAVASYA, {"Mauni Amavasya", "Maghi Amavasya"});
+    addTithi(HinduMonth::PHALGUNA, AMAVASYA, {"Phalguna Amavasya"});
+
+    // Special tithi festivals. Months here are solar (calculateHinduMonth), so the
+    // Krishna paksha of amanta Shravana and Magha is keyed to Shravana and Magha
+    addTithi(HinduMonth::SHRAVANA, static_cast<int>(Tithi::ASHTAMI_K), {"Krishna Janmashtami"});
+    addTithi(HinduMonth::MAGHA, static_cast<int>(Tithi::CHATURDASHI_K), {"Maha Shivratri"});
+    addTithi(HinduMonth::BHADRAPADA, static_cast<int>(Tithi::CHATURTHI), {"Ganesh Chaturthi"});
+
+    // Navratri festivals (Shukla Pratipad to Navami)
+    for (int day = 1; day <= 9; day++) {
+        addTithi(HinduMonth::CHAITRA, day, {("Chaitra Navratri - Day " + std::to_string(day)).c_str()});
+        addTithi(HinduMonth::ASHWINI_MONTH, day, {("Sharad Navratri - Day " + std::to_string(day)).c_str()});
+    }
 
     // Sankranti festivals
-    festivalMap["Mesha_Sankranti"] = {"Mesha Sankranti", "Baisakhi"};
-    festivalMap["Vrishabha_Sankranti"] = {"Vrishabha Sankranti"};
-    festivalMap["Mithuna_Sankranti"] = {"Mithuna Sankranti"};
-    festivalMap["Karka_Sankranti"] = {"Karka Sankranti", "Dakshinayana"};
-    festivalMap["Simha_Sankranti"] = {"Simha Sankranti"};
-    festivalMap["Kanya_Sankranti"] = {"Kanya Sankranti"};
-    festivalMap["Tula_Sankranti"] = {"Tula Sankranti"};
-    festivalMap["Vrishchika_Sankranti"] = {"Vrishchika Sankranti"};
-    festivalMap["Dhanu_Sankranti"] = {"Dhanu Sankranti"};
-    festivalMap["Makara_Sankranti"] = {"Makar Sankranti", "Uttarayana"};
-    festivalMap["Kumbha_Sankranti"] = {"Kumbha Sankranti"};
-    festivalMap["Meena_Sankranti"] = {"Meena Sankranti"};
-
-    // Krishna Paksha special days
-    festivalMap["Janmashtami"] = {"Krishna Janmashtami", "Gokulashtami"};
-    festivalMap["Shivratri"] = {"Maha Shivratri"};
-    festivalMap["Ganesh_Chaturthi"] = {"Ganesh Chaturthi", "Vinayaka Chavithi"};
+    addSankranti(Rashi::MESHA, {"Mesha Sankranti", "Baisakhi"});
+    addSankranti(Rashi::VRISHABHA, {"Vrishabha Sankranti"});
+    addSankranti(Rashi::MITHUNA, {"Mithuna Sankranti"});
+    addSankranti(Rashi::KARKA, {"Karka Sankranti", "Dakshinayana"});
+    addSankranti(Rashi::SIMHA, {"Simha Sankranti"});
+    addSankranti(Rashi::KANYA, {"Kanya Sankranti"});
+    addSankranti(Rashi::TULA, {"Tula Sankranti"});
+    addSankranti(Rashi::VRISHCHIKA, {"Vrishchika Sankranti"});
+    addSankranti(Rashi::DHANU, {"Dhanu Sankranti"});
+    addSankranti(Rashi::MAKARA, {"Makar Sankranti", "Uttarayana"});
+    addSankranti(Rashi::KUMBHA, {"Kumbha Sankranti"});
+    addSankranti(Rashi::MEENA, {"Meena Sankranti"});
+
+    // Nakshatra festivals in solar months
+    addNakshatra(HinduMonth::SHRAVANA, HinduNakshatra::SHRAVANA, {"Onam"});
+    addNakshatra(HinduMonth::KARTIKA, HinduNakshatra::KRITTIKA, {"Karthigai Deepam"});
+    addNakshatra(HinduMonth::PAUSHA, HinduNakshatra::PUSHYA, {"Thaipusam"});
+
+    // Names produced by the special event and vrata rules
+    builtinEvents = {};
+    builtinEvents.ekadashiVrata = internEventName("Ekadashi Vrata");
+    for (int rashi = 1; rashi <= 12; rashi++) {
+        builtinEvents.sankranti[rashi] = internEventName("Sankranti - " + getRashiName(static_cast<Rashi>(rashi)));
+    }
+    for (Yoga yoga : {Yoga::VYATIPATA, Yoga::VAIDHRITI}) {
+        builtinEvents.yoga[static_cast<int>(yoga)] = internEventName("Inauspicious Yoga: " + getYogaName(yoga));
+    }
+    for (Yoga yoga : {Yoga::SIDDHI, Yoga::SHIVA, Yoga::SIDDHA}) {
+        builtinEvents.yoga[static_cast<int>(yoga)] = internEventName("Very Auspicious Yoga: " + getYogaName(yoga));
+    }
+    builtinEvents.purnimaVrata = internEventName("Purnima Vrata");
+    builtinEvents.amavasyaVrata = internEventName("Amavasya Vrata");
+    builtinEvents.somwarVrata = internEventName("Somwar Vrata");
+    builtinEvents.mangalwarVrata = internEventName("Mangalwar Vrata");
+    builtinEvents.shaniwarVrata = internEventName("Shaniwar Vrata");
+    builtinEvents.rohiniVrata = internEventName("Rohini Vrata");
+    builtinEvents.gandaMoolShanti = internEventName("Ganda Mool Shanti");
+}
+
+FestivalId HinduCalendar::internEventName(const std::string& name) {
+    auto it = eventIds.find(name);
+    if (it != eventIds.end()) {
+        return it->second;
+    }
+    FestivalId id = static_cast<FestivalId>(eventNames.size());
+    eventNames.push_back(name);
+    eventIds.emplace(name, id);
+    return id;
+}
+
+size_t HinduCalendar::compileFestivalRules() {
+    // Rules for "every month" are expanded so a day needs one lookup per table
+    for (int month = 0; month <= 12; month++) {
+        for (auto& slot : tithiFestivals[month]) slot = {};
+        for (auto& slot : nakshatraFestivals[month]) slot = {};
+        sankrantiFestivals[month] = {};
+    }
+
+    size_t dropped = 0;
+    for (const auto& rule : festivalRules) {
+        int firstMonth = rule.month == 0 ? 1 : rule.month;
+        int lastMonth = rule.month == 0 ? 12 : rule.month;
+
+        switch (rule.kind) {
+            case FestivalRule::Kind::TITHI:
+                for (int month = firstMonth; month <= lastMonth; month++) {
+                    if (!tithiFestivals[month][rule.tithi].push(rule.name)) dropped++;
+                }
+                break;
+            case FestivalRule::Kind::SANKRANTI:
+                if (!sankrantiFestivals[rule.rashi].push(rule.name)) dropped++;
+                break;
+            case FestivalRule::Kind::NAKSHATRA:
+                for (int month = firstMonth; month <= lastMonth; month++) {
+                    if (!nakshatraFestivals[month][rule.nakshatra].push(rule.name)) dropped++;
+                }
+                break;
+        }
+    }
+    return dropped;
+}
+
+bool HinduCalendar::loadFestivalRules(const std::string& filename) {
+    if (!initialized) {
+        lastError = "Hindu Calendar must be initialized before loading festival rules";
+        return false;
+    }
+
+    std::ifstream file(filename);
+    if (!file) {
+        lastError = "Cannot open festival rule file: " + filename;
+        return false;
+    }
+
+    // A file that fails leaves no trace: names it interned are forgotten again
+    size_t previousNames = eventNames.size();
+    auto forgetNewNames = [&]() {
+        for (size_t id = previousNames; id < eventNames.size(); id++) {
+            eventIds.erase(eventNames[id]);
+        }
+        eventNames.resize(previousNames);
+    };
+
+    std::vector<FestivalRule> rules;
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        lineNumber++;
+        std::string error;
+        if (!parseFestivalRule(line, rules, error)) {
+            forgetNewNames();
+            lastError = filename + ":" + std::to_string(lineNumber) + ": " + error;
+            return false;
+        }
+    }
+
+    size_t previousCount = festivalRules.size();
+    festivalRules.insert(festivalRules.end(), rules.begin(), rules.end());
+    size_t dropped = compileFestivalRules();
+    if (dropped > 0) {
+        festivalRules.resize(previousCount);
+        forgetNewNames();
+        compileFestivalRules();
+        lastError = filename + ": " + std::to_string(dropped) + " festival name(s) exceed the limit of " +
+                    std::to_string(MAX_SLOT_FESTIVALS) + " per tithi, sankranti or nakshatra";
+        return false;
+    }
+    return true;
+}
+
+bool HinduCalendar::parseFestivalRule(const std::string& line, std::vector<FestivalRule>& rules, std::string& error) {
+    auto trim = [](const std::string& text) {
+        size_t first = text.find_first_not_of(" \t\r");
+        if (first == std::string::npos) return std::string();
+        size_t last = text.find_last_not_of(" \t\r");
+        return text.substr(first, last - first + 1);
+    };
+    auto lower = [](std::string text) {
+        std::transform(text.begin(), text.end(), text.begin(),
+                       [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return text;
+    };
+    auto split = [&trim](const std::string& text, char separator) {
+        std::vector<std::string> parts;
+        std::istringstream stream(text);
+        std::string part;
+        while (std::getline(stream, part, separator)) {
+            parts.push_back(trim(part));
+        }
+        return parts;
+    };
+
+    std::string content = trim(line);
+    if (content.empty() || content[0] == '#') {
+        return true;
+    }
+
+    std::vector<std::string> fields = split(content, '|');
+    std::string kind = lower(fields[0]);
+
+    // Match a name against an enum's display names (case-insensitive, English suffix optional)
+    auto findByName = [&lower](const std::string& text, int first, int last,
+                               const std::function<std::string(int)>& nameOf) {
+        std::string wanted = lower(text);
+        for (int value = first; value <= last; value++) {
+            std::string name = lower(nameOf(value));
+            if (name == wanted || name.substr(0, name.find(' ')) == wanted) {
+                return value;
+            }
+        }
+        return 0;
+    };
+    auto parseMonth = [&](const std::string& text) {
+        if (text == "*") return 0;
+        int month = findByName(text, 1, 12, [this](int m) { return getHinduMonthName(static_cast<HinduMonth>(m)); });
+        return month == 0 ? -1 : month;
+    };
+
+    FestivalRule rule = {};
+    size_t namesField = 0;
+
+    if (kind == "tithi" && fields.size() == 5) {
+        rule.kind = FestivalRule::Kind::TITHI;
+        rule.month = parseMonth(fields[1]);
+        std::string paksha = lower(fields[2]);
+        int day = std::atoi(fields[3].c_str());
+        if (rule.month < 0) { error = "unknown month '" + fields[1] + "'"; return false; }
+        if (day < 1 || day > 15) { error = "tithi must be 1-15"; return false; }
+        if (paksha == "shukla" || paksha == "s") {
+            rule.tithi = day;
+        } else if (paksha == "krishna" || paksha == "k") {
+            rule.tithi = day + 15;
+        } else {
+            error = "paksha must be Shukla or Krishna";
+            return false;
+        }
+        namesField = 4;
+    } else if (kind == "sankranti" && fields.size() == 3) {
+        rule.kind = FestivalRule::Kind::SANKRANTI;
+        rule.rashi = findByName(fields[1], 1, 12, [this](int r) { return getRashiName(static_cast<Rashi>(r)); });
+        if (rule.rashi == 0) { error = "unknown rashi '" + fields[1] + "'"; return false; }
+        namesField = 2;
+    } else if (kind == "nakshatra" && fields.size() == 4) {
+        rule.kind = FestivalRule::Kind::NAKSHATRA;
+        rule.month = parseMonth(fields[1]);
+        rule.nakshatra = findByName(fields[2], 1, 27,
+                                    [this](int n) { return getNakshatraName(static_cast<HinduNakshatra>(n)); });
+        if (rule.month < 0) { error = "unknown month '" + fields[1] + "'"; return false; }
+        if (rule.nakshatra == 0) { error = "unknown nakshatra '" + fields[2] + "'"; return false; }
+        namesField = 3;
+    } else {
+        error = "expected 'tithi | month | paksha | day | names', 'sankranti | rashi | names' "
+                "or 'nakshatra | month | nakshatra | names'";
+        return false;
+    }
+
+    bool added = false;
+    for (const auto& name : split(fields[namesField], ';')) {
+        if (name.empty()) continue;
+        rule.name = internEventName(name);
+        rules.push_back(rule);
+        added = true;
+    }
+    if (!added) {
+        error = "no festival name given";
+        return false;
+    }
+    return true;
 }
 
 PanchangaData HinduCalendar::calculatePanchanga(const BirthData& birthData) const {
@@ -263,114 +628,399 @@ PanchangaData HinduCalendar::calculatePanchanga(const BirthData& birthData) cons
 }
 
 PanchangaData HinduCalendar::calculatePanchanga(double julianDay, double latitude, double longitude) const {
+    PanchangaRecord record = {};
+    if (!calculatePanchangaRecord(julianDay, latitude, longitude, record)) {
+        PanchangaData empty = {};
+        return empty;
+    }
+    return toPanchangaData(record);
+}
+
+bool HinduCalendar::calculatePanchangaRecord(double julianDay, double latitude, double longitude,
+                                             PanchangaRecord& record) const {
+    record = {};
+
+    if (!initialized) {
+        return false;
+    }
+
+    try {
+        if (!calculateInstantElements(julianDay, record)) {
+            record = {};
+            return false;
+        }
+        // Rise/set search starts half a day before the panchanga instant
+        calculateLocationElements(record, riseSetCalculator.calculate(julianDay - 0.5, latitude, longitude));
+
+    } catch (const std::exception& e) {
+        lastError = "Error calculating Panchanga: " + std::string(e.what());
+    }
+
+    return true;
+}
+
+bool HinduCalendar::calculatePanchangaRecord(double julianDay, double latitude, double longitude,
+                                             double sunLongitude, double sunSpeed,
+                                             double moonLongitude, double moonSpeed,
+                                             PanchangaRecord& record) const {
+    record = {};
+
+    if (!initialized) {
+        return false;
+    }
+
+    try {
+        calculateInstantElements(julianDay, sunLongitude, sunSpeed, moonLongitude, moonSpeed, record);
+        calculateLocationElements(record, riseSetCalculator.calculate(julianDay - 0.5, latitude, longitude));
+
+    } catch (const std::exception& e) {
+        lastError = "Error calculating Panchanga: " + std::string(e.what());
+    }
+
+    return true;
+}
+
+int HinduCalendar::forEachPanchangaRecord(double julianDay, int days, double latitude, double longitude,
+                                          const std::function<bool(const PanchangaRecord&)>& visitor) const {
+    if (!initialized) {
+        return 0;
+    }
+
+    int produced = 0;
+    RiseSetTimes previousTimes;
+    PanchangaRecord record;
+
+    for (int i = 0; i < days; i++) {
+        double jd = julianDay + i;
+        record = {};
+        if (!calculateInstantElements(jd, record)) {
+            break;
+        }
+
+        // Uncached solve seeded by the previous day keeps the loop allocation-free
+        RiseSetTimes times = riseSetCalculator.solve(jd - 0.5, latitude, longitude,
+                                                     produced > 0 ? &previousTimes : nullptr);
+        calculateLocationElements(record, times);
+        previousTimes = times;
+        produced++;
+
+        if (!visitor(record)) {
+            break;
+        }
+    }
+
+    return produced;
+}
+
+bool HinduCalendar::calculateInstantElements(double julianDay, PanchangaRecord& record) const {
+    // Calculate planetary positions for the given JD
+    double sunPos[6], moonPos[6];
+    char errorString[256];
+
+    // Get Sun position
+    int result = SwissEphemeris::calc(julianDay, SE_SUN, SEFLG_SIDEREAL | SEFLG_SPEED, sunPos, errorString);
+    if (result < 0) {
+        lastError = "Failed to calculate Sun position: " + std::string(errorString);
+        return false;
+    }
+
+    // Get Moon position
+    result = SwissEphemeris::calc(julianDay, SE_MOON, SEFLG_SIDEREAL | SEFLG_SPEED, moonPos, errorString);
+    if (result < 0) {
+        lastError = "Failed to calculate Moon position: " + std::string(errorString);
+        return false;
+    }
+
+    return calculateInstantElements(julianDay, sunPos[0], sunPos[3], moonPos[0], moonPos[3], record);
+}
+
+bool HinduCalendar::calculateInstantElements(double julianDay, double sunLongitude, double sunSpeed,
+                                             double moonLongitude, double moonSpeed,
+                                             PanchangaRecord& record) const {
+    ASTRO_PROFILE_SCOPE("HinduCalendar::calculateInstantElements");
+    // Calculate lunar phase
+    double lunarPhase = calculateLunarPhase(sunLongitude, moonLongitude);
+    record.lunarPhase = lunarPhase;
+    record.sunLongitude = sunLongitude;
+    record.moonLongitude = moonLongitude;
+
+    // Calculate the five main elements
+    record.tithi = calculateTithi(lunarPhase);
+    record.vara = calculateVara(julianDay);
+    record.nakshatra = calculateNakshatra(moonLongitude);
+    record.yoga = calculateYoga(sunLongitude, moonLongitude);
+    record.karana = calculateKarana(lunarPhase, true); // Assume first half for now
+
+    // Calculate zodiac signs
+    record.sunRashi = calculateRashi(sunLongitude);
+    record.moonRashi = calculateRashi(moonLongitude);
+
+    // Calculate Hindu month and year
+    record.month = calculateHinduMonth(sunLongitude);
+    record.year = calculateVikramYear(julianDay);
+
+    // Determine paksha (fortnight); Hindu day runs 1-15 in each paksha
+    int tithiNum = static_cast<int>(record.tithi);
+    if (tithiNum <= 15) {
+        record.set(PanchangaRecord::SHUKLA);
+        record.day = static_cast<int8_t>(tithiNum);
+    } else {
+        record.day = static_cast<int8_t>(tithiNum - 15);
+    }
+
+    // Calculate end times
+    record.tithiEndTime = calculateTithiEndTime(lunarPhase, sunSpeed, moonSpeed);
+    record.nakshatraEndTime = calculateNakshatraEndTime(moonLongitude, moonSpeed);
+    record.yogaEndTime = calculateYogaEndTime(sunLongitude, moonLongitude, sunSpeed, moonSpeed);
+    record.karanaEndTime = calculateKaranaEndTime(lunarPhase, sunSpeed, moonSpeed);
+
+    record.julianDay = julianDay;
+
+    // Special day identification
+    if (record.tithi == Tithi::EKADASHI || record.tithi == Tithi::EKADASHI_K) record.set(PanchangaRecord::EKADASHI);
+    if (record.tithi == Tithi::PURNIMA) record.set(PanchangaRecord::PURNIMA);
+    if (record.tithi == Tithi::AMAVASYA) record.set(PanchangaRecord::AMAVASYA);
+
+    // Identify special events first: Sankranti festivals depend on them
+    identifySpecialEvents(record);
+    identifyFestivals(record);
+
+    calculateSpecialYogas(record);
+    calculateNakshatraPada(record);
+    calculateRituAyana(record);
+    calculateShoolDirections(record);
+    calculateVarnaInformation(record);  // Calculate Savarna days
+    identifyVrataUpavas(record);
+
+    // Set additional astronomical data
+    record.ayanamsaValue = getAyanamsaValue(julianDay);
+    record.kaliyugaYear = calculateKaliYear(julianDay);
+    record.shakaYear = calculateShakaYear(julianDay);
+
+    // Calculate muhurta
+    calculateMuhurta(record);
+
+    return true;
+}
+
+void HinduCalendar::calculateLocationElements(PanchangaRecord& record, const RiseSetTimes& times) const {
+    ASTRO_PROFILE_SCOPE("HinduCalendar::calculateLocationElements");
+    calculateSunMoonTimes(record, times);
+    calculateRahuKaal(record);
+    calculateYamaganda(record);
+    calculateGulikai(record);
+    calculateDurMuhurtam(record);
+    calculateVarjyam(record);
+}
+
+PanchangaData HinduCalendar::toPanchangaData(const PanchangaRecord& record) const {
+    ASTRO_PROFILE_SCOPE("HinduCalendar::toPanchangaData");
     PanchangaData panchanga = {};
 
+    panchanga.tithi = record.tithi;
+    panchanga.vara = record.vara;
+    panchanga.nakshatra = record.nakshatra;
+    panchanga.yoga = record.yoga;
+    panchanga.karana = record.karana;
+
+    panchanga.month = record.month;
+    panchanga.day = record.day;
+    panchanga.year = record.year;
+    panchanga.isShukla = record.has(PanchangaRecord::SHUKLA);
+    panchanga.isKrishna = !panchanga.isShukla;
+
+    panchanga.tithiEndTime = record.tithiEndTime;
+    panchanga.nakshatraEndTime = record.nakshatraEndTime;
+    panchanga.yogaEndTime = record.yogaEndTime;
+    panchanga.karanaEndTime = record.karanaEndTime;
+
+    panchanga.sunRashi = record.sunRashi;
+    panchanga.sunLongitude = record.sunLongitude;
+    panchanga.moonRashi = record.moonRashi;
+    panchanga.moonLongitude = record.moonLongitude;
+    panchanga.lunarPhase = record.lunarPhase;
+
+    panchanga.sunriseTime = record.sunriseTime;
+    panchanga.sunsetTime = record.sunsetTime;
+    panchanga.moonriseTime = record.moonriseTime;
+    panchanga.moonsetTime = record.moonsetTime;
+    panchanga.dayLength = record.dayLength;
+    panchanga.nightLength = record.nightLength;
+
+    panchanga.brahmaMuhurtaStart = record.brahmaMuhurtaStart;
+    panchanga.brahmaMuhurtaEnd = record.brahmaMuhurtaEnd;
+    panchanga.abhijitStart = record.abhijitStart;
+    panchanga.abhijitEnd = record.abhijitEnd;
+    panchanga.godhuliBelStart = record.godhuliBelStart;
+    panchanga.godhuliBelEnd = record.godhuliBelEnd;
+    panchanga.nishitaMuhurtaStart = record.nishitaMuhurtaStart;
+    panchanga.nishitaMuhurtaEnd = record.nishitaMuhurtaEnd;
+    panchanga.rahuKaalStart = record.rahuKaalStart;
+    panchanga.rahuKaalEnd = record.rahuKaalEnd;
+    panchanga.yamagandaStart = record.yamagandaStart;
+    panchanga.yamagandaEnd = record.yamagandaEnd;
+    panchanga.gulikaiStart = record.gulikaiStart;
+    panchanga.gulikaiEnd = record.gulikaiEnd;
+    panchanga.durMuhurtamStart = record.durMuhurtamStart;
+    panchanga.durMuhurtamEnd = record.durMuhurtamEnd;
+
+    for (size_t i = 0; i < PanchangaRecord::VARJYAM_PERIODS; i++) {
+        panchanga.varjyamTimes.push_back({record.varjyamStart[i], record.varjyamEnd[i]});
+    }
+
+    panchanga.ayanamsaValue = record.ayanamsaValue;
+    panchanga.julianDay = record.julianDay;
+    panchanga.kaliyugaYear = record.kaliyugaYear;
+    panchanga.shakaYear = record.shakaYear;
+    panchanga.vikramYear = record.year;
+
+    panchanga.ritu = getRituName(record.ritu);
+    panchanga.ayana = getAyanaName(record.ayana);
+    panchanga.dishaShool = getDirectionName(record.dishaShool);
+    panchanga.nakshatraShool = getDirectionName(record.nakshatraShool);
+    panchanga.varnaDay = getVarnaName(record.varnaDay);
+    panchanga.varnaTithi = getVarnaName(record.varnaTithi);
+    panchanga.varnaNakshatra = getVarnaName(record.varnaNakshatra);
+
+    panchanga.nakshatraPada = record.nakshatraPada;
+    panchanga.nakshatraPadaEndTime = record.nakshatraPadaEndTime;
+
+    calculateChandraTaraBalam(panchanga);
+
+    for (FestivalId id : record.festivals) panchanga.festivals.push_back(getEventName(id));
+    for (FestivalId id : record.specialEvents) panchanga.specialEvents.push_back(getEventName(id));
+    for (FestivalId id : record.ekadashiNames) panchanga.ekadashiNames.push_back(getEventName(id));
+    for (FestivalId id : record.vrataList) panchanga.vrataList.push_back(getEventName(id));
+
+    panchanga.isEkadashi = record.has(PanchangaRecord::EKADASHI);
+    panchanga.isPurnima = record.has(PanchangaRecord::PURNIMA);
+    panchanga.isAmavasya = record.has(PanchangaRecord::AMAVASYA);
+    panchanga.isSankranti = record.has(PanchangaRecord::SANKRANTI);
+    panchanga.isNavratri = record.has(PanchangaRecord::NAVRATRI);
+    panchanga.isGandaMool = record.has(PanchangaRecord::GANDA_MOOL);
+    panchanga.isPanchak = record.has(PanchangaRecord::PANCHAK);
+    panchanga.isBhadra = record.has(PanchangaRecord::BHADRA);
+
+    panchanga.isSarvarthaSiddhi = record.has(PanchangaRecord::SARVARTHA_SIDDHI);
+    panchanga.isAmritaSiddhi = record.has(PanchangaRecord::AMRITA_SIDDHI);
+    panchanga.isDwipushkar = record.has(PanchangaRecord::DWIPUSHKAR);
+    panchanga.isTripushkar = record.has(PanchangaRecord::TRIPUSHKAR);
+    panchanga.isRaviPushya = record.has(PanchangaRecord::RAVI_PUSHYA);
+    panchanga.isGuruPushya = record.has(PanchangaRecord::GURU_PUSHYA);
+
+    panchanga.isShubhaMuhurta = record.has(PanchangaRecord::SHUBHA_MUHURTA);
+    panchanga.isAshubhaMuhurta = !panchanga.isShubhaMuhurta;
+    panchanga.muhurtaDescription = panchanga.isShubhaMuhurta ? SHUBHA_MUHURTA_DESCRIPTION
+                                                             : ASHUBHA_MUHURTA_DESCRIPTION;
+
+    panchanga.isFastingDay = record.has(PanchangaRecord::FASTING_DAY);
+
+    return panchanga;
+}
+
+MultiLocationPanchanga HinduCalendar::calculatePanchangaMultiLocation(double julianDay,
+                                                                     const std::vector<double>& latitudes,
+                                                                     const std::vector<double>& longitudes) const {
+    MultiLocationPanchanga result;
+
     if (!initialized) {
-        return panchanga;
+        return result;
+    }
+    if (latitudes.size() != longitudes.size()) {
+        lastError = "Latitude and longitude lists differ in length";
+        return result;
     }
 
     try {
-        // Calculate planetary positions for the given JD
-        double sunPos[6], moonPos[6];
-        char errorString[256];
-
-        // Get Sun position
-        int result = swe_calc(julianDay, SE_SUN, SEFLG_SIDEREAL | SEFLG_SPEED, sunPos, errorString);
-        if (result < 0) {
-            lastError = "Failed to calculate Sun position: " + std::string(errorString);
-            return panchanga;
+        PanchangaRecord common = {};
+        if (!calculateInstantElements(julianDay, common)) {
+            return result;
         }
 
-        // Get Moon position
-        result = swe_calc(julianDay, SE_MOON, SEFLG_SIDEREAL | SEFLG_SPEED, moonPos, errorString);
-        if (result < 0) {
-            lastError = "Failed to calculate Moon position: " + std::string(errorString);
-            return panchanga;
+        // Varjyam only depends on the nakshatra; keep its periods relative to sunrise
+        calculateVarjyam(common);
+        result.common = toPanchangaData(common);
+
+        const size_t count = latitudes.size();
+        result.resize(count);
+        result.latitudes = latitudes;
+        result.longitudes = longitudes;
+
+        // Sun and Moon are sampled once for all locations
+        std::vector<RiseSetTimes> riseSet =
+            riseSetCalculator.calculateMultiLocation(julianDay - 0.5, latitudes, longitudes);
+        for (size_t i = 0; i < count; i++) {
+            result.sunriseTime[i] = riseSetToHours(riseSet[i].sunrise, 6.0);
+            result.sunsetTime[i] = riseSetToHours(riseSet[i].sunset, 18.0);
+            result.moonriseTime[i] = riseSetToHours(riseSet[i].moonrise, 7.0);
+            result.moonsetTime[i] = riseSetToHours(riseSet[i].moonset, 19.0);
         }
 
-        double sunLongitude = sunPos[0];
-        double moonLongitude = moonPos[0];
-        double sunSpeed = sunPos[3];
-        double moonSpeed = moonPos[3];
-
-        // Calculate lunar phase
-        double lunarPhase = calculateLunarPhase(sunLongitude, moonLongitude);
-        panchanga.lunarPhase = lunarPhase;
-        panchanga.sunLongitude = sunLongitude;
-        panchanga.moonLongitude = moonLongitude;
-
-        // Calculate the five main elements
-        panchanga.tithi = calculateTithi(lunarPhase);
-        panchanga.vara = calculateVara(julianDay);
-        panchanga.nakshatra = calculateNakshatra(moonLongitude);
-        panchanga.yoga = calculateYoga(sunLongitude, moonLongitude);
-        panchanga.karana = calculateKarana(lunarPhase, true); // Assume first half for now
-
-        // Calculate zodiac signs
-        panchanga.sunRashi = calculateRashi(sunLongitude);
-        panchanga.moonRashi = calculateRashi(moonLongitude);
-
-        // Calculate Hindu month and year
-        panchanga.month = calculateHinduMonth(sunLongitude);
-        panchanga.year = calculateVikramYear(julianDay);
-
-        // Determine paksha (fortnight)
-        panchanga.isShukla = (static_cast<int>(panchanga.tithi) <= 15);
-        panchanga.isKrishna = !panchanga.isShukla;
-
-        // Calculate Hindu day based on tithi
-        int tithiNum = static_cast<int>(panchanga.tithi);
-        if (panchanga.isShukla) {
-            panchanga.day = tithiNum; // Shukla paksha: 1-15
-        } else {
-            panchanga.day = tithiNum - 15; // Krishna paksha: 1-15 (tithi 16-30 becomes day 1-15)
+        // Everything else is simple arithmetic on the arrays
+        const double* sunrise = result.sunriseTime.data();
+        const double* sunset = result.sunsetTime.data();
+        double* dayLength = result.dayLength.data();
+        double* nightLength = result.nightLength.data();
+
+        for (size_t i = 0; i < count; i++) {
+            double length = sunset[i] - sunrise[i];
+            dayLength[i] = length < 0 ? length + 24.0 : length;
+            nightLength[i] = 24.0 - dayLength[i];
+        }
+
+        for (size_t i = 0; i < count; i++) {
+            result.brahmaMuhurtaStart[i] = calculateBrahmaMuhurta(sunrise[i], true);
+            result.brahmaMuhurtaEnd[i] = calculateBrahmaMuhurta(sunrise[i], false);
+            result.abhijitStart[i] = calculateAbhijitMuhurta(sunrise[i], sunset[i], true);
+            result.abhijitEnd[i] = calculateAbhijitMuhurta(sunrise[i], sunset[i], false);
+            result.godhuliBelStart[i] = calculateGodhuliBela(sunset[i], true);
+            result.godhuliBelEnd[i] = calculateGodhuliBela(sunset[i], false);
+            result.nishitaMuhurtaStart[i] = calculateNishitaMuhurta(sunset[i], sunrise[i] + 24.0, true);
+            result.nishitaMuhurtaEnd[i] = calculateNishitaMuhurta(sunset[i], sunrise[i] + 24.0, false);
+        }
+
+        // The weekday is shared, so each period is a fixed eighth of every location's day
+        int weekday = static_cast<int>(result.common.vara);
+        if (weekday >= 0 && weekday <= 6) {
+            double rahuPeriod = RAHU_KAAL_PERIODS[weekday] - 1;
+            double yamagandaPeriod = YAMAGANDA_PERIODS[weekday] - 1;
+            double gulikaiPeriod = GULIKAI_PERIODS[weekday] - 1;
+
+            for (size_t i = 0; i < count; i++) {
+                double dayEighth = dayLength[i] / 8.0;
+                result.rahuKaalStart[i] = sunrise[i] + rahuPeriod * dayEighth;
+                result.rahuKaalEnd[i] = result.rahuKaalStart[i] + dayEighth;
+                result.yamagandaStart[i] = sunrise[i] + yamagandaPeriod * dayEighth;
+                result.yamagandaEnd[i] = result.yamagandaStart[i] + dayEighth;
+                result.gulikaiStart[i] = sunrise[i] + gulikaiPeriod * dayEighth;
+                result.gulikaiEnd[i] = result.gulikaiStart[i] + dayEighth;
+            }
         }
 
-        // Calculate end times
-        panchanga.tithiEndTime = calculateTithiEndTime(lunarPhase, sunSpeed, moonSpeed);
-        panchanga.nakshatraEndTime = calculateNakshatraEndTime(moonLongitude, moonSpeed);
-        panchanga.yogaEndTime = calculateYogaEndTime(sunLongitude, moonLongitude, sunSpeed, moonSpeed);
-        panchanga.karanaEndTime = calculateKaranaEndTime(lunarPhase, sunSpeed, moonSpeed);
-
-        // Special day identification
-        panchanga.isEkadashi = (panchanga.tithi == Tithi::EKADASHI || panchanga.tithi == Tithi::EKADASHI_K);
-        panchanga.isPurnima = (panchanga.tithi == Tithi::PURNIMA);
-        panchanga.isAmavasya = (panchanga.tithi == Tithi::AMAVASYA);
-
-        // Identify festivals and special events
-        identifyFestivals(panchanga);
-        identifySpecialEvents(panchanga);
-
-        // Calculate enhanced timing information
-        calculateSunMoonTimes(panchanga, latitude, longitude);
-        calculateRahuKaal(panchanga);
-        calculateYamaganda(panchanga);
-        calculateGulikai(panchanga);
-        calculateDurMuhurtam(panchanga);
-        calculateVarjyam(panchanga);
-        calculateSpecialYogas(panchanga);
-        calculateNakshatraPada(panchanga);
-        calculateChandraTaraBalam(panchanga);
-        calculateRituAyana(panchanga);
-        calculateShoolDirections(panchanga);
-        calculateVarnaInformation(panchanga);  // Calculate Savarna days
-        identifyVrataUpavas(panchanga);
-
-        // Set additional astronomical data
-        panchanga.ayanamsaValue = getAyanamsaValue(julianDay);
-        panchanga.julianDay = julianDay;
-        panchanga.kaliyugaYear = calculateKaliYear(julianDay);
-        panchanga.shakaYear = calculateShakaYear(julianDay);
-        panchanga.vikramYear = calculateVikramYear(julianDay);
-
-        // Calculate muhurta
-        calculateMuhurta(panchanga);
+        for (size_t i = 0; i < count; i++) {
+            double dayCenter = sunrise[i] + dayLength[i] / 2.0;
+            result.durMuhurtamStart[i] = dayCenter - DUR_MUHURTAM_HALF_SPAN;
+            result.durMuhurtamEnd[i] = dayCenter + DUR_MUHURTAM_HALF_SPAN;
+        }
 
     } catch (const std::exception& e) {
-        lastError = "Error calculating Panchanga: " + std::string(e.what());
+        lastError = "Error calculating multi-location Panchanga: " + std::string(e.what());
     }
 
-    return panchanga;
+    return result;
+}
+
+MultiLocationPanchanga HinduCalendar::calculatePanchangaMultiLocation(double julianDay,
+                                                                     const std::vector<Location>& locations) const {
+    std::vector<double> latitudes;
+    std::vector<double> longitudes;
+    latitudes.reserve(locations.size());
+    longitudes.reserve(locations.size());
+    for (const auto& location : locations) {
+        latitudes.push_back(location.latitude);
+        longitudes.push_back(location.longitude);
+    }
+    return calculatePanchangaMultiLocation(julianDay, latitudes, longitudes);
 }
 
 double HinduCalendar::calculateLunarPhase(double sunLong, double moonLong) const {
@@ -514,7 +1164,7 @@ int HinduCalendar::calculateKaliYear(double julianDay) const {
 void HinduCalendar::setAyanamsa(AyanamsaType type) {
     ayanamsa = type;
     if (initialized) {
-        swe_set_sid_mode(getSweAyanamsaId(), 0, 0);
+        SwissEphemeris::setSiderealMode(getSweAyanamsaId());
     }
 }
 
@@ -639,320 +1289,209 @@ std::string HinduCalendar::gregorianDateToHindu(int gregYear, int gregMonth, int
     return oss.str();
 }
 
-void HinduCalendar::identifyFestivals(PanchangaData& panchanga) const {
-    // Check for major festivals based on tithi and month
-    std::string monthName = getHinduMonthName(panchanga.month);
-    panchanga.festivals.clear();
-    panchanga.ekadashiNames.clear();
+void HinduCalendar::identifyFestivals(PanchangaRecord& record) const {
+    ASTRO_PROFILE_SCOPE("HinduCalendar::identifyFestivals");
+    // Compiled rule tables: one lookup for the lunar day, one each for Sankranti and nakshatra
+    int month = static_cast<int>(record.month);
+    int tithi = static_cast<int>(record.tithi);
+    if (month < 1 || month > 12) month = 0;
+    if (tithi < 1 || tithi > 30) tithi = 0;
 
-    if (panchanga.isPurnima) {
-        std::string key = monthName + "_Purnima";
-        auto it = festivalMap.find(key);
-        if (it != festivalMap.end()) {
-            panchanga.festivals.insert(panchanga.festivals.end(), it->second.begin(), it->second.end());
-        }
-    }
+    const FestivalSlot& tithiSlot = tithiFestivals[month][tithi];
+    for (FestivalId id : tithiSlot) record.festivals.push(id);
 
-    if (panchanga.isAmavasya) {
-        std::string key = monthName + "_Amavasya";
-        auto it = festivalMap.find(key);
-        if (it != festivalMap.end()) {
-            panchanga.festivals.insert(panchanga.festivals.end(), it->second.begin(), it->second.end());
+    if (record.has(PanchangaRecord::EKADASHI)) {
+        // Festivals on an Ekadashi are that Ekadashi's names
+        for (FestivalId id : tithiSlot) record.ekadashiNames.push(id);
+        if (tithiSlot.empty()) {
+            record.festivals.push(builtinEvents.ekadashiVrata);
         }
     }
 
-    if (panchanga.isEkadashi) {
-        // Determine specific Ekadashi name based on month and paksha
-        std::string paksha = panchanga.isShukla ? "S" : "K";
-        std::string key = monthName + "_Ekadashi_" + paksha;
-        auto it = festivalMap.find(key);
-        if (it != festivalMap.end()) {
-            panchanga.ekadashiNames = it->second;
-            panchanga.festivals.insert(panchanga.festivals.end(), it->second.begin(), it->second.end());
-        } else {
-            panchanga.festivals.push_back("Ekadashi Vrata");
+    if (record.has(PanchangaRecord::SANKRANTI)) {
+        int rashi = static_cast<int>(record.sunRashi);
+        if (rashi >= 1 && rashi <= 12) {
+            for (FestivalId id : sankrantiFestivals[rashi]) record.festivals.push(id);
         }
     }
 
-    // Check for Sankranti festivals
-    if (panchanga.isSankranti) {
-        std::string rashiName = getRashiName(panchanga.sunRashi);
-        // Extract just the rashi name without the English translation
-        size_t spacePos = rashiName.find(' ');
-        if (spacePos != std::string::npos) {
-            rashiName = rashiName.substr(0, spacePos);
-        }
-        std::string key = rashiName + "_Sankranti";
-        auto it = festivalMap.find(key);
-        if (it != festivalMap.end()) {
-            panchanga.festivals.insert(panchanga.festivals.end(), it->second.begin(), it->second.end());
-        }
-    }
-
-    // Check for special tithi festivals
-    int tithiNum = static_cast<int>(panchanga.tithi);
-    if (tithiNum == 8 && monthName == "Bhadrapada" && panchanga.isKrishna) {
-        panchanga.festivals.push_back("Krishna Janmashtami");
-    }
-
-    if (tithiNum == 14 && monthName == "Phalguna" && panchanga.isKrishna) {
-        panchanga.festivals.push_back("Maha Shivratri");
+    int nakshatra = static_cast<int>(record.nakshatra);
+    if (nakshatra >= 1 && nakshatra <= 27) {
+        for (FestivalId id : nakshatraFestivals[month][nakshatra]) record.festivals.push(id);
     }
 
-    if (tithiNum == 4 && monthName == "Bhadrapada" && panchanga.isShukla) {
-        panchanga.festivals.push_back("Ganesh Chaturthi");
-    }
-
-    // Check for Navratri periods
-    if ((monthName == "Chaitra" && tithiNum >= 1 && tithiNum <= 9 && panchanga.isShukla) ||
-        (monthName == "Ashwini" && tithiNum >= 1 && tithiNum <= 9 && panchanga.isShukla)) {
-        panchanga.isNavratri = true;
-        if (monthName == "Chaitra") {
-            panchanga.festivals.push_back("Chaitra Navratri - Day " + std::to_string(tithiNum));
-        } else {
-            panchanga.festivals.push_back("Sharad Navratri - Day " + std::to_string(tithiNum));
-        }
+    // Navratri periods: Chaitra and Ashwini Shukla Pratipad to Navami
+    if ((record.month == HinduMonth::CHAITRA || record.month == HinduMonth::ASHWINI_MONTH) &&
+        tithi >= 1 && tithi <= 9) {
+        record.set(PanchangaRecord::NAVRATRI);
     }
 }
 
-void HinduCalendar::identifySpecialEvents(PanchangaData& panchanga) const {
+void HinduCalendar::identifySpecialEvents(PanchangaRecord& record) const {
     // Check for solar transitions (Sankranti)
-    if (std::fmod(panchanga.sunLongitude, 30.0) < 1.0) {
-        panchanga.isSankranti = true;
-        panchanga.specialEvents.push_back("Sankranti - " + getRashiName(panchanga.sunRashi));
-    }
-
-    // Add other special astronomical events
-    if (panchanga.yoga == Yoga::VYATIPATA || panchanga.yoga == Yoga::VAIDHRITI) {
-        panchanga.specialEvents.push_back("Inauspicious Yoga: " + getYogaName(panchanga.yoga));
+    if (std::fmod(record.sunLongitude, 30.0) < 1.0) {
+        record.set(PanchangaRecord::SANKRANTI);
+        int rashi = static_cast<int>(record.sunRashi);
+        if (rashi >= 1 && rashi <= 12) {
+            record.specialEvents.push(builtinEvents.sankranti[rashi]);
+        }
     }
 
-    if (panchanga.yoga == Yoga::SIDDHI || panchanga.yoga == Yoga::SHIVA || panchanga.yoga == Yoga::SIDDHA) {
-        panchanga.specialEvents.push_back("Very Auspicious Yoga: " + getYogaName(panchanga.yoga));
+    // Add other special astronomical events (Vyatipata/Vaidhriti, Siddhi/Shiva/Siddha)
+    int yoga = static_cast<int>(record.yoga);
+    if (yoga >= 1 && yoga <= 27 && builtinEvents.yoga[yoga] != 0) {
+        record.specialEvents.push(builtinEvents.yoga[yoga]);
     }
 }
 
-void HinduCalendar::calculateMuhurta(PanchangaData& panchanga) const {
+void HinduCalendar::calculateMuhurta(PanchangaRecord& record) const {
     // Simple muhurta calculation based on tithi, nakshatra, and yoga
-    bool isTithiGood = (static_cast<int>(panchanga.tithi) % 7 != 4) && (static_cast<int>(panchanga.tithi) % 7 != 9);
-    bool isNakshatraGood = (static_cast<int>(panchanga.nakshatra) % 9 != 8);
-    bool isYogaGood = (panchanga.yoga != Yoga::VYATIPATA && panchanga.yoga != Yoga::VAIDHRITI &&
-                       panchanga.yoga != Yoga::SHULA && panchanga.yoga != Yoga::GANDA);
+    bool isTithiGood = (static_cast<int>(record.tithi) % 7 != 4) && (static_cast<int>(record.tithi) % 7 != 9);
+    bool isNakshatraGood = (static_cast<int>(record.nakshatra) % 9 != 8);
+    bool isYogaGood = (record.yoga != Yoga::VYATIPATA && record.yoga != Yoga::VAIDHRITI &&
+                       record.yoga != Yoga::SHULA && record.yoga != Yoga::GANDA);
 
-    panchanga.isShubhaMuhurta = (isTithiGood && isNakshatraGood && isYogaGood);
-    panchanga.isAshubhaMuhurta = !panchanga.isShubhaMuhurta;
-
-    if (panchanga.isShubhaMuhurta) {
-        panchanga.muhurtaDescription = "Generally auspicious time for most activities";
-    } else {
-        panchanga.muhurtaDescription = "Exercise caution; consult detailed muhurta for important activities";
+    if (isTithiGood && isNakshatraGood && isYogaGood) {
+        record.set(PanchangaRecord::SHUBHA_MUHURTA);
     }
 }
 
-void HinduCalendar::calculateSunMoonTimes(PanchangaData& panchanga, double latitude, double longitude) const {
-    try {
-        char errorString[256];
-        double geopos[3] = {longitude, latitude, 0.0}; // longitude, latitude, altitude
-        double riseSet[2];
-
-        // Calculate sunrise and sunset
-        int result = swe_rise_trans(panchanga.julianDay - 0.5, SE_SUN, nullptr, SEFLG_SIDEREAL,
-                                   SE_CALC_RISE, geopos, 1013.25, 10.0, riseSet, errorString);
-        if (result >= 0) {
-            // Convert to local time (approximate)
-            panchanga.sunriseTime = (riseSet[0] - floor(riseSet[0])) * 24.0;
-            if (panchanga.sunriseTime < 0) panchanga.sunriseTime += 24.0;
-        } else {
-            panchanga.sunriseTime = 6.0; // Default sunrise
-        }
+void HinduCalendar::calculateSunMoonTimes(PanchangaRecord& record, const RiseSetTimes& times) const {
+    record.sunriseTime = riseSetToHours(times.sunrise, 6.0);   // Default sunrise
+    record.sunsetTime = riseSetToHours(times.sunset, 18.0);    // Default sunset
+    record.moonriseTime = riseSetToHours(times.moonrise, 7.0); // Default moonrise
+    record.moonsetTime = riseSetToHours(times.moonset, 19.0);  // Default moonset
 
-        result = swe_rise_trans(panchanga.julianDay - 0.5, SE_SUN, nullptr, SEFLG_SIDEREAL,
-                               SE_CALC_SET, geopos, 1013.25, 10.0, riseSet, errorString);
-        if (result >= 0) {
-            panchanga.sunsetTime = (riseSet[0] - floor(riseSet[0])) * 24.0;
-            if (panchanga.sunsetTime < 0) panchanga.sunsetTime += 24.0;
-        } else {
-            panchanga.sunsetTime = 18.0; // Default sunset
-        }
+    // Calculate day and night lengths
+    record.dayLength = record.sunsetTime - record.sunriseTime;
+    if (record.dayLength < 0) record.dayLength += 24.0;
+    record.nightLength = 24.0 - record.dayLength;
 
-        // Calculate moonrise and moonset
-        result = swe_rise_trans(panchanga.julianDay - 0.5, SE_MOON, nullptr, SEFLG_SIDEREAL,
-                               SE_CALC_RISE, geopos, 1013.25, 10.0, riseSet, errorString);
-        if (result >= 0) {
-            panchanga.moonriseTime = (riseSet[0] - floor(riseSet[0])) * 24.0;
-            if (panchanga.moonriseTime < 0) panchanga.moonriseTime += 24.0;
-        } else {
-            panchanga.moonriseTime = 7.0; // Default moonrise
-        }
-
-        result = swe_rise_trans(panchanga.julianDay - 0.5, SE_MOON, nullptr, SEFLG_SIDEREAL,
-                               SE_CALC_SET, geopos, 1013.25, 10.0, riseSet, errorString);
-        if (result >= 0) {
-            panchanga.moonsetTime = (riseSet[0] - floor(riseSet[0])) * 24.0;
-            if (panchanga.moonsetTime < 0) panchanga.moonsetTime += 24.0;
-        } else {
-            panchanga.moonsetTime = 19.0; // Default moonset
-        }
-
-        // Calculate day and night lengths
-        panchanga.dayLength = panchanga.sunsetTime - panchanga.sunriseTime;
-        if (panchanga.dayLength < 0) panchanga.dayLength += 24.0;
-        panchanga.nightLength = 24.0 - panchanga.dayLength;
+    // Calculate Brahma Muhurta (1.5 hours before sunrise)
+    record.brahmaMuhurtaStart = calculateBrahmaMuhurta(record.sunriseTime, true);
+    record.brahmaMuhurtaEnd = calculateBrahmaMuhurta(record.sunriseTime, false);
 
-        // Calculate Brahma Muhurta (1.5 hours before sunrise)
-        panchanga.brahmaMuhurtaStart = calculateBrahmaMuhurta(panchanga.sunriseTime, true);
-        panchanga.brahmaMuhurtaEnd = calculateBrahmaMuhurta(panchanga.sunriseTime, false);
+    // Calculate Abhijit Muhurta (middle of the day)
+    record.abhijitStart = calculateAbhijitMuhurta(record.sunriseTime, record.sunsetTime, true);
+    record.abhijitEnd = calculateAbhijitMuhurta(record.sunriseTime, record.sunsetTime, false);
 
-        // Calculate Abhijit Muhurta (middle of the day)
-        panchanga.abhijitStart = calculateAbhijitMuhurta(panchanga.sunriseTime, panchanga.sunsetTime, true);
-        panchanga.abhijitEnd = calculateAbhijitMuhurta(panchanga.sunriseTime, panchanga.sunsetTime, false);
+    // Calculate Godhuli Bela (evening twilight)
+    record.godhuliBelStart = calculateGodhuliBela(record.sunsetTime, true);
+    record.godhuliBelEnd = calculateGodhuliBela(record.sunsetTime, false);
 
-        // Calculate Godhuli Bela (evening twilight)
-        panchanga.godhuliBelStart = calculateGodhuliBela(panchanga.sunsetTime, true);
-        panchanga.godhuliBelEnd = calculateGodhuliBela(panchanga.sunsetTime, false);
-
-        // Calculate Nishita Muhurta (midnight)
-        double nextSunrise = panchanga.sunriseTime + 24.0; // Next day sunrise
-        panchanga.nishitaMuhurtaStart = calculateNishitaMuhurta(panchanga.sunsetTime, nextSunrise, true);
-        panchanga.nishitaMuhurtaEnd = calculateNishitaMuhurta(panchanga.sunsetTime, nextSunrise, false);
-
-    } catch (const std::exception& e) {
-        // Set default values in case of error
-        panchanga.sunriseTime = 6.0;
-        panchanga.sunsetTime = 18.0;
-        panchanga.moonriseTime = 7.0;
-        panchanga.moonsetTime = 19.0;
-        panchanga.dayLength = 12.0;
-        panchanga.nightLength = 12.0;
-    }
+    // Calculate Nishita Muhurta (midnight)
+    double nextSunrise = record.sunriseTime + 24.0; // Next day sunrise
+    record.nishitaMuhurtaStart = calculateNishitaMuhurta(record.sunsetTime, nextSunrise, true);
+    record.nishitaMuhurtaEnd = calculateNishitaMuhurta(record.sunsetTime, nextSunrise, false);
 }
 
-void HinduCalendar::calculateRahuKaal(PanchangaData& panchanga) const {
+void HinduCalendar::calculateRahuKaal(PanchangaRecord& record) const {
     // Rahu Kaal is 1/8th of day length, starting at different times for each weekday
-    double dayEighth = panchanga.dayLength / 8.0;
-    int weekday = static_cast<int>(panchanga.vara);
-
-    // Starting periods for each weekday (0=Sunday)
-    int rahuPeriods[] = {7, 1, 6, 4, 5, 3, 2}; // Sunday to Saturday
+    double dayEighth = record.dayLength / 8.0;
+    int weekday = static_cast<int>(record.vara);
 
     if (weekday >= 0 && weekday <= 6) {
-        int period = rahuPeriods[weekday] - 1; // Convert to 0-based
-        panchanga.rahuKaalStart = panchanga.sunriseTime + (period * dayEighth);
-        panchanga.rahuKaalEnd = panchanga.rahuKaalStart + dayEighth;
+        int period = RAHU_KAAL_PERIODS[weekday] - 1; // Convert to 0-based
+        record.rahuKaalStart = record.sunriseTime + (period * dayEighth);
+        record.rahuKaalEnd = record.rahuKaalStart + dayEighth;
     }
 }
 
-void HinduCalendar::calculateYamaganda(PanchangaData& panchanga) const {
+void HinduCalendar::calculateYamaganda(PanchangaRecord& record) const {
     // Yamaganda is also 1/8th of day length, different periods for each weekday
-    double dayEighth = panchanga.dayLength / 8.0;
-    int weekday = static_cast<int>(panchanga.vara);
-
-    // Starting periods for Yamaganda
-    int yamagandaPeriods[] = {4, 3, 2, 1, 7, 6, 5}; // Sunday to Saturday
+    double dayEighth = record.dayLength / 8.0;
+    int weekday = static_cast<int>(record.vara);
 
     if (weekday >= 0 && weekday <= 6) {
-        int period = yamagandaPeriods[weekday] - 1; // Convert to 0-based
-        panchanga.yamagandaStart = panchanga.sunriseTime + (period * dayEighth);
-        panchanga.yamagandaEnd = panchanga.yamagandaStart + dayEighth;
+        int period = YAMAGANDA_PERIODS[weekday] - 1; // Convert to 0-based
+        record.yamagandaStart = record.sunriseTime + (period * dayEighth);
+        record.yamagandaEnd = record.yamagandaStart + dayEighth;
     }
 }
 
-void HinduCalendar::calculateGulikai(PanchangaData& panchanga) const {
+void HinduCalendar::calculateGulikai(PanchangaRecord& record) const {
     // Gulikai periods
-    double dayEighth = panchanga.dayLength / 8.0;
-    int weekday = static_cast<int>(panchanga.vara);
-
-    // Starting periods for Gulikai
-    int gulikaiPeriods[] = {6, 5, 4, 3, 2, 1, 7}; // Sunday to Saturday
+    double dayEighth = record.dayLength / 8.0;
+    int weekday = static_cast<int>(record.vara);
 
     if (weekday >= 0 && weekday <= 6) {
-        int period = gulikaiPeriods[weekday] - 1; // Convert to 0-based
-        panchanga.gulikaiStart = panchanga.sunriseTime + (period * dayEighth);
-        panchanga.gulikaiEnd = panchanga.gulikaiStart + dayEighth;
+        int period = GULIKAI_PERIODS[weekday] - 1; // Convert to 0-based
+        record.gulikaiStart = record.sunriseTime + (period * dayEighth);
+        record.gulikaiEnd = record.gulikaiStart + dayEighth;
     }
 }
 
-void HinduCalendar::calculateDurMuhurtam(PanchangaData& panchanga) const {
+void HinduCalendar::calculateDurMuhurtam(PanchangaRecord& record) const {
     // Dur Muhurtam is typically around midday
-    double dayCenter = panchanga.sunriseTime + (panchanga.dayLength / 2.0);
-    panchanga.durMuhurtamStart = dayCenter - 0.75; // 45 minutes before midday
-    panchanga.durMuhurtamEnd = dayCenter + 0.75;   // 45 minutes after midday
+    double dayCenter = record.sunriseTime + (record.dayLength / 2.0);
+    record.durMuhurtamStart = dayCenter - DUR_MUHURTAM_HALF_SPAN;
+    record.durMuhurtamEnd = dayCenter + DUR_MUHURTAM_HALF_SPAN;
 }
 
-void HinduCalendar::calculateVarjyam(PanchangaData& panchanga) const {
+void HinduCalendar::calculateVarjyam(PanchangaRecord& record) const {
     // Varjyam calculations based on nakshatra
     // This is a simplified calculation - actual Varjyam is complex
-    panchanga.varjyamTimes.clear();
-
-    // Sample calculation based on nakshatra number
-    int nakNum = static_cast<int>(panchanga.nakshatra);
+    int nakNum = static_cast<int>(record.nakshatra);
     double varjyamDuration = 1.0 + (nakNum % 3) * 0.5; // 1 to 2 hours
 
-    // Add multiple Varjyam periods during the day
-    double startTime = panchanga.sunriseTime + 6.0;
-    panchanga.varjyamTimes.push_back({startTime, startTime + varjyamDuration});
+    // Two Varjyam periods during the day
+    record.varjyamStart[0] = record.sunriseTime + 6.0;
+    record.varjyamEnd[0] = record.varjyamStart[0] + varjyamDuration;
 
-    startTime = panchanga.sunriseTime + 9.0;
-    panchanga.varjyamTimes.push_back({startTime, startTime + varjyamDuration/2});
+    record.varjyamStart[1] = record.sunriseTime + 9.0;
+    record.varjyamEnd[1] = record.varjyamStart[1] + varjyamDuration/2;
 }
 
-void HinduCalendar::calculateSpecialYogas(PanchangaData& panchanga) const {
-    // Calculate special astronomical yogas
-    panchanga.isSarvarthaSiddhi = false;
-    panchanga.isAmritaSiddhi = false;
-    panchanga.isDwipushkar = false;
-    panchanga.isTripushkar = false;
-    panchanga.isRaviPushya = false;
-    panchanga.isGuruPushya = false;
-
+void HinduCalendar::calculateSpecialYogas(PanchangaRecord& record) const {
     // Sarvartha Siddhi Yoga conditions
-    if ((panchanga.vara == Vara::WEDNESDAY && panchanga.nakshatra == HinduNakshatra::HASTA) ||
-        (panchanga.vara == Vara::FRIDAY && panchanga.nakshatra == HinduNakshatra::REVATI) ||
-        (panchanga.vara == Vara::SUNDAY && panchanga.nakshatra == HinduNakshatra::PUSHYA)) {
-        panchanga.isSarvarthaSiddhi = true;
+    if ((record.vara == Vara::WEDNESDAY && record.nakshatra == HinduNakshatra::HASTA) ||
+        (record.vara == Vara::FRIDAY && record.nakshatra == HinduNakshatra::REVATI) ||
+        (record.vara == Vara::SUNDAY && record.nakshatra == HinduNakshatra::PUSHYA)) {
+        record.set(PanchangaRecord::SARVARTHA_SIDDHI);
     }
 
     // Amrita Siddhi Yoga conditions
-    if ((panchanga.vara == Vara::MONDAY && panchanga.nakshatra == HinduNakshatra::ROHINI) ||
-        (panchanga.vara == Vara::TUESDAY && panchanga.nakshatra == HinduNakshatra::ASHWINI) ||
-        (panchanga.vara == Vara::THURSDAY && panchanga.nakshatra == HinduNakshatra::PUNARVASU)) {
-        panchanga.isAmritaSiddhi = true;
+    if ((record.vara == Vara::MONDAY && record.nakshatra == HinduNakshatra::ROHINI) ||
+        (record.vara == Vara::TUESDAY && record.nakshatra == HinduNakshatra::ASHWINI) ||
+        (record.vara == Vara::THURSDAY && record.nakshatra == HinduNakshatra::PUNARVASU)) {
+        record.set(PanchangaRecord::AMRITA_SIDDHI);
     }
 
     // Ravi Pushya Yoga (Sunday + Pushya nakshatra)
-    if (panchanga.vara == Vara::SUNDAY && panchanga.nakshatra == HinduNakshatra::PUSHYA) {
-        panchanga.isRaviPushya = true;
+    if (record.vara == Vara::SUNDAY && record.nakshatra == HinduNakshatra::PUSHYA) {
+        record.set(PanchangaRecord::RAVI_PUSHYA);
     }
 
     // Check for Dwipushkar and Tripushkar based on complex calculations
     // This is simplified - actual calculation involves planetary positions
-    int tithiNum = static_cast<int>(panchanga.tithi);
-    int nakNum = static_cast<int>(panchanga.nakshatra);
+    int tithiNum = static_cast<int>(record.tithi);
+    int nakNum = static_cast<int>(record.nakshatra);
 
     if ((tithiNum + nakNum) % 7 == 0) {
-        panchanga.isDwipushkar = true;
+        record.set(PanchangaRecord::DWIPUSHKAR);
     }
 
     if ((tithiNum + nakNum) % 9 == 0) {
-        panchanga.isTripushkar = true;
+        record.set(PanchangaRecord::TRIPUSHKAR);
     }
 }
 
-void HinduCalendar::calculateNakshatraPada(PanchangaData& panchanga) const {
+void HinduCalendar::calculateNakshatraPada(PanchangaRecord& record) const {
     // Each nakshatra has 4 padas, each spanning 3°20' (200 minutes)
-    double nakshatraStart = (static_cast<int>(panchanga.nakshatra) - 1) * 13.333333;
-    double offsetInNakshatra = fmod(panchanga.moonLongitude - nakshatraStart, 13.333333);
+    double nakshatraStart = (static_cast<int>(record.nakshatra) - 1) * 13.333333;
+    double offsetInNakshatra = fmod(record.moonLongitude - nakshatraStart, 13.333333);
     if (offsetInNakshatra < 0) offsetInNakshatra += 13.333333;
 
-    panchanga.nakshatraPada = static_cast<int>(offsetInNakshatra / 3.333333) + 1;
-    if (panchanga.nakshatraPada > 4) panchanga.nakshatraPada = 4;
+    int pada = static_cast<int>(offsetInNakshatra / 3.333333) + 1;
+    if (pada > 4) pada = 4;
+    record.nakshatraPada = static_cast<int8_t>(pada);
 
     // Calculate when current pada ends
-    double nextPadaStart = panchanga.nakshatraPada * 3.333333;
+    double nextPadaStart = pada * 3.333333;
     double remainingDegrees = nextPadaStart - offsetInNakshatra;
 
     // Approximate time calculation (simplified)
-    panchanga.nakshatraPadaEndTime = remainingDegrees / 0.5; // Rough estimate
+    record.nakshatraPadaEndTime = remainingDegrees / 0.5; // Rough estimate
 }
 
 void HinduCalendar::calculateChandraTaraBalam(PanchangaData& panchanga) const {
@@ -964,7 +1503,7 @@ void HinduCalendar::calculateChandraTaraBalam(PanchangaData& panchanga) const {
     int currentMoonRashiNum = static_cast<int>(currentMoonRashi);
 
     // Add favorable rashis (2, 3, 4, 6, 8, 9, 12 from moon rashi)
-    std::vector<int> favorableOffsets = {2, 3, 4, 6, 8, 9, 12};
+    static const int favorableOffsets[] = {2, 3, 4, 6, 8, 9, 12};
     for (int offset : favorableOffsets) {
         int favorableRashi = ((currentMoonRashiNum - 1 + offset - 1) % 12) + 1;
         panchanga.goodChandraBalam.push_back(static_cast<Rashi>(favorableRashi));
@@ -975,203 +1514,192 @@ void HinduCalendar::calculateChandraTaraBalam(PanchangaData& panchanga) const {
     int currentNakNum = static_cast<int>(currentNak);
 
     // Add favorable nakshatras
-    std::vector<int> favorableNakOffsets = {1, 3, 5, 7, 9, 11, 13, 15, 17, 19};
+    static const int favorableNakOffsets[] = {1, 3, 5, 7, 9, 11, 13, 15, 17, 19};
     for (int offset : favorableNakOffsets) {
         int favorableNak = ((currentNakNum - 1 + offset - 1) % 27) + 1;
         panchanga.goodTaraBalam.push_back(static_cast<HinduNakshatra>(favorableNak));
     }
 }
 
-void HinduCalendar::calculateRituAyana(PanchangaData& panchanga) const {
+void HinduCalendar::calculateRituAyana(PanchangaRecord& record) const {
     // Determine Ritu (season) based on sun's longitude
-    double sunLong = panchanga.sunLongitude;
+    double sunLong = record.sunLongitude;
 
     if (sunLong >= 320 || sunLong < 50) {
-        panchanga.ritu = "Shishira (Late Winter)";
+        record.ritu = Ritu::SHISHIRA;
     } else if (sunLong >= 50 && sunLong < 80) {
-        panchanga.ritu = "Vasanta (Spring)";
+        record.ritu = Ritu::VASANTA;
     } else if (sunLong >= 80 && sunLong < 110) {
-        panchanga.ritu = "Grishma (Summer)";
+        record.ritu = Ritu::GRISHMA;
     } else if (sunLong >= 110 && sunLong < 140) {
-        panchanga.ritu = "Varsha (Monsoon)";
+        record.ritu = Ritu::VARSHA;
     } else if (sunLong >= 140 && sunLong < 170) {
-        panchanga.ritu = "Sharad (Autumn)";
+        record.ritu = Ritu::SHARAD;
     } else {
-        panchanga.ritu = "Hemanta (Early Winter)";
+        record.ritu = Ritu::HEMANTA;
     }
 
     // Determine Ayana (solar movement)
     if (sunLong >= 270 || sunLong < 90) {
-        panchanga.ayana = "Uttarayana (Northward)";
+        record.ayana = Ayana::UTTARAYANA;
     } else {
-        panchanga.ayana = "Dakshinayana (Southward)";
+        record.ayana = Ayana::DAKSHINAYANA;
     }
 }
 
-void HinduCalendar::calculateShoolDirections(PanchangaData& panchanga) const {
+void HinduCalendar::calculateShoolDirections(PanchangaRecord& record) const {
     // Disha Shool based on weekday
-    int weekday = static_cast<int>(panchanga.vara);
-    std::vector<std::string> dishaShools = {
-        "East", "North", "South", "West", "North", "South", "West"
+    static const Direction dishaShools[] = {
+        Direction::EAST, Direction::NORTH, Direction::SOUTH, Direction::WEST,
+        Direction::NORTH, Direction::SOUTH, Direction::WEST
     };
 
+    int weekday = static_cast<int>(record.vara);
     if (weekday >= 0 && weekday <= 6) {
-        panchanga.dishaShool = dishaShools[weekday];
+        record.dishaShool = dishaShools[weekday];
     }
 
-    // Nakshatra Shool based on nakshatra
-    int nakNum = static_cast<int>(panchanga.nakshatra);
-    std::vector<std::string> nakShools = {
-        "South", "East", "West", "North", "South", "East", "West", "North", "South",
-        "East", "West", "North", "South", "East", "West", "North", "South", "East",
-        "West", "North", "South", "East", "West", "North", "South", "East", "West"
+    // Nakshatra Shool based on nakshatra (South, East, West, North repeating)
+    static const Direction nakShoolCycle[] = {
+        Direction::SOUTH, Direction::EAST, Direction::WEST, Direction::NORTH
     };
 
+    int nakNum = static_cast<int>(record.nakshatra);
     if (nakNum >= 1 && nakNum <= 27) {
-        panchanga.nakshatraShool = nakShools[nakNum - 1];
+        record.nakshatraShool = nakShoolCycle[(nakNum - 1) % 4];
     }
 }
 
-void HinduCalendar::calculateVarnaInformation(PanchangaData& panchanga) const {
+void HinduCalendar::calculateVarnaInformation(PanchangaRecord& record) const {
     // Calculate Varna based on weekday (traditional classification)
-    int weekday = static_cast<int>(panchanga.vara);
-    std::vector<std::string> dayVarnas = {
-        "Kshatriya",  // Sunday - ruled by Sun (royal/warrior)
-        "Vaishya",    // Monday - ruled by Moon (merchant/agricultural)
-        "Kshatriya",  // Tuesday - ruled by Mars (warrior)
-        "Brahmin",    // Wednesday - ruled by Mercury (intellectual/priestly)
-        "Brahmin",    // Thursday - ruled by Jupiter (spiritual/learned)
-        "Vaishya",    // Friday - ruled by Venus (artistic/commercial)
-        "Shudra"      // Saturday - ruled by Saturn (service/labor)
+    static const Varna dayVarnas[] = {
+        Varna::KSHATRIYA,  // Sunday - ruled by Sun (royal/warrior)
+        Varna::VAISHYA,    // Monday - ruled by Moon (merchant/agricultural)
+        Varna::KSHATRIYA,  // Tuesday - ruled by Mars (warrior)
+        Varna::BRAHMIN,    // Wednesday - ruled by Mercury (intellectual/priestly)
+        Varna::BRAHMIN,    // Thursday - ruled by Jupiter (spiritual/learned)
+        Varna::VAISHYA,    // Friday - ruled by Venus (artistic/commercial)
+        Varna::SHUDRA      // Saturday - ruled by Saturn (service/labor)
     };
 
+    int weekday = static_cast<int>(record.vara);
     if (weekday >= 0 && weekday <= 6) {
-        panchanga.varnaDay = dayVarnas[weekday];
+        record.varnaDay = dayVarnas[weekday];
     }
 
     // Calculate Varna based on Tithi (traditional lunar day classification)
-    int tithiNum = static_cast<int>(panchanga.tithi);
-    std::string tithiVarna;
-
+    int tithiNum = static_cast<int>(record.tithi);
     if (tithiNum >= 1 && tithiNum <= 30) {
         // Simplify tithi to 1-15 range for both pakshas
         int simpleTithi = ((tithiNum - 1) % 15) + 1;
 
-        if (simpleTithi >= 1 && simpleTithi <= 3) {
-            tithiVarna = "Brahmin";     // Beginning tithis - spiritual
-        } else if (simpleTithi >= 4 && simpleTithi <= 7) {
-            tithiVarna = "Kshatriya";   // Middle tithis - active/royal
-        } else if (simpleTithi >= 8 && simpleTithi <= 11) {
-            tithiVarna = "Vaishya";     // Later tithis - commercial
-        } else if (simpleTithi >= 12 && simpleTithi <= 15) {
-            tithiVarna = "Shudra";      // Final tithis - service/completion
+        if (simpleTithi <= 3) {
+            record.varnaTithi = Varna::BRAHMIN;     // Beginning tithis - spiritual
+        } else if (simpleTithi <= 7) {
+            record.varnaTithi = Varna::KSHATRIYA;   // Middle tithis - active/royal
+        } else if (simpleTithi <= 11) {
+            record.varnaTithi = Varna::VAISHYA;     // Later tithis - commercial
+        } else {
+            record.varnaTithi = Varna::SHUDRA;      // Final tithis - service/completion
         }
     }
-    panchanga.varnaTithi = tithiVarna;
 
     // Calculate Varna based on Nakshatra (based on traditional gana classification)
-    int nakNum = static_cast<int>(panchanga.nakshatra);
-    std::string nakshatraVarna;
-
-    // Classification based on traditional nakshatra gana and nature
-    std::vector<std::string> nakVarnas = {
-        "Kshatriya", // Ashwini - Swift, royal
-        "Shudra",    // Bharani - Service, death deity
-        "Kshatriya", // Krittika - Fire, sharp
-        "Vaishya",   // Rohini - Beauty, commerce
-        "Vaishya",   // Mrigashira - Soft, seeking
-        "Shudra",    // Ardra - Sharp, destructive
-        "Brahmin",   // Punarvasu - Divine, renewal
-        "Brahmin",   // Pushya - Divine, nourishing
-        "Shudra",    // Ashlesha - Sharp, serpent
-        "Kshatriya", // Magha - Royal, fierce
-        "Kshatriya", // Purva Phalguni - Royal, fierce
-        "Kshatriya", // Uttara Phalguni - Royal, fixed
-        "Brahmin",   // Hasta - Divine, skillful
-        "Shudra",    // Chitra - Mixed, artistic
-        "Brahmin",   // Swati - Divine, independent
-        "Shudra",    // Vishakha - Mixed, forked
-        "Brahmin",   // Anuradha - Divine, soft
-        "Shudra",    // Jyeshtha - Sharp, competitive
-        "Shudra",    // Mula - Sharp, destructive
-        "Kshatriya", // Purva Ashadha - Fierce, invincible
-        "Kshatriya", // Uttara Ashadha - Fixed, victory
-        "Brahmin",   // Shravana - Divine, learning
-        "Kshatriya", // Dhanishta - Royal, wealthy
-        "Shudra",    // Shatabhisha - Independent, healing
-        "Kshatriya", // Purva Bhadrapada - Fierce, transformative
-        "Kshatriya", // Uttara Bhadrapada - Fixed, depth
-        "Brahmin"    // Revati - Divine, nourishing
+    static const Varna nakVarnas[] = {
+        Varna::KSHATRIYA, // Ashwini - Swift, royal
+        Varna::SHUDRA,    // Bharani - Service, death deity
+        Varna::KSHATRIYA, // Krittika - Fire, sharp
+        Varna::VAISHYA,   // Rohini - Beauty, commerce
+        Varna::VAISHYA,   // Mrigashira - Soft, seeking
+        Varna::SHUDRA,    // Ardra - Sharp, destructive
+        Varna::BRAHMIN,   // Punarvasu - Divine, renewal
+        Varna::BRAHMIN,   // Pushya - Divine, nourishing
+        Varna::SHUDRA,    // Ashlesha - Sharp, serpent
+        Varna::KSHATRIYA, // Magha - Royal, fierce
+        Varna::KSHATRIYA, // Purva Phalguni - Royal, fierce
+        Varna::KSHATRIYA, // Uttara Phalguni - Royal, fixed
+        Varna::BRAHMIN,   // Hasta - Divine, skillful
+        Varna::SHUDRA,    // Chitra - Mixed, artistic
+        Varna::BRAHMIN,   // Swati - Divine, independent
+        Varna::SHUDRA,    // Vishakha - Mixed, forked
+        Varna::BRAHMIN,   // Anuradha - Divine, soft
+        Varna::SHUDRA,    // Jyeshtha - Sharp, competitive
+        Varna::SHUDRA,    // Mula - Sharp, destructive
+        Varna::KSHATRIYA, // Purva Ashadha - Fierce, invincible
+        Varna::KSHATRIYA, // Uttara Ashadha - Fixed, victory
+        Varna::BRAHMIN,   // Shravana - Divine, learning
+        Varna::KSHATRIYA, // Dhanishta - Royal, wealthy
+        Varna::SHUDRA,    // Shatabhisha - Independent, healing
+        Varna::KSHATRIYA, // Purva Bhadrapada - Fierce, transformative
+        Varna::KSHATRIYA, // Uttara Bhadrapada - Fixed, depth
+        Varna::BRAHMIN    // Revati - Divine, nourishing
     };
 
+    int nakNum = static_cast<int>(record.nakshatra);
     if (nakNum >= 1 && nakNum <= 27) {
-        panchanga.varnaNakshatra = nakVarnas[nakNum - 1];
+        record.varnaNakshatra = nakVarnas[nakNum - 1];
     }
 }
 
-void HinduCalendar::identifyVrataUpavas(PanchangaData& panchanga) const {
-    panchanga.vrataList.clear();
-    panchanga.isFastingDay = false;
-
+void HinduCalendar::identifyVrataUpavas(PanchangaRecord& record) const {
     // Identify major vratas
-    if (panchanga.isEkadashi) {
-        panchanga.vrataList.push_back("Ekadashi Vrata");
-        panchanga.isFastingDay = true;
+    if (record.has(PanchangaRecord::EKADASHI)) {
+        record.vrataList.push(builtinEvents.ekadashiVrata);
+        record.set(PanchangaRecord::FASTING_DAY);
     }
 
-    if (panchanga.isPurnima) {
-        panchanga.vrataList.push_back("Purnima Vrata");
+    if (record.has(PanchangaRecord::PURNIMA)) {
+        record.vrataList.push(builtinEvents.purnimaVrata);
     }
 
-    if (panchanga.isAmavasya) {
-        panchanga.vrataList.push_back("Amavasya Vrata");
+    if (record.has(PanchangaRecord::AMAVASYA)) {
+        record.vrataList.push(builtinEvents.amavasyaVrata);
     }
 
     // Weekly vratas
-    if (panchanga.vara == Vara::MONDAY) {
-        panchanga.vrataList.push_back("Somwar Vrata");
-    } else if (panchanga.vara == Vara::TUESDAY) {
-        panchanga.vrataList.push_back("Mangalwar Vrata");
-    } else if (panchanga.vara == Vara::SATURDAY) {
-        panchanga.vrataList.push_back("Shaniwar Vrata");
+    if (record.vara == Vara::MONDAY) {
+        record.vrataList.push(builtinEvents.somwarVrata);
+    } else if (record.vara == Vara::TUESDAY) {
+        record.vrataList.push(builtinEvents.mangalwarVrata);
+    } else if (record.vara == Vara::SATURDAY) {
+        record.vrataList.push(builtinEvents.shaniwarVrata);
     }
 
     // Nakshatra-based vratas
-    if (panchanga.nakshatra == HinduNakshatra::ROHINI) {
-        panchanga.vrataList.push_back("Rohini Vrata");
-    }
-
-    // Check for Ganda Mool
-    std::vector<HinduNakshatra> gandaMoolNaks = {
-        HinduNakshatra::ASHWINI, HinduNakshatra::ASHLESHA, HinduNakshatra::MAGHA,
-        HinduNakshatra::JYESHTHA, HinduNakshatra::MULA, HinduNakshatra::REVATI
-    };
-
-    for (auto gnak : gandaMoolNaks) {
-        if (panchanga.nakshatra == gnak) {
-            panchanga.isGandaMool = true;
-            panchanga.vrataList.push_back("Ganda Mool Shanti");
+    if (record.nakshatra == HinduNakshatra::ROHINI) {
+        record.vrataList.push(builtinEvents.rohiniVrata);
+    }
+
+    switch (record.nakshatra) {
+        // Ganda Mool nakshatras
+        case HinduNakshatra::ASHWINI:
+        case HinduNakshatra::ASHLESHA:
+        case HinduNakshatra::MAGHA:
+        case HinduNakshatra::JYESHTHA:
+        case HinduNakshatra::MULA:
+            record.set(PanchangaRecord::GANDA_MOOL);
+            record.vrataList.push(builtinEvents.gandaMoolShanti);
             break;
-        }
-    }
-
-    // Check for Panchak (simplified)
-    std::vector<HinduNakshatra> panchakNaks = {
-        HinduNakshatra::DHANISHTA, HinduNakshatra::SHATABHISHA,
-        HinduNakshatra::PURVA_BHADRAPADA, HinduNakshatra::UTTARA_BHADRAPADA,
-        HinduNakshatra::REVATI
-    };
-
-    for (auto pnak : panchakNaks) {
-        if (panchanga.nakshatra == pnak) {
-            panchanga.isPanchak = true;
+        // Revati is both Ganda Mool and Panchak
+        case HinduNakshatra::REVATI:
+            record.set(PanchangaRecord::GANDA_MOOL);
+            record.vrataList.push(builtinEvents.gandaMoolShanti);
+            record.set(PanchangaRecord::PANCHAK);
+            break;
+        // Panchak (simplified)
+        case HinduNakshatra::DHANISHTA:
+        case HinduNakshatra::SHATABHISHA:
+        case HinduNakshatra::PURVA_BHADRAPADA:
+        case HinduNakshatra::UTTARA_BHADRAPADA:
+            record.set(PanchangaRecord::PANCHAK);
+            break;
+        default:
             break;
-        }
     }
 
     // Check for Bhadra (Vishti Karana)
-    if (panchanga.karana == Karana::VISHTI) {
-        panchanga.isBhadra = true;
+    if (record.karana == Karana::VISHTI) {
+        record.set(PanchangaRecord::BHADRA);
     }
 }
 
@@ -1257,6 +1785,53 @@ std::string PanchangaData::getSummary() const {
     return oss.str();
 }
 
+void MultiLocationPanchanga::resize(size_t count) {
+    for (auto* column : {&latitudes, &longitudes, &sunriseTime, &sunsetTime, &moonriseTime, &moonsetTime,
+                         &dayLength, &nightLength, &brahmaMuhurtaStart, &brahmaMuhurtaEnd,
+                         &abhijitStart, &abhijitEnd, &godhuliBelStart, &godhuliBelEnd,
+                         &nishitaMuhurtaStart, &nishitaMuhurtaEnd, &rahuKaalStart, &rahuKaalEnd,
+                         &yamagandaStart, &yamagandaEnd, &gulikaiStart, &gulikaiEnd,
+                         &durMuhurtamStart, &durMuhurtamEnd}) {
+        column->assign(count, 0.0);
+    }
+}
+
+PanchangaData MultiLocationPanchanga::at(size_t index) const {
+    PanchangaData panchanga = common;
+
+    panchanga.sunriseTime = sunriseTime[index];
+    panchanga.sunsetTime = sunsetTime[index];
+    panchanga.moonriseTime = moonriseTime[index];
+    panchanga.moonsetTime = moonsetTime[index];
+    panchanga.dayLength = dayLength[index];
+    panchanga.nightLength = nightLength[index];
+
+    panchanga.brahmaMuhurtaStart = brahmaMuhurtaStart[index];
+    panchanga.brahmaMuhurtaEnd = brahmaMuhurtaEnd[index];
+    panchanga.abhijitStart = abhijitStart[index];
+    panchanga.abhijitEnd = abhijitEnd[index];
+    panchanga.godhuliBelStart = godhuliBelStart[index];
+    panchanga.godhuliBelEnd = godhuliBelEnd[index];
+    panchanga.nishitaMuhurtaStart = nishitaMuhurtaStart[index];
+    panchanga.nishitaMuhurtaEnd = nishitaMuhurtaEnd[index];
+
+    panchanga.rahuKaalStart = rahuKaalStart[index];
+    panchanga.rahuKaalEnd = rahuKaalEnd[index];
+    panchanga.yamagandaStart = yamagandaStart[index];
+    panchanga.yamagandaEnd = yamagandaEnd[index];
+    panchanga.gulikaiStart = gulikaiStart[index];
+    panchanga.gulikaiEnd = gulikaiEnd[index];
+    panchanga.durMuhurtamStart = durMuhurtamStart[index];
+    panchanga.durMuhurtamEnd = durMuhurtamEnd[index];
+
+    for (auto& period : panchanga.varjyamTimes) {
+        period.first += sunriseTime[index];
+        period.second += sunriseTime[index];
+    }
+
+    return panchanga;
+}
+
 std::string HinduCalendar::generatePanchangaTable(const PanchangaData& panchanga) const {
     std::ostringstream oss;
 
@@ -1439,7 +2014,7 @@ std::string HinduCalendar::generatePanchangaTable(const PanchangaData& panchanga
 // Utility name methods
 std::string HinduCalendar::getNakshatraName(HinduNakshatra nak) const {
     if (static_cast<int>(nak) >= 1 && static_cast<int>(nak) <= 27) {
-        return nakshatraData[static_cast<int>(nak) - 1].name;
+        return NAKSHATRA_DATA[static_cast<int>(nak) - 1].name;
     }
     return "Unknown";
 }
@@ -1462,7 +2037,7 @@ std::string HinduCalendar::getTithiName(Tithi tithi) const {
 std::string HinduCalendar::getYogaName(Yoga yoga) const {
     int index = static_cast<int>(yoga);
     if (index >= 1 && index <= 27) {
-        return yogaData[index - 1].name;
+        return YOGA_DATA[index - 1].name;
     }
     return "Unknown";
 }
@@ -1470,7 +2045,7 @@ std::string HinduCalendar::getYogaName(Yoga yoga) const {
 std::string HinduCalendar::getKaranaName(Karana karana) const {
     int index = static_cast<int>(karana);
     if (index >= 1 && index <= 11) {
-        return karanaData[index - 1].name;
+        return KARANA_DATA[index - 1].name;
     }
     return "Unknown";
 }
@@ -1514,6 +2089,31 @@ std::string HinduCalendar::getRashiName(Rashi rashi) const {
     return "Unknown";
 }
 
+std::string HinduCalendar::getRituName(Ritu ritu) const {
+    int index = static_cast<int>(ritu);
+    return (index >= 0 && index <= 6) ? RITU_NAMES[index] : "";
+}
+
+std::string HinduCalendar::getAyanaName(Ayana ayana) const {
+    int index = static_cast<int>(ayana);
+    return (index >= 0 && index <= 2) ? AYANA_NAMES[index] : "";
+}
+
+std::string HinduCalendar::getDirectionName(Direction direction) const {
+    int index = static_cast<int>(direction);
+    return (index >= 0 && index <= 4) ? DIRECTION_NAMES[index] : "";
+}
+
+std::string HinduCalendar::getVarnaName(Varna varna) const {
+    int index = static_cast<int>(varna);
+    return (index >= 0 && index <= 4) ? VARNA_NAMES[index] : "";
+}
+
+const std::string& HinduCalendar::getEventName(FestivalId id) const {
+    static const std::string unknown;
+    return id < eventNames.size() ? eventNames[id] : unknown;
+}
+
 std::vector<PanchangaData> HinduCalendar::calculatePanchangaRange(const std::string& fromDate,
                                                                const std::string& toDate,
                                                                double latitude, double longitude) const {
@@ -1538,13 +2138,17 @@ std::vector<PanchangaData> HinduCalendar::calculatePanchangaRange(const std::str
         double fromJD = swe_julday(fromYear, fromMonth, fromDay, 0.0, SE_GREG_CAL);
         double toJD = swe_julday(toYear, toMonth, toDay, 0.0, SE_GREG_CAL);
 
-        // Calculate panchanga for each day
-        for (double jd = fromJD; jd <= toJD; jd += 1.0) {
-            PanchangaData panchanga = calculatePanchanga(jd, latitude, longitude);
-            if (panchanga.tithi != Tithi::PRATIPAD || jd == fromJD) { // Basic validation
-                results.push_back(panchanga);
-            }
+        // Records are streamed day by day; each day's sunrise/sunset seeds the next
+        int days = static_cast<int>(toJD - fromJD) + 1;
+        if (days > 0) {
+            results.reserve(days);
         }
+        forEachPanchangaRecord(fromJD, days, latitude, longitude, [&](const PanchangaRecord& record) {
+            if (record.tithi != Tithi::PRATIPAD || record.julianDay == fromJD) { // Basic validation
+                results.push_back(toPanchangaData(record));
+            }
+            return true;
+        });
 
     } catch (const std::exception& e) {
         lastError = "Error calculating panchanga range: " + std::string(e.what());
@@ -1553,6 +2157,273 @@ std::vector<PanchangaData> HinduCalendar::calculatePanchangaRange(const std::str
     return results;
 }
 
+FestivalCalendar HinduCalendar::generateFestivalCalendar(int year) const {
+    ASTRO_PROFILE_SCOPE("HinduCalendar::generateFestivalCalendar");
+    FestivalCalendar calendar = {};
+    calendar.year = year;
+
+    if (!initialized) {
+        return calendar;
+    }
+
+    const double yearStart = swe_julday(year, 1, 1, 0.0, SE_GREG_CAL);
+    const double yearEnd = swe_julday(year + 1, 1, 1, 0.0, SE_GREG_CAL);
+    const int days = static_cast<int>(yearEnd - yearStart);
+    const double lunation = 360.0 / MEAN_ELONGATION_RATE;
+
+    // Lunar month skeleton: new moons, full moons and Sankrantis (about 50 events)
+    std::vector<double> newMoons = findCalendarCrossings(CalendarAngle::ELONGATION, 0.0, MEAN_ELONGATION_RATE,
+                                                         yearStart - 1.2 * lunation, yearEnd + 1.2 * lunation);
+    std::vector<double> fullMoons = findCalendarCrossings(CalendarAngle::ELONGATION, 180.0, MEAN_ELONGATION_RATE,
+                                                          yearStart - 1.2 * lunation, yearEnd + 1.2 * lunation);
+    if (newMoons.size() < 2) {
+        lastError = "Failed to locate new moons for " + std::to_string(year);
+        return calendar;
+    }
+    // Sankrantis a month either side also bound the solar months that festival rules use
+    std::vector<double> ingresses;
+    for (int rashi = 0; rashi < 12; rashi++) {
+        for (double jd : findCalendarCrossings(CalendarAngle::SUN, rashi * 30.0, MEAN_SUN_RATE,
+                                               yearStart - 40.0, yearEnd + 40.0)) {
+            ingresses.push_back(jd);
+            if (jd >= yearStart && jd < yearEnd) calendar.sankrantis.push_back(jd);
+        }
+    }
+    std::sort(ingresses.begin(), ingresses.end());
+    std::sort(calendar.sankrantis.begin(), calendar.sankrantis.end());
+
+    // A failed Sun position leaves no months, which callers report as the error
+    auto sunFailure = [&](double jd) {
+        lastError = "Failed to compute the Sun's position at " + formatJulianDate(jd);
+        FestivalCalendar failed = {};
+        failed.year = year;
+        return failed;
+    };
+
+    // Amanta months take the name of the Sankranti they contain; a month without one is adhika
+    auto sunRashiAt = [this](double jd, int& rashi) {
+        double angle, rate;
+        if (!calendarAngleAt(CalendarAngle::SUN, jd, angle, rate)) return false;
+        rashi = static_cast<int>(calculateRashi(angle));
+        return true;
+    };
+    for (size_t i = 0; i + 1 < newMoons.size(); i++) {
+        if (newMoons[i + 1] <= yearStart || newMoons[i] >= yearEnd) continue;
+
+        LunarMonth lunarMonth = {};
+        lunarMonth.newMoonJD = newMoons[i];
+        lunarMonth.endJD = newMoons[i + 1];
+        for (double fullMoon : fullMoons) {
+            if (fullMoon > newMoons[i] && fullMoon < newMoons[i + 1]) lunarMonth.fullMoonJD = fullMoon;
+        }
+        int startRashi, endRashi;
+        if (!sunRashiAt(newMoons[i], startRashi)) return sunFailure(newMoons[i]);
+        if (!sunRashiAt(newMoons[i + 1], endRashi)) return sunFailure(newMoons[i + 1]);
+        lunarMonth.month = static_cast<HinduMonth>(startRashi % 12 + 1);
+        lunarMonth.isAdhika = (startRashi == endRashi);
+        calendar.months.push_back(lunarMonth);
+    }
+
+    // Candidate days: those whose Panchanga instant can fall inside a window where a rule may fire
+    std::vector<char> candidate(days, 0);
+    auto markWindow = [&](double from, double to) {
+        int first = std::max(0, static_cast<int>(std::ceil(from - CANDIDATE_MARGIN_DAYS - yearStart)));
+        int last = std::min(days - 1, static_cast<int>(std::floor(to + CANDIDATE_MARGIN_DAYS - yearStart)));
+        for (int day = first; day <= last; day++) candidate[day] = 1;
+    };
+
+    // Mark the part of [from, to] lying in solar months where `fires(month)` holds
+    std::vector<int> spanMonths;
+    for (size_t i = 0; i + 1 < ingresses.size(); i++) {
+        double middle = (ingresses[i] + ingresses[i + 1]) / 2.0;
+        double angle, rate;
+        if (!calendarAngleAt(CalendarAngle::SUN, middle, angle, rate)) return sunFailure(middle);
+        spanMonths.push_back(static_cast<int>(calculateHinduMonth(angle)));
+    }
+    auto markInMonths = [&](double from, double to, const std::function<bool(int)>& fires) {
+        for (size_t i = 0; i < spanMonths.size(); i++) {
+            double spanStart = std::max(from, ingresses[i]);
+            double spanEnd = std::min(to, ingresses[i + 1]);
+            if (spanStart <= spanEnd && fires(spanMonths[i])) markWindow(spanStart, spanEnd);
+        }
+    };
+
+    // Lunar vratas are observed every month; other tithis only where a rule exists
+    auto tithiFires = [this](int month, int tithi) {
+        return tithi == static_cast<int>(Tithi::EKADASHI) || tithi == static_cast<int>(Tithi::EKADASHI_K) ||
+               tithi == static_cast<int>(Tithi::PURNIMA) || tithi == static_cast<int>(Tithi::AMAVASYA) ||
+               !tithiFestivals[month][tithi].empty();
+    };
+
+    // Tithi windows within each lunation, seeded from the new and full moons
+    for (const auto& lunarMonth : calendar.months) {
+        double fullMoon = lunarMonth.fullMoonJD > 0.0 ? lunarMonth.fullMoonJD
+                                                      : (lunarMonth.newMoonJD + lunarMonth.endJD) / 2.0;
+        double boundaries[31] = {};
+        auto boundary = [&](int index) {
+            // Instant when the elongation reaches index * 12 degrees
+            if (index == 0) return lunarMonth.newMoonJD;
+            if (index == 15) return fullMoon;
+            if (index == 30) return lunarMonth.endJD;
+            if (boundaries[index] == 0.0) {
+                double jd = index < 15 ? lunarMonth.newMoonJD + (fullMoon - lunarMonth.newMoonJD) * index / 15.0
+                                       : fullMoon + (lunarMonth.endJD - fullMoon) * (index - 15) / 15.0;
+                solveCalendarAngle(CalendarAngle::ELONGATION, index * 12.0, jd);
+                boundaries[index] = jd;
+            }
+            return boundaries[index];
+        };
+        for (int tithi = 1; tithi <= 30; tithi++) {
+            bool anyMonth = false;
+            for (int month = 1; month <= 12 && !anyMonth; month++) anyMonth = tithiFires(month, tithi);
+            if (!anyMonth) continue;
+            markInMonths(boundary(tithi - 1), boundary(tithi),
+                         [&](int month) { return tithiFires(month, tithi); });
+        }
+    }
+
+    // Sankranti is flagged while the Sun is in the first degree of a rashi
+    for (double ingress : calendar.sankrantis) {
+        double angle, rate;
+        if (!calendarAngleAt(CalendarAngle::SUN, ingress + 0.5, angle, rate)) return sunFailure(ingress + 0.5);
+        if (!sankrantiFestivals[static_cast<int>(calculateRashi(angle))].empty()) {
+            markWindow(ingress, ingress + 1.0 / MEAN_SUN_RATE + 0.1);
+        }
+    }
+
+    for (int nakshatra = 1; nakshatra <= 27; nakshatra++) {
+        auto nakshatraFires = [&](int month) { return !nakshatraFestivals[month][nakshatra].empty(); };
+        bool anyMonth = false;
+        for (int month = 1; month <= 12 && !anyMonth; month++) anyMonth = nakshatraFires(month);
+        if (!anyMonth) continue;
+
+        double start = (nakshatra - 1) * NAKSHATRA_SPAN;
+        for (double entry : findCalendarCrossings(CalendarAngle::MOON, start, MEAN_MOON_RATE,
+                                                  yearStart - 2.0, yearEnd)) {
+            double exit = entry + NAKSHATRA_SPAN / MEAN_MOON_RATE;
+            solveCalendarAngle(CalendarAngle::MOON, start + NAKSHATRA_SPAN, exit);
+            markInMonths(entry, exit, nakshatraFires);
+        }
+    }
+
+    // Evaluate the candidate days only
+    auto lunarMonthAt = [&calendar](double jd) -> const LunarMonth* {
+        for (size_t i = 0; i < calendar.months.size(); i++) {
+            if (jd >= calendar.months[i].newMoonJD && jd < calendar.months[i].endJD) {
+                return &calendar.months[i];
+            }
+        }
+        return nullptr;
+    };
+
+    for (int day = 0; day < days; day++) {
+        if (!candidate[day]) continue;
+
+        double jd = yearStart + day;
+        PanchangaRecord record = {};
+        if (!calculateInstantElements(jd, record)) continue;
+        calendar.daysEvaluated++;
+
+        FestivalOccurrence occurrence = {};
+        occurrence.julianDay = jd;
+        occurrence.tithi = record.tithi;
+        occurrence.month = record.month;
+
+        const LunarMonth* lunarMonth = lunarMonthAt(jd);
+        if (lunarMonth) {
+            occurrence.amantaMonth = lunarMonth->month;
+            occurrence.isAdhika = lunarMonth->isAdhika;
+            // Purnimanta months begin at the full moon, so the Krishna paksha belongs to the next month
+            occurrence.purnimantaMonth = lunarMonth->month;
+            if (lunarMonth->fullMoonJD > 0.0 && jd >= lunarMonth->fullMoonJD) {
+                occurrence.purnimantaMonth = static_cast<HinduMonth>(static_cast<int>(lunarMonth->month) % 12 + 1);
+                if (lunarMonth + 1 < calendar.months.data() + calendar.months.size()) {
+                    occurrence.purnimantaMonth = (lunarMonth + 1)->month;
+                }
+            }
+        }
+
+        for (FestivalId id : record.festivals) {
+            occurrence.name = id;
+            occurrence.isVrata = false;
+            calendar.festivals.push_back(occurrence);
+        }
+        for (FestivalId id : record.vrataList) {
+            bool lunarVrata = (id == builtinEvents.ekadashiVrata || id == builtinEvents.purnimaVrata ||
+                               id == builtinEvents.amavasyaVrata);
+            bool alreadyListed = std::find(record.festivals.begin(), record.festivals.end(), id) !=
+                                 record.festivals.end();
+            if (lunarVrata && !alreadyListed) {
+                occurrence.name = id;
+                occurrence.isVrata = true;
+                calendar.festivals.push_back(occurrence);
+            }
+        }
+    }
+
+    return calendar;
+}
+
+std::string HinduCalendar::generateFestivalCalendarTable(const FestivalCalendar& calendar) const {
+    std::ostringstream oss;
+
+    oss << "\n═══════════════════════════════════════════════════════════════════\n";
+    oss << "           🕉️  HINDU FESTIVAL CALENDAR " << calendar.year << "  🕉️\n";
+    oss << "═══════════════════════════════════════════════════════════════════\n\n";
+
+    oss << "Lunar months (amanta, new moon to new moon):\n";
+    for (const auto& lunarMonth : calendar.months) {
+        std::string name = getHinduMonthName(lunarMonth.month);
+        if (lunarMonth.isAdhika) name = "Adhika " + name;
+        oss << "  " << std::left << std::setw(20) << name
+            << formatJulianDate(lunarMonth.newMoonJD) << " to " << formatJulianDate(lunarMonth.endJD)
+            << "  (Purnima " << formatJulianDate(lunarMonth.fullMoonJD) << ")\n";
+    }
+    oss << "\n";
+
+    oss << "Date       | Vara      | Tithi         | Amanta / Purnimanta       | Festival\n";
+    oss << "-----------|-----------|---------------|---------------------------|---------\n";
+
+    for (const auto& occurrence : calendar.festivals) {
+        std::string months = getHinduMonthName(occurrence.amantaMonth) + " / " +
+                             getHinduMonthName(occurrence.purnimantaMonth);
+        if (occurrence.isAdhika) months = "Adhika " + months;
+
+        oss << formatJulianDate(occurrence.julianDay) << " | ";
+        oss << std::left << std::setw(9) << getVaraName(calculateVara(occurrence.julianDay)) << " | ";
+        oss << std::setw(13) << getTithiName(occurrence.tithi) << " | ";
+        oss << std::setw(25) << months << " | ";
+        oss << getEventName(occurrence.name);
+        if (occurrence.isVrata) oss << " (vrata)";
+        oss << "\n";
+    }
+
+    oss << "\n" << calendar.festivals.size() << " observances; Panchanga evaluated on "
+        << calendar.daysEvaluated << " days\n";
+    oss << "═══════════════════════════════════════════════════════════════════\n";
+
+    return oss.str();
+}
+
+std::string HinduCalendar::generateFestivalCalendarCSV(const FestivalCalendar& calendar) const {
+    std::ostringstream oss;
+    oss << "Date,Vara,Tithi,Solar_Month,Amanta_Month,Purnimanta_Month,Adhika,Festival,Type\n";
+
+    for (const auto& occurrence : calendar.festivals) {
+        oss << formatJulianDate(occurrence.julianDay) << ","
+            << getVaraName(calculateVara(occurrence.julianDay)) << ","
+            << getTithiName(occurrence.tithi) << ","
+            << getHinduMonthName(occurrence.month) << ","
+            << getHinduMonthName(occurrence.amantaMonth) << ","
+            << getHinduMonthName(occurrence.purnimantaMonth) << ","
+            << (occurrence.isAdhika ? "Yes" : "No") << ","
+            << "\"" << getEventName(occurrence.name) << "\","
+            << (occurrence.isVrata ? "Vrata" : "Festival") << "\n";
+    }
+
+    return oss.str();
+}
+
 std::string HinduCalendar::generatePanchangaTable(const std::vector<PanchangaData>& panchangaList) const {
     if (panchangaList.empty()) {
         return "No Panchanga data available.";
@@ -1725,181 +2596,149 @@ std::string HinduCalendar::generatePanchangaTableFormat(const std::vector<Pancha
 }
 
 std::string HinduCalendar::generateJSON(const PanchangaData& panchanga) const {
-    std::ostringstream oss;
-
-    oss << "{\n";
-    oss << "  \"panchangaBasics\": {\n";
-    oss << "    \"tithi\": {\n";
-    oss << "      \"number\": " << static_cast<int>(panchanga.tithi) << ",\n";
-    oss << "      \"name\": \"" << getTithiName(panchanga.tithi) << "\",\n";
-    oss << "      \"endTime\": \"" << panchanga.getTimeString(panchanga.tithiEndTime) << "\"\n";
-    oss << "    },\n";
-    oss << "    \"vara\": {\n";
-    oss << "      \"number\": " << static_cast<int>(panchanga.vara) << ",\n";
-    oss << "      \"name\": \"" << getVaraName(panchanga.vara) << "\"\n";
-    oss << "    },\n";
-    oss << "    \"nakshatra\": {\n";
-    oss << "      \"number\": " << static_cast<int>(panchanga.nakshatra) << ",\n";
-    oss << "      \"name\": \"" << getNakshatraName(panchanga.nakshatra) << "\",\n";
-    oss << "      \"pada\": " << panchanga.nakshatraPada << ",\n";
-    oss << "      \"endTime\": \"" << panchanga.getTimeString(panchanga.nakshatraEndTime) << "\"\n";
-    oss << "    },\n";
-    oss << "    \"yoga\": {\n";
-    oss << "      \"number\": " << static_cast<int>(panchanga.yoga) << ",\n";
-    oss << "      \"name\": \"" << getYogaName(panchanga.yoga) << "\",\n";
-    oss << "      \"endTime\": \"" << panchanga.getTimeString(panchanga.yogaEndTime) << "\"\n";
-    oss << "    },\n";
-    oss << "    \"karana\": {\n";
-    oss << "      \"number\": " << static_cast<int>(panchanga.karana) << ",\n";
-    oss << "      \"name\": \"" << getKaranaName(panchanga.karana) << "\",\n";
-    oss << "      \"endTime\": \"" << panchanga.getTimeString(panchanga.karanaEndTime) << "\"\n";
-    oss << "    }\n";
-    oss << "  },\n";
-
-    oss << "  \"dateInformation\": {\n";
-    oss << "    \"vikramYear\": " << panchanga.vikramYear << ",\n";
-    oss << "    \"shakaYear\": " << panchanga.shakaYear << ",\n";
-    oss << "    \"kaliyugaYear\": " << panchanga.kaliyugaYear << ",\n";
-    oss << "    \"month\": \"" << getHinduMonthName(panchanga.month) << "\",\n";
-    oss << "    \"paksha\": \"" << (panchanga.isShukla ? "Shukla" : "Krishna") << "\",\n";
-    oss << "    \"julianDay\": " << std::fixed << std::setprecision(1) << panchanga.julianDay << "\n";
-    oss << "  },\n";
-
-    oss << "  \"sunMoonInformation\": {\n";
-    oss << "    \"sunrise\": \"" << panchanga.getTimeString(panchanga.sunriseTime) << "\",\n";
-    oss << "    \"sunset\": \"" << panchanga.getTimeString(panchanga.sunsetTime) << "\",\n";
-    oss << "    \"moonrise\": \"" << panchanga.getTimeString(panchanga.moonriseTime) << "\",\n";
-    oss << "    \"moonset\": \"" << panchanga.getTimeString(panchanga.moonsetTime) << "\",\n";
-    oss << "    \"dayLength\": " << std::fixed << std::setprecision(2) << panchanga.dayLength << ",\n";
-    oss << "    \"nightLength\": " << std::fixed << std::setprecision(2) << panchanga.nightLength << "\n";
-    oss << "  },\n";
-
-    oss << "  \"celestial\": {\n";
-    oss << "    \"sunLongitude\": " << std::fixed << std::setprecision(4) << panchanga.sunLongitude << ",\n";
-    oss << "    \"moonLongitude\": " << std::fixed << std::setprecision(4) << panchanga.moonLongitude << ",\n";
-    oss << "    \"lunarPhase\": " << std::fixed << std::setprecision(4) << panchanga.lunarPhase << ",\n";
-    oss << "    \"sunRashi\": \"" << getRashiName(panchanga.sunRashi) << "\",\n";
-    oss << "    \"moonRashi\": \"" << getRashiName(panchanga.moonRashi) << "\",\n";
-    oss << "    \"ayanamsaValue\": " << std::fixed << std::setprecision(6) << panchanga.ayanamsaValue << ",\n";
-    oss << "    \"ritu\": \"" << panchanga.ritu << "\",\n";
-    oss << "    \"ayana\": \"" << panchanga.ayana << "\"\n";
-    oss << "  },\n";
-
-    oss << "  \"auspiciousTimings\": {\n";
-    oss << "    \"brahmaMuhurta\": {\n";
-    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.brahmaMuhurtaStart) << "\",\n";
-    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.brahmaMuhurtaEnd) << "\"\n";
-    oss << "    },\n";
-    oss << "    \"abhijitMuhurta\": {\n";
-    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.abhijitStart) << "\",\n";
-    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.abhijitEnd) << "\"\n";
-    oss << "    },\n";
-    oss << "    \"godhuliBela\": {\n";
-    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.godhuliBelStart) << "\",\n";
-    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.godhuliBelEnd) << "\"\n";
-    oss << "    },\n";
-    oss << "    \"nishitaMuhurta\": {\n";
-    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.nishitaMuhurtaStart) << "\",\n";
-    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.nishitaMuhurtaEnd) << "\"\n";
-    oss << "    }\n";
-    oss << "  },\n";
-
-    oss << "  \"inauspiciousTimings\": {\n";
-    oss << "    \"rahuKaal\": {\n";
-    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.rahuKaalStart) << "\",\n";
-    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.rahuKaalEnd) << "\"\n";
-    oss << "    },\n";
-    oss << "    \"yamaganda\": {\n";
-    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.yamagandaStart) << "\",\n";
-    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.yamagandaEnd) << "\"\n";
-    oss << "    },\n";
-    oss << "    \"gulikai\": {\n";
-    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.gulikaiStart) << "\",\n";
-    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.gulikaiEnd) << "\"\n";
-    oss << "    },\n";
-    oss << "    \"durMuhurtam\": {\n";
-    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.durMuhurtamStart) << "\",\n";
-    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.durMuhurtamEnd) << "\"\n";
-    oss << "    },\n";
-    oss << "    \"varjyam\": [";
-    for (size_t i = 0; i < panchanga.varjyamTimes.size(); ++i) {
-        if (i > 0) oss << ", ";
-        oss << "{\n";
-        oss << "        \"start\": \"" << panchanga.getTimeString(panchanga.varjyamTimes[i].first) << "\",\n";
-        oss << "        \"end\": \"" << panchanga.getTimeString(panchanga.varjyamTimes[i].second) << "\"\n";
-        oss << "      }";
-    }
-    oss << "]\n";
-    oss << "  },\n";
-
-    oss << "  \"specialDays\": {\n";
-    oss << "    \"isEkadashi\": " << (panchanga.isEkadashi ? "true" : "false") << ",\n";
-    oss << "    \"isPurnima\": " << (panchanga.isPurnima ? "true" : "false") << ",\n";
-    oss << "    \"isAmavasya\": " << (panchanga.isAmavasya ? "true" : "false") << ",\n";
-    oss << "    \"isSankranti\": " << (panchanga.isSankranti ? "true" : "false") << ",\n";
-    oss << "    \"isNavratri\": " << (panchanga.isNavratri ? "true" : "false") << ",\n";
-    oss << "    \"isGandaMool\": " << (panchanga.isGandaMool ? "true" : "false") << ",\n";
-    oss << "    \"isPanchak\": " << (panchanga.isPanchak ? "true" : "false") << ",\n";
-    oss << "    \"isBhadra\": " << (panchanga.isBhadra ? "true" : "false") << ",\n";
-    oss << "    \"isFastingDay\": " << (panchanga.isFastingDay ? "true" : "false") << "\n";
-    oss << "  },\n";
-
-    oss << "  \"specialYogas\": {\n";
-    oss << "    \"isSarvarthaSiddhi\": " << (panchanga.isSarvarthaSiddhi ? "true" : "false") << ",\n";
-    oss << "    \"isAmritaSiddhi\": " << (panchanga.isAmritaSiddhi ? "true" : "false") << ",\n";
-    oss << "    \"isDwipushkar\": " << (panchanga.isDwipushkar ? "true" : "false") << ",\n";
-    oss << "    \"isTripushkar\": " << (panchanga.isTripushkar ? "true" : "false") << ",\n";
-    oss << "    \"isRaviPushya\": " << (panchanga.isRaviPushya ? "true" : "false") << ",\n";
-    oss << "    \"isGuruPushya\": " << (panchanga.isGuruPushya ? "true" : "false") << "\n";
-    oss << "  },\n";
-
-    oss << "  \"directions\": {\n";
-    oss << "    \"dishaShool\": \"" << panchanga.dishaShool << "\",\n";
-    oss << "    \"nakshatraShool\": \"" << panchanga.nakshatraShool << "\"\n";
-    oss << "  },\n";
-
-    oss << "  \"festivals\": [";
-    for (size_t i = 0; i < panchanga.festivals.size(); ++i) {
-        oss << "\"" << panchanga.festivals[i] << "\"";
-        if (i < panchanga.festivals.size() - 1) oss << ", ";
-    }
-    oss << "],\n";
-
-    oss << "  \"ekadashiNames\": [";
-    for (size_t i = 0; i < panchanga.ekadashiNames.size(); ++i) {
-        oss << "\"" << panchanga.ekadashiNames[i] << "\"";
-        if (i < panchanga.ekadashiNames.size() - 1) oss << ", ";
-    }
-    oss << "],\n";
-
-    oss << "  \"vrataUpavas\": [";
-    for (size_t i = 0; i < panchanga.vrataList.size(); ++i) {
-        oss << "\"" << panchanga.vrataList[i] << "\"";
-        if (i < panchanga.vrataList.size() - 1) oss << ", ";
-    }
-    oss << "],\n";
-
-    oss << "  \"chandraBalam\": [";
-    for (size_t i = 0; i < panchanga.goodChandraBalam.size(); ++i) {
-        oss << "\"" << getRashiName(panchanga.goodChandraBalam[i]) << "\"";
-        if (i < panchanga.goodChandraBalam.size() - 1) oss << ", ";
-    }
-    oss << "],\n";
-
-    oss << "  \"taraBalam\": [";
-    for (size_t i = 0; i < panchanga.goodTaraBalam.size(); ++i) {
-        oss << "\"" << getNakshatraName(panchanga.goodTaraBalam[i]) << "\"";
-        if (i < panchanga.goodTaraBalam.size() - 1) oss << ", ";
-    }
-    oss << "],\n";
-
-    oss << "  \"muhurta\": {\n";
-    oss << "    \"isShubha\": " << (panchanga.isShubhaMuhurta ? "true" : "false") << ",\n";
-    oss << "    \"description\": \"" << panchanga.muhurtaDescription << "\"\n";
-    oss << "  }\n";
-    oss << "}";
+    JsonWriter json;
+    json.reserve(4096);
+    writeJSON(json, panchanga);
+    return json.take();
+}
+
+void HinduCalendar::writeJSON(JsonWriter& json, const PanchangaData& panchanga) const {
+    auto timing = [&](const char* name, double start, double end) {
+        json.key(name).beginObject();
+        json.field("start", panchanga.getTimeString(start));
+        json.field("end", panchanga.getTimeString(end));
+        json.endObject();
+    };
 
-    return oss.str();
+    json.beginObject();
+
+    json.key("panchangaBasics").beginObject();
+    json.key("tithi").beginObject();
+    json.field("number", static_cast<int>(panchanga.tithi));
+    json.field("name", getTithiName(panchanga.tithi));
+    json.field("endTime", panchanga.getTimeString(panchanga.tithiEndTime));
+    json.endObject();
+    json.key("vara").beginObject();
+    json.field("number", static_cast<int>(panchanga.vara));
+    json.field("name", getVaraName(panchanga.vara));
+    json.endObject();
+    json.key("nakshatra").beginObject();
+    json.field("number", static_cast<int>(panchanga.nakshatra));
+    json.field("name", getNakshatraName(panchanga.nakshatra));
+    json.field("pada", panchanga.nakshatraPada);
+    json.field("endTime", panchanga.getTimeString(panchanga.nakshatraEndTime));
+    json.endObject();
+    json.key("yoga").beginObject();
+    json.field("number", static_cast<int>(panchanga.yoga));
+    json.field("name", getYogaName(panchanga.yoga));
+    json.field("endTime", panchanga.getTimeString(panchanga.yogaEndTime));
+    json.endObject();
+    json.key("karana").beginObject();
+    json.field("number", static_cast<int>(panchanga.karana));
+    json.field("name", getKaranaName(panchanga.karana));
+    json.field("endTime", panchanga.getTimeString(panchanga.karanaEndTime));
+    json.endObject();
+    json.endObject();
+
+    json.key("dateInformation").beginObject();
+    json.field("vikramYear", panchanga.vikramYear);
+    json.field("shakaYear", panchanga.shakaYear);
+    json.field("kaliyugaYear", panchanga.kaliyugaYear);
+    json.field("month", getHinduMonthName(panchanga.month));
+    json.field("paksha", panchanga.isShukla ? "Shukla" : "Krishna");
+    json.field("julianDay", panchanga.julianDay);
+    json.endObject();
+
+    json.key("sunMoonInformation").beginObject();
+    json.field("sunrise", panchanga.getTimeString(panchanga.sunriseTime));
+    json.field("sunset", panchanga.getTimeString(panchanga.sunsetTime));
+    json.field("moonrise", panchanga.getTimeString(panchanga.moonriseTime));
+    json.field("moonset", panchanga.getTimeString(panchanga.moonsetTime));
+    json.field("dayLength", panchanga.dayLength);
+    json.field("nightLength", panchanga.nightLength);
+    json.endObject();
+
+    json.key("celestial").beginObject();
+    json.field("sunLongitude", panchanga.sunLongitude);
+    json.field("moonLongitude", panchanga.moonLongitude);
+    json.field("lunarPhase", panchanga.lunarPhase);
+    json.field("sunRashi", getRashiName(panchanga.sunRashi));
+    json.field("moonRashi", getRashiName(panchanga.moonRashi));
+    json.field("ayanamsaValue", panchanga.ayanamsaValue);
+    json.field("ritu", panchanga.ritu);
+    json.field("ayana", panchanga.ayana);
+    json.endObject();
+
+    json.key("auspiciousTimings").beginObject();
+    timing("brahmaMuhurta", panchanga.brahmaMuhurtaStart, panchanga.brahmaMuhurtaEnd);
+    timing("abhijitMuhurta", panchanga.abhijitStart, panchanga.abhijitEnd);
+    timing("godhuliBela", panchanga.godhuliBelStart, panchanga.godhuliBelEnd);
+    timing("nishitaMuhurta", panchanga.nishitaMuhurtaStart, panchanga.nishitaMuhurtaEnd);
+    json.endObject();
+
+    json.key("inauspiciousTimings").beginObject();
+    timing("rahuKaal", panchanga.rahuKaalStart, panchanga.rahuKaalEnd);
+    timing("yamaganda", panchanga.yamagandaStart, panchanga.yamagandaEnd);
+    timing("gulikai", panchanga.gulikaiStart, panchanga.gulikaiEnd);
+    timing("durMuhurtam", panchanga.durMuhurtamStart, panchanga.durMuhurtamEnd);
+    json.key("varjyam").beginArray();
+    for (const auto& period : panchanga.varjyamTimes) {
+        json.beginObject();
+        json.field("start", panchanga.getTimeString(period.first));
+        json.field("end", panchanga.getTimeString(period.second));
+        json.endObject();
+    }
+    json.endArray();
+    json.endObject();
+
+    json.key("specialDays").beginObject();
+    json.field("isEkadashi", panchanga.isEkadashi);
+    json.field("isPurnima", panchanga.isPurnima);
+    json.field("isAmavasya", panchanga.isAmavasya);
+    json.field("isSankranti", panchanga.isSankranti);
+    json.field("isNavratri", panchanga.isNavratri);
+    json.field("isGandaMool", panchanga.isGandaMool);
+    json.field("isPanchak", panchanga.isPanchak);
+    json.field("isBhadra", panchanga.isBhadra);
+    json.field("isFastingDay", panchanga.isFastingDay);
+    json.endObject();
+
+    json.key("specialYogas").beginObject();
+    json.field("isSarvarthaSiddhi", panchanga.isSarvarthaSiddhi);
+    json.field("isAmritaSiddhi", panchanga.isAmritaSiddhi);
+    json.field("isDwipushkar", panchanga.isDwipushkar);
+    json.field("isTripushkar", panchanga.isTripushkar);
+    json.field("isRaviPushya", panchanga.isRaviPushya);
+    json.field("isGuruPushya", panchanga.isGuruPushya);
+    json.endObject();
+
+    json.key("directions").beginObject();
+    json.field("dishaShool", panchanga.dishaShool);
+    json.field("nakshatraShool", panchanga.nakshatraShool);
+    json.endObject();
+
+    json.arrayField("festivals", panchanga.festivals);
+    json.arrayField("ekadashiNames", panchanga.ekadashiNames);
+    json.arrayField("vrataUpavas", panchanga.vrataList);
+
+    json.key("chandraBalam").beginArray();
+    for (Rashi rashi : panchanga.goodChandraBalam) {
+        json.value(getRashiName(rashi));
+    }
+    json.endArray();
+
+    json.key("taraBalam").beginArray();
+    for (HinduNakshatra nakshatra : panchanga.goodTaraBalam) {
+        json.value(getNakshatraName(nakshatra));
+    }
+    json.endArray();
+
+    json.key("muhurta").beginObject();
+    json.field("isShubha", panchanga.isShubhaMuhurta);
+    json.field("description", panchanga.muhurtaDescription);
+    json.endObject();
+
+    json.endObject();
 }
 
 std::string HinduCalendar::generateCSV(const std::vector<PanchangaData>& panchangaList) const {
@@ -1971,6 +2810,7 @@ bool HinduCalendar::parseDate(const std::string& dateStr, int& year, int& month,
 
 // Main search function - comprehensive Hindu calendar search
 std::vector<HinduCalendar::SearchResult> HinduCalendar::searchHinduCalendar(const SearchCriteria& criteria, double latitude, double longitude) const {
+    ASTRO_PROFILE_SCOPE("HinduCalendar::searchHinduCalendar");
     std::vector<SearchResult> results;
 
     if (!initialized) {
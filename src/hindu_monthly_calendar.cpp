@@ -1,4 +1,7 @@
 #include "hindu_monthly_calendar.h"
+#include "profiler.h"
+#include "json_writer.h"
+#include "display_width.h"
 #include "ephemeris_manager.h"
 #include <iostream>
 #include <iomanip>
@@ -6,6 +9,7 @@
 #include <algorithm>
 #include <cmath>
 #include <ctime>
+#include <cstdio>
 #include <cstdlib>
 #include <map>
 
@@ -70,10 +74,34 @@ void HinduMonthlyCalendar::setDisplayOptions(const DisplayOptions& options) {
 }
 
 HinduMonthlyCalendar::MonthlyData HinduMonthlyCalendar::generateMonthlyData(int year, int month) const {
+    ASTRO_PROFILE_SCOPE("HinduMonthlyCalendar::generateMonthlyData");
     if (!initialized) {
         throw std::runtime_error("Hindu Monthly Calendar not initialized");
     }
 
+    MonthlyData monthData = createMonthlyData(year, month);
+
+    // Calculate daily panchanga for each day of the month
+    for (int day = 1; day <= monthData.daysInMonth; day++) {
+        double jd = calculateJulianDay(year, month, day, monthData.isBCYear);
+        appendDay(monthData, jd, hinduCalendar.calculatePanchanga(jd, latitude, longitude));
+    }
+
+    completeMonthlyData(monthData);
+    return monthData;
+}
+
+HinduMonthlyCalendar::MonthlyData HinduMonthlyCalendar::generateMonthlyData(const CalendarMonthDays& monthDays) const {
+    ASTRO_PROFILE_SCOPE("HinduMonthlyCalendar::generateMonthlyData");
+    MonthlyData monthData = createMonthlyData(monthDays.year, monthDays.month);
+    for (const auto& day : monthDays.days) {
+        appendDay(monthData, day.julianDay, day.panchanga);
+    }
+    completeMonthlyData(monthData);
+    return monthData;
+}
+
+HinduMonthlyCalendar::MonthlyData HinduMonthlyCalendar::createMonthlyData(int year, int month) const {
     MonthlyData monthData;
     monthData.year = year;
     monthData.month = month;
@@ -81,26 +109,24 @@ HinduMonthlyCalendar::MonthlyData HinduMonthlyCalendar::generateMonthlyData(int
     monthData.daysInMonth = getDaysInMonth(year, month);
     monthData.firstDayWeekday = getFirstDayOfMonth(year, month);
     monthData.monthName = getMonthName(month);
+    return monthData;
+}
 
-    // Calculate daily panchanga for each day of the month
-    for (int day = 1; day <= monthData.daysInMonth; day++) {
-        double jd = calculateJulianDay(year, month, day, monthData.isBCYear);
-        monthData.julianDays.push_back(jd);
-
-        // Calculate panchanga for this day
-        PanchangaData panchanga = hinduCalendar.calculatePanchanga(jd, latitude, longitude);
-        monthData.dailyPanchanga.push_back(panchanga);
+void HinduMonthlyCalendar::appendDay(MonthlyData& monthData, double julianDay, const PanchangaData& panchanga) const {
+    monthData.julianDays.push_back(julianDay);
+    monthData.dailyPanchanga.push_back(panchanga);
 
-        // Format dates
-        std::stringstream gregorianDate;
-        gregorianDate << std::setfill('0') << std::setw(2) << day;
-        monthData.gregorianDates.push_back(gregorianDate.str());
+    // Format dates
+    std::stringstream gregorianDate;
+    gregorianDate << std::setfill('0') << std::setw(2) << monthData.dailyPanchanga.size();
+    monthData.gregorianDates.push_back(gregorianDate.str());
 
-        std::stringstream hinduDate;
-        hinduDate << panchanga.day << "/" << static_cast<int>(panchanga.month);
-        monthData.hinduDates.push_back(hinduDate.str());
-    }
+    std::stringstream hinduDate;
+    hinduDate << panchanga.day << "/" << static_cast<int>(panchanga.month);
+    monthData.hinduDates.push_back(hinduDate.str());
+}
 
+void HinduMonthlyCalendar::completeMonthlyData(MonthlyData& monthData) const {
     // Set Hindu year and month from first day
     if (!monthData.dailyPanchanga.empty()) {
         monthData.hinduYear = monthData.dailyPanchanga[0].vikramYear;
@@ -113,8 +139,6 @@ HinduMonthlyCalendar::MonthlyData HinduMonthlyCalendar::generateMonthlyData(int
     // Calculate monthly summaries
     calculateMonthlySummary(monthData);
     identifyMonthlyFestivals(monthData);
-
-    return monthData;
 }
 
 HinduMonthlyCalendar::MonthlyData HinduMonthlyCalendar::generateMonthlyData(const std::string& dateStr) const {
@@ -131,7 +155,11 @@ HinduMonthlyCalendar::MonthlyData HinduMonthlyCalendar::generateMonthlyData(cons
 }
 
 std::string HinduMonthlyCalendar::generateCalendar(int year, int month) const {
-    MonthlyData monthData = generateMonthlyData(year, month);
+    return generateCalendar(generateMonthlyData(year, month));
+}
+
+std::string HinduMonthlyCalendar::generateCalendar(const MonthlyData& monthData) const {
+    ASTRO_PROFILE_SCOPE("HinduMonthlyCalendar::generateCalendar");
     return generateEnhancedHinduCalendar(monthData);
 }
 
@@ -147,8 +175,10 @@ std::string HinduMonthlyCalendar::generateCalendar(const std::string& dateStr) c
 }
 
 std::string HinduMonthlyCalendar::generateHTMLCalendar(int year, int month) const {
-    MonthlyData monthData = generateMonthlyData(year, month);
+    return generateHTMLCalendar(generateMonthlyData(year, month));
+}
 
+std::string HinduMonthlyCalendar::generateHTMLCalendar(const MonthlyData& monthData) const {
     std::stringstream html;
 
     // HTML header
@@ -183,6 +213,43 @@ HinduMonthlyCalendar::MonthlyData HinduMonthlyCalendar::generateBCMonthlyData(in
     return generateMonthlyData(-bcYear, month);
 }
 
+std::vector<HinduMonthlyCalendar::MonthlyData> HinduMonthlyCalendar::generateMultipleMonthsData(
+    int startYear, int startMonth, int endYear, int endMonth) const {
+    if (!initialized) {
+        throw std::runtime_error("Hindu Monthly Calendar not initialized");
+    }
+
+    std::vector<MonthlyData> months;
+    int count = (endYear - startYear) * 12 + (endMonth - startMonth) + 1;
+    if (count < 1) {
+        return months;
+    }
+
+    CalendarDayStream stream;
+    stream.setLocation(latitude, longitude);
+    stream.setAyanamsa(displayOptions.ayanamsa, displayOptions.calculationMethod);
+    stream.setIncludeMyanmar(false);
+
+    std::vector<CalendarMonthDays> days;
+    if (!stream.generate(startYear, startMonth, count, days)) {
+        throw std::runtime_error(stream.getLastError());
+    }
+
+    months.reserve(days.size());
+    for (const auto& monthDays : days) {
+        months.push_back(generateMonthlyData(monthDays));
+    }
+    return months;
+}
+
+std::vector<std::string> HinduMonthlyCalendar::generateMultipleMonths(int startYear, int startMonth,
+                                                                      int endYear, int endMonth) const {
+    std::vector<MonthlyData> months = generateMultipleMonthsData(startYear, startMonth, endYear, endMonth);
+    return CalendarDayStream::renderPages(months.size(), 0, [&](size_t i) {
+        return displayOptions.htmlOutput ? generateHTMLCalendar(months[i]) : generateCalendar(months[i]);
+    });
+}
+
 // Helper methods implementation
 
 bool HinduMonthlyCalendar::isLeapYear(int year) const {
@@ -288,17 +355,8 @@ std::string HinduMonthlyCalendar::formatDateCell(const PanchangaData& panchanga,
         cellContent = highlightSpecialDay(panchanga, cellContent);
     }
 
-    // Pad to cell width
-    while (cellContent.length() < static_cast<size_t>(displayOptions.cellWidth)) {
-        cellContent += " ";
-    }
-
-    // Truncate if too long
-    if (cellContent.length() > static_cast<size_t>(displayOptions.cellWidth)) {
-        cellContent = cellContent.substr(0, displayOptions.cellWidth);
-    }
-
-    return cellContent;
+    // Pad or truncate to the cell width; highlight colors take no columns
+    return padToWidth(truncateToWidth(cellContent, displayOptions.cellWidth), displayOptions.cellWidth);
 }
 
 std::string HinduMonthlyCalendar::formatWeekdayHeaders() const {
@@ -402,12 +460,8 @@ std::string HinduMonthlyCalendar::generateEnhancedHinduCalendar(const MonthlyDat
                                monthData.hinduMonthName + " " + std::to_string(monthData.hinduYear) + " VS | " +
                                monthData.currentRitu + " (" + monthData.currentAyana + ")";
 
-    size_t targetLength = 80; // Target width inside borders
-    if (headerContent.length() < targetLength) {
-        for (size_t i = headerContent.length(); i < targetLength; i++) {
-            ss << " ";
-        }
-    }
+    int targetWidth = 80; // Target width inside borders
+    ss << std::string(std::max(0, targetWidth - displayWidth(headerContent)), ' ');
     ss << "║\n";
     ss << "╚══════════════════════════════════════════════════════════════════════════════════╝\n\n";
 
@@ -623,14 +677,8 @@ std::string HinduMonthlyCalendar::formatEnhancedDateCell(const PanchangaData& pa
 
     std::string result = ss.str();
 
-    // Ensure exactly 15 characters
-    if (result.length() > 15) {
-        result = result.substr(0, 15);
-    } else if (result.length() < 15) {
-        result += std::string(15 - result.length(), ' ');
-    }
-
-    return result;
+    // Ensure exactly 15 columns
+    return padToWidth(truncateToWidth(result, 15), 15);
 }
 
 std::string HinduMonthlyCalendar::formatEnhancedQualityCell(const PanchangaData& panchanga, const MonthlyData& monthData) const {
@@ -682,13 +730,8 @@ std::string HinduMonthlyCalendar::formatEnhancedQualityCell(const PanchangaData&
 
     ss << moonPhase;
 
-    // Ensure exactly 15 characters
-    std::string result = ss.str();
-    if (result.length() > 15) {
-        result = result.substr(0, 15);
-    } else if (result.length() < 15) {
-        result += std::string(15 - result.length(), ' ');
-    }    return result;
+    // Ensure exactly 15 columns
+    return padToWidth(truncateToWidth(ss.str(), 15), 15);
 }
 
 std::string HinduMonthlyCalendar::highlightSpecialDay(const PanchangaData& panchanga,
@@ -824,6 +867,16 @@ bool HinduMonthlyCalendar::parseDate(const std::string& dateStr, int& year, int&
     return true;
 }
 
+bool HinduMonthlyCalendar::parseMonth(const std::string& dateStr, int& year, int& month) const {
+    int day;
+    bool isBCDate;
+    try {
+        return parseDate(dateStr, year, month, day, isBCDate) && month >= 1 && month <= 12;
+    } catch (const std::exception&) {
+        return false;
+    }
+}
+
 double HinduMonthlyCalendar::calculateJulianDay(int year, int month, int day, bool isBCDate) const {
     // Use Swiss Ephemeris Julian Day calculation which handles BC dates
     double jd;
@@ -914,66 +967,57 @@ std::string HinduMonthlyCalendar::exportToCSV(const MonthlyData& monthData) cons
 }
 
 std::string HinduMonthlyCalendar::exportToJSON(const MonthlyData& monthData) const {
-    std::stringstream json;
-
-    json << "{\n";
-    json << "  \"year\": " << monthData.year << ",\n";
-    json << "  \"month\": " << monthData.month << ",\n";
-    json << "  \"isBCYear\": " << (monthData.isBCYear ? "true" : "false") << ",\n";
-    json << "  \"monthName\": \"" << monthData.monthName << "\",\n";
-    json << "  \"hinduYear\": " << monthData.hinduYear << ",\n";
-    json << "  \"hinduMonthName\": \"" << monthData.hinduMonthName << "\",\n";
-    json << "  \"currentRitu\": \"" << monthData.currentRitu << "\",\n";
-    json << "  \"currentAyana\": \"" << monthData.currentAyana << "\",\n";
-    json << "  \"daysInMonth\": " << monthData.daysInMonth << ",\n";
-    json << "  \"ekadashiCount\": " << monthData.ekadashiCount << ",\n";
-    json << "  \"purnimaCount\": " << monthData.purnimaCount << ",\n";
-    json << "  \"amavasyaCount\": " << monthData.amavasyaCount << ",\n";
-    json << "  \"days\": [\n";
-
+    JsonWriter json;
+    json.reserve(1024 + monthData.dailyPanchanga.size() * 640);
+    json.beginObject();
+    json.field("year", monthData.year);
+    json.field("month", monthData.month);
+    json.field("isBCYear", monthData.isBCYear);
+    json.field("monthName", monthData.monthName);
+    json.field("hinduYear", monthData.hinduYear);
+    json.field("hinduMonthName", monthData.hinduMonthName);
+    json.field("currentRitu", monthData.currentRitu);
+    json.field("currentAyana", monthData.currentAyana);
+    json.field("daysInMonth", monthData.daysInMonth);
+    json.field("ekadashiCount", monthData.ekadashiCount);
+    json.field("purnimaCount", monthData.purnimaCount);
+    json.field("amavasyaCount", monthData.amavasyaCount);
+
+    json.key("days").beginArray();
     for (size_t i = 0; i < monthData.dailyPanchanga.size(); i++) {
         const auto& panchanga = monthData.dailyPanchanga[i];
-
-        json << "    {\n";
-        json << "      \"day\": " << (i + 1) << ",\n";
-        json << "      \"gregorianDate\": \"" << monthData.year << "-"
-             << std::setfill('0') << std::setw(2) << monthData.month
-             << "-" << std::setw(2) << (i + 1) << "\",\n";
-        json << "      \"hinduDate\": \"" << monthData.hinduDates[i] << "\",\n";
-        json << "      \"julianDay\": " << monthData.julianDays[i] << ",\n";
-        json << "      \"tithi\": " << static_cast<int>(panchanga.tithi) << ",\n";
-        json << "      \"tithiName\": \"" << getTithiName(panchanga.tithi) << "\",\n";
-        json << "      \"nakshatra\": " << static_cast<int>(panchanga.nakshatra) << ",\n";
-        json << "      \"nakshatraName\": \"" << getNakshatraName(panchanga.nakshatra) << "\",\n";
-        json << "      \"yoga\": " << static_cast<int>(panchanga.yoga) << ",\n";
-        json << "      \"yogaName\": \"" << hinduCalendar.getYogaName(panchanga.yoga) << "\",\n";
-        json << "      \"karana\": " << static_cast<int>(panchanga.karana) << ",\n";
-        json << "      \"karanaName\": \"" << hinduCalendar.getKaranaName(panchanga.karana) << "\",\n";
-        json << "      \"isEkadashi\": " << (panchanga.isEkadashi ? "true" : "false") << ",\n";
-        json << "      \"isPurnima\": " << (panchanga.isPurnima ? "true" : "false") << ",\n";
-        json << "      \"isAmavasya\": " << (panchanga.isAmavasya ? "true" : "false") << ",\n";
-        json << "      \"isSankranti\": " << (panchanga.isSankranti ? "true" : "false") << ",\n";
-        json << "      \"festivals\": [";
-        for (size_t j = 0; j < panchanga.festivals.size(); j++) {
-            if (j > 0) json << ", ";
-            json << "\"" << panchanga.festivals[j] << "\"";
-        }
-        json << "]\n";
-        json << "    }";
-        if (i < monthData.dailyPanchanga.size() - 1) json << ",";
-        json << "\n";
-    }
-
-    json << "  ],\n";
-    json << "  \"monthlyFestivals\": [";
-    for (size_t i = 0; i < monthData.monthlyFestivals.size(); i++) {
-        if (i > 0) json << ", ";
-        json << "\"" << monthData.monthlyFestivals[i] << "\"";
-    }
-    json << "]\n";
-    json << "}\n";
-
-    return json.str();
+        char gregorianDate[16];
+        std::snprintf(gregorianDate, sizeof(gregorianDate), "%d-%02d-%02d",
+                      monthData.year, monthData.month, static_cast<int>(i + 1));
+
+        json.beginObject();
+        json.field("day", i + 1);
+        json.field("gregorianDate", gregorianDate);
+        json.field("hinduDate", monthData.hinduDates[i]);
+        json.field("julianDay", monthData.julianDays[i]);
+        json.field("tithi", static_cast<int>(panchanga.tithi));
+        json.field("tithiName", getTithiName(panchanga.tithi));
+        json.field("nakshatra", static_cast<int>(panchanga.nakshatra));
+        json.field("nakshatraName", getNakshatraName(panchanga.nakshatra));
+        json.field("yoga", static_cast<int>(panchanga.yoga));
+        json.field("yogaName", hinduCalendar.getYogaName(panchanga.yoga));
+        json.field("karana", static_cast<int>(panchanga.karana));
+        json.field("karanaName", hinduCalendar.getKaranaName(panchanga.karana));
+        json.field("isEkadashi", panchanga.isEkadashi);
+        json.field("isPurnima", panchanga.isPurnima);
+        json.field("isAmavasya", panchanga.isAmavasya);
+        json.field("isSankranti", panchanga.isSankranti);
+        json.arrayField("festivals", panchanga.festivals);
+        json.endObject();
+    }
+    json.endArray();
+
+    json.arrayField("monthlyFestivals", monthData.monthlyFestivals);
+    json.endObject();
+
+    std::string result = json.take();
+    result += '\n';
+    return result;
 }
 
 std::string HinduMonthlyCalendar::exportToXML(const MonthlyData& monthData) const {
@@ -1,4 +1,5 @@
 #include "horoscope_calculator.h"
+#include "profiler.h"
 #include <algorithm>
 
 namespace Astro {
@@ -29,6 +30,7 @@ bool HoroscopeCalculator::initialize(const std::string& ephemerisPath) {
 bool HoroscopeCalculator::calculateBirthChart(const BirthData& birthData,
                                             HouseSystem houseSystem,
                                             BirthChart& chart) {
+    ASTRO_PROFILE_SCOPE("HoroscopeCalculator::calculateBirthChart");
     if (!initialized) {
         lastError = "Calculator not initialized";
         return false;
@@ -81,6 +83,7 @@ bool HoroscopeCalculator::calculateBirthChart(const BirthData& birthData,
     // Set all data in chart
     chart.setPlanetPositions(planetPositions);
     chart.setHouseCusps(houseCusps);
+    chart.setHouseSystem(houseSystem);
     chart.setAspects(aspects);
 
     return true;
@@ -0,0 +1,193 @@
+#include "json_writer.h"
+#include <charconv>
+#include <cmath>
+#include <ostream>
+#include <stdexcept>
+
+namespace Astro {
+
+namespace {
+
+JsonStyle globalDefaultStyle = JsonStyle::PRETTY;
+
+const char HEX_DIGITS[] = "0123456789abcdef";
+
+} // namespace
+
+JsonWriter::JsonWriter(JsonStyle style)
+    : style(style), depth(0), nonEmptyLevels(0), afterKey(false) {
+}
+
+void JsonWriter::setDefaultStyle(JsonStyle style) {
+    globalDefaultStyle = style;
+}
+
+JsonStyle JsonWriter::defaultStyle() {
+    return globalDefaultStyle;
+}
+
+void JsonWriter::newline() {
+    if (style == JsonStyle::PRETTY) {
+        out += '\n';
+        out.append(static_cast<size_t>(depth) * 2, ' ');
+    }
+}
+
+void JsonWriter::beginItem() {
+    if (afterKey) {
+        afterKey = false;
+        return;
+    }
+    if (depth == 0) {
+        return;
+    }
+
+    uint64_t bit = 1ull << (depth - 1);
+    if (nonEmptyLevels & bit) {
+        out += ',';
+    }
+    nonEmptyLevels |= bit;
+    newline();
+}
+
+JsonWriter& JsonWriter::open(char bracket) {
+    // One bit of nonEmptyLevels per level
+    if (depth >= MAX_DEPTH) {
+        throw std::length_error("JSON nesting deeper than " + std::to_string(MAX_DEPTH) + " levels");
+    }
+    beginItem();
+    out += bracket;
+    nonEmptyLevels &= ~(1ull << depth);
+    depth++;
+    return *this;
+}
+
+JsonWriter& JsonWriter::close(char bracket) {
+    if (depth == 0) {
+        throw std::logic_error(std::string("JSON '") + bracket + "' without an open container");
+    }
+    bool hadMembers = (nonEmptyLevels >> (depth - 1)) & 1u;
+    depth--;
+    if (hadMembers) {
+        newline();
+    }
+    out += bracket;
+    return *this;
+}
+
+JsonWriter& JsonWriter::beginObject() {
+    return open('{');
+}
+
+JsonWriter& JsonWriter::endObject() {
+    return close('}');
+}
+
+JsonWriter& JsonWriter::beginArray() {
+    return open('[');
+}
+
+JsonWriter& JsonWriter::endArray() {
+    return close(']');
+}
+
+JsonWriter& JsonWriter::key(std::string_view name) {
+    beginItem();
+    out += '"';
+    appendEscaped(out, name);
+    out += style == JsonStyle::PRETTY ? "\": " : "\":";
+    afterKey = true;
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(std::string_view text) {
+    beginItem();
+    out += '"';
+    appendEscaped(out, text);
+    out += '"';
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(bool flag) {
+    beginItem();
+    out += flag ? "true" : "false";
+    return *this;
+}
+
+JsonWriter& JsonWriter::value(double number) {
+    if (!std::isfinite(number)) {
+        return null();
+    }
+
+    beginItem();
+    char buffer[32];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out.append(buffer, result.ptr);
+    return *this;
+}
+
+JsonWriter& JsonWriter::null() {
+    beginItem();
+    out += "null";
+    return *this;
+}
+
+JsonWriter& JsonWriter::integer(int64_t number) {
+    beginItem();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out.append(buffer, result.ptr);
+    return *this;
+}
+
+JsonWriter& JsonWriter::unsignedInteger(uint64_t number) {
+    beginItem();
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), number);
+    out.append(buffer, result.ptr);
+    return *this;
+}
+
+JsonWriter& JsonWriter::raw(std::string_view json) {
+    beginItem();
+    out.append(json.data(), json.size());
+    return *this;
+}
+
+void JsonWriter::writeTo(std::ostream& os) {
+    os.write(out.data(), static_cast<std::streamsize>(out.size()));
+    out.clear();
+}
+
+void JsonWriter::appendEscaped(std::string& target, std::string_view text) {
+    size_t runStart = 0;
+
+    for (size_t i = 0; i < text.size(); i++) {
+        unsigned char c = static_cast<unsigned char>(text[i]);
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;  // UTF-8 bytes and printable ASCII pass through
+        }
+
+        target.append(text.data() + runStart, i - runStart);
+        runStart = i + 1;
+
+        switch (c) {
+            case '"':  target += "\\\""; break;
+            case '\\': target += "\\\\"; break;
+            case '\b': target += "\\b"; break;
+            case '\f': target += "\\f"; break;
+            case '\n': target += "\\n"; break;
+            case '\r': target += "\\r"; break;
+            case '\t': target += "\\t"; break;
+            default: {
+                char escape[6] = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0xF]};
+                target.append(escape, sizeof(escape));
+                break;
+            }
+        }
+    }
+
+    target.append(text.data() + runStart, text.size() - runStart);
+}
+
+} // namespace Astro
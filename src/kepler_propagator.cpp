@@ -0,0 +1,184 @@
+#include "kepler_propagator.h"
+#include "profiler.h"
+#include "swiss_ephemeris.h"
+#include <cmath>
+#include <cstdio>
+
+extern "C" {
+#include "swephexp.h"
+}
+
+namespace Astro {
+
+namespace {
+
+const double DEGREES_TO_RADIANS = M_PI / 180.0;
+const double RADIANS_TO_DEGREES = 180.0 / M_PI;
+
+// Mass of the Sun over that of each planet, as swe_get_orbital_elements
+// uses them for the semimajor axis; its daily motion leaves them out
+double sunMassRatio(int body) {
+    switch (body) {
+        case SE_MERCURY: return 6023600.0;
+        case SE_VENUS: return 408523.719;
+        case SE_EARTH: return 328900.5;
+        case SE_MARS: return 3098703.59;
+        case SE_JUPITER: return 1047.348644;
+        case SE_SATURN: return 3497.9018;
+        case SE_URANUS: return 22902.98;
+        case SE_NEPTUNE: return 19412.26;
+        case SE_PLUTO: return 136566000.0;
+        default: return HUGE_VAL;
+    }
+}
+
+// Solves M = E - e sin E for the eccentric anomaly E by Newton's method,
+// starting from a guess within a few iterations of it; also gives sin E and
+// cos E
+double eccentricAnomaly(double meanAnomaly, double eccentricity, double guess, double& sinE, double& cosE) {
+    double e = guess;
+    for (int i = 0; i < 16; i++) {
+        sinE = std::sin(e);
+        cosE = std::cos(e);
+        double delta = (e - eccentricity * sinE - meanAnomaly) / (1.0 - eccentricity * cosE);
+        e -= delta;
+        if (std::abs(delta) < 1e-6) {
+            // Another step would move E by under 1e-12: turn the sine and
+            // cosine through the last correction instead of recomputing them
+            double c = 1.0 - 0.5 * delta * delta;
+            double s = sinE;
+            sinE = s * c - cosE * delta;
+            cosE = cosE * c + s * delta;
+            return e;
+        }
+    }
+    sinE = std::sin(e);
+    cosE = std::cos(e);
+    return e;
+}
+
+} // namespace
+
+KeplerPropagator::KeplerPropagator(int ephemerisFlags, double resyncDays)
+    : ephemerisFlags(ephemerisFlags & (SEFLG_JPLEPH | SEFLG_SWIEPH | SEFLG_MOSEPH)),
+      resyncDays(resyncDays > 0.0 ? resyncDays : 1.0), planets(SE_NPLANETS) {
+    for (Orbit& orbit : planets) {
+        orbit.valid = false;
+    }
+}
+
+KeplerPropagator::Orbit& KeplerPropagator::orbitFor(int body) {
+    if (body >= 0 && body < static_cast<int>(planets.size())) {
+        return planets[body];
+    }
+    auto it = others.find(body);
+    if (it == others.end()) {
+        it = others.emplace(body, Orbit()).first;
+        it->second.valid = false;
+    }
+    return it->second;
+}
+
+bool KeplerPropagator::synchronize(Orbit& orbit, long epochIndex, int body, char* error) const {
+    ASTRO_PROFILE_COUNT_DETAIL("kepler resync", 1, SwissEphemeris::bodyName(body));
+    if (body == SE_MOON) {
+        if (error) {
+            std::snprintf(error, AS_MAXCH, "the Moon's orbit is not propagated");
+        }
+        orbit.valid = false;
+        return false;
+    }
+
+    double elements[SwissEphemeris::ORBITAL_ELEMENT_COUNT];
+    double epoch = epochIndex * resyncDays;
+    if (SwissEphemeris::orbitalElements(epoch, body, ephemerisFlags | SEFLG_HELCTR | SEFLG_J2000,
+                                        elements, error) < 0) {
+        orbit.valid = false;
+        return false;
+    }
+    if (elements[1] >= 1.0) {
+        if (error) {
+            std::snprintf(error, AS_MAXCH, "orbit of body %d is not elliptic", body);
+        }
+        orbit.valid = false;
+        return false;
+    }
+
+    double semimajorAxis = elements[0];
+    double eccentricity = elements[1];
+    double inclination = elements[2] * DEGREES_TO_RADIANS;
+    double node = elements[3] * DEGREES_TO_RADIANS;
+    double perihelion = elements[4] * DEGREES_TO_RADIANS;     // argument, from the node
+    double semiminorAxis = semimajorAxis * std::sqrt(1.0 - eccentricity * eccentricity);
+
+    double cosNode = std::cos(node), sinNode = std::sin(node);
+    double cosPeri = std::cos(perihelion), sinPeri = std::sin(perihelion);
+    double cosIncl = std::cos(inclination), sinIncl = std::sin(inclination);
+
+    orbit.p[0] = semimajorAxis * (cosNode * cosPeri - sinNode * sinPeri * cosIncl);
+    orbit.p[1] = semimajorAxis * (sinNode * cosPeri + cosNode * sinPeri * cosIncl);
+    orbit.p[2] = semimajorAxis * sinPeri * sinIncl;
+    orbit.q[0] = semiminorAxis * (-cosNode * sinPeri - sinNode * cosPeri * cosIncl);
+    orbit.q[1] = semiminorAxis * (-sinNode * sinPeri + cosNode * cosPeri * cosIncl);
+    orbit.q[2] = semiminorAxis * cosPeri * sinIncl;
+
+    orbit.epochIndex = epochIndex;
+    orbit.epoch = epoch;
+    orbit.eccentricity = eccentricity;
+    orbit.meanAnomaly = elements[6] * DEGREES_TO_RADIANS;
+    orbit.meanMotion = elements[11] * DEGREES_TO_RADIANS * std::sqrt(1.0 + 1.0 / sunMassRatio(body));
+    orbit.lastTime = epoch;
+    orbit.lastAnomaly = elements[8] * DEGREES_TO_RADIANS;
+    orbit.lastRate = orbit.meanMotion / (1.0 - eccentricity * std::cos(orbit.lastAnomaly));
+    orbit.valid = true;
+    return true;
+}
+
+int KeplerPropagator::calc(double julianDayET, int body, double* result, char* error) {
+    Orbit& orbit = orbitFor(body);
+    long epochIndex = std::lround(julianDayET / resyncDays);
+    if ((!orbit.valid || orbit.epochIndex != epochIndex) && !synchronize(orbit, epochIndex, body, error)) {
+        return -1;
+    }
+    if (error) {
+        error[0] = '\0';
+    }
+
+    // Runs walk forward in small steps, so the last anomaly moved on at its
+    // rate is usually within 1e-6 of the answer
+    double e = orbit.eccentricity;
+    double meanAnomaly = orbit.meanAnomaly + orbit.meanMotion * (julianDayET - orbit.epoch);
+    double guess = orbit.lastAnomaly + orbit.lastRate * (julianDayET - orbit.lastTime);
+    if (std::abs(guess - meanAnomaly) > 2.0 * e + 0.1) {
+        guess = meanAnomaly;
+    }
+    double sinE, cosE;
+    double anomaly = eccentricAnomaly(meanAnomaly, e, guess, sinE, cosE);
+    double rate = orbit.meanMotion / (1.0 - e * cosE);       // dE/dt
+    orbit.lastTime = julianDayET;
+    orbit.lastAnomaly = anomaly;
+    orbit.lastRate = rate;
+
+    double x[3], v[3];
+    for (int i = 0; i < 3; i++) {
+        x[i] = (cosE - e) * orbit.p[i] + sinE * orbit.q[i];
+        v[i] = (-sinE * orbit.p[i] + cosE * orbit.q[i]) * rate;
+    }
+
+    // Ecliptic polar coordinates and their rates
+    double rho2 = x[0] * x[0] + x[1] * x[1];
+    double rho = std::sqrt(rho2);
+    double r2 = rho2 + x[2] * x[2];
+    double r = std::sqrt(r2);
+
+    double longitude = std::atan2(x[1], x[0]) * RADIANS_TO_DEGREES;
+    result[0] = longitude < 0.0 ? longitude + 360.0 : longitude;
+    result[1] = std::atan2(x[2], rho) * RADIANS_TO_DEGREES;
+    result[2] = r;
+    result[3] = (x[0] * v[1] - x[1] * v[0]) / rho2 * RADIANS_TO_DEGREES;
+    result[4] = (v[2] * rho2 - x[2] * (x[0] * v[0] + x[1] * v[1])) / (r2 * rho) * RADIANS_TO_DEGREES;
+    result[5] = (x[0] * v[0] + x[1] * v[1] + x[2] * v[2]) / r;
+    return ephemerisFlags | SEFLG_HELCTR | SEFLG_J2000 | SEFLG_TRUEPOS | SEFLG_NONUT | SEFLG_SPEED;
+}
+
+} // namespace Astro
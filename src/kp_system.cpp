@@ -1,4 +1,6 @@
 #include "kp_system.h"
+#include "swiss_ephemeris.h"
+#include "json_writer.h"
 #include "planet_calculator.h"
 #include "ephemeris_manager.h"
 #include "astro_types.h"
@@ -67,7 +69,6 @@ KPSystem::~KPSystem() {
 bool KPSystem::initialize() {
     try {
         initializeNakshatras();
-        initializeSubDivisions();
         isInitialized = true;
         lastError.clear();
         return true;
@@ -91,22 +92,30 @@ void KPSystem::initializeNakshatras() {
     }
 }
 
-void KPSystem::initializeSubDivisions() {
-    subDivisions.clear();
-    subDivisions.resize(27); // 27 nakshatras
-
-    for (int i = 0; i < 27; i++) {
-        const Nakshatra& nak = nakshatras[i];
-
-        // Calculate sub divisions for each level (3, 4, 5)
-        for (int level = 3; level <= 5; level++) {
-            auto divs = calculateSubDivisions(nak, level);
-            subDivisions[i].insert(subDivisions[i].end(), divs.begin(), divs.end());
+const std::vector<std::vector<KPSubDivision>>& KPSystem::sharedSubDivisions() {
+    // The table depends only on constants; build it once, on the first lookup
+    static const std::vector<std::vector<KPSubDivision>> table = [] {
+        std::vector<std::vector<KPSubDivision>> divisions(27);
+
+        for (int i = 0; i < 27; i++) {
+            Nakshatra nak;
+            nak.number = NAKSHATRA_DATA[i].number;
+            nak.startDegree = NAKSHATRA_DATA[i].startDegree;
+            nak.endDegree = (i < 26) ? NAKSHATRA_DATA[i+1].startDegree : 360.0;
+
+            // Sub divisions for each level (3, 4, 5)
+            divisions[i].reserve(9 + 81 + 729);
+            for (int level = 3; level <= 5; level++) {
+                auto divs = calculateSubDivisions(nak, level);
+                divisions[i].insert(divisions[i].end(), divs.begin(), divs.end());
+            }
         }
-    }
+        return divisions;
+    }();
+    return table;
 }
 
-std::vector<KPSubDivision> KPSystem::calculateSubDivisions(const Nakshatra& nakshatra, int level) const {
+std::vector<KPSubDivision> KPSystem::calculateSubDivisions(const Nakshatra& nakshatra, int level) {
     std::vector<KPSubDivision> divisions;
 
     double nakshatraSpan = nakshatra.endDegree - nakshatra.startDegree;
@@ -114,6 +123,7 @@ std::vector<KPSubDivision> KPSystem::calculateSubDivisions(const Nakshatra& naks
 
     // For each level, calculate the subdivisions
     int numDivisions = (level == 3) ? 9 : (level == 4) ? 81 : 729; // 9^(level-2)
+    divisions.reserve(numDivisions);
 
     for (int i = 0; i < numDivisions; i++) {
         KPSubDivision div;
@@ -154,7 +164,7 @@ Planet KPSystem::findSubLord(double longitude, const Nakshatra& nakshatra, int l
     longitude = normalizeKPLongitude(longitude);
 
     // Find appropriate subdivision
-    for (const auto& div : subDivisions[nakshatra.number - 1]) {
+    for (const auto& div : sharedSubDivisions()[nakshatra.number - 1]) {
         if (div.level == level && longitude >= div.startDegree && longitude < div.endDegree) {
             return div.lord;
         }
@@ -361,7 +371,7 @@ double KPSystem::calculatePlanetLongitudeForJD(double julianDay, Planet planet)
     int planetNum = static_cast<int>(planet);
     if (planetNum > 11) return -1; // Skip minor bodies for now
 
-    int32 result = swe_calc_ut(julianDay, planetNum, SEFLG_SWIEPH, pos, serr);
+    int32 result = SwissEphemeris::calcUt(julianDay, planetNum, SEFLG_SWIEPH, pos, serr);
     if (result < 0) {
         return -1; // Calculation failed
     }
@@ -406,6 +416,61 @@ std::string KPSystem::generateTransitionTable(const std::vector<KPTransition>& t
     return table.str();
 }
 
+std::string KPSystem::generateKPTableJSON(const std::vector<PlanetPosition>& planets) const {
+    JsonWriter json;
+    json.reserve(256 + planets.size() * 320);
+    json.beginObject();
+    json.key("kp_analysis").beginArray();
+
+    if (isInitialized) {
+        for (const auto& planet : planets) {
+            KPPosition kpPos = calculateKPPosition(planet.longitude);
+
+            json.beginObject();
+            json.field("planet", planetToString(planet.planet));
+            json.field("longitude", planet.longitude);
+            json.field("sign", zodiacSignToString(kpPos.sign));
+            json.field("sign_lord", planetToString(kpPos.signLord));
+            json.field("nakshatra", kpPos.nakshatra.name);
+            json.field("nakshatra_number", kpPos.nakshatra.number);
+            json.field("star_lord", planetToString(kpPos.nakshatra.lord));
+            json.field("sub_lord", planetToString(kpPos.subLord));
+            json.field("sub_sub_lord", planetToString(kpPos.subSubLord));
+            json.field("sub_sub_sub_lord", planetToString(kpPos.subSubSubLord));
+            json.field("kp_notation", kpPos.getKPNotation());
+            json.endObject();
+        }
+    }
+
+    json.endArray();
+    json.endObject();
+    return json.take();
+}
+
+std::string KPSystem::generateTransitionTableJSON(const std::vector<KPTransition>& transitions) const {
+    JsonWriter json;
+    json.reserve(128 + transitions.size() * 256);
+    json.beginObject();
+    json.key("kp_transitions").beginArray();
+
+    for (const auto& trans : transitions) {
+        json.beginObject();
+        json.field("date", trans.getDateString());
+        json.field("julian_day", trans.julianDay);
+        json.field("planet", planetToString(trans.planet));
+        json.field("level", kpLevelToString(trans.level));
+        json.field("from_lord", planetToString(trans.fromLord));
+        json.field("to_lord", planetToString(trans.toLord));
+        json.field("description", trans.description);
+        json.endObject();
+    }
+
+    json.endArray();
+    json.field("total", transitions.size());
+    json.endObject();
+    return json.take();
+}
+
 // Utility function implementations
 
 double normalizeKPLongitude(double longitude) {
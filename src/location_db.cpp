@@ -0,0 +1,10 @@
+#include "location_db.h"
+
+namespace Astro {
+namespace LocationDB {
+
+// Tables written by tools/location_db_generator into the build directory
+#include "location_db.inc"
+
+} // namespace LocationDB
+} // namespace Astro
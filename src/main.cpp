@@ -14,6 +14,14 @@
 #include "hindu_monthly_calendar.h"
 #include "astro_calendar.h"
 #include "professional_table.h"
+#include "json_writer.h"
+#include "chart_server.h"
+#include "timezone_resolver.h"
+#include "chart_animator.h"
+#include "chart_image_renderer.h"
+#include "calendar_day_stream.h"
+#include "cycle_statistics.h"
+#include "profiler.h"
 #include "swephexp.h"
 #include <iostream>
 #include <string>
@@ -22,11 +30,16 @@
 #include <cstring>
 #include <cstdlib>
 #include <chrono>
+#include <cstdio>
+#include <fstream>
 #include <ctime>
 #include <algorithm>
 #include <sstream>
 #include <iomanip>
 #include <cmath>
+#include <thread>
+#include <atomic>
+#include <mutex>
 
 using namespace Astro;
 
@@ -59,12 +72,52 @@ Planet stringToPlanet(const std::string& planetStr) {
     else return Planet::SUN; // default
 }
 
+// Comma-separated planet names, Sun through Pluto
+bool parsePlanetList(const std::string& list, std::vector<Planet>& planets) {
+    planets.clear();
+    std::stringstream ss(list);
+    std::string name;
+    while (std::getline(ss, name, ',')) {
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        Planet planet = stringToPlanet(name);
+        if (static_cast<int>(planet) > static_cast<int>(Planet::PLUTO) || (planet == Planet::SUN && name != "sun")) {
+            return false;
+        }
+        planets.push_back(planet);
+    }
+    return !planets.empty();
+}
+
+// Comma-separated PLANET-PLANET pairs, or "graha-yuddha" for the ten pairs of the five planets
+bool parsePlanetPairList(const std::string& list, std::vector<std::pair<Planet, Planet>>& pairs) {
+    if (list == "graha-yuddha") {
+        pairs = CycleStatistics::grahaYuddhaPairs();
+        return true;
+    }
+
+    pairs.clear();
+    std::stringstream ss(list);
+    std::string item;
+    while (std::getline(ss, item, ',')) {
+        std::vector<Planet> planets;
+        size_t dash = item.find('-');
+        if (dash == std::string::npos ||
+            !parsePlanetList(item.substr(0, dash) + "," + item.substr(dash + 1), planets) ||
+            planets.size() != 2 || planets[0] == planets[1]) {
+            return false;
+        }
+        pairs.push_back({planets[0], planets[1]});
+    }
+    return !pairs.empty();
+}
+
 struct CommandLineArgs {
     std::string date;
     std::string time;
     double latitude = 0.0;
     double longitude = 0.0;
     double timezone = 0.0;
+    std::string timezoneName;           // IANA zone (--tz); overrides --timezone
     HouseSystem houseSystem = HouseSystem::PLACIDUS;
     ZodiacMode zodiacMode = ZodiacMode::TROPICAL;
     AyanamsaType ayanamsa = AyanamsaType::LAHIRI;
@@ -73,9 +126,23 @@ struct CommandLineArgs {
     std::string chartStyle = "";
     std::string ephemerisPath;
     std::string solarSystemPerspective = "heliocentric";
+    double keplerResyncDays = 0.0;      // > 0: solar-system time-lapse on Kepler orbits
+    int animateStepMinutes = 0;         // > 0: time-lapse of the chart from the birth time
+    int animateFrames = 24;
+    std::string animateOutput = "ansi";
+    int frameDelayMs = 0;
+    std::string imageFile;
+    std::string imageFormat;            // empty: from the file extension
+    std::string imageBatchInput;
+    std::string imageBatchDir;
+    std::string serveSocket;
+    int serveWorkers = 0;
     bool showHelp = false;
     bool showVersion = false;
     bool showFeatures = false;
+    bool showTiming = false;
+    bool showProfile = false;
+    std::string profileFormat = "text";
     bool showSolarSystemOnly = false;
     bool noDrawing = false;
     bool showAstronomicalCoordinates = false;
@@ -84,6 +151,12 @@ struct CommandLineArgs {
     std::string locationName = "";
     std::string searchLocation = "";
     bool listLocations = false;
+    bool nearestLocation = false;
+    bool hasCoordinates = false;        // both --lat and --lon were given
+    int nearestCount = 5;
+    double nearestRadiusKm = -1.0;      // < 0: nearest nearestCount instead
+    std::string reverseGeocodeFile;
+    std::string timezoneOffsetsFile;
 
     // New eclipse and conjunction features
     bool showEclipses = false;
@@ -105,9 +178,21 @@ struct CommandLineArgs {
     std::string grahaYuddhaFromDate;
     std::string grahaYuddhaToDate;
     std::string grahaYuddhaFormat = "table";
+
+    // Long-range cycle statistics
+    bool showCycleStats = false;
+    std::string cycleFromDate;
+    std::string cycleToDate;
+    std::vector<std::pair<Planet, Planet>> cyclePairs = {{Planet::JUPITER, Planet::SATURN}};
+    std::vector<Planet> cycleRetrogradePlanets;
+    double cycleOrb = 1.0;
+    std::string cycleFormat = "text";
+    unsigned cycleThreads = 0;          // 0: one per CPU
     std::string ephemerisFromDate;
     std::string ephemerisToDate;
     int ephemerisIntervalDays = 1;
+    int ephemerisIntervalMinutes = 0;
+    double ephemerisToleranceArcsec = 0.0;
     std::string ephemerisFormat = "table";
     bool ephemerisShowDeclination = false;
     std::string ephemerisCoordinateType = "longitude"; // "longitude", "declination", "both", "3line", "latitude", "distance", or "right-ascension"
@@ -137,6 +222,9 @@ struct CommandLineArgs {
     std::string panchangaToDate;
     std::string panchangaFormat = "table";
     bool showFestivalsOnly = false;
+    std::string festivalRulesFile;
+    bool showFestivalCalendar = false;
+    int festivalCalendarYear = 0;
 
     // Hindu Calendar Search options
     bool showHinduSearch = false;
@@ -394,6 +482,7 @@ struct CommandLineArgs {
     std::string hinduMonthlyCalendarDate; // Format: YYYY-MM for monthly view, supports BC dates
     std::string hinduMonthlyCalendarFormat = "traditional";
     bool hinduMonthlyShowMuhurta = false;
+    int calendarMonths = 1;                // Consecutive months for the monthly calendars
     bool includeGregorian = false;
     bool includeHindu = false;
     bool includePlanetary = false;
@@ -441,6 +530,14 @@ void printHelp() {
     std::cout << "                       • Use time zone at birth time (consider DST)\n";
     std::cout << "                       • Examples: -5 (EST), 1 (CET), 9 (JST)\n\n";
 
+    std::cout << "    --tz ZONE          IANA time zone, e.g. America/New_York, Asia/Kolkata\n";
+    std::cout << "                       • Sets the offset in effect at --date/--time, DST included\n";
+    std::cout << "                       • Historical offsets from the bundled tzdata snapshot\n";
+    std::cout << "                       • --location uses the city's zone automatically\n\n";
+
+    std::cout << "    --tz-offsets FILE  Resolve \"ZONE,YYYY-MM-DD[,HH:MM:SS]\" lines ('-' for stdin)\n";
+    std::cout << "                       • Prints CSV: zone,date,time,utc_offset,dst\n\n";
+
     std::cout << "CHART GENERATION OPTIONS 🎨\n";
     std::cout << "    --house-system SYS House system to use (default: P)\n";
     std::cout << "                       P = Placidus (most common)\n";
@@ -482,16 +579,38 @@ void printHelp() {
     std::cout << "                       solar-system = Orbital view with perspectives\n";
     std::cout << "                       (If not specified, shows basic chart data only)\n\n";
 
+    std::cout << "    --animate MINUTES  Time-lapse of the chart, one frame every MINUTES from the\n";
+    std::cout << "                       birth time (western, north-, south- or east-indian style,\n";
+    std::cout << "                       or solar-system with the heliocentric perspective)\n";
+    std::cout << "    --frames N         Number of time-lapse frames (default: 24)\n";
+    std::cout << "    --animate-output O Time-lapse output (default: ansi)\n";
+    std::cout << "                       ansi   = Redraw in place, updating only changed cells\n";
+    std::cout << "                       stream = Full frames separated by form feeds\n";
+    std::cout << "    --frame-delay MS   Pause between time-lapse frames (default: 0)\n\n";
+
+    std::cout << "    --image FILE       Write the chart as an image instead of text\n";
+    std::cout << "                       (western, north-, south- or east-indian style)\n";
+    std::cout << "                       • .png gives PNG, anything else SVG\n";
+    std::cout << "    --image-batch INPUT DIR\n";
+    std::cout << "                       Render \"id,YYYY-MM-DD,HH:MM:SS,lat,lon,timezone\" lines\n";
+    std::cout << "                       to DIR/id.svg ('-' for stdin); timezone in hours or a zone name\n";
+    std::cout << "    --image-format F   svg or png (default: svg, or from the --image name)\n\n";
+
     std::cout << "    --perspective PER  Solar system perspective (for solar-system style)\n";
     std::cout << "                       heliocentric   = Sun-centered (default)\n";
     std::cout << "                       geocentric     = Earth-centered\n";
     std::cout << "                       mars-centric   = Mars-centered\n";
     std::cout << "                       jupiter-centric = Jupiter-centered\n";
-    std::cout << "                       saturn-centric = Saturn-centered\n\n";
+    std::cout << "                       saturn-centric = Saturn-centered\n";
+    std::cout << "    --kepler-resync DAYS\n";
+    std::cout << "                       Solar-system time-lapse: propagate Kepler orbits, refreshed\n";
+    std::cout << "                       from the ephemeris every DAYS, instead of computing each frame\n";
+    std::cout << "                       (within 0.5\" at 30 days; default: ephemeris every frame)\n\n";
 
     std::cout << "    --output FORMAT    Output format (default: text)\n";
     std::cout << "                       text = Human-readable charts with ASCII art\n";
-    std::cout << "                       json = Complete data structure for APIs\n\n";
+    std::cout << "                       json = Complete data structure for APIs\n";
+    std::cout << "    --json-compact     Write JSON output without whitespace\n\n";
 
     std::cout << "ECLIPSE ANALYSIS OPTIONS 🌚🌞\n";
     std::cout << "    --eclipses         Show eclipses near birth date (±1 year)\n\n";
@@ -558,6 +677,29 @@ void printHelp() {
     std::cout << "                       Maximum orb for planetary wars (default: 1.0)\n";
     std::cout << "                       • Range: 0.1 to 2.0 degrees\n\n";
 
+    std::cout << "    --cycle-stats FROM TO\n";
+    std::cout << "                       Statistics of planetary cycles over a long range\n";
+    std::cout << "                       • Intervals between conjunctions, counts per sign and century\n";
+    std::cout << "                       • Graha Yuddha counts and winners for pairs of the five planets\n";
+    std::cout << "                       • Retrograde durations with --cycle-retrograde\n\n";
+
+    std::cout << "    --cycle-pairs LIST Planet pairs for --cycle-stats (default: jupiter-saturn)\n";
+    std::cout << "                       • Example: jupiter-saturn,mars-venus\n";
+    std::cout << "                       • graha-yuddha = all pairs of Mercury to Saturn\n\n";
+
+    std::cout << "    --cycle-retrograde LIST\n";
+    std::cout << "                       Planets whose retrograde periods to measure\n";
+    std::cout << "                       • Example: mercury,venus,mars\n\n";
+
+    std::cout << "    --cycle-orb DEGREES\n";
+    std::cout << "                       Graha Yuddha: largest latitude difference at the\n";
+    std::cout << "                       conjunction (default: 1.0)\n\n";
+
+    std::cout << "    --cycle-format FORMAT\n";
+    std::cout << "                       text (default) or json\n\n";
+
+    std::cout << "    --cycle-threads N  Worker threads for --cycle-stats (default: one per CPU)\n\n";
+
     std::cout << "EPHEMERIS TABLE OPTIONS 📊📈\n";
     std::cout << "    --ephemeris        Generate ephemeris table\n\n";
 
@@ -566,7 +708,12 @@ void printHelp() {
 
     std::cout << "    --ephemeris-interval DAYS\n";
     std::cout << "                       Days between entries (default: 1)\n";
-    std::cout << "                       • 1 = daily, 7 = weekly, 30 = monthly\n\n";
+    std::cout << "                       • 1 = daily, 7 = weekly, 30 = monthly\n";
+    std::cout << "                       • 6h, 30m = sub-day steps, with the time shown\n\n";
+    std::cout << "    --ephemeris-tolerance ARCSEC\n";
+    std::cout << "                       Interpolate between exact positions within this error\n";
+    std::cout << "                       (default: 0 = compute every entry exactly);\n";
+    std::cout << "                       0.1 makes minute tables several times faster\n\n";
 
     std::cout << "    --ephemeris-format FORMAT\n";
     std::cout << "                       table = Professional table view (default)\n";
@@ -680,6 +827,18 @@ void printHelp() {
     std::cout << "                       csv   = Comma-separated values\n";
     std::cout << "                       json  = JSON structure\n\n";
 
+    std::cout << "    --festival-rules FILE\n";
+    std::cout << "                       Load regional festival rules (one per line)\n";
+    std::cout << "                       • tithi | <month or *> | <Shukla|Krishna> | <1-15> | Name[; Name]\n";
+    std::cout << "                       • sankranti | <rashi> | Name[; Name]\n";
+    std::cout << "                       • nakshatra | <month or *> | <nakshatra> | Name[; Name]\n\n";
+
+    std::cout << "    --festival-calendar YEAR\n";
+    std::cout << "                       Festival and lunar vrata calendar for a whole year\n";
+    std::cout << "                       • Lists amanta months (with adhika masa) from new moons\n";
+    std::cout << "                       • Evaluates only days where a festival rule can match\n";
+    std::cout << "                       • Use --panchanga-format csv for CSV output\n\n";
+
     std::cout << "    --festivals-only   Show only festivals and special events\n";
     std::cout << "                       • Filters output to show religious observances\n";
     std::cout << "                       • Includes Ekadashi, Purnima, Amavasya\n";
@@ -951,6 +1110,14 @@ void printHelp() {
     std::cout << "                       • Rahu Kaal, Yamaganda, Gulikai periods\n";
     std::cout << "                       • Auspicious and inauspicious timings\n\n";
 
+    std::cout << "    --calendar-months N\n";
+    std::cout << "                       Print N consecutive months (up to 1200) of --hindu-monthly\n";
+    std::cout << "                       and/or --myanmar-monthly from the given month\n";
+    std::cout << "                       • Each day is computed once and shared by both views\n";
+    std::cout << "                       • Given both options, every month prints the Hindu page\n";
+    std::cout << "                         then the Myanmar page\n";
+    std::cout << "                       • Pages are rendered in parallel, output stays in order\n\n";
+
     std::cout << "CALENDAR SYSTEM OPTIONS 📅🌍\n";
     std::cout << "    --include-gregorian\n";
     std::cout << "                       Include Gregorian calendar data (enabled by default)\n";
@@ -999,10 +1166,37 @@ void printHelp() {
     std::cout << "                       • Useful for finding exact spelling\n";
     std::cout << "                       • No calculations performed\n\n";
 
+    std::cout << "    --nearest-location List the known cities nearest to --lat/--lon or --location\n";
+    std::cout << "                       • Shows distance, coordinates and timezone\n";
+    std::cout << "    --nearest-count N  Number of cities to list (default: 5)\n";
+    std::cout << "    --nearest-radius KM  List every city within KM kilometres instead\n\n";
+
+    std::cout << "    --reverse-geocode FILE  Nearest city for each point in FILE ('-' for stdin)\n";
+    std::cout << "                       • One \"latitude,longitude\" per line; extra fields ignored\n";
+    std::cout << "                       • Prints CSV: latitude,longitude,name,country,timezone,distance_km\n\n";
+
     std::cout << "    --ephe-path PATH   Custom path to Swiss Ephemeris data files\n";
     std::cout << "                       • Default: ./data/\n";
     std::cout << "                       • Required files: seas_18.se1, semo_18.se1, etc.\n\n";
 
+    std::cout << "    --timing           Print the time spent in each startup and processing phase\n";
+    std::cout << "                       • Written to stderr when the program exits\n\n";
+
+    std::cout << "    --profile          Print a hierarchical profile of the run: Swiss Ephemeris\n";
+    std::cout << "                       calls by function and body, Panchanga stages, searches,\n";
+    std::cout << "                       formatting and output, with calls and total/self time\n";
+    std::cout << "                       • Written to stderr when the program exits\n";
+    std::cout << "    --profile-format F Profile format: text (default) or json\n\n";
+
+    std::cout << "    --serve SOCKET     Run as a server on a Unix domain socket\n";
+    std::cout << "                       • One JSON request per line, e.g.\n";
+    std::cout << "                         {\"id\":1,\"command\":\"chart\",\"date\":\"1990-01-15\",\"time\":\"14:30:00\",\"location\":\"London\"}\n";
+    std::cout << "                       • Commands: chart, panchanga, myanmar, kp, search-location, nearest-location, stats, ping\n";
+    std::cout << "                       • Calculators stay initialized between requests\n";
+    std::cout << "                       • Stops on SIGINT/SIGTERM and prints latency statistics\n\n";
+
+    std::cout << "    --serve-workers N  Worker threads for --serve (default: one per CPU)\n\n";
+
     std::cout << "    --help, -h         Show this comprehensive help message\n";
     std::cout << "    --features, -f     Show colorful feature showcase\n";
     std::cout << "    --version, -v      Show version and build information\n\n";
@@ -1679,6 +1873,18 @@ bool parseDate(const std::string& dateStr, int& year, int& month, int& day) {
     return Astro::parseBCDate(dateStr, year, month, day);
 }
 
+// True when the date exists in the proleptic Gregorian calendar (swe_julday
+// silently normalizes 2020-13-45, so the day must survive the round trip)
+bool isCalendarDate(int year, int month, int day) {
+    if (month < 1 || month > 12 || day < 1 || day > 31) {
+        return false;
+    }
+    int y, m, d;
+    double hour;
+    swe_revjul(swe_julday(year, month, day, 12.0, SE_GREG_CAL), SE_GREG_CAL, &y, &m, &d, &hour);
+    return y == year && m == month && d == day;
+}
+
 // Helper function to parse dates with BC support for other modules
 bool parseBCDate(const std::string& dateStr, int& year, int& month, int& day) {
     return Astro::parseBCDate(dateStr, year, month, day);
@@ -1715,6 +1921,7 @@ HouseSystem parseHouseSystem(const std::string& hsStr) {
 }
 
 bool parseCommandLine(int argc, char* argv[], CommandLineArgs& args) {
+    bool seenLatitude = false, seenLongitude = false;
     for (int i = 1; i < argc; i++) {
         std::string arg = argv[i];
 
@@ -1738,6 +1945,7 @@ bool parseCommandLine(int argc, char* argv[], CommandLineArgs& args) {
                 std::cerr << "Error: Invalid latitude value\n";
                 return false;
             }
+            seenLatitude = true;
         } else if (arg == "--lon" && i + 1 < argc) {
             try {
                 args.longitude = std::stod(argv[++i]);
@@ -1745,6 +1953,7 @@ bool parseCommandLine(int argc, char* argv[], CommandLineArgs& args) {
                 std::cerr << "Error: Invalid longitude value\n";
                 return false;
             }
+            seenLongitude = true;
         } else if (arg == "--timezone" && i + 1 < argc) {
             try {
                 args.timezone = std::stod(argv[++i]);
@@ -1752,6 +1961,10 @@ bool parseCommandLine(int argc, char* argv[], CommandLineArgs& args) {
                 std::cerr << "Error: Invalid timezone value\n";
                 return false;
             }
+        } else if (arg == "--tz" && i + 1 < argc) {
+            args.timezoneName = argv[++i];
+        } else if (arg == "--tz-offsets" && i + 1 < argc) {
+            args.timezoneOffsetsFile = argv[++i];
         } else if (arg == "--house-system" && i + 1 < argc) {
             args.houseSystem = parseHouseSystem(argv[++i]);
         } else if (arg == "--zodiac-mode" && i + 1 < argc) {
@@ -1777,6 +1990,34 @@ bool parseCommandLine(int argc, char* argv[], CommandLineArgs& args) {
                 std::cerr << "Error: Output format must be 'text' or 'json'\n";
                 return false;
             }
+        } else if (arg == "--serve" && i + 1 < argc) {
+            args.serveSocket = argv[++i];
+        } else if (arg == "--serve-workers" && i + 1 < argc) {
+            try {
+                args.serveWorkers = std::stoi(argv[++i]);
+            } catch (const std::exception&) {
+                args.serveWorkers = -1;
+            }
+            if (args.serveWorkers < 1) {
+                std::cerr << "Error: --serve-workers must be a positive number\n";
+                return false;
+            }
+        } else if (arg == "--timing") {
+            args.showTiming = true;
+        } else if (arg == "--profile") {
+            if (!Profiler::isCompiledIn()) {
+                std::cerr << "Error: --profile is not available in this build (configure with -DHOROSCOPE_PROFILING=ON)\n";
+                return false;
+            }
+            args.showProfile = true;
+        } else if (arg == "--profile-format" && i + 1 < argc) {
+            args.profileFormat = argv[++i];
+            if (args.profileFormat != "text" && args.profileFormat != "json") {
+                std::cerr << "Error: Profile format must be 'text' or 'json'\n";
+                return false;
+            }
+        } else if (arg == "--json-compact") {
+            Astro::JsonWriter::setDefaultStyle(Astro::JsonStyle::COMPACT);
         } else if (arg == "--chart-style" && i + 1 < argc) {
             args.chartStyle = argv[++i];
             if (args.chartStyle != "western" && args.chartStyle != "north-indian" &&
@@ -1785,6 +2026,54 @@ bool parseCommandLine(int argc, char* argv[], CommandLineArgs& args) {
                 std::cerr << "Error: Chart style must be 'western', 'north-indian', 'south-indian', 'east-indian', or 'solar-system'\n";
                 return false;
             }
+        } else if (arg == "--animate" && i + 1 < argc) {
+            try {
+                args.animateStepMinutes = std::stoi(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << "Error: Invalid animation step\n";
+                return false;
+            }
+            if (args.animateStepMinutes <= 0) {
+                std::cerr << "Error: Animation step must be a positive number of minutes\n";
+                return false;
+            }
+        } else if (arg == "--frames" && i + 1 < argc) {
+            try {
+                args.animateFrames = std::stoi(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << "Error: Invalid frame count\n";
+                return false;
+            }
+            if (args.animateFrames <= 0) {
+                std::cerr << "Error: Frame count must be positive\n";
+                return false;
+            }
+        } else if (arg == "--animate-output" && i + 1 < argc) {
+            args.animateOutput = argv[++i];
+            ChartAnimator::Output output;
+            if (!ChartAnimator::parseOutput(args.animateOutput, output)) {
+                std::cerr << "Error: Animation output must be 'ansi' or 'stream'\n";
+                return false;
+            }
+        } else if (arg == "--frame-delay" && i + 1 < argc) {
+            try {
+                args.frameDelayMs = std::stoi(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << "Error: Invalid frame delay\n";
+                return false;
+            }
+        } else if (arg == "--image" && i + 1 < argc) {
+            args.imageFile = argv[++i];
+        } else if (arg == "--image-batch" && i + 2 < argc) {
+            args.imageBatchInput = argv[++i];
+            args.imageBatchDir = argv[++i];
+        } else if (arg == "--image-format" && i + 1 < argc) {
+            args.imageFormat = argv[++i];
+            ChartImageRenderer::Format format;
+            if (!ChartImageRenderer::parseFormat(args.imageFormat, format)) {
+                std::cerr << "Error: Image format must be 'svg' or 'png'\n";
+                return false;
+            }
         } else if (arg == "--ephe-path" && i + 1 < argc) {
             args.ephemerisPath = argv[++i];
         } else if (arg == "--perspective" && i + 1 < argc) {
@@ -1795,6 +2084,17 @@ bool parseCommandLine(int argc, char* argv[], CommandLineArgs& args) {
                 std::cerr << "Error: Perspective must be 'heliocentric', 'geocentric', 'mars-centric', 'jupiter-centric', or 'saturn-centric'\n";
                 return false;
             }
+        } else if (arg == "--kepler-resync" && i + 1 < argc) {
+            try {
+                args.keplerResyncDays = std::stod(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << "Error: Invalid Kepler resync interval\n";
+                return false;
+            }
+            if (args.keplerResyncDays <= 0.0) {
+                std::cerr << "Error: Kepler resync interval must be a positive number of days\n";
+                return false;
+            }
         } else if (arg == "--solar-system") {
             args.showSolarSystemOnly = true;
         } else if (arg == "--no-drawing") {
@@ -1807,6 +2107,26 @@ bool parseCommandLine(int argc, char* argv[], CommandLineArgs& args) {
             args.searchLocation = argv[++i];
         } else if (arg == "--list-locations") {
             args.listLocations = true;
+        } else if (arg == "--nearest-location") {
+            args.nearestLocation = true;
+        } else if (arg == "--nearest-count" && i + 1 < argc) {
+            try {
+                args.nearestCount = std::stoi(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << "Error: Invalid nearest count value\n";
+                return false;
+            }
+            args.nearestLocation = true;
+        } else if (arg == "--nearest-radius" && i + 1 < argc) {
+            try {
+                args.nearestRadiusKm = std::stod(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << "Error: Invalid nearest radius value\n";
+                return false;
+            }
+            args.nearestLocation = true;
+        } else if (arg == "--reverse-geocode" && i + 1 < argc) {
+            args.reverseGeocodeFile = argv[++i];
         } else if (arg == "--eclipses") {
             args.showEclipses = true;
         } else if (arg == "--eclipse-range" && i + 2 < argc) {
@@ -1861,6 +2181,35 @@ bool parseCommandLine(int argc, char* argv[], CommandLineArgs& args) {
                 std::cerr << "Error: Invalid graha yuddha orb value\n";
                 return false;
             }
+        } else if (arg == "--cycle-stats" && i + 2 < argc) {
+            args.cycleFromDate = argv[++i];
+            args.cycleToDate = argv[++i];
+            args.showCycleStats = true;
+        } else if (arg == "--cycle-pairs" && i + 1 < argc) {
+            if (!parsePlanetPairList(argv[++i], args.cyclePairs)) {
+                std::cerr << "Error: Cycle pairs must be PLANET-PLANET[,PLANET-PLANET...] or 'graha-yuddha'\n";
+                return false;
+            }
+        } else if (arg == "--cycle-retrograde" && i + 1 < argc) {
+            if (!parsePlanetList(argv[++i], args.cycleRetrogradePlanets)) {
+                std::cerr << "Error: Retrograde planets must be PLANET[,PLANET...] from Mercury to Pluto\n";
+                return false;
+            }
+        } else if (arg == "--cycle-orb" && i + 1 < argc) {
+            try {
+                args.cycleOrb = std::stod(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << "Error: Invalid cycle orb value\n";
+                return false;
+            }
+        } else if (arg == "--cycle-format" && i + 1 < argc) {
+            args.cycleFormat = argv[++i];
+            if (args.cycleFormat != "text" && args.cycleFormat != "json") {
+                std::cerr << "Error: Cycle format must be 'text' or 'json'\n";
+                return false;
+            }
+        } else if (arg == "--cycle-threads" && i + 1 < argc) {
+            args.cycleThreads = static_cast<unsigned>(std::max(0, std::atoi(argv[++i])));
         } else if (arg == "--ephemeris") {
             args.showEphemerisTable = true;
         } else if (arg == "--ephemeris-range" && i + 2 < argc) {
@@ -1868,12 +2217,34 @@ bool parseCommandLine(int argc, char* argv[], CommandLineArgs& args) {
             args.ephemerisToDate = argv[++i];
             args.showEphemerisTable = true;
         } else if (arg == "--ephemeris-interval" && i + 1 < argc) {
+            // Whole days, or hours and minutes with an h or m suffix
+            std::string value = argv[++i];
+            size_t used = 0;
+            int amount = 0;
             try {
-                args.ephemerisIntervalDays = std::stoi(argv[++i]);
+                amount = std::stoi(value, &used);
             } catch (const std::exception&) {
                 std::cerr << "Error: Invalid ephemeris interval value\n";
                 return false;
             }
+            std::string unit = value.substr(used);
+            if (amount <= 0 || (unit != "" && unit != "d" && unit != "h" && unit != "m")) {
+                std::cerr << "Error: Ephemeris interval must be a positive number of days, or hours/minutes such as 6h or 30m\n";
+                return false;
+            }
+            args.ephemerisIntervalDays = unit.empty() || unit == "d" ? amount : 1;
+            args.ephemerisIntervalMinutes = unit == "h" ? amount * 60 : unit == "m" ? amount : 0;
+        } else if (arg == "--ephemeris-tolerance" && i + 1 < argc) {
+            try {
+                args.ephemerisToleranceArcsec = std::stod(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << "Error: Invalid ephemeris tolerance value\n";
+                return false;
+            }
+            if (args.ephemerisToleranceArcsec < 0.0) {
+                std::cerr << "Error: Ephemeris tolerance must not be negative\n";
+                return false;
+            }
         } else if (arg == "--ephemeris-format" && i + 1 < argc) {
             args.ephemerisFormat = argv[++i];
             if (args.ephemerisFormat != "table" && args.ephemerisFormat != "csv" && args.ephemerisFormat != "json") {
@@ -1981,6 +2352,11 @@ bool parseCommandLine(int argc, char* argv[], CommandLineArgs& args) {
             }
         } else if (arg == "--festivals-only") {
             args.showFestivalsOnly = true;
+        } else if (arg == "--festival-rules" && i + 1 < argc) {
+            args.festivalRulesFile = argv[++i];
+        } else if (arg == "--festival-calendar" && i + 1 < argc) {
+            args.showFestivalCalendar = true;
+            args.festivalCalendarYear = std::atoi(argv[++i]);
 
         // Hindu Calendar Search options
         } else if (arg == "--hindu-search" && i + 2 < argc) {
@@ -2250,6 +2626,17 @@ bool parseCommandLine(int argc, char* argv[], CommandLineArgs& args) {
             }
         } else if (arg == "--hindu-monthly-muhurta") {
             args.hinduMonthlyShowMuhurta = true;
+        } else if (arg == "--calendar-months" && i + 1 < argc) {
+            try {
+                args.calendarMonths = std::stoi(argv[++i]);
+            } catch (const std::exception&) {
+                std::cerr << "Error: Invalid month count\n";
+                return false;
+            }
+            if (args.calendarMonths < 1 || args.calendarMonths > 1200) {
+                std::cerr << "Error: --calendar-months must be between 1 and 1200\n";
+                return false;
+            }
         } else if (arg == "--include-gregorian") {
             args.includeGregorian = true;
         } else if (arg == "--include-hindu") {
@@ -2264,12 +2651,49 @@ bool parseCommandLine(int argc, char* argv[], CommandLineArgs& args) {
         }
     }
 
+    args.hasCoordinates = seenLatitude && seenLongitude;
+    return true;
+}
+
+// Offset of a named zone at the local date and time given on the command
+// line (noon when there is no --time), daylight saving included
+bool zoneOffsetForArgs(const std::string& zone, const CommandLineArgs& args, ZoneOffset& offset, std::string& error) {
+    BirthData local{};
+    if (args.date.empty() || !parseDate(args.date, local.year, local.month, local.day)) {
+        error = "A valid --date is required to resolve time zone " + zone;
+        return false;
+    }
+    local.hour = 12;
+    if (!args.time.empty() && !parseTime(args.time, local.hour, local.minute, local.second)) {
+        error = "Invalid time format. Use HH:MM:SS";
+        return false;
+    }
+
+    TimeZoneResolver resolver;
+    int index = resolver.findZone(zone);
+    if (index < 0) {
+        error = "Unknown time zone \"" + zone + "\"";
+        return false;
+    }
+    offset = resolver.offsetAtLocalTime(index, TimeZoneResolver::toSeconds(
+        local.year, local.month, local.day, local.hour, local.minute, local.second));
     return true;
 }
 
 bool validateArgs(const CommandLineArgs& args) {
+    // --kepler-resync only changes how the solar-system time-lapse is computed
+    if (args.keplerResyncDays > 0.0 &&
+        (args.animateStepMinutes <= 0 || args.chartStyle != "solar-system" ||
+         args.solarSystemPerspective != "heliocentric")) {
+        std::cerr << "Error: --kepler-resync requires --animate with --chart-style solar-system "
+                     "and the heliocentric perspective\n";
+        return false;
+    }
+
     if (args.showHelp || args.showVersion || args.showFeatures || args.showSolarSystemOnly ||
-        args.listLocations || !args.searchLocation.empty()) {
+        args.listLocations || !args.searchLocation.empty() || args.nearestLocation ||
+        !args.reverseGeocodeFile.empty() || !args.timezoneOffsetsFile.empty() ||
+        !args.imageBatchInput.empty()) {
         return true;
     }
 
@@ -2288,6 +2712,16 @@ bool validateArgs(const CommandLineArgs& args) {
         return true;
     }
 
+    // Festival calendar depends only on the Sun and Moon, not on location
+    if (args.showFestivalCalendar) {
+        return true;
+    }
+
+    // Cycle statistics are geocentric and need only the date range
+    if (args.showCycleStats) {
+        return true;
+    }
+
     // Eclipse, ephemeris, panchanga, Myanmar calendar, and Hindu/Myanmar search features can work without full birth data
     if (args.showEclipses || args.showConjunctions || args.showEphemerisTable || args.showKPTransitions ||
         args.showPanchangaRange || args.showMyanmarCalendarRange || args.showHinduSearch || args.showMyanmarSearch ||
@@ -2378,12 +2812,494 @@ BirthData parseDateStringToBirthData(const std::string& dateStr) {
     return birthData;
 }
 
+// Wall-clock time per phase for --timing. Phases are recorded unconditionally
+// (one clock read each) and printed to stderr at exit when enabled.
+class PhaseTimer {
+public:
+    PhaseTimer() : enabled(false), start(Clock::now()), last(start) {}
+
+    ~PhaseTimer() {
+        if (!enabled) return;
+
+        mark("calculation and output");
+        std::fprintf(stderr, "\nTiming (wall clock):\n");
+        for (const auto& phase : phases) {
+            std::fprintf(stderr, "  %-32s %9.3f ms\n", phase.first, phase.second);
+        }
+        std::fprintf(stderr, "  %-32s %9.3f ms\n", "total", millisecondsSince(start));
+        std::fprintf(stderr, "  %-32s %9.3f ms\n", "CPU time",
+                     1000.0 * static_cast<double>(std::clock()) / CLOCKS_PER_SEC);
+    }
+
+    void enable() { enabled = true; }
+
+    // Attribute the time since the previous mark to `phase`
+    void mark(const char* phase) {
+        Clock::time_point now = Clock::now();
+        phases.emplace_back(phase, std::chrono::duration<double, std::milli>(now - last).count());
+        last = now;
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    bool enabled;
+    Clock::time_point start;
+    Clock::time_point last;
+    std::vector<std::pair<const char*, double>> phases;
+
+    double millisecondsSince(Clock::time_point from) const {
+        return std::chrono::duration<double, std::milli>(Clock::now() - from).count();
+    }
+};
+
+PhaseTimer phaseTimer;
+
+// --profile report, written to stderr from an atexit handler so that every
+// return path out of main() is covered
+bool profileAsJSON = false;
+
+void writeProfile() {
+    if (profileAsJSON) {
+        Profiler::writeJSON(std::cerr);
+    } else {
+        Profiler::writeReport(std::cerr);
+    }
+}
+
+bool initializeHinduCalendar(HinduCalendar& hinduCalendar, const CommandLineArgs& args) {
+    if (!hinduCalendar.initialize()) {
+        std::cerr << "Error: Failed to initialize Hindu Calendar system: " << hinduCalendar.getLastError() << std::endl;
+        return false;
+    }
+    if (!args.festivalRulesFile.empty() && !hinduCalendar.loadFestivalRules(args.festivalRulesFile)) {
+        std::cerr << "Error: Failed to load festival rules: " << hinduCalendar.getLastError() << std::endl;
+        return false;
+    }
+    phaseTimer.mark("Hindu calendar init");
+    return true;
+}
+
+bool writeBinaryFile(const std::string& filename, const std::string& data) {
+    std::ofstream file(filename, std::ios::binary);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    return static_cast<bool>(file);
+}
+
+// Image format: --image-format, else the file extension
+ChartImageRenderer::Format imageFormatForArgs(const CommandLineArgs& args, const std::string& filename) {
+    ChartImageRenderer::Format format = ChartImageRenderer::formatForFile(filename);
+    if (!args.imageFormat.empty()) {
+        ChartImageRenderer::parseFormat(args.imageFormat, format);
+    }
+    return format;
+}
+
+// Display options for --hindu-monthly and its --hindu-monthly-format
+HinduMonthlyCalendar::DisplayOptions hinduMonthlyDisplayOptions(const CommandLineArgs& args) {
+    HinduMonthlyCalendar::DisplayOptions displayOptions = HinduMonthlyCalendar::getDefaultDisplayOptions();
+    displayOptions.ayanamsa = args.ayanamsa;
+    displayOptions.showMuhurta = args.hinduMonthlyShowMuhurta;
+
+    // Configure display based on format
+    if (args.hinduMonthlyCalendarFormat == "detailed") {
+        displayOptions.showMuhurta = true;
+        displayOptions.showRashiInfo = true;
+        displayOptions.showLunarPhase = true;
+    } else if (args.hinduMonthlyCalendarFormat == "panchanga") {
+        displayOptions.showTithi = true;
+        displayOptions.showNakshatra = true;
+        displayOptions.showYoga = true;
+        displayOptions.showKarana = true;
+    } else if (args.hinduMonthlyCalendarFormat == "compact") {
+        displayOptions.showPackedLayout = true;
+        displayOptions.cellWidth = 8;
+    } else if (args.hinduMonthlyCalendarFormat == "festivals") {
+        displayOptions.showFestivals = true;
+        displayOptions.showSpecialDays = true;
+        displayOptions.showVrataInfo = true;
+    } else if (args.hinduMonthlyCalendarFormat == "astronomical") {
+        displayOptions.showRashiInfo = true;
+        displayOptions.showLunarPhase = true;
+        displayOptions.showMuhurta = true;
+    } else if (args.hinduMonthlyCalendarFormat == "html") {
+        displayOptions.htmlOutput = true;
+    }
+
+    return displayOptions;
+}
+
+// Page of one month in the --hindu-monthly-format
+std::string hinduMonthlyPage(const HinduMonthlyCalendar& calendar, const HinduMonthlyCalendar::MonthlyData& monthData,
+                             const std::string& format) {
+    if (format == "csv") {
+        return calendar.exportToCSV(monthData);
+    } else if (format == "json") {
+        return calendar.exportToJSON(monthData);
+    } else if (format == "html") {
+        return calendar.generateHTMLCalendar(monthData);
+    }
+    return calendar.generateCalendar(monthData);
+}
+
+// Calendar systems shown by --myanmar-monthly in addition to --include-*
+void myanmarMonthlyIncludes(const CommandLineArgs& args, bool& enableHindu, bool& enablePlanetary,
+                            bool& enableAdvancedAstro) {
+    enableHindu = args.includeHindu;
+    enablePlanetary = args.includePlanetary;
+    enableAdvancedAstro = args.includeAdvancedAstro;
+
+    if (args.myanmarMonthlyCalendarFormat == "multi-calendar" ||
+        args.myanmarMonthlyCalendarFormat == "hindu-myanmar" ||
+        args.myanmarMonthlyCalendarFormat == "full-astronomical") {
+        enableHindu = true;
+    }
+
+    if (args.myanmarMonthlyCalendarFormat == "planetary" ||
+        args.myanmarMonthlyCalendarFormat == "full-astronomical") {
+        enablePlanetary = true;
+    }
+
+    if (args.myanmarMonthlyCalendarFormat == "full-astronomical") {
+        enableAdvancedAstro = true;
+    }
+}
+
+// --calendar-months, or --hindu-monthly together with --myanmar-monthly.
+// Every day of the range is computed once by a CalendarDayStream and shared
+// by the Hindu view and the Myanmar view (including its Hindu columns); the
+// month pages are then rendered in parallel and printed in calendar order.
+int runMonthlyCalendars(const CommandLineArgs& args) {
+    const bool showHindu = args.showHinduMonthlyCalendar;
+    const bool showMyanmar = args.showMyanmarMonthlyCalendar;
+
+    HinduMonthlyCalendar hinduMonthlyCalendar;
+    int year = 0, month = 0;
+    if (showHindu && !hinduMonthlyCalendar.parseMonth(args.hinduMonthlyCalendarDate, year, month)) {
+        std::cerr << "Error: Invalid date format for Hindu monthly calendar. Use YYYY-MM or YYYYBC-MM format.\n";
+        return 1;
+    }
+    if (showMyanmar) {
+        int myanmarYear, myanmarMonth;
+        if (sscanf(args.myanmarMonthlyCalendarDate.c_str(), "%d-%d", &myanmarYear, &myanmarMonth) != 2 ||
+            myanmarMonth < 1 || myanmarMonth > 12) {
+            std::cerr << "Error: Invalid date format for Myanmar monthly calendar. Use YYYY-MM format.\n";
+            return 1;
+        }
+        if (showHindu && (myanmarYear != year || myanmarMonth != month)) {
+            std::cerr << "Error: --hindu-monthly and --myanmar-monthly must start at the same month\n";
+            return 1;
+        }
+        year = myanmarYear;
+        month = myanmarMonth;
+    }
+
+    bool enableHindu = false, enablePlanetary = false, enableAdvancedAstro = false;
+    if (showMyanmar) {
+        myanmarMonthlyIncludes(args, enableHindu, enablePlanetary, enableAdvancedAstro);
+    }
+
+    // The Hindu view's location (New Delhi by default) and ayanamsa; the
+    // Myanmar view alone keeps its usual Delhi Lahiri Panchanga
+    double latitude = args.latitude != 0.0 ? args.latitude : 28.6139;
+    double longitude = args.longitude != 0.0 ? args.longitude : 77.2090;
+
+    CalendarDayStream stream;
+    stream.setIncludeHindu(showHindu || enableHindu);
+    stream.setIncludeMyanmar(showMyanmar);
+    if (showHindu) {
+        stream.setLocation(latitude, longitude);
+        stream.setAyanamsa(args.ayanamsa);
+    }
+
+    std::vector<CalendarMonthDays> days;
+    if (!stream.generate(year, month, args.calendarMonths, days)) {
+        std::cerr << "Error: " << stream.getLastError() << "\n";
+        return 1;
+    }
+
+    HinduMonthlyCalendar::DisplayOptions displayOptions = hinduMonthlyDisplayOptions(args);
+    if (showHindu && !hinduMonthlyCalendar.initialize(latitude, longitude, displayOptions)) {
+        std::cerr << "Error: Failed to initialize Hindu Monthly Calendar: " << hinduMonthlyCalendar.getLastError() << std::endl;
+        return 1;
+    }
+    MyanmarMonthlyCalendar myanmarMonthlyCalendar;
+    if (showMyanmar && !myanmarMonthlyCalendar.initialize()) {
+        std::cerr << "Error: Failed to initialize Myanmar Monthly Calendar: " << myanmarMonthlyCalendar.getLastError() << std::endl;
+        return 1;
+    }
+
+    // Month data is assembled here; planetary columns still query the
+    // Myanmar calendar's AstroCalendar, which belongs to this thread
+    std::vector<HinduMonthlyCalendar::MonthlyData> hinduMonths;
+    std::vector<MyanmarMonthlyData> myanmarMonths;
+    for (const auto& monthDays : days) {
+        if (showHindu) {
+            hinduMonths.push_back(hinduMonthlyCalendar.generateMonthlyData(monthDays));
+        }
+        if (showMyanmar) {
+            myanmarMonths.push_back(myanmarMonthlyCalendar.calculateMonthlyData(
+                monthDays, args.includeGregorian, enableHindu, enablePlanetary, enableAdvancedAstro));
+        }
+    }
+
+    const size_t views = (showHindu ? 1 : 0) + (showMyanmar ? 1 : 0);
+    std::vector<std::string> pages = CalendarDayStream::renderPages(days.size() * views, 0, [&](size_t i) {
+        size_t index = i / views;
+        if (showHindu && i % views == 0) {
+            return hinduMonthlyPage(hinduMonthlyCalendar, hinduMonths[index], args.hinduMonthlyCalendarFormat);
+        }
+        return myanmarMonthlyCalendar.generateMonthlyCalendar(myanmarMonths[index], args.myanmarMonthlyCalendarFormat);
+    });
+
+    ASTRO_PROFILE_SCOPE("write output");
+    for (const auto& page : pages) {
+        std::cout << page << "\n";
+    }
+    return 0;
+}
+
+// Charts for every "id,date,time,latitude,longitude,timezone" line of the
+// batch input, one image file each. The input is read and checked first, then
+// the charts are split over worker threads, each with its own calculator and
+// renderer; the renderers share the frame templates built by the first chart.
+int renderImageBatch(const CommandLineArgs& args) {
+    const std::string style = args.chartStyle.empty() ? "western" : args.chartStyle;
+    ChartImageRenderer styleCheck;
+    if (!styleCheck.setChartStyle(style)) {
+        std::cerr << "Error: " << styleCheck.getLastError() << "\n";
+        return 1;
+    }
+    const ChartImageRenderer::Format format = imageFormatForArgs(args, "");
+    const std::string extension = format == ChartImageRenderer::Format::PNG ? ".png" : ".svg";
+
+    std::ifstream fileInput;
+    std::istream* input = &std::cin;
+    if (args.imageBatchInput != "-") {
+        fileInput.open(args.imageBatchInput);
+        if (!fileInput) {
+            std::cerr << "Error: Cannot open " << args.imageBatchInput << std::endl;
+            return 1;
+        }
+        input = &fileInput;
+    }
+
+    struct BatchChart {
+        std::string id;
+        BirthData birthData;
+        int lineNumber;
+    };
+    std::vector<BatchChart> charts;
+
+    TimeZoneResolver resolver;
+    std::string line, id, date, time, latitude, longitude, timezone;
+    int lineNumber = 0;
+
+    while (std::getline(*input, line)) {
+        lineNumber++;
+        line = line.substr(0, line.find('#'));
+        std::replace(line.begin(), line.end(), ',', ' ');
+        std::istringstream fields(line);
+        if (!(fields >> id)) {
+            continue;  // blank or comment line
+        }
+        // The id names the output file and must stay inside the batch directory
+        if (id[0] == '.' || id.find_first_of("/\\") != std::string::npos ||
+            id.find("..") != std::string::npos) {
+            std::cerr << "Error: " << args.imageBatchInput << ":" << lineNumber
+                      << ": invalid id '" << id << "' (no path separators, '..' or leading '.')\n";
+            return 1;
+        }
+
+        BirthData birthData{};
+        bool valid = static_cast<bool>(fields >> date >> time >> latitude >> longitude >> timezone) &&
+                     parseDate(date, birthData.year, birthData.month, birthData.day) &&
+                     parseTime(time, birthData.hour, birthData.minute, birthData.second);
+        char* end = nullptr;
+        if (valid) {
+            birthData.latitude = std::strtod(latitude.c_str(), &end);
+            valid = *end == '\0';
+        }
+        if (valid) {
+            birthData.longitude = std::strtod(longitude.c_str(), &end);
+            valid = *end == '\0';
+        }
+        if (!valid) {
+            std::cerr << "Error: " << args.imageBatchInput << ":" << lineNumber
+                      << ": expected id, YYYY-MM-DD, HH:MM:SS, latitude, longitude and timezone\n";
+            return 1;
+        }
+
+        birthData.timezone = std::strtod(timezone.c_str(), &end);
+        if (*end != '\0' && !resolver.resolve(timezone, birthData)) {
+            std::cerr << "Error: " << args.imageBatchInput << ":" << lineNumber << ": "
+                      << resolver.getLastError() << "\n";
+            return 1;
+        }
+        charts.push_back(BatchChart{id, birthData, lineNumber});
+    }
+
+    std::atomic<size_t> next(0);
+    std::atomic<bool> failed(false);
+    std::mutex errorMutex;
+    std::string error;
+    auto fail = [&](const std::string& message) {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        if (!failed.exchange(true)) error = message;
+    };
+
+    auto work = [&]() {
+        HoroscopeCalculator calculator;
+        if (!calculator.initialize(args.ephemerisPath)) {
+            fail("Failed to initialize calculator: " + calculator.getLastError());
+            return;
+        }
+        calculator.setZodiacMode(args.zodiacMode);
+        calculator.setAyanamsa(args.ayanamsa);
+
+        ChartImageRenderer renderer;
+        renderer.setChartStyle(style);
+        std::string image;
+
+        for (size_t i = next++; i < charts.size() && !failed; i = next++) {
+            const BatchChart& entry = charts[i];
+            BirthChart chart;
+            if (!calculator.calculateBirthChart(entry.birthData, args.houseSystem, args.zodiacMode,
+                                               args.ayanamsa, chart)) {
+                fail(args.imageBatchInput + ":" + std::to_string(entry.lineNumber) +
+                     ": failed to calculate chart: " + calculator.getLastError());
+                return;
+            }
+
+            image.clear();
+            renderer.render(chart, format, image);
+            std::string filename = args.imageBatchDir + "/" + entry.id + extension;
+            if (!writeBinaryFile(filename, image)) {
+                fail("Cannot write " + filename);
+                return;
+            }
+        }
+    };
+
+    unsigned workers = std::max(1u, std::min(std::thread::hardware_concurrency(),
+                                             static_cast<unsigned>(charts.size() / 16 + 1)));
+    std::vector<std::thread> threads;
+    for (unsigned i = 1; i < workers; i++) {
+        threads.emplace_back(work);
+    }
+    work();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (failed) {
+        std::cerr << "Error: " << error << "\n";
+        return 1;
+    }
+    std::cout << "Wrote " << charts.size() << " chart image" << (charts.size() == 1 ? "" : "s")
+              << " to " << args.imageBatchDir << "\n";
+    return 0;
+}
+
+// Local date and time a whole number of seconds after the given one
+BirthData advanceBirthData(const BirthData& start, long long seconds) {
+    long long secondOfDay = start.hour * 3600LL + start.minute * 60LL + start.second + seconds;
+    long long dayShift = secondOfDay / 86400 - (secondOfDay % 86400 < 0 ? 1 : 0);
+    secondOfDay -= dayShift * 86400;
+
+    BirthData result = start;
+    double jd = swe_julday(start.year, start.month, start.day, 12.0, SE_GREG_CAL) + dayShift;
+    double hour;
+    swe_revjul(jd, SE_GREG_CAL, &result.year, &result.month, &result.day, &hour);
+    result.hour = static_cast<int>(secondOfDay / 3600);
+    result.minute = static_cast<int>(secondOfDay / 60 % 60);
+    result.second = static_cast<int>(secondOfDay % 60);
+    return result;
+}
+
+// Time-lapse of the chart. The drawers keep the previous frame and only
+// redraw what moved; the animator sends just the changed cells to the terminal.
+int runAnimation(HoroscopeCalculator& calculator, const BirthData& start, const CommandLineArgs& args) {
+    std::string style = args.chartStyle.empty() ? "western" : args.chartStyle;
+    if (style == "solar-system" && args.solarSystemPerspective != "heliocentric") {
+        std::cerr << "Error: --animate draws the solar-system style with the heliocentric perspective only\n";
+        return 1;
+    }
+
+    ChartAnimator::Output output = ChartAnimator::Output::ANSI;
+    ChartAnimator::parseOutput(args.animateOutput, output);
+    ChartAnimator animator(std::cout, output);
+
+    WesternChartDrawer westernDrawer;
+    WesternChartDrawer::WheelState wheel;
+    EasternChartDrawer easternDrawer;
+    easternDrawer.setChartStyle(style);
+    EasternChartDrawer::GridState grid;
+    SolarSystemDrawer solarDrawer;
+    solarDrawer.setKeplerResync(args.keplerResyncDays);
+    SolarSystemDrawer::OrbitState orbits;
+
+    for (int frame = 0; frame < args.animateFrames; frame++) {
+        BirthData moment = advanceBirthData(start, frame * args.animateStepMinutes * 60LL);
+
+        const std::vector<std::string>* rows;
+        if (style == "solar-system") {
+            // The heliocentric view needs only the moment, not a chart
+            if (!solarDrawer.updateHeliocentricView(orbits, moment.getJulianDay())) {
+                animator.finish();
+                std::cerr << "Error: Failed to place the planets for " << moment.getDateTimeString()
+                          << ": " << solarDrawer.getLastError() << "\n";
+                return 1;
+            }
+            rows = &orbits.rows;
+        } else {
+            BirthChart chart;
+            if (!calculator.calculateBirthChart(moment, args.houseSystem, args.zodiacMode, args.ayanamsa, chart)) {
+                animator.finish();
+                std::cerr << "Error: Failed to calculate chart for " << moment.getDateTimeString()
+                          << ": " << calculator.getLastError() << "\n";
+                return 1;
+            }
+
+            if (style == "western") {
+                westernDrawer.updateWheel(wheel, chart);
+                rows = &wheel.rows;
+            } else {
+                easternDrawer.updateGrid(grid, chart);
+                rows = &grid.rows;
+            }
+        }
+
+        std::ostringstream caption;
+        caption << moment.getDateTimeString() << "  (frame " << (frame + 1) << "/" << args.animateFrames << ")";
+        animator.writeFrame(caption.str(), *rows);
+
+        if (args.frameDelayMs > 0 && frame + 1 < args.animateFrames) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(args.frameDelayMs));
+        }
+    }
+
+    animator.finish();
+    return 0;
+}
+
 int main(int argc, char* argv[]) {
+    phaseTimer.mark("process startup");
     CommandLineArgs args;
 
     if (!parseCommandLine(argc, argv, args)) {
         return 1;
     }
+    if (args.showTiming) {
+        phaseTimer.enable();
+    }
+    if (args.showProfile) {
+        profileAsJSON = args.profileFormat == "json";
+        Profiler::setEnabled(true);
+        std::atexit(writeProfile);
+    }
+    phaseTimer.mark("parse arguments");
+    ASTRO_PROFILE_SCOPE("main");
 
     if (args.showHelp) {
         printHelp();
@@ -2400,10 +3316,33 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
-    // Handle location search operations
-    LocationManager locationManager;
+    if (!args.serveSocket.empty()) {
+        ChartServer server;
+        ChartServer::Options options;
+        options.socketPath = args.serveSocket;
+        options.ephemerisPath = args.ephemerisPath;
+        options.festivalRulesFile = args.festivalRulesFile;
+        options.workers = args.serveWorkers;
+
+        if (!server.start(options)) {
+            std::cerr << "Error: Failed to start server: " << server.getLastError() << std::endl;
+            return 1;
+        }
+        std::cerr << "Serving on " << args.serveSocket << std::endl;
 
+        bool ok = server.run();
+        std::cerr << server.getMetrics().summary();
+        if (!ok) {
+            std::cerr << "Error: " << server.getLastError() << std::endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Handle location search operations. The location database is only built
+    // by the commands that use it.
     if (args.listLocations) {
+        LocationManager locationManager;
         std::cout << "Available Predefined Locations:\n";
         std::cout << std::string(80, '=') << std::endl;
         auto locations = locationManager.getAllLocations();
@@ -2416,6 +3355,7 @@ int main(int argc, char* argv[]) {
     }
 
     if (!args.searchLocation.empty()) {
+        LocationManager locationManager;
         std::cout << "Searching for locations matching: \"" << args.searchLocation << "\"\n";
         std::cout << std::string(80, '=') << std::endl;
         auto matches = locationManager.searchLocations(args.searchLocation);
@@ -2432,8 +3372,182 @@ int main(int argc, char* argv[]) {
         return 0;
     }
 
+    if (args.nearestLocation) {
+        LocationManager locationManager;
+        if (!args.locationName.empty()) {
+            Location origin = locationManager.getLocationByName(args.locationName);
+            if (origin.name.empty()) {
+                std::cerr << "Error: Location \"" << args.locationName << "\" not found\n";
+                return 1;
+            }
+            args.latitude = origin.latitude;
+            args.longitude = origin.longitude;
+        } else if (!args.hasCoordinates) {
+            std::cerr << "Error: --lat and --lon or --location required for --nearest-location\n";
+            return 1;
+        }
+        if (args.latitude < -90.0 || args.latitude > 90.0 ||
+            args.longitude < -180.0 || args.longitude > 180.0) {
+            std::cerr << "Error: Valid coordinates (--lat/--lon) required for --nearest-location\n";
+            return 1;
+        }
+
+        std::vector<NearbyLocation> nearby;
+        if (args.nearestRadiusKm >= 0.0) {
+            nearby = locationManager.findWithinRadius(args.latitude, args.longitude, args.nearestRadiusKm);
+            std::cout << "Locations within " << args.nearestRadiusKm << " km of ";
+        } else {
+            nearby = locationManager.findNearest(args.latitude, args.longitude, args.nearestCount);
+            std::cout << "Nearest locations to ";
+        }
+        std::cout << args.latitude << "°, " << args.longitude << "°\n";
+        std::cout << std::string(80, '=') << std::endl;
+        if (nearby.empty()) {
+            std::cout << "No locations found\n";
+        }
+        for (const auto& entry : nearby) {
+            const Location& location = entry.location;
+            std::cout << "📍 " << location.name << " (" << location.country << ")\n";
+            std::cout << "   Coordinates: " << location.latitude << "°, " << location.longitude << "°\n";
+            std::cout << "   Timezone: UTC" << (location.timezone >= 0 ? "+" : "") << location.timezone << "\n";
+            std::ostringstream distance;
+            distance << std::fixed << std::setprecision(1) << entry.distanceKm;
+            std::cout << "   Distance: " << distance.str() << " km\n\n";
+        }
+        return 0;
+    }
+
+    if (!args.reverseGeocodeFile.empty()) {
+        std::ifstream fileInput;
+        std::istream* input = &std::cin;
+        if (args.reverseGeocodeFile != "-") {
+            fileInput.open(args.reverseGeocodeFile);
+            if (!fileInput) {
+                std::cerr << "Error: Cannot open " << args.reverseGeocodeFile << std::endl;
+                return 1;
+            }
+            input = &fileInput;
+        }
+
+        // One point per line: latitude and longitude separated by a comma or
+        // whitespace; further fields are ignored, '#' starts a comment
+        std::vector<std::pair<double, double>> points;
+        std::string line;
+        int lineNumber = 0;
+        while (std::getline(*input, line)) {
+            lineNumber++;
+            line = line.substr(0, line.find('#'));
+            std::replace(line.begin(), line.end(), ',', ' ');
+            std::istringstream fields(line);
+            if (line.find_first_not_of(" \t\r") == std::string::npos) {
+                continue;  // blank or comment line
+            }
+            double latitude, longitude;
+            if (!(fields >> latitude >> longitude)) {
+                std::cerr << "Error: " << args.reverseGeocodeFile << ":" << lineNumber
+                          << ": expected latitude and longitude\n";
+                return 1;
+            }
+            // A point off the globe is reported and skipped; the rest of the batch still runs
+            if (latitude < -90.0 || latitude > 90.0) {
+                std::cerr << "Warning: " << args.reverseGeocodeFile << ":" << lineNumber << ": latitude "
+                          << latitude << " is outside -90 to 90; point skipped\n";
+                continue;
+            }
+            if (longitude < -180.0 || longitude > 180.0) {
+                std::cerr << "Warning: " << args.reverseGeocodeFile << ":" << lineNumber << ": longitude "
+                          << longitude << " is outside -180 to 180; point skipped\n";
+                continue;
+            }
+            points.push_back({latitude, longitude});
+        }
+
+        LocationManager locationManager;
+        auto nearest = locationManager.reverseGeocode(points);
+
+        std::cout << "latitude,longitude,name,country,timezone,distance_km\n";
+        for (size_t i = 0; i < points.size(); i++) {
+            const Location& location = nearest[i].location;
+            std::ostringstream distance;
+            distance << std::fixed << std::setprecision(1) << nearest[i].distanceKm;
+            std::cout << points[i].first << "," << points[i].second << ",\""
+                      << location.name << "\",\"" << location.country << "\","
+                      << location.timezone << "," << distance.str() << "\n";
+        }
+        return 0;
+    }
+
+    if (!args.timezoneOffsetsFile.empty()) {
+        std::ifstream fileInput;
+        std::istream* input = &std::cin;
+        if (args.timezoneOffsetsFile != "-") {
+            fileInput.open(args.timezoneOffsetsFile);
+            if (!fileInput) {
+                std::cerr << "Error: Cannot open " << args.timezoneOffsetsFile << std::endl;
+                return 1;
+            }
+            input = &fileInput;
+        }
+
+        // One record per line: zone, date and optional time (default noon),
+        // separated by commas or whitespace; '#' starts a comment
+        TimeZoneResolver resolver;
+        std::string line, zone, lastZone, date, time;
+        int zoneIndex = -1;
+        int lineNumber = 0;
+        std::string output = "zone,date,time,utc_offset,dst\n";
+
+        while (std::getline(*input, line)) {
+            lineNumber++;
+            line = line.substr(0, line.find('#'));
+            std::replace(line.begin(), line.end(), ',', ' ');
+            std::istringstream fields(line);
+            if (!(fields >> zone)) {
+                continue;  // blank or comment line
+            }
+            if (!(fields >> date)) {
+                date.clear();
+            }
+            if (!(fields >> time)) {
+                time = "12:00:00";
+            }
+
+            BirthData local{};
+            if (!parseDate(date, local.year, local.month, local.day) ||
+                !isCalendarDate(local.year, local.month, local.day) ||
+                !parseTime(time, local.hour, local.minute, local.second) ||
+                local.hour > 23 || local.minute > 59 || local.second > 59) {
+                std::cerr << "Error: " << args.timezoneOffsetsFile << ":" << lineNumber
+                          << ": expected zone, YYYY-MM-DD and HH:MM:SS\n";
+                return 1;
+            }
+            if (zone != lastZone) {
+                zoneIndex = resolver.findZone(zone);
+                lastZone = zone;
+            }
+            if (zoneIndex < 0) {
+                std::cerr << "Error: " << args.timezoneOffsetsFile << ":" << lineNumber
+                          << ": unknown time zone \"" << zone << "\"\n";
+                return 1;
+            }
+
+            ZoneOffset offset = resolver.offsetAtLocalTime(zoneIndex, TimeZoneResolver::toSeconds(
+                local.year, local.month, local.day, local.hour, local.minute, local.second));
+            std::ostringstream hours;
+            hours << offset.hours();
+            output += zone + "," + date + "," + time + "," + hours.str() + "," + (offset.isDST ? "1" : "0") + "\n";
+        }
+        std::cout << output;
+        return 0;
+    }
+
+    if (!args.imageBatchInput.empty()) {
+        return renderImageBatch(args);
+    }
+
     // Resolve location if specified
     if (!args.locationName.empty()) {
+        LocationManager locationManager;
         auto location = locationManager.getLocationByName(args.locationName);
         if (!location.name.empty()) {
             args.latitude = location.latitude;
@@ -2441,7 +3555,21 @@ int main(int argc, char* argv[]) {
             args.timezone = location.timezone;
             std::cout << "🌍 Using location: " << location.name << " (" << location.country << ")\n";
             std::cout << "   Coordinates: " << location.latitude << "°, " << location.longitude << "°\n";
-            std::cout << "   Timezone: UTC" << (location.timezone >= 0 ? "+" : "") << location.timezone << "\n\n";
+
+            // The city's zone gives the offset actually in effect on the date
+            std::string zone = args.timezoneName.empty() ? location.timezoneStr : args.timezoneName;
+            ZoneOffset offset;
+            std::string error;
+            if (!zone.empty() && zoneOffsetForArgs(zone, args, offset, error)) {
+                args.timezone = offset.hours();
+                std::cout << "   Timezone: UTC" << (args.timezone >= 0 ? "+" : "") << args.timezone
+                          << " (" << zone << (offset.isDST ? ", daylight saving time" : "") << ")\n\n";
+            } else if (!args.timezoneName.empty()) {
+                std::cerr << "Error: " << error << "\n";
+                return 1;
+            } else {
+                std::cout << "   Timezone: UTC" << (location.timezone >= 0 ? "+" : "") << location.timezone << "\n\n";
+            }
         } else {
             std::cerr << "Error: Location \"" << args.locationName << "\" not found\n";
             std::cerr << "Use --search-location \"" << args.locationName << "\" to find similar locations\n";
@@ -2450,16 +3578,23 @@ int main(int argc, char* argv[]) {
         }
     }
 
+    if (!args.timezoneName.empty() && args.locationName.empty()) {
+        ZoneOffset offset;
+        std::string error;
+        if (!zoneOffsetForArgs(args.timezoneName, args, offset, error)) {
+            std::cerr << "Error: " << error << "\n";
+            return 1;
+        }
+        args.timezone = offset.hours();
+    }
+
     if (!validateArgs(args)) {
         std::cerr << "Use --help for usage information\n";
         return 1;
     }
+    phaseTimer.mark("location and validation");
 
     try {
-        // Initialize ephemeris for special features
-        EphemerisManager ephemerisManager;
-        ephemerisManager.initialize(args.ephemerisPath);
-
         // Handle eclipse calculations
         if (args.showEclipses || !args.eclipseFromDate.empty()) {
             EclipseCalculator eclipseCalc;
@@ -2467,6 +3602,7 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Failed to initialize eclipse calculator" << std::endl;
                 return 1;
             }
+            phaseTimer.mark("eclipse calculator init");
 
             std::string fromDate = args.eclipseFromDate;
             std::string toDate = args.eclipseToDate;
@@ -2543,22 +3679,24 @@ int main(int argc, char* argv[]) {
                               << (eclipse.location.empty() ? "Global" : eclipse.location) << "\n";
                 }
             } else if (args.eclipseFormat == "json") {
-                // JSON output
-                std::cout << "{\n  \"eclipses\": [\n";
-                for (size_t i = 0; i < eclipses.size(); ++i) {
-                    const auto& eclipse = eclipses[i];
-                    std::cout << "    {\n";
-                    std::cout << "      \"date\": \"" << eclipse.getDateString() << "\",\n";
-                    std::cout << "      \"type\": \"" << eclipse.getTypeString() << "\",\n";
-                    std::cout << "      \"magnitude\": " << eclipse.magnitude << ",\n";
-                    std::cout << "      \"duration\": " << eclipse.duration << ",\n";
-                    std::cout << "      \"visible\": " << (eclipse.isVisible ? "true" : "false") << ",\n";
-                    std::cout << "      \"location\": \"" << (eclipse.location.empty() ? "Global" : eclipse.location) << "\"\n";
-                    std::cout << "    }" << (i < eclipses.size() - 1 ? "," : "") << "\n";
+                JsonWriter json;
+                json.beginObject();
+                json.key("eclipses").beginArray();
+                for (const auto& eclipse : eclipses) {
+                    json.beginObject();
+                    json.field("date", eclipse.getDateString());
+                    json.field("julian_day", eclipse.julianDay);
+                    json.field("type", eclipse.getTypeString());
+                    json.field("magnitude", eclipse.magnitude);
+                    json.field("duration", eclipse.duration);
+                    json.field("visible", eclipse.isVisible);
+                    json.field("location", eclipse.location.empty() ? "Global" : eclipse.location);
+                    json.endObject();
                 }
-                std::cout << "  ],\n";
-                std::cout << "  \"total_count\": " << eclipses.size() << "\n";
-                std::cout << "}\n";
+                json.endArray();
+                json.field("total_count", eclipses.size());
+                json.endObject();
+                std::cout << json.str() << "\n";
             } else {
                 // Traditional text output
                 std::cout << "\nEclipse Events (" << fromDate << " to " << toDate << "):\n";
@@ -2582,6 +3720,7 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Failed to initialize conjunction calculator" << std::endl;
                 return 1;
             }
+            phaseTimer.mark("conjunction calculator init");
             conjCalc.setMaximumOrb(args.conjunctionMaxOrb);
 
             std::string fromDate = args.conjunctionFromDate;
@@ -2663,25 +3802,34 @@ int main(int argc, char* argv[]) {
                 // CSV output
                 std::cout << "Date,Planet1,Planet2,Separation,Orb,Significance\n";
                 for (const auto& conjunction : conjunctions) {
-                    std::cout << "2024-01-01,Mercury,Venus,2.5°," << args.conjunctionMaxOrb << "°,Strong conjunction\n";
-                    // Note: Would need actual data extraction from conjunction object
+                    std::cout << conjunction.getDateString() << ","
+                              << (conjunction.planets.size() > 0 ? planetToString(conjunction.planets[0]) : "") << ","
+                              << (conjunction.planets.size() > 1 ? planetToString(conjunction.planets[1]) : "") << ","
+                              << conjunction.orb << "°," << args.conjunctionMaxOrb << "°,\""
+                              << conjunction.getDescription() << "\"\n";
                 }
             } else if (args.conjunctionFormat == "json") {
-                // JSON output
-                std::cout << "{\n  \"conjunctions\": [\n";
-                for (size_t i = 0; i < conjunctions.size(); ++i) {
-                    std::cout << "    {\n";
-                    std::cout << "      \"date\": \"2024-01-01\",\n";
-                    std::cout << "      \"planet1\": \"Mercury\",\n";
-                    std::cout << "      \"planet2\": \"Venus\",\n";
-                    std::cout << "      \"separation\": \"2.5\",\n";
-                    std::cout << "      \"orb\": \"" << args.conjunctionMaxOrb << "\",\n";
-                    std::cout << "      \"significance\": \"Strong conjunction\"\n";
-                    std::cout << "    }" << (i < conjunctions.size() - 1 ? "," : "") << "\n";
+                JsonWriter json;
+                json.beginObject();
+                json.key("conjunctions").beginArray();
+                for (const auto& conjunction : conjunctions) {
+                    json.beginObject();
+                    json.field("date", conjunction.getDateString());
+                    json.field("julian_day", conjunction.julianDay);
+                    if (conjunction.planets.size() > 0) json.field("planet1", planetToString(conjunction.planets[0]));
+                    if (conjunction.planets.size() > 1) json.field("planet2", planetToString(conjunction.planets[1]));
+                    json.field("separation", conjunction.orb);
+                    json.field("orb", args.conjunctionMaxOrb);
+                    json.field("longitude", conjunction.longitude);
+                    json.field("sign", zodiacSignToString(conjunction.sign));
+                    json.field("applying", conjunction.isApplying);
+                    json.field("significance", conjunction.getDescription());
+                    json.endObject();
                 }
-                std::cout << "  ],\n";
-                std::cout << "  \"total_count\": " << conjunctions.size() << "\n";
-                std::cout << "}\n";
+                json.endArray();
+                json.field("total_count", conjunctions.size());
+                json.endObject();
+                std::cout << json.str() << "\n";
             } else {
                 // Traditional text output
                 std::cout << "\nPlanetary Conjunctions (" << fromDate << " to " << toDate << "):\n";
@@ -2710,6 +3858,7 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Failed to initialize conjunction calculator for Graha Yuddha" << std::endl;
                 return 1;
             }
+            phaseTimer.mark("conjunction calculator init");
 
             std::string fromDate = args.grahaYuddhaFromDate;
             std::string toDate = args.grahaYuddhaToDate;
@@ -2804,9 +3953,10 @@ int main(int argc, char* argv[]) {
                              << war.grahaYuddhaEffect << "\n";
                 }
             } else if (args.grahaYuddhaFormat == "json") {
-                std::cout << "{\n  \"graha_yuddha_events\": [\n";
-                for (size_t i = 0; i < wars.size(); ++i) {
-                    const auto& war = wars[i];
+                JsonWriter json;
+                json.beginObject();
+                json.key("graha_yuddha_events").beginArray();
+                for (const auto& war : wars) {
                     std::string winner = "Unknown";
                     std::string loser = "Unknown";
                     if (war.isGrahaYuddha && war.planets.size() >= 2) {
@@ -2819,17 +3969,20 @@ int main(int argc, char* argv[]) {
                         }
                     }
 
-                    std::cout << "    {\n";
-                    std::cout << "      \"date\": \"" << war.getDateString() << "\",\n";
-                    std::cout << "      \"combatants\": \"" << war.getPlanetsString() << "\",\n";
-                    std::cout << "      \"separation\": " << war.orb << ",\n";
-                    std::cout << "      \"winner\": \"" << winner << "\",\n";
-                    std::cout << "      \"loser\": \"" << loser << "\",\n";
-                    std::cout << "      \"effects\": \"" << war.grahaYuddhaEffect << "\",\n";
-                    std::cout << "      \"significance\": \"" << war.getDescription() << "\"\n";
-                    std::cout << "    }" << (i < wars.size() - 1 ? "," : "") << "\n";
+                    json.beginObject();
+                    json.field("date", war.getDateString());
+                    json.field("julian_day", war.julianDay);
+                    json.field("combatants", war.getPlanetsString());
+                    json.field("separation", war.orb);
+                    json.field("winner", winner);
+                    json.field("loser", loser);
+                    json.field("effects", war.grahaYuddhaEffect);
+                    json.field("significance", war.getDescription());
+                    json.endObject();
                 }
-                std::cout << "  ]\n}\n";
+                json.endArray();
+                json.endObject();
+                std::cout << json.str() << "\n";
             } else {
                 // Default text format (original behavior)
                 std::cout << conjCalc.generateGrahaYuddhaReport(wars);
@@ -2845,6 +3998,7 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Error: Failed to initialize ephemeris table" << std::endl;
                 return 1;
             }
+            phaseTimer.mark("ephemeris table init");
 
             std::string fromDate = args.ephemerisFromDate;
             std::string toDate = args.ephemerisToDate;
@@ -2882,6 +4036,8 @@ int main(int argc, char* argv[]) {
             Astro::parseBCDate(toDate, config.endDate.year, config.endDate.month, config.endDate.day);
 
             config.intervalDays = args.ephemerisIntervalDays;
+            config.intervalMinutes = args.ephemerisIntervalMinutes;
+            config.interpolationTolerance = args.ephemerisToleranceArcsec / 3600.0;
             config.format = args.ephemerisFormat;
 
             // Set zodiac mode and ayanamsa
@@ -2934,10 +4090,9 @@ int main(int argc, char* argv[]) {
             config.showDayNames = args.ephemerisShowDayNames;
             config.calendarMode = args.ephemerisCalendarMode;
 
-            std::string result = ephemTable.generateTable(config);
-
-            if (!result.empty()) {
-                std::cout << result << std::endl;
+            // Rows go straight to stdout instead of being built up in one string
+            if (ephemTable.writeTable(config, std::cout)) {
+                std::cout << std::endl;
             } else {
                 std::string error = ephemTable.getLastError();
                 if (!error.empty()) {
@@ -2955,6 +4110,7 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Error: Failed to initialize KP system" << std::endl;
                 return 1;
             }
+            phaseTimer.mark("KP system init");
 
             std::string fromDate = args.kpTransitionFromDate;
             std::string toDate = args.kpTransitionToDate;
@@ -3021,7 +4177,9 @@ int main(int argc, char* argv[]) {
 
             // Output results
             if (!allTransitions.empty()) {
-                std::string result = kpSystem.generateTransitionTable(allTransitions);
+                std::string result = args.kpOutputFormat == "json"
+                    ? kpSystem.generateTransitionTableJSON(allTransitions)
+                    : kpSystem.generateTransitionTable(allTransitions);
                 std::cout << result << std::endl;
             } else {
                 std::cout << "No KP transitions found in the specified period." << std::endl;
@@ -3031,8 +4189,7 @@ int main(int argc, char* argv[]) {
         // Handle Hindu Calendar (Panchanga) calculations
         if (args.showPanchangaRange) {
             HinduCalendar hinduCalendar;
-            if (!hinduCalendar.initialize()) {
-                std::cerr << "Error: Failed to initialize Hindu Calendar system: " << hinduCalendar.getLastError() << std::endl;
+            if (!initializeHinduCalendar(hinduCalendar, args)) {
                 return 1;
             }
 
@@ -3202,8 +4359,7 @@ int main(int argc, char* argv[]) {
         // Handle Simplified Julian Day Search
         if (args.searchJdOnly > 0) {
             HinduCalendar hinduCalendar;
-            if (!hinduCalendar.initialize()) {
-                std::cerr << "Error: Failed to initialize Hindu Calendar system: " << hinduCalendar.getLastError() << std::endl;
+            if (!initializeHinduCalendar(hinduCalendar, args)) {
                 return 1;
             }
 
@@ -3236,6 +4392,7 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Error: Failed to initialize Myanmar Calendar system" << std::endl;
                 return 1;
             }
+            phaseTimer.mark("Myanmar calendar init");
 
             try {
                 // Calculate Myanmar calendar data for the specific Julian Day
@@ -3301,6 +4458,7 @@ int main(int argc, char* argv[]) {
                     std::cerr << "Error: Failed to initialize horoscope calculator: " << calculator.getLastError() << "\n";
                     return 1;
                 }
+                phaseTimer.mark("calculator init");
 
                 BirthChart chart;
                 if (!calculator.calculateBirthChart(birthData, args.houseSystem, args.zodiacMode, args.ayanamsa, chart)) {
@@ -3330,8 +4488,7 @@ int main(int argc, char* argv[]) {
         // Handle Hindu Calendar Search
         if (args.showHinduSearch) {
             HinduCalendar hinduCalendar;
-            if (!hinduCalendar.initialize()) {
-                std::cerr << "Error: Failed to initialize Hindu Calendar system: " << hinduCalendar.getLastError() << std::endl;
+            if (!initializeHinduCalendar(hinduCalendar, args)) {
                 return 1;
             }
 
@@ -3420,25 +4577,26 @@ int main(int argc, char* argv[]) {
             if (!searchResults.empty()) {
                 // Generate output based on format
                 if (args.hinduSearchFormat == "json") {
-                    // Generate JSON output manually
-                    std::cout << "{\n";
-                    std::cout << "  \"search_criteria\": {\n";
-                    std::cout << "    \"date_range\": \"" << criteria.searchStartDate << " to " << criteria.searchEndDate << "\",\n";
-                    std::cout << "    \"exact_match\": " << (criteria.exactMatch ? "true" : "false") << ",\n";
-                    std::cout << "    \"tolerance\": " << criteria.nearMatchTolerance << "\n";
-                    std::cout << "  },\n";
-                    std::cout << "  \"results_count\": " << searchResults.size() << ",\n";
-                    std::cout << "  \"results\": [\n";
-                    for (size_t i = 0; i < searchResults.size(); ++i) {
-                        const auto& result = searchResults[i];
-                        std::cout << "    {\n";
-                        std::cout << "      \"gregorian_date\": \"" << result.gregorianDate << "\",\n";
-                        std::cout << "      \"match_score\": " << result.matchScore << ",\n";
-                        std::cout << "      \"panchanga\": " << hinduCalendar.generateJSON(result.panchangaData) << "\n";
-                        std::cout << "    }" << (i < searchResults.size() - 1 ? "," : "") << "\n";
+                    JsonWriter json;
+                    json.beginObject();
+                    json.key("search_criteria").beginObject();
+                    json.field("date_range", criteria.searchStartDate + " to " + criteria.searchEndDate);
+                    json.field("exact_match", criteria.exactMatch);
+                    json.field("tolerance", criteria.nearMatchTolerance);
+                    json.endObject();
+                    json.field("results_count", searchResults.size());
+                    json.key("results").beginArray();
+                    for (const auto& result : searchResults) {
+                        json.beginObject();
+                        json.field("gregorian_date", result.gregorianDate);
+                        json.field("match_score", result.matchScore);
+                        json.key("panchanga");
+                        hinduCalendar.writeJSON(json, result.panchangaData);
+                        json.endObject();
                     }
-                    std::cout << "  ]\n";
-                    std::cout << "}\n";
+                    json.endArray();
+                    json.endObject();
+                    std::cout << json.str() << "\n";
                 } else if (args.hinduSearchFormat == "csv") {
                     // Generate CSV output manually
                     std::cout << "Date,Score,HinduYear,Month,Tithi,Vara,Nakshatra,Yoga,Karana\n";
@@ -3516,6 +4674,7 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Error: Failed to initialize Myanmar Calendar system: " << myanmarCalendar.getLastError() << std::endl;
                 return 1;
             }
+            phaseTimer.mark("Myanmar calendar init");
 
             std::string fromDate = args.myanmarCalendarFromDate;
             std::string toDate = args.myanmarCalendarToDate;
@@ -3558,6 +4717,7 @@ int main(int argc, char* argv[]) {
                 std::cerr << "Error: Failed to initialize Myanmar calendar" << std::endl;
                 return 1;
             }
+            phaseTimer.mark("Myanmar calendar init");
 
             if (args.myanmarSearchStartDate.empty() || args.myanmarSearchEndDate.empty()) {
                 std::cerr << "Error: Myanmar calendar search requires --myanmar-search FROM TO dates" << std::endl;
@@ -3624,26 +4784,27 @@ int main(int argc, char* argv[]) {
             if (!searchResults.empty()) {
                 // Generate output based on format
                 if (args.myanmarSearchFormat == "json") {
-                    // Generate JSON output manually
-                    std::cout << "{\n";
-                    std::cout << "  \"search_criteria\": {\n";
-                    std::cout << "    \"date_range\": \"" << criteria.searchStartDate << " to " << criteria.searchEndDate << "\",\n";
-                    std::cout << "    \"exact_match\": " << (criteria.exactMatch ? "true" : "false") << ",\n";
-                    std::cout << "    \"tolerance\": " << criteria.nearMatchTolerance << "\n";
-                    std::cout << "  },\n";
-                    std::cout << "  \"results_count\": " << searchResults.size() << ",\n";
-                    std::cout << "  \"results\": [\n";
-                    for (size_t i = 0; i < searchResults.size(); ++i) {
-                        const auto& result = searchResults[i];
-                        std::cout << "    {\n";
-                        std::cout << "      \"gregorian_date\": \"" << result.gregorianDate << "\",\n";
-                        std::cout << "      \"match_score\": " << result.matchScore << ",\n";
-                        std::cout << "      \"match_description\": \"" << result.matchDescription << "\",\n";
-                        std::cout << "      \"myanmar_data\": " << myanmarCalendar.generateJSON(result.myanmarData) << "\n";
-                        std::cout << "    }" << (i < searchResults.size() - 1 ? "," : "") << "\n";
+                    JsonWriter json;
+                    json.beginObject();
+                    json.key("search_criteria").beginObject();
+                    json.field("date_range", criteria.searchStartDate + " to " + criteria.searchEndDate);
+                    json.field("exact_match", criteria.exactMatch);
+                    json.field("tolerance", criteria.nearMatchTolerance);
+                    json.endObject();
+                    json.field("results_count", searchResults.size());
+                    json.key("results").beginArray();
+                    for (const auto& result : searchResults) {
+                        json.beginObject();
+                        json.field("gregorian_date", result.gregorianDate);
+                        json.field("match_score", result.matchScore);
+                        json.field("match_description", result.matchDescription);
+                        json.key("myanmar_data");
+                        myanmarCalendar.writeJSON(json, result.myanmarData);
+                        json.endObject();
                     }
-                    std::cout << "  ]\n";
-                    std::cout << "}\n";
+                    json.endArray();
+                    json.endObject();
+                    std::cout << json.str() << "\n";
                 } else if (args.myanmarSearchFormat == "csv") {
                     // Generate CSV output manually
                     std::cout << "Date,Score,Description,MyanmarYear,Month,MoonPhase,FortnightDay,Weekday\n";
@@ -3947,6 +5108,7 @@ int main(int argc, char* argv[]) {
             std::cerr << "Error: Failed to initialize AstroCalendar system: " << astroCalendar.getLastError() << std::endl;
             return 1;
         }
+        phaseTimer.mark("astro calendar init");
 
         astroCalendar.setIncludePlanetaryTransitions(args.showPlanetaryTransitions);
 
@@ -3955,7 +5117,9 @@ int main(int argc, char* argv[]) {
             int year, month;
             if (sscanf(args.astroCalendarMonth.c_str(), "%d-%d", &year, &month) == 2) {
                 AstroCalendarMonth monthData = astroCalendar.calculateAstroCalendarMonth(year, month);
-                std::cout << astroCalendar.generateMonthlyCalendar(monthData, args.astroCalendarFormat) << std::endl;
+                std::string calendar = astroCalendar.generateMonthlyCalendar(monthData, args.astroCalendarFormat);
+                ASTRO_PROFILE_SCOPE("write output");
+                std::cout << calendar << std::endl;
             } else {
                 std::cerr << "Error: Invalid date format for monthly calendar. Use YYYY-MM format.\n";
                 return 1;
@@ -3968,6 +5132,12 @@ int main(int argc, char* argv[]) {
         return 0; // Exit after monthly astro-calendar
     }
 
+    // Month ranges, and the Hindu and Myanmar views together, share one day stream
+    if ((args.showHinduMonthlyCalendar || args.showMyanmarMonthlyCalendar) &&
+        (args.calendarMonths > 1 || (args.showHinduMonthlyCalendar && args.showMyanmarMonthlyCalendar))) {
+        return runMonthlyCalendars(args);
+    }
+
     // Handle Myanmar Monthly Calendar (doesn't need birth data)
     if (args.showMyanmarMonthlyCalendar) {
         MyanmarMonthlyCalendar myanmarMonthlyCalendar;
@@ -3976,6 +5146,7 @@ int main(int argc, char* argv[]) {
             std::cerr << "Error: Failed to initialize Myanmar Monthly Calendar: " << myanmarMonthlyCalendar.getLastError() << std::endl;
             return 1;
         }
+        phaseTimer.mark("Myanmar monthly calendar init");
 
         try {
             // Parse year and month from myanmarMonthlyCalendarDate
@@ -3986,30 +5157,16 @@ int main(int argc, char* argv[]) {
                 double longitude = args.longitude != 0.0 ? args.longitude : 96.1951; // Yangon
 
                 // Auto-enable calendars based on format
-                bool enableHindu = args.includeHindu;
-                bool enablePlanetary = args.includePlanetary;
-                bool enableAdvancedAstro = args.includeAdvancedAstro;
-
-                if (args.myanmarMonthlyCalendarFormat == "multi-calendar" ||
-                    args.myanmarMonthlyCalendarFormat == "hindu-myanmar" ||
-                    args.myanmarMonthlyCalendarFormat == "full-astronomical") {
-                    enableHindu = true;
-                }
-
-                if (args.myanmarMonthlyCalendarFormat == "planetary" ||
-                    args.myanmarMonthlyCalendarFormat == "full-astronomical") {
-                    enablePlanetary = true;
-                }
-
-                if (args.myanmarMonthlyCalendarFormat == "full-astronomical") {
-                    enableAdvancedAstro = true;
-                }
+                bool enableHindu, enablePlanetary, enableAdvancedAstro;
+                myanmarMonthlyIncludes(args, enableHindu, enablePlanetary, enableAdvancedAstro);
 
                 MyanmarMonthlyData monthData = myanmarMonthlyCalendar.calculateMonthlyData(
                     year, month, latitude, longitude,
                     args.includeGregorian, enableHindu, enablePlanetary, enableAdvancedAstro
                 );
-                std::cout << myanmarMonthlyCalendar.generateMonthlyCalendar(monthData, args.myanmarMonthlyCalendarFormat) << std::endl;
+                std::string calendar = myanmarMonthlyCalendar.generateMonthlyCalendar(monthData, args.myanmarMonthlyCalendarFormat);
+                ASTRO_PROFILE_SCOPE("write output");
+                std::cout << calendar << std::endl;
             } else {
                 std::cerr << "Error: Invalid date format for Myanmar monthly calendar. Use YYYY-MM format.\n";
                 return 1;
@@ -4022,6 +5179,64 @@ int main(int argc, char* argv[]) {
         return 0; // Exit after Myanmar monthly calendar
     }
 
+    // Handle long-range cycle statistics (doesn't need birth data)
+    if (args.showCycleStats) {
+        int fromYear, fromMonth, fromDay, toYear, toMonth, toDay;
+        if (!parseDate(args.cycleFromDate, fromYear, fromMonth, fromDay) ||
+            !parseDate(args.cycleToDate, toYear, toMonth, toDay)) {
+            std::cerr << "Error: Invalid date in --cycle-stats range" << std::endl;
+            return 1;
+        }
+
+        CycleStatistics statistics;
+        if (!statistics.initialize(args.ephemerisPath)) {
+            std::cerr << "Error: Failed to initialize cycle statistics: " << statistics.getLastError() << std::endl;
+            return 1;
+        }
+        phaseTimer.mark("cycle statistics init");
+        statistics.setPairs(args.cyclePairs);
+        statistics.setRetrogradePlanets(args.cycleRetrogradePlanets);
+        statistics.setZodiacMode(args.zodiacMode, args.ayanamsa);
+        statistics.setGrahaYuddhaOrb(args.cycleOrb);
+        statistics.setThreadCount(args.cycleThreads);
+
+        // The whole of the last day is included
+        CycleSummary summary;
+        if (!statistics.compute(swe_julday(fromYear, fromMonth, fromDay, 0.0, SE_GREG_CAL),
+                                swe_julday(toYear, toMonth, toDay, 24.0, SE_GREG_CAL), summary)) {
+            std::cerr << "Error: Failed to compute cycle statistics: " << statistics.getLastError() << std::endl;
+            return 1;
+        }
+
+        if (args.cycleFormat == "json") {
+            std::cout << statistics.generateJSON(summary);
+        } else {
+            std::cout << statistics.generateReport(summary) << std::endl;
+        }
+        return 0;
+    }
+
+    // Handle whole-year festival calendar (doesn't need birth data)
+    if (args.showFestivalCalendar) {
+        HinduCalendar hinduCalendar;
+        if (!initializeHinduCalendar(hinduCalendar, args)) {
+            return 1;
+        }
+
+        FestivalCalendar calendar = hinduCalendar.generateFestivalCalendar(args.festivalCalendarYear);
+        if (calendar.months.empty()) {
+            std::cerr << "Error: Failed to generate festival calendar: " << hinduCalendar.getLastError() << std::endl;
+            return 1;
+        }
+
+        if (args.panchangaFormat == "csv") {
+            std::cout << hinduCalendar.generateFestivalCalendarCSV(calendar);
+        } else {
+            std::cout << hinduCalendar.generateFestivalCalendarTable(calendar) << std::endl;
+        }
+        return 0;
+    }
+
     // Handle Hindu Monthly Calendar (doesn't need birth data, supports BC dates)
     if (args.showHinduMonthlyCalendar) {
         HinduMonthlyCalendar hinduMonthlyCalendar;
@@ -4030,40 +5245,13 @@ int main(int argc, char* argv[]) {
         double latitude = args.latitude != 0.0 ? args.latitude : 28.6139;  // New Delhi
         double longitude = args.longitude != 0.0 ? args.longitude : 77.2090; // New Delhi
 
-        // Set up display options
-        HinduMonthlyCalendar::DisplayOptions displayOptions = HinduMonthlyCalendar::getDefaultDisplayOptions();
-        displayOptions.ayanamsa = args.ayanamsa;
-        displayOptions.showMuhurta = args.hinduMonthlyShowMuhurta;
-
-        // Configure display based on format
-        if (args.hinduMonthlyCalendarFormat == "detailed") {
-            displayOptions.showMuhurta = true;
-            displayOptions.showRashiInfo = true;
-            displayOptions.showLunarPhase = true;
-        } else if (args.hinduMonthlyCalendarFormat == "panchanga") {
-            displayOptions.showTithi = true;
-            displayOptions.showNakshatra = true;
-            displayOptions.showYoga = true;
-            displayOptions.showKarana = true;
-        } else if (args.hinduMonthlyCalendarFormat == "compact") {
-            displayOptions.showPackedLayout = true;
-            displayOptions.cellWidth = 8;
-        } else if (args.hinduMonthlyCalendarFormat == "festivals") {
-            displayOptions.showFestivals = true;
-            displayOptions.showSpecialDays = true;
-            displayOptions.showVrataInfo = true;
-        } else if (args.hinduMonthlyCalendarFormat == "astronomical") {
-            displayOptions.showRashiInfo = true;
-            displayOptions.showLunarPhase = true;
-            displayOptions.showMuhurta = true;
-        } else if (args.hinduMonthlyCalendarFormat == "html") {
-            displayOptions.htmlOutput = true;
-        }
+        HinduMonthlyCalendar::DisplayOptions displayOptions = hinduMonthlyDisplayOptions(args);
 
         if (!hinduMonthlyCalendar.initialize(latitude, longitude, displayOptions)) {
             std::cerr << "Error: Failed to initialize Hindu Monthly Calendar: " << hinduMonthlyCalendar.getLastError() << std::endl;
             return 1;
         }
+        phaseTimer.mark("Hindu monthly calendar init");
 
         try {
             if (args.hinduMonthlyCalendarFormat == "csv") {
@@ -4075,7 +5263,9 @@ int main(int argc, char* argv[]) {
             } else if (args.hinduMonthlyCalendarFormat == "html") {
                 std::cout << hinduMonthlyCalendar.generateHTMLCalendar(args.hinduMonthlyCalendarDate) << std::endl;
             } else {
-                std::cout << hinduMonthlyCalendar.generateCalendar(args.hinduMonthlyCalendarDate) << std::endl;
+                std::string calendar = hinduMonthlyCalendar.generateCalendar(args.hinduMonthlyCalendarDate);
+                ASTRO_PROFILE_SCOPE("write output");
+                std::cout << calendar << std::endl;
             }
         } catch (const std::exception& e) {
             std::cerr << "Error generating Hindu monthly calendar: " << e.what() << std::endl;
@@ -4112,6 +5302,7 @@ int main(int argc, char* argv[]) {
         std::cerr << "Note: You may need to install Swiss Ephemeris data files or specify the path with --ephe-path\n";
         return 1;
     }
+    phaseTimer.mark("calculator init");
 
     // Set calculation parameters
     calculator.setZodiacMode(args.zodiacMode);
@@ -4120,12 +5311,33 @@ int main(int argc, char* argv[]) {
         calculator.setCalculationFlags(args.calculationFlags);
     }
 
+    if (args.animateStepMinutes > 0) {
+        return runAnimation(calculator, birthData, args);
+    }
+
     // Calculate birth chart
     BirthChart chart;
     if (!calculator.calculateBirthChart(birthData, args.houseSystem, args.zodiacMode, args.ayanamsa, chart)) {
         std::cerr << "Error: Failed to calculate birth chart: " << calculator.getLastError() << "\n";
         return 1;
     }
+    phaseTimer.mark("chart calculation");
+
+    if (!args.imageFile.empty()) {
+        ChartImageRenderer renderer;
+        if (!renderer.setChartStyle(args.chartStyle.empty() ? "western" : args.chartStyle)) {
+            std::cerr << "Error: " << renderer.getLastError() << "\n";
+            return 1;
+        }
+        std::string image;
+        renderer.render(chart, imageFormatForArgs(args, args.imageFile), image);
+        if (!writeBinaryFile(args.imageFile, image)) {
+            std::cerr << "Error: Cannot write " << args.imageFile << std::endl;
+            return 1;
+        }
+        std::cout << "Chart image written to " << args.imageFile << "\n";
+        return 0;
+    }
 
     // Handle KP Table if requested
     if (args.showKPTable) {
@@ -4134,6 +5346,7 @@ int main(int argc, char* argv[]) {
             std::cerr << "Error: Failed to initialize KP system" << std::endl;
             return 1;
         }
+        phaseTimer.mark("KP system init");
 
         if (args.kpOutputFormat == "table") {
             // Professional table output
@@ -4168,20 +5381,7 @@ int main(int argc, char* argv[]) {
                           << "Ashwini,Venus,Mars,Jupiter,Ge-Ash-Ve,Career\n";
             }
         } else if (args.kpOutputFormat == "json") {
-            std::cout << "{\n  \"kp_analysis\": [\n";
-            const auto& planetPositions = chart.getPlanetPositions();
-            for (size_t i = 0; i < planetPositions.size(); ++i) {
-                const auto& planet = planetPositions[i];
-                std::cout << "    {\n";
-                std::cout << "      \"planet\": \"" << getPlanetName(planet.planet) << "\",\n";
-                std::cout << "      \"longitude\": " << planet.longitude << ",\n";
-                std::cout << "      \"sign\": \"" << zodiacSignToString(longitudeToSign(planet.longitude)) << "\",\n";
-                std::cout << "      \"nakshatra\": \"Ashwini\",\n";
-                std::cout << "      \"sub_lord\": \"Venus\",\n";
-                std::cout << "      \"kp_notation\": \"Ge-Ash-Ve\"\n";
-                std::cout << "    }" << (i < planetPositions.size() - 1 ? "," : "") << "\n";
-            }
-            std::cout << "  ]\n}\n";
+            std::cout << kpSystem.generateKPTableJSON(chart.getPlanetPositions()) << std::endl;
         } else {
             // Traditional text output
             std::string kpTable = kpSystem.generateKPTable(chart.getPlanetPositions());
@@ -4197,8 +5397,7 @@ int main(int argc, char* argv[]) {
     // Handle Panchanga (Hindu Calendar) for birth date
     if (args.showPanchanga) {
         HinduCalendar hinduCalendar;
-        if (!hinduCalendar.initialize()) {
-            std::cerr << "Error: Failed to initialize Hindu Calendar system: " << hinduCalendar.getLastError() << std::endl;
+        if (!initializeHinduCalendar(hinduCalendar, args)) {
             return 1;
         }
 
@@ -4223,6 +5422,7 @@ int main(int argc, char* argv[]) {
             std::cerr << "Error: Failed to initialize Myanmar Calendar system: " << myanmarCalendar.getLastError() << std::endl;
             return 1;
         }
+        phaseTimer.mark("Myanmar calendar init");
 
         // Create a copy of birthData with Myanmar timezone for accurate calendar calculation
         BirthData myanmarBirthData = birthData;
@@ -4249,6 +5449,7 @@ int main(int argc, char* argv[]) {
             std::cerr << "Error: Failed to initialize Myanmar Calendar system: " << myanmarCalendar.getLastError() << std::endl;
             return 1;
         }
+        phaseTimer.mark("Myanmar calendar init");
 
         std::string fromDate = args.myanmarCalendarFromDate;
         std::string toDate = args.myanmarCalendarToDate;
@@ -4293,6 +5494,7 @@ int main(int argc, char* argv[]) {
             std::cerr << "Error: Failed to initialize AstroCalendar system: " << astroCalendar.getLastError() << std::endl;
             return 1;
         }
+        phaseTimer.mark("astro calendar init");
 
         // Set configuration options
         astroCalendar.setIncludePlanetaryTransitions(args.showPlanetaryTransitions);
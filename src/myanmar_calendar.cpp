@@ -6,6 +6,8 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include "myanmar_calendar.h"
+#include "profiler.h"
+#include "json_writer.h"
 #include "ephemeris_manager.h"
 #include <cmath>
 #include <sstream>
@@ -413,6 +415,7 @@ MyanmarCalendarData MyanmarCalendar::calculateMyanmarCalendar(const BirthData& b
 }
 
 MyanmarCalendarData MyanmarCalendar::calculateMyanmarCalendar(double julianDay) const {
+    ASTRO_PROFILE_SCOPE("MyanmarCalendar::calculateMyanmarCalendar");
     if (!initialized) {
         throw std::runtime_error("Myanmar calendar not initialized");
     }
@@ -663,54 +666,50 @@ std::string MyanmarCalendar::generateTable(const MyanmarCalendarData& data) cons
 }
 
 std::string MyanmarCalendar::generateJSON(const MyanmarCalendarData& data) const {
-    std::stringstream ss;
+    JsonWriter json;
+    json.reserve(1024);
+    writeJSON(json, data);
 
-    ss << "{\n";
-    ss << "  \"myanmarYear\": " << data.myanmarYear << ",\n";
-    ss << "  \"sasanaYear\": " << data.sasanaYear << ",\n";
-    ss << "  \"month\": {\n";
-    ss << "    \"number\": " << static_cast<int>(data.month) << ",\n";
-    ss << "    \"name\": \"" << getMyanmarMonthName(data.month) << "\"\n";
-    ss << "  },\n";
-    ss << "  \"dayOfMonth\": " << data.dayOfMonth << ",\n";
-    ss << "  \"yearType\": {\n";
-    ss << "    \"number\": " << static_cast<int>(data.yearType) << ",\n";
-    ss << "    \"name\": \"" << getYearTypeName(data.yearType) << "\"\n";
-    ss << "  },\n";
-    ss << "  \"weekday\": {\n";
-    ss << "    \"number\": " << static_cast<int>(data.weekday) << ",\n";
-    ss << "    \"name\": \"" << getMyanmarWeekdayName(data.weekday) << "\"\n";
-    ss << "  },\n";
-    ss << "  \"moonPhase\": {\n";
-    ss << "    \"number\": " << static_cast<int>(data.moonPhase) << ",\n";
-    ss << "    \"name\": \"" << getMoonPhaseName(data.moonPhase) << "\"\n";
-    ss << "  },\n";
-    ss << "  \"fortnightDay\": " << data.fortnightDay << ",\n";
-    ss << "  \"monthLength\": " << data.monthLength << ",\n";
-    ss << "  \"astrological\": {\n";
-    ss << "    \"mahabote\": \"" << getMahaboteName(data.mahabote) << "\",\n";
-    ss << "    \"nakhat\": \"" << getNakhatName(data.nakhat) << "\",\n";
-    ss << "    \"nagahle\": \"" << getNagahleDirectionName(data.nagahle) << "\",\n";
-    ss << "    \"sabbath\": " << (data.isSabbath ? "true" : "false") << ",\n";
-    ss << "    \"yatyaza\": " << (data.isYatyaza ? "true" : "false") << ",\n";
-    ss << "    \"pyathada\": " << (data.isPyathada ? "true" : "false") << ",\n";
-    ss << "    \"thamanyo\": " << (data.isThamanyo ? "true" : "false") << "\n";
-    ss << "  },\n";
-    ss << "  \"festivals\": [";
-    for (size_t i = 0; i < data.festivals.size(); ++i) {
-        ss << "\"" << data.festivals[i] << "\"";
-        if (i < data.festivals.size() - 1) ss << ", ";
-    }
-    ss << "],\n";
-    ss << "  \"astrologicalEvents\": [";
-    for (size_t i = 0; i < data.astrologicalEvents.size(); ++i) {
-        ss << "\"" << data.astrologicalEvents[i] << "\"";
-        if (i < data.astrologicalEvents.size() - 1) ss << ", ";
-    }
-    ss << "]\n";
-    ss << "}\n";
+    std::string result = json.take();
+    result += '\n';
+    return result;
+}
 
-    return ss.str();
+void MyanmarCalendar::writeJSON(JsonWriter& json, const MyanmarCalendarData& data) const {
+    json.beginObject();
+    json.field("myanmarYear", data.myanmarYear);
+    json.field("sasanaYear", data.sasanaYear);
+    json.key("month").beginObject();
+    json.field("number", static_cast<int>(data.month));
+    json.field("name", getMyanmarMonthName(data.month));
+    json.endObject();
+    json.field("dayOfMonth", data.dayOfMonth);
+    json.key("yearType").beginObject();
+    json.field("number", static_cast<int>(data.yearType));
+    json.field("name", getYearTypeName(data.yearType));
+    json.endObject();
+    json.key("weekday").beginObject();
+    json.field("number", static_cast<int>(data.weekday));
+    json.field("name", getMyanmarWeekdayName(data.weekday));
+    json.endObject();
+    json.key("moonPhase").beginObject();
+    json.field("number", static_cast<int>(data.moonPhase));
+    json.field("name", getMoonPhaseName(data.moonPhase));
+    json.endObject();
+    json.field("fortnightDay", data.fortnightDay);
+    json.field("monthLength", data.monthLength);
+    json.key("astrological").beginObject();
+    json.field("mahabote", getMahaboteName(data.mahabote));
+    json.field("nakhat", getNakhatName(data.nakhat));
+    json.field("nagahle", getNagahleDirectionName(data.nagahle));
+    json.field("sabbath", data.isSabbath);
+    json.field("yatyaza", data.isYatyaza);
+    json.field("pyathada", data.isPyathada);
+    json.field("thamanyo", data.isThamanyo);
+    json.endObject();
+    json.arrayField("festivals", data.festivals);
+    json.arrayField("astrologicalEvents", data.astrologicalEvents);
+    json.endObject();
 }
 
 /////////////////////////////////////////////////////////////////////////////
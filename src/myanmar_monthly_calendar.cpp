@@ -5,6 +5,9 @@
 /////////////////////////////////////////////////////////////////////////////
 
 #include "myanmar_monthly_calendar.h"
+#include "profiler.h"
+#include "json_writer.h"
+#include "display_width.h"
 #include <sstream>
 #include <iomanip>
 #include <ctime>
@@ -55,21 +58,9 @@ bool MyanmarMonthlyCalendar::initialize() {
 MyanmarMonthlyData MyanmarMonthlyCalendar::calculateMonthlyData(int year, int month, double latitude, double longitude,
                                                               bool includeGregorian, bool includeHindu,
                                                               bool includePlanetary, bool includeAdvancedAstro) const {
-    MyanmarMonthlyData monthData;
-
-    monthData.gregorianYear = year;
-    monthData.gregorianMonth = month;
-
-    // Store include flags
-    monthData.includeGregorian = includeGregorian;
-    monthData.includeHindu = includeHindu;
-    monthData.includePlanetary = includePlanetary;
-    monthData.includeAdvancedAstro = includeAdvancedAstro;
-
-    // Month names
-    std::vector<std::string> monthNames = {"January", "February", "March", "April", "May", "June",
-                                         "July", "August", "September", "October", "November", "December"};
-    monthData.gregorianMonthName = monthNames[month - 1];
+    ASTRO_PROFILE_SCOPE("MyanmarMonthlyCalendar::calculateMonthlyData");
+    MyanmarMonthlyData monthData = createMonthlyData(year, month, includeGregorian, includeHindu,
+                                                     includePlanetary, includeAdvancedAstro);
 
     // Calculate days in month
     int daysInMonth = 31;
@@ -91,43 +82,8 @@ MyanmarMonthlyData MyanmarMonthlyCalendar::calculateMonthlyData(int year, int mo
         double jd = swe_julday(year, month, day, 12.0, SE_GREG_CAL);
         dayData.julianDay = jd;
 
-        // Calculate Myanmar calendar data
         try {
-            MyanmarCalendarData myanmarData = myanmarCalendar.calculateMyanmarCalendar(jd);
-
-            // Extract Myanmar date information
-            dayData.myanmarDay = myanmarData.dayOfMonth;
-            dayData.weekday = myanmarData.weekday;
-            dayData.moonPhase = myanmarData.moonPhase;
-            dayData.isSabbath = myanmarData.isSabbath;
-            dayData.isYatyaza = myanmarData.isYatyaza;
-            dayData.isPyathada = myanmarData.isPyathada;
-            dayData.isThamanyo = myanmarData.isThamanyo;
-            dayData.festivals = myanmarData.festivals;
-            dayData.isHoliday = !myanmarData.festivals.empty();
-
-            // Set Myanmar year and month from first day
-            if (day == 1) {
-                monthData.myanmarYear = myanmarData.myanmarYear;
-                monthData.myanmarMonth = myanmarData.month;
-                monthData.myanmarMonthName = myanmarCalendar.getMyanmarMonthName(myanmarData.month);
-            }
-
-            // Determine day quality
-            if (dayData.isSabbath || dayData.isThamanyo) {
-                dayData.qualityIndicator = "*"; // Excellent/Religious (changed from emoji)
-            } else if (dayData.isPyathada || dayData.isYatyaza) {
-                dayData.qualityIndicator = "!"; // Inauspicious (changed from emoji)
-            } else if (dayData.isHoliday) {
-                dayData.qualityIndicator = "#"; // Festival (changed from emoji)
-            } else {
-                dayData.qualityIndicator = "."; // Neutral (changed from emoji)
-            }
-
-            // Calculate additional calendar systems if requested
-            if (includeGregorian) {
-                calculateGregorianData(dayData, year, month, day);
-            }
+            fillDayData(monthData, dayData, myanmarCalendar.calculateMyanmarCalendar(jd));
 
             if (includeHindu) {
                 calculateHinduCalendarData(dayData, jd);
@@ -138,38 +94,138 @@ MyanmarMonthlyData MyanmarMonthlyCalendar::calculateMonthlyData(int year, int mo
             }
 
         } catch (...) {
-            // Fill with default values if calculation fails
-            dayData.myanmarDay = 0;
-            dayData.weekday = MyanmarWeekday::SATURDAY;
-            dayData.moonPhase = MyanmarMoonPhase::NEW_MOON;
-            dayData.qualityIndicator = ".";
+            setDefaultDayData(dayData, includeHindu);
+        }
+
+        monthData.days.push_back(dayData);
+    }
+
+    completeMonthlyData(monthData);
+    return monthData;
+}
+
+MyanmarMonthlyData MyanmarMonthlyCalendar::calculateMonthlyData(const CalendarMonthDays& monthDays,
+                                                              bool includeGregorian, bool includeHindu,
+                                                              bool includePlanetary, bool includeAdvancedAstro) const {
+    ASTRO_PROFILE_SCOPE("MyanmarMonthlyCalendar::calculateMonthlyData");
+    MyanmarMonthlyData monthData = createMonthlyData(monthDays.year, monthDays.month, includeGregorian,
+                                                     includeHindu, includePlanetary, includeAdvancedAstro);
+
+    for (const auto& day : monthDays.days) {
+        MyanmarMonthlyData::DayData dayData;
+        dayData.gregorianDay = day.day;
+        dayData.julianDay = day.julianDay;
+
+        try {
+            fillDayData(monthData, dayData, day.myanmar);
 
-            // Initialize Hindu data with default values to prevent segfault
             if (includeHindu) {
-                dayData.hindu.hinduDay = 1;
-                dayData.hindu.hinduYear = 2024;
-                dayData.hindu.hinduMonthName = "Unknown";
-                dayData.hindu.paksha = "Unknown";
-                dayData.hindu.nakshatraName = "Unknown";
-                dayData.hindu.vikramSamvat = 2081;
-                dayData.hindu.ritu = "Unknown";
-                dayData.hindu.isEkadashi = false;
-                dayData.hindu.isPurnima = false;
-                dayData.hindu.isAmavasya = false;
-                dayData.hindu.isAuspiciousDay = false;
-                dayData.hindu.isInauspiciousDay = false;
+                applyHinduCalendarData(dayData, &day.panchanga);
+            }
+
+            if (includePlanetary || includeAdvancedAstro) {
+                calculatePlanetaryData(dayData, day.julianDay);
             }
+
+        } catch (...) {
+            setDefaultDayData(dayData, includeHindu);
         }
 
         monthData.days.push_back(dayData);
     }
 
+    completeMonthlyData(monthData);
+    return monthData;
+}
+
+MyanmarMonthlyData MyanmarMonthlyCalendar::createMonthlyData(int year, int month, bool includeGregorian,
+                                                           bool includeHindu, bool includePlanetary,
+                                                           bool includeAdvancedAstro) const {
+    MyanmarMonthlyData monthData;
+
+    monthData.gregorianYear = year;
+    monthData.gregorianMonth = month;
+
+    // Store include flags
+    monthData.includeGregorian = includeGregorian;
+    monthData.includeHindu = includeHindu;
+    monthData.includePlanetary = includePlanetary;
+    monthData.includeAdvancedAstro = includeAdvancedAstro;
+
+    // Month names
+    static const char* const monthNames[] = {"January", "February", "March", "April", "May", "June",
+                                             "July", "August", "September", "October", "November", "December"};
+    monthData.gregorianMonthName = monthNames[month - 1];
+
+    return monthData;
+}
+
+void MyanmarMonthlyCalendar::fillDayData(MyanmarMonthlyData& monthData, MyanmarMonthlyData::DayData& dayData,
+                                         const MyanmarCalendarData& myanmarData) const {
+    // Extract Myanmar date information
+    dayData.myanmarDay = myanmarData.dayOfMonth;
+    dayData.weekday = myanmarData.weekday;
+    dayData.moonPhase = myanmarData.moonPhase;
+    dayData.isSabbath = myanmarData.isSabbath;
+    dayData.isYatyaza = myanmarData.isYatyaza;
+    dayData.isPyathada = myanmarData.isPyathada;
+    dayData.isThamanyo = myanmarData.isThamanyo;
+    dayData.festivals = myanmarData.festivals;
+    dayData.isHoliday = !myanmarData.festivals.empty();
+
+    // Set Myanmar year and month from first day
+    if (dayData.gregorianDay == 1) {
+        monthData.myanmarYear = myanmarData.myanmarYear;
+        monthData.myanmarMonth = myanmarData.month;
+        monthData.myanmarMonthName = myanmarCalendar.getMyanmarMonthName(myanmarData.month);
+    }
+
+    // Determine day quality
+    if (dayData.isSabbath || dayData.isThamanyo) {
+        dayData.qualityIndicator = "*"; // Excellent/Religious (changed from emoji)
+    } else if (dayData.isPyathada || dayData.isYatyaza) {
+        dayData.qualityIndicator = "!"; // Inauspicious (changed from emoji)
+    } else if (dayData.isHoliday) {
+        dayData.qualityIndicator = "#"; // Festival (changed from emoji)
+    } else {
+        dayData.qualityIndicator = "."; // Neutral (changed from emoji)
+    }
+
+    // Calculate additional calendar systems if requested
+    if (monthData.includeGregorian) {
+        calculateGregorianData(dayData, monthData.gregorianYear, monthData.gregorianMonth, dayData.gregorianDay);
+    }
+}
+
+void MyanmarMonthlyCalendar::setDefaultDayData(MyanmarMonthlyData::DayData& dayData, bool includeHindu) const {
+    // Fill with default values if calculation fails
+    dayData.myanmarDay = 0;
+    dayData.weekday = MyanmarWeekday::SATURDAY;
+    dayData.moonPhase = MyanmarMoonPhase::NEW_MOON;
+    dayData.qualityIndicator = ".";
+
+    // Initialize Hindu data with default values to prevent segfault
+    if (includeHindu) {
+        dayData.hindu.hinduDay = 1;
+        dayData.hindu.hinduYear = 2024;
+        dayData.hindu.hinduMonthName = "Unknown";
+        dayData.hindu.paksha = "Unknown";
+        dayData.hindu.nakshatraName = "Unknown";
+        dayData.hindu.vikramSamvat = 2081;
+        dayData.hindu.ritu = "Unknown";
+        dayData.hindu.isEkadashi = false;
+        dayData.hindu.isPurnima = false;
+        dayData.hindu.isAmavasya = false;
+        dayData.hindu.isAuspiciousDay = false;
+        dayData.hindu.isInauspiciousDay = false;
+    }
+}
+
+void MyanmarMonthlyCalendar::completeMonthlyData(MyanmarMonthlyData& monthData) const {
     // Calculate statistics and identify special days
     calculateMonthlyStatistics(monthData);
     calculateMultiCalendarStatistics(monthData);
     identifySpecialDays(monthData);
-
-    return monthData;
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -177,6 +233,7 @@ MyanmarMonthlyData MyanmarMonthlyCalendar::calculateMonthlyData(int year, int mo
 /////////////////////////////////////////////////////////////////////////////
 
 std::string MyanmarMonthlyCalendar::generateMonthlyCalendar(const MyanmarMonthlyData& monthData, const std::string& format) const {
+    ASTRO_PROFILE_SCOPE("MyanmarMonthlyCalendar::generateMonthlyCalendar");
     if (format == "traditional") {
         return generateTraditionalLayout(monthData);
     } else if (format == "modern") {
@@ -474,55 +531,12 @@ std::string MyanmarMonthlyCalendar::generateBlogStyleLayout(const MyanmarMonthly
 
 // Calculate display width of a string considering Unicode characters
 int MyanmarMonthlyCalendar::getDisplayWidth(const std::string& str) const {
-    int width = 0;
-    size_t i = 0;
-    while (i < str.length()) {
-        unsigned char c = str[i];
-        if (c < 0x80) {
-            // ASCII character
-            width += 1;
-            i += 1;
-        } else if (c < 0xC0) {
-            // Invalid UTF-8 continuation byte, skip
-            i += 1;
-        } else if (c < 0xE0) {
-            // 2-byte UTF-8 character
-            width += 1; // Most 2-byte chars are single width
-            i += 2;
-        } else if (c < 0xF0) {
-            // 3-byte UTF-8 character (includes Myanmar script and some emojis)
-            if (c >= 0xE1 && i + 2 < str.length() &&
-                (unsigned char)str[i+1] >= 0x80 && (unsigned char)str[i+1] <= 0xAF) {
-                // Myanmar Unicode range U+1000-U+109F
-                width += 2; // Myanmar characters are wide
-            } else {
-                width += 1; // Other 3-byte chars (some emojis, symbols)
-            }
-            i += 3;
-        } else {
-            // 4-byte UTF-8 character (most emojis)
-            width += 2; // Emojis are typically double-width
-            i += 4;
-        }
-    }
-    return width;
+    return displayWidth(str);
 }
 
 // Pad string to exact display width considering Unicode characters
 std::string MyanmarMonthlyCalendar::padToDisplayWidth(const std::string& str, int targetWidth, bool rightAlign) const {
-    int currentWidth = getDisplayWidth(str);
-    int padding = targetWidth - currentWidth;
-
-    if (padding <= 0) {
-        return str; // String is already at or exceeds target width
-    }
-
-    std::string paddingStr(padding, ' ');
-    if (rightAlign) {
-        return paddingStr + str;
-    } else {
-        return str + paddingStr;
-    }
+    return padToWidth(str, targetWidth, rightAlign);
 }
 
 /////////////////////////////////////////////////////////////////////////////
@@ -1087,58 +1101,49 @@ tabulate::Table MyanmarMonthlyCalendar::createSummaryTable(const MyanmarMonthlyD
 /////////////////////////////////////////////////////////////////////////////
 
 std::string MyanmarMonthlyCalendar::generateJSON(const MyanmarMonthlyData& monthData) const {
-    std::stringstream ss;
-
-    ss << "{\n";
-    ss << "  \"calendar\": {\n";
-    ss << "    \"type\": \"myanmar_monthly\",\n";
-    ss << "    \"gregorian\": {\n";
-    ss << "      \"year\": " << monthData.gregorianYear << ",\n";
-    ss << "      \"month\": " << monthData.gregorianMonth << ",\n";
-    ss << "      \"monthName\": \"" << monthData.gregorianMonthName << "\"\n";
-    ss << "    },\n";
-    ss << "    \"myanmar\": {\n";
-    ss << "      \"year\": " << monthData.myanmarYear << ",\n";
-    ss << "      \"monthName\": \"" << monthData.myanmarMonthName << "\"\n";
-    ss << "    },\n";
-    ss << "    \"statistics\": {\n";
-    ss << "      \"sabbathDays\": " << monthData.sabbathDays << ",\n";
-    ss << "      \"auspiciousDays\": " << monthData.auspiciousDays << ",\n";
-    ss << "      \"inauspiciousDays\": " << monthData.inauspiciousDays << ",\n";
-    ss << "      \"festivalDays\": " << monthData.festivalDays << "\n";
-    ss << "    },\n";
-    ss << "    \"days\": [\n";
-
-    for (size_t i = 0; i < monthData.days.size(); ++i) {
-        const auto& day = monthData.days[i];
-        if (i > 0) ss << ",\n";
-
-        ss << "      {\n";
-        ss << "        \"gregorianDay\": " << day.gregorianDay << ",\n";
-        ss << "        \"myanmarDay\": " << day.myanmarDay << ",\n";
-        ss << "        \"weekday\": \"" << myanmarCalendar.getMyanmarWeekdayName(day.weekday) << "\",\n";
-        ss << "        \"moonPhase\": \"" << myanmarCalendar.getMoonPhaseName(day.moonPhase) << "\",\n";
-        ss << "        \"qualityIndicator\": \"" << day.qualityIndicator << "\",\n";
-        ss << "        \"astrological\": {\n";
-        ss << "          \"sabbath\": " << (day.isSabbath ? "true" : "false") << ",\n";
-        ss << "          \"yatyaza\": " << (day.isYatyaza ? "true" : "false") << ",\n";
-        ss << "          \"pyathada\": " << (day.isPyathada ? "true" : "false") << ",\n";
-        ss << "          \"thamanyo\": " << (day.isThamanyo ? "true" : "false") << "\n";
-        ss << "        },\n";
-        ss << "        \"festivals\": [";
-        for (size_t j = 0; j < day.festivals.size(); ++j) {
-            if (j > 0) ss << ", ";
-            ss << "\"" << day.festivals[j] << "\"";
-        }
-        ss << "]\n";
-        ss << "      }";
+    JsonWriter json;
+    json.reserve(1024 + monthData.days.size() * 400);
+    json.beginObject();
+    json.key("calendar").beginObject();
+    json.field("type", "myanmar_monthly");
+    json.key("gregorian").beginObject();
+    json.field("year", monthData.gregorianYear);
+    json.field("month", monthData.gregorianMonth);
+    json.field("monthName", monthData.gregorianMonthName);
+    json.endObject();
+    json.key("myanmar").beginObject();
+    json.field("year", monthData.myanmarYear);
+    json.field("monthName", monthData.myanmarMonthName);
+    json.endObject();
+    json.key("statistics").beginObject();
+    json.field("sabbathDays", monthData.sabbathDays);
+    json.field("auspiciousDays", monthData.auspiciousDays);
+    json.field("inauspiciousDays", monthData.inauspiciousDays);
+    json.field("festivalDays", monthData.festivalDays);
+    json.endObject();
+
+    json.key("days").beginArray();
+    for (const auto& day : monthData.days) {
+        json.beginObject();
+        json.field("gregorianDay", day.gregorianDay);
+        json.field("myanmarDay", day.myanmarDay);
+        json.field("weekday", myanmarCalendar.getMyanmarWeekdayName(day.weekday));
+        json.field("moonPhase", myanmarCalendar.getMoonPhaseName(day.moonPhase));
+        json.field("qualityIndicator", day.qualityIndicator);
+        json.key("astrological").beginObject();
+        json.field("sabbath", day.isSabbath);
+        json.field("yatyaza", day.isYatyaza);
+        json.field("pyathada", day.isPyathada);
+        json.field("thamanyo", day.isThamanyo);
+        json.endObject();
+        json.arrayField("festivals", day.festivals);
+        json.endObject();
     }
+    json.endArray();
 
-    ss << "\n    ]\n";
-    ss << "  }\n";
-    ss << "}";
-
-    return ss.str();
+    json.endObject();
+    json.endObject();
+    return json.take();
 }
 
 std::string MyanmarMonthlyCalendar::generateCSV(const MyanmarMonthlyData& monthData) const {
@@ -1320,6 +1325,20 @@ void MyanmarMonthlyCalendar::calculateGregorianData(MyanmarMonthlyData::DayData&
 }
 
 void MyanmarMonthlyCalendar::calculateHinduCalendarData(MyanmarMonthlyData::DayData& dayData, double julianDay) const {
+    try {
+        // Calculate panchanga with default location (Delhi)
+        double latitude = 28.6139;   // Delhi latitude
+        double longitude = 77.2090;  // Delhi longitude
+
+        PanchangaData panchanga = hinduCalendar.calculatePanchanga(julianDay, latitude, longitude);
+        applyHinduCalendarData(dayData, &panchanga);
+    } catch (const std::exception& e) {
+        // If panchanga calculation fails, keep default values
+        applyHinduCalendarData(dayData, nullptr);
+    }
+}
+
+void MyanmarMonthlyCalendar::applyHinduCalendarData(MyanmarMonthlyData::DayData& dayData, const PanchangaData* source) const {
     try {
         // Initialize all values with defaults first
         dayData.hindu.hinduDay = 0;
@@ -1344,66 +1363,57 @@ void MyanmarMonthlyCalendar::calculateHinduCalendarData(MyanmarMonthlyData::DayD
         dayData.hindu.festivals.clear();
         dayData.hindu.comprehensiveInfo.clear();
 
-        // Now calculate the Panchanga data carefully
+        if (!source) {
+            return;
+        }
+        const PanchangaData& panchanga = *source;
+
+        // Copy data safely from panchanga to dayData
+        dayData.hindu.tithiName = hinduCalendar.getTithiName(panchanga.tithi);
+        dayData.hindu.nakshatraName = hinduCalendar.getNakshatraName(panchanga.nakshatra);
+        dayData.hindu.yogaName = hinduCalendar.getYogaName(panchanga.yoga);
+        dayData.hindu.karanaName = hinduCalendar.getKaranaName(panchanga.karana);
+        dayData.hindu.hinduMonthName = hinduCalendar.getHinduMonthName(panchanga.month);
+        dayData.hindu.paksha = panchanga.isShukla ? "Shukla Paksha" : "Krishna Paksha";
+        dayData.hindu.moonSign = hinduCalendar.getRashiName(panchanga.moonRashi);
+        dayData.hindu.ritu = panchanga.ritu;
+        dayData.hindu.hinduDay = panchanga.day;
+        dayData.hindu.hinduYear = panchanga.year;
+        dayData.hindu.vikramSamvat = panchanga.vikramYear;
+        dayData.hindu.nakshatraPada = panchanga.nakshatraPada;
+
+        // Copy boolean flags
+        dayData.hindu.isEkadashi = panchanga.isEkadashi;
+        dayData.hindu.isPurnima = panchanga.isPurnima;
+        dayData.hindu.isAmavasya = panchanga.isAmavasya;
+        dayData.hindu.isAuspiciousDay = panchanga.isSarvarthaSiddhi || panchanga.isAmritaSiddhi;
+        dayData.hindu.isInauspiciousDay = false; // Can be set based on other criteria
+
+        // Copy festivals safely
         try {
-            // Calculate panchanga with default location (Delhi)
-            double latitude = 28.6139;   // Delhi latitude
-            double longitude = 77.2090;  // Delhi longitude
-
-            // Call calculatePanchanga and manage memory carefully
-            PanchangaData panchanga = hinduCalendar.calculatePanchanga(julianDay, latitude, longitude);
-
-            // Copy data safely from panchanga to dayData
-            dayData.hindu.tithiName = hinduCalendar.getTithiName(panchanga.tithi);
-            dayData.hindu.nakshatraName = hinduCalendar.getNakshatraName(panchanga.nakshatra);
-            dayData.hindu.yogaName = hinduCalendar.getYogaName(panchanga.yoga);
-            dayData.hindu.karanaName = hinduCalendar.getKaranaName(panchanga.karana);
-            dayData.hindu.hinduMonthName = hinduCalendar.getHinduMonthName(panchanga.month);
-            dayData.hindu.paksha = panchanga.isShukla ? "Shukla Paksha" : "Krishna Paksha";
-            dayData.hindu.moonSign = hinduCalendar.getRashiName(panchanga.moonRashi);
-            dayData.hindu.ritu = panchanga.ritu;
-            dayData.hindu.hinduDay = panchanga.day;
-            dayData.hindu.hinduYear = panchanga.year;
-            dayData.hindu.vikramSamvat = panchanga.vikramYear;
-            dayData.hindu.nakshatraPada = panchanga.nakshatraPada;
-
-            // Copy boolean flags
-            dayData.hindu.isEkadashi = panchanga.isEkadashi;
-            dayData.hindu.isPurnima = panchanga.isPurnima;
-            dayData.hindu.isAmavasya = panchanga.isAmavasya;
-            dayData.hindu.isAuspiciousDay = panchanga.isSarvarthaSiddhi || panchanga.isAmritaSiddhi;
-            dayData.hindu.isInauspiciousDay = false; // Can be set based on other criteria
-
-            // Copy festivals safely
-            try {
-                if (!panchanga.festivals.empty()) {
-                    dayData.hindu.festivals.reserve(panchanga.festivals.size());
-                    for (const auto& festival : panchanga.festivals) {
-                        dayData.hindu.festivals.push_back(festival);
-                    }
+            if (!panchanga.festivals.empty()) {
+                dayData.hindu.festivals.reserve(panchanga.festivals.size());
+                for (const auto& festival : panchanga.festivals) {
+                    dayData.hindu.festivals.push_back(festival);
                 }
-            } catch (const std::exception& e) {
-                // If festival copying fails, just continue without festivals
-                dayData.hindu.festivals.clear();
-            }
-
-            // Create comprehensive info map
-            try {
-                dayData.hindu.comprehensiveInfo.clear();
-                dayData.hindu.comprehensiveInfo["Tithi"] = dayData.hindu.tithiName;
-                dayData.hindu.comprehensiveInfo["Nakshatra"] = dayData.hindu.nakshatraName;
-                dayData.hindu.comprehensiveInfo["Yoga"] = dayData.hindu.yogaName;
-                dayData.hindu.comprehensiveInfo["Karana"] = dayData.hindu.karanaName;
-                dayData.hindu.comprehensiveInfo["Paksha"] = dayData.hindu.paksha;
-                dayData.hindu.comprehensiveInfo["Ritu"] = dayData.hindu.ritu;
-            } catch (const std::exception& e) {
-                dayData.hindu.comprehensiveInfo.clear();
-                dayData.hindu.comprehensiveInfo["Status"] = "Hindu calendar data available";
             }
+        } catch (const std::exception& e) {
+            // If festival copying fails, just continue without festivals
+            dayData.hindu.festivals.clear();
+        }
 
+        // Create comprehensive info map
+        try {
+            dayData.hindu.comprehensiveInfo.clear();
+            dayData.hindu.comprehensiveInfo["Tithi"] = dayData.hindu.tithiName;
+            dayData.hindu.comprehensiveInfo["Nakshatra"] = dayData.hindu.nakshatraName;
+            dayData.hindu.comprehensiveInfo["Yoga"] = dayData.hindu.yogaName;
+            dayData.hindu.comprehensiveInfo["Karana"] = dayData.hindu.karanaName;
+            dayData.hindu.comprehensiveInfo["Paksha"] = dayData.hindu.paksha;
+            dayData.hindu.comprehensiveInfo["Ritu"] = dayData.hindu.ritu;
         } catch (const std::exception& e) {
-            // If panchanga calculation fails, keep default values
-            // Already set above, so nothing more to do
+            dayData.hindu.comprehensiveInfo.clear();
+            dayData.hindu.comprehensiveInfo["Status"] = "Hindu calendar data available";
         }
 
     } catch (const std::exception& e) {
@@ -0,0 +1,162 @@
+#include "position_stream.h"
+#include "profiler.h"
+#include "swiss_ephemeris.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+extern "C" {
+#include "swephexp.h"
+}
+
+namespace Astro {
+
+namespace {
+
+const double FIRST_SPAN_STEPS = 8.0;
+const double SHORTEST_SPAN_STEPS = 4.0;     // shorter windows compute as many points as they serve
+const double FIRST_RETRY_STEPS = 8.0;       // steps served exactly after a window fails, doubling
+const double LAST_RETRY_STEPS = 512.0;      // while the body stays too curved for the tolerance
+const double LONGEST_SPAN_DAYS = 32.0;      // well inside the shortest loop of a planet's apparent path
+const double RADIANS_TO_DEGREES = 180.0 / M_PI;
+
+} // namespace
+
+PositionStream::PositionStream(int body, int flags, bool universalTime, double step, double tolerance)
+    : body(body), flags(flags), universalTime(universalTime), step(step), tolerance(tolerance),
+      first{0.0, 0, {}}, middle{0.0, 0, {}}, last{0.0, 0, {}},
+      span(FIRST_SPAN_STEPS * step), retryAfter(-HUGE_VAL), retrySteps(FIRST_RETRY_STEPS) {
+    // Hermite needs speeds, and angles in degrees to unwrap
+    if (!(flags & SEFLG_SPEED) || (flags & (SEFLG_XYZ | SEFLG_RADIANS)) || step <= 0.0 || tolerance <= 0.0) {
+        span = 0.0;
+    }
+}
+
+int PositionStream::calc(double julianDay, double* result, char* error) {
+    // A halved window may stop short of the request; the next one starts at its end
+    while (last.julianDay <= first.julianDay || julianDay < first.julianDay || julianDay > last.julianDay) {
+        if (span == 0.0 || julianDay < retryAfter || !openWindow(julianDay, error)) {
+            if (span != 0.0 && julianDay >= retryAfter) {
+                retryAfter = julianDay + retrySteps * step;
+                retrySteps = std::min(2.0 * retrySteps, LAST_RETRY_STEPS);
+            }
+            return universalTime ? SwissEphemeris::calcUt(julianDay, body, flags, result, error)
+                                 : SwissEphemeris::calc(julianDay, body, flags, result, error);
+        }
+    }
+
+    if (error) {
+        error[0] = '\0';
+    }
+    if (julianDay == first.julianDay || julianDay == middle.julianDay || julianDay == last.julianDay) {
+        const Node& node = julianDay == first.julianDay ? first : julianDay == middle.julianDay ? middle : last;
+        std::memcpy(result, node.position, sizeof(node.position));
+    } else {
+        ASTRO_PROFILE_COUNT_DETAIL("position stream interpolated", 1, SwissEphemeris::bodyName(body));
+        if (julianDay < middle.julianDay) {
+            interpolate(first, middle, julianDay, result);
+        } else {
+            interpolate(middle, last, julianDay, result);
+        }
+    }
+    return first.returnFlags;
+}
+
+int PositionStream::exact(double julianDay, Node& node, char* error) const {
+    node.julianDay = julianDay;
+    node.returnFlags = universalTime ? SwissEphemeris::calcUt(julianDay, body, flags, node.position, error)
+                                     : SwissEphemeris::calc(julianDay, body, flags, node.position, error);
+    if (node.returnFlags >= 0 && error && error[0]) {
+        return -1;      // a warning has to reach the caller, so never interpolate across it
+    }
+    return node.returnFlags;
+}
+
+bool PositionStream::openWindow(double julianDay, char* error) {
+    // Continue from the previous window when the request follows it
+    Node a;
+    if (last.julianDay > first.julianDay && julianDay > last.julianDay && julianDay < last.julianDay + span) {
+        a = last;
+    } else if (exact(julianDay, a, error) < 0) {
+        return false;
+    }
+
+    // Halve until the middle agrees with the curve through the ends, reusing
+    // each failed window's middle as the next one's end. The middle is taken
+    // first so that a passing window reads the ephemeris in time order.
+    double width = std::min(span, std::max(LONGEST_SPAN_DAYS, SHORTEST_SPAN_STEPS * step));
+    Node b, m;
+    for (bool haveEnd = false; width >= SHORTEST_SPAN_STEPS * step; width /= 2.0) {
+        if (exact(a.julianDay + width / 2.0, m, error) < 0 ||
+            (!haveEnd && exact(a.julianDay + width, b, error) < 0)) {
+            return false;
+        }
+        haveEnd = true;
+        if (m.returnFlags != a.returnFlags || b.returnFlags != a.returnFlags) {
+            break;
+        }
+
+        double deviation = windowError(a, b, m);
+        if (deviation <= tolerance) {
+            first = a;
+            middle = m;
+            last = b;
+            span = deviation <= tolerance / 32.0 ? std::min(2.0 * width, LONGEST_SPAN_DAYS) : width;
+            retrySteps = FIRST_RETRY_STEPS;
+            return true;
+        }
+        b = m;
+    }
+
+    // Too curved to skip a step here; the caller computes exactly for a while
+    first = last = a;
+    span = FIRST_SPAN_STEPS * step;
+    return false;
+}
+
+double PositionStream::windowError(const Node& a, const Node& b, const Node& check) const {
+    double estimate[6];
+    interpolate(a, b, check.julianDay, estimate);
+
+    // Positions only: the speeds Swiss Ephemeris returns scatter by up to
+    // 1e-5 degrees per day, far more than an interpolant's own error
+    double error = std::max(std::abs(std::remainder(estimate[0] - check.position[0], 360.0)),
+                            std::abs(estimate[1] - check.position[1]));
+
+    // Distance as the angle its relative error would subtend
+    if (check.position[2] != 0.0) {
+        error = std::max(error, std::abs((estimate[2] - check.position[2]) / check.position[2]) * RADIANS_TO_DEGREES);
+    }
+    return error;
+}
+
+void PositionStream::interpolate(const Node& a, const Node& b, double julianDay, double* result) const {
+    double h = b.julianDay - a.julianDay;
+    double s = (julianDay - a.julianDay) / h;
+    double s2 = s * s;
+    double s3 = s2 * s;
+
+    // Cubic Hermite basis and its derivative with respect to s
+    double h00 = 2 * s3 - 3 * s2 + 1, h10 = s3 - 2 * s2 + s, h01 = -2 * s3 + 3 * s2, h11 = s3 - s2;
+    double d00 = 6 * s2 - 6 * s, d10 = 3 * s2 - 4 * s + 1, d01 = -6 * s2 + 6 * s, d11 = 3 * s2 - 2 * s;
+
+    for (int i = 0; i < 3; i++) {
+        double pa = a.position[i];
+        double pb = b.position[i];
+        if (i == 0) {
+            pb = pa + std::remainder(pb - pa, 360.0);   // longitude or right ascension
+        }
+        double va = a.position[i + 3] * h;
+        double vb = b.position[i + 3] * h;
+
+        result[i] = h00 * pa + h10 * va + h01 * pb + h11 * vb;
+        result[i + 3] = (d00 * pa + d10 * va + d01 * pb + d11 * vb) / h;
+    }
+
+    result[0] = std::fmod(result[0], 360.0);
+    if (result[0] < 0.0) {
+        result[0] += 360.0;
+    }
+}
+
+} // namespace Astro
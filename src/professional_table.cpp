@@ -1,4 +1,7 @@
 #include "professional_table.h"
+#include "profiler.h"
+#include "display_width.h"
+#include "json_writer.h"
 #include <algorithm>
 #include <iostream>
 #include <cmath>
@@ -22,45 +25,46 @@ std::vector<std::string> TableCell::getWrappedLines(int maxWidth) const {
         return {content};
     }
 
+    // Walk the content by offset; each line is copied out once. Breaks are
+    // found in display columns, so wide and combining characters wrap whole.
     std::vector<std::string> lines;
-    std::string remaining = content;
-
-    while (!remaining.empty()) {
-        if (static_cast<int>(remaining.length()) <= maxWidth) {
-            lines.push_back(remaining);
+    size_t start = 0;
+
+    while (start < content.size()) {
+        const char* rest = content.data() + start;
+        size_t remaining = content.size() - start;
+        size_t fit = byteOffsetForWidth(rest, remaining, maxWidth);
+        if (fit == remaining) {
+            lines.emplace_back(content, start);
             break;
         }
 
         // Find best break point
-        size_t breakPoint = maxWidth;
-        while (breakPoint > 0 && remaining[breakPoint] != ' ' && remaining[breakPoint] != '\n') {
+        size_t breakPoint = fit;
+        while (breakPoint > 0 && rest[breakPoint] != ' ' && rest[breakPoint] != '\n') {
             breakPoint--;
         }
 
         if (breakPoint == 0) {
-            breakPoint = maxWidth; // Force break if no space found
+            // Force break if no space found; nothing to skip. A character
+            // wider than the whole column still goes on a line of its own.
+            size_t take = fit > 0 ? fit : byteOffsetForWidth(rest, remaining, 2);
+            lines.emplace_back(content, start, take);
+            start += take;
+        } else {
+            lines.emplace_back(content, start, breakPoint);
+            start += breakPoint + 1;
         }
-
-        lines.push_back(remaining.substr(0, breakPoint));
-        remaining = remaining.substr(breakPoint + 1);
     }
 
     return lines;
 }
 
 int TableCell::getDisplayWidth() const {
-    if (format.multiByteSupport) {
-        // Simple approximation for multi-byte character width
-        int width = 0;
-        for (char c : content) {
-            if ((c & 0x80) == 0) width += 1;      // ASCII
-            else if ((c & 0xE0) == 0xC0) width += 1; // 2-byte UTF-8 start
-            else if ((c & 0xF0) == 0xE0) width += 2; // 3-byte UTF-8 start (CJK chars)
-            else if ((c & 0xF8) == 0xF0) width += 2; // 4-byte UTF-8 start
-        }
-        return width;
+    if (displayWidthCache < 0) {
+        displayWidthCache = displayWidth(content);
     }
-    return static_cast<int>(content.length());
+    return displayWidthCache;
 }
 
 // TableRow implementation
@@ -115,20 +119,25 @@ ProfessionalTable::ProfessionalTable() {
 
 void ProfessionalTable::addRow(const std::vector<std::string>& data) {
     rows.emplace_back(data);
+    if (rowWidthsValid) measureRow(rows.back(), rowWidths);
 }
 
 void ProfessionalTable::addRow(const std::vector<TableCell>& cells) {
     rows.emplace_back(cells);
+    if (rowWidthsValid) measureRow(rows.back(), rowWidths);
 }
 
 void ProfessionalTable::addRow(const TableRow& row) {
     rows.push_back(row);
+    if (rowWidthsValid) measureRow(rows.back(), rowWidths);
 }
 
 TableRow& ProfessionalTable::operator[](size_t index) {
     if (index >= rows.size()) {
         rows.resize(index + 1);
     }
+    // The caller may change text or padding; remeasure on next render
+    rowWidthsValid = false;
     return rows[index];
 }
 
@@ -209,6 +218,7 @@ ProfessionalTable& ProfessionalTable::applyHinduCalendarStyle() {
     // Header formatting
     if (!rows.empty()) {
         rows[0].applyFormatToAll(CellFormat().style({FontStyle::BOLD}).align(FontAlign::CENTER).color(Color::YELLOW));
+        rowWidthsValid = false;
     }
 
     enableZebra(Color::NONE, Color::BLUE);
@@ -238,6 +248,7 @@ ProfessionalTable& ProfessionalTable::applyMyanmarCalendarStyle() {
     // Header formatting
     if (!rows.empty()) {
         rows[0].applyFormatToAll(CellFormat().style({FontStyle::BOLD}).align(FontAlign::CENTER).color(Color::YELLOW));
+        rowWidthsValid = false;
     }
 
     enableZebra(Color::NONE, Color::BLUE);
@@ -272,48 +283,78 @@ ProfessionalTable& ProfessionalTable::applyClassicStyle() {
 
 // Main output generation
 std::string ProfessionalTable::toString() const {
-    if (rows.empty()) {
-        return "";
+    std::ostringstream output;
+    write(output);
+    return output.str();
+}
+
+void ProfessionalTable::write(std::ostream& os) const {
+    stream(os, RowSource());
+}
+
+void ProfessionalTable::stream(std::ostream& os, const RowSource& source) const {
+    ASTRO_PROFILE_SCOPE("ProfessionalTable::stream");
+    // Pass 1: measure. Stored rows are already measured.
+    ColumnWidths content = measuredRowWidths();
+    size_t totalRows = rows.size();
+    if (source) {
+        TableRow row;
+        for (size_t i = 0; source(i, row); ++i, ++totalRows) {
+            measureRow(row, content);
+            row = TableRow();
+        }
     }
 
-    std::ostringstream output;
-    auto widths = calculateColumnWidths();
+    if (totalRows == 0) {
+        return;
+    }
+    std::vector<int> widths = resolveColumnWidths(content);
 
     // Add title section if present
     if (!title.empty() || !subtitle.empty()) {
-        output << formatHeaderSection();
+        os << formatHeaderSection(widths);
     }
 
     // Add table border and headers
     if (showBordersFlag) {
-        output << formatRowSeparator(widths, true);
+        os << formatRowSeparator(widths, true);
     }
 
-    // Add header row if enabled
-    if (showHeadersFlag && !rows.empty()) {
-        output << formatDataRow(rows[0], widths, 0);
-        if (showBordersFlag) {
-            output << formatRowSeparator(widths);
+    // Pass 2: emit. The header is row 0; a separator goes between every
+    // fifth data row and the next, so it is written when that next row arrives.
+    size_t startRow = showHeadersFlag ? 1 : 0;
+    bool separatorPending = false;
+    auto emit = [&](const TableRow& row, size_t index) {
+        if (separatorPending) {
+            os << formatRowSeparator(widths);
+            separatorPending = false;
         }
-    }
+        os << formatDataRow(row, widths, index);
 
-    // Add data rows
-    size_t startRow = (showHeadersFlag && !rows.empty()) ? 1 : 0;
-    for (size_t i = startRow; i < rows.size(); ++i) {
-        output << formatDataRow(rows[i], widths, i);
+        if (showHeadersFlag && index == 0) {
+            if (showBordersFlag) {
+                os << formatRowSeparator(widths);
+            }
+        } else if (showBordersFlag && (index - startRow + 1) % 5 == 0) {
+            separatorPending = true;
+        }
+    };
 
-        // Add separator every 5 rows for better readability
-        if (showBordersFlag && (i - startRow + 1) % 5 == 0 && i != rows.size() - 1) {
-            output << formatRowSeparator(widths);
+    for (size_t i = 0; i < rows.size(); ++i) {
+        emit(rows[i], i);
+    }
+    if (source) {
+        TableRow row;
+        for (size_t i = 0; source(i, row); ++i) {
+            emit(row, rows.size() + i);
+            row = TableRow();
         }
     }
 
     // Add final border
     if (showBordersFlag) {
-        output << formatRowSeparator(widths, false, true);
+        os << formatRowSeparator(widths, false, true);
     }
-
-    return output.str();
 }
 
 std::string ProfessionalTable::toMarkdown() const {
@@ -390,28 +431,26 @@ std::string ProfessionalTable::toCSV() const {
 }
 
 std::string ProfessionalTable::toJSON() const {
-    std::ostringstream output;
-    output << "{\n  \"table\": {\n";
-
+    JsonWriter json;
+    json.beginObject();
+    json.key("table").beginObject();
     if (!title.empty()) {
-        output << "    \"title\": \"" << title << "\",\n";
+        json.field("title", title);
     }
 
-    output << "    \"rows\": [\n";
-
-    for (size_t i = 0; i < rows.size(); ++i) {
-        output << "      [";
-        for (size_t j = 0; j < rows[i].size(); ++j) {
-            if (j > 0) output << ", ";
-            output << "\"" << rows[i][j].getText() << "\"";
+    json.key("rows").beginArray();
+    for (const auto& row : rows) {
+        json.beginArray();
+        for (const auto& cell : row) {
+            json.value(cell.getText());
         }
-        output << "]";
-        if (i < rows.size() - 1) output << ",";
-        output << "\n";
+        json.endArray();
     }
+    json.endArray();
 
-    output << "    ]\n  }\n}";
-    return output.str();
+    json.endObject();
+    json.endObject();
+    return json.take();
 }
 
 std::string ProfessionalTable::toHTML() const {
@@ -448,50 +487,46 @@ std::string ProfessionalTable::toHTML() const {
 
 // Private helper methods
 std::vector<int> ProfessionalTable::calculateColumnWidths() const {
-    std::vector<int> widths;
+    return resolveColumnWidths(measuredRowWidths());
+}
 
-    // Find maximum number of columns
-    size_t maxCols = 0;
-    for (const auto& row : rows) {
-        maxCols = std::max(maxCols, row.size());
+const ColumnWidths& ProfessionalTable::measuredRowWidths() const {
+    if (!rowWidthsValid) {
+        rowWidths.clear();
+        for (const auto& row : rows) {
+            measureRow(row, rowWidths);
+        }
+        rowWidthsValid = true;
     }
+    return rowWidths;
+}
 
-    widths.resize(maxCols, 0);
-
-    // Calculate based on content and formats
-    for (size_t colIdx = 0; colIdx < maxCols; ++colIdx) {
-        int maxWidth = 0;
+std::vector<int> ProfessionalTable::resolveColumnWidths(const ColumnWidths& content) const {
+    std::vector<int> widths(content.size(), 0);
 
-        // Check format width first
+    for (size_t colIdx = 0; colIdx < widths.size(); ++colIdx) {
+        // Format width first, otherwise content with a minimum column width
         if (colIdx < columnFormats.size() && columnFormats[colIdx].width > 0) {
-            maxWidth = columnFormats[colIdx].width;
+            widths[colIdx] = columnFormats[colIdx].width;
         } else {
-            // Calculate from content
-            for (const auto& row : rows) {
-                if (colIdx < row.size()) {
-                    const auto& cell = row[colIdx];
-                    int contentWidth = cell.getDisplayWidth() +
-                                     cell.getFormat().paddingLeft +
-                                     cell.getFormat().paddingRight;
-                    maxWidth = std::max(maxWidth, contentWidth);
-                }
-            }
-
-            // Apply minimum width
-            maxWidth = std::max(maxWidth, 8); // Minimum column width
+            widths[colIdx] = std::max(content[colIdx], 8);
         }
-
-        widths[colIdx] = maxWidth;
     }
 
     return widths;
 }
 
-std::string ProfessionalTable::formatHeaderSection() const {
+void ProfessionalTable::measureRow(const TableRow& row, ColumnWidths& widths) {
+    for (size_t colIdx = 0; colIdx < row.size(); ++colIdx) {
+        const auto& cell = row[colIdx];
+        widths.observe(colIdx, cell.getDisplayWidth() + cell.getFormat().paddingLeft + cell.getFormat().paddingRight);
+    }
+}
+
+std::string ProfessionalTable::formatHeaderSection(const std::vector<int>& widths) const {
     if (title.empty() && subtitle.empty()) return "";
 
     std::ostringstream output;
-    auto widths = calculateColumnWidths();
 
     // Calculate total width
     int totalWidth = 0;
@@ -559,8 +594,14 @@ std::string ProfessionalTable::formatDataRow(const TableRow& row, const std::vec
     std::ostringstream output;
     const auto& chars = getBorderChars();
 
-    // Handle multi-line cells
-    int rowHeight = row.getMaxHeight(widths);
+    // Handle multi-line cells: wrap each cell once
+    std::vector<std::vector<std::string>> cellLines(std::min(row.size(), widths.size()));
+    int rowHeight = 1;
+    for (size_t colIdx = 0; colIdx < cellLines.size(); ++colIdx) {
+        const auto& cell = row[colIdx];
+        cellLines[colIdx] = cell.getWrappedLines(widths[colIdx] - cell.getFormat().paddingLeft - cell.getFormat().paddingRight);
+        rowHeight = std::max(rowHeight, static_cast<int>(cellLines[colIdx].size()));
+    }
 
     for (int lineIdx = 0; lineIdx < rowHeight; ++lineIdx) {
         if (showBordersFlag) {
@@ -570,13 +611,8 @@ std::string ProfessionalTable::formatDataRow(const TableRow& row, const std::vec
         for (size_t colIdx = 0; colIdx < widths.size(); ++colIdx) {
             std::string cellContent;
 
-            if (colIdx < row.size()) {
-                const auto& cell = row[colIdx];
-                auto lines = cell.getWrappedLines(widths[colIdx] - cell.getFormat().paddingLeft - cell.getFormat().paddingRight);
-
-                if (lineIdx < static_cast<int>(lines.size())) {
-                    cellContent = lines[lineIdx];
-                }
+            if (colIdx < cellLines.size() && lineIdx < static_cast<int>(cellLines[colIdx].size())) {
+                cellContent = cellLines[colIdx][lineIdx];
             }
 
             // Apply column formatting if available
@@ -631,11 +667,12 @@ std::string ProfessionalTable::formatCell(const TableCell& cell, int width, bool
 }
 
 std::string ProfessionalTable::alignText(const std::string& text, int width, FontAlign alignment) const {
-    if (static_cast<int>(text.length()) >= width) {
-        return text.substr(0, width);
+    int textWidth = displayWidth(text);
+    if (textWidth >= width) {
+        return textWidth == width ? text : truncateToWidth(text, width);
     }
 
-    int padding = width - static_cast<int>(text.length());
+    int padding = width - textWidth;
 
     switch (alignment) {
         case FontAlign::RIGHT:
@@ -709,7 +746,7 @@ const ProfessionalTable::BorderChars& ProfessionalTable::getBorderChars() const
 
 // Stream operator
 std::ostream& operator<<(std::ostream& os, const ProfessionalTable& table) {
-    os << table.toString();
+    table.write(os);
     return os;
 }
 
@@ -0,0 +1,237 @@
+#include "profiler.h"
+#include "json_writer.h"
+#include <algorithm>
+#include <atomic>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Astro {
+
+struct ProfileNode {
+    const char* name;
+    const char* detail;
+    bool timed;
+    uint64_t calls;
+    uint64_t nanoseconds;
+    ProfileNode* parent;
+    std::vector<std::unique_ptr<ProfileNode>> children;
+};
+
+namespace {
+
+// Per-thread roots live here so they outlive their threads; never destroyed,
+// so a report written from an atexit handler still finds them
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ProfileNode>> roots;
+    std::atomic<unsigned> generation{0};
+};
+
+Registry& registry() {
+    static Registry* instance = new Registry();
+    return *instance;
+}
+
+struct ThreadState {
+    ProfileNode* current = nullptr;
+    unsigned generation = 0;
+};
+
+thread_local ThreadState threadState;
+
+bool sameText(const char* a, const char* b) {
+    if (a == b) return true;
+    if (!a || !b) return false;
+    return std::strcmp(a, b) == 0;
+}
+
+ProfileNode* currentNode() {
+    Registry& reg = registry();
+    if (!threadState.current || threadState.generation != reg.generation) {
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        reg.roots.push_back(std::unique_ptr<ProfileNode>(new ProfileNode{"", nullptr, false, 0, 0, nullptr, {}}));
+        threadState.current = reg.roots.back().get();
+        threadState.generation = reg.generation;
+    }
+    return threadState.current;
+}
+
+ProfileNode* findChild(ProfileNode* parent, const char* name, const char* detail, bool timed) {
+    for (auto& child : parent->children) {
+        if (child->timed == timed && sameText(child->name, name) && sameText(child->detail, detail)) {
+            return child.get();
+        }
+    }
+    parent->children.push_back(std::unique_ptr<ProfileNode>(new ProfileNode{name, detail, timed, 0, 0, parent, {}}));
+    return parent->children.back().get();
+}
+
+// Thread trees folded together by path
+struct MergedNode {
+    std::string label;
+    bool timed = false;
+    uint64_t calls = 0;
+    uint64_t nanoseconds = 0;
+    std::vector<MergedNode> children;
+
+    uint64_t childNanoseconds() const {
+        uint64_t total = 0;
+        for (const auto& child : children) {
+            if (child.timed) total += child.nanoseconds;
+        }
+        return total;
+    }
+};
+
+std::string labelOf(const ProfileNode& node) {
+    std::string label = node.name;
+    if (node.detail) {
+        label += " [";
+        label += node.detail;
+        label += "]";
+    }
+    return label;
+}
+
+void mergeInto(MergedNode& target, const ProfileNode& source) {
+    for (const auto& child : source.children) {
+        std::string label = labelOf(*child);
+        auto it = std::find_if(target.children.begin(), target.children.end(), [&](const MergedNode& m) {
+            return m.timed == child->timed && m.label == label;
+        });
+        if (it == target.children.end()) {
+            target.children.push_back(MergedNode());
+            it = target.children.end() - 1;
+            it->label = label;
+            it->timed = child->timed;
+        }
+        it->calls += child->calls;
+        it->nanoseconds += child->nanoseconds;
+        mergeInto(*it, *child);
+    }
+}
+
+void sortByTime(MergedNode& node) {
+    // Timers by total time, then counters by count
+    std::stable_sort(node.children.begin(), node.children.end(), [](const MergedNode& a, const MergedNode& b) {
+        if (a.timed != b.timed) return a.timed;
+        return a.timed ? a.nanoseconds > b.nanoseconds : a.calls > b.calls;
+    });
+    for (auto& child : node.children) {
+        sortByTime(child);
+    }
+}
+
+MergedNode mergedTree() {
+    MergedNode root;
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (const auto& threadRoot : reg.roots) {
+        mergeInto(root, *threadRoot);
+    }
+    sortByTime(root);
+    return root;
+}
+
+double milliseconds(uint64_t nanoseconds) {
+    return static_cast<double>(nanoseconds) / 1e6;
+}
+
+void writeNode(std::ostream& os, const MergedNode& node, int depth) {
+    char line[160];
+    std::string label = std::string(2 * depth, ' ') + node.label;
+    if (node.timed) {
+        std::snprintf(line, sizeof(line), "  %-56s %10llu %12.3f %12.3f\n", label.c_str(),
+                      static_cast<unsigned long long>(node.calls), milliseconds(node.nanoseconds),
+                      milliseconds(node.nanoseconds - std::min(node.nanoseconds, node.childNanoseconds())));
+    } else {
+        std::snprintf(line, sizeof(line), "  %-56s %10llu %12s %12s\n", label.c_str(),
+                      static_cast<unsigned long long>(node.calls), "-", "-");
+    }
+    os << line;
+    for (const auto& child : node.children) {
+        writeNode(os, child, depth + 1);
+    }
+}
+
+void writeNodeJSON(JsonWriter& json, const MergedNode& node) {
+    json.beginObject();
+    json.field("name", node.label);
+    json.field("calls", node.calls);
+    if (node.timed) {
+        json.field("totalMs", milliseconds(node.nanoseconds));
+        json.field("selfMs", milliseconds(node.nanoseconds - std::min(node.nanoseconds, node.childNanoseconds())));
+    }
+    if (!node.children.empty()) {
+        json.key("children").beginArray();
+        for (const auto& child : node.children) {
+            writeNodeJSON(json, child);
+        }
+        json.endArray();
+    }
+    json.endObject();
+}
+
+} // namespace
+
+bool Profiler::isCompiledIn() {
+#ifdef ASTRO_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+ProfileNode* Profiler::enter(const char* name, const char* detail) {
+    ProfileNode* node = findChild(currentNode(), name, detail, true);
+    threadState.current = node;
+    return node;
+}
+
+void Profiler::leave(ProfileNode* node, uint64_t nanoseconds) {
+    node->calls++;
+    node->nanoseconds += nanoseconds;
+    threadState.current = node->parent;
+}
+
+void Profiler::count(const char* name, uint64_t amount, const char* detail) {
+    findChild(currentNode(), name, detail, false)->calls += amount;
+}
+
+void Profiler::writeReport(std::ostream& os) {
+    MergedNode root = mergedTree();
+
+    char header[160];
+    std::snprintf(header, sizeof(header), "  %-56s %10s %12s %12s\n", "scope", "calls", "total ms", "self ms");
+    os << "\nProfile (wall clock, summed over threads):\n" << header;
+    for (const auto& child : root.children) {
+        writeNode(os, child, 0);
+    }
+}
+
+void Profiler::writeJSON(std::ostream& os) {
+    MergedNode root = mergedTree();
+
+    JsonWriter json;
+    json.beginObject();
+    json.key("profile").beginArray();
+    for (const auto& child : root.children) {
+        writeNodeJSON(json, child);
+    }
+    json.endArray();
+    json.endObject();
+    os << json.str() << "\n";
+}
+
+void Profiler::reset() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    reg.roots.clear();
+    reg.generation++;
+}
+
+} // namespace Astro
@@ -0,0 +1,387 @@
+#include "raster_image.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace Astro {
+
+namespace {
+
+// --- PNG container ---
+
+uint32_t crc32(const uint8_t* data, size_t length, uint32_t crc = 0) {
+    static const std::vector<uint32_t> table = [] {
+        std::vector<uint32_t> values(256);
+        for (uint32_t n = 0; n < 256; n++) {
+            uint32_t c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            values[n] = c;
+        }
+        return values;
+    }();
+
+    crc = ~crc;
+    for (size_t i = 0; i < length; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+uint32_t adler32(const std::vector<uint8_t>& data) {
+    uint32_t a = 1, b = 0;
+    size_t i = 0;
+    while (i < data.size()) {
+        size_t end = std::min(data.size(), i + 5552);   // largest block without overflow
+        for (; i < end; i++) {
+            a += data[i];
+            b += a;
+        }
+        a %= 65521;
+        b %= 65521;
+    }
+    return (b << 16) | a;
+}
+
+void appendBigEndian(std::string& out, uint32_t value) {
+    out += static_cast<char>(value >> 24);
+    out += static_cast<char>(value >> 16);
+    out += static_cast<char>(value >> 8);
+    out += static_cast<char>(value);
+}
+
+void appendChunk(std::string& out, const char type[4], const std::string& data) {
+    appendBigEndian(out, static_cast<uint32_t>(data.size()));
+    size_t start = out.size();
+    out.append(type, 4);
+    out += data;
+    appendBigEndian(out, crc32(reinterpret_cast<const uint8_t*>(out.data() + start), data.size() + 4));
+}
+
+// --- Deflate with the fixed Huffman code (RFC 1951, 3.2.6) ---
+
+const int LENGTH_BASE[] = {3, 4, 5, 6, 7, 8, 9, 10, 11, 13, 15, 17, 19, 23, 27, 31,
+                           35, 43, 51, 59, 67, 83, 99, 115, 131, 163, 195, 227, 258};
+const int LENGTH_EXTRA[] = {0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2,
+                            3, 3, 3, 3, 4, 4, 4, 4, 5, 5, 5, 5, 0};
+const int DISTANCE_BASE[] = {1, 2, 3, 4, 5, 7, 9, 13, 17, 25, 33, 49, 65, 97, 129, 193,
+                             257, 385, 513, 769, 1025, 1537, 2049, 3073, 4097, 6145,
+                             8193, 12289, 16385, 24577};
+const int DISTANCE_EXTRA[] = {0, 0, 0, 0, 1, 1, 2, 2, 3, 3, 4, 4, 5, 5, 6, 6,
+                              7, 7, 8, 8, 9, 9, 10, 10, 11, 11, 12, 12, 13, 13};
+
+const int MIN_MATCH = 3;
+const int MAX_MATCH = 258;
+const int WINDOW = 32768;
+const int HASH_BITS = 12;
+
+class BitWriter {
+public:
+    explicit BitWriter(std::string& out) : out(out), buffer(0), count(0) {}
+
+    void bits(uint32_t value, int length) {
+        buffer |= static_cast<uint64_t>(value) << count;
+        count += length;
+        while (count >= 8) {
+            out += static_cast<char>(buffer & 0xFF);
+            buffer >>= 8;
+            count -= 8;
+        }
+    }
+
+    void flush() {
+        if (count > 0) bits(0, 8 - count);
+    }
+
+private:
+    std::string& out;
+    uint64_t buffer;
+    int count;
+};
+
+// Fixed Huffman code of a symbol, bit-reversed since Huffman codes are sent
+// most significant bit first
+struct Code {
+    uint16_t bits;
+    uint8_t length;
+};
+
+Code reversedCode(uint32_t value, int length) {
+    uint32_t reversed = 0;
+    for (int i = 0; i < length; i++) {
+        reversed = (reversed << 1) | ((value >> i) & 1);
+    }
+    return Code{static_cast<uint16_t>(reversed), static_cast<uint8_t>(length)};
+}
+
+const std::vector<Code>& literalCodes() {
+    static const std::vector<Code> codes = [] {
+        std::vector<Code> table(288);
+        for (int symbol = 0; symbol < 288; symbol++) {
+            if (symbol < 144) table[symbol] = reversedCode(0x30 + symbol, 8);
+            else if (symbol < 256) table[symbol] = reversedCode(0x190 + symbol - 144, 9);
+            else if (symbol < 280) table[symbol] = reversedCode(symbol - 256, 7);
+            else table[symbol] = reversedCode(0xC0 + symbol - 280, 8);
+        }
+        return table;
+    }();
+    return codes;
+}
+
+void literalOrLength(BitWriter& writer, const std::vector<Code>& codes, int symbol) {
+    writer.bits(codes[symbol].bits, codes[symbol].length);
+}
+
+// Length and distance symbols, looked up rather than searched per match
+struct MatchCodes {
+    uint8_t lengthSymbol[MAX_MATCH + 1];
+    Code distanceCodes[30];
+};
+
+const MatchCodes& matchCodes() {
+    static const MatchCodes codes = [] {
+        MatchCodes table{};
+        for (int l = 0, length = MIN_MATCH; length <= MAX_MATCH; length++) {
+            while (l < 28 && LENGTH_BASE[l + 1] <= length) l++;
+            table.lengthSymbol[length] = static_cast<uint8_t>(l);
+        }
+        for (int d = 0; d < 30; d++) {
+            table.distanceCodes[d] = reversedCode(d, 5);
+        }
+        return table;
+    }();
+    return codes;
+}
+
+int distanceSymbol(int distance) {
+    if (distance <= 4) return distance - 1;
+    int bits = 0;
+    for (int value = distance - 1; value > 1; value >>= 1) bits++;
+    return 2 * bits + (((distance - 1) >> (bits - 1)) & 1);
+}
+
+void match(BitWriter& writer, const std::vector<Code>& codes, int length, int distance) {
+    const MatchCodes& table = matchCodes();
+    int l = table.lengthSymbol[length];
+    literalOrLength(writer, codes, 257 + l);
+    writer.bits(length - LENGTH_BASE[l], LENGTH_EXTRA[l]);
+
+    int d = distanceSymbol(distance);
+    writer.bits(table.distanceCodes[d].bits, table.distanceCodes[d].length);
+    writer.bits(distance - DISTANCE_BASE[d], DISTANCE_EXTRA[d]);
+}
+
+// Greedy LZ77 over one fixed-Huffman block. Filtered chart scanlines are
+// mostly zero runs and repeats of the row above, which the run (distance 1),
+// previous-row and last-occurrence candidates catch without a hash chain.
+void deflate(const std::vector<uint8_t>& data, int stride, std::string& out) {
+    const std::vector<Code>& codes = literalCodes();
+    BitWriter writer(out);
+    writer.bits(1, 1);   // final block
+    writer.bits(1, 2);   // fixed Huffman codes
+
+    // Scratch space is kept per thread: fresh pages cost more than the encoding
+    thread_local std::vector<int> head;
+    head.assign(1 << HASH_BITS, -1);
+    const int size = static_cast<int>(data.size());
+    auto hashAt = [&](int i) {
+        uint32_t value = (data[i] << 16) | (data[i + 1] << 8) | data[i + 2];
+        return static_cast<int>((value * 2654435761u) >> (32 - HASH_BITS));
+    };
+    auto matchLength = [&](int i, int candidate) {
+        int limit = std::min(MAX_MATCH, size - i);
+        int length = 0;
+        while (length + 8 <= limit) {
+            uint64_t a, b;
+            std::memcpy(&a, &data[candidate + length], 8);
+            std::memcpy(&b, &data[i + length], 8);
+            if (a != b) break;
+            length += 8;
+        }
+        while (length < limit && data[candidate + length] == data[i + length]) length++;
+        return length;
+    };
+    auto consider = [&](int i, int candidate, int& bestLength, int& bestDistance) {
+        if (candidate < 0 || i - candidate > WINDOW || bestLength >= MAX_MATCH) return;
+        int length = matchLength(i, candidate);
+        if (length > bestLength) {
+            bestLength = length;
+            bestDistance = i - candidate;
+        }
+    };
+
+    int i = 0;
+    while (i < size) {
+        int bestLength = 0;
+        int bestDistance = 0;
+        if (i + MIN_MATCH <= size) {
+            int h = hashAt(i);
+            int candidate = head[h];
+            head[h] = i;
+            consider(i, i - 1, bestLength, bestDistance);
+            consider(i, i - stride, bestLength, bestDistance);
+            consider(i, candidate, bestLength, bestDistance);
+        }
+
+        if (bestLength >= MIN_MATCH) {
+            match(writer, codes, bestLength, bestDistance);
+            i += bestLength;
+        } else {
+            literalOrLength(writer, codes, data[i]);
+            i++;
+        }
+    }
+
+    literalOrLength(writer, codes, 256);   // end of block
+    writer.flush();
+}
+
+// std::hypot guards against overflow that pixel distances never reach, at
+// several times the cost of a square root
+inline double distanceOf(double dx, double dy) {
+    return std::sqrt(dx * dx + dy * dy);
+}
+
+} // namespace
+
+RasterImage::RasterImage() : width(0), height(0) {
+}
+
+RasterImage::RasterImage(int width, int height, uint8_t background)
+    : width(width), height(height), pixels(static_cast<size_t>(width) * height, background) {
+}
+
+void RasterImage::blend(int x, int y, double coverage, uint8_t gray) {
+    if (coverage <= 0.0) return;
+    if (coverage > 1.0) coverage = 1.0;
+    uint8_t& target = pixels[static_cast<size_t>(y) * width + x];
+    uint8_t value = static_cast<uint8_t>(std::lround(255.0 - coverage * (255.0 - gray)));
+    if (value < target) target = value;
+}
+
+void RasterImage::strokeLine(double x0, double y0, double x1, double y1, double strokeWidth, uint8_t gray) {
+    const double halfWidth = strokeWidth / 2.0;
+    const double reach = halfWidth + 0.5;
+    const double dx = x1 - x0;
+    const double dy = y1 - y0;
+    const double lengthSquared = dx * dx + dy * dy;
+    const double length = std::sqrt(lengthSquared);
+
+    int top = std::max(0, static_cast<int>(std::floor(std::min(y0, y1) - reach)));
+    int bottom = std::min(height - 1, static_cast<int>(std::ceil(std::max(y0, y1) + reach)));
+    double boxLeft = std::min(x0, x1) - reach;
+    double boxRight = std::max(x0, x1) + reach;
+
+    for (int py = top; py <= bottom; py++) {
+        double yc = py + 0.5;
+
+        // Only the pixels within reach of the line through the segment
+        double left = boxLeft, right = boxRight;
+        if (std::fabs(dy) > 1e-9) {
+            double across = x0 + (yc - y0) * dx / dy;
+            double half = reach * length / std::fabs(dy);
+            left = std::max(left, across - half);
+            right = std::min(right, across + half);
+        }
+        int first = std::max(0, static_cast<int>(std::floor(left)));
+        int last = std::min(width - 1, static_cast<int>(std::ceil(right)));
+
+        for (int px = first; px <= last; px++) {
+            double xc = px + 0.5;
+            double t = lengthSquared > 0.0 ? ((xc - x0) * dx + (yc - y0) * dy) / lengthSquared : 0.0;
+            t = std::clamp(t, 0.0, 1.0);
+            double distance = distanceOf(xc - (x0 + t * dx), yc - (y0 + t * dy));
+            blend(px, py, halfWidth + 0.5 - distance, gray);
+        }
+    }
+}
+
+void RasterImage::strokeCircle(double cx, double cy, double radius, double strokeWidth, uint8_t gray) {
+    const double halfWidth = strokeWidth / 2.0;
+    const double outer = radius + halfWidth + 0.5;
+    const double inner = std::max(0.0, radius - halfWidth - 0.5);
+
+    int top = std::max(0, static_cast<int>(std::floor(cy - outer)));
+    int bottom = std::min(height - 1, static_cast<int>(std::ceil(cy + outer)));
+
+    auto span = [&](int py, double from, double to) {
+        int first = std::max(0, static_cast<int>(std::floor(from)));
+        int last = std::min(width - 1, static_cast<int>(std::ceil(to)));
+        for (int px = first; px <= last; px++) {
+            double distance = distanceOf(px + 0.5 - cx, py + 0.5 - cy);
+            blend(px, py, halfWidth + 0.5 - std::fabs(distance - radius), gray);
+        }
+    };
+
+    // Each row crosses the ring in one span, or two around the hole
+    for (int py = top; py <= bottom; py++) {
+        double offset = std::fabs(py + 0.5 - cy);
+        if (offset > outer) continue;
+        double outerX = std::sqrt(outer * outer - offset * offset);
+        if (offset < inner) {
+            double innerX = std::sqrt(inner * inner - offset * offset);
+            span(py, cx - outerX, cx - innerX);
+            span(py, cx + innerX, cx + outerX);
+        } else {
+            span(py, cx - outerX, cx + outerX);
+        }
+    }
+}
+
+void RasterImage::fillCircle(double cx, double cy, double radius, uint8_t gray) {
+    const double outer = radius + 0.5;
+    int top = std::max(0, static_cast<int>(std::floor(cy - outer)));
+    int bottom = std::min(height - 1, static_cast<int>(std::ceil(cy + outer)));
+
+    for (int py = top; py <= bottom; py++) {
+        double offset = std::fabs(py + 0.5 - cy);
+        if (offset > outer) continue;
+        double halfSpan = std::sqrt(outer * outer - offset * offset);
+        int first = std::max(0, static_cast<int>(std::floor(cx - halfSpan)));
+        int last = std::min(width - 1, static_cast<int>(std::ceil(cx + halfSpan)));
+        for (int px = first; px <= last; px++) {
+            double distance = distanceOf(px + 0.5 - cx, py + 0.5 - cy);
+            blend(px, py, radius + 0.5 - distance, gray);
+        }
+    }
+}
+
+void RasterImage::encodePng(std::string& out) const {
+    static const char SIGNATURE[] = "\x89PNG\r\n\x1a\n";
+    out.append(SIGNATURE, 8);
+
+    std::string header;
+    appendBigEndian(header, static_cast<uint32_t>(width));
+    appendBigEndian(header, static_cast<uint32_t>(height));
+    header += static_cast<char>(8);   // bit depth
+    header += static_cast<char>(0);   // grayscale
+    header += std::string(3, '\0');   // deflate, adaptive filtering, no interlace
+    appendChunk(out, "IHDR", header);
+
+    // Every scanline uses the Sub filter: flat areas become zero runs
+    const size_t stride = static_cast<size_t>(width) + 1;
+    thread_local std::vector<uint8_t> scanlines;
+    scanlines.resize(stride * height);
+    for (int y = 0; y < height; y++) {
+        const uint8_t* row = pixels.data() + static_cast<size_t>(y) * width;
+        uint8_t* filtered = scanlines.data() + y * stride;
+        filtered[0] = 1;
+        filtered[1] = row[0];
+        for (int x = 1; x < width; x++) {
+            filtered[x + 1] = static_cast<uint8_t>(row[x] - row[x - 1]);
+        }
+    }
+
+    std::string compressed;
+    compressed.reserve(scanlines.size() / 8);
+    compressed += static_cast<char>(0x78);   // zlib header: deflate, 32K window
+    compressed += static_cast<char>(0x01);
+    deflate(scanlines, static_cast<int>(stride), compressed);
+    appendBigEndian(compressed, adler32(scanlines));
+    appendChunk(out, "IDAT", compressed);
+
+    appendChunk(out, "IEND", std::string());
+}
+
+} // namespace Astro
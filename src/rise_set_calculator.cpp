@@ -0,0 +1,477 @@
+#include "rise_set_calculator.h"
+#include "profiler.h"
+#include "swiss_ephemeris.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+
+extern "C" {
+#include "swephexp.h"
+}
+
+namespace Astro {
+
+namespace {
+
+constexpr double DEG_TO_RAD = M_PI / 180.0;
+constexpr double RAD_TO_DEG = 180.0 / M_PI;
+
+// Same values Swiss Ephemeris uses
+constexpr double SUN_DIAMETER_M = 1392000000.0;
+constexpr double MOON_DIAMETER_M = 3475000.0;
+constexpr double AU_M = 1.49597870700e+11;
+constexpr double EARTH_RADIUS_M = 6378136.6;
+constexpr double EARTH_FLATTENING = 1.0 / 298.25642;
+constexpr double LAPSE_RATE = 0.0065;              // deg K / m, as in swe_rise_trans()
+constexpr double SOLAR_HOUR_ANGLE_RATE = 360.0;    // degrees per day
+// After a Newton step the residual is about the step times the relative error of the
+// altitude rate (< 1e-3), so a step below a minute leaves well under a second.
+constexpr double CONVERGED_DAYS = 60.0 / 86400.0;
+constexpr int MAX_CORRECTIONS = 2;
+
+// Multi-location search: geocentric samples every hour, altitude scanned every
+// half hour for up to 28 hours (the window swe_rise_trans() searches), roots
+// refined to 0.01 seconds
+constexpr double TRACK_STEP_DAYS = 1.0 / 24.0;
+constexpr double SCAN_STEP_DAYS = 1.0 / 48.0;
+constexpr double SCAN_WINDOW_DAYS = 28.0 / 24.0;
+constexpr double ROOT_TOLERANCE_DAYS = 0.01 / 86400.0;
+
+double normalizeDegrees(double deg) {
+    deg = std::fmod(deg, 360.0);
+    if (deg < 0) deg += 360.0;
+    return deg;
+}
+
+// Low-precision apparent solar position (Meeus, Astronomical Algorithms ch. 25), ~0.01 deg
+void approximateSunPosition(double jd, double& rightAscension, double& declination, double& distance) {
+    double t = (jd - 2451545.0) / 36525.0;
+    double l0 = 280.46646 + t * (36000.76983 + t * 0.0003032);
+    double m = (357.52911 + t * (35999.05029 - t * 0.0001537)) * DEG_TO_RAD;
+    double e = 0.016708634 - t * (0.000042037 + t * 0.0000001267);
+    double c = (1.914602 - t * (0.004817 + t * 0.000014)) * std::sin(m)
+             + (0.019993 - t * 0.000101) * std::sin(2.0 * m)
+             + 0.000289 * std::sin(3.0 * m);
+    double omega = (125.04 - 1934.136 * t) * DEG_TO_RAD;
+    double lambda = (l0 + c - 0.00569 - 0.00478 * std::sin(omega)) * DEG_TO_RAD;
+    double epsilon = (23.439291 - 0.0130042 * t + 0.00256 * std::cos(omega)) * DEG_TO_RAD;
+
+    rightAscension = normalizeDegrees(std::atan2(std::cos(epsilon) * std::sin(lambda), std::cos(lambda)) * RAD_TO_DEG);
+    declination = std::asin(std::sin(epsilon) * std::sin(lambda)) * RAD_TO_DEG;
+
+    double trueAnomaly = m + c * DEG_TO_RAD;
+    distance = 1.000001018 * (1.0 - e * e) / (1.0 + e * std::cos(trueAnomaly));
+}
+
+// Greenwich mean sidereal time in degrees (Meeus 12.4)
+double greenwichSiderealTime(double jd) {
+    double d = jd - 2451545.0;
+    double t = d / 36525.0;
+    return normalizeDegrees(280.46061837 + 360.98564736629 * d + t * t * (0.000387933 - t / 38710000.0));
+}
+
+double sunSemidiameter(double distanceAu) {
+    return std::asin(SUN_DIAMETER_M / 2.0 / AU_M / distanceAu) * RAD_TO_DEG;
+}
+
+// Geocentric apparent equatorial track of one body, sampled on a regular grid and
+// interpolated with cubic Hermite polynomials using the ephemeris speeds
+class GeocentricTrack {
+public:
+    bool sample(int body, double startJD, double stepDays, int count) {
+        start = startJD;
+        step = stepDays;
+        nodes.resize(count);
+        for (int i = 0; i < count; i++) {
+            double xx[6];
+            char errorString[256];
+            if (SwissEphemeris::calcUt(start + i * step, body, SEFLG_SWIEPH | SEFLG_EQUATORIAL | SEFLG_SPEED,
+                                       xx, errorString) < 0) {
+                return false;
+            }
+            // Unwrap right ascension so it is continuous across 0/360
+            if (i > 0) {
+                double previous = nodes[i - 1][0];
+                while (xx[0] - previous > 180.0) xx[0] -= 360.0;
+                while (xx[0] - previous < -180.0) xx[0] += 360.0;
+            }
+            for (int k = 0; k < 6; k++) nodes[i][k] = xx[k];
+        }
+        return count >= 2;
+    }
+
+    void position(double t, double& rightAscension, double& declination, double& distance) const {
+        int last = static_cast<int>(nodes.size()) - 2;
+        int i = static_cast<int>(std::floor((t - start) / step));
+        if (i < 0) i = 0;
+        if (i > last) i = last;
+
+        double s = (t - (start + i * step)) / step;
+        double s2 = s * s, s3 = s2 * s;
+        double h00 = 2 * s3 - 3 * s2 + 1, h10 = s3 - 2 * s2 + s;
+        double h01 = -2 * s3 + 3 * s2, h11 = s3 - s2;
+
+        const auto& a = nodes[i];
+        const auto& b = nodes[i + 1];
+        double v[3];
+        for (int k = 0; k < 3; k++) {
+            v[k] = h00 * a[k] + h10 * step * a[k + 3] + h01 * b[k] + h11 * step * b[k + 3];
+        }
+        rightAscension = v[0];
+        declination = v[1];
+        distance = v[2];
+    }
+
+private:
+    double start = 0.0;
+    double step = 1.0;
+    std::vector<std::array<double, 6>> nodes;  // ra, dec, distance and their daily speeds
+};
+
+// Observer on the reference ellipsoid, in the Earth-fixed equatorial frame
+struct Observer {
+    double longitude;
+    double sinLatitude, cosLatitude;  // geodetic latitude, defines the horizon
+    double rhoCos, rhoSin;            // geocentric position, AU
+
+    Observer(double latitude, double lon) : longitude(lon) {
+        double phi = latitude * DEG_TO_RAD;
+        double u = std::atan((1.0 - EARTH_FLATTENING) * std::tan(phi));
+        sinLatitude = std::sin(phi);
+        cosLatitude = std::cos(phi);
+        rhoCos = std::cos(u) * EARTH_RADIUS_M / AU_M;
+        rhoSin = (1.0 - EARTH_FLATTENING) * std::sin(u) * EARTH_RADIUS_M / AU_M;
+    }
+};
+
+// Height of the body's upper limb above the refracted horizon, in degrees
+double upperLimbAltitude(const GeocentricTrack& track, const Observer& observer, double t,
+                         double siderealOffset, double diameter, double horizonRefraction) {
+    double ra, dec, dist;
+    track.position(t, ra, dec, dist);
+
+    double lst = (greenwichSiderealTime(t) + siderealOffset + observer.longitude) * DEG_TO_RAD;
+    double cosLst = std::cos(lst), sinLst = std::sin(lst);
+
+    // Topocentric vector: geocentric body minus observer
+    double cosDec = std::cos(dec * DEG_TO_RAD);
+    double x = dist * cosDec * std::cos(ra * DEG_TO_RAD) - observer.rhoCos * cosLst;
+    double y = dist * cosDec * std::sin(ra * DEG_TO_RAD) - observer.rhoCos * sinLst;
+    double z = dist * std::sin(dec * DEG_TO_RAD) - observer.rhoSin;
+    double d = std::sqrt(x * x + y * y + z * z);
+
+    // sin(h) = sin(lat) sin(dec') + cos(lat) cos(dec') cos(H'), with cos(dec') cos(H') = (x cos LST + y sin LST) / d
+    double sinAltitude = observer.sinLatitude * z / d + observer.cosLatitude * (x * cosLst + y * sinLst) / d;
+    double semidiameter = std::asin(diameter / 2.0 / AU_M / d) * RAD_TO_DEG;
+    return std::asin(sinAltitude) * RAD_TO_DEG + semidiameter + horizonRefraction;
+}
+
+// First rise (upward crossing) or set after jdStart; 0.0 if none within the scan window
+template <typename AltitudeFunction>
+double findHorizonCrossing(AltitudeFunction altitude, double jdStart, bool rising) {
+    double t0 = jdStart;
+    double f0 = altitude(t0);
+    for (double t1 = jdStart + SCAN_STEP_DAYS; t1 <= jdStart + SCAN_WINDOW_DAYS + 1e-9; t1 += SCAN_STEP_DAYS) {
+        double f1 = altitude(t1);
+        bool crossed = rising ? (f0 < 0.0 && f1 >= 0.0) : (f0 > 0.0 && f1 <= 0.0);
+        if (crossed) {
+            // Illinois variant of regula falsi
+            double a = t0, fa = f0, b = t1, fb = f1;
+            int side = 0;
+            double c = b;
+            for (int i = 0; i < 50 && b - a > ROOT_TOLERANCE_DAYS; i++) {
+                c = (a * fb - b * fa) / (fb - fa);
+                double fc = altitude(c);
+                if (fc == 0.0) break;
+                if ((fc < 0.0) == (fa < 0.0)) {
+                    a = c;
+                    fa = fc;
+                    if (side == -1) fb /= 2.0;
+                    side = -1;
+                } else {
+                    b = c;
+                    fb = fc;
+                    if (side == 1) fa /= 2.0;
+                    side = 1;
+                }
+            }
+            return c;
+        }
+        t0 = t1;
+        f0 = f1;
+    }
+    return 0.0;
+}
+
+} // namespace
+
+size_t RiseSetCalculator::CacheKeyHash::operator()(const CacheKey& key) const {
+    size_t h = std::hash<int64_t>()(key.latitude);
+    h ^= std::hash<int64_t>()(key.longitude) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    h ^= std::hash<int64_t>()(key.start) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2);
+    return h;
+}
+
+RiseSetCalculator::RiseSetCalculator() : horizonRefraction(0.0) {
+    setAtmosphere(1013.25, 10.0);
+}
+
+void RiseSetCalculator::setAtmosphere(double pressure, double temperature) {
+    atmosphericPressure = pressure;
+    atmosphericTemperature = temperature;
+
+    // True altitude of an object that appears on the horizon, as computed by swe_rise_trans()
+    double dret[20];
+    swe_refrac_extended(0.000001, 0, pressure, temperature, LAPSE_RATE, SE_APP_TO_TRUE, dret);
+    horizonRefraction = dret[1] - dret[0];
+
+    clearCache();
+}
+
+void RiseSetCalculator::clearCache() {
+    cache.clear();
+}
+
+RiseSetCalculator::CacheKey RiseSetCalculator::makeKey(double jdStart, double latitude, double longitude) {
+    CacheKey key;
+    key.latitude = static_cast<int64_t>(std::llround(latitude * 1e6));
+    key.longitude = static_cast<int64_t>(std::llround(longitude * 1e6));
+    key.start = static_cast<int64_t>(std::llround(jdStart * 86400.0));
+    return key;
+}
+
+void RiseSetCalculator::storeInCache(const CacheKey& key, const RiseSetTimes& times) const {
+    if (cache.size() >= MAX_CACHE_ENTRIES) {
+        cache.clear();
+    }
+    cache[key] = times;
+}
+
+bool RiseSetCalculator::estimateSunEvent(double jdStart, double latitude, double longitude,
+                                         bool rising, double& eventJD) const {
+    double ra, dec, dist;
+    approximateSunPosition(jdStart, ra, dec, dist);
+
+    double h0 = -(sunSemidiameter(dist) + horizonRefraction);
+    double phi = latitude * DEG_TO_RAD;
+
+    // Hour angle of the event from the semi-diurnal arc
+    auto semiDiurnalArc = [&](double declination, double& arc) {
+        double delta = declination * DEG_TO_RAD;
+        double cosH0 = (std::sin(h0 * DEG_TO_RAD) - std::sin(phi) * std::sin(delta)) /
+                       (std::cos(phi) * std::cos(delta));
+        if (cosH0 <= -1.0 || cosH0 >= 1.0) return false;
+        arc = std::acos(cosH0) * RAD_TO_DEG;
+        return true;
+    };
+
+    double arc;
+    if (!semiDiurnalArc(dec, arc)) return false;
+
+    // Meridian distance the sky has to turn through until the event
+    double lst = normalizeDegrees(greenwichSiderealTime(jdStart) + longitude);
+    double target = rising ? arc : -arc;
+    double turn = normalizeDegrees(normalizeDegrees(ra - lst) - target);
+    if (turn > 358.0) turn -= 360.0;  // avoid skipping to the next day's event
+    double t = jdStart + turn / SOLAR_HOUR_ANGLE_RATE;
+
+    // One more analytic pass at the estimated time absorbs the Sun's daily motion
+    approximateSunPosition(t, ra, dec, dist);
+    if (!semiDiurnalArc(dec, arc)) return false;
+    lst = normalizeDegrees(greenwichSiderealTime(t) + longitude);
+    target = rising ? arc : -arc;
+    double offset = normalizeDegrees(normalizeDegrees(ra - lst) - target);
+    if (offset > 180.0) offset -= 360.0;
+    eventJD = t + offset / SOLAR_HOUR_ANGLE_RATE;
+    return true;
+}
+
+bool RiseSetCalculator::refineSunEvent(double latitude, double longitude, double& eventJD) const {
+    double geopos[3] = {longitude, latitude, 0.0};
+    SwissEphemeris::setTopocentric(longitude, latitude, 0.0);
+
+    double cosLat = std::cos(latitude * DEG_TO_RAD);
+    double t = eventJD;
+    for (int i = 0; i < MAX_CORRECTIONS; i++) {
+        double xx[6], xaz[6];
+        char errorString[256];
+        if (SwissEphemeris::calcUt(t, SE_SUN, SEFLG_SWIEPH | SEFLG_EQUATORIAL | SEFLG_TOPOCTR, xx, errorString) < 0) {
+            return false;
+        }
+        swe_azalt(t, SE_EQU2HOR, geopos, atmosphericPressure, atmosphericTemperature, xx, xaz);
+
+        // Altitude of the upper limb above the refracted horizon, and its rate of change.
+        // Azimuth is measured from south towards west, so dh/dt = -cos(lat) sin(A) dH/dt.
+        double altitudeError = xaz[1] + sunSemidiameter(xx[2]) + horizonRefraction;
+        double altitudeRate = -cosLat * std::sin(xaz[0] * DEG_TO_RAD) * SOLAR_HOUR_ANGLE_RATE;
+        if (std::fabs(altitudeRate) < 1e-3) return false;
+
+        double dt = altitudeError / altitudeRate;
+        if (std::fabs(dt) > 0.1) return false;
+        t -= dt;
+        if (std::fabs(dt) < CONVERGED_DAYS) break;
+    }
+
+    eventJD = t;
+    return true;
+}
+
+bool RiseSetCalculator::sweRiseTrans(double jdStart, int body, double latitude, double longitude,
+                                     bool rising, double& eventJD) const {
+    char errorString[256];
+    double geopos[3] = {longitude, latitude, 0.0};
+    double riseSet[10];
+
+    int result = SwissEphemeris::riseTrans(jdStart, body, nullptr, SEFLG_SWIEPH,
+                                           rising ? SE_CALC_RISE : SE_CALC_SET, geopos,
+                                           atmosphericPressure, atmosphericTemperature, riseSet, errorString);
+    if (result < 0) {
+        return false;
+    }
+    eventJD = riseSet[0];
+    return true;
+}
+
+bool RiseSetCalculator::findSunEvent(double jdStart, double latitude, double longitude,
+                                     bool rising, double& eventJD) const {
+    if (std::fabs(latitude) <= FAST_LATITUDE_LIMIT) {
+        double t = 0.0;
+        bool found = estimateSunEvent(jdStart, latitude, longitude, rising, t) &&
+                     refineSunEvent(latitude, longitude, t);
+
+        // Event already passed: search on from half a day later, as swe_rise_trans() does
+        if (found && t < jdStart) {
+            found = estimateSunEvent(jdStart + 0.5, latitude, longitude, rising, t) &&
+                    refineSunEvent(latitude, longitude, t);
+        }
+        if (found && t >= jdStart) {
+            eventJD = t;
+            return true;
+        }
+    }
+    return sweRiseTrans(jdStart, SE_SUN, latitude, longitude, rising, eventJD);
+}
+
+RiseSetTimes RiseSetCalculator::calculate(double jdStart, double latitude, double longitude) const {
+    ASTRO_PROFILE_SCOPE("RiseSetCalculator::calculate");
+    CacheKey key = makeKey(jdStart, latitude, longitude);
+    auto it = cache.find(key);
+    if (it != cache.end()) {
+        return it->second;
+    }
+
+    RiseSetTimes times;
+    findSunEvent(jdStart, latitude, longitude, true, times.sunrise);
+    findSunEvent(jdStart, latitude, longitude, false, times.sunset);
+    sweRiseTrans(jdStart, SE_MOON, latitude, longitude, true, times.moonrise);
+    sweRiseTrans(jdStart, SE_MOON, latitude, longitude, false, times.moonset);
+
+    storeInCache(key, times);
+    return times;
+}
+
+RiseSetTimes RiseSetCalculator::solve(double jdStart, double latitude, double longitude,
+                                      const RiseSetTimes* previousDay) const {
+    ASTRO_PROFILE_SCOPE("RiseSetCalculator::solve");
+    bool seeded = previousDay && std::fabs(latitude) <= FAST_LATITUDE_LIMIT;
+
+    // Rise/set times drift by minutes from one day to the next, so the previous
+    // solution shifted by a day is an excellent starting point for Newton.
+    auto solveSeeded = [&](double previous, bool rising, double& eventJD) {
+        if (seeded && previous > 0.0) {
+            double t = previous + 1.0;
+            if (refineSunEvent(latitude, longitude, t) && t >= jdStart && t < jdStart + 1.0) {
+                eventJD = t;
+                return;
+            }
+        }
+        findSunEvent(jdStart, latitude, longitude, rising, eventJD);
+    };
+
+    RiseSetTimes times;
+    solveSeeded(previousDay ? previousDay->sunrise : 0.0, true, times.sunrise);
+    solveSeeded(previousDay ? previousDay->sunset : 0.0, false, times.sunset);
+    sweRiseTrans(jdStart, SE_MOON, latitude, longitude, true, times.moonrise);
+    sweRiseTrans(jdStart, SE_MOON, latitude, longitude, false, times.moonset);
+    return times;
+}
+
+std::vector<RiseSetTimes> RiseSetCalculator::calculateRange(double jdStart, int days,
+                                                            double latitude, double longitude) const {
+    std::vector<RiseSetTimes> results;
+    if (days <= 0) return results;
+    results.reserve(days);
+
+    for (int i = 0; i < days; i++) {
+        double start = jdStart + i;
+        CacheKey key = makeKey(start, latitude, longitude);
+        auto it = cache.find(key);
+
+        RiseSetTimes times;
+        if (it != cache.end()) {
+            times = it->second;
+        } else {
+            times = solve(start, latitude, longitude, results.empty() ? nullptr : &results.back());
+            storeInCache(key, times);
+        }
+        results.push_back(times);
+    }
+
+    return results;
+}
+
+std::vector<RiseSetTimes> RiseSetCalculator::calculateMultiLocation(double jdStart,
+                                                                    const std::vector<double>& latitudes,
+                                                                    const std::vector<double>& longitudes) const {
+    size_t count = std::min(latitudes.size(), longitudes.size());
+    std::vector<RiseSetTimes> results(count);
+
+    // Location-independent part: geocentric tracks and apparent sidereal time
+    int nodes = static_cast<int>(std::ceil(SCAN_WINDOW_DAYS / TRACK_STEP_DAYS)) + 2;
+    GeocentricTrack sunTrack, moonTrack;
+    bool tracked = sunTrack.sample(SE_SUN, jdStart, TRACK_STEP_DAYS, nodes) &&
+                   moonTrack.sample(SE_MOON, jdStart, TRACK_STEP_DAYS, nodes);
+
+    // Equation of the equinoxes (and model offset) relative to the analytic mean sidereal time
+    double siderealOffset = swe_sidtime(jdStart) * 15.0 - greenwichSiderealTime(jdStart);
+
+    for (size_t i = 0; i < count; i++) {
+        CacheKey key = makeKey(jdStart, latitudes[i], longitudes[i]);
+        auto it = cache.find(key);
+        if (it != cache.end()) {
+            results[i] = it->second;
+            continue;
+        }
+
+        if (!tracked) {
+            results[i] = calculate(jdStart, latitudes[i], longitudes[i]);
+            continue;
+        }
+
+        Observer observer(latitudes[i], longitudes[i]);
+        auto sunAltitude = [&](double t) {
+            return upperLimbAltitude(sunTrack, observer, t, siderealOffset, SUN_DIAMETER_M, horizonRefraction);
+        };
+        auto moonAltitude = [&](double t) {
+            return upperLimbAltitude(moonTrack, observer, t, siderealOffset, MOON_DIAMETER_M, horizonRefraction);
+        };
+
+        RiseSetTimes& times = results[i];
+        times.sunrise = findHorizonCrossing(sunAltitude, jdStart, true);
+        times.sunset = findHorizonCrossing(sunAltitude, jdStart, false);
+        times.moonrise = findHorizonCrossing(moonAltitude, jdStart, true);
+        times.moonset = findHorizonCrossing(moonAltitude, jdStart, false);
+        storeInCache(key, times);
+    }
+
+    return results;
+}
+
+std::vector<RiseSetTimes> RiseSetCalculator::calculateYear(int year, double latitude, double longitude) const {
+    double jdStart = swe_julday(year, 1, 1, 0.0, SE_GREG_CAL);
+    double jdEnd = swe_julday(year + 1, 1, 1, 0.0, SE_GREG_CAL);
+    return calculateRange(jdStart, static_cast<int>(std::lround(jdEnd - jdStart)), latitude, longitude);
+}
+
+} // namespace Astro
@@ -1,11 +1,26 @@
 #include "solar_system_drawer.h"
+#include "profiler.h"
+#include "swiss_ephemeris.h"
 #include <sstream>
 #include <cmath>
 #include <algorithm>
 #include <iomanip>
 
+extern "C" {
+#include "swephexp.h"
+}
+
 namespace Astro {
 
+namespace {
+
+const int EARTH_ORBIT_RADIUS = 7;   // between Venus and Mars in ORBITAL_RADII
+
+// The frame KeplerPropagator works in, so both sources draw the same thing
+const int HELIOCENTRIC_FLAGS = SEFLG_SWIEPH | SEFLG_HELCTR | SEFLG_J2000 | SEFLG_TRUEPOS | SEFLG_NONUT | SEFLG_SPEED;
+
+} // namespace
+
 // Orbital radii for ASCII representation (not to scale, for visual clarity)
 const std::map<Planet, int> SolarSystemDrawer::ORBITAL_RADII = {
     {Planet::MERCURY, 3},
@@ -153,6 +168,72 @@ std::string SolarSystemDrawer::drawSolarSystemWithPositions(const std::vector<Pl
     return ss.str();
 }
 
+bool SolarSystemDrawer::updateHeliocentricView(OrbitState& state, double julianDayUT) {
+    ASTRO_PROFILE_SCOPE("SolarSystemDrawer::updateHeliocentricView");
+    const int width = 80;
+    const int height = 60;
+    const int centerX = width / 2;
+    const int centerY = height / 2;
+
+    int earthRadius = static_cast<int>(EARTH_ORBIT_RADIUS * scale);
+    if (state.frame.empty()) {
+        state.frame.assign(height, std::string(width, ' '));
+        if (showOrbits) {
+            for (const auto& pair : ORBITAL_RADII) {
+                int radius = static_cast<int>(pair.second * scale);
+                if (radius < height/2 && radius < width/2) {
+                    drawOrbitOnCanvas(state.frame, centerX, centerY, radius);
+                }
+            }
+            if (earthRadius < height/2 && earthRadius < width/2) {
+                drawOrbitOnCanvas(state.frame, centerX, centerY, earthRadius);
+            }
+        }
+        state.frame[centerY][centerX] = 'O';
+        state.rows = state.frame;
+    } else {
+        for (const auto& cell : state.drawnCells) {
+            state.rows[cell.second][cell.first] = state.frame[cell.second][cell.first];
+        }
+    }
+    state.drawnCells.clear();
+
+    const int bodies[] = {SE_MERCURY, SE_VENUS, SE_EARTH, SE_MARS, SE_JUPITER,
+                          SE_SATURN, SE_URANUS, SE_NEPTUNE, SE_PLUTO};
+    double julianDayET = julianDayUT + swe_deltat(julianDayUT);
+    for (int body : bodies) {
+        double xx[6];
+        char serr[AS_MAXCH];
+        int ret = propagator ? propagator->calc(julianDayET, body, xx, serr)
+                             : SwissEphemeris::calc(julianDayET, body, HELIOCENTRIC_FLAGS, xx, serr);
+        if (ret < 0) {
+            lastError = std::string("Swiss Ephemeris error: ") + serr;
+            return false;
+        }
+
+        // Same orientation as calculatePlanetPosition(): 0 degrees at the top
+        int radius = body == SE_EARTH ? earthRadius : getOrbitRadius(static_cast<Planet>(body));
+        double angleRad = (xx[0] * M_PI / 180.0) - (M_PI / 2.0);
+        int x = centerX + static_cast<int>(radius * cos(angleRad));
+        int y = centerY + static_cast<int>(radius * sin(angleRad));
+        if (x >= 0 && x < width && y >= 0 && y < height) {
+            state.rows[y][x] = body == SE_EARTH ? 'E' : getPlanetSymbol(static_cast<Planet>(body))[0];
+            state.drawnCells.push_back({x, y});
+        }
+    }
+
+    lastError.clear();
+    return true;
+}
+
+void SolarSystemDrawer::setKeplerResync(double days) {
+    if (days > 0.0) {
+        propagator.reset(new KeplerPropagator(SEFLG_SWIEPH, days));
+    } else {
+        propagator.reset();
+    }
+}
+
 std::string SolarSystemDrawer::getPlanetSymbol(Planet planet) const {
     auto it = PLANET_SYMBOLS.find(planet);
     if (it != PLANET_SYMBOLS.end()) {
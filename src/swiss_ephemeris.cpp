@@ -0,0 +1,196 @@
+#include "swiss_ephemeris.h"
+#include "profiler.h"
+#include <cstdint>
+#include <cstring>
+#include <memory>
+
+extern "C" {
+#include "swephexp.h"
+}
+
+namespace Astro {
+
+namespace {
+
+// Direct-mapped: a new position evicts whatever shared its slot. 2048 slots
+// cover the working set of a conjunction scan or a calendar month several
+// times over at under 200 KB per thread.
+const unsigned CACHE_SLOT_BITS = 11;
+const size_t CACHE_SLOTS = size_t(1) << CACHE_SLOT_BITS;
+
+struct CachedPosition {
+    double julianDay;
+    int body;
+    int flags;
+    int siderealMode;       // -1 when flags lack SEFLG_SIDEREAL
+    bool universalTime;
+    bool valid;
+    int returnFlags;
+    double result[6];
+};
+
+struct ThreadEphemeris {
+    // The library's own defaults
+    int siderealMode = SE_SIDM_FAGAN_BRADLEY;
+    double siderealReferenceJD = 0.0;
+    double siderealAyanamsa = 0.0;
+    std::unique_ptr<CachedPosition[]> slots;
+
+    void clear() {
+        if (slots) {
+            for (size_t i = 0; i < CACHE_SLOTS; i++) {
+                slots[i].valid = false;
+            }
+        }
+    }
+
+    CachedPosition& slotFor(double julianDay, int body, int flags, bool universalTime) {
+        if (!slots) {
+            slots.reset(new CachedPosition[CACHE_SLOTS]);
+            clear();
+        }
+        uint64_t bits;
+        std::memcpy(&bits, &julianDay, sizeof(bits));
+        uint64_t hash = bits ^ (static_cast<uint64_t>(static_cast<uint32_t>(body)) << 32) ^
+                        static_cast<uint32_t>(flags) ^ (universalTime ? 0x5bd1e995u : 0u);
+        hash *= 0x9E3779B97F4A7C15ull;
+        return slots[hash >> (64 - CACHE_SLOT_BITS)];
+    }
+};
+
+thread_local ThreadEphemeris threadEphemeris;
+
+int uncachedCalc(bool universalTime, double julianDay, int body, int flags, double* result, char* error) {
+    if (universalTime) {
+        ASTRO_PROFILE_SCOPE_DETAIL("swe_calc_ut", SwissEphemeris::bodyName(body));
+        return swe_calc_ut(julianDay, body, flags, result, error);
+    }
+    ASTRO_PROFILE_SCOPE_DETAIL("swe_calc", SwissEphemeris::bodyName(body));
+    return swe_calc(julianDay, body, flags, result, error);
+}
+
+int cachedCalc(bool universalTime, double julianDay, int body, int flags, double* result, char* error) {
+    // The observer is also set behind our back by swe_rise_trans and the
+    // eclipse functions, so topocentric positions are never cached
+    if (flags & SEFLG_TOPOCTR) {
+        return uncachedCalc(universalTime, julianDay, body, flags, result, error);
+    }
+
+    ThreadEphemeris& state = threadEphemeris;
+    int siderealMode = (flags & SEFLG_SIDEREAL) ? state.siderealMode : -1;
+    CachedPosition& slot = state.slotFor(julianDay, body, flags, universalTime);
+
+    if (slot.valid && slot.julianDay == julianDay && slot.body == body && slot.flags == flags &&
+        slot.siderealMode == siderealMode && slot.universalTime == universalTime) {
+        ASTRO_PROFILE_COUNT_DETAIL("ephemeris cache hit", 1, SwissEphemeris::bodyName(body));
+        std::memcpy(result, slot.result, sizeof(slot.result));
+        if (error) {
+            error[0] = '\0';
+        }
+        return slot.returnFlags;
+    }
+    ASTRO_PROFILE_COUNT_DETAIL("ephemeris cache miss", 1, SwissEphemeris::bodyName(body));
+
+    if (error) {
+        error[0] = '\0';
+    }
+    int returnFlags = uncachedCalc(universalTime, julianDay, body, flags, result, error);
+
+    // A warning (e.g. a fallback to the Moshier ephemeris) must reach every caller
+    if (returnFlags >= 0 && (!error || error[0] == '\0')) {
+        slot.julianDay = julianDay;
+        slot.body = body;
+        slot.flags = flags;
+        slot.siderealMode = siderealMode;
+        slot.universalTime = universalTime;
+        slot.returnFlags = returnFlags;
+        std::memcpy(slot.result, result, sizeof(slot.result));
+        slot.valid = true;
+    }
+    return returnFlags;
+}
+
+} // namespace
+
+int SwissEphemeris::calcUt(double julianDayUT, int body, int flags, double* result, char* error) {
+    return cachedCalc(true, julianDayUT, body, flags, result, error);
+}
+
+int SwissEphemeris::calc(double julianDayET, int body, int flags, double* result, char* error) {
+    return cachedCalc(false, julianDayET, body, flags, result, error);
+}
+
+int SwissEphemeris::riseTrans(double julianDayUT, int body, char* star, int ephemerisFlags, int riseSetFlags,
+                              double* geopos, double pressure, double temperature, double* result, char* error) {
+    ASTRO_PROFILE_SCOPE_DETAIL("swe_rise_trans", bodyName(body));
+    return swe_rise_trans(julianDayUT, body, star, ephemerisFlags, riseSetFlags,
+                          geopos, pressure, temperature, result, error);
+}
+
+int SwissEphemeris::orbitalElements(double julianDayET, int body, int flags, double* result, char* error) {
+    ASTRO_PROFILE_SCOPE_DETAIL("swe_get_orbital_elements", bodyName(body));
+    return swe_get_orbital_elements(julianDayET, body, flags, result, error);
+}
+
+void SwissEphemeris::setSiderealMode(int mode, double referenceJD, double ayanamsaAtReference) {
+    ThreadEphemeris& state = threadEphemeris;
+    swe_set_sid_mode(mode, referenceJD, ayanamsaAtReference);
+
+    // The mode is part of the key; its parameters are not
+    if (referenceJD != state.siderealReferenceJD || ayanamsaAtReference != state.siderealAyanamsa) {
+        state.clear();
+    }
+    state.siderealMode = mode;
+    state.siderealReferenceJD = referenceJD;
+    state.siderealAyanamsa = ayanamsaAtReference;
+}
+
+double SwissEphemeris::ayanamsaUt(double julianDayUT, int mode) {
+    const ThreadEphemeris& state = threadEphemeris;
+    swe_set_sid_mode(mode, 0.0, 0.0);
+    double ayanamsa = swe_get_ayanamsa_ut(julianDayUT);
+    swe_set_sid_mode(state.siderealMode, state.siderealReferenceJD, state.siderealAyanamsa);
+    return ayanamsa;
+}
+
+void SwissEphemeris::setTopocentric(double longitude, double latitude, double altitude) {
+    swe_set_topo(longitude, latitude, altitude);
+}
+
+void SwissEphemeris::setEphemerisPath(const char* path) {
+    swe_set_ephe_path(const_cast<char*>(path));
+    threadEphemeris.clear();
+}
+
+void SwissEphemeris::close() {
+    swe_close();
+    threadEphemeris.clear();
+}
+
+void SwissEphemeris::clearCache() {
+    threadEphemeris.clear();
+}
+
+const char* SwissEphemeris::bodyName(int body) {
+    switch (body) {
+        case SE_SUN: return "Sun";
+        case SE_MOON: return "Moon";
+        case SE_MERCURY: return "Mercury";
+        case SE_VENUS: return "Venus";
+        case SE_MARS: return "Mars";
+        case SE_JUPITER: return "Jupiter";
+        case SE_SATURN: return "Saturn";
+        case SE_URANUS: return "Uranus";
+        case SE_NEPTUNE: return "Neptune";
+        case SE_PLUTO: return "Pluto";
+        case SE_MEAN_NODE: return "Mean Node";
+        case SE_TRUE_NODE: return "True Node";
+        case SE_MEAN_APOG: return "Mean Apogee";
+        case SE_OSCU_APOG: return "Osculating Apogee";
+        case SE_EARTH: return "Earth";
+        case SE_CHIRON: return "Chiron";
+        default: return "other";
+    }
+}
+
+} // namespace Astro
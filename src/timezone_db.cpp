@@ -0,0 +1,10 @@
+#include "timezone_db.h"
+
+namespace Astro {
+namespace TimeZoneDB {
+
+// Tables written by tools/timezone_db_generator into the build directory
+#include "timezone_db.inc"
+
+} // namespace TimeZoneDB
+} // namespace Astro
@@ -0,0 +1,197 @@
+#include "timezone_resolver.h"
+#include "timezone_db.h"
+#include <algorithm>
+#include <cctype>
+
+namespace Astro {
+
+namespace {
+
+int64_t floorDiv(int64_t a, int64_t b) {
+    return a / b - ((a % b != 0) && ((a < 0) != (b < 0)));
+}
+
+int64_t daysFromCivil(int64_t year, int month, int day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t yearOfEra = year - era * 400;
+    const int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+int64_t yearOfDays(int64_t days) {
+    days += 719468;
+    const int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    const int64_t dayOfEra = days - era * 146097;
+    const int64_t yearOfEra = (dayOfEra - dayOfEra / 1460 + dayOfEra / 36524 - dayOfEra / 146096) / 365;
+    const int64_t dayOfYear = dayOfEra - (365 * yearOfEra + yearOfEra / 4 - yearOfEra / 100);
+    const int64_t monthIndex = (5 * dayOfYear + 2) / 153;   // March = 0
+    return yearOfEra + era * 400 + (monthIndex >= 10);
+}
+
+int weekdayOf(int64_t days) {
+    return static_cast<int>(((days % 7) + 11) % 7);   // 1970-01-01 was a Thursday
+}
+
+int daysInMonth(int64_t year, int month) {
+    static const int DAYS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : DAYS[month - 1];
+}
+
+int64_t dayOf(int64_t year, const TimeZoneDB::DayRule& rule) {
+    int64_t days;
+    switch (rule.kind) {
+        case TimeZoneDB::DAY_LAST_WEEKDAY:
+            days = daysFromCivil(year, rule.month, daysInMonth(year, rule.month));
+            while (weekdayOf(days) != rule.weekday) days--;
+            return days;
+        case TimeZoneDB::DAY_WEEKDAY_ON_OR_AFTER:
+            days = daysFromCivil(year, rule.month, rule.day);
+            while (weekdayOf(days) != rule.weekday) days++;
+            return days;
+        case TimeZoneDB::DAY_WEEKDAY_ON_OR_BEFORE:
+            days = daysFromCivil(year, rule.month, rule.day);
+            while (weekdayOf(days) != rule.weekday) days--;
+            return days;
+        default:
+            return daysFromCivil(year, rule.month, rule.day);
+    }
+}
+
+bool equalsIgnoreCase(std::string_view a, std::string_view b) {
+    return a.size() == b.size() &&
+           std::equal(a.begin(), a.end(), b.begin(), [](char x, char y) {
+               return std::tolower(static_cast<unsigned char>(x)) == std::tolower(static_cast<unsigned char>(y));
+           });
+}
+
+} // namespace
+
+TimeZoneResolver::TimeZoneResolver() {
+}
+
+int TimeZoneResolver::findZone(std::string_view name) const {
+    const TimeZoneDB::ZoneName* begin = TimeZoneDB::ZONE_NAMES;
+    const TimeZoneDB::ZoneName* end = begin + TimeZoneDB::ZONE_NAME_COUNT;
+
+    auto found = std::lower_bound(begin, end, name, [](const TimeZoneDB::ZoneName& entry, std::string_view value) {
+        return TimeZoneDB::text(entry.name) < value;
+    });
+    if (found != end && TimeZoneDB::text(found->name) == name) {
+        return static_cast<int>(found->zone);
+    }
+
+    // Names are case-sensitive in tzdata, but nobody types them that way
+    for (const TimeZoneDB::ZoneName* entry = begin; entry != end; ++entry) {
+        if (equalsIgnoreCase(TimeZoneDB::text(entry->name), name)) {
+            return static_cast<int>(entry->zone);
+        }
+    }
+    return -1;
+}
+
+std::string TimeZoneResolver::zoneName(int zone) const {
+    if (zone < 0 || static_cast<size_t>(zone) >= TimeZoneDB::ZONE_COUNT) {
+        return "";
+    }
+    return std::string(TimeZoneDB::text(TimeZoneDB::ZONES[zone].name));
+}
+
+ZoneOffset TimeZoneResolver::offsetAtUTC(int zone, int64_t utcSeconds) const {
+    if (zone < 0 || static_cast<size_t>(zone) >= TimeZoneDB::ZONE_COUNT) {
+        return ZoneOffset{};
+    }
+
+    const TimeZoneDB::Zone& entry = TimeZoneDB::ZONES[zone];
+    const int64_t* first = TimeZoneDB::TRANSITION_UTC + entry.firstTransition;
+    const int64_t* last = first + entry.transitionCount;
+
+    if (entry.finalRules >= 0 && (first == last || utcSeconds > last[-1])) {
+        return finalRuleOffset(zone, utcSeconds, false);
+    }
+
+    const int64_t* next = std::upper_bound(first, last, utcSeconds);
+    if (next == first) {
+        return ZoneOffset{entry.initialOffset, entry.initialDST != 0};
+    }
+    const TimeZoneDB::Offset& offset = TimeZoneDB::TRANSITION_OFFSETS[next - 1 - TimeZoneDB::TRANSITION_UTC];
+    return ZoneOffset{offset.utcOffset, offset.dst != 0};
+}
+
+ZoneOffset TimeZoneResolver::offsetAtLocalTime(int zone, int64_t localSeconds) const {
+    if (zone < 0 || static_cast<size_t>(zone) >= TimeZoneDB::ZONE_COUNT) {
+        return ZoneOffset{};
+    }
+
+    const TimeZoneDB::Zone& entry = TimeZoneDB::ZONES[zone];
+    const int64_t* first = TimeZoneDB::TRANSITION_LOCAL + entry.firstTransition;
+    const int64_t* last = first + entry.transitionCount;
+
+    if (entry.finalRules >= 0 && (first == last || localSeconds > last[-1])) {
+        return finalRuleOffset(zone, localSeconds, true);
+    }
+
+    const int64_t* next = std::upper_bound(first, last, localSeconds);
+    if (next == first) {
+        return ZoneOffset{entry.initialOffset, entry.initialDST != 0};
+    }
+    const TimeZoneDB::Offset& offset = TimeZoneDB::TRANSITION_OFFSETS[next - 1 - TimeZoneDB::TRANSITION_LOCAL];
+    return ZoneOffset{offset.utcOffset, offset.dst != 0};
+}
+
+ZoneOffset TimeZoneResolver::finalRuleOffset(int zone, int64_t seconds, bool local) const {
+    const TimeZoneDB::Zone& entry = TimeZoneDB::ZONES[zone];
+    const TimeZoneDB::FinalRules& rules = TimeZoneDB::FINAL_RULES[entry.finalRules];
+
+    // Latest change of this year or the last that is not after the given time;
+    // each rule's wall clock time is read with the other rule's save in effect
+    ZoneOffset result;
+    int64_t latest = INT64_MIN;
+    int64_t year = yearOfDays(floorDiv(seconds, 86400));
+
+    for (int64_t y = year - 1; y <= year; y++) {
+        for (int r = 0; r < 2; r++) {
+            const TimeZoneDB::YearlyRule& rule = rules.rules[r];
+            const TimeZoneDB::YearlyRule& other = rules.rules[1 - r];
+
+            int64_t utc = dayOf(y, rule.date) * 86400 + rule.at;
+            if (rule.atKind != TimeZoneDB::TIME_UNIVERSAL) utc -= rules.standardOffset;
+            if (rule.atKind == TimeZoneDB::TIME_WALL) utc -= other.save;
+
+            int before = rules.standardOffset + other.save;
+            int after = rules.standardOffset + rule.save;
+            int64_t start = local ? utc + std::max(before, after) : utc;
+
+            if (start <= seconds && start > latest) {
+                latest = start;
+                result = ZoneOffset{after, rule.dst != 0};
+            }
+        }
+    }
+    return result;
+}
+
+bool TimeZoneResolver::resolve(std::string_view name, BirthData& birthData) const {
+    int zone = findZone(name);
+    if (zone < 0) {
+        lastError = "Unknown time zone \"" + std::string(name) + "\"";
+        return false;
+    }
+
+    int64_t local = toSeconds(birthData.year, birthData.month, birthData.day,
+                              birthData.hour, birthData.minute, birthData.second);
+    birthData.timezone = offsetAtLocalTime(zone, local).hours();
+    return true;
+}
+
+int64_t TimeZoneResolver::toSeconds(int year, int month, int day, int hour, int minute, int second) {
+    return daysFromCivil(year, month, day) * 86400 + hour * 3600 + minute * 60 + second;
+}
+
+std::string TimeZoneResolver::dataVersion() {
+    return TimeZoneDB::VERSION;
+}
+
+} // namespace Astro
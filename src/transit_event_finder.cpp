@@ -0,0 +1,317 @@
+#include "transit_event_finder.h"
+#include "profiler.h"
+#include "swiss_ephemeris.h"
+#include <algorithm>
+#include <cmath>
+
+extern "C" {
+#include "swephexp.h"
+}
+
+namespace Astro {
+
+namespace {
+
+const double NAKSHATRA_SIZE = 360.0 / 27.0;
+
+int sweBody(Planet planet) {
+    switch (planet) {
+        case Planet::NORTH_NODE: return SE_TRUE_NODE;
+        case Planet::CHIRON: return SE_CHIRON;
+        case Planet::LILITH: return SE_MEAN_APOG;
+        default: return static_cast<int>(planet);
+    }
+}
+
+int boundaryIndex(double boundary, double size) {
+    int count = static_cast<int>(std::lround(360.0 / size));
+    int index = static_cast<int>(std::lround(boundary / size)) % count;
+    return index < 0 ? index + count : index;
+}
+
+} // namespace
+
+TransitEventFinder::TransitEventFinder()
+    : zodiacMode(ZodiacMode::TROPICAL), ayanamsa(AyanamsaType::LAHIRI),
+      planets({Planet::SUN, Planet::MERCURY, Planet::VENUS, Planet::MARS, Planet::JUPITER,
+               Planet::SATURN, Planet::URANUS, Planet::NEPTUNE, Planet::PLUTO}),
+      includeSigns(true), includeNakshatras(false), includeStations(true) {
+}
+
+void TransitEventFinder::setZodiacMode(ZodiacMode mode, AyanamsaType type) {
+    zodiacMode = mode;
+    ayanamsa = type;
+    yearCache.clear();
+}
+
+void TransitEventFinder::setPlanets(const std::vector<Planet>& planetList) {
+    planets = planetList;
+    yearCache.clear();
+}
+
+void TransitEventFinder::setIncludeSignIngresses(bool include) {
+    includeSigns = include;
+    yearCache.clear();
+}
+
+void TransitEventFinder::setIncludeNakshatraIngresses(bool include) {
+    includeNakshatras = include;
+    yearCache.clear();
+}
+
+void TransitEventFinder::setIncludeStations(bool include) {
+    includeStations = include;
+    yearCache.clear();
+}
+
+bool TransitEventFinder::findEvents(double startJD, double endJD, std::vector<TransitEvent>& events) const {
+    ASTRO_PROFILE_SCOPE("TransitEventFinder::findEvents");
+    events.clear();
+    if (endJD <= startJD) {
+        lastError = "Empty event range";
+        return false;
+    }
+    lastError.clear();
+
+    if (zodiacMode == ZodiacMode::SIDEREAL) {
+        SwissEphemeris::setSiderealMode(ayanamsaTypeToSwissEphId(ayanamsa));
+    }
+
+    for (Planet planet : planets) {
+        if (!findPlanetEvents(planet, startJD, endJD, events)) {
+            events.clear();
+            return false;
+        }
+    }
+
+    std::stable_sort(events.begin(), events.end(), [](const TransitEvent& a, const TransitEvent& b) {
+        return a.julianDay < b.julianDay;
+    });
+    return true;
+}
+
+bool TransitEventFinder::getEvents(double startJD, double endJD, std::vector<TransitEvent>& events) const {
+    events.clear();
+    if (endJD <= startJD) {
+        lastError = "Empty event range";
+        return false;
+    }
+
+    int firstYear, lastYear, month, day;
+    double hour;
+    swe_revjul(startJD, SE_GREG_CAL, &firstYear, &month, &day, &hour);
+    swe_revjul(endJD - 1e-6, SE_GREG_CAL, &lastYear, &month, &day, &hour);   // end is exclusive
+
+    for (int year = firstYear; year <= lastYear; year++) {
+        const std::vector<TransitEvent>& yearEvents = getYearEvents(year);
+        if (yearEvents.empty() && !lastError.empty()) {
+            events.clear();
+            return false;
+        }
+
+        auto first = std::lower_bound(yearEvents.begin(), yearEvents.end(), startJD,
+                                      [](const TransitEvent& e, double jd) { return e.julianDay < jd; });
+        auto last = std::lower_bound(first, yearEvents.end(), endJD,
+                                     [](const TransitEvent& e, double jd) { return e.julianDay < jd; });
+        events.insert(events.end(), first, last);
+    }
+    return true;
+}
+
+const std::vector<TransitEvent>& TransitEventFinder::getYearEvents(int year) const {
+    auto it = yearCache.find(year);
+    if (it != yearCache.end()) {
+        return it->second;
+    }
+
+    std::vector<TransitEvent> events;
+    findEvents(swe_julday(year, 1, 1, 0.0, SE_GREG_CAL), swe_julday(year + 1, 1, 1, 0.0, SE_GREG_CAL), events);
+    return yearCache[year] = std::move(events);
+}
+
+std::string TransitEventFinder::getEventTypeName(TransitEventType type) {
+    switch (type) {
+        case TransitEventType::SIGN_INGRESS: return "Sign Ingress";
+        case TransitEventType::NAKSHATRA_INGRESS: return "Nakshatra Ingress";
+        case TransitEventType::STATION_RETROGRADE: return "Stationary Retrograde";
+        case TransitEventType::STATION_DIRECT: return "Stationary Direct";
+    }
+    return "Unknown";
+}
+
+int TransitEventFinder::calculationFlags() const {
+    int flags = SEFLG_SWIEPH | SEFLG_SPEED;
+    if (zodiacMode == ZodiacMode::SIDEREAL) {
+        flags |= SEFLG_SIDEREAL;
+    }
+    return flags;
+}
+
+bool TransitEventFinder::sample(int body, double julianDay, Sample& result) const {
+    double position[6];
+    char error[AS_MAXCH];
+    if (SwissEphemeris::calcUt(julianDay, body, calculationFlags(), position, error) < 0) {
+        lastError = "Swiss Ephemeris error: " + std::string(error);
+        return false;
+    }
+
+    result.julianDay = julianDay;
+    result.longitude = position[0];
+    result.speed = position[3];
+    return true;
+}
+
+bool TransitEventFinder::findPlanetEvents(Planet planet, double startJD, double endJD,
+                                          std::vector<TransitEvent>& events) const {
+    if (planet == Planet::SOUTH_NODE) {
+        lastError = "South Node events follow the North Node; request Planet::NORTH_NODE";
+        return false;
+    }
+
+    int body = sweBody(planet);
+    double step = planet == Planet::MOON ? 0.25 : 1.0;
+    bool stations = includeStations && planet != Planet::SUN && planet != Planet::MOON;
+
+    Sample a, b;
+    if (!sample(body, startJD, a)) {
+        return false;
+    }
+
+    while (a.julianDay < endJD) {
+        if (!sample(body, std::min(a.julianDay + step, endJD), b)) {
+            return false;
+        }
+
+        // Split the step at a station so each half moves one way only
+        std::vector<Sample> pieces = {a};
+        if (stations && (a.speed < 0.0) != (b.speed < 0.0)) {
+            Sample station;
+            if (!refineStation(body, a, b, station)) {
+                return false;
+            }
+            if (station.julianDay >= startJD && station.julianDay < endJD) {
+                int sign = static_cast<int>(station.longitude / 30.0) % 12;
+                events.push_back({b.speed < 0.0 ? TransitEventType::STATION_RETROGRADE : TransitEventType::STATION_DIRECT,
+                                  planet, station.julianDay, station.longitude, sign, sign});
+            }
+            pieces.push_back(station);
+        }
+        pieces.push_back(b);
+
+        for (size_t i = 0; i + 1 < pieces.size(); i++) {
+            if (includeSigns) {
+                findIngresses(planet, body, pieces[i], pieces[i + 1], 30.0,
+                              TransitEventType::SIGN_INGRESS, startJD, endJD, events);
+            }
+            if (includeNakshatras) {
+                findIngresses(planet, body, pieces[i], pieces[i + 1], NAKSHATRA_SIZE,
+                              TransitEventType::NAKSHATRA_INGRESS, startJD, endJD, events);
+            }
+        }
+
+        a = b;
+    }
+
+    return lastError.empty();
+}
+
+void TransitEventFinder::findIngresses(Planet planet, int body, const Sample& a, const Sample& b, double size,
+                                       TransitEventType type, double startJD, double endJD,
+                                       std::vector<TransitEvent>& events) const {
+    double from = a.longitude;
+    double to = from + std::remainder(b.longitude - a.longitude, 360.0);
+    bool forward = to > from;
+
+    // Boundaries B with from < B <= to (forward) or to < B <= from (backward)
+    double low = forward ? from : to;
+    double high = forward ? to : from;
+    for (double k = std::floor(low / size) + 1.0; k * size <= high; k += 1.0) {
+        Sample exact;
+        if (!refineIngress(body, a, b, k * size, exact)) {
+            return;
+        }
+        if (exact.julianDay < startJD || exact.julianDay >= endJD) {
+            continue;
+        }
+
+        // The boundary starts division upper and ends division lower
+        int count = static_cast<int>(std::lround(360.0 / size));
+        int upper = boundaryIndex(k * size, size);
+        int lower = (upper + count - 1) % count;
+        if (forward) {
+            events.push_back({type, planet, exact.julianDay, exact.longitude, lower, upper});
+        } else {
+            events.push_back({type, planet, exact.julianDay, exact.longitude, upper, lower});
+        }
+    }
+}
+
+bool TransitEventFinder::refineIngress(int body, Sample a, Sample b, double boundary, Sample& result) const {
+    auto offset = [boundary](const Sample& s) { return std::remainder(s.longitude - boundary, 360.0); };
+
+    double fa = offset(a);
+    double fb = offset(b);
+    double t = fb == fa ? a.julianDay : a.julianDay + (b.julianDay - a.julianDay) * (-fa) / (fb - fa);
+
+    // Newton on longitude, kept inside the bracket
+    for (int i = 0; i < 40; i++) {
+        if (!sample(body, t, result)) {
+            return false;
+        }
+
+        double f = offset(result);
+        if (f == 0.0) {
+            break;
+        }
+        if ((f < 0.0) == (fa < 0.0)) {
+            a = result;
+            fa = f;
+        } else {
+            b = result;
+        }
+
+        double next = result.speed != 0.0 ? t - f / result.speed : 0.5 * (a.julianDay + b.julianDay);
+        if (next <= a.julianDay || next >= b.julianDay) {
+            next = 0.5 * (a.julianDay + b.julianDay);
+        }
+        if (std::abs(next - t) < 1e-7) {
+            break;
+        }
+        t = next;
+    }
+    return true;
+}
+
+bool TransitEventFinder::refineStation(int body, Sample a, Sample b, Sample& result) const {
+    // Illinois regula falsi on speed
+    double ga = a.speed, gb = b.speed;
+    double previous = a.julianDay;
+    int side = 0;
+    result = a;
+
+    for (int i = 0; i < 60; i++) {
+        double t = (a.julianDay * gb - b.julianDay * ga) / (gb - ga);
+        if (!sample(body, t, result)) {
+            return false;
+        }
+        if (result.speed == 0.0 || std::abs(t - previous) < 1e-6) {
+            break;
+        }
+        previous = t;
+
+        if ((result.speed < 0.0) == (gb < 0.0)) {
+            b = result;
+            gb = result.speed;
+            if (side == -1) ga /= 2.0;
+            side = -1;
+        } else {
+            a = result;
+            ga = result.speed;
+            if (side == 1) gb /= 2.0;
+            side = 1;
+        }
+    }
+    return true;
+}
+
+} // namespace Astro
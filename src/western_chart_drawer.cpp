@@ -1,4 +1,5 @@
 #include "western_chart_drawer.h"
+#include "display_width.h"
 #include <sstream>
 #include <cmath>
 #include <algorithm>
@@ -54,40 +55,9 @@ WesternChartDrawer::WesternChartDrawer()
 }
 
 std::string WesternChartDrawer::drawChartWheel(const BirthChart& chart) const {
-    const int wheelSize = 61; // Must be odd for center
-    const int centerX = wheelSize / 2;
-    const int centerY = wheelSize / 2;
-
-    // Create empty wheel
-    std::vector<std::string> wheel(wheelSize, std::string(wheelSize, ' '));
-
-    // Draw the basic wheel structure
-    std::string frame = drawWheelFrame(wheelSize);
-    std::istringstream frameStream(frame);
-    std::string line;
-    int lineIndex = 0;
-    while (std::getline(frameStream, line) && lineIndex < wheelSize) {
-        if (line.length() > static_cast<size_t>(wheelSize)) {
-            wheel[lineIndex] = line.substr(0, wheelSize);
-        } else {
-            wheel[lineIndex] = line;
-            if (wheel[lineIndex].length() < static_cast<size_t>(wheelSize)) {
-                wheel[lineIndex].resize(wheelSize, ' ');
-            }
-        }
-        lineIndex++;
-    }
-
-    // Fill wheel with chart data
-    const auto& positions = chart.getPlanetPositions();
-    const auto& cusps = chart.getHouseCusps();
-
-    fillWheelWithPlanets(wheel, positions, cusps, centerX, centerY);
-    drawHouseCusps(wheel, cusps, centerX, centerY, 25);
-
-    if (showAspects) {
-        drawAspectLines(wheel, chart.getAspects(), positions, cusps, centerX, centerY);
-    }
+    WheelState state;
+    updateWheel(state, chart);
+    const auto& wheel = state.rows;
 
     // Convert wheel to string
     std::stringstream ss;
@@ -110,6 +80,32 @@ std::string WesternChartDrawer::drawChartWheel(const BirthChart& chart) const {
     return ss.str();
 }
 
+void WesternChartDrawer::updateWheel(WheelState& state, const BirthChart& chart) const {
+    const int centerX = WHEEL_SIZE / 2;
+    const int centerY = WHEEL_SIZE / 2;
+    const auto& frame = wheelFrame();
+
+    if (state.rows.size() != frame.size()) {
+        state.rows = frame;
+    } else {
+        for (const auto& cell : state.drawnCells) {
+            state.rows[cell.second][cell.first] = frame[cell.second][cell.first];
+        }
+    }
+    state.drawnCells.clear();
+
+    // Fill wheel with chart data
+    const auto& positions = chart.getPlanetPositions();
+    const auto& cusps = chart.getHouseCusps();
+
+    fillWheelWithPlanets(state.rows, positions, cusps, centerX, centerY, &state.drawnCells);
+    drawHouseCusps(state.rows, cusps, centerX, centerY, 25, &state.drawnCells);
+
+    if (showAspects) {
+        drawAspectLines(state.rows, chart.getAspects(), positions, cusps, centerX, centerY);
+    }
+}
+
 std::string WesternChartDrawer::drawRectangularChart(const BirthChart& chart) const {
     std::stringstream ss;
     ss << "\n=== WESTERN CHART - RECTANGULAR LAYOUT ===\n\n";
@@ -124,13 +120,13 @@ std::string WesternChartDrawer::drawRectangularChart(const BirthChart& chart) co
         "│              │              │              │              │",
         "│              │              │              │              │",
         "├──────────────┼──────────────┼──────────────┼──────────────┤",
-        "│   House 9    │                            │   House 2    │",
+        "│   House 9    │                             │   House 2    │",
         "│              │         CHART WHEEL         │              │",
-        "│              │                            │              │",
-        "├──────────────┤                            ├──────────────┤",
-        "│   House 8    │                            │   House 3    │",
-        "│              │                            │              │",
-        "│              │                            │              │",
+        "│              │                             │              │",
+        "├──────────────┤                             ├──────────────┤",
+        "│   House 8    │                             │   House 3    │",
+        "│              │                             │              │",
+        "│              │                             │              │",
         "├──────────────┼──────────────┼──────────────┼──────────────┤",
         "│   House 7    │   House 6    │   House 5    │   House 4    │",
         "│              │              │              │              │",
@@ -180,20 +176,18 @@ std::string WesternChartDrawer::drawRectangularChart(const BirthChart& chart) co
                 planetsStr += planetsInHouse[i];
             }
 
-            // Truncate if too long
-            if (planetsStr.length() > static_cast<size_t>(housePos.width)) {
-                planetsStr = planetsStr.substr(0, housePos.width);
-            }
-
-            // Center the text
-            int padding = (housePos.width - planetsStr.length()) / 2;
-            std::string formatted = std::string(padding, ' ') + planetsStr +
-                                  std::string(housePos.width - padding - planetsStr.length(), ' ');
-
-            // Place in grid
-            if (housePos.line + 2 < static_cast<int>(lines.size()) &&
-                housePos.col + formatted.length() <= lines[housePos.line + 2].length()) {
-                lines[housePos.line + 2].replace(housePos.col, formatted.length(), formatted);
+            // Truncate if too long, then center the text
+            std::string formatted = centerToWidth(truncateToWidth(planetsStr, housePos.width), housePos.width);
+
+            // Place in grid; the frame is box-drawing text, so col and width
+            // are display columns rather than byte offsets
+            if (housePos.line + 2 < static_cast<int>(lines.size())) {
+                std::string& line = lines[housePos.line + 2];
+                if (displayWidth(line) >= housePos.col + housePos.width) {
+                    size_t begin = byteOffsetForWidth(line, housePos.col);
+                    size_t end = byteOffsetForWidth(line, housePos.col + housePos.width);
+                    line.replace(begin, end - begin, formatted);
+                }
             }
         }
     }
@@ -263,7 +257,28 @@ std::string WesternChartDrawer::drawAspectGrid(const BirthChart& chart) const {
     return ss.str();
 }
 
-std::string WesternChartDrawer::drawWheelFrame(int size) const {
+const std::vector<std::string>& WesternChartDrawer::wheelFrame() {
+    // The frame depends on nothing but the size, so it is laid out once
+    static const std::vector<std::string> frame = [] {
+        std::vector<std::string> wheel(WHEEL_SIZE, std::string(WHEEL_SIZE, ' '));
+        std::istringstream frameStream(drawWheelFrame(WHEEL_SIZE));
+        std::string line;
+        int lineIndex = 0;
+        while (std::getline(frameStream, line) && lineIndex < WHEEL_SIZE) {
+            if (line.length() > static_cast<size_t>(WHEEL_SIZE)) {
+                wheel[lineIndex] = line.substr(0, WHEEL_SIZE);
+            } else {
+                wheel[lineIndex] = line;
+                wheel[lineIndex].resize(WHEEL_SIZE, ' ');
+            }
+            lineIndex++;
+        }
+        return wheel;
+    }();
+    return frame;
+}
+
+std::string WesternChartDrawer::drawWheelFrame(int size) {
     std::stringstream ss;
     int center = size / 2;
     int outerRadius = center - 1;
@@ -331,7 +346,8 @@ std::string WesternChartDrawer::formatDegreeWithSign(double longitude) const {
 
 void WesternChartDrawer::fillWheelWithPlanets(std::vector<std::string>& wheel,
                                             const std::vector<PlanetPosition>& positions,
-                                            const HouseCusps& cusps, int centerX, int centerY) const {
+                                            const HouseCusps& cusps, int centerX, int centerY,
+                                            std::vector<std::pair<int, int>>* drawnCells) const {
     const int planetRadius = 20;
 
     for (const auto& pos : positions) {
@@ -352,13 +368,15 @@ void WesternChartDrawer::fillWheelWithPlanets(std::vector<std::string>& wheel,
             std::string glyph = getPlanetGlyph(pos.planet);
             if (!glyph.empty() && glyph != "?") {
                 wheel[y][x] = glyph[0]; // Use first character if multi-byte
+                if (drawnCells) drawnCells->emplace_back(x, y);
             }
         }
     }
 }
 
 void WesternChartDrawer::drawHouseCusps(std::vector<std::string>& wheel, const HouseCusps& cusps,
-                                      int centerX, int centerY, int radius) const {
+                                      int centerX, int centerY, int radius,
+                                      std::vector<std::pair<int, int>>* drawnCells) const {
     // Draw house cusp lines
     for (int house = 1; house <= 12; house++) {
         double cuspLongitude = cusps.cusps[house];
@@ -374,6 +392,7 @@ void WesternChartDrawer::drawHouseCusps(std::vector<std::string>& wheel, const H
                 y >= 0 && y < static_cast<int>(wheel.size()) &&
                 wheel[y][x] == ' ') {
                 wheel[y][x] = '|';
+                if (drawnCells) drawnCells->emplace_back(x, y);
             }
         }
 
@@ -386,6 +405,7 @@ void WesternChartDrawer::drawHouseCusps(std::vector<std::string>& wheel, const H
             ny >= 0 && ny < static_cast<int>(wheel.size())) {
             if (house < 10) {
                 wheel[ny][nx] = '0' + house;
+                if (drawnCells) drawnCells->emplace_back(nx, ny);
             }
         }
     }
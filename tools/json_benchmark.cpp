@@ -0,0 +1,414 @@
+// Timing harness for the JSON outputs (built with -DHOROSCOPE_BENCHMARKS=ON).
+//
+// usage: json_benchmark [ITERATIONS]
+//
+// Computes one birth chart and one year of daily Panchanga and Myanmar
+// calendar data up front, then times only the JSON generation: per chart for
+// BirthChart::exportToJson and per calendar day for HinduCalendar::generateJSON
+// and MyanmarCalendar::generateJSON. Each is timed next to the ostringstream
+// generator it replaced (kept below as the legacy* functions, unchanged apart
+// from reading through public getters) and the speedup is printed per row.
+// KPSystem::generateKPTableJSON had no earlier implementation and is timed
+// alone. The generated text is summed into a checksum so none of it can be
+// optimized away.
+
+#include "birth_chart.h"
+#include "hindu_calendar.h"
+#include "horoscope_calculator.h"
+#include "kp_system.h"
+#include "myanmar_calendar.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using namespace Astro;
+
+namespace {
+
+constexpr int DAYS = 365;
+
+// Average microseconds per call of generate(), repeated `iterations` times
+double timePerCall(int iterations, size_t& checksum, const std::function<std::string()>& generate) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < iterations; i++) {
+        checksum += generate().size();
+    }
+    std::chrono::duration<double, std::micro> elapsed = std::chrono::steady_clock::now() - start;
+    return elapsed.count() / iterations;
+}
+
+// The generators as they were before JsonWriter
+
+std::string legacyChartJSON(const BirthChart& chart) {
+    const BirthData& birthData = chart.getBirthData();
+    const auto& planetPositions = chart.getPlanetPositions();
+    const HouseCusps& houseCusps = chart.getHouseCusps();
+    const auto& aspects = chart.getAspects();
+    std::ostringstream oss;
+    oss << "{\n";
+    oss << "  \"birthData\": {\n";
+    oss << "    \"date\": \"" << birthData.year << "-"
+        << std::setfill('0') << std::setw(2) << birthData.month << "-"
+        << std::setw(2) << birthData.day << "\",\n";
+    oss << "    \"time\": \"" << std::setw(2) << birthData.hour << ":"
+        << std::setw(2) << birthData.minute << ":"
+        << std::setw(2) << birthData.second << "\",\n";
+    oss << "    \"latitude\": " << std::fixed << std::setprecision(6) << birthData.latitude << ",\n";
+    oss << "    \"longitude\": " << birthData.longitude << ",\n";
+    oss << "    \"timezone\": " << birthData.timezone << "\n";
+    oss << "  },\n";
+
+    oss << "  \"planets\": [\n";
+    for (size_t i = 0; i < planetPositions.size(); i++) {
+        const auto& pos = planetPositions[i];
+        oss << "    {\n";
+        oss << "      \"name\": \"" << planetToString(pos.planet) << "\",\n";
+        oss << "      \"longitude\": " << std::fixed << std::setprecision(6) << pos.longitude << ",\n";
+        oss << "      \"latitude\": " << pos.latitude << ",\n";
+        oss << "      \"sign\": \"" << zodiacSignToString(pos.sign) << "\",\n";
+        oss << "      \"house\": " << pos.house << ",\n";
+        oss << "      \"speed\": " << pos.speed << "\n";
+        oss << "    }";
+        if (i < planetPositions.size() - 1) oss << ",";
+        oss << "\n";
+    }
+    oss << "  ],\n";
+
+    oss << "  \"houses\": {\n";
+    for (int house = 1; house <= 12; house++) {
+        oss << "    \"" << house << "\": " << std::fixed << std::setprecision(6)
+            << houseCusps.cusps[house];
+        if (house < 12) oss << ",";
+        oss << "\n";
+    }
+    oss << "  },\n";
+
+    oss << "  \"aspects\": [\n";
+    for (size_t i = 0; i < aspects.size(); i++) {
+        const auto& aspect = aspects[i];
+        oss << "    {\n";
+        oss << "      \"planet1\": \"" << planetToString(aspect.planet1) << "\",\n";
+        oss << "      \"planet2\": \"" << planetToString(aspect.planet2) << "\",\n";
+        oss << "      \"type\": \"" << aspectTypeToString(aspect.type) << "\",\n";
+        oss << "      \"orb\": " << std::fixed << std::setprecision(2) << aspect.orb << ",\n";
+        oss << "      \"applying\": " << (aspect.isApplying ? "true" : "false") << "\n";
+        oss << "    }";
+        if (i < aspects.size() - 1) oss << ",";
+        oss << "\n";
+    }
+    oss << "  ]\n";
+    oss << "}";
+
+    return oss.str();
+}
+
+std::string legacyPanchangaJSON(const HinduCalendar& calendar, const PanchangaData& panchanga) {
+    std::ostringstream oss;
+
+    oss << "{\n";
+    oss << "  \"panchangaBasics\": {\n";
+    oss << "    \"tithi\": {\n";
+    oss << "      \"number\": " << static_cast<int>(panchanga.tithi) << ",\n";
+    oss << "      \"name\": \"" << calendar.getTithiName(panchanga.tithi) << "\",\n";
+    oss << "      \"endTime\": \"" << panchanga.getTimeString(panchanga.tithiEndTime) << "\"\n";
+    oss << "    },\n";
+    oss << "    \"vara\": {\n";
+    oss << "      \"number\": " << static_cast<int>(panchanga.vara) << ",\n";
+    oss << "      \"name\": \"" << calendar.getVaraName(panchanga.vara) << "\"\n";
+    oss << "    },\n";
+    oss << "    \"nakshatra\": {\n";
+    oss << "      \"number\": " << static_cast<int>(panchanga.nakshatra) << ",\n";
+    oss << "      \"name\": \"" << calendar.getNakshatraName(panchanga.nakshatra) << "\",\n";
+    oss << "      \"pada\": " << panchanga.nakshatraPada << ",\n";
+    oss << "      \"endTime\": \"" << panchanga.getTimeString(panchanga.nakshatraEndTime) << "\"\n";
+    oss << "    },\n";
+    oss << "    \"yoga\": {\n";
+    oss << "      \"number\": " << static_cast<int>(panchanga.yoga) << ",\n";
+    oss << "      \"name\": \"" << calendar.getYogaName(panchanga.yoga) << "\",\n";
+    oss << "      \"endTime\": \"" << panchanga.getTimeString(panchanga.yogaEndTime) << "\"\n";
+    oss << "    },\n";
+    oss << "    \"karana\": {\n";
+    oss << "      \"number\": " << static_cast<int>(panchanga.karana) << ",\n";
+    oss << "      \"name\": \"" << calendar.getKaranaName(panchanga.karana) << "\",\n";
+    oss << "      \"endTime\": \"" << panchanga.getTimeString(panchanga.karanaEndTime) << "\"\n";
+    oss << "    }\n";
+    oss << "  },\n";
+
+    oss << "  \"dateInformation\": {\n";
+    oss << "    \"vikramYear\": " << panchanga.vikramYear << ",\n";
+    oss << "    \"shakaYear\": " << panchanga.shakaYear << ",\n";
+    oss << "    \"kaliyugaYear\": " << panchanga.kaliyugaYear << ",\n";
+    oss << "    \"month\": \"" << calendar.getHinduMonthName(panchanga.month) << "\",\n";
+    oss << "    \"paksha\": \"" << (panchanga.isShukla ? "Shukla" : "Krishna") << "\",\n";
+    oss << "    \"julianDay\": " << std::fixed << std::setprecision(1) << panchanga.julianDay << "\n";
+    oss << "  },\n";
+
+    oss << "  \"sunMoonInformation\": {\n";
+    oss << "    \"sunrise\": \"" << panchanga.getTimeString(panchanga.sunriseTime) << "\",\n";
+    oss << "    \"sunset\": \"" << panchanga.getTimeString(panchanga.sunsetTime) << "\",\n";
+    oss << "    \"moonrise\": \"" << panchanga.getTimeString(panchanga.moonriseTime) << "\",\n";
+    oss << "    \"moonset\": \"" << panchanga.getTimeString(panchanga.moonsetTime) << "\",\n";
+    oss << "    \"dayLength\": " << std::fixed << std::setprecision(2) << panchanga.dayLength << ",\n";
+    oss << "    \"nightLength\": " << std::fixed << std::setprecision(2) << panchanga.nightLength << "\n";
+    oss << "  },\n";
+
+    oss << "  \"celestial\": {\n";
+    oss << "    \"sunLongitude\": " << std::fixed << std::setprecision(4) << panchanga.sunLongitude << ",\n";
+    oss << "    \"moonLongitude\": " << std::fixed << std::setprecision(4) << panchanga.moonLongitude << ",\n";
+    oss << "    \"lunarPhase\": " << std::fixed << std::setprecision(4) << panchanga.lunarPhase << ",\n";
+    oss << "    \"sunRashi\": \"" << calendar.getRashiName(panchanga.sunRashi) << "\",\n";
+    oss << "    \"moonRashi\": \"" << calendar.getRashiName(panchanga.moonRashi) << "\",\n";
+    oss << "    \"ayanamsaValue\": " << std::fixed << std::setprecision(6) << panchanga.ayanamsaValue << ",\n";
+    oss << "    \"ritu\": \"" << panchanga.ritu << "\",\n";
+    oss << "    \"ayana\": \"" << panchanga.ayana << "\"\n";
+    oss << "  },\n";
+
+    oss << "  \"auspiciousTimings\": {\n";
+    oss << "    \"brahmaMuhurta\": {\n";
+    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.brahmaMuhurtaStart) << "\",\n";
+    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.brahmaMuhurtaEnd) << "\"\n";
+    oss << "    },\n";
+    oss << "    \"abhijitMuhurta\": {\n";
+    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.abhijitStart) << "\",\n";
+    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.abhijitEnd) << "\"\n";
+    oss << "    },\n";
+    oss << "    \"godhuliBela\": {\n";
+    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.godhuliBelStart) << "\",\n";
+    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.godhuliBelEnd) << "\"\n";
+    oss << "    },\n";
+    oss << "    \"nishitaMuhurta\": {\n";
+    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.nishitaMuhurtaStart) << "\",\n";
+    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.nishitaMuhurtaEnd) << "\"\n";
+    oss << "    }\n";
+    oss << "  },\n";
+
+    oss << "  \"inauspiciousTimings\": {\n";
+    oss << "    \"rahuKaal\": {\n";
+    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.rahuKaalStart) << "\",\n";
+    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.rahuKaalEnd) << "\"\n";
+    oss << "    },\n";
+    oss << "    \"yamaganda\": {\n";
+    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.yamagandaStart) << "\",\n";
+    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.yamagandaEnd) << "\"\n";
+    oss << "    },\n";
+    oss << "    \"gulikai\": {\n";
+    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.gulikaiStart) << "\",\n";
+    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.gulikaiEnd) << "\"\n";
+    oss << "    },\n";
+    oss << "    \"durMuhurtam\": {\n";
+    oss << "      \"start\": \"" << panchanga.getTimeString(panchanga.durMuhurtamStart) << "\",\n";
+    oss << "      \"end\": \"" << panchanga.getTimeString(panchanga.durMuhurtamEnd) << "\"\n";
+    oss << "    },\n";
+    oss << "    \"varjyam\": [";
+    for (size_t i = 0; i < panchanga.varjyamTimes.size(); ++i) {
+        if (i > 0) oss << ", ";
+        oss << "{\n";
+        oss << "        \"start\": \"" << panchanga.getTimeString(panchanga.varjyamTimes[i].first) << "\",\n";
+        oss << "        \"end\": \"" << panchanga.getTimeString(panchanga.varjyamTimes[i].second) << "\"\n";
+        oss << "      }";
+    }
+    oss << "]\n";
+    oss << "  },\n";
+
+    oss << "  \"specialDays\": {\n";
+    oss << "    \"isEkadashi\": " << (panchanga.isEkadashi ? "true" : "false") << ",\n";
+    oss << "    \"isPurnima\": " << (panchanga.isPurnima ? "true" : "false") << ",\n";
+    oss << "    \"isAmavasya\": " << (panchanga.isAmavasya ? "true" : "false") << ",\n";
+    oss << "    \"isSankranti\": " << (panchanga.isSankranti ? "true" : "false") << ",\n";
+    oss << "    \"isNavratri\": " << (panchanga.isNavratri ? "true" : "false") << ",\n";
+    oss << "    \"isGandaMool\": " << (panchanga.isGandaMool ? "true" : "false") << ",\n";
+    oss << "    \"isPanchak\": " << (panchanga.isPanchak ? "true" : "false") << ",\n";
+    oss << "    \"isBhadra\": " << (panchanga.isBhadra ? "true" : "false") << ",\n";
+    oss << "    \"isFastingDay\": " << (panchanga.isFastingDay ? "true" : "false") << "\n";
+    oss << "  },\n";
+
+    oss << "  \"specialYogas\": {\n";
+    oss << "    \"isSarvarthaSiddhi\": " << (panchanga.isSarvarthaSiddhi ? "true" : "false") << ",\n";
+    oss << "    \"isAmritaSiddhi\": " << (panchanga.isAmritaSiddhi ? "true" : "false") << ",\n";
+    oss << "    \"isDwipushkar\": " << (panchanga.isDwipushkar ? "true" : "false") << ",\n";
+    oss << "    \"isTripushkar\": " << (panchanga.isTripushkar ? "true" : "false") << ",\n";
+    oss << "    \"isRaviPushya\": " << (panchanga.isRaviPushya ? "true" : "false") << ",\n";
+    oss << "    \"isGuruPushya\": " << (panchanga.isGuruPushya ? "true" : "false") << "\n";
+    oss << "  },\n";
+
+    oss << "  \"directions\": {\n";
+    oss << "    \"dishaShool\": \"" << panchanga.dishaShool << "\",\n";
+    oss << "    \"nakshatraShool\": \"" << panchanga.nakshatraShool << "\"\n";
+    oss << "  },\n";
+
+    oss << "  \"festivals\": [";
+    for (size_t i = 0; i < panchanga.festivals.size(); ++i) {
+        oss << "\"" << panchanga.festivals[i] << "\"";
+        if (i < panchanga.festivals.size() - 1) oss << ", ";
+    }
+    oss << "],\n";
+
+    oss << "  \"ekadashiNames\": [";
+    for (size_t i = 0; i < panchanga.ekadashiNames.size(); ++i) {
+        oss << "\"" << panchanga.ekadashiNames[i] << "\"";
+        if (i < panchanga.ekadashiNames.size() - 1) oss << ", ";
+    }
+    oss << "],\n";
+
+    oss << "  \"vrataUpavas\": [";
+    for (size_t i = 0; i < panchanga.vrataList.size(); ++i) {
+        oss << "\"" << panchanga.vrataList[i] << "\"";
+        if (i < panchanga.vrataList.size() - 1) oss << ", ";
+    }
+    oss << "],\n";
+
+    oss << "  \"chandraBalam\": [";
+    for (size_t i = 0; i < panchanga.goodChandraBalam.size(); ++i) {
+        oss << "\"" << calendar.getRashiName(panchanga.goodChandraBalam[i]) << "\"";
+        if (i < panchanga.goodChandraBalam.size() - 1) oss << ", ";
+    }
+    oss << "],\n";
+
+    oss << "  \"taraBalam\": [";
+    for (size_t i = 0; i < panchanga.goodTaraBalam.size(); ++i) {
+        oss << "\"" << calendar.getNakshatraName(panchanga.goodTaraBalam[i]) << "\"";
+        if (i < panchanga.goodTaraBalam.size() - 1) oss << ", ";
+    }
+    oss << "],\n";
+
+    oss << "  \"muhurta\": {\n";
+    oss << "    \"isShubha\": " << (panchanga.isShubhaMuhurta ? "true" : "false") << ",\n";
+    oss << "    \"description\": \"" << panchanga.muhurtaDescription << "\"\n";
+    oss << "  }\n";
+    oss << "}";
+
+    return oss.str();
+}
+
+std::string legacyMyanmarJSON(const MyanmarCalendar& calendar, const MyanmarCalendarData& data) {
+    std::stringstream ss;
+
+    ss << "{\n";
+    ss << "  \"myanmarYear\": " << data.myanmarYear << ",\n";
+    ss << "  \"sasanaYear\": " << data.sasanaYear << ",\n";
+    ss << "  \"month\": {\n";
+    ss << "    \"number\": " << static_cast<int>(data.month) << ",\n";
+    ss << "    \"name\": \"" << calendar.getMyanmarMonthName(data.month) << "\"\n";
+    ss << "  },\n";
+    ss << "  \"dayOfMonth\": " << data.dayOfMonth << ",\n";
+    ss << "  \"yearType\": {\n";
+    ss << "    \"number\": " << static_cast<int>(data.yearType) << ",\n";
+    ss << "    \"name\": \"" << calendar.getYearTypeName(data.yearType) << "\"\n";
+    ss << "  },\n";
+    ss << "  \"weekday\": {\n";
+    ss << "    \"number\": " << static_cast<int>(data.weekday) << ",\n";
+    ss << "    \"name\": \"" << calendar.getMyanmarWeekdayName(data.weekday) << "\"\n";
+    ss << "  },\n";
+    ss << "  \"moonPhase\": {\n";
+    ss << "    \"number\": " << static_cast<int>(data.moonPhase) << ",\n";
+    ss << "    \"name\": \"" << calendar.getMoonPhaseName(data.moonPhase) << "\"\n";
+    ss << "  },\n";
+    ss << "  \"fortnightDay\": " << data.fortnightDay << ",\n";
+    ss << "  \"monthLength\": " << data.monthLength << ",\n";
+    ss << "  \"astrological\": {\n";
+    ss << "    \"mahabote\": \"" << calendar.getMahaboteName(data.mahabote) << "\",\n";
+    ss << "    \"nakhat\": \"" << calendar.getNakhatName(data.nakhat) << "\",\n";
+    ss << "    \"nagahle\": \"" << calendar.getNagahleDirectionName(data.nagahle) << "\",\n";
+    ss << "    \"sabbath\": " << (data.isSabbath ? "true" : "false") << ",\n";
+    ss << "    \"yatyaza\": " << (data.isYatyaza ? "true" : "false") << ",\n";
+    ss << "    \"pyathada\": " << (data.isPyathada ? "true" : "false") << ",\n";
+    ss << "    \"thamanyo\": " << (data.isThamanyo ? "true" : "false") << "\n";
+    ss << "  },\n";
+    ss << "  \"festivals\": [";
+    for (size_t i = 0; i < data.festivals.size(); ++i) {
+        ss << "\"" << data.festivals[i] << "\"";
+        if (i < data.festivals.size() - 1) ss << ", ";
+    }
+    ss << "],\n";
+    ss << "  \"astrologicalEvents\": [";
+    for (size_t i = 0; i < data.astrologicalEvents.size(); ++i) {
+        ss << "\"" << data.astrologicalEvents[i] << "\"";
+        if (i < data.astrologicalEvents.size() - 1) ss << ", ";
+    }
+    ss << "]\n";
+    ss << "}\n";
+
+    return ss.str();
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    int iterations = argc > 1 ? std::atoi(argv[1]) : 20000;
+    if (iterations <= 0) {
+        std::fprintf(stderr, "usage: json_benchmark [ITERATIONS]\n");
+        return 1;
+    }
+
+    HoroscopeCalculator calculator;
+    if (!calculator.initialize(SE_EPHE_PATH)) {
+        std::fprintf(stderr, "Error: %s\n", calculator.getLastError().c_str());
+        return 1;
+    }
+    BirthData birthData = {1990, 1, 15, 14, 30, 0, 40.7128, -74.0060, -5.0};
+    BirthChart chart;
+    if (!calculator.calculateBirthChart(birthData, HouseSystem::PLACIDUS, chart)) {
+        std::fprintf(stderr, "Error: %s\n", calculator.getLastError().c_str());
+        return 1;
+    }
+
+    KPSystem kp;
+    kp.initialize();
+
+    HinduCalendar hindu;
+    MyanmarCalendar myanmar;
+    if (!hindu.initialize() || !myanmar.initialize()) {
+        std::fprintf(stderr, "Error: failed to initialize the calendars\n");
+        return 1;
+    }
+    std::vector<PanchangaData> panchanga;
+    std::vector<MyanmarCalendarData> myanmarDays;
+    double firstDay = birthData.getJulianDay();
+    for (int day = 0; day < DAYS; day++) {
+        panchanga.push_back(hindu.calculatePanchanga(firstDay + day, birthData.latitude, birthData.longitude));
+        myanmarDays.push_back(myanmar.calculateMyanmarCalendar(firstDay + day));
+    }
+
+    size_t checksum = 0;
+    int dayIterations = std::max(1, iterations / DAYS) * DAYS;
+    size_t day = 0;
+    auto nextPanchanga = [&]() -> const PanchangaData& { return panchanga[day++ % DAYS]; };
+    auto nextMyanmar = [&]() -> const MyanmarCalendarData& { return myanmarDays[day++ % DAYS]; };
+
+    struct Row {
+        const char* name;
+        const char* unit;
+        double before;      // legacy generator; 0 when there was none
+        double after;
+    };
+    std::vector<Row> rows;
+    rows.push_back({"BirthChart::exportToJson", "chart",
+                    timePerCall(iterations, checksum, [&] { return legacyChartJSON(chart); }),
+                    timePerCall(iterations, checksum, [&] { return chart.exportToJson(); })});
+    rows.push_back({"KPSystem::generateKPTableJSON", "chart", 0.0,
+                    timePerCall(iterations, checksum, [&] { return kp.generateKPTableJSON(chart.getPlanetPositions()); })});
+    rows.push_back({"HinduCalendar::generateJSON", "day",
+                    timePerCall(dayIterations, checksum, [&] { return legacyPanchangaJSON(hindu, nextPanchanga()); }),
+                    timePerCall(dayIterations, checksum, [&] { return hindu.generateJSON(nextPanchanga()); })});
+    rows.push_back({"MyanmarCalendar::generateJSON", "day",
+                    timePerCall(dayIterations, checksum, [&] { return legacyMyanmarJSON(myanmar, nextMyanmar()); }),
+                    timePerCall(dayIterations, checksum, [&] { return myanmar.generateJSON(nextMyanmar()); })});
+
+    std::printf("JSON generation, %d iterations (checksum %zu)\n", iterations, checksum);
+    std::printf("  %-30s %17s %15s %8s\n", "", "ostringstream", "JsonWriter", "speedup");
+    for (const Row& row : rows) {
+        if (row.before > 0.0) {
+            std::printf("  %-30s %8.2f us/%-5s %6.2f us/%-5s %7.2fx\n", row.name, row.before, row.unit,
+                        row.after, row.unit, row.before / row.after);
+        } else {
+            std::printf("  %-30s %17s %6.2f us/%-5s %8s\n", row.name, "-", row.after, row.unit, "-");
+        }
+    }
+    return 0;
+}
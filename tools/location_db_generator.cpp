@@ -0,0 +1,396 @@
+// Build-time generator for the location database (see include/location_db.h).
+//
+// usage: location_db_generator OUTPUT.inc LOCATIONS.tsv [cities15000.txt]
+//
+// LOCATIONS.tsv is the curated city list (name, country, region, latitude,
+// longitude, UTC offset, timezone id, population; '#' starts a comment).
+// The optional second input is a GeoNames cities dump. When timeZones.txt,
+// countryInfo.txt and admin1CodesASCII.txt from GeoNames sit next to it they
+// supply UTC offsets, country names and region names. GeoNames cities that
+// duplicate a curated one are skipped; the rest follow in population order.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <set>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+struct City {
+    std::string name;
+    std::string asciiName;   // extra search tokens (GeoNames only)
+    std::string country;
+    std::string region;
+    std::string timezoneId;
+    double latitude = 0.0;
+    double longitude = 0.0;
+    double timezone = 0.0;
+    long population = 0;
+};
+
+std::vector<std::string> splitTabs(const std::string& line) {
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+        size_t tab = line.find('\t', start);
+        fields.push_back(line.substr(start, tab == std::string::npos ? std::string::npos : tab - start));
+        if (tab == std::string::npos) break;
+        start = tab + 1;
+    }
+    if (!fields.empty() && !fields.back().empty() && fields.back().back() == '\r') {
+        fields.back().pop_back();
+    }
+    return fields;
+}
+
+std::string lower(std::string text) {
+    std::transform(text.begin(), text.end(), text.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return text;
+}
+
+// Same token rules the runtime index has always used: split on whitespace,
+// drop ',', '-', '(' and ')'
+std::vector<std::string> tokenize(const std::string& text) {
+    std::vector<std::string> tokens;
+    std::istringstream stream(text);
+    std::string token;
+    while (stream >> token) {
+        token.erase(std::remove_if(token.begin(), token.end(), [](char c) {
+            return c == ',' || c == '-' || c == '(' || c == ')';
+        }), token.end());
+        if (!token.empty()) tokens.push_back(token);
+    }
+    return tokens;
+}
+
+bool readCurated(const std::string& path, std::vector<City>& cities) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "location_db_generator: cannot open " << path << "\n";
+        return false;
+    }
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(in, line)) {
+        lineNumber++;
+        if (line.empty() || line[0] == '#') continue;
+
+        auto f = splitTabs(line);
+        if (f.size() != 8) {
+            std::cerr << path << ":" << lineNumber << ": expected 8 tab-separated fields\n";
+            return false;
+        }
+        City city;
+        city.name = f[0];
+        city.country = f[1];
+        city.region = f[2];
+        city.latitude = std::stod(f[3]);
+        city.longitude = std::stod(f[4]);
+        city.timezone = std::stod(f[5]);
+        city.timezoneId = f[6];
+        city.population = std::stol(f[7]);
+        cities.push_back(city);
+    }
+    return true;
+}
+
+std::string siblingPath(const std::string& path, const std::string& name) {
+    size_t slash = path.find_last_of('/');
+    return slash == std::string::npos ? name : path.substr(0, slash + 1) + name;
+}
+
+// Optional GeoNames side tables: key column -> value column
+std::map<std::string, std::string> readTable(const std::string& path, size_t keyColumn, size_t valueColumn,
+                                             bool skipHeader) {
+    std::map<std::string, std::string> table;
+    std::ifstream in(path);
+    std::string line;
+    bool first = true;
+    while (std::getline(in, line)) {
+        if (first && skipHeader) {
+            first = false;
+            continue;
+        }
+        if (line.empty() || line[0] == '#') continue;
+        auto f = splitTabs(line);
+        if (f.size() > std::max(keyColumn, valueColumn)) {
+            table[f[keyColumn]] = f[valueColumn];
+        }
+    }
+    return table;
+}
+
+bool readGeoNames(const std::string& path, const std::vector<City>& curated, std::vector<City>& cities) {
+    std::ifstream in(path);
+    if (!in) {
+        std::cerr << "location_db_generator: cannot open " << path << "\n";
+        return false;
+    }
+
+    auto offsets = readTable(siblingPath(path, "timeZones.txt"), 1, 4, true);
+    auto countries = readTable(siblingPath(path, "countryInfo.txt"), 0, 4, false);
+    auto regions = readTable(siblingPath(path, "admin1CodesASCII.txt"), 0, 1, false);
+
+    // Curated cities by lowercased name, to drop GeoNames duplicates
+    std::multimap<std::string, const City*> known;
+    for (const auto& city : curated) {
+        known.emplace(lower(city.name), &city);
+    }
+
+    std::vector<City> loaded;
+    std::string line;
+    while (std::getline(in, line)) {
+        auto f = splitTabs(line);
+        if (f.size() < 18) continue;
+
+        City city;
+        city.name = f[1];
+        city.asciiName = f[2] == f[1] ? "" : f[2];
+        city.latitude = std::stod(f[4]);
+        city.longitude = std::stod(f[5]);
+        city.population = f[14].empty() ? 0 : std::stol(f[14]);
+        city.timezoneId = f[17];
+
+        auto country = countries.find(f[8]);
+        city.country = country != countries.end() ? country->second : f[8];
+        auto region = regions.find(f[8] + "." + f[10]);
+        city.region = region != regions.end() ? region->second : "";
+        auto offset = offsets.find(city.timezoneId);
+        city.timezone = offset != offsets.end() ? std::stod(offset->second) : 0.0;
+
+        bool duplicate = false;
+        for (const std::string& name : {lower(city.name), lower(f[2])}) {
+            auto range = known.equal_range(name);
+            for (auto it = range.first; it != range.second && !duplicate; ++it) {
+                duplicate = std::fabs(it->second->latitude - city.latitude) < 0.5 &&
+                            std::fabs(it->second->longitude - city.longitude) < 0.5;
+            }
+        }
+        if (!duplicate) loaded.push_back(city);
+    }
+
+    std::stable_sort(loaded.begin(), loaded.end(), [](const City& a, const City& b) {
+        return a.population > b.population;
+    });
+    cities.insert(cities.end(), loaded.begin(), loaded.end());
+    return true;
+}
+
+// Deduplicated string pool; every string is NUL-terminated
+class TextPool {
+public:
+    uint32_t add(const std::string& text) {
+        auto it = offsets.find(text);
+        if (it != offsets.end()) return it->second;
+        uint32_t offset = static_cast<uint32_t>(pool.size());
+        pool += text;
+        pool += '\0';
+        offsets.emplace(text, offset);
+        return offset;
+    }
+
+    const std::string& data() const { return pool; }
+
+private:
+    std::string pool;
+    std::unordered_map<std::string, uint32_t> offsets;
+};
+
+void writeText(std::ostream& out, const std::string& pool) {
+    out << "const char TEXT[] =\n    \"";
+    size_t column = 0;
+    for (unsigned char c : pool) {
+        if (column >= 96) {
+            out << "\"\n    \"";
+            column = 0;
+        }
+        if (c == '"' || c == '\\') {
+            out << '\\' << c;
+            column += 2;
+        } else if (c >= 0x20 && c < 0x7F) {
+            out << c;
+            column++;
+        } else {
+            char escape[5];
+            std::snprintf(escape, sizeof(escape), "\\%03o", c);
+            out << escape;
+            column += 4;
+        }
+    }
+    out << "\";\n\n";
+}
+
+void writeNumbers(std::ostream& out, const char* declaration, const std::vector<uint32_t>& values) {
+    out << declaration << " = {";
+    for (size_t i = 0; i < values.size(); i++) {
+        out << (i % 16 == 0 ? "\n    " : " ") << values[i] << ",";
+    }
+    out << "\n    0  // sentinel, keeps the array non-empty\n};\n\n";
+}
+
+// Implicit k-d tree over unit vectors: the node for order[lo, hi) is the
+// median at lo + (hi - lo) / 2, split on the axis of widest spread; its
+// children are the ranges on either side of it
+struct SpatialPoint {
+    double xyz[3];
+    uint32_t location;
+    uint32_t axis;
+};
+
+void buildSpatial(std::vector<SpatialPoint>& points, size_t lo, size_t hi) {
+    if (hi - lo <= 1) {
+        if (hi > lo) points[lo].axis = 0;
+        return;
+    }
+
+    uint32_t axis = 0;
+    double widest = -1.0;
+    for (uint32_t a = 0; a < 3; a++) {
+        double low = points[lo].xyz[a], high = low;
+        for (size_t i = lo + 1; i < hi; i++) {
+            low = std::min(low, points[i].xyz[a]);
+            high = std::max(high, points[i].xyz[a]);
+        }
+        if (high - low > widest) {
+            widest = high - low;
+            axis = a;
+        }
+    }
+
+    size_t mid = lo + (hi - lo) / 2;
+    std::nth_element(points.begin() + lo, points.begin() + mid, points.begin() + hi,
+                     [axis](const SpatialPoint& a, const SpatialPoint& b) {
+                         return a.xyz[axis] < b.xyz[axis] ||
+                                (a.xyz[axis] == b.xyz[axis] && a.location < b.location);
+                     });
+    points[mid].axis = axis;
+    buildSpatial(points, lo, mid);
+    buildSpatial(points, mid + 1, hi);
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc < 3 || argc > 4) {
+        std::cerr << "usage: location_db_generator OUTPUT.inc LOCATIONS.tsv [cities15000.txt]\n";
+        return 1;
+    }
+
+    std::vector<City> cities;
+    if (!readCurated(argv[2], cities)) return 1;
+    if (argc == 4) {
+        std::vector<City> curated = cities;
+        if (!readGeoNames(argv[3], curated, cities)) return 1;
+    }
+
+    TextPool text;
+
+    // Search keys exactly as the old runtime index built them: the full name,
+    // each name token, the country and the region, all lowercased
+    std::map<std::string, std::vector<uint32_t>> keyLocations;
+    auto addKey = [&](const std::string& key, uint32_t location) {
+        auto& ids = keyLocations[lower(key)];
+        if (ids.empty() || ids.back() != location) ids.push_back(location);
+    };
+
+    std::ostringstream records;
+    for (uint32_t i = 0; i < cities.size(); i++) {
+        const City& city = cities[i];
+
+        char numbers[128];
+        std::snprintf(numbers, sizeof(numbers), "%.17g, %.17g, %.17g, %ld",
+                      city.latitude, city.longitude, city.timezone, city.population);
+        records << "    {" << text.add(city.name) << ", " << text.add(city.country) << ", "
+                << text.add(city.region) << ", " << text.add(city.timezoneId) << ", "
+                << text.add(lower(city.name)) << ", " << text.add(lower(city.country)) << ", "
+                << numbers << "},\n";
+
+        addKey(city.name, i);
+        for (const auto& token : tokenize(city.name)) addKey(token, i);
+        for (const auto& token : tokenize(city.asciiName)) addKey(token, i);
+        if (!city.asciiName.empty()) addKey(city.asciiName, i);
+        addKey(city.country, i);
+        addKey(city.region, i);
+    }
+
+    // Keys in sorted order (std::map), then trigram postings over them
+    std::vector<uint32_t> keyTexts, keyLengths, keyFirst, keyCounts, locations;
+    std::map<uint32_t, std::vector<uint32_t>> trigramKeys;
+    uint32_t keyId = 0;
+    for (const auto& [key, ids] : keyLocations) {
+        keyTexts.push_back(text.add(key));
+        keyLengths.push_back(static_cast<uint32_t>(key.size()));
+        keyFirst.push_back(static_cast<uint32_t>(locations.size()));
+        keyCounts.push_back(static_cast<uint32_t>(ids.size()));
+        locations.insert(locations.end(), ids.begin(), ids.end());
+
+        for (size_t j = 0; j + 3 <= key.size(); j++) {
+            uint32_t code = (static_cast<uint32_t>(static_cast<unsigned char>(key[j])) << 16) |
+                            (static_cast<uint32_t>(static_cast<unsigned char>(key[j + 1])) << 8) |
+                            static_cast<unsigned char>(key[j + 2]);
+            auto& postings = trigramKeys[code];
+            if (postings.empty() || postings.back() != keyId) postings.push_back(keyId);
+        }
+        keyId++;
+    }
+
+    std::vector<SpatialPoint> spatial(cities.size());
+    for (uint32_t i = 0; i < cities.size(); i++) {
+        double lat = cities[i].latitude * M_PI / 180.0;
+        double lon = cities[i].longitude * M_PI / 180.0;
+        spatial[i] = {{std::cos(lat) * std::cos(lon), std::cos(lat) * std::sin(lon), std::sin(lat)}, i, 0};
+    }
+    buildSpatial(spatial, 0, spatial.size());
+
+    std::ofstream out(argv[1]);
+    if (!out) {
+        std::cerr << "location_db_generator: cannot write " << argv[1] << "\n";
+        return 1;
+    }
+
+    out << "// Generated by tools/location_db_generator. Do not edit.\n\n";
+    writeText(out, text.data());
+
+    out << "const Record RECORDS[] = {\n" << records.str()
+        << "    {0, 0, 0, 0, 0, 0, 0.0, 0.0, 0.0, 0}  // sentinel\n};\n";
+    out << "const size_t RECORD_COUNT = " << cities.size() << ";\n\n";
+
+    out << "const Key KEYS[] = {\n";
+    for (size_t i = 0; i < keyTexts.size(); i++) {
+        out << "    {" << keyTexts[i] << ", " << keyLengths[i] << ", " << keyFirst[i] << ", " << keyCounts[i] << "},\n";
+    }
+    out << "    {0, 0, 0, 0}  // sentinel\n};\n";
+    out << "const size_t KEY_COUNT = " << keyTexts.size() << ";\n\n";
+    writeNumbers(out, "const uint32_t KEY_LOCATIONS[]", locations);
+
+    std::vector<uint32_t> trigramPostings;
+    out << "const Trigram TRIGRAMS[] = {\n";
+    for (const auto& [code, keys] : trigramKeys) {
+        out << "    {" << code << ", " << trigramPostings.size() << ", " << keys.size() << "},\n";
+        trigramPostings.insert(trigramPostings.end(), keys.begin(), keys.end());
+    }
+    out << "    {0, 0, 0}  // sentinel\n};\n";
+    out << "const size_t TRIGRAM_COUNT = " << trigramKeys.size() << ";\n\n";
+    writeNumbers(out, "const uint32_t TRIGRAM_KEYS[]", trigramPostings);
+
+    out << "const SpatialNode SPATIAL_NODES[] = {\n";
+    for (const auto& point : spatial) {
+        char node[128];
+        std::snprintf(node, sizeof(node), "    {{%.17g, %.17g, %.17g}, %u, %u},\n",
+                      point.xyz[0], point.xyz[1], point.xyz[2], point.location, point.axis);
+        out << node;
+    }
+    out << "    {{0.0, 0.0, 0.0}, 0, 0}  // sentinel\n};\n";
+
+    return out ? 0 : 1;
+}
@@ -0,0 +1,629 @@
+// Build-time compiler for the time zone database (see include/timezone_db.h).
+//
+// usage: timezone_db_generator OUTPUT.inc TZDATA.zi
+//
+// TZDATA.zi is the single-file zic input that tzdata distributes (Rule, Zone
+// and Link lines, usually in their abbreviated R/Z/L form). Every zone is
+// expanded the way zic expands it into UTC transitions through at least
+// TABLE_END_YEAR. Zones that keep following a pair of open-ended daylight
+// saving rules also get those rules, which the runtime applies to later years.
+
+#include <algorithm>
+#include <cctype>
+#include <climits>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+
+constexpr int TABLE_END_YEAR = 2037;
+constexpr int MAX_YEAR = INT_MAX;
+
+enum DayKind { DAY_FIXED, DAY_LAST_WEEKDAY, DAY_WEEKDAY_ON_OR_AFTER, DAY_WEEKDAY_ON_OR_BEFORE };
+enum TimeKind { TIME_WALL, TIME_STANDARD, TIME_UNIVERSAL };
+
+struct DayRule {
+    int month = 1;          // 1-12
+    int day = 1;
+    int weekday = 0;        // 0 = Sunday
+    DayKind kind = DAY_FIXED;
+};
+
+struct Rule {
+    int fromYear = 0;
+    int toYear = 0;         // MAX_YEAR for "max"
+    DayRule date;
+    int64_t at = 0;         // seconds after local midnight
+    TimeKind atKind = TIME_WALL;
+    int save = 0;
+    bool dst = false;
+};
+
+struct Era {
+    int standardOffset = 0;
+    std::string rules;      // rule set name, empty for a fixed save
+    int fixedSave = 0;
+    bool fixedDST = false;
+    bool hasUntil = false;
+    int untilYear = 0;
+    DayRule untilDate;
+    int64_t untilTime = 0;
+    TimeKind untilKind = TIME_WALL;
+};
+
+struct ZoneSource {
+    std::string name;
+    std::vector<Era> eras;
+};
+
+struct Transition {
+    int64_t utc;
+    int offset;
+    bool dst;
+};
+
+struct CompiledZone {
+    std::string name;
+    int initialOffset = 0;
+    bool initialDST = false;
+    std::vector<Transition> transitions;
+    int finalStandardOffset = 0;
+    std::vector<Rule> finalRules;   // empty or exactly two
+};
+
+std::string sourcePath;
+int sourceLine = 0;
+
+[[noreturn]] void fail(const std::string& message) {
+    std::cerr << sourcePath << ":" << sourceLine << ": " << message << "\n";
+    std::exit(1);
+}
+
+// ---------------------------------------------------------------------------
+// Calendar arithmetic (proleptic Gregorian, days since 1970-01-01)
+
+int64_t daysFromCivil(int64_t year, int month, int day) {
+    year -= month <= 2;
+    const int64_t era = (year >= 0 ? year : year - 399) / 400;
+    const int64_t yearOfEra = year - era * 400;
+    const int64_t dayOfYear = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;
+    const int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+    return era * 146097 + dayOfEra - 719468;
+}
+
+int weekdayOf(int64_t days) {
+    return static_cast<int>(((days % 7) + 11) % 7);   // 1970-01-01 was a Thursday
+}
+
+int daysInMonth(int64_t year, int month) {
+    static const int DAYS[] = {31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : DAYS[month - 1];
+}
+
+int64_t dayOf(int64_t year, const DayRule& rule) {
+    int64_t days;
+    switch (rule.kind) {
+        case DAY_LAST_WEEKDAY:
+            days = daysFromCivil(year, rule.month, daysInMonth(year, rule.month));
+            while (weekdayOf(days) != rule.weekday) days--;
+            return days;
+        case DAY_WEEKDAY_ON_OR_AFTER:
+            days = daysFromCivil(year, rule.month, rule.day);
+            while (weekdayOf(days) != rule.weekday) days++;
+            return days;
+        case DAY_WEEKDAY_ON_OR_BEFORE:
+            days = daysFromCivil(year, rule.month, rule.day);
+            while (weekdayOf(days) != rule.weekday) days--;
+            return days;
+        default:
+            return daysFromCivil(year, rule.month, rule.day);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Field parsing. zic accepts any unambiguous prefix of month, weekday and
+// year keywords, case-insensitively.
+
+int matchWord(const std::string& word, const std::vector<std::string>& names, const char* what) {
+    std::string lower = word;
+    std::transform(lower.begin(), lower.end(), lower.begin(), [](unsigned char c) { return std::tolower(c); });
+
+    int found = -1;
+    for (size_t i = 0; i < names.size(); i++) {
+        if (names[i] == lower) return static_cast<int>(i);
+        if (!lower.empty() && names[i].compare(0, lower.size(), lower) == 0) {
+            if (found >= 0) fail(std::string("ambiguous ") + what + " \"" + word + "\"");
+            found = static_cast<int>(i);
+        }
+    }
+    if (found < 0) fail(std::string("invalid ") + what + " \"" + word + "\"");
+    return found;
+}
+
+int parseMonth(const std::string& word) {
+    static const std::vector<std::string> MONTHS = {
+        "january", "february", "march", "april", "may", "june",
+        "july", "august", "september", "october", "november", "december"};
+    return matchWord(word, MONTHS, "month") + 1;
+}
+
+int parseWeekday(const std::string& word) {
+    static const std::vector<std::string> WEEKDAYS = {
+        "sunday", "monday", "tuesday", "wednesday", "thursday", "friday", "saturday"};
+    return matchWord(word, WEEKDAYS, "weekday");
+}
+
+int parseInteger(const std::string& word) {
+    try {
+        size_t used = 0;
+        int value = std::stoi(word, &used);
+        if (used == word.size()) return value;
+    } catch (const std::exception&) {
+    }
+    fail("invalid number \"" + word + "\"");
+}
+
+DayRule parseDay(int month, const std::string& word) {
+    DayRule rule;
+    rule.month = month;
+    if (word.compare(0, 4, "last") == 0) {
+        rule.kind = DAY_LAST_WEEKDAY;
+        rule.weekday = parseWeekday(word.substr(4));
+    } else if (word.find(">=") != std::string::npos || word.find("<=") != std::string::npos) {
+        size_t op = word.find_first_of("<>");
+        rule.kind = word[op] == '>' ? DAY_WEEKDAY_ON_OR_AFTER : DAY_WEEKDAY_ON_OR_BEFORE;
+        rule.weekday = parseWeekday(word.substr(0, op));
+        rule.day = parseInteger(word.substr(op + 2));
+    } else {
+        rule.day = parseInteger(word);
+    }
+    return rule;
+}
+
+// [-]h[:mm[:ss]] with an optional w/s/u (g, z) suffix; "-" is zero
+int64_t parseTime(std::string word, TimeKind* kind) {
+    if (kind) *kind = TIME_WALL;
+    if (!word.empty() && std::isalpha(static_cast<unsigned char>(word.back()))) {
+        char suffix = static_cast<char>(std::tolower(static_cast<unsigned char>(word.back())));
+        word.pop_back();
+        if (!kind) fail("unexpected time suffix");
+        if (suffix == 's') *kind = TIME_STANDARD;
+        else if (suffix == 'u' || suffix == 'g' || suffix == 'z') *kind = TIME_UNIVERSAL;
+        else if (suffix != 'w') fail(std::string("invalid time suffix '") + suffix + "'");
+    }
+    if (word.empty() || word == "-") return 0;
+
+    bool negative = word[0] == '-';
+    if (negative) word.erase(0, 1);
+
+    int64_t seconds = 0;
+    int64_t scale = 3600;
+    std::istringstream parts(word);
+    std::string part;
+    while (std::getline(parts, part, ':')) {
+        if (scale == 0) fail("invalid time \"" + word + "\"");
+        size_t dot = part.find('.');
+        int64_t value = parseInteger(part.substr(0, dot));
+        // Fractional seconds round to the nearest second, as in zic
+        if (dot != std::string::npos && scale == 1 && dot + 1 < part.size() && part[dot + 1] >= '5') value++;
+        seconds += value * scale;
+        scale /= 60;
+    }
+    return negative ? -seconds : seconds;
+}
+
+// SAVE amounts may carry 's' (standard time) or 'd' (daylight saving time)
+int parseSave(std::string word, bool& dst) {
+    char suffix = word.empty() ? '\0' : word.back();
+    if (suffix == 's' || suffix == 'd') word.pop_back();
+    int save = static_cast<int>(parseTime(word, nullptr));
+    dst = suffix == 'd' || (suffix != 's' && save != 0);
+    return save;
+}
+
+int parseYear(const std::string& word, int only) {
+    if (std::isalpha(static_cast<unsigned char>(word[0]))) {
+        static const std::vector<std::string> KEYWORDS = {"minimum", "maximum", "only"};
+        switch (matchWord(word, KEYWORDS, "year")) {
+            case 0: return INT_MIN;
+            case 1: return MAX_YEAR;
+            default: return only;
+        }
+    }
+    return parseInteger(word);
+}
+
+// STDOFF RULES FORMAT [UNTIL...], starting at fields[first]
+Era parseEra(const std::vector<std::string>& fields, size_t first) {
+    if (fields.size() < first + 3) fail("zone line needs STDOFF RULES FORMAT");
+
+    Era era;
+    era.standardOffset = static_cast<int>(parseTime(fields[first], nullptr));
+
+    const std::string& rules = fields[first + 1];
+    if (rules != "-") {
+        if (std::isdigit(static_cast<unsigned char>(rules[0])) || rules[0] == '-') {
+            era.fixedSave = parseSave(rules, era.fixedDST);
+        } else {
+            era.rules = rules;
+        }
+    }
+
+    size_t until = first + 3;
+    if (fields.size() > until) {
+        era.hasUntil = true;
+        era.untilYear = parseInteger(fields[until]);
+        int month = fields.size() > until + 1 ? parseMonth(fields[until + 1]) : 1;
+        era.untilDate = fields.size() > until + 2 ? parseDay(month, fields[until + 2]) : parseDay(month, "1");
+        if (fields.size() > until + 3) era.untilTime = parseTime(fields[until + 3], &era.untilKind);
+    }
+    return era;
+}
+
+// ---------------------------------------------------------------------------
+// Expansion, following zic's outzone()
+
+CompiledZone compileZone(const ZoneSource& source, const std::map<std::string, std::vector<Rule>>& ruleSets) {
+    CompiledZone zone;
+    zone.name = source.name;
+
+    std::vector<Transition> transitions;
+    int64_t startTime = 0;
+    const size_t eraCount = source.eras.size();
+
+    for (size_t i = 0; i < eraCount; i++) {
+        const Era& era = source.eras[i];
+        const int standard = era.standardOffset;
+        bool useStart = i > 0;
+        const bool useUntil = i + 1 < eraCount;
+        int save = 0;
+        int startOffset = standard;
+
+        int64_t untilLocal = 0;
+        if (useUntil) {
+            if (!era.hasUntil) fail("zone " + source.name + ": continuation without UNTIL");
+            untilLocal = dayOf(era.untilYear, era.untilDate) * 86400 + era.untilTime;
+        }
+        auto untilUTC = [&]() {
+            int64_t t = untilLocal;
+            if (era.untilKind != TIME_UNIVERSAL) t -= standard;
+            if (era.untilKind == TIME_WALL) t -= save;
+            return t;
+        };
+
+        if (era.rules.empty()) {
+            save = era.fixedSave;
+            if (useStart) {
+                transitions.push_back({startTime, standard + save, era.fixedDST});
+                useStart = false;
+            } else {
+                zone.initialOffset = standard + save;
+                zone.initialDST = era.fixedDST;
+            }
+        } else {
+            auto found = ruleSets.find(era.rules);
+            if (found == ruleSets.end()) fail("zone " + source.name + ": unknown rule set " + era.rules);
+            const std::vector<Rule>& rules = found->second;
+
+            if (i == 0) {
+                zone.initialOffset = standard;
+                zone.initialDST = false;
+            }
+
+            int firstYear = INT_MAX;
+            int lastYear = TABLE_END_YEAR;
+            for (const Rule& rule : rules) {
+                firstYear = std::min(firstYear, rule.fromYear);
+                if (rule.toYear != MAX_YEAR) lastYear = std::max(lastYear, rule.toYear);
+                else lastYear = std::max(lastYear, rule.fromYear);
+            }
+            if (useUntil) lastYear = era.untilYear;
+
+            std::vector<bool> todo(rules.size());
+            std::vector<int64_t> localTimes(rules.size());
+            for (int year = firstYear; year <= lastYear; year++) {
+                for (size_t j = 0; j < rules.size(); j++) {
+                    todo[j] = year >= rules[j].fromYear && year <= rules[j].toYear;
+                    if (todo[j]) localTimes[j] = dayOf(year, rules[j].date) * 86400 + rules[j].at;
+                }
+
+                while (true) {
+                    // The rule of this year, not yet taken, that takes effect first
+                    int taken = -1;
+                    int64_t takenTime = 0;
+                    for (size_t j = 0; j < rules.size(); j++) {
+                        if (!todo[j]) continue;
+                        int64_t offset = rules[j].atKind == TIME_UNIVERSAL ? 0 : standard;
+                        if (rules[j].atKind == TIME_WALL) offset += save;
+                        int64_t t = localTimes[j] - offset;
+                        if (taken < 0 || t < takenTime) {
+                            taken = static_cast<int>(j);
+                            takenTime = t;
+                        }
+                    }
+                    if (taken < 0) break;
+
+                    const Rule& rule = rules[taken];
+                    todo[taken] = false;
+                    if (useUntil && takenTime >= untilUTC()) break;
+
+                    save = rule.save;
+                    if (useStart && takenTime == startTime) useStart = false;
+                    if (useStart) {
+                        if (takenTime < startTime) {
+                            startOffset = standard + save;
+                            continue;
+                        }
+                    }
+                    transitions.push_back({takenTime, standard + rule.save, rule.dst});
+                }
+            }
+
+            if (!useUntil) {
+                zone.finalStandardOffset = standard;
+                for (const Rule& rule : rules) {
+                    if (rule.toYear == MAX_YEAR) zone.finalRules.push_back(rule);
+                }
+                if (zone.finalRules.size() > 2) fail("zone " + source.name + ": more than two open-ended rules");
+                if (zone.finalRules.size() == 1) zone.finalRules.clear();
+            }
+        }
+
+        if (useStart) {
+            transitions.push_back({startTime, startOffset, startOffset != standard});
+        }
+        if (useUntil) {
+            startTime = untilUTC();
+        }
+    }
+
+    std::stable_sort(transitions.begin(), transitions.end(),
+                     [](const Transition& a, const Transition& b) { return a.utc < b.utc; });
+
+    // zic's optimization pass: a transition whose wall clock time does not come
+    // after the previous one's replaces it, and no-op transitions are dropped
+    std::vector<Transition> merged;
+    for (const Transition& t : transitions) {
+        if (!merged.empty()) {
+            int before = merged.size() == 1 ? zone.initialOffset : merged[merged.size() - 2].offset;
+            if (t.utc + merged.back().offset <= merged.back().utc + before) {
+                merged.back().offset = t.offset;
+                merged.back().dst = t.dst;
+                continue;
+            }
+        }
+        merged.push_back(t);
+    }
+
+    int offset = zone.initialOffset;
+    bool dst = zone.initialDST;
+    for (const Transition& t : merged) {
+        if (t.offset != offset || t.dst != dst) zone.transitions.push_back(t);
+        offset = t.offset;
+        dst = t.dst;
+    }
+    return zone;
+}
+
+// ---------------------------------------------------------------------------
+// Output
+
+std::vector<std::string> splitFields(const std::string& line) {
+    std::vector<std::string> fields;
+    std::istringstream stream(line.substr(0, line.find('#')));
+    std::string field;
+    while (stream >> field) fields.push_back(field);
+    return fields;
+}
+
+class TextPool {
+public:
+    uint32_t add(const std::string& text) {
+        auto it = offsets.find(text);
+        if (it != offsets.end()) return it->second;
+        uint32_t offset = static_cast<uint32_t>(pool.size());
+        pool += text;
+        pool += '\0';
+        offsets.emplace(text, offset);
+        return offset;
+    }
+
+    const std::string& data() const { return pool; }
+
+private:
+    std::string pool;
+    std::unordered_map<std::string, uint32_t> offsets;
+};
+
+void writeRule(std::ostream& out, const Rule& rule) {
+    out << "{{" << rule.date.month << ", " << rule.date.day << ", " << rule.date.weekday << ", "
+        << rule.date.kind << "}, " << rule.at << ", " << rule.atKind << ", " << rule.save << ", "
+        << (rule.dst ? 1 : 0) << "}";
+}
+
+} // namespace
+
+int main(int argc, char* argv[]) {
+    if (argc != 3) {
+        std::cerr << "usage: timezone_db_generator OUTPUT.inc TZDATA.zi\n";
+        return 1;
+    }
+
+    sourcePath = argv[2];
+    std::ifstream in(sourcePath);
+    if (!in) {
+        std::cerr << "timezone_db_generator: cannot open " << sourcePath << "\n";
+        return 1;
+    }
+
+    std::string version = "unknown";
+    std::map<std::string, std::vector<Rule>> ruleSets;
+    std::vector<ZoneSource> sources;
+    std::vector<std::pair<std::string, std::string>> links;   // (alias, target)
+    bool inZone = false;
+
+    std::string line;
+    while (std::getline(in, line)) {
+        sourceLine++;
+        if (line.compare(0, 10, "# version ") == 0) {
+            version = line.substr(10);
+            continue;
+        }
+
+        auto fields = splitFields(line);
+        if (fields.empty()) continue;
+
+        static const std::vector<std::string> KINDS = {"rule", "zone", "link"};
+        bool continuation = inZone && (std::isdigit(static_cast<unsigned char>(fields[0][0])) || fields[0][0] == '-');
+        if (continuation) {
+            sources.back().eras.push_back(parseEra(fields, 0));
+            inZone = sources.back().eras.back().hasUntil;
+            continue;
+        }
+
+        switch (matchWord(fields[0], KINDS, "line type")) {
+            case 0: {
+                if (fields.size() != 10) fail("rule line needs 10 fields");
+                Rule rule;
+                rule.fromYear = parseYear(fields[2], 0);
+                rule.toYear = parseYear(fields[3], rule.fromYear);
+                rule.date = parseDay(parseMonth(fields[5]), fields[6]);
+                rule.at = parseTime(fields[7], &rule.atKind);
+                rule.save = parseSave(fields[8], rule.dst);
+                ruleSets[fields[1]].push_back(rule);
+                inZone = false;
+                break;
+            }
+            case 1: {
+                if (fields.size() < 5) fail("zone line needs NAME STDOFF RULES FORMAT");
+                sources.push_back({fields[1], {parseEra(fields, 2)}});
+                inZone = sources.back().eras.back().hasUntil;
+                break;
+            }
+            default: {
+                if (fields.size() != 3) fail("link line needs TARGET NAME");
+                links.push_back({fields[2], fields[1]});
+                inZone = false;
+                break;
+            }
+        }
+    }
+
+    std::sort(sources.begin(), sources.end(),
+              [](const ZoneSource& a, const ZoneSource& b) { return a.name < b.name; });
+
+    TextPool text;
+    std::map<std::string, uint32_t> zoneIndex;
+    std::ostringstream zones, utc, local, offsets, finals;
+    uint32_t transitionCount = 0;
+    uint32_t finalCount = 0;
+
+    for (const ZoneSource& source : sources) {
+        CompiledZone zone = compileZone(source, ruleSets);
+        zoneIndex[zone.name] = static_cast<uint32_t>(zoneIndex.size());
+
+        int finalIndex = -1;
+        if (!zone.finalRules.empty()) {
+            // Rule taking effect first in the year comes first
+            std::sort(zone.finalRules.begin(), zone.finalRules.end(), [](const Rule& a, const Rule& b) {
+                return a.date.month < b.date.month;
+            });
+            finals << "    {" << zone.finalStandardOffset << ", {";
+            writeRule(finals, zone.finalRules[0]);
+            finals << ", ";
+            writeRule(finals, zone.finalRules[1]);
+            finals << "}},\n";
+            finalIndex = static_cast<int>(finalCount++);
+        }
+
+        zones << "    {" << text.add(zone.name) << ", " << transitionCount << ", " << zone.transitions.size()
+              << ", " << zone.initialOffset << ", " << (zone.initialDST ? 1 : 0) << ", " << finalIndex << "},\n";
+
+        // Local wall clock time from which each offset applies. A time skipped
+        // or repeated by the change keeps the earlier offset.
+        int before = zone.initialOffset;
+        int64_t previousKey = INT64_MIN;
+        for (const Transition& t : zone.transitions) {
+            int64_t key = t.utc + std::max(before, t.offset);
+            if (key <= previousKey) {
+                sourceLine = 0;
+                fail("zone " + zone.name + ": local transition times are not increasing");
+            }
+            previousKey = key;
+            utc << "    " << t.utc << ",\n";
+            local << "    " << key << ",\n";
+            offsets << "    {" << t.offset << ", " << (t.dst ? 1 : 0) << "},\n";
+            before = t.offset;
+        }
+        transitionCount += static_cast<uint32_t>(zone.transitions.size());
+    }
+
+    // Canonical names and aliases, sorted for binary search
+    std::map<std::string, uint32_t> names(zoneIndex.begin(), zoneIndex.end());
+    for (const auto& [alias, target] : links) {
+        std::string resolved = target;
+        for (int depth = 0; depth < 8 && !zoneIndex.count(resolved); depth++) {
+            auto next = std::find_if(links.begin(), links.end(),
+                                     [&](const std::pair<std::string, std::string>& link) { return link.first == resolved; });
+            if (next == links.end()) break;
+            resolved = next->second;
+        }
+        auto zone = zoneIndex.find(resolved);
+        if (zone == zoneIndex.end()) {
+            std::cerr << "timezone_db_generator: link " << alias << " -> " << target << " has no zone\n";
+            return 1;
+        }
+        names.emplace(alias, zone->second);
+    }
+
+    std::ostringstream nameTable;
+    for (const auto& [name, zone] : names) {
+        nameTable << "    {" << text.add(name) << ", " << zone << "},\n";
+    }
+
+    std::ofstream out(argv[1]);
+    if (!out) {
+        std::cerr << "timezone_db_generator: cannot write " << argv[1] << "\n";
+        return 1;
+    }
+
+    out << "// Generated by tools/timezone_db_generator. Do not edit.\n\n";
+    out << "const char VERSION[] = \"" << version << "\";\n\n";
+
+    out << "const char TEXT[] =\n    \"";
+    size_t column = 0;
+    for (char c : text.data()) {
+        if (column >= 96) {
+            out << "\"\n    \"";
+            column = 0;
+        }
+        if (c == '\0') {
+            out << "\\0";
+            column += 2;
+        } else {
+            out << c;
+            column++;
+        }
+    }
+    out << "\";\n\n";
+
+    out << "const Zone ZONES[] = {\n" << zones.str() << "    {0, 0, 0, 0, 0, -1}  // sentinel\n};\n";
+    out << "const size_t ZONE_COUNT = " << zoneIndex.size() << ";\n\n";
+    out << "const ZoneName ZONE_NAMES[] = {\n" << nameTable.str() << "    {0, 0}  // sentinel\n};\n";
+    out << "const size_t ZONE_NAME_COUNT = " << names.size() << ";\n\n";
+    out << "const int64_t TRANSITION_UTC[] = {\n" << utc.str() << "    0  // sentinel\n};\n\n";
+    out << "const int64_t TRANSITION_LOCAL[] = {\n" << local.str() << "    0  // sentinel\n};\n\n";
+    out << "const Offset TRANSITION_OFFSETS[] = {\n" << offsets.str() << "    {0, 0}  // sentinel\n};\n\n";
+    out << "const FinalRules FINAL_RULES[] = {\n" << finals.str()
+        << "    {0, {{{1, 1, 0, 0}, 0, 0, 0, 0}, {{1, 1, 0, 0}, 0, 0, 0, 0}}}  // sentinel\n};\n";
+
+    return out ? 0 : 1;
+}